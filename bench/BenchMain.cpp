@@ -0,0 +1,113 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "BenchRunner.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+namespace
+{
+    void PrintUsage()
+    {
+        cout << "Usage: zilliqa_bench [--filter=<substring>] [--min-time=<seconds>] [--out=<file>]" << endl
+             << "                     [--baseline=<file>] [--tolerance=<percent>]" << endl
+             << "Writes results as JSON to --out, or to stdout. Progress is logged to stdout with --out" << endl
+             << "and to zilliqa_bench-00001-log.txt without it. With --baseline, each result also" << endl
+             << "carries the baseline ns/op, and the exit code is 1 if any benchmark is slower than" << endl
+             << "its baseline by more than --tolerance (default 10)." << endl;
+    }
+
+    bool GetOption(const string & arg, const string & name, string & value)
+    {
+        const string prefix = "--" + name + "=";
+        if (arg.compare(0, prefix.size(), prefix) != 0)
+        {
+            return false;
+        }
+        value = arg.substr(prefix.size());
+        return true;
+    }
+}
+
+int main(int argc, const char * argv[])
+{
+    string filter;
+    string minTime = "0.5";
+    string outPath;
+    string baselinePath;
+    string tolerance = "10";
+
+    for (int i = 1; i < argc; i++)
+    {
+        const string arg = argv[i];
+        if (!GetOption(arg, "filter", filter) && !GetOption(arg, "min-time", minTime) &&
+            !GetOption(arg, "out", outPath) && !GetOption(arg, "baseline", baselinePath) &&
+            !GetOption(arg, "tolerance", tolerance))
+        {
+            PrintUsage();
+            return (arg == "--help") ? 0 : 1;
+        }
+    }
+
+    // The asynchronous logger would interleave its lines with JSON written to stdout
+    if (outPath.empty())
+    {
+        INIT_FILE_LOGGER("zilliqa_bench");
+    }
+    else
+    {
+        INIT_STDOUT_LOGGER();
+    }
+
+    // Per-benchmark progress is logged as a warning so library chatter below that stays out of the timings
+    Logger::SetLogLevel(LOG_LEVEL_WARNING);
+
+    BenchRunner runner(filter, atof(minTime.c_str()));
+    if (!baselinePath.empty() && !runner.LoadBaseline(baselinePath))
+    {
+        return 1;
+    }
+
+    RegisterCryptoBenchmarks(runner);
+    RegisterSha3Benchmarks(runner);
+    RegisterDataBenchmarks(runner);
+    RegisterStorageBenchmarks(runner);
+    RegisterPOWBenchmarks(runner);
+
+    if (outPath.empty())
+    {
+        runner.WriteJson(cout);
+    }
+    else
+    {
+        ofstream out(outPath);
+        runner.WriteJson(out);
+    }
+
+    vector<string> regressions = runner.GetRegressions(atof(tolerance.c_str()));
+    for (const auto & name : regressions)
+    {
+        cerr << "Regression: " << name << endl;
+    }
+
+    return regressions.empty() ? 0 : 1;
+}
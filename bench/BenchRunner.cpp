@@ -0,0 +1,158 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include "BenchRunner.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+BenchRunner::BenchRunner(const string & filter, double minSeconds) : m_filter(filter), m_minSeconds(minSeconds)
+{
+}
+
+bool BenchRunner::IsSelected(const string & prefix) const
+{
+    // A filter may name either the suite or one benchmark within it
+    return m_filter.empty() || (prefix.find(m_filter) != string::npos) || (m_filter.find(prefix) == 0);
+}
+
+void BenchRunner::Run(const string & name, const BenchFunc & f)
+{
+    if (!m_filter.empty() && (name.find(m_filter) == string::npos))
+    {
+        return;
+    }
+
+    // Warm up caches and lazily built state
+    f(1);
+
+    uint64_t numOps = 1;
+    double seconds = 0;
+    while (true)
+    {
+        auto start = chrono::steady_clock::now();
+        f(numOps);
+        seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        if ((seconds >= m_minSeconds) || (numOps >= (numeric_limits<uint64_t>::max() >> 1)))
+        {
+            break;
+        }
+
+        // Jump close to the target when the timing is meaningful, otherwise just double
+        if (seconds > m_minSeconds / 100)
+        {
+            numOps = max(numOps * 2, (uint64_t) (numOps * 1.2 * m_minSeconds / seconds));
+        }
+        else
+        {
+            numOps *= 2;
+        }
+    }
+
+    double best = seconds;
+    for (unsigned int i = 1; i < REPEATS; i++)
+    {
+        auto start = chrono::steady_clock::now();
+        f(numOps);
+        best = min(best, chrono::duration<double>(chrono::steady_clock::now() - start).count());
+    }
+
+    Result result;
+    result.m_name = name;
+    result.m_iterations = numOps;
+    result.m_nsPerOp = best * 1e9 / numOps;
+    auto it = m_baseline.find(name);
+    result.m_baselineNsPerOp = (it == m_baseline.end()) ? 0 : it->second;
+    m_results.push_back(result);
+
+    LOG_GENERAL(LOG_LEVEL_WARNING, name << ": " << fixed << setprecision(1) << result.m_nsPerOp << " ns/op");
+}
+
+bool BenchRunner::LoadBaseline(const string & path)
+{
+    using boost::property_tree::ptree;
+    ptree pt;
+
+    try
+    {
+        read_json(path, pt);
+        for (const auto & entry : pt.get_child("benchmarks"))
+        {
+            m_baseline[entry.second.get<string>("name")] = entry.second.get<double>("ns_per_op");
+        }
+    }
+    catch (const exception & e)
+    {
+        LOG_GENERAL(LOG_LEVEL_WARNING, "Cannot read baseline " << path << ": " << e.what());
+        return false;
+    }
+
+    return true;
+}
+
+void BenchRunner::WriteJson(ostream & os) const
+{
+    os << "{\n  \"benchmarks\": [";
+
+    for (unsigned int i = 0; i < m_results.size(); i++)
+    {
+        const Result & r = m_results.at(i);
+
+        os << (i == 0 ? "\n" : ",\n") << "    { \"name\": \"" << r.m_name << "\", \"iterations\": " << 
+              r.m_iterations << fixed << setprecision(2) << ", \"ns_per_op\": " << r.m_nsPerOp << 
+              ", \"ops_per_sec\": " << 1e9 / r.m_nsPerOp;
+
+        if (r.m_baselineNsPerOp > 0)
+        {
+            os << ", \"baseline_ns_per_op\": " << r.m_baselineNsPerOp << ", \"change_percent\": " << 
+                  (r.m_nsPerOp / r.m_baselineNsPerOp - 1) * 100;
+        }
+
+        os << " }";
+    }
+
+    os << "\n  ]\n}\n";
+}
+
+vector<string> BenchRunner::GetRegressions(double tolerancePercent) const
+{
+    vector<string> regressions;
+
+    for (const auto & r : m_results)
+    {
+        if ((r.m_baselineNsPerOp > 0) && (r.m_nsPerOp > r.m_baselineNsPerOp * (1 + tolerancePercent / 100)))
+        {
+            regressions.push_back(r.m_name);
+        }
+    }
+
+    return regressions;
+}
+
+const vector<BenchRunner::Result> & BenchRunner::GetResults() const
+{
+    return m_results;
+}
@@ -0,0 +1,85 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#ifndef __BENCHRUNNER_H__
+#define __BENCHRUNNER_H__
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+/// Times microbenchmarks and reports them as JSON, optionally against a stored baseline.
+///
+/// A benchmark is a function that performs a given number of operations. The runner doubles that number
+/// until one call takes at least the minimum time, then keeps the fastest of REPEATS such calls, which
+/// filters out scheduling noise better than an average.
+class BenchRunner
+{
+public:
+
+    struct Result
+    {
+        std::string m_name;
+        uint64_t m_iterations;
+        double m_nsPerOp;
+        double m_baselineNsPerOp; // 0 if not in the baseline
+    };
+
+    using BenchFunc = std::function<void(uint64_t numOps)>;
+
+    /// Number of timed calls a result is the best of.
+    static const unsigned int REPEATS = 3;
+
+    /// Constructor. Only benchmarks whose name contains filter are run.
+    BenchRunner(const std::string & filter, double minSeconds);
+
+    /// Returns true if any benchmark whose name starts with prefix would run. Suites check this before
+    /// expensive setup.
+    bool IsSelected(const std::string & prefix) const;
+
+    /// Times f under the given name, unless it is filtered out.
+    void Run(const std::string & name, const BenchFunc & f);
+
+    /// Loads ns/op figures from a JSON file written by WriteJson(). Returns false if it cannot be read.
+    bool LoadBaseline(const std::string & path);
+
+    /// Writes all results as JSON.
+    void WriteJson(std::ostream & os) const;
+
+    /// Returns the names of benchmarks slower than their baseline by more than tolerancePercent.
+    std::vector<std::string> GetRegressions(double tolerancePercent) const;
+
+    /// Returns the results so far, in the order they ran.
+    const std::vector<Result> & GetResults() const;
+
+private:
+
+    std::string m_filter;
+    double m_minSeconds;
+    std::map<std::string, double> m_baseline;
+    std::vector<Result> m_results;
+};
+
+/// Benchmark suites, one per area of the code.
+void RegisterCryptoBenchmarks(BenchRunner & runner);
+void RegisterSha3Benchmarks(BenchRunner & runner);
+void RegisterDataBenchmarks(BenchRunner & runner);
+void RegisterStorageBenchmarks(BenchRunner & runner);
+void RegisterPOWBenchmarks(BenchRunner & runner);
+
+#endif // __BENCHRUNNER_H__
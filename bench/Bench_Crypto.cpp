@@ -0,0 +1,129 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <vector>
+
+#include "BenchRunner.h"
+#include "libCrypto/MultiSig.h"
+#include "libCrypto/Schnorr.h"
+#include "libCrypto/Sha2.h"
+
+using namespace std;
+
+namespace
+{
+    const unsigned int MESSAGE_SIZE = 256;
+    const unsigned int MULTISIG_SIGNERS = 20;
+
+    void RegisterSchnorr(BenchRunner & runner)
+    {
+        Schnorr & schnorr = Schnorr::GetInstance();
+        pair<PrivKey, PubKey> keyPair = schnorr.GenKeyPair();
+        vector<unsigned char> message(MESSAGE_SIZE, 0x5A);
+
+        Signature signature;
+        schnorr.Sign(message, keyPair.first, keyPair.second, signature);
+
+        runner.Run("crypto/schnorr_sign", [&](uint64_t numOps)
+        {
+            Signature result;
+            for (uint64_t i = 0; i < numOps; i++)
+            {
+                schnorr.Sign(message, keyPair.first, keyPair.second, result);
+            }
+        });
+
+        runner.Run("crypto/schnorr_verify", [&](uint64_t numOps)
+        {
+            for (uint64_t i = 0; i < numOps; i++)
+            {
+                schnorr.Verify(message, signature, keyPair.second);
+            }
+        });
+    }
+
+    void RegisterMultiSig(BenchRunner & runner)
+    {
+        Schnorr & schnorr = Schnorr::GetInstance();
+        vector<unsigned char> message(MESSAGE_SIZE, 0xA5);
+
+        vector<PrivKey> privKeys;
+        vector<PubKey> pubKeys;
+        vector<CommitSecret> secrets(MULTISIG_SIGNERS);
+        vector<CommitPoint> points;
+        for (unsigned int i = 0; i < MULTISIG_SIGNERS; i++)
+        {
+            pair<PrivKey, PubKey> keyPair = schnorr.GenKeyPair();
+            privKeys.push_back(keyPair.first);
+            pubKeys.push_back(keyPair.second);
+            points.push_back(CommitPoint(secrets.at(i)));
+        }
+
+        shared_ptr<PubKey> aggregatedPubKey = MultiSig::AggregatePubKeys(pubKeys);
+        shared_ptr<CommitPoint> aggregatedCommit = MultiSig::AggregateCommits(points);
+        Challenge challenge(*aggregatedCommit, *aggregatedPubKey, message);
+
+        vector<Response> responses;
+        for (unsigned int i = 0; i < MULTISIG_SIGNERS; i++)
+        {
+            responses.push_back(Response(secrets.at(i), challenge, privKeys.at(i)));
+        }
+
+        // One op is one full aggregation round over all signers, as a consensus leader performs it
+        runner.Run("crypto/multisig_aggregate_" + to_string(MULTISIG_SIGNERS), [&](uint64_t numOps)
+        {
+            for (uint64_t i = 0; i < numOps; i++)
+            {
+                shared_ptr<PubKey> pubKey = MultiSig::AggregatePubKeys(pubKeys);
+                shared_ptr<CommitPoint> commit = MultiSig::AggregateCommits(points);
+                shared_ptr<Response> response = MultiSig::AggregateResponses(responses);
+                MultiSig::AggregateSign(Challenge(*commit, *pubKey, message), *response);
+            }
+        });
+    }
+
+    void RegisterSha2(BenchRunner & runner)
+    {
+        for (unsigned int size : { 64, 1024, 65536 })
+        {
+            vector<unsigned char> input(size, 0x3C);
+
+            runner.Run("crypto/sha2_256_" + to_string(size), [&](uint64_t numOps)
+            {
+                SHA2<HASH_TYPE::HASH_VARIANT_256> sha2;
+                for (uint64_t i = 0; i < numOps; i++)
+                {
+                    sha2.Reset();
+                    sha2.Update(input);
+                    sha2.Finalize();
+                }
+            });
+        }
+    }
+}
+
+void RegisterCryptoBenchmarks(BenchRunner & runner)
+{
+    if (runner.IsSelected("crypto/schnorr"))
+    {
+        RegisterSchnorr(runner);
+    }
+    if (runner.IsSelected("crypto/multisig"))
+    {
+        RegisterMultiSig(runner);
+    }
+    RegisterSha2(runner);
+}
@@ -0,0 +1,175 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <vector>
+
+#include "BenchRunner.h"
+#include "libData/AccountData/AccountStore.h"
+#include "libData/AccountData/Transaction.h"
+#include "libData/BlockData/Block/TxBlock.h"
+#include "libUtils/TxnRootComputation.h"
+
+using namespace std;
+using namespace boost::multiprecision;
+
+namespace
+{
+    const unsigned int NUM_ACCOUNTS = 1000;
+
+    Address MakeAddress(uint64_t id)
+    {
+        Address addr;
+        for (unsigned int i = 0; i < sizeof(uint64_t); i++)
+        {
+            addr.asArray().at(i) = static_cast<unsigned char>(id >> (8 * i));
+        }
+        return addr;
+    }
+
+    TxnHash MakeHash(uint64_t id)
+    {
+        TxnHash hash;
+        for (unsigned int i = 0; i < sizeof(uint64_t); i++)
+        {
+            hash.asArray().at(i) = static_cast<unsigned char>(id >> (8 * i));
+        }
+        return hash;
+    }
+
+    Transaction MakeTransaction(uint64_t id)
+    {
+        array<unsigned char, PUB_KEY_SIZE> pubKey = {0};
+        array<unsigned char, TRAN_SIG_SIZE> signature;
+        fill(signature.begin(), signature.end(), 0x0F);
+        return Transaction(1, id, MakeAddress(id + 1), MakeAddress(id), 100, pubKey, signature);
+    }
+
+    void RegisterTxnRoot(BenchRunner & runner)
+    {
+        for (unsigned int numTxns : { 100, 1000, 10000 })
+        {
+            vector<TxnHash> hashes;
+            for (unsigned int i = 0; i < numTxns; i++)
+            {
+                hashes.push_back(MakeHash(i));
+            }
+
+            runner.Run("data/txn_root_" + to_string(numTxns), [&](uint64_t numOps)
+            {
+                for (uint64_t i = 0; i < numOps; i++)
+                {
+                    ComputeTransactionsRoot(hashes);
+                }
+            });
+        }
+    }
+
+    void RegisterAccountStore(BenchRunner & runner)
+    {
+        AccountStore & store = AccountStore::GetInstance();
+        for (unsigned int i = 0; i < NUM_ACCOUNTS; i++)
+        {
+            store.AddAccount(MakeAddress(i), uint256_t(1) << 128, 0);
+        }
+
+        // Transfers go round the accounts so balances never run out
+        runner.Run("data/account_transfer", [&](uint64_t numOps)
+        {
+            for (uint64_t i = 0; i < numOps; i++)
+            {
+                store.TransferBalance(MakeAddress(i % NUM_ACCOUNTS), MakeAddress((i + 1) % NUM_ACCOUNTS), 1);
+            }
+        });
+
+        store.DiscardUnsavedUpdates();
+    }
+
+    void RegisterTransaction(BenchRunner & runner)
+    {
+        Transaction tx = MakeTransaction(7);
+        vector<unsigned char> serialized;
+        tx.Serialize(serialized, 0);
+
+        runner.Run("data/txn_serialize", [&](uint64_t numOps)
+        {
+            vector<unsigned char> dst;
+            for (uint64_t i = 0; i < numOps; i++)
+            {
+                tx.Serialize(dst, 0);
+            }
+        });
+
+        runner.Run("data/txn_deserialize", [&](uint64_t numOps)
+        {
+            Transaction result;
+            for (uint64_t i = 0; i < numOps; i++)
+            {
+                result.Deserialize(serialized, 0);
+            }
+        });
+    }
+
+    void RegisterTxBlock(BenchRunner & runner)
+    {
+        const unsigned int numMicroBlocks = 100;
+
+        vector<TxnHash> microBlockHashes;
+        for (unsigned int i = 0; i < numMicroBlocks; i++)
+        {
+            microBlockHashes.push_back(MakeHash(i));
+        }
+
+        PubKey minerPubKey = Schnorr::GetInstance().GenKeyPair().second;
+        array<unsigned char, BLOCK_SIG_SIZE> signature;
+        fill(signature.begin(), signature.end(), 0x11);
+
+        TxBlockHeader header(1, 1, 100, 50, BlockHash(), 1, 12345, ComputeTransactionsRoot(microBlockHashes),
+                             numMicroBlocks * 100, numMicroBlocks, minerPubKey, 0, BlockHash());
+        TxBlock block(header, signature, microBlockHashes);
+
+        vector<unsigned char> serialized;
+        block.Serialize(serialized, 0);
+
+        runner.Run("data/txblock_serialize", [&](uint64_t numOps)
+        {
+            vector<unsigned char> dst;
+            for (uint64_t i = 0; i < numOps; i++)
+            {
+                block.Serialize(dst, 0);
+            }
+        });
+
+        runner.Run("data/txblock_deserialize", [&](uint64_t numOps)
+        {
+            TxBlock result;
+            for (uint64_t i = 0; i < numOps; i++)
+            {
+                result.Deserialize(serialized, 0);
+            }
+        });
+    }
+}
+
+void RegisterDataBenchmarks(BenchRunner & runner)
+{
+    RegisterTxnRoot(runner);
+    if (runner.IsSelected("data/account"))
+    {
+        RegisterAccountStore(runner);
+    }
+    RegisterTransaction(runner);
+    RegisterTxBlock(runner);
+}
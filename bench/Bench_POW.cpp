@@ -0,0 +1,49 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include "BenchRunner.h"
+#include "libPOW/pow.h"
+
+using namespace std;
+
+void RegisterPOWBenchmarks(BenchRunner & runner)
+{
+    if (!runner.IsSelected("pow/"))
+    {
+        return;
+    }
+
+    POW & pow = POW::GetInstance();
+
+    array<unsigned char, UINT256_SIZE> rand1;
+    array<unsigned char, UINT256_SIZE> rand2;
+    rand1.fill('0');
+    rand2.fill('1');
+    boost::multiprecision::uint128_t ipAddr = 0x7F000001;
+    PubKey pubKey = Schnorr::GetInstance().GenKeyPair().second;
+
+    // The lowest difficulty finds a solution within a few light hashes; verifying it costs one
+    ethash_mining_result_t solution = pow.PoWMine(0, 1, rand1, rand2, ipAddr, pubKey, false);
+
+    runner.Run("pow/light_verify", [&](uint64_t numOps)
+    {
+        for (uint64_t i = 0; i < numOps; i++)
+        {
+            pow.PoWVerify(0, 1, rand1, rand2, ipAddr, pubKey, false, solution.winning_nonce, solution.result,
+                          solution.mix_hash);
+        }
+    });
+}
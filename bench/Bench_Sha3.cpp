@@ -0,0 +1,42 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <vector>
+
+#include "BenchRunner.h"
+#include "libCrypto/Sha3.h"
+
+using namespace std;
+
+// Kept apart from Bench_Crypto.cpp because Sha2.h and Sha3.h both define HASH_TYPE
+void RegisterSha3Benchmarks(BenchRunner & runner)
+{
+    for (unsigned int size : { 64, 1024, 65536 })
+    {
+        vector<unsigned char> input(size, 0x3C);
+
+        runner.Run("crypto/sha3_256_" + to_string(size), [&](uint64_t numOps)
+        {
+            SHA3<HASH_TYPE::HASH_VARIANT_256> sha3;
+            for (uint64_t i = 0; i < numOps; i++)
+            {
+                sha3.Reset();
+                sha3.Update(input);
+                sha3.Finalize();
+            }
+        });
+    }
+}
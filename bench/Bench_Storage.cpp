@@ -0,0 +1,102 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <string>
+
+#include <boost/filesystem.hpp>
+#include <leveldb/db.h>
+#include <leveldb/write_batch.h>
+
+#include "BenchRunner.h"
+#include "libPersistence/DB.h"
+
+using namespace std;
+
+namespace
+{
+    const unsigned int VALUE_SIZE = 237; // One serialized transaction
+    const unsigned int BATCH_SIZE = 1000;
+    const unsigned int NUM_LOOKUP_KEYS = 100000;
+
+    string MakeKey(uint64_t id)
+    {
+        // Fixed width so keys sort in insertion order, like block numbers
+        string key = to_string(id);
+        return string(20 - key.size(), '0') + key;
+    }
+
+    void RegisterLevelDB(BenchRunner & runner, const string & dbName)
+    {
+        DB db(dbName);
+        const string value(VALUE_SIZE, 'v');
+
+        // Keys keep growing across runs so each insert writes a fresh key
+        uint64_t nextKey = 0;
+        runner.Run("storage/leveldb_insert", [&](uint64_t numOps)
+        {
+            for (uint64_t i = 0; i < numOps; i++)
+            {
+                db.WriteToDB(MakeKey(nextKey++), value);
+            }
+        });
+
+        runner.Run("storage/leveldb_batch_" + to_string(BATCH_SIZE), [&](uint64_t numOps)
+        {
+            for (uint64_t i = 0; i < numOps; i++)
+            {
+                leveldb::WriteBatch batch;
+                for (unsigned int j = 0; j < BATCH_SIZE; j++)
+                {
+                    batch.Put(MakeKey(nextKey++), value);
+                }
+                db.GetDB()->Write(leveldb::WriteOptions(), &batch);
+            }
+        });
+
+        // Lookups need keys written above, whichever of them ran
+        if (nextKey == 0)
+        {
+            for (; nextKey < NUM_LOOKUP_KEYS; nextKey++)
+            {
+                db.WriteToDB(MakeKey(nextKey), value);
+            }
+        }
+
+        const uint64_t numKeys = min<uint64_t>(nextKey, NUM_LOOKUP_KEYS);
+        runner.Run("storage/leveldb_lookup", [&](uint64_t numOps)
+        {
+            for (uint64_t i = 0; i < numOps; i++)
+            {
+                db.ReadFromDB(MakeKey((i * 7919) % numKeys));
+            }
+        });
+    }
+}
+
+void RegisterStorageBenchmarks(BenchRunner & runner)
+{
+    if (!runner.IsSelected("storage/"))
+    {
+        return;
+    }
+
+    const string dbName = "bench.db";
+    boost::filesystem::remove_all(dbName);
+    RegisterLevelDB(runner, dbName);
+
+    // DB::DeleteDB() leaves its handle for the destructor to free again, so the files are removed here
+    boost::filesystem::remove_all(dbName);
+}
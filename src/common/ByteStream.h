@@ -0,0 +1,403 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#ifndef __BYTESTREAM_H__
+#define __BYTESTREAM_H__
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <boost/multiprecision/cpp_int.hpp>
+
+/// Big-endian loads and stores of numbers into byte buffers.
+///
+/// Built-in integers whose length matches the field are moved with one unaligned load or store
+/// and a byte swap. In a wider field they take its low-order bytes, the rest being zero padding,
+/// so 64-bit indices can use the 32-byte encoding of uint256_t block numbers. Fixed-width boost
+/// integers wider than a double limb (uint256_t) are moved limb by limb through their backend,
+/// without the multiprecision shifts of the generic path. Narrower ones (uint128_t) wrap a native
+/// integer and use the byte loop on it. Any other combination falls back to the byte loop. All
+/// paths produce the format of Serializable::SetNumber.
+namespace BigEndian
+{
+    template <unsigned int N> struct SizedUint;
+    template <> struct SizedUint<2> { typedef uint16_t type; static type Swap(type v) { return __builtin_bswap16(v); } };
+    template <> struct SizedUint<4> { typedef uint32_t type; static type Swap(type v) { return __builtin_bswap32(v); } };
+    template <> struct SizedUint<8> { typedef uint64_t type; static type Swap(type v) { return __builtin_bswap64(v); } };
+
+    /// Converts between host and big-endian byte order.
+    template <class W>
+    inline W ToBigEndian(W v)
+    {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+        return v;
+#else
+        return SizedUint<sizeof(W)>::Swap(v);
+#endif
+    }
+
+    template <class T>
+    struct IsSwappable : std::integral_constant<bool, std::is_integral<T>::value && 
+                                                      ((sizeof(T) == 2) || (sizeof(T) == 4) || (sizeof(T) == 8))>
+    {
+    };
+
+    template <class T>
+    struct IsFixedCppInt : std::false_type
+    {
+    };
+
+    template <unsigned MinBits, unsigned MaxBits, boost::multiprecision::cpp_int_check_type Checked>
+    struct IsFixedCppInt<boost::multiprecision::number<boost::multiprecision::cpp_int_backend<MinBits, MaxBits, 
+                                                       boost::multiprecision::unsigned_magnitude, Checked, void>>>
+        : std::integral_constant<bool, (MinBits == MaxBits) && 
+                                       !boost::multiprecision::backends::is_trivial_cpp_int<
+                                           boost::multiprecision::cpp_int_backend<MinBits, MaxBits, 
+                                           boost::multiprecision::unsigned_magnitude, Checked, void>>::value>
+    {
+    };
+
+    /// Byte loop with the arithmetic of the original Serializable::GetNumber.
+    template <class T>
+    inline T LoadBytewise(const unsigned char * src, unsigned int len)
+    {
+        T result = 0;
+        unsigned int left_shift = (len - 1) * 8;
+        for (unsigned int i = 0; i < len; i++)
+        {
+            T tmp = src[i];
+            result += (tmp << left_shift);
+            left_shift -= 8;
+        }
+        return result;
+    }
+
+    /// Byte loop with the arithmetic of the original Serializable::SetNumber.
+    template <class T>
+    inline void StoreBytewise(unsigned char * dst, const T & value, unsigned int len)
+    {
+        unsigned int right_shift = (len - 1) * 8;
+        for (unsigned int i = 0; i < len; i++)
+        {
+            dst[i] = static_cast<unsigned char>((value >> right_shift) & 0xFF);
+            right_shift -= 8;
+        }
+    }
+
+    /// Other types use the byte loop.
+    template <class T>
+    inline typename std::enable_if<!IsSwappable<T>::value && !IsFixedCppInt<T>::value, T>::type 
+    Load(const unsigned char * src, unsigned int len)
+    {
+        return LoadBytewise<T>(src, len);
+    }
+
+    template <class T>
+    inline typename std::enable_if<!IsSwappable<T>::value && !IsFixedCppInt<T>::value>::type 
+    Store(unsigned char * dst, const T & value, unsigned int len)
+    {
+        StoreBytewise<T>(dst, value, len);
+    }
+
+    /// Built-in integers filling the whole field take one load and a byte swap. Wider fields are
+    /// read from their low-order bytes. A value too large for T reads as the largest T rather than
+    /// being truncated, so a peer cannot turn a huge block number into a small one.
+    template <class T>
+    inline typename std::enable_if<IsSwappable<T>::value, T>::type Load(const unsigned char * src, unsigned int len)
+    {
+        typedef typename SizedUint<sizeof(T)>::type W;
+
+        if (len < sizeof(T))
+        {
+            return LoadBytewise<T>(src, len);
+        }
+
+        for (unsigned int i = 0; i < len - sizeof(W); i++)
+        {
+            if (src[i] != 0)
+            {
+                return std::numeric_limits<T>::max();
+            }
+        }
+
+        W v;
+        std::memcpy(&v, src + len - sizeof(W), sizeof(W));
+        return static_cast<T>(ToBigEndian(v));
+    }
+
+    template <class T>
+    inline typename std::enable_if<IsSwappable<T>::value>::type Store(unsigned char * dst, const T & value, unsigned int len)
+    {
+        typedef typename SizedUint<sizeof(T)>::type W;
+
+        if (len < sizeof(T))
+        {
+            StoreBytewise<T>(dst, value, len);
+            return;
+        }
+
+        std::memset(dst, 0, len - sizeof(W));
+        W v = ToBigEndian(static_cast<W>(value));
+        std::memcpy(dst + len - sizeof(W), &v, sizeof(W));
+    }
+
+    /// Fixed-width boost integers: read the field straight into the limbs, least significant first.
+    template <class T>
+    inline typename std::enable_if<IsFixedCppInt<T>::value, T>::type Load(const unsigned char * src, unsigned int len)
+    {
+        typedef boost::multiprecision::limb_type Limb;
+        const unsigned int LIMB_SIZE = sizeof(Limb);
+
+        T result;
+        auto & backend = result.backend();
+        const unsigned int num_limbs = (len + LIMB_SIZE - 1) / LIMB_SIZE;
+        backend.resize(num_limbs, num_limbs);
+
+        Limb * limbs = backend.limbs();
+        const unsigned int stored_limbs = backend.size();
+        const unsigned char * end = src + len;
+
+        for (unsigned int i = 0; i < stored_limbs; i++)
+        {
+            if (end - src >= (long)LIMB_SIZE)
+            {
+                end -= LIMB_SIZE;
+                Limb v;
+                std::memcpy(&v, end, LIMB_SIZE);
+                limbs[i] = ToBigEndian(v);
+            }
+            else
+            {
+                Limb v = 0;
+                for (const unsigned char * p = src; p < end; p++)
+                {
+                    v = (v << 8) | *p;
+                }
+                end = src;
+                limbs[i] = v;
+            }
+        }
+
+        backend.normalize();
+        return result;
+    }
+
+    /// Fixed-width boost integers: write the limbs straight into the field. Bits that do not fit
+    /// in len bytes are dropped, as with the byte loop.
+    template <class T>
+    inline typename std::enable_if<IsFixedCppInt<T>::value>::type Store(unsigned char * dst, const T & value, unsigned int len)
+    {
+        typedef boost::multiprecision::limb_type Limb;
+        const unsigned int LIMB_SIZE = sizeof(Limb);
+
+        const auto & backend = value.backend();
+        const Limb * limbs = backend.limbs();
+        const unsigned int num_limbs = backend.size();
+
+        std::memset(dst, 0, len);
+        unsigned char * end = dst + len;
+
+        for (unsigned int i = 0; (i < num_limbs) && (end > dst); i++)
+        {
+            if (end - dst >= (long)LIMB_SIZE)
+            {
+                end -= LIMB_SIZE;
+                Limb v = ToBigEndian(limbs[i]);
+                std::memcpy(end, &v, LIMB_SIZE);
+            }
+            else
+            {
+                Limb v = limbs[i];
+                while (end > dst)
+                {
+                    *--end = static_cast<unsigned char>(v & 0xFF);
+                    v >>= 8;
+                }
+            }
+        }
+    }
+
+    static_assert(sizeof(boost::multiprecision::limb_type) == sizeof(uint64_t), 
+                  "BigEndian limb access assumes 64-bit limbs");
+}
+
+/// Compile-time layout of a fixed-size record, given the sizes of its fields in serialized order.
+template <unsigned int... Sizes>
+struct FieldLayout;
+
+template <>
+struct FieldLayout<>
+{
+    static constexpr unsigned int NUM_FIELDS = 0;
+    static constexpr unsigned int SIZE = 0;
+
+    static constexpr unsigned int Offset(unsigned int) { return 0; }
+};
+
+template <unsigned int First, unsigned int... Rest>
+struct FieldLayout<First, Rest...>
+{
+    static constexpr unsigned int NUM_FIELDS = 1 + FieldLayout<Rest...>::NUM_FIELDS;
+    static constexpr unsigned int SIZE = First + FieldLayout<Rest...>::SIZE;
+
+    /// Returns the offset of field index from the start of the record.
+    static constexpr unsigned int Offset(unsigned int index)
+    {
+        return (index == 0) ? 0 : First + FieldLayout<Rest...>::Offset(index - 1);
+    }
+};
+
+/// Writes fields one after another into a byte stream that is sized once up front.
+class ByteWriter
+{
+    std::vector<unsigned char> & m_dst;
+    unsigned int m_offset;
+
+    unsigned char * Claim(unsigned int len)
+    {
+        if (m_dst.size() < m_offset + len)
+        {
+            m_dst.resize(m_offset + len);
+        }
+        unsigned char * p = m_dst.data() + m_offset;
+        m_offset += len;
+        return p;
+    }
+
+public:
+
+    /// Constructor. Grows dst to hold size bytes from offset, if needed, with a single resize.
+    ByteWriter(std::vector<unsigned char> & dst, unsigned int offset, unsigned int size) : m_dst(dst), m_offset(offset)
+    {
+        if (m_dst.size() < offset + size)
+        {
+            m_dst.resize(offset + size);
+        }
+    }
+
+    /// Writes a big-endian number of len bytes.
+    template <class T>
+    void WriteNumber(const T & value, unsigned int len)
+    {
+        BigEndian::Store<T>(Claim(len), value, len);
+    }
+
+    /// Writes raw bytes.
+    void WriteBytes(const unsigned char * src, unsigned int len)
+    {
+        std::memcpy(Claim(len), src, len);
+    }
+
+    /// Writes a fixed-size byte array.
+    template <size_t N>
+    void WriteBytes(const std::array<unsigned char, N> & src)
+    {
+        WriteBytes(src.data(), N);
+    }
+
+    /// Writes a Serializable object that takes up len bytes.
+    template <class S>
+    void WriteObject(const S & obj, unsigned int len)
+    {
+        Claim(len);
+        obj.Serialize(m_dst, m_offset - len);
+    }
+
+    /// Returns the offset of the next byte to be written.
+    unsigned int GetOffset() const { return m_offset; }
+};
+
+/// Reads fields one after another from a byte stream.
+/// Like Serializable::GetNumber, a read past the end yields zeros; Good() reports whether that happened.
+class ByteReader
+{
+    const std::vector<unsigned char> & m_src;
+    unsigned int m_offset;
+    bool m_good;
+
+    const unsigned char * Take(unsigned int len)
+    {
+        if (m_offset + len > m_src.size())
+        {
+            m_good = false;
+            m_offset += len;
+            return nullptr;
+        }
+        const unsigned char * p = m_src.data() + m_offset;
+        m_offset += len;
+        return p;
+    }
+
+public:
+
+    /// Constructor.
+    ByteReader(const std::vector<unsigned char> & src, unsigned int offset) : m_src(src), m_offset(offset), m_good(true)
+    {
+    }
+
+    /// Reads a big-endian number of len bytes.
+    template <class T>
+    T ReadNumber(unsigned int len)
+    {
+        const unsigned char * p = Take(len);
+        return (p == nullptr) ? T(0) : BigEndian::Load<T>(p, len);
+    }
+
+    /// Reads raw bytes.
+    void ReadBytes(unsigned char * dst, unsigned int len)
+    {
+        const unsigned char * p = Take(len);
+        if (p == nullptr)
+        {
+            std::memset(dst, 0, len);
+            return;
+        }
+        std::memcpy(dst, p, len);
+    }
+
+    /// Reads a fixed-size byte array.
+    template <size_t N>
+    void ReadBytes(std::array<unsigned char, N> & dst)
+    {
+        ReadBytes(dst.data(), N);
+    }
+
+    /// Reads a Serializable object that takes up len bytes.
+    template <class S>
+    void ReadObject(S & obj, unsigned int len)
+    {
+        if (m_offset + len > m_src.size())
+        {
+            m_good = false;
+            m_offset += len;
+            return;
+        }
+        obj.Deserialize(m_src, m_offset);
+        m_offset += len;
+    }
+
+    /// Returns the offset of the next byte to be read.
+    unsigned int GetOffset() const { return m_offset; }
+
+    /// Returns false if any read ran past the end of the stream.
+    bool Good() const { return m_good; }
+};
+
+#endif // __BYTESTREAM_H__
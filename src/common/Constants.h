@@ -59,6 +59,11 @@ const unsigned int SEED_PEER_LIST_SIZE = 20;
 // Transaction body sharing
 const unsigned int TX_SHARING_CLUSTER_SIZE = 20;
 
+// Final block fragments: any 1 / FINALBLOCK_FRAGMENT_REDUNDANCY of those sent to a shard rebuild the final block
+// Header = [32-byte FINALBLOCK message hash] [4-byte FINALBLOCK message length] [1-byte k] [1-byte n] [1-byte fragment index] [33-byte DS pubkey]
+const unsigned int FINALBLOCK_FRAGMENT_REDUNDANCY = 3;
+const unsigned int FINALBLOCK_FRAGMENT_HEADER_SIZE = BLOCK_HASH_SIZE + sizeof(uint32_t) + 3 * sizeof(uint8_t) + PUB_KEY_SIZE;
+
 // Networking and mining 
 const unsigned int POW_SIZE = 32;
 const unsigned int IP_SIZE = 16;
@@ -98,5 +103,25 @@ static const unsigned int POW_SUB_BUFFER_TIME(ReadFromConstantsFile("POW_SUB_BUF
 static const unsigned int POW1_DIFFICULTY(ReadFromConstantsFile("POW1_DIFFICULTY"));
 static const unsigned int POW2_DIFFICULTY(ReadFromConstantsFile("POW2_DIFFICULTY"));
 static const unsigned int NUM_FINAL_BLOCK_PER_POW(ReadFromConstantsFile("NUM_FINAL_BLOCK_PER_POW"));
+static const unsigned int CONSENSUS_AGGREGATION_FANOUT(ReadFromConstantsFile("CONSENSUS_AGGREGATION_FANOUT")); // 0 = flat
+static const unsigned int CONSENSUS_AGGREGATION_TIMEOUT_IN_MILLISECONDS(
+	ReadFromConstantsFile("CONSENSUS_AGGREGATION_TIMEOUT_IN_MILLISECONDS")); // backup waits this long for its children
+static const unsigned int CONSENSUS_AGGREGATION_FALLBACK_TIMEOUT_IN_MILLISECONDS(
+	ReadFromConstantsFile("CONSENSUS_AGGREGATION_FALLBACK_TIMEOUT_IN_MILLISECONDS")); // then this long for a challenge before going to the leader
+static const unsigned int CONSENSUS_AGGREGATION_RESPONSE_TIMEOUT_IN_MILLISECONDS(
+	ReadFromConstantsFile("CONSENSUS_AGGREGATION_RESPONSE_TIMEOUT_IN_MILLISECONDS")); // leader waits this long for responses before a recommit
+static const unsigned int CONSENSUS_AGGREGATION_MAX_ATTEMPTS(ReadFromConstantsFile("CONSENSUS_AGGREGATION_MAX_ATTEMPTS"));
+static const unsigned int TXN_POOL_MAX_SIZE_IN_MB(ReadFromConstantsFile("TXN_POOL_MAX_SIZE_IN_MB"));
+static const unsigned int MAX_TXNS_PER_MICROBLOCK(ReadFromConstantsFile("MAX_TXNS_PER_MICROBLOCK"));
+static const unsigned int FETCH_MICROBLOCK_TXNS_TIMEOUT_IN_SECONDS(
+	ReadFromConstantsFile("FETCH_MICROBLOCK_TXNS_TIMEOUT_IN_SECONDS"));
+static const unsigned int TXN_INTAKE_BATCH_SIZE(ReadFromConstantsFile("TXN_INTAKE_BATCH_SIZE"));
+static const unsigned int TXN_INTAKE_BATCH_TIMEOUT_IN_MILLISECONDS(
+	ReadFromConstantsFile("TXN_INTAKE_BATCH_TIMEOUT_IN_MILLISECONDS"));
+static const unsigned int TXN_VERIFY_CACHE_SIZE(ReadFromConstantsFile("TXN_VERIFY_CACHE_SIZE")); // entries
+static const unsigned int METRICS_PORT(ReadFromConstantsFile("METRICS_PORT")); // 0 = no listener
+static const unsigned int METRICS_DUMP_INTERVAL_IN_SECONDS(
+	ReadFromConstantsFile("METRICS_DUMP_INTERVAL_IN_SECONDS")); // 0 = no file dump
+static const unsigned int TRACE_LEVEL(ReadFromConstantsFile("TRACE_LEVEL")); // 0 = off, 1 = phases, 2 = all
 
 #endif // __CONSTANTS_H__
\ No newline at end of file
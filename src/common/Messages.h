@@ -54,7 +54,13 @@ enum NodeInstructionType : unsigned char
     SUBMITTRANSACTION = 0x04,
     MICROBLOCKCONSENSUS = 0x05,
     FINALBLOCK = 0x06,
-    FORWARDTRANSACTION  = 0x07
+    FORWARDTRANSACTION  = 0x07,
+    GETMICROBLOCKTXNS = 0x08,
+    SETMICROBLOCKTXNS = 0x09,
+    FORWARDTXNOFFER = 0x0A,
+    FORWARDTXNSKETCH = 0x0B,
+    FINALBLOCKFRAGMENT = 0x0C,
+    SUBMITTXNBATCH = 0x0D
 };
 
 enum LookupInstructionType : unsigned char
@@ -20,6 +20,8 @@
 
 #include <vector>
 
+#include "common/ByteStream.h"
+
 /// Specifies the interface required for classes that are byte serializable.
 class Serializable
 {
@@ -39,20 +41,12 @@ public:
     template<class numerictype>
     static numerictype GetNumber(const std::vector<unsigned char> & src, unsigned int offset, unsigned int numerictype_len)
     {
-        numerictype result = 0;
-
         if (offset + numerictype_len <= src.size())
         {
-            unsigned int left_shift = (numerictype_len - 1) * 8;
-            for (unsigned int i = 0; i < numerictype_len; i++)
-            {
-                numerictype tmp = src.at(offset + i);
-                result += (tmp << left_shift);
-                left_shift -= 8;
-            }
+            return BigEndian::Load<numerictype>(src.data() + offset, numerictype_len);
         }
 
-        return result;
+        return 0;
     }
 
     /// Template function for placing a number into the destination byte stream at the specified offset.
@@ -60,19 +54,12 @@ public:
     template<class numerictype>
     static void SetNumber(std::vector<unsigned char> & dst, unsigned int offset, numerictype value, unsigned int numerictype_len)
     {
-        const unsigned int length_available = dst.size() - offset;
-
-        if (length_available < numerictype_len)
+        if (dst.size() < offset + numerictype_len)
         {
-            dst.resize(dst.size() + numerictype_len - length_available);
+            dst.resize(offset + numerictype_len);
         }
 
-        unsigned int right_shift = (numerictype_len - 1) * 8;
-        for (unsigned int i = 0; i < numerictype_len; i++)
-        {
-            dst.at(offset + i) = static_cast<unsigned char>((value >> right_shift) & 0xFF);
-            right_shift -= 8;
-        }
+        BigEndian::Store<numerictype>(dst.data() + offset, value, numerictype_len);
     }
 };
 
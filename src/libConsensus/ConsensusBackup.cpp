@@ -20,6 +20,8 @@
 #include "common/Messages.h"
 #include "libUtils/Logger.h"
 #include "libUtils/DataConversion.h"
+#include "libUtils/Executor.h"
+#include "libNetwork/BroadcastTree.h"
 #include "libNetwork/P2PComm.h"
 
 using namespace std;
@@ -301,12 +303,22 @@ bool ConsensusBackup::ProcessMessageAnnounce(const vector<unsigned char> & annou
         // Update internal state
         // =====================
         m_state = COMMIT_DONE;
+        RecordPhase("backup");
 
-        // Unicast to the leader
-        // =====================
+        if (m_aggregating)
+        {
+            // Combine with the subtree and send to the parent
+            // ===============================================
 
-        P2PComm::GetInstance().SendMessage(m_peerInfo.at(m_leaderID), commit);
+            StartAggregationRound(0, 0);
+        }
+        else
+        {
+            // Unicast to the leader
+            // =====================
 
+            P2PComm::GetInstance().SendMessage(m_peerInfo.at(m_leaderID), commit);
+        }
     }
 
     return result;
@@ -475,6 +487,17 @@ bool ConsensusBackup::ProcessMessageChallengeCore(const vector<unsigned char> &
         return false;
     }
 
+    if (m_aggregating)
+    {
+        // Combine with the subtree responses and send to the parent
+        // =========================================================
+
+        m_state = nextstate;
+        RecordPhase("backup");
+        ProcessAggregateChallenge();
+        return true;
+    }
+
     // Generate response
     // =================
 
@@ -487,6 +510,7 @@ bool ConsensusBackup::ProcessMessageChallengeCore(const vector<unsigned char> &
         // =====================
 
         m_state = nextstate;
+        RecordPhase("backup");
         
         // Unicast to the leader
         // =====================
@@ -666,17 +690,27 @@ bool ConsensusBackup::ProcessMessageCollectiveSigCore(const vector<unsigned char
             // =====================
 
             m_state = nextstate;
+            RecordPhase("backup");
 
             // First round: consensus over message (e.g., DS block)
             // Second round: consensus over collective sig
             m_message.clear();
             m_collectiveSig.Serialize(m_message, 0);
 
-            // Unicast to the leader
-            // =====================
+            if (m_aggregating)
+            {
+                // Combine with the subtree and send to the parent
+                // ===============================================
 
-            P2PComm::GetInstance().SendMessage(m_peerInfo.at(m_leaderID), finalcommit);
+                StartAggregationRound(1, 0);
+            }
+            else
+            {
+                // Unicast to the leader
+                // =====================
 
+                P2PComm::GetInstance().SendMessage(m_peerInfo.at(m_leaderID), finalcommit);
+            }
         }
     }
     else
@@ -685,6 +719,7 @@ bool ConsensusBackup::ProcessMessageCollectiveSigCore(const vector<unsigned char
         // =====================
 
         m_state = nextstate;
+        RecordPhase("backup");
     }
 
     return result;
@@ -708,6 +743,549 @@ bool ConsensusBackup::ProcessMessageFinalCollectiveSig(const vector<unsigned cha
     return ProcessMessageCollectiveSigCore(finalcollectivesig, offset, PROCESS_FINALCOLLECTIVESIG, DONE);
 }
 
+void ConsensusBackup::StartAggregationRound(unsigned int round, uint8_t attempt)
+{
+    LOG_MARKER();
+
+    vector<pair<vector<unsigned char>, unsigned int>> parked;
+
+    {
+        lock_guard<mutex> g(m_aggregation->m_mutex);
+        AggregationState & state = *m_aggregation;
+
+        if ((round > state.m_round) || ((round == state.m_round) && (attempt > state.m_attempt)))
+        {
+            // Pieces of the previous round or attempt are of no further use
+            state.m_flushTimer.Cancel();
+            state.m_fallbackTimer.Cancel();
+            state.m_round = round;
+            state.m_attempt = attempt;
+            state.m_flushed = false;
+            state.m_fellBack = false;
+            state.m_challenged = false;
+            state.m_responded = false;
+            state.m_sentMembers.clear();
+            state.m_sentMessage.clear();
+            state.m_children.clear();
+            parked.swap(state.m_parked);
+        }
+
+        state.m_ready = true;
+        state.m_ownCommit = *m_commitPoint;
+
+        if (state.m_children.size() == m_childIDs.size())
+        {
+            FlushAggregateCommit();
+        }
+        else
+        {
+            // Do not wait on missing children forever - send up whatever has arrived by then
+            shared_ptr<AggregationState> state_ptr = m_aggregation;
+            auto flush_func = [this, state_ptr, round, attempt]() -> void
+            {
+                lock_guard<mutex> g(state_ptr->m_mutex);
+                if (state_ptr->m_alive && (state_ptr->m_round == round) && (state_ptr->m_attempt == attempt) && !state_ptr->m_flushed)
+                {
+                    LOG_MESSAGE("Aggregation timeout - sending " << state_ptr->m_children.size() << " out of " << m_childIDs.size() << " child commits");
+                    FlushAggregateCommit();
+                }
+            };
+            state.m_flushTimer = Executor::GetInstance().PostBlockingAfter(chrono::milliseconds(CONSENSUS_AGGREGATION_TIMEOUT_IN_MILLISECONDS), flush_func);
+        }
+    }
+
+    // Replay child messages that arrived ahead of this round
+    for (const auto & message : parked)
+    {
+        ProcessMessage(message.first, message.second);
+    }
+}
+
+bool ConsensusBackup::ProcessMessageRecommit(const vector<unsigned char> & recommit, unsigned int offset)
+{
+    LOG_MARKER();
+
+    if (!m_aggregating)
+    {
+        LOG_MESSAGE("Error: Recommit received but aggregation is disabled");
+        return false;
+    }
+
+    // Extract and check recommit message body
+    // =======================================
+
+    // Format: [4-byte consensus id] [32-byte blockhash] [2-byte leader id] [1-byte round] [1-byte attempt] [N-byte bitmap] [64-byte signature]
+
+    const unsigned int bitmap_size = GetBitVectorLengthInBytes(m_pubKeys.size()) + 2;
+    const unsigned int length_available = recommit.size() - offset;
+    const unsigned int length_needed = sizeof(uint32_t) + BLOCK_HASH_SIZE + sizeof(uint16_t) + sizeof(uint8_t) + sizeof(uint8_t) + bitmap_size + SIGNATURE_CHALLENGE_SIZE + SIGNATURE_RESPONSE_SIZE;
+
+    if (length_needed > length_available)
+    {
+        LOG_MESSAGE("Error: Malformed message");
+        return false;
+    }
+
+    unsigned int curr_offset = offset;
+
+    // 4-byte consensus id
+    uint32_t consensus_id = Serializable::GetNumber<uint32_t>(recommit, curr_offset, sizeof(uint32_t));
+    curr_offset += sizeof(uint32_t);
+
+    // Check the consensus id
+    if (consensus_id != m_consensusID)
+    {
+        LOG_MESSAGE("Error: Consensus ID in recommit (" << consensus_id << ") does not match instance consensus ID (" << m_consensusID << ")");
+        return false;
+    }
+
+    // 32-byte blockhash
+
+    // Check the block hash
+    if (equal(m_blockHash.begin(), m_blockHash.end(), recommit.begin() + curr_offset) == false)
+    {
+        LOG_MESSAGE("Error: Block hash in recommit does not match instance block hash");
+        return false;
+    }
+    curr_offset += BLOCK_HASH_SIZE;
+
+    // 2-byte leader id
+    uint32_t leader_id = Serializable::GetNumber<uint16_t>(recommit, curr_offset, sizeof(uint16_t));
+    curr_offset += sizeof(uint16_t);
+
+    // Check the leader id
+    if (leader_id != m_leaderID)
+    {
+        LOG_MESSAGE("Error: Leader ID mismatch");
+        return false;
+    }
+
+    // 1-byte round
+    unsigned int round = Serializable::GetNumber<uint8_t>(recommit, curr_offset, sizeof(uint8_t));
+    curr_offset += sizeof(uint8_t);
+
+    // 1-byte attempt
+    uint8_t attempt = Serializable::GetNumber<uint8_t>(recommit, curr_offset, sizeof(uint8_t));
+    curr_offset += sizeof(uint8_t);
+
+    // N-byte bitmap
+    vector<bool> blamed = GetBitVector(recommit, curr_offset, GetBitVectorLengthInBytes(m_pubKeys.size()));
+    curr_offset += bitmap_size;
+
+    if (blamed.size() != m_pubKeys.size())
+    {
+        LOG_MESSAGE("Error: Invalid bitmap in recommit");
+        return false;
+    }
+
+    // 64-byte signature
+    Signature signature(recommit, curr_offset);
+
+    // Check the signature
+    bool sig_valid = VerifyMessage(recommit, offset, curr_offset - offset, signature, m_leaderID);
+    if (sig_valid == false)
+    {
+        LOG_MESSAGE("Error: Invalid signature in recommit message");
+        return false;
+    }
+
+    // The round being retried must be the one in progress here
+    const bool in_round_0 = (m_state == COMMIT_DONE) || (m_state == RESPONSE_DONE);
+    const bool in_round_1 = (m_state == FINALCOMMIT_DONE) || (m_state == FINALRESPONSE_DONE);
+    if (!((round == 0) && in_round_0) && !((round == 1) && in_round_1))
+    {
+        LOG_MESSAGE("Error: Recommit for round " << round << " in state " << m_state);
+        return false;
+    }
+
+    {
+        lock_guard<mutex> g(m_aggregation->m_mutex);
+
+        if ((round != m_aggregation->m_round) || (attempt <= m_aggregation->m_attempt))
+        {
+            LOG_MESSAGE("Error: Recommit for an attempt already made");
+            return false;
+        }
+
+        m_aggregation->m_blamed = move(blamed);
+    }
+
+    // Generate a fresh commit - the previous one may already have answered a challenge
+    // ==================================================================================
+
+    const ConsensusMessageType type = (round == 0) ? ConsensusMessageType::COMMIT : ConsensusMessageType::FINALCOMMIT;
+    vector<unsigned char> commit = { m_classByte, m_insByte, static_cast<unsigned char>(type) };
+    if (!GenerateCommitMessage(commit, MessageOffset::BODY + sizeof(unsigned char)))
+    {
+        return false;
+    }
+
+    // Update internal state
+    // =====================
+
+    m_state = (round == 0) ? COMMIT_DONE : FINALCOMMIT_DONE;
+
+    LOG_MESSAGE("Leader retries round " << round << " (attempt " << (unsigned int)attempt << ")");
+
+    StartAggregationRound(round, attempt);
+
+    return true;
+}
+
+bool ConsensusBackup::ProcessMessageAggregateCommit(const vector<unsigned char> & commit, unsigned int offset, unsigned int round)
+{
+    LOG_MARKER();
+
+    if (!m_aggregating)
+    {
+        LOG_MESSAGE("Error: Aggregated commit received but aggregation is disabled");
+        return false;
+    }
+
+    // Extract and check aggregated commit message body
+    // ================================================
+
+    // Format: [4-byte consensus id] [32-byte blockhash] [2-byte sender id] [1-byte attempt] [N-byte bitmap] [33-byte aggregated commit] [64-byte signature]
+
+    uint16_t sender_id;
+    uint8_t attempt;
+    vector<bool> members;
+    unsigned int aggregate_offset;
+
+    if (!ReadAggregateMessage(commit, offset, COMMIT_POINT_SIZE, m_leaderID, sender_id, attempt, members, aggregate_offset))
+    {
+        return false;
+    }
+
+    lock_guard<mutex> g(m_aggregation->m_mutex);
+    AggregationState & state = *m_aggregation;
+
+    if ((round < state.m_round) || ((round == state.m_round) && (attempt < state.m_attempt)))
+    {
+        LOG_MESSAGE("Error: Aggregated commit for a finished round or attempt");
+        return false;
+    }
+    if ((round > state.m_round) || (attempt > state.m_attempt))
+    {
+        state.m_parked.emplace_back(commit, offset - 1);
+        return true;
+    }
+
+    if (find(m_childIDs.begin(), m_childIDs.end(), sender_id) == m_childIDs.end())
+    {
+        LOG_MESSAGE("Error: Aggregated commit from " << sender_id << " who is not a child");
+        return false;
+    }
+    if ((members.at(m_myID) == true) || (members.at(m_leaderID) == true))
+    {
+        LOG_MESSAGE("Error: Aggregated commit from " << sender_id << " includes an ancestor");
+        return false;
+    }
+    if (state.m_children.find(sender_id) != state.m_children.end())
+    {
+        LOG_MESSAGE("Error: Child " << sender_id << " has already sent an aggregated commit");
+        return false;
+    }
+    for (unsigned int i = 0; i < state.m_blamed.size(); i++)
+    {
+        if ((members.at(i) == true) && (state.m_blamed.at(i) == true))
+        {
+            LOG_MESSAGE("Error: Aggregated commit from " << sender_id << " includes " << i << " who failed to respond before");
+            return false;
+        }
+    }
+
+    // 33-byte aggregated commit
+    CommitPoint child_commit(commit, aggregate_offset);
+    if (child_commit.Initialized() == false)
+    {
+        LOG_MESSAGE("Error: Invalid aggregated commit from " << sender_id);
+        return false;
+    }
+
+    ChildPiece & piece = state.m_children[sender_id];
+    piece.m_members = move(members);
+    piece.m_commit = child_commit;
+    piece.m_hasResponse = false;
+    piece.m_included = !state.m_flushed;
+
+    if (state.m_flushed)
+    {
+        // Too late for the aggregate already sent up - let the leader count it on its own
+        P2PComm::GetInstance().SendMessage(m_peerInfo.at(m_leaderID), commit);
+    }
+    else if (state.m_ready && (state.m_children.size() == m_childIDs.size()))
+    {
+        FlushAggregateCommit();
+    }
+
+    return true;
+}
+
+void ConsensusBackup::FlushAggregateCommit()
+{
+    LOG_MARKER();
+
+    // Caller holds m_aggregation->m_mutex
+    AggregationState & state = *m_aggregation;
+
+    state.m_flushTimer.Cancel();
+
+    if ((state.m_blamed.size() > 0) && (state.m_blamed.at(m_myID) == true))
+    {
+        // The leader would refuse any aggregate including this backup - the children go to the leader directly
+        LOG_MESSAGE("Blamed for a missing response before - not aggregating this attempt");
+        state.m_flushed = true;
+        return;
+    }
+
+    vector<CommitPoint> commits = { state.m_ownCommit };
+    state.m_sentMembers.assign(m_pubKeys.size(), false);
+    state.m_sentMembers.at(m_myID) = true;
+
+    for (auto & child : state.m_children)
+    {
+        child.second.m_included = true;
+        commits.push_back(child.second.m_commit);
+        for (unsigned int i = 0; i < child.second.m_members.size(); i++)
+        {
+            if (child.second.m_members.at(i) == true)
+            {
+                state.m_sentMembers.at(i) = true;
+            }
+        }
+    }
+
+    shared_ptr<CommitPoint> aggregated_commit = MultiSig::AggregateCommits(commits);
+    if (aggregated_commit == nullptr)
+    {
+        LOG_MESSAGE("Error: Aggregating commits failed");
+        return;
+    }
+
+    const ConsensusMessageType type = (state.m_round == 0) ? AGGREGATECOMMIT : AGGREGATEFINALCOMMIT;
+    state.m_sentMessage = { m_classByte, m_insByte, static_cast<unsigned char>(type) };
+    if (!GenerateAggregateMessage(state.m_sentMessage, MessageOffset::BODY + sizeof(unsigned char), state.m_attempt, state.m_sentMembers, *aggregated_commit))
+    {
+        return;
+    }
+    state.m_flushed = true;
+
+    const uint16_t target = GetAggregationTarget();
+    P2PComm::GetInstance().SendMessage(m_peerInfo.at(target), state.m_sentMessage);
+
+    if (target != m_leaderID)
+    {
+        // If the parent is down, no challenge will come - go to the leader directly instead
+        shared_ptr<AggregationState> state_ptr = m_aggregation;
+        const unsigned int round = state.m_round;
+        const uint8_t attempt = state.m_attempt;
+        auto fallback_func = [this, state_ptr, round, attempt]() -> void
+        {
+            lock_guard<mutex> g(state_ptr->m_mutex);
+            if (state_ptr->m_alive)
+            {
+                FallBackToLeader(round, attempt);
+            }
+        };
+        state.m_fallbackTimer = Executor::GetInstance().PostBlockingAfter(chrono::milliseconds(CONSENSUS_AGGREGATION_FALLBACK_TIMEOUT_IN_MILLISECONDS), fallback_func);
+    }
+}
+
+uint16_t ConsensusBackup::GetAggregationTarget() const
+{
+    // Caller holds m_aggregation->m_mutex
+    const AggregationState & state = *m_aggregation;
+
+    // The leader refuses anything a blamed parent aggregates, so skip it
+    if ((state.m_blamed.size() > 0) && (state.m_blamed.at(m_parentID) == true))
+    {
+        return m_leaderID;
+    }
+
+    return m_parentID;
+}
+
+void ConsensusBackup::FallBackToLeader(unsigned int round, uint8_t attempt)
+{
+    // Caller holds m_aggregation->m_mutex
+    AggregationState & state = *m_aggregation;
+
+    if ((state.m_round != round) || (state.m_attempt != attempt) || state.m_challenged || state.m_fellBack)
+    {
+        return;
+    }
+
+    LOG_MESSAGE("No challenge from the leader - sending aggregated commit directly");
+
+    state.m_fellBack = true;
+    P2PComm::GetInstance().SendMessage(m_peerInfo.at(m_leaderID), state.m_sentMessage);
+}
+
+void ConsensusBackup::ProcessAggregateChallenge()
+{
+    LOG_MARKER();
+
+    Response own_response(*m_commitSecret, m_challenge, m_myPrivKey);
+
+    lock_guard<mutex> g(m_aggregation->m_mutex);
+    AggregationState & state = *m_aggregation;
+
+    if (state.m_challenged)
+    {
+        return;
+    }
+
+    state.m_fallbackTimer.Cancel();
+    state.m_challenged = true;
+    state.m_challenge = m_challenge;
+    state.m_ownResponse = own_response;
+
+    // Check the child responses that arrived ahead of the challenge
+    for (auto & child : state.m_children)
+    {
+        ChildPiece & piece = child.second;
+        if (piece.m_included && piece.m_hasResponse && 
+            (MultiSig::VerifyResponse(piece.m_response, m_challenge, AggregateKeys(piece.m_members), piece.m_commit) == false))
+        {
+            LOG_MESSAGE("Error: Invalid aggregated response from " << child.first);
+            piece.m_hasResponse = false;
+        }
+    }
+
+    FlushAggregateResponse();
+}
+
+bool ConsensusBackup::ProcessMessageAggregateResponse(const vector<unsigned char> & response, unsigned int offset, unsigned int round)
+{
+    LOG_MARKER();
+
+    if (!m_aggregating)
+    {
+        LOG_MESSAGE("Error: Aggregated response received but aggregation is disabled");
+        return false;
+    }
+
+    // Extract and check aggregated response message body
+    // ==================================================
+
+    // Format: [4-byte consensus id] [32-byte blockhash] [2-byte sender id] [1-byte attempt] [N-byte bitmap] [32-byte aggregated response] [64-byte signature]
+
+    uint16_t sender_id;
+    uint8_t attempt;
+    vector<bool> members;
+    unsigned int aggregate_offset;
+
+    if (!ReadAggregateMessage(response, offset, RESPONSE_SIZE, m_leaderID, sender_id, attempt, members, aggregate_offset))
+    {
+        return false;
+    }
+
+    lock_guard<mutex> g(m_aggregation->m_mutex);
+    AggregationState & state = *m_aggregation;
+
+    if ((round < state.m_round) || ((round == state.m_round) && (attempt < state.m_attempt)))
+    {
+        LOG_MESSAGE("Error: Aggregated response for a finished round or attempt");
+        return false;
+    }
+    if ((round > state.m_round) || (attempt > state.m_attempt))
+    {
+        state.m_parked.emplace_back(response, offset - 1);
+        return true;
+    }
+
+    auto child = state.m_children.find(sender_id);
+    if ((child == state.m_children.end()) || (child->second.m_members != members))
+    {
+        LOG_MESSAGE("Error: Aggregated response from " << sender_id << " does not match an aggregated commit");
+        return false;
+    }
+
+    ChildPiece & piece = child->second;
+
+    if (!piece.m_included)
+    {
+        // The leader holds this commit, so it gets the response as well
+        P2PComm::GetInstance().SendMessage(m_peerInfo.at(m_leaderID), response);
+        return true;
+    }
+    if (piece.m_hasResponse)
+    {
+        LOG_MESSAGE("Error: Child " << sender_id << " has already sent an aggregated response");
+        return false;
+    }
+
+    // 32-byte aggregated response
+    Response child_response(response, aggregate_offset);
+
+    if (state.m_challenged && 
+        (MultiSig::VerifyResponse(child_response, state.m_challenge, AggregateKeys(piece.m_members), piece.m_commit) == false))
+    {
+        LOG_MESSAGE("Error: Invalid aggregated response from " << sender_id);
+        return false;
+    }
+
+    piece.m_response = child_response;
+    piece.m_hasResponse = true;
+
+    FlushAggregateResponse();
+
+    return true;
+}
+
+void ConsensusBackup::FlushAggregateResponse()
+{
+    // Caller holds m_aggregation->m_mutex
+    AggregationState & state = *m_aggregation;
+
+    if (!state.m_challenged || state.m_responded)
+    {
+        return;
+    }
+
+    // Wait until every child covered by the aggregated commit has responded
+    vector<Response> responses = { state.m_ownResponse };
+    for (const auto & child : state.m_children)
+    {
+        if (!child.second.m_included)
+        {
+            continue;
+        }
+        if (!child.second.m_hasResponse)
+        {
+            return;
+        }
+        responses.push_back(child.second.m_response);
+    }
+
+    LOG_MARKER();
+
+    shared_ptr<Response> aggregated_response = MultiSig::AggregateResponses(responses);
+    if (aggregated_response == nullptr)
+    {
+        LOG_MESSAGE("Error: Aggregating responses failed");
+        return;
+    }
+
+    const ConsensusMessageType type = (state.m_round == 0) ? AGGREGATERESPONSE : AGGREGATEFINALRESPONSE;
+    vector<unsigned char> response = { m_classByte, m_insByte, static_cast<unsigned char>(type) };
+    if (!GenerateAggregateMessage(response, MessageOffset::BODY + sizeof(unsigned char), state.m_attempt, state.m_sentMembers, *aggregated_response))
+    {
+        return;
+    }
+    state.m_responded = true;
+
+    const uint16_t target = GetAggregationTarget();
+    P2PComm::GetInstance().SendMessage(m_peerInfo.at(target), response);
+
+    // After a fallback the leader may hold this commit rather than the parent
+    if (state.m_fellBack && (target != m_leaderID))
+    {
+        P2PComm::GetInstance().SendMessage(m_peerInfo.at(m_leaderID), response);
+    }
+}
+
 ConsensusBackup::ConsensusBackup
 (
     uint32_t consensus_id,
@@ -719,19 +1297,47 @@ ConsensusBackup::ConsensusBackup
     const deque<Peer> & peer_info,
     unsigned char class_byte,
     unsigned char ins_byte,
-    MsgContentValidatorFunc msg_validator
-) : ConsensusCommon(consensus_id, block_hash, node_id, privkey, pubkeys, peer_info, class_byte, ins_byte), m_commitSecret(nullptr), m_commitPoint(nullptr)
+    MsgContentValidatorFunc msg_validator,
+    unsigned int aggregation_fanout
+) : ConsensusCommon(consensus_id, block_hash, node_id, privkey, pubkeys, peer_info, class_byte, ins_byte, aggregation_fanout), m_commitSecret(nullptr), m_commitPoint(nullptr)
 {
     LOG_MARKER();
 
     m_state = INITIAL;
     m_leaderID = leader_id;
     m_msgContentValidator = msg_validator;
+
+    // Aggregation tree rooted at the leader
+    m_aggregating = (m_aggregationFanout > 0);
+    m_parentID = m_leaderID;
+    if (m_aggregating)
+    {
+        BroadcastTree tree(m_pubKeys.size(), m_aggregationFanout, m_leaderID);
+        m_parentID = tree.GetParent(m_myID);
+        for (unsigned int child : tree.GetChildren(m_myID))
+        {
+            m_childIDs.push_back(child);
+        }
+    }
+
+    m_aggregation = make_shared<AggregationState>();
+    m_aggregation->m_alive = true;
+    m_aggregation->m_round = 0;
+    m_aggregation->m_attempt = 0;
+    m_aggregation->m_ready = false;
+    m_aggregation->m_flushed = false;
+    m_aggregation->m_fellBack = false;
+    m_aggregation->m_challenged = false;
+    m_aggregation->m_responded = false;
 }
 
 ConsensusBackup::~ConsensusBackup()
 {
-
+    // Pending aggregation timers share the state and check this flag before touching the backup
+    lock_guard<mutex> g(m_aggregation->m_mutex);
+    m_aggregation->m_alive = false;
+    m_aggregation->m_flushTimer.Cancel();
+    m_aggregation->m_fallbackTimer.Cancel();
 }
 
 bool ConsensusBackup::ProcessMessage(const vector<unsigned char> & message, unsigned int offset)
@@ -759,6 +1365,21 @@ bool ConsensusBackup::ProcessMessage(const vector<unsigned char> & message, unsi
         case ConsensusMessageType::FINALCOLLECTIVESIG:
             result = ProcessMessageFinalCollectiveSig(message, offset + 1);
             break;
+        case ConsensusMessageType::AGGREGATECOMMIT:
+            result = ProcessMessageAggregateCommit(message, offset + 1, 0);
+            break;
+        case ConsensusMessageType::AGGREGATERESPONSE:
+            result = ProcessMessageAggregateResponse(message, offset + 1, 0);
+            break;
+        case ConsensusMessageType::AGGREGATEFINALCOMMIT:
+            result = ProcessMessageAggregateCommit(message, offset + 1, 1);
+            break;
+        case ConsensusMessageType::AGGREGATEFINALRESPONSE:
+            result = ProcessMessageAggregateResponse(message, offset + 1, 1);
+            break;
+        case ConsensusMessageType::RECOMMIT:
+            result = ProcessMessageRecommit(message, offset + 1);
+            break;
         default:
         LOG_MESSAGE("Error: Unknown consensus message received");
             break;
@@ -21,13 +21,16 @@
 #include <vector>
 #include <memory>
 #include <functional>
+#include <map>
 #include <mutex>
 #include <deque>
 
 #include "ConsensusCommon.h"
+#include "common/Constants.h"
 #include "libCrypto/MultiSig.h"
 #include "libNetwork/PeerStore.h"
 #include "libUtils/TimeLockedFunction.h"
+#include "libUtils/TimerWheel.h"
 
 /// Implements the functionality for the consensus committee backup.
 class ConsensusBackup : public ConsensusCommon
@@ -56,6 +59,45 @@ private:
     // Function handler for validating message content
     MsgContentValidatorFunc m_msgContentValidator;
 
+    // Aggregation tree (fanout > 0): commits and responses of the subtree below
+    // this backup are combined here and sent to the parent instead of each going to the leader
+    struct ChildPiece
+    {
+        std::vector<bool> m_members;
+        CommitPoint m_commit;
+        Response m_response;
+        bool m_hasResponse;  // verified once the challenge is known
+        bool m_included;  // covered by the aggregate this backup sent up (otherwise forwarded to the leader as is)
+    };
+
+    struct AggregationState
+    {
+        std::mutex m_mutex;
+        bool m_alive;
+        unsigned int m_round;  // 0 = commit/response over the message, 1 = finalcommit/finalresponse
+        uint8_t m_attempt;     // times the leader has asked for fresh commits in this round
+        bool m_ready;          // own commit generated for this round
+        bool m_flushed;        // aggregated commit sent up
+        bool m_fellBack;       // aggregated commit also sent directly to the leader
+        bool m_challenged;
+        bool m_responded;
+        CommitPoint m_ownCommit;
+        Response m_ownResponse;
+        Challenge m_challenge;
+        std::vector<bool> m_sentMembers;
+        std::vector<bool> m_blamed;  // members whose commits the leader no longer accepts
+        std::vector<unsigned char> m_sentMessage;
+        std::map<uint16_t, ChildPiece> m_children;
+        std::vector<std::pair<std::vector<unsigned char>, unsigned int>> m_parked;
+        TimerHandle m_flushTimer;
+        TimerHandle m_fallbackTimer;
+    };
+
+    bool m_aggregating;
+    uint16_t m_parentID;
+    std::vector<uint16_t> m_childIDs;
+    std::shared_ptr<AggregationState> m_aggregation;
+
     // Internal functions
     bool CheckState(Action action);
     bool ProcessMessageAnnounce(const std::vector<unsigned char> & announcement, unsigned int offset);
@@ -68,6 +110,17 @@ private:
     bool ProcessMessageFinalChallenge(const std::vector<unsigned char> & challenge, unsigned int offset);
     bool ProcessMessageFinalCollectiveSig(const std::vector<unsigned char> & finalcollectivesig, unsigned int offset);
 
+    // Aggregation tree functions
+    void StartAggregationRound(unsigned int round, uint8_t attempt);
+    bool ProcessMessageRecommit(const std::vector<unsigned char> & recommit, unsigned int offset);
+    bool ProcessMessageAggregateCommit(const std::vector<unsigned char> & commit, unsigned int offset, unsigned int round);
+    bool ProcessMessageAggregateResponse(const std::vector<unsigned char> & response, unsigned int offset, unsigned int round);
+    void ProcessAggregateChallenge();
+    void FlushAggregateCommit();
+    void FlushAggregateResponse();
+    void FallBackToLeader(unsigned int round, uint8_t attempt);
+    uint16_t GetAggregationTarget() const;
+
 public:
 
     /// Constructor.
@@ -82,7 +135,8 @@ public:
         const std::deque<Peer> & peer_info,            // IP addresses of peers
         unsigned char class_byte,                      // class byte representing Executable class using this instance of ConsensusBackup
         unsigned char ins_byte,                        // instruction byte representing consensus messages for the Executable class
-        MsgContentValidatorFunc msg_validator          // function handler for validating the content of message for consensus (e.g., Tx block)
+        MsgContentValidatorFunc msg_validator,         // function handler for validating the content of message for consensus (e.g., Tx block)
+        unsigned int aggregation_fanout = CONSENSUS_AGGREGATION_FANOUT // children per backup in the aggregation tree (0 = flat)
     );
 
     /// Destructor.
@@ -19,7 +19,9 @@
 #include "common/Constants.h"
 #include "common/Messages.h"
 #include "libUtils/Logger.h"
+#include "libUtils/Metrics.h"
 #include "libUtils/DataConversion.h"
+#include "libNetwork/BroadcastTree.h"
 #include "libNetwork/P2PComm.h"
 
 using namespace std;
@@ -89,13 +91,16 @@ ConsensusCommon::ConsensusCommon
     const deque<PubKey> & pubkeys,
     const deque<Peer> & peer_info,
     unsigned char class_byte,
-    unsigned char ins_byte
+    unsigned char ins_byte,
+    unsigned int aggregation_fanout
 ) : TOLERANCE_FRACTION((double) 0.667), m_blockHash(block_hash), m_myPrivKey(privkey), m_pubKeys(pubkeys), m_peerInfo(peer_info), m_responseMap(pubkeys.size(), false)
 {
     m_consensusID = consensus_id;
     m_myID = my_id;
     m_classByte = class_byte;
     m_insByte = ins_byte;
+    m_aggregationFanout = aggregation_fanout;
+    m_phaseStart = chrono::steady_clock::now();
 }
 
 ConsensusCommon::~ConsensusCommon()
@@ -103,6 +108,43 @@ ConsensusCommon::~ConsensusCommon()
 
 }
 
+void ConsensusCommon::RecordPhase(const char * role)
+{
+    // Each state is entered when the message exchange named here has completed
+    const char * phase = nullptr;
+    switch (m_state)
+    {
+    case COMMIT_DONE:
+        phase = "announce";
+        break;
+    case CHALLENGE_DONE:
+    case RESPONSE_DONE:
+        phase = "commit";
+        break;
+    case COLLECTIVESIG_DONE:
+    case FINALCOMMIT_DONE:
+        phase = "response";
+        break;
+    case FINALCHALLENGE_DONE:
+    case FINALRESPONSE_DONE:
+        phase = "final_commit";
+        break;
+    case DONE:
+        phase = "final_response";
+        break;
+    default:
+        break;
+    }
+
+    const auto now = chrono::steady_clock::now();
+    if (phase != nullptr)
+    {
+        Metrics::GetInstance().GetHistogram("zilliqa_consensus_phase_seconds", "Duration of each consensus phase",
+                                            string("role=\"") + role + "\",phase=\"" + phase + "\"").Record(now - m_phaseStart);
+    }
+    m_phaseStart = now;
+}
+
 Signature ConsensusCommon::SignMessage(const vector<unsigned char> & msg, unsigned int offset, unsigned int size)
 {
     LOG_MARKER();
@@ -198,6 +240,148 @@ Challenge ConsensusCommon::GetChallenge(const vector<unsigned char> & msg, unsig
     return Challenge(aggregated_commit, aggregated_key, m_message);
 }
 
+bool ConsensusCommon::GenerateAggregateMessage(vector<unsigned char> & dst, unsigned int offset, uint8_t attempt, const vector<bool> & members, const Serializable & aggregate)
+{
+    LOG_MARKER();
+
+    // Format: [4-byte consensus id] [32-byte blockhash] [2-byte sender id] [1-byte attempt] [N-byte bitmap] [aggregated commit or response] [64-byte signature]
+    // Signature is over: [4-byte consensus id] [32-byte blockhash] [2-byte sender id] [1-byte attempt] [N-byte bitmap] [aggregated commit or response]
+    // Note on attempt: the number of times the leader has asked for fresh commits in the current round (see RECOMMIT)
+    // Note on N-byte bitmap: the members whose commits or responses are aggregated, in the same encoding as the collective sig bitmap
+
+    unsigned int curr_offset = offset;
+
+    // 4-byte consensus id
+    Serializable::SetNumber<uint32_t>(dst, curr_offset, m_consensusID, sizeof(uint32_t));
+    curr_offset += sizeof(uint32_t);
+
+    // 32-byte blockhash
+    dst.insert(dst.begin() + curr_offset, m_blockHash.begin(), m_blockHash.end());
+    curr_offset += m_blockHash.size();
+
+    // 2-byte sender id
+    Serializable::SetNumber<uint16_t>(dst, curr_offset, m_myID, sizeof(uint16_t));
+    curr_offset += sizeof(uint16_t);
+
+    // 1-byte attempt
+    Serializable::SetNumber<uint8_t>(dst, curr_offset, attempt, sizeof(uint8_t));
+    curr_offset += sizeof(uint8_t);
+
+    // N-byte bitmap
+    curr_offset += SetBitVector(dst, curr_offset, members);
+
+    // Aggregated commit or response
+    curr_offset += aggregate.Serialize(dst, curr_offset);
+
+    // 64-byte signature
+    Signature signature = SignMessage(dst, offset, curr_offset - offset);
+    if (signature.Initialized() == false)
+    {
+        LOG_MESSAGE("Error: Message signing failed");
+        return false;
+    }
+    signature.Serialize(dst, curr_offset);
+
+    return true;
+}
+
+bool ConsensusCommon::ReadAggregateMessage(const vector<unsigned char> & src, unsigned int offset, unsigned int aggregate_size, uint16_t root_id, uint16_t & sender_id, uint8_t & attempt, vector<bool> & members, unsigned int & aggregate_offset)
+{
+    LOG_MARKER();
+
+    if (m_aggregationFanout == 0)
+    {
+        LOG_MESSAGE("Error: Aggregate received but aggregation is disabled");
+        return false;
+    }
+
+    const unsigned int bitmap_size = GetBitVectorLengthInBytes(m_pubKeys.size()) + 2;
+    const unsigned int length_available = src.size() - offset;
+    const unsigned int length_needed = sizeof(uint32_t) + BLOCK_HASH_SIZE + sizeof(uint16_t) + sizeof(uint8_t) + bitmap_size + aggregate_size + SIGNATURE_CHALLENGE_SIZE + SIGNATURE_RESPONSE_SIZE;
+
+    if (length_needed > length_available)
+    {
+        LOG_MESSAGE("Error: Malformed message");
+        return false;
+    }
+
+    unsigned int curr_offset = offset;
+
+    // 4-byte consensus id
+    uint32_t consensus_id = Serializable::GetNumber<uint32_t>(src, curr_offset, sizeof(uint32_t));
+    curr_offset += sizeof(uint32_t);
+
+    // Check the consensus id
+    if (consensus_id != m_consensusID)
+    {
+        LOG_MESSAGE("Error: Consensus ID in aggregate (" << consensus_id << ") does not match instance consensus ID (" << m_consensusID << ")");
+        return false;
+    }
+
+    // 32-byte blockhash
+
+    // Check the block hash
+    if (equal(m_blockHash.begin(), m_blockHash.end(), src.begin() + curr_offset) == false)
+    {
+        LOG_MESSAGE("Error: Block hash in aggregate does not match instance block hash");
+        return false;
+    }
+    curr_offset += BLOCK_HASH_SIZE;
+
+    // 2-byte sender id
+    sender_id = Serializable::GetNumber<uint16_t>(src, curr_offset, sizeof(uint16_t));
+    curr_offset += sizeof(uint16_t);
+
+    // Check the sender id
+    if (sender_id >= m_pubKeys.size())
+    {
+        LOG_MESSAGE("Error: Sender ID beyond committee size");
+        return false;
+    }
+
+    // 1-byte attempt
+    attempt = Serializable::GetNumber<uint8_t>(src, curr_offset, sizeof(uint8_t));
+    curr_offset += sizeof(uint8_t);
+
+    // N-byte bitmap
+    members = GetBitVector(src, curr_offset, GetBitVectorLengthInBytes(m_pubKeys.size()));
+    curr_offset += bitmap_size;
+
+    // Check the bitmap - the sender always aggregates its own contribution
+    if ((members.size() != m_pubKeys.size()) || (members.at(sender_id) == false))
+    {
+        LOG_MESSAGE("Error: Invalid bitmap in aggregate from " << sender_id);
+        return false;
+    }
+
+    // Check the bitmap - the sender only ever aggregates members of its own subtree
+    BroadcastTree tree(m_pubKeys.size(), m_aggregationFanout, root_id);
+    for (unsigned int i = 0; i < members.size(); i++)
+    {
+        if ((members.at(i) == true) && !tree.IsInSubtree(sender_id, i))
+        {
+            LOG_MESSAGE("Error: Aggregate from " << sender_id << " includes " << i << " outside its subtree");
+            return false;
+        }
+    }
+
+    // Aggregated commit or response - deserialized by the caller
+    aggregate_offset = curr_offset;
+    curr_offset += aggregate_size;
+
+    // 64-byte signature
+    Signature signature(src, curr_offset);
+
+    // Check the signature
+    if (VerifyMessage(src, offset, curr_offset - offset, signature, sender_id) == false)
+    {
+        LOG_MESSAGE("Error: Invalid signature in aggregate message");
+        return false;
+    }
+
+    return true;
+}
+
 ConsensusCommon::State ConsensusCommon::GetState() const
 {
     return m_state;
@@ -18,6 +18,7 @@
 #ifndef __CONSENSUSCOMMON_H__
 #define __CONSENSUSCOMMON_H__
 
+#include <chrono>
 #include <vector>
 #include <memory>
 #include <functional>
@@ -69,7 +70,12 @@ protected:
         FINALCOMMIT = 0x05,
         FINALCHALLENGE = 0x06,
         FINALRESPONSE = 0x07,
-        FINALCOLLECTIVESIG = 0x8
+        FINALCOLLECTIVESIG = 0x8,
+        AGGREGATECOMMIT = 0x09,
+        AGGREGATERESPONSE = 0x0A,
+        AGGREGATEFINALCOMMIT = 0x0B,
+        AGGREGATEFINALRESPONSE = 0x0C,
+        RECOMMIT = 0x0D
     };
 
     State m_state;
@@ -83,6 +89,7 @@ protected:
     std::vector<unsigned char> m_message;
     unsigned char m_classByte;
     unsigned char m_insByte;
+    unsigned int m_aggregationFanout;
 
     // Generated collective signature
     Signature m_collectiveSig;
@@ -90,6 +97,9 @@ protected:
     // Response map for the generated collective signature
     std::vector<bool> m_responseMap;
 
+    // Start of the phase currently in progress, for the phase duration metrics
+    std::chrono::steady_clock::time_point m_phaseStart;
+
     ConsensusCommon
     (
         uint32_t consensus_id,
@@ -99,11 +109,15 @@ protected:
         const std::deque<PubKey> & pubkeys,
         const std::deque<Peer> & peer_info,
         unsigned char class_byte,
-        unsigned char ins_byte
+        unsigned char ins_byte,
+        unsigned int aggregation_fanout
     );
 
     ~ConsensusCommon();
 
+    /// Records the time since the last state change against the phase that m_state has just completed.
+    void RecordPhase(const char * role);
+
     Signature SignMessage(const std::vector<unsigned char> & msg, unsigned int offset, unsigned int size);
     bool VerifyMessage(const std::vector<unsigned char> & msg, unsigned int offset, unsigned int size, const Signature & toverify, uint16_t peer_id);
     PubKey AggregateKeys(const std::vector<bool> peer_map);
@@ -112,6 +126,10 @@ protected:
     Signature AggregateSign(const Challenge & challenge, const Response & aggregated_response);
     Challenge GetChallenge(const std::vector<unsigned char> & msg, unsigned int offset, unsigned int size, const CommitPoint & aggregated_commit, const PubKey & aggregated_key);
 
+    // Aggregated commit and response messages sent up the aggregation tree
+    bool GenerateAggregateMessage(std::vector<unsigned char> & dst, unsigned int offset, uint8_t attempt, const std::vector<bool> & members, const Serializable & aggregate);
+    bool ReadAggregateMessage(const std::vector<unsigned char> & src, unsigned int offset, unsigned int aggregate_size, uint16_t root_id, uint16_t & sender_id, uint8_t & attempt, std::vector<bool> & members, unsigned int & aggregate_offset);
+
 public:
 
     virtual bool ProcessMessage(const std::vector<unsigned char> & message, unsigned int offset)
@@ -20,6 +20,7 @@
 #include "common/Messages.h"
 #include "libUtils/Logger.h"
 #include "libUtils/DataConversion.h"
+#include "libUtils/Executor.h"
 #include "libNetwork/P2PComm.h"
 
 using namespace std;
@@ -291,6 +292,22 @@ bool ConsensusLeader::ProcessMessageCommitCore(const vector<unsigned char> & com
             return false;
         }
 
+        // When aggregating, backups send only aggregated commits. A flat one carries no attempt, so after
+        // a recommit it may be stale, and a blamed member must not rejoin through it.
+        if (m_aggregationFanout > 0)
+        {
+            if (m_blamed.at(backup_id) == true)
+            {
+                LOG_MESSAGE("Error: Commit from " << backup_id << " who failed to respond before");
+                return false;
+            }
+            if (m_attempt != 0)
+            {
+                LOG_MESSAGE("Error: Commit from " << backup_id << " carries no attempt, expected attempt " << (unsigned int)m_attempt);
+                return false;
+            }
+        }
+
         // 33-byte commit
         if (m_commitCounter < m_numForConsensus)
         {
@@ -310,31 +327,7 @@ bool ConsensusLeader::ProcessMessageCommitCore(const vector<unsigned char> & com
 
         if (m_commitCounter == m_numForConsensus)
         {
-            LOG_MESSAGE("Sufficient " << m_numForConsensus << " commits obtained");
-
-            vector<unsigned char> challenge = { m_classByte, m_insByte, static_cast<unsigned char>(returnmsgtype) };
-            result = GenerateChallengeMessage(challenge, MessageOffset::BODY + sizeof(unsigned char));
-            if (result == true)
-            {
-                // Update internal state
-                // =====================
-
-                m_state = nextstate;
-
-                // Multicast to all nodes who send validated commits
-                // =================================================
-
-                vector<Peer> commit_peers;
-                deque<Peer>::const_iterator j = m_peerInfo.begin();
-                for (unsigned int i = 0; i < m_commitMap.size(); i++, j++)
-                {
-                    if (m_commitMap.at(i) == true)
-                    {
-                        commit_peers.push_back(*j);
-                    }
-                }
-                P2PComm::GetInstance().SendMessage(commit_peers, challenge);
-            }
+            result = SendChallenge(returnmsgtype, nextstate);
         }
 
         // Redundant commits
@@ -468,6 +461,247 @@ bool ConsensusLeader::ProcessMessageCommitCore(const vector<unsigned char> & com
     return result;
 }
 
+bool ConsensusLeader::SendChallenge(ConsensusMessageType returnmsgtype, State nextstate)
+{
+    LOG_MESSAGE("Sufficient " << m_commitCounter << " commits obtained");
+
+    vector<unsigned char> challenge = { m_classByte, m_insByte, static_cast<unsigned char>(returnmsgtype) };
+    bool result = GenerateChallengeMessage(challenge, MessageOffset::BODY + sizeof(unsigned char));
+    if (result == true)
+    {
+        // Update internal state
+        // =====================
+
+        m_state = nextstate;
+        RecordPhase("leader");
+
+        // Multicast to all nodes who send validated commits
+        // =================================================
+
+        vector<Peer> commit_peers;
+        deque<Peer>::const_iterator j = m_peerInfo.begin();
+        for (unsigned int i = 0; i < m_commitMap.size(); i++, j++)
+        {
+            if (m_commitMap.at(i) == true)
+            {
+                commit_peers.push_back(*j);
+            }
+        }
+        P2PComm::GetInstance().SendMessage(commit_peers, challenge);
+
+        if (m_aggregationFanout > 0)
+        {
+            // Do not wait on a missing or invalid aggregated response forever
+            const Action action = (nextstate == CHALLENGE_DONE) ? PROCESS_RESPONSE : PROCESS_FINALRESPONSE;
+            const uint8_t attempt = m_attempt;
+            shared_ptr<RetryGuard> guard = m_retryGuard;
+            auto retry_func = [this, guard, action, attempt]() -> void
+            {
+                lock_guard<mutex> g(guard->m_mutex);
+                if (guard->m_alive)
+                {
+                    RetryRound(action, attempt);
+                }
+            };
+            m_responseTimer = Executor::GetInstance().PostBlockingAfter(chrono::milliseconds(CONSENSUS_AGGREGATION_RESPONSE_TIMEOUT_IN_MILLISECONDS), retry_func);
+        }
+    }
+
+    return result;
+}
+
+bool ConsensusLeader::ReleaseCoveredCommits(const vector<bool> & members)
+{
+    // Caller holds m_mutex
+
+    // An aggregated commit cannot be split, so a counted piece must be covered whole by the new one
+    for (const auto & piece : m_commitPieces)
+    {
+        bool overlaps = false;
+        bool covered = true;
+        for (unsigned int i = 0; i < members.size(); i++)
+        {
+            if (piece.second.at(i) == true)
+            {
+                overlaps = overlaps || members.at(i);
+                covered = covered && members.at(i);
+            }
+        }
+        if (overlaps && !covered)
+        {
+            LOG_MESSAGE("Error: Aggregated commit overlaps only part of the one from " << piece.first);
+            return false;
+        }
+    }
+
+    // Drop the covered pieces and individual commits (e.g., a child that fell back before its parent's aggregate came in)
+    for (auto it = m_commitPieces.begin(); it != m_commitPieces.end(); )
+    {
+        if (members.at(it->first) == true)
+        {
+            it = m_commitPieces.erase(it);
+        }
+        else
+        {
+            it++;
+        }
+    }
+
+    unsigned int released = 0;
+    for (unsigned int i = 0; i < members.size(); i++)
+    {
+        if ((members.at(i) == true) && (m_commitMap.at(i) == true))
+        {
+            m_commitMap.at(i) = false;
+            m_commitPointMap.at(i) = CommitPoint();
+            m_commitCounter--;
+            released++;
+        }
+    }
+
+    if (released > 0)
+    {
+        // Every counted commit point is kept at its sender - an individual backup or the aggregator of a piece
+        m_commitPoints.clear();
+        for (unsigned int i = 0; i < m_commitMap.size(); i++)
+        {
+            if (HoldsOwnCommit(i))
+            {
+                m_commitPoints.push_back(m_commitPointMap.at(i));
+            }
+        }
+
+        LOG_MESSAGE("Aggregated commit replaces " << released << " commits already counted");
+    }
+
+    return true;
+}
+
+bool ConsensusLeader::HoldsOwnCommit(unsigned int id) const
+{
+    // Caller holds m_mutex
+
+    // A member covered by someone else's aggregated commit has no commit point here. Checking
+    // m_commitPointMap is not enough, as copies of an empty CommitPoint report themselves initialized.
+    if (m_commitMap.at(id) == false)
+    {
+        return false;
+    }
+
+    for (const auto & piece : m_commitPieces)
+    {
+        if ((piece.first != id) && (piece.second.at(id) == true))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool ConsensusLeader::ProcessMessageAggregateCommitCore(const vector<unsigned char> & commit, unsigned int offset, Action action, ConsensusMessageType returnmsgtype, State nextstate)
+{
+    LOG_MARKER();
+
+    // Initial checks
+    // ==============
+
+    if (!CheckState(action))
+    {
+        return false;
+    }
+
+    // Extract and check aggregated commit message body
+    // ================================================
+
+    // Format: [4-byte consensus id] [32-byte blockhash] [2-byte sender id] [N-byte bitmap] [33-byte aggregated commit] [64-byte signature]
+
+    uint16_t sender_id;
+    uint8_t attempt;
+    vector<bool> members;
+    unsigned int aggregate_offset;
+
+    if (!ReadAggregateMessage(commit, offset, COMMIT_POINT_SIZE, m_myID, sender_id, attempt, members, aggregate_offset))
+    {
+        return false;
+    }
+
+    if (members.at(m_myID) == true)
+    {
+        LOG_MESSAGE("Error: Aggregated commit from " << sender_id << " includes the leader");
+        return false;
+    }
+
+    // 33-byte aggregated commit
+    CommitPoint aggregated_commit(commit, aggregate_offset);
+    if (aggregated_commit.Initialized() == false)
+    {
+        LOG_MESSAGE("Error: Invalid aggregated commit from " << sender_id);
+        return false;
+    }
+
+    // Update internal state
+    // =====================
+
+    lock_guard<mutex> g(m_mutex);
+
+    if (!CheckState(action))
+    {
+        return false;
+    }
+
+    if (attempt != m_attempt)
+    {
+        LOG_MESSAGE("Error: Aggregated commit from " << sender_id << " is for attempt " << (unsigned int)attempt << " instead of " << (unsigned int)m_attempt);
+        return false;
+    }
+
+    unsigned int count = 0;
+    for (unsigned int i = 0; i < members.size(); i++)
+    {
+        if (members.at(i) == true)
+        {
+            if (m_blamed.at(i) == true)
+            {
+                LOG_MESSAGE("Error: Aggregated commit from " << sender_id << " includes " << i << " who failed to respond before");
+                return false;
+            }
+            count++;
+        }
+    }
+
+    if (!ReleaseCoveredCommits(members))
+    {
+        return false;
+    }
+
+    for (unsigned int i = 0; i < members.size(); i++)
+    {
+        if (members.at(i) == true)
+        {
+            m_commitMap.at(i) = true;
+        }
+    }
+    m_commitPoints.push_back(aggregated_commit);
+    m_commitPointMap.at(sender_id) = aggregated_commit;
+    m_commitPieces[sender_id] = move(members);
+    m_commitCounter += count;
+
+    LOG_MESSAGE("Received " << count << " commits from " << sender_id << ", " << m_commitCounter << " out of " << m_numForConsensus << ".");
+
+    // Generate challenge if sufficient commits have been obtained
+    // ===========================================================
+
+    bool result = true;
+
+    if (m_commitCounter >= m_numForConsensus)
+    {
+        result = SendChallenge(returnmsgtype, nextstate);
+    }
+
+    return result;
+}
+
 bool ConsensusLeader::ProcessMessageCommit(const vector<unsigned char> & commit, unsigned int offset)
 {
     LOG_MARKER();
@@ -622,6 +856,11 @@ bool ConsensusLeader::ProcessMessageResponseCore(const vector<unsigned char> & r
         LOG_MESSAGE("Error: Backup has already sent validated response");
         return false;
     }
+    if ((m_commitPieces.find(backup_id) != m_commitPieces.end()) || !HoldsOwnCommit(backup_id))
+    {
+        LOG_MESSAGE("Error: Backup commit was aggregated - expecting an aggregated response");
+        return false;
+    }
 
     // 32-byte response
     Response tmp_response = Response(response, curr_offset);
@@ -665,47 +904,259 @@ bool ConsensusLeader::ProcessMessageResponseCore(const vector<unsigned char> & r
 
     bool result = true;
 
-    if (m_responseCounter == m_numForConsensus)
+    if (m_responseCounter == m_commitCounter)
+    {
+        result = SendCollectiveSig(action, returnmsgtype, nextstate);
+    }
+
+    return result;
+}
+
+bool ConsensusLeader::SendCollectiveSig(Action action, ConsensusMessageType returnmsgtype, State nextstate)
+{
+    LOG_MESSAGE("Sufficient responses obtained");
+
+    vector<unsigned char> collectivesig = { m_classByte, m_insByte, static_cast<unsigned char>(returnmsgtype) };
+    bool result = GenerateCollectiveSigMessage(collectivesig, MessageOffset::BODY + sizeof(unsigned char));
+
+    if (result == true)
     {
-        LOG_MESSAGE("Sufficient responses obtained");
+        // Update internal state
+        // =====================
 
-        vector<unsigned char> collectivesig = { m_classByte, m_insByte, static_cast<unsigned char>(returnmsgtype) };
-        result = GenerateCollectiveSigMessage(collectivesig, MessageOffset::BODY + sizeof(unsigned char));
+        m_state = nextstate;
+        RecordPhase("leader");
+        m_responseTimer.Cancel();
 
-        if (result == true)
+        if (action == PROCESS_RESPONSE)
         {
-            // Update internal state
-            // =====================
+            ResetCommits();
+            m_attempt = 0;
 
-            m_state = nextstate;
+            // First round: consensus over message (e.g., DS block)
+            // Second round: consensus over collective sig
+            m_message.clear();
+            m_collectiveSig.Serialize(m_message, 0);
+        }
 
-            if (action == PROCESS_RESPONSE)
-            {
-                m_commitCounter = 0;
-                m_commitPoints.clear();
-                fill(m_commitMap.begin(), m_commitMap.end(), false);
+        // Multicast to all nodes in the committee
+        // =======================================
 
-                m_commitRedundantCounter = 0;
-                fill(m_commitRedundantMap.begin(), m_commitRedundantMap.end(), false);
+        P2PComm::GetInstance().SendMessage(m_peerInfo, collectivesig);
+    }
 
-                m_responseCounter = 0;
-                m_responseData.clear();
-                fill(m_responseMap.begin(), m_responseMap.end(), false);
+    return result;
+}
 
-                // First round: consensus over message (e.g., DS block)
-                // Second round: consensus over collective sig
-                m_message.clear();
-                m_collectiveSig.Serialize(m_message, 0);
-            }
+void ConsensusLeader::ResetCommits()
+{
+    // Caller holds m_mutex
+
+    m_commitCounter = 0;
+    m_commitPoints.clear();
+    fill(m_commitMap.begin(), m_commitMap.end(), false);
+    fill(m_commitPointMap.begin(), m_commitPointMap.end(), CommitPoint());
+    m_commitPieces.clear();
+
+    m_commitRedundantCounter = 0;
+    fill(m_commitRedundantMap.begin(), m_commitRedundantMap.end(), false);
+
+    m_responseCounter = 0;
+    m_responseData.clear();
+    fill(m_responseMap.begin(), m_responseMap.end(), false);
+}
+
+void ConsensusLeader::RetryRound(Action action, uint8_t attempt)
+{
+    LOG_MARKER();
+
+    lock_guard<mutex> g(m_mutex);
+
+    const State waiting = (action == PROCESS_RESPONSE) ? CHALLENGE_DONE : FINALCHALLENGE_DONE;
+    if ((m_state != waiting) || (m_attempt != attempt))
+    {
+        // Every response came in, or this attempt has already been given up on
+        return;
+    }
+
+    // Blame whoever still owes a response - an individual backup or the aggregator of a piece
+    for (unsigned int i = 0; i < m_commitMap.size(); i++)
+    {
+        if (HoldsOwnCommit(i) && (m_responseMap.at(i) == false))
+        {
+            LOG_MESSAGE("No valid response from " << i << " in time");
+            m_blamed.at(i) = true;
+        }
+    }
+
+    const unsigned int num_blamed = count(m_blamed.begin(), m_blamed.end(), true);
+    if ((attempt + 1u >= CONSENSUS_AGGREGATION_MAX_ATTEMPTS) || (m_pubKeys.size() - 1 - num_blamed < m_numForConsensus))
+    {
+        LOG_MESSAGE("Error: Responses still missing after " << attempt + 1u << " attempts and " << num_blamed << " blamed members");
+        m_state = ERROR;
+        return;
+    }
+
+    // The challenge already went out, so the commits behind it cannot be reused - ask for fresh ones
+    ResetCommits();
+    m_attempt++;
+    m_state = (action == PROCESS_RESPONSE) ? ANNOUNCE_DONE : COLLECTIVESIG_DONE;
+
+    vector<unsigned char> recommit = { m_classByte, m_insByte, static_cast<unsigned char>(ConsensusMessageType::RECOMMIT) };
+    if (!GenerateRecommitMessage(recommit, MessageOffset::BODY + sizeof(unsigned char), (action == PROCESS_RESPONSE) ? 0 : 1))
+    {
+        m_state = ERROR;
+        return;
+    }
+
+    LOG_MESSAGE("Retrying with fresh commits (attempt " << (unsigned int)m_attempt << ")");
+
+    P2PComm::GetInstance().SendMessage(m_peerInfo, recommit);
+}
+
+bool ConsensusLeader::GenerateRecommitMessage(vector<unsigned char> & recommit, unsigned int offset, uint8_t round)
+{
+    LOG_MARKER();
+
+    // Format: [4-byte consensus id] [32-byte blockhash] [2-byte leader id] [1-byte round] [1-byte attempt] [N-byte bitmap] [64-byte signature]
+    // Signature is over: [4-byte consensus id] [32-byte blockhash] [2-byte leader id] [1-byte round] [1-byte attempt] [N-byte bitmap]
+    // Note on round: 0 = commit over the message, 1 = finalcommit over the collective sig
+    // Note on N-byte bitmap: the members blamed for a missing or invalid response, whose commits are no longer accepted
+
+    unsigned int curr_offset = offset;
+
+    // 4-byte consensus id
+    Serializable::SetNumber<uint32_t>(recommit, curr_offset, m_consensusID, sizeof(uint32_t));
+    curr_offset += sizeof(uint32_t);
+
+    // 32-byte blockhash
+    recommit.insert(recommit.begin() + curr_offset, m_blockHash.begin(), m_blockHash.end());
+    curr_offset += m_blockHash.size();
+
+    // 2-byte leader id
+    Serializable::SetNumber<uint16_t>(recommit, curr_offset, m_myID, sizeof(uint16_t));
+    curr_offset += sizeof(uint16_t);
+
+    // 1-byte round
+    Serializable::SetNumber<uint8_t>(recommit, curr_offset, round, sizeof(uint8_t));
+    curr_offset += sizeof(uint8_t);
+
+    // 1-byte attempt
+    Serializable::SetNumber<uint8_t>(recommit, curr_offset, m_attempt, sizeof(uint8_t));
+    curr_offset += sizeof(uint8_t);
+
+    // N-byte bitmap
+    curr_offset += SetBitVector(recommit, curr_offset, m_blamed);
+
+    // 64-byte signature
+    Signature signature = SignMessage(recommit, offset, curr_offset - offset);
+    if (signature.Initialized() == false)
+    {
+        LOG_MESSAGE("Error: Message signing failed");
+        return false;
+    }
+    signature.Serialize(recommit, curr_offset);
+
+    return true;
+}
+
+bool ConsensusLeader::ProcessMessageAggregateResponseCore(const vector<unsigned char> & response, unsigned int offset, Action action, ConsensusMessageType returnmsgtype, State nextstate)
+{
+    LOG_MARKER();
+
+    // Initial checks
+    // ==============
+
+    if (!CheckState(action))
+    {
+        return false;
+    }
+
+    // Extract and check aggregated response message body
+    // ==================================================
+
+    // Format: [4-byte consensus id] [32-byte blockhash] [2-byte sender id] [N-byte bitmap] [32-byte aggregated response] [64-byte signature]
+
+    uint16_t sender_id;
+    uint8_t attempt;
+    vector<bool> members;
+    unsigned int aggregate_offset;
+
+    if (!ReadAggregateMessage(response, offset, RESPONSE_SIZE, m_myID, sender_id, attempt, members, aggregate_offset))
+    {
+        return false;
+    }
+
+    CommitPoint piece_commit;
+    Challenge challenge;
+    {
+        lock_guard<mutex> g(m_mutex);
+
+        if (attempt != m_attempt)
+        {
+            LOG_MESSAGE("Error: Aggregated response from " << sender_id << " is for attempt " << (unsigned int)attempt << " instead of " << (unsigned int)m_attempt);
+            return false;
+        }
+
+        // The response must cover exactly the members of the commit aggregated by the same sender
+        auto piece = m_commitPieces.find(sender_id);
+        if ((piece == m_commitPieces.end()) || (piece->second != members))
+        {
+            LOG_MESSAGE("Error: Aggregated response from " << sender_id << " does not match an aggregated commit");
+            return false;
+        }
+        if (m_responseMap.at(sender_id) == true)
+        {
+            LOG_MESSAGE("Error: Backup has already sent validated response");
+            return false;
+        }
+
+        piece_commit = m_commitPointMap.at(sender_id);
+        challenge = m_challenge;
+    }
+
+    // 32-byte aggregated response
+    Response aggregated_response(response, aggregate_offset);
+
+    if (MultiSig::VerifyResponse(aggregated_response, challenge, AggregateKeys(members), piece_commit) == false)
+    {
+        // A valid one may still come (e.g., after a fallback); otherwise the response timer retries the round
+        LOG_MESSAGE("Error: Invalid aggregated response from " << sender_id);
+        return false;
+    }
 
-            // Multicast to all nodes in the committee
-            // =======================================
+    // Update internal state
+    // =====================
 
-            P2PComm::GetInstance().SendMessage(m_peerInfo, collectivesig);
+    lock_guard<mutex> g(m_mutex);
 
+    if (!CheckState(action) || (attempt != m_attempt) || (m_responseMap.at(sender_id) == true))
+    {
+        return false;
+    }
 
+    unsigned int count = 0;
+    for (unsigned int i = 0; i < members.size(); i++)
+    {
+        if (members.at(i) == true)
+        {
+            m_responseMap.at(i) = true;
+            count++;
         }
     }
+    m_responseData.push_back(aggregated_response);
+    m_responseDataMap.at(sender_id) = aggregated_response;
+    m_responseCounter += count;
+
+    // Generate collective sig if all committed members have responded
+    // ===============================================================
+
+    bool result = true;
+
+    if (m_responseCounter == m_commitCounter)
+    {
+        result = SendCollectiveSig(action, returnmsgtype, nextstate);
+    }
 
     return result;
 }
@@ -824,12 +1275,14 @@ ConsensusLeader::ConsensusLeader
                 const deque<PubKey> & pubkeys,
                 const deque<Peer> & peer_info,
                 unsigned char class_byte,
-                unsigned char ins_byte
-        ) : ConsensusCommon(consensus_id, block_hash, node_id, privkey, pubkeys, peer_info, class_byte, ins_byte), m_commitMap(pubkeys.size(), false), m_commitPointMap(pubkeys.size(), CommitPoint()), m_commitRedundantMap(pubkeys.size(), false), m_commitRedundantPointMap(pubkeys.size(), CommitPoint()), m_responseDataMap(pubkeys.size(), Response())
+                unsigned char ins_byte,
+                unsigned int aggregation_fanout
+        ) : ConsensusCommon(consensus_id, block_hash, node_id, privkey, pubkeys, peer_info, class_byte, ins_byte, aggregation_fanout), m_commitMap(pubkeys.size(), false), m_commitPointMap(pubkeys.size(), CommitPoint()), m_commitRedundantMap(pubkeys.size(), false), m_commitRedundantPointMap(pubkeys.size(), CommitPoint()), m_responseDataMap(pubkeys.size(), Response()), m_attempt(0), m_blamed(pubkeys.size(), false), m_retryGuard(make_shared<RetryGuard>())
 {
     LOG_MARKER();
 
     m_state = INITIAL;
+    m_retryGuard->m_alive = true;
     // m_numForConsensus = (floor(TOLERANCE_FRACTION * (pubkeys.size() - 1)) + 1);
     m_numForConsensus = pubkeys.size() - (ceil(pubkeys.size() * (1 - TOLERANCE_FRACTION)) - 1) - 1;
     LOG_MESSAGE("TOLERANCE_FRACTION " << TOLERANCE_FRACTION << " pubkeys.size() " << pubkeys.size() << " m_numForConsensus " << m_numForConsensus);
@@ -837,7 +1290,10 @@ ConsensusLeader::ConsensusLeader
 
 ConsensusLeader::~ConsensusLeader()
 {
-
+    // A pending response timer shares the guard and checks this flag before touching the leader
+    lock_guard<mutex> g(m_retryGuard->m_mutex);
+    m_retryGuard->m_alive = false;
+    m_responseTimer.Cancel();
 }
 
 bool ConsensusLeader::StartConsensus(const vector<unsigned char> & message)
@@ -902,6 +1358,7 @@ bool ConsensusLeader::StartConsensus(const vector<unsigned char> & message)
     // =====================
 
     m_state = ANNOUNCE_DONE;
+    m_phaseStart = chrono::steady_clock::now();
     m_commitCounter = 0;
     m_commitRedundantCounter = 0;
     m_responseCounter = 0;
@@ -936,6 +1393,18 @@ bool ConsensusLeader::ProcessMessage(const vector<unsigned char> & message, unsi
         case ConsensusMessageType::FINALRESPONSE:
             result = ProcessMessageFinalResponse(message, offset + 1);
             break;
+        case ConsensusMessageType::AGGREGATECOMMIT:
+            result = ProcessMessageAggregateCommitCore(message, offset + 1, PROCESS_COMMIT, CHALLENGE, CHALLENGE_DONE);
+            break;
+        case ConsensusMessageType::AGGREGATERESPONSE:
+            result = ProcessMessageAggregateResponseCore(message, offset + 1, PROCESS_RESPONSE, COLLECTIVESIG, COLLECTIVESIG_DONE);
+            break;
+        case ConsensusMessageType::AGGREGATEFINALCOMMIT:
+            result = ProcessMessageAggregateCommitCore(message, offset + 1, PROCESS_FINALCOMMIT, FINALCHALLENGE, FINALCHALLENGE_DONE);
+            break;
+        case ConsensusMessageType::AGGREGATEFINALRESPONSE:
+            result = ProcessMessageAggregateResponseCore(message, offset + 1, PROCESS_FINALRESPONSE, FINALCOLLECTIVESIG, DONE);
+            break;
         default:
         LOG_MESSAGE("Error: Unknown consensus message received. No: "  << (unsigned int) message.at(offset));
             break;
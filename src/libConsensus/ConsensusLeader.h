@@ -21,13 +21,16 @@
 #include <vector>
 #include <memory>
 #include <functional>
+#include <map>
 #include <mutex>
 #include <deque>
 
 #include "ConsensusCommon.h"
+#include "common/Constants.h"
 #include "libCrypto/MultiSig.h"
 #include "libNetwork/PeerStore.h"
 #include "libUtils/TimeLockedFunction.h"
+#include "libUtils/TimerWheel.h"
 
 /// Implements the functionality for the consensus committee leader.
 class ConsensusLeader : public ConsensusCommon
@@ -53,6 +56,7 @@ class ConsensusLeader : public ConsensusCommon
     unsigned int m_commitRedundantCounter;
     std::vector<bool> m_commitRedundantMap;
     std::vector<CommitPoint> m_commitRedundantPointMap; // ordered list of redundant commits of size = 1/3 of committee size
+    std::map<uint16_t, std::vector<bool>> m_commitPieces; // members covered by each aggregated commit, keyed by aggregating backup
     // Generated challenge
     Challenge m_challenge;
 
@@ -61,6 +65,20 @@ class ConsensusLeader : public ConsensusCommon
     std::vector<Response> m_responseDataMap;
     std::vector<Response> m_responseData;
 
+    // Aggregation tree (fanout > 0): a piece whose aggregated response is still missing or invalid
+    // when the response timer fires cannot be dropped from the challenge, so its aggregator is blamed and the round
+    // is retried with fresh commits from everyone else
+    struct RetryGuard
+    {
+        std::mutex m_mutex;
+        bool m_alive;
+    };
+
+    uint8_t m_attempt;
+    std::vector<bool> m_blamed;
+    TimerHandle m_responseTimer;
+    std::shared_ptr<RetryGuard> m_retryGuard;
+
     // Internal functions
     bool CheckState(Action action);
     bool ProcessMessageCommitCore(const std::vector<unsigned char> & commit, unsigned int offset, Action action, ConsensusMessageType returnmsgtype, State nextstate);
@@ -71,6 +89,15 @@ class ConsensusLeader : public ConsensusCommon
     bool GenerateCollectiveSigMessage(std::vector<unsigned char> & collectivesig, unsigned int offset);
     bool ProcessMessageFinalCommit(const std::vector<unsigned char> & finalcommit, unsigned int offset);
     bool ProcessMessageFinalResponse(const std::vector<unsigned char> & finalresponse, unsigned int offset);
+    bool ProcessMessageAggregateCommitCore(const std::vector<unsigned char> & commit, unsigned int offset, Action action, ConsensusMessageType returnmsgtype, State nextstate);
+    bool ProcessMessageAggregateResponseCore(const std::vector<unsigned char> & response, unsigned int offset, Action action, ConsensusMessageType returnmsgtype, State nextstate);
+    bool SendChallenge(ConsensusMessageType returnmsgtype, State nextstate);
+    bool SendCollectiveSig(Action action, ConsensusMessageType returnmsgtype, State nextstate);
+    bool ReleaseCoveredCommits(const std::vector<bool> & members);
+    bool HoldsOwnCommit(unsigned int id) const;
+    void ResetCommits();
+    void RetryRound(Action action, uint8_t attempt);
+    bool GenerateRecommitMessage(std::vector<unsigned char> & recommit, unsigned int offset, uint8_t round);
 
 public:
 
@@ -84,7 +111,8 @@ public:
         const std::deque<PubKey> & pubkeys,            // ordered lookup table of pubkeys for this committee (includes leader)
         const std::deque<Peer> & peer_info,            // IP addresses of all peers
         unsigned char class_byte,                      // class byte representing Executable class using this instance of ConsensusLeader
-        unsigned char ins_byte                         // instruction byte representing consensus messages for the Executable class
+        unsigned char ins_byte,                        // instruction byte representing consensus messages for the Executable class
+        unsigned int aggregation_fanout = CONSENSUS_AGGREGATION_FANOUT // children per backup in the aggregation tree (0 = flat)
     );
 
     /// Destructor.
@@ -46,7 +46,8 @@ CommitSecret::CommitSecret() : m_s(BN_new(), BN_clear_free), m_initialized(false
             break;
         }
 
-        err = (BN_nnmod(m_s.get(), m_s.get(), curve.m_order.get(), NULL) == 0);
+        unique_ptr<BN_CTX, void (*)(BN_CTX*)> ctx(BN_CTX_new(), BN_CTX_free);
+        err = (ctx == nullptr) || (BN_nnmod(m_s.get(), m_s.get(), curve.m_order.get(), ctx.get()) == 0);
         if (err)
         {
             LOG_MESSAGE("Error: Value to commit gen failed");
@@ -400,7 +401,8 @@ void Challenge::Set(const CommitPoint & aggregatedCommit, const PubKey & aggrega
         return;
     }
 
-    if (BN_nnmod(m_c.get(), m_c.get(), curve.m_order.get(), NULL) == 0)
+    unique_ptr<BN_CTX, void (*)(BN_CTX*)> ctx(BN_CTX_new(), BN_CTX_free);
+    if ((ctx == nullptr) || (BN_nnmod(m_c.get(), m_c.get(), curve.m_order.get(), ctx.get()) == 0))
     {
         LOG_MESSAGE("Error: Could not reduce challenge modulo group order");
         return;
@@ -599,6 +601,8 @@ shared_ptr<PubKey> MultiSig::AggregatePubKeys(const vector<PubKey> & pubkeys)
         }
     }
 
+    aggregatedPubkey->UpdateCompressed();
+
     return aggregatedPubkey;
 }
 
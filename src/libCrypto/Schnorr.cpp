@@ -261,7 +261,7 @@ bool PrivKey::operator==(const PrivKey & r) const
     return (m_initialized && r.m_initialized && (BN_cmp(m_d.get(), r.m_d.get()) == 0));
 }
 
-PubKey::PubKey() : m_P(EC_POINT_new(Schnorr::GetInstance().GetCurve().m_group.get()), EC_POINT_clear_free), m_initialized(false)
+PubKey::PubKey() : m_P(EC_POINT_new(Schnorr::GetInstance().GetCurve().m_group.get()), EC_POINT_clear_free), m_initialized(false), m_compressed{}
 {
     if (m_P == nullptr)
     {
@@ -270,7 +270,7 @@ PubKey::PubKey() : m_P(EC_POINT_new(Schnorr::GetInstance().GetCurve().m_group.ge
     }
 }
 
-PubKey::PubKey(const PrivKey & privkey) : m_P(EC_POINT_new(Schnorr::GetInstance().GetCurve().m_group.get()), EC_POINT_clear_free), m_initialized(false)
+PubKey::PubKey(const PrivKey & privkey) : m_P(EC_POINT_new(Schnorr::GetInstance().GetCurve().m_group.get()), EC_POINT_clear_free), m_initialized(false), m_compressed{}
 {
     if (m_P == nullptr)
     {
@@ -298,15 +298,16 @@ PubKey::PubKey(const PrivKey & privkey) : m_P(EC_POINT_new(Schnorr::GetInstance(
         }
 
         m_initialized = true;
+        UpdateCompressed();
     }
 }
 
-PubKey::PubKey(const vector<unsigned char> & src, unsigned int offset)
+PubKey::PubKey(const vector<unsigned char> & src, unsigned int offset) : m_initialized(false), m_compressed{}
 {
     Deserialize(src, offset);
 }
 
-PubKey::PubKey(const PubKey & src) : m_P(EC_POINT_new(Schnorr::GetInstance().GetCurve().m_group.get()), EC_POINT_clear_free), m_initialized(false)
+PubKey::PubKey(const PubKey & src) : m_P(EC_POINT_new(Schnorr::GetInstance().GetCurve().m_group.get()), EC_POINT_clear_free), m_initialized(false), m_compressed{}
 {
     if (m_P == nullptr)
     {
@@ -326,7 +327,8 @@ PubKey::PubKey(const PubKey & src) : m_P(EC_POINT_new(Schnorr::GetInstance().Get
         }
         else
         {
-            m_initialized = true;
+            m_initialized = src.m_initialized;
+            m_compressed = src.m_compressed;
         }
     }
 }
@@ -341,11 +343,25 @@ bool PubKey::Initialized() const
     return m_initialized;
 }
 
+void PubKey::UpdateCompressed()
+{
+    if (!m_initialized || 
+        (EC_POINT_point2oct(Schnorr::GetInstance().GetCurve().m_group.get(), m_P.get(), POINT_CONVERSION_COMPRESSED, 
+                            m_compressed.data(), PUB_KEY_SIZE, NULL) != PUB_KEY_SIZE))
+    {
+        m_compressed.fill(0x00);
+    }
+}
+
 unsigned int PubKey::Serialize(vector<unsigned char> & dst, unsigned int offset) const
 {
     if (m_initialized)
     {
-        ECPOINTSerialize::SetNumber(dst, offset, PUB_KEY_SIZE, m_P);
+        if (dst.size() < offset + PUB_KEY_SIZE)
+        {
+            dst.resize(offset + PUB_KEY_SIZE);
+        }
+        copy(m_compressed.begin(), m_compressed.end(), dst.begin() + offset);
     }
 
     return PUB_KEY_SIZE;
@@ -363,54 +379,30 @@ void PubKey::Deserialize(const vector<unsigned char> & src, unsigned int offset)
     {
         m_initialized = true;
     }
+    UpdateCompressed();
 }
 
 PubKey & PubKey::operator=(const PubKey & src)
 {
-    m_initialized = (EC_POINT_copy(m_P.get(), src.m_P.get()) == 1);
+    m_initialized = (EC_POINT_copy(m_P.get(), src.m_P.get()) == 1) && src.m_initialized;
+    m_compressed = src.m_compressed;
     return *this;
 }
 
 bool PubKey::operator<(const PubKey & r) const
 {
-    unique_ptr<BN_CTX, void (*)(BN_CTX*)> ctx(BN_CTX_new(), BN_CTX_free);
-    if (ctx == nullptr)
-    {
-        LOG_MESSAGE("Error: Memory allocation failure");
-        throw exception();
-    }
-
-    shared_ptr<BIGNUM> lhs_bnvalue(EC_POINT_point2bn(Schnorr::GetInstance().GetCurve().m_group.get(), m_P.get(), POINT_CONVERSION_COMPRESSED, NULL, ctx.get()), BN_clear_free);
-    shared_ptr<BIGNUM> rhs_bnvalue(EC_POINT_point2bn(Schnorr::GetInstance().GetCurve().m_group.get(), r.m_P.get(), POINT_CONVERSION_COMPRESSED, NULL, ctx.get()), BN_clear_free);
-
-    return (m_initialized && r.m_initialized && (BN_cmp(lhs_bnvalue.get(), rhs_bnvalue.get()) == -1));
+    // Byte-wise order of the compressed encodings matches the numeric order of the encoded points
+    return (m_initialized && r.m_initialized && (m_compressed < r.m_compressed));
 }
 
 bool PubKey::operator>(const PubKey & r) const
 {
-    unique_ptr<BN_CTX, void (*)(BN_CTX*)> ctx(BN_CTX_new(), BN_CTX_free);
-    if (ctx == nullptr)
-    {
-        LOG_MESSAGE("Error: Memory allocation failure");
-        throw exception();
-    }
-
-    shared_ptr<BIGNUM> lhs_bnvalue(EC_POINT_point2bn(Schnorr::GetInstance().GetCurve().m_group.get(), m_P.get(), POINT_CONVERSION_COMPRESSED, NULL, ctx.get()), BN_clear_free);
-    shared_ptr<BIGNUM> rhs_bnvalue(EC_POINT_point2bn(Schnorr::GetInstance().GetCurve().m_group.get(), r.m_P.get(), POINT_CONVERSION_COMPRESSED, NULL, ctx.get()), BN_clear_free);
-
-    return (m_initialized && r.m_initialized && (BN_cmp(lhs_bnvalue.get(), rhs_bnvalue.get()) == 1));
+    return (m_initialized && r.m_initialized && (m_compressed > r.m_compressed));
 }
 
 bool PubKey::operator==(const PubKey & r) const
 {
-    unique_ptr<BN_CTX, void (*)(BN_CTX*)> ctx(BN_CTX_new(), BN_CTX_free);
-    if (ctx == nullptr)
-    {
-        LOG_MESSAGE("Error: Memory allocation failure");
-        throw exception();
-    }
-
-    return (m_initialized && r.m_initialized && (EC_POINT_cmp(Schnorr::GetInstance().GetCurve().m_group.get(), m_P.get(), r.m_P.get(), ctx.get()) == 0));
+    return (m_initialized && r.m_initialized && (m_compressed == r.m_compressed));
 }
 
 Signature::Signature() : m_r(BN_new(), BN_clear_free), m_s(BN_new(), BN_clear_free), m_initialized(false)
@@ -667,7 +659,7 @@ bool Schnorr::Sign(const vector<unsigned char> & message, unsigned int offset, u
                 LOG_MESSAGE("Error: Digest to challenge failed");
             }
 
-            err = (BN_nnmod(result.m_r.get(), result.m_r.get(), m_curve.m_order.get(), NULL) == 0);
+            err = (BN_nnmod(result.m_r.get(), result.m_r.get(), m_curve.m_order.get(), ctx.get()) == 0);
             if (err)
             {
                 LOG_MESSAGE("Error: BIGNUM NNmod failed");
@@ -835,7 +827,7 @@ bool Schnorr::Verify(const vector<unsigned char> & message, unsigned int offset,
             LOG_MESSAGE("Error: Challenge bin2bn conversion failed");
         }    
     
-        err2 = (BN_nnmod(challenge_built.get(), challenge_built.get(), m_curve.m_order.get(), NULL) == 0);
+        err2 = (BN_nnmod(challenge_built.get(), challenge_built.get(), m_curve.m_order.get(), ctx.get()) == 0);
         err = err || err2;
         if (err2)
         {
@@ -21,9 +21,11 @@
 #include <openssl/ec.h>
 #include <openssl/bn.h>
 
+#include <array>
+#include <cstring>
+#include <functional>
 #include <memory>
 #include <vector>
-#include <array>
 
 #include "common/Serializable.h"
 #include "common/Constants.h"
@@ -103,14 +105,19 @@ struct PrivKey : public Serializable
 };
 
 /// Stores information on an EC-Schnorr public key.
+/// The compressed encoding of the point is cached, so serialization, ordering, equality and hashing
+/// work on raw bytes instead of converting the point on every call.
 struct PubKey : public Serializable
 {
-    /// The point on the curve.
+    /// The point on the curve. Call UpdateCompressed() after modifying it in place.
     std::shared_ptr<EC_POINT> m_P;
 
     /// Flag to indicate if parameters have been initialized.
     bool m_initialized;
 
+    /// Cached compressed encoding of m_P (all zeroes if not initialized).
+    std::array<unsigned char, PUB_KEY_SIZE> m_compressed;
+
     /// Default constructor for an uninitialized key.
     PubKey();
 
@@ -129,6 +136,15 @@ struct PubKey : public Serializable
     /// Indicates if key parameters have been initialized.
     bool Initialized() const;
 
+    /// Recomputes the cached compressed encoding from m_P.
+    void UpdateCompressed();
+
+    /// Returns the cached compressed encoding.
+    const std::array<unsigned char, PUB_KEY_SIZE> & GetCompressed() const
+    {
+        return m_compressed;
+    }
+
     /// Implements the Serialize function inherited from Serializable.
     unsigned int Serialize(std::vector<unsigned char> & dst, unsigned int offset) const;
 
@@ -160,6 +176,22 @@ inline std::ostream & operator<<(std::ostream & os, const PubKey & p)
     return os;
 }
 
+namespace std
+{
+    /// Hashes a PubKey by its compressed encoding. The x coordinate is uniformly distributed,
+    /// so its leading bytes are used directly.
+    template <>
+    struct hash<PubKey>
+    {
+        size_t operator()(const PubKey & key) const
+        {
+            size_t h;
+            memcpy(&h, key.m_compressed.data() + 1, sizeof(h));
+            return h ^ key.m_compressed[0];
+        }
+    };
+}
+
 /// Stores information on an EC-Schnorr signature.
 struct Signature : public Serializable
 {
@@ -22,6 +22,7 @@
 #include "depends/common/RLP.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/Logger.h"
+#include "libUtils/Metrics.h"
 
 using namespace std;
 using namespace boost::multiprecision;
@@ -140,6 +141,7 @@ bool AccountStore::UpdateStateTrie(const Address & address, const Account & acco
     dev::RLPStream rlpStream(2);
     rlpStream << account.GetBalance() << account.GetNonce();
     m_state.insert(address, &rlpStream.out());
+    METRICS_COUNTER("zilliqa_state_trie_writes_total", "Account updates written to the state trie").Increment();
 
     return true;
 }
@@ -238,6 +240,7 @@ dev::h256 AccountStore::GetStateRootHash() const
 
 void AccountStore::MoveUpdatesToDisk()
 {
+    MetricTimer timer(METRICS_HISTOGRAM("zilliqa_state_commit_seconds", "Time to commit the state trie to disk"));
     m_state.db()->commit();
     prevRoot = m_state.root();
     // m_state.init();
@@ -0,0 +1,155 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include "ForwardedTxnSet.h"
+#include "TxnVerifier.h"
+#include "libData/BlockData/Block/CompactMicroBlock.h"
+#include "libUtils/TxnRootComputation.h"
+
+using namespace std;
+
+ForwardedTxnSet::ForwardedTxnSet(const TxnHash & txRootHash) : m_txRootHash(txRootHash)
+{
+}
+
+uint64_t ForwardedTxnSet::GetID(uint64_t salt, const TxnHash & tranHash) const
+{
+    return CompactMicroBlock::ComputeKeyedID(salt, m_txRootHash, tranHash);
+}
+
+IBLT ForwardedTxnSet::GetSketch(uint64_t salt, unsigned int numTxns) const
+{
+    // With nothing held, a sketch without cells asks for every body
+    if (m_txns.empty())
+    {
+        return IBLT();
+    }
+
+    // Forwarded bodies are all in the microblock; seeded ones are assumed to be too, bar a margin
+    unsigned int numCandidates = m_candidates.size();
+    unsigned int numConfirmed = m_txns.size() - numCandidates;
+    unsigned int numUnknown = (numTxns > numConfirmed) ? (numTxns - numConfirmed) : 0;
+    unsigned int difference = ((numUnknown > numCandidates) ? (numUnknown - numCandidates) : 
+                                                              (numCandidates - numUnknown)) + 
+                              (numCandidates + CANDIDATE_MISS_DIVISOR - 1) / CANDIDATE_MISS_DIVISOR;
+
+    IBLT sketch(IBLT::GetNumCellsForDifference(difference));
+    for (const auto & tx : m_txns)
+    {
+        sketch.Insert(GetID(salt, tx.first));
+    }
+    return sketch;
+}
+
+unsigned int ForwardedTxnSet::Add(const vector<Transaction> & txns)
+{
+    vector<TxnVerifier::Result> results;
+    TxnVerifier::CheckBatch(txns, 0, 0, results);
+
+    unsigned int numAdded = 0;
+    for (unsigned int i = 0; i < txns.size(); i++)
+    {
+        if (results.at(i) != TxnVerifier::VALID)
+        {
+            continue;
+        }
+
+        // A forwarder naming a seeded body confirms it, whichever of the two valid bodies is kept
+        if (m_txns.emplace(txns.at(i).GetTranID(), txns.at(i)).second || 
+            (m_candidates.erase(txns.at(i).GetTranID()) > 0))
+        {
+            numAdded++;
+        }
+    }
+    return numAdded;
+}
+
+unsigned int ForwardedTxnSet::AddCandidates(const vector<Transaction> & txns)
+{
+    unsigned int numAdded = 0;
+    for (const auto & tx : txns)
+    {
+        if (m_txns.emplace(tx.GetTranID(), tx).second)
+        {
+            m_candidates.insert(tx.GetTranID());
+            numAdded++;
+        }
+    }
+    return numAdded;
+}
+
+ForwardedTxnSet::Result ForwardedTxnSet::Assemble(uint64_t salt, const vector<uint64_t> & ids, 
+                                                  vector<Transaction> & txns) const
+{
+    // Two bodies under one ID cannot be told apart, so the ID is not usable
+    unordered_map<uint64_t, const Transaction *> byID;
+    byID.reserve(m_txns.size());
+    for (const auto & tx : m_txns)
+    {
+        auto entry = byID.emplace(GetID(salt, tx.first), &tx.second);
+        if (!entry.second)
+        {
+            entry.first->second = nullptr;
+        }
+    }
+
+    vector<const Transaction *> found;
+    found.reserve(ids.size());
+    for (const auto & id : ids)
+    {
+        auto entry = byID.find(id);
+        if (entry == byID.end())
+        {
+            return INCOMPLETE;
+        }
+        if (entry->second == nullptr)
+        {
+            return MISMATCH;
+        }
+        found.push_back(entry->second);
+    }
+
+    vector<TxnHash> tranHashes;
+    tranHashes.reserve(found.size());
+    for (const auto tx : found)
+    {
+        tranHashes.push_back(tx->GetTranID());
+    }
+
+    if (ComputeTransactionsRoot(tranHashes) != m_txRootHash)
+    {
+        return MISMATCH;
+    }
+
+    txns.clear();
+    txns.reserve(found.size());
+    for (const auto tx : found)
+    {
+        txns.push_back(*tx);
+    }
+    return COMPLETE;
+}
+
+size_t ForwardedTxnSet::GetSize() const
+{
+    return m_txns.size();
+}
+
+void ForwardedTxnSet::Clear()
+{
+    m_txns.clear();
+    m_candidates.clear();
+}
@@ -0,0 +1,85 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#ifndef __FORWARDEDTXNSET_H__
+#define __FORWARDEDTXNSET_H__
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "Transaction.h"
+#include "libData/DataStructures/IBLT.h"
+
+/// Transaction bodies forwarded for one microblock, gathered across messages until the whole
+/// microblock can be assembled.
+///
+/// Bodies are kept by tran ID and only once they pass the stateless checks, so a body sent first
+/// cannot stand in for another one. The set can be seeded with bodies the node already holds that
+/// may be in the microblock, so that even the first sketch leaves them out of the transfer. Messages
+/// name the bodies by a 64-bit ID keyed by the forwarder's salt and the microblock txn root
+/// (CompactMicroBlock::ComputeKeyedID). Not thread-safe.
+class ForwardedTxnSet
+{
+    TxnHash m_txRootHash;
+    std::unordered_map<TxnHash, Transaction> m_txns;
+
+    // Seeded bodies not confirmed by a forwarder yet, which may not be in the microblock at all
+    std::unordered_set<TxnHash> m_candidates;
+
+public:
+
+    enum Result : unsigned char
+    {
+        INCOMPLETE = 0, // Some IDs are not held yet
+        COMPLETE,
+        MISMATCH        // The IDs do not name a single body each, or the bodies do not add up to the root
+    };
+
+    /// One in this many seeded bodies is allowed for as not being in the microblock when sizing a sketch.
+    static const unsigned int CANDIDATE_MISS_DIVISOR = 8;
+
+    /// Constructor for the bodies of the microblock with the given txn root.
+    explicit ForwardedTxnSet(const TxnHash & txRootHash);
+
+    /// Returns the ID of a transaction under the given salt.
+    uint64_t GetID(uint64_t salt, const TxnHash & tranHash) const;
+
+    /// Returns a sketch of the IDs held under the given salt, sized for a microblock of numTxns.
+    /// The sketch has no cells if nothing is held.
+    IBLT GetSketch(uint64_t salt, unsigned int numTxns) const;
+
+    /// Adds the bodies that pass TxnVerifier's stateless checks. Returns the number added.
+    unsigned int Add(const std::vector<Transaction> & txns);
+
+    /// Seeds bodies the node already holds that may be in the microblock, such as pending transactions
+    /// from the shard that produced it. They must have passed the stateless checks on their way in.
+    /// Returns the number added.
+    unsigned int AddCandidates(const std::vector<Transaction> & txns);
+
+    /// Looks up the bodies named by ids, in order, and checks them against the txn root.
+    /// txns is only filled on COMPLETE.
+    Result Assemble(uint64_t salt, const std::vector<uint64_t> & ids, std::vector<Transaction> & txns) const;
+
+    /// Returns the number of bodies held.
+    size_t GetSize() const;
+
+    /// Drops every body held.
+    void Clear();
+};
+
+#endif // __FORWARDEDTXNSET_H__
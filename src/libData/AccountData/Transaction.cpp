@@ -45,25 +45,24 @@ Transaction::Transaction
     const Address & toAddr,
     const Address & fromAddr,
     const uint256_t & amount,
+    const array<unsigned char, PUB_KEY_SIZE> & senderPubKey,
     const array<unsigned char, TRAN_SIG_SIZE> & signature
-) : m_version(version), m_nonce(nonce), m_toAddr(toAddr), m_fromAddr(fromAddr), m_amount(amount), m_signature(signature)//, m_pred(pred)
+) : m_version(version), m_nonce(nonce), m_toAddr(toAddr), m_fromAddr(fromAddr), m_amount(amount), 
+    m_senderPubKey(senderPubKey), m_signature(signature)//, m_pred(pred)
 {
-    // [TODO] m_signature should be generated from the rest
+    m_tranID = ComputeTranID();
+}
 
+TxnHash Transaction::ComputeTranID() const
+{
     vector<unsigned char> vec;
-    vec.resize(sizeof(uint32_t) + UINT256_SIZE + ACC_ADDR_SIZE * 2 + UINT256_SIZE);
-
-    unsigned int curOffset = 0;
+    ByteWriter writer(vec, 0, IDLayout::SIZE);
 
-    SetNumber<uint32_t>(vec, curOffset, m_version, sizeof(uint32_t));
-    curOffset += sizeof(uint32_t);
-    SetNumber<uint256_t>(vec, curOffset, m_nonce, UINT256_SIZE);
-    curOffset += UINT256_SIZE;
-    copy(m_toAddr.asArray().begin(), m_toAddr.asArray().end(), vec.begin() + curOffset);
-    curOffset += ACC_ADDR_SIZE;
-    copy(m_fromAddr.asArray().begin(), m_fromAddr.asArray().end(), vec.begin() + curOffset);
-    curOffset += ACC_ADDR_SIZE;
-    SetNumber<uint256_t>(vec, curOffset, m_amount, UINT256_SIZE);
+    writer.WriteNumber(m_version, sizeof(uint32_t));
+    writer.WriteNumber(m_nonce, UINT256_SIZE);
+    writer.WriteBytes(m_toAddr.asArray());
+    writer.WriteBytes(m_fromAddr.asArray());
+    writer.WriteNumber(m_amount, UINT256_SIZE);
 
     SHA2<HASH_TYPE::HASH_VARIANT_256> sha2;
     sha2.Update(vec);
@@ -71,59 +70,48 @@ Transaction::Transaction
 
     assert(output.size() == 32);
 
-    copy(output.begin(), output.end(), m_tranID.asArray().begin());
+    TxnHash tranID;
+    copy(output.begin(), output.end(), tranID.asArray().begin());
+    return tranID;
+}
+
+bool Transaction::IsTranIDConsistent() const
+{
+    return ComputeTranID() == m_tranID;
 }
 
 unsigned int Transaction::Serialize(vector<unsigned char> & dst, unsigned int offset) const
 {
     LOG_MARKER();
 
-    unsigned int size_needed = TRAN_HASH_SIZE + sizeof(uint32_t) + UINT256_SIZE + ACC_ADDR_SIZE + ACC_ADDR_SIZE + UINT256_SIZE + TRAN_SIG_SIZE;// + predicate_size_needed;
-    unsigned int size_remaining = dst.size() - offset;
+    ByteWriter writer(dst, offset, Layout::SIZE);
 
-    if (size_remaining < size_needed)
-    {
-        dst.resize(size_needed + offset);
-    }
+    writer.WriteBytes(m_tranID.asArray());
+    writer.WriteNumber(m_version, sizeof(uint32_t));
+    writer.WriteNumber(m_nonce, UINT256_SIZE);
+    writer.WriteBytes(m_toAddr.asArray());
+    writer.WriteBytes(m_fromAddr.asArray());
+    writer.WriteNumber(m_amount, UINT256_SIZE);
+    writer.WriteBytes(m_senderPubKey);
+    writer.WriteBytes(m_signature);
 
-    unsigned int curOffset = offset;
-
-    copy(m_tranID.asArray().begin(), m_tranID.asArray().end(), dst.begin() + curOffset);
-    curOffset += TRAN_HASH_SIZE;
-    SetNumber<uint32_t>(dst, curOffset, m_version, sizeof(uint32_t));
-    curOffset += sizeof(uint32_t);
-    SetNumber<uint256_t>(dst, curOffset, m_nonce, UINT256_SIZE);
-    curOffset += UINT256_SIZE;
-    copy(m_toAddr.asArray().begin(), m_toAddr.asArray().end(), dst.begin() + curOffset);
-    curOffset += ACC_ADDR_SIZE;
-    copy(m_fromAddr.asArray().begin(), m_fromAddr.asArray().end(), dst.begin() + curOffset);
-    curOffset += ACC_ADDR_SIZE;
-    SetNumber<uint256_t>(dst, curOffset, m_amount, UINT256_SIZE);
-    curOffset += UINT256_SIZE;
-    copy(m_signature.begin(), m_signature.end(), dst.begin() + curOffset);
-
-    return size_needed;
+    return Layout::SIZE;
 }
 
 void Transaction::Deserialize(const vector<unsigned char> & src, unsigned int offset)
 {
     LOG_MARKER();
 
-    unsigned int curOffset = offset;
+    ByteReader reader(src, offset);
 
-    copy(src.begin() + curOffset, src.begin() + curOffset + TRAN_HASH_SIZE, m_tranID.asArray().begin());
-    curOffset += TRAN_HASH_SIZE;
-    m_version = GetNumber<uint32_t>(src, curOffset, sizeof(uint32_t));
-    curOffset += sizeof(uint32_t);
-    m_nonce = GetNumber<uint256_t>(src, curOffset, UINT256_SIZE);
-    curOffset += UINT256_SIZE;
-    copy(src.begin() + curOffset, src.begin() + curOffset + ACC_ADDR_SIZE, m_toAddr.asArray().begin());
-    curOffset += ACC_ADDR_SIZE;
-    copy(src.begin() + curOffset, src.begin() + curOffset + ACC_ADDR_SIZE, m_fromAddr.asArray().begin());
-    curOffset += ACC_ADDR_SIZE;
-    m_amount = GetNumber<uint256_t>(src, curOffset, UINT256_SIZE);
-    curOffset += UINT256_SIZE;
-    copy(src.begin() + curOffset, src.begin() + curOffset + TRAN_SIG_SIZE, m_signature.begin());
+    reader.ReadBytes(m_tranID.asArray());
+    m_version = reader.ReadNumber<uint32_t>(sizeof(uint32_t));
+    m_nonce = reader.ReadNumber<uint256_t>(UINT256_SIZE);
+    reader.ReadBytes(m_toAddr.asArray());
+    reader.ReadBytes(m_fromAddr.asArray());
+    m_amount = reader.ReadNumber<uint256_t>(UINT256_SIZE);
+    reader.ReadBytes(m_senderPubKey);
+    reader.ReadBytes(m_signature);
 }
 
 const TxnHash & Transaction::GetTranID() const
@@ -156,6 +144,11 @@ const uint256_t & Transaction::GetAmount() const
     return m_amount;
 }
 
+const array<unsigned char, PUB_KEY_SIZE> & Transaction::GetSenderPubKey() const
+{
+    return m_senderPubKey;
+}
+
 const array<unsigned char, TRAN_SIG_SIZE> & Transaction::GetSignature() const
 {
     return m_signature;
@@ -188,9 +181,7 @@ unsigned int Transaction::GetShardIndex(const Address & fromAddr, unsigned int n
 
 unsigned int Transaction::GetSerializedSize()
 {
-    unsigned int size_needed_wo_predicate = TRAN_HASH_SIZE + sizeof(uint32_t) + UINT256_SIZE + ACC_ADDR_SIZE + ACC_ADDR_SIZE + UINT256_SIZE + TRAN_SIG_SIZE;
-
-    return size_needed_wo_predicate;
+    return Layout::SIZE;
 }
 
 bool Transaction::operator==(const Transaction & tran) const
@@ -203,6 +194,7 @@ bool Transaction::operator==(const Transaction & tran) const
         (m_toAddr == tran.m_toAddr) &&
         (m_fromAddr == tran.m_fromAddr) &&
         (m_amount == tran.m_amount) &&
+        (m_senderPubKey == tran.m_senderPubKey) &&
         (m_signature == tran.m_signature)
     );
 }
@@ -257,6 +249,14 @@ bool Transaction::operator<(const Transaction & tran) const
     {
         return false;
     }
+    else if (m_senderPubKey < tran.m_senderPubKey)
+    {
+        return true;
+    }
+    else if (m_senderPubKey > tran.m_senderPubKey)
+    {
+        return false;
+    }
     else if (m_signature < tran.m_signature)
     {
         return true;
@@ -290,6 +290,7 @@ Transaction & Transaction::operator=(const Transaction & src)
     copy(src.m_toAddr.begin(), src.m_toAddr.end(), m_toAddr.asArray().begin());
     copy(src.m_fromAddr.begin(), src.m_fromAddr.end(), m_fromAddr.asArray().begin());
     m_amount = src.m_amount;
+    m_senderPubKey = src.m_senderPubKey;
     copy(src.m_signature.begin(), src.m_signature.end(), m_signature.begin());
 
     return *this;
@@ -39,10 +39,21 @@ class Transaction : public Serializable
     Address m_toAddr;
     Address m_fromAddr;
     boost::multiprecision::uint256_t m_amount;
-    std::array<unsigned char, TRAN_SIG_SIZE> m_signature;
+    std::array<unsigned char, PUB_KEY_SIZE> m_senderPubKey; // compressed; hashes to m_fromAddr
+    std::array<unsigned char, TRAN_SIG_SIZE> m_signature; // over the tran ID, by m_senderPubKey
+
+    TxnHash ComputeTranID() const;
 
 public:
 
+    /// Serialized field sizes: [tran ID] [version] [nonce] [to address] [from address] [amount] [sender pubkey]
+    /// [signature]
+    typedef FieldLayout<TRAN_HASH_SIZE, sizeof(uint32_t), UINT256_SIZE, ACC_ADDR_SIZE, ACC_ADDR_SIZE, 
+                        UINT256_SIZE, PUB_KEY_SIZE, TRAN_SIG_SIZE> Layout;
+
+    /// Field sizes of the bytes hashed into the tran ID: [version] [nonce] [to address] [from address] [amount]
+    typedef FieldLayout<sizeof(uint32_t), UINT256_SIZE, ACC_ADDR_SIZE, ACC_ADDR_SIZE, UINT256_SIZE> IDLayout;
+
     /// Default constructor.
     Transaction();
 
@@ -54,6 +65,7 @@ public:
         const Address & toAddr,
         const Address & fromAddr,
         const boost::multiprecision::uint256_t & amount,
+        const std::array<unsigned char, PUB_KEY_SIZE> & senderPubKey,
         const std::array<unsigned char, TRAN_SIG_SIZE> & signature
     );
 
@@ -87,9 +99,16 @@ public:
     /// Returns the transaction amount.
     const boost::multiprecision::uint256_t & GetAmount() const;
 
-    /// Returns the EC-Schnorr signature over the transaction data.
+    /// Returns the compressed public key of the sender.
+    const std::array<unsigned char, PUB_KEY_SIZE> & GetSenderPubKey() const;
+
+    /// Returns the EC-Schnorr signature over the transaction ID.
     const std::array<unsigned char, TRAN_SIG_SIZE> & GetSignature() const;
 
+    /// Returns true if the transaction ID matches the hash of the other fields (it is taken as is when
+    /// loading from a byte stream).
+    bool IsTranIDConsistent() const;
+
     /// Identifies the shard number that should process the transaction.
     static unsigned int GetShardIndex(const Address & fromAddr, unsigned int numShards);
 
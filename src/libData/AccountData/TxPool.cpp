@@ -0,0 +1,447 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include "TxPool.h"
+
+using namespace std;
+using namespace boost::multiprecision;
+
+TxPool::TxPool(uint64_t maxBytes) : m_maxBytes(maxBytes), m_numBytes(0), m_numEvicted(0)
+{
+}
+
+uint32_t TxPool::AllocateRecord(const Transaction & tx)
+{
+    if (m_freeRecords.empty())
+    {
+        m_records.push_back({ tx, false });
+        return m_records.size() - 1;
+    }
+
+    uint32_t slot = m_freeRecords.back();
+    m_freeRecords.pop_back();
+    m_records.at(slot).m_tx = tx;
+    m_records.at(slot).m_pinned = false;
+    return slot;
+}
+
+void TxPool::FreeRecord(uint32_t slot)
+{
+    m_freeRecords.push_back(slot);
+}
+
+void TxPool::ResizeSender(const Address & addr, size_t oldSize, size_t newSize)
+{
+    if (oldSize > 0)
+    {
+        m_sendersBySize.erase(make_pair(oldSize, addr));
+    }
+    if (newSize > 0)
+    {
+        m_sendersBySize.insert(make_pair(newSize, addr));
+    }
+}
+
+void TxPool::UpdateReady(const Address & addr, Sender & sender)
+{
+    bool ready = !sender.m_queue.empty() && (sender.m_queue.begin()->first == sender.m_nextNonce);
+
+    if (ready && !sender.m_ready)
+    {
+        sender.m_readyPos = m_readySenders.insert(m_readySenders.end(), addr);
+    }
+    else if (!ready && sender.m_ready)
+    {
+        m_readySenders.erase(sender.m_readyPos);
+    }
+
+    sender.m_ready = ready;
+}
+
+void TxPool::RemoveFromQueue(unordered_map<Address, Sender>::iterator senderIt,
+                             map<uint256_t, uint32_t>::iterator queueIt)
+{
+    const Address addr = senderIt->first;
+    Sender & sender = senderIt->second;
+    uint32_t slot = queueIt->second;
+
+    m_index.erase(m_records.at(slot).m_tx.GetTranID());
+    if (m_records.at(slot).m_pinned)
+    {
+        m_records.at(slot).m_pinned = false;
+        sender.m_numPinned--;
+    }
+    FreeRecord(slot);
+    m_numBytes -= RECORD_SIZE;
+
+    size_t oldSize = sender.m_queue.size();
+    sender.m_queue.erase(queueIt);
+    ResizeSender(addr, oldSize, oldSize - 1);
+
+    if (sender.m_queue.empty())
+    {
+        // Senders with nothing pending are forgotten, but an anchored next nonce is remembered
+        if (sender.m_ready)
+        {
+            m_readySenders.erase(sender.m_readyPos);
+        }
+        if (sender.m_anchored)
+        {
+            RememberCommittedLocked(addr, sender.m_nextNonce);
+        }
+        m_senders.erase(senderIt);
+        m_numBytes -= SENDER_SIZE;
+        return;
+    }
+
+    if (!sender.m_anchored)
+    {
+        sender.m_nextNonce = sender.m_queue.begin()->first;
+    }
+    UpdateReady(addr, sender);
+}
+
+bool TxPool::EvictLocked()
+{
+    // The highest nonce of the longest queue is the furthest from being executed. Pinned transactions
+    // are the lowest nonces of their queues, so the back of a queue is pinned only if all of it is.
+    for (auto sizeIt = m_sendersBySize.rbegin(); sizeIt != m_sendersBySize.rend(); sizeIt++)
+    {
+        auto senderIt = m_senders.find(sizeIt->second);
+        Sender & sender = senderIt->second;
+        if (sender.m_numPinned == sender.m_queue.size())
+        {
+            continue;
+        }
+
+        for (auto queueIt = sender.m_queue.rbegin(); queueIt != sender.m_queue.rend(); queueIt++)
+        {
+            if (!m_records.at(queueIt->second).m_pinned)
+            {
+                RemoveFromQueue(senderIt, prev(queueIt.base()));
+                m_numEvicted++;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+void TxPool::UnpinLocked()
+{
+    // Slots of transactions removed since they were pinned were unpinned on removal and may be reused
+    for (uint32_t slot : m_pinnedRecords)
+    {
+        Record & record = m_records.at(slot);
+        if (record.m_pinned)
+        {
+            record.m_pinned = false;
+            m_senders.at(record.m_tx.GetFromAddr()).m_numPinned--;
+        }
+    }
+    m_pinnedRecords.clear();
+}
+
+bool TxPool::Insert(const Transaction & tx)
+{
+    lock_guard<mutex> g(m_mutex);
+
+    const TxnHash & tranID = tx.GetTranID();
+    if (m_index.find(tranID) != m_index.end())
+    {
+        return false;
+    }
+
+    const Address & addr = tx.GetFromAddr();
+    const uint256_t & nonce = tx.GetNonce();
+
+    auto senderIt = m_senders.find(addr);
+    if (senderIt == m_senders.end())
+    {
+        auto committedIt = m_committedSenders.find(addr);
+        if ((committedIt != m_committedSenders.end()) && (nonce < committedIt->second.m_nextNonce))
+        {
+            return false;
+        }
+
+        senderIt = m_senders.emplace(addr, Sender()).first;
+        senderIt->second.m_nextNonce = nonce;
+        senderIt->second.m_numPinned = 0;
+        senderIt->second.m_anchored = false;
+        senderIt->second.m_ready = false;
+        m_numBytes += SENDER_SIZE;
+
+        // The remembered next nonce moves back into the sender until its queue empties again
+        if (committedIt != m_committedSenders.end())
+        {
+            senderIt->second.m_nextNonce = committedIt->second.m_nextNonce;
+            senderIt->second.m_anchored = true;
+            m_committedOrder.erase(committedIt->second.m_position);
+            m_committedSenders.erase(committedIt);
+        }
+    }
+    else if ((senderIt->second.m_anchored && (nonce < senderIt->second.m_nextNonce)) ||
+             (senderIt->second.m_queue.find(nonce) != senderIt->second.m_queue.end()))
+    {
+        return false;
+    }
+
+    Sender & sender = senderIt->second;
+
+    uint32_t slot = AllocateRecord(tx);
+    m_index.emplace(tranID, slot);
+    m_numBytes += RECORD_SIZE;
+
+    size_t oldSize = sender.m_queue.size();
+    sender.m_queue.emplace(nonce, slot);
+    ResizeSender(addr, oldSize, oldSize + 1);
+
+    if (!sender.m_anchored)
+    {
+        sender.m_nextNonce = sender.m_queue.begin()->first;
+    }
+    UpdateReady(addr, sender);
+
+    // The new transaction is never pinned, so there is always something to evict
+    while ((m_numBytes > m_maxBytes) && EvictLocked())
+    {
+    }
+
+    return m_index.find(tranID) != m_index.end();
+}
+
+bool TxPool::Contains(const TxnHash & tranID) const
+{
+    lock_guard<mutex> g(m_mutex);
+    return m_index.find(tranID) != m_index.end();
+}
+
+bool TxPool::Get(const TxnHash & tranID, Transaction & tx) const
+{
+    lock_guard<mutex> g(m_mutex);
+
+    auto it = m_index.find(tranID);
+    if (it == m_index.end())
+    {
+        return false;
+    }
+
+    tx = m_records.at(it->second).m_tx;
+    return true;
+}
+
+bool TxPool::Commit(const TxnHash & tranID, Transaction & tx)
+{
+    lock_guard<mutex> g(m_mutex);
+
+    auto it = m_index.find(tranID);
+    if (it == m_index.end())
+    {
+        return false;
+    }
+
+    tx = m_records.at(it->second).m_tx;
+
+    // The committed transaction is below the new next nonce, so it goes too
+    AdvanceNonceLocked(tx.GetFromAddr(), tx.GetNonce());
+
+    return true;
+}
+
+void TxPool::CommitExternal(const Transaction & tx)
+{
+    lock_guard<mutex> g(m_mutex);
+    AdvanceNonceLocked(tx.GetFromAddr(), tx.GetNonce());
+}
+
+void TxPool::AdvanceNonceLocked(const Address & addr, const uint256_t & nonce)
+{
+    // A sender with nothing pending has only its remembered next nonce to move
+    auto senderIt = m_senders.find(addr);
+    if (senderIt == m_senders.end())
+    {
+        RememberCommittedLocked(addr, nonce + 1);
+        return;
+    }
+
+    Sender & sender = senderIt->second;
+
+    sender.m_anchored = true;
+    if (nonce >= sender.m_nextNonce)
+    {
+        sender.m_nextNonce = nonce + 1;
+    }
+
+    // Everything below the new next nonce is stale now
+    const uint256_t nextNonce = sender.m_nextNonce;
+    while (true)
+    {
+        senderIt = m_senders.find(addr);
+        if ((senderIt == m_senders.end()) || (senderIt->second.m_queue.begin()->first >= nextNonce))
+        {
+            break;
+        }
+        RemoveFromQueue(senderIt, senderIt->second.m_queue.begin());
+    }
+
+    if (senderIt != m_senders.end())
+    {
+        UpdateReady(addr, senderIt->second);
+    }
+}
+
+void TxPool::RememberCommittedLocked(const Address & addr, const uint256_t & nextNonce)
+{
+    auto committedIt = m_committedSenders.find(addr);
+    if (committedIt != m_committedSenders.end())
+    {
+        if (nextNonce > committedIt->second.m_nextNonce)
+        {
+            committedIt->second.m_nextNonce = nextNonce;
+        }
+        m_committedOrder.splice(m_committedOrder.end(), m_committedOrder, committedIt->second.m_position);
+        return;
+    }
+
+    m_committedSenders.emplace(addr, CommittedSender{ nextNonce, m_committedOrder.insert(m_committedOrder.end(), addr) });
+
+    if (m_committedSenders.size() > MAX_NUM_COMMITTED_SENDERS)
+    {
+        m_committedSenders.erase(m_committedOrder.front());
+        m_committedOrder.pop_front();
+    }
+}
+
+bool TxPool::Remove(const TxnHash & tranID)
+{
+    lock_guard<mutex> g(m_mutex);
+
+    auto it = m_index.find(tranID);
+    if (it == m_index.end())
+    {
+        return false;
+    }
+
+    const Transaction & tx = m_records.at(it->second).m_tx;
+    auto senderIt = m_senders.find(tx.GetFromAddr());
+    RemoveFromQueue(senderIt, senderIt->second.m_queue.find(tx.GetNonce()));
+
+    return true;
+}
+
+bool TxPool::Pin(const vector<TxnHash> & tranIDs)
+{
+    lock_guard<mutex> g(m_mutex);
+
+    UnpinLocked();
+
+    bool result = true;
+    for (const auto & tranID : tranIDs)
+    {
+        auto it = m_index.find(tranID);
+        if (it == m_index.end())
+        {
+            result = false;
+            continue;
+        }
+
+        Record & record = m_records.at(it->second);
+        if (!record.m_pinned)
+        {
+            record.m_pinned = true;
+            m_senders.at(record.m_tx.GetFromAddr()).m_numPinned++;
+            m_pinnedRecords.push_back(it->second);
+        }
+    }
+
+    return result;
+}
+
+void TxPool::Unpin()
+{
+    lock_guard<mutex> g(m_mutex);
+    UnpinLocked();
+}
+
+void TxPool::SelectExecutable(unsigned int k, vector<TxnHash> & tranIDs) const
+{
+    lock_guard<mutex> g(m_mutex);
+
+    // Every ready sender yields at least one transaction, so at most k senders are visited
+    unsigned int selected = 0;
+    for (auto addrIt = m_readySenders.begin(); (addrIt != m_readySenders.end()) && (selected < k); addrIt++)
+    {
+        const Sender & sender = m_senders.at(*addrIt);
+        uint256_t expected = sender.m_nextNonce;
+
+        for (auto it = sender.m_queue.begin();
+             (it != sender.m_queue.end()) && (it->first == expected) && (selected < k); it++)
+        {
+            tranIDs.push_back(m_records.at(it->second).m_tx.GetTranID());
+            expected++;
+            selected++;
+        }
+    }
+}
+
+void TxPool::GetTranIDs(vector<TxnHash> & tranIDs) const
+{
+    lock_guard<mutex> g(m_mutex);
+
+    tranIDs.reserve(tranIDs.size() + m_index.size());
+    for (const auto & entry : m_index)
+    {
+        tranIDs.push_back(entry.first);
+    }
+}
+
+void TxPool::GetFromShard(unsigned int numShards, unsigned int shardID, vector<Transaction> & txns) const
+{
+    lock_guard<mutex> g(m_mutex);
+
+    // All of a sender's transactions are in the same shard
+    for (const auto & sender : m_senders)
+    {
+        if ((numShards > 0) && (Transaction::GetShardIndex(sender.first, numShards) != shardID))
+        {
+            continue;
+        }
+
+        for (const auto & entry : sender.second.m_queue)
+        {
+            txns.push_back(m_records.at(entry.second).m_tx);
+        }
+    }
+}
+
+size_t TxPool::GetSize() const
+{
+    lock_guard<mutex> g(m_mutex);
+    return m_index.size();
+}
+
+uint64_t TxPool::GetNumBytes() const
+{
+    lock_guard<mutex> g(m_mutex);
+    return m_numBytes;
+}
+
+uint64_t TxPool::GetNumEvicted() const
+{
+    lock_guard<mutex> g(m_mutex);
+    return m_numEvicted;
+}
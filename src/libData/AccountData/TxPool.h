@@ -0,0 +1,193 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#ifndef __TXPOOL_H__
+#define __TXPOOL_H__
+
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/multiprecision/cpp_int.hpp>
+
+#include "Address.h"
+#include "Transaction.h"
+
+/// Pool of pending transactions, shared by all epochs until they are committed.
+///
+/// Records live in a slot arena and are reached through a hash index (for dedup) and through
+/// per-sender queues ordered by nonce. A sender's transactions are executable from its next nonce
+/// onwards, up to the first gap. The next nonce is anchored by the first commit from that sender;
+/// before that it is the lowest nonce queued. Once nothing from a sender is pending, an anchored next
+/// nonce is kept for the last MAX_NUM_COMMITTED_SENDERS such senders, so committed transactions cannot
+/// be pooled again, and an unanchored one is forgotten. The pool holds at most a fixed number of bytes and evicts from the back of the longest
+/// sender queue once that is exceeded, skipping transactions pinned for the microblock under way.
+///
+/// All member functions are thread-safe.
+class TxPool
+{
+    struct Record
+    {
+        Transaction m_tx;
+        bool m_pinned;
+    };
+
+    struct Sender
+    {
+        std::map<boost::multiprecision::uint256_t, uint32_t> m_queue;
+        boost::multiprecision::uint256_t m_nextNonce;
+        size_t m_numPinned;
+        bool m_anchored;
+        bool m_ready;
+        std::list<Address>::iterator m_readyPos;
+    };
+
+    struct CommittedSender
+    {
+        boost::multiprecision::uint256_t m_nextNonce;
+        std::list<Address>::iterator m_position;
+    };
+
+    /// Transaction IDs are SHA-256 outputs, so their leading bytes are already a good hash.
+    struct TxnHashHasher
+    {
+        size_t operator()(const TxnHash & hash) const
+        {
+            size_t value;
+            std::memcpy(&value, hash.data(), sizeof(value));
+            return value;
+        }
+    };
+
+    mutable std::mutex m_mutex;
+
+    std::vector<Record> m_records;
+    std::vector<uint32_t> m_freeRecords;
+    std::unordered_map<TxnHash, uint32_t, TxnHashHasher> m_index;
+    std::unordered_map<Address, Sender> m_senders;
+
+    // Senders whose queue starts at their next nonce, in the order they became executable
+    std::list<Address> m_readySenders;
+
+    // Senders by queue length, for eviction
+    std::set<std::pair<size_t, Address>> m_sendersBySize;
+
+    // Records of the transactions proposed for the current microblock, which are never evicted
+    std::vector<uint32_t> m_pinnedRecords;
+
+    // Anchored next nonces of senders with nothing pending, oldest first
+    std::unordered_map<Address, CommittedSender> m_committedSenders;
+    std::list<Address> m_committedOrder;
+
+    const uint64_t m_maxBytes;
+    uint64_t m_numBytes;
+    uint64_t m_numEvicted;
+
+    uint32_t AllocateRecord(const Transaction & tx);
+    void FreeRecord(uint32_t slot);
+    void RemoveFromQueue(std::unordered_map<Address, Sender>::iterator senderIt,
+                         std::map<boost::multiprecision::uint256_t, uint32_t>::iterator queueIt);
+    void UpdateReady(const Address & addr, Sender & sender);
+    void ResizeSender(const Address & addr, size_t oldSize, size_t newSize);
+    bool EvictLocked();
+    void UnpinLocked();
+    void AdvanceNonceLocked(const Address & addr, const boost::multiprecision::uint256_t & nonce);
+    void RememberCommittedLocked(const Address & addr, const boost::multiprecision::uint256_t & nextNonce);
+
+public:
+
+    /// Number of senders with nothing pending whose anchored next nonce is remembered.
+    static const unsigned int MAX_NUM_COMMITTED_SENDERS = 1 << 16;
+
+    // Heap taken by a container node beyond its value: next pointer, cached hash and bucket slot for
+    // the hash maps, colour and three links for the ordered ones, two links for the list
+    static const unsigned int HASH_NODE_OVERHEAD = 3 * sizeof(void *);
+    static const unsigned int TREE_NODE_OVERHEAD = 4 * sizeof(void *);
+    static const unsigned int LIST_NODE_OVERHEAD = 2 * sizeof(void *);
+
+    /// Memory charged against the byte budget for each pending transaction: its record, its entry in
+    /// the hash index and its entry in the sender's nonce queue.
+    static const unsigned int RECORD_SIZE =
+        sizeof(Record) +
+        HASH_NODE_OVERHEAD + sizeof(std::pair<const TxnHash, uint32_t>) +
+        TREE_NODE_OVERHEAD + sizeof(std::pair<const boost::multiprecision::uint256_t, uint32_t>);
+
+    /// Memory charged against the byte budget for each sender with pending transactions: its entry in
+    /// the sender map, in the ready list and in the eviction order.
+    static const unsigned int SENDER_SIZE =
+        HASH_NODE_OVERHEAD + sizeof(std::pair<const Address, Sender>) +
+        LIST_NODE_OVERHEAD + sizeof(Address) +
+        TREE_NODE_OVERHEAD + sizeof(std::pair<size_t, Address>);
+
+    /// Constructor. maxBytes bounds the memory taken by pending transactions.
+    explicit TxPool(uint64_t maxBytes);
+
+    /// Adds a transaction. Returns false if its ID is already pooled, its nonce is below the sender's
+    /// next nonce (remembered or pending) or already queued for that sender, or the pool is full and it
+    /// is the one evicted.
+    bool Insert(const Transaction & tx);
+
+    /// Returns true if a transaction with this ID is pending.
+    bool Contains(const TxnHash & tranID) const;
+
+    /// Copies out a pending transaction. Returns false if it is not in the pool.
+    bool Get(const TxnHash & tranID, Transaction & tx) const;
+
+    /// Removes a transaction included in a final block and returns it. The sender's next nonce moves
+    /// past it, and any other queued transaction from that sender below the new next nonce is dropped.
+    bool Commit(const TxnHash & tranID, Transaction & tx);
+
+    /// Moves the sender's next nonce past a transaction committed from outside the pool, dropping any
+    /// queued transaction from that sender below the new next nonce.
+    void CommitExternal(const Transaction & tx);
+
+    /// Removes a transaction without moving its sender's next nonce.
+    bool Remove(const TxnHash & tranID);
+
+    /// Keeps the transactions proposed for the current microblock from being evicted until they are
+    /// committed or unpinned. Replaces any earlier pins. Returns false if any of them is not pending.
+    bool Pin(const std::vector<TxnHash> & tranIDs);
+
+    /// Releases all pins.
+    void Unpin();
+
+    /// Appends up to k executable transaction IDs, each sender's in nonce order. Takes O(k) time.
+    void SelectExecutable(unsigned int k, std::vector<TxnHash> & tranIDs) const;
+
+    /// Appends the IDs of all pending transactions.
+    void GetTranIDs(std::vector<TxnHash> & tranIDs) const;
+
+    /// Appends copies of the pending transactions whose sender belongs to the given shard.
+    /// A numShards of 0 matches every sender.
+    void GetFromShard(unsigned int numShards, unsigned int shardID, std::vector<Transaction> & txns) const;
+
+    /// Returns the number of pending transactions.
+    size_t GetSize() const;
+
+    /// Returns the bytes charged against the budget: RECORD_SIZE per pending transaction plus SENDER_SIZE per sender.
+    uint64_t GetNumBytes() const;
+
+    /// Returns how many transactions have been evicted for space so far.
+    uint64_t GetNumEvicted() const;
+};
+
+#endif // __TXPOOL_H__
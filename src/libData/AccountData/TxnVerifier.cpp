@@ -0,0 +1,177 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <algorithm>
+#include <atomic>
+
+#include "Account.h"
+#include "TxnVerifier.h"
+#include "TxnVerifyCache.h"
+#include "libUtils/Executor.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+using namespace boost::multiprecision;
+
+Transaction TxnVerifier::CreateSigned(uint32_t version, const uint256_t & nonce, const Address & toAddr, 
+                                      const PrivKey & privKey, const PubKey & pubKey, const uint256_t & amount)
+{
+    array<unsigned char, TRAN_SIG_SIZE> signature = {0};
+    Transaction unsigned_txn(version, nonce, toAddr, Account::GetAddressFromPublicKey(pubKey), amount, 
+                             pubKey.GetCompressed(), signature);
+
+    const auto & tranID = unsigned_txn.GetTranID().asArray();
+    vector<unsigned char> message(tranID.begin(), tranID.end());
+
+    Signature sig;
+    if (!Schnorr::GetInstance().Sign(message, privKey, pubKey, sig))
+    {
+        LOG_MESSAGE("Error: Failed to sign transaction " << unsigned_txn.GetTranID());
+        throw exception();
+    }
+
+    vector<unsigned char> sig_bytes;
+    sig.Serialize(sig_bytes, 0);
+    copy(sig_bytes.begin(), sig_bytes.end(), signature.begin());
+
+    return Transaction(version, nonce, toAddr, unsigned_txn.GetFromAddr(), amount, pubKey.GetCompressed(), signature);
+}
+
+bool TxnVerifier::CreateSignedBatch(uint32_t version, const uint256_t & nonce, const Address & toAddr, 
+                                    const PrivKey & privKey, const PubKey & pubKey, const uint256_t & amount, 
+                                    unsigned int count, vector<Transaction> & txns)
+{
+    txns.assign(count, Transaction());
+
+    Executor & executor = Executor::GetInstance();
+    const size_t num_chunks = max<size_t>(1, min<size_t>(executor.GetNumWorkers(), count / MIN_CHUNK_SIZE));
+    const size_t chunk_size = (count + num_chunks - 1) / num_chunks;
+
+    atomic<bool> signed_all(true);
+    auto sign_range = [&](size_t begin, size_t end) -> void
+    {
+        try
+        {
+            for (size_t i = begin; i < end; i++)
+            {
+                txns.at(i) = CreateSigned(version, nonce + i, toAddr, privKey, pubKey, amount + i);
+            }
+        }
+        catch (const exception &)
+        {
+            signed_all = false;
+        }
+    };
+
+    // Each chunk writes its own slice of txns; the calling thread takes the first chunk itself
+    vector<TaskFuture<void>> pending;
+    for (size_t begin = chunk_size; begin < count; begin += chunk_size)
+    {
+        size_t end = min<size_t>(count, begin + chunk_size);
+        pending.push_back(executor.Submit([&sign_range, begin, end]() -> void { sign_range(begin, end); }));
+    }
+
+    sign_range(0, min<size_t>(count, chunk_size));
+
+    for (const auto & task : pending)
+    {
+        task.Get();
+    }
+
+    if (!signed_all)
+    {
+        txns.clear();
+        return false;
+    }
+
+    return true;
+}
+
+TxnVerifier::Result TxnVerifier::Check(const Transaction & tx, unsigned int numShards, unsigned int shardID)
+{
+    // Cheapest checks first: one SHA-256 each, then the curve operations
+
+    if (!tx.IsTranIDConsistent())
+    {
+        return BAD_TRAN_ID;
+    }
+
+    if ((numShards > 0) && (Transaction::GetShardIndex(tx.GetFromAddr(), numShards) != shardID))
+    {
+        return WRONG_SHARD;
+    }
+
+    // The key covers the sender key and signature; the tran ID, checked above, covers the rest
+    TxnVerifyCache & cache = TxnVerifyCache::GetInstance();
+    TxnVerifyCache::Key key = TxnVerifyCache::MakeKey(tx);
+    if (cache.Contains(key))
+    {
+        return VALID;
+    }
+
+    vector<unsigned char> buf(tx.GetSenderPubKey().begin(), tx.GetSenderPubKey().end());
+    PubKey pubKey(buf, 0);
+    if (!pubKey.Initialized() || (Account::GetAddressFromPublicKey(pubKey) != tx.GetFromAddr()))
+    {
+        return BAD_SENDER_KEY;
+    }
+
+    buf.assign(tx.GetSignature().begin(), tx.GetSignature().end());
+    Signature sig(buf, 0);
+
+    const auto & tranID = tx.GetTranID().asArray();
+    buf.assign(tranID.begin(), tranID.end());
+    if (!Schnorr::GetInstance().Verify(buf, sig, pubKey))
+    {
+        return BAD_SIGNATURE;
+    }
+
+    cache.Insert(key);
+    return VALID;
+}
+
+void TxnVerifier::CheckBatch(const vector<Transaction> & txns, unsigned int numShards, unsigned int shardID, 
+                             vector<Result> & results)
+{
+    results.resize(txns.size());
+
+    Executor & executor = Executor::GetInstance();
+    const size_t num_chunks = max<size_t>(1, min<size_t>(executor.GetNumWorkers(), txns.size() / MIN_CHUNK_SIZE));
+    const size_t chunk_size = (txns.size() + num_chunks - 1) / num_chunks;
+
+    auto check_range = [&txns, &results, numShards, shardID](size_t begin, size_t end) -> void
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            results.at(i) = Check(txns.at(i), numShards, shardID);
+        }
+    };
+
+    // Each chunk writes its own slice of results; the calling thread takes the first chunk itself
+    vector<TaskFuture<void>> pending;
+    for (size_t begin = chunk_size; begin < txns.size(); begin += chunk_size)
+    {
+        size_t end = min(txns.size(), begin + chunk_size);
+        pending.push_back(executor.Submit([check_range, begin, end]() -> void { check_range(begin, end); }));
+    }
+
+    check_range(0, min(txns.size(), chunk_size));
+
+    for (const auto & task : pending)
+    {
+        task.Get();
+    }
+}
@@ -0,0 +1,69 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#ifndef __TXNVERIFIER_H__
+#define __TXNVERIFIER_H__
+
+#include <vector>
+
+#include <boost/multiprecision/cpp_int.hpp>
+
+#include "Address.h"
+#include "Transaction.h"
+#include "libCrypto/Schnorr.h"
+
+/// Checks on received transactions that do not depend on account state: the tran ID, the sender key,
+/// the signature and the shard. Batches are split into chunks that run on the Executor workers, so
+/// signature checks scale with the number of cores. Nonce and balance checks against the account store
+/// are left to the caller, which serializes them.
+class TxnVerifier
+{
+public:
+
+    enum Result : unsigned char
+    {
+        VALID = 0,
+        BAD_TRAN_ID,        // The ID is not the hash of the other fields
+        BAD_SENDER_KEY,     // The public key is not on the curve or does not hash to the from address
+        BAD_SIGNATURE,
+        WRONG_SHARD
+    };
+
+    /// Smallest number of transactions handed to a single Executor task.
+    static const unsigned int MIN_CHUNK_SIZE = 64;
+
+    /// Creates a transaction from the address of the key pair, signed by it.
+    static Transaction CreateSigned(uint32_t version, const boost::multiprecision::uint256_t & nonce, 
+                                    const Address & toAddr, const PrivKey & privKey, const PubKey & pubKey, 
+                                    const boost::multiprecision::uint256_t & amount);
+
+    /// Creates count transactions like CreateSigned, the i-th with nonce + i and amount + i, signing them
+    /// in parallel. Returns false, with txns cleared, if any of them could not be signed.
+    static bool CreateSignedBatch(uint32_t version, const boost::multiprecision::uint256_t & nonce, 
+                                  const Address & toAddr, const PrivKey & privKey, const PubKey & pubKey, 
+                                  const boost::multiprecision::uint256_t & amount, unsigned int count, 
+                                  std::vector<Transaction> & txns);
+
+    /// Runs the stateless checks on one transaction. A numShards of 0 skips the shard check.
+    /// Transactions found in TxnVerifyCache skip the sender key and signature checks.
+    static Result Check(const Transaction & tx, unsigned int numShards, unsigned int shardID);
+
+    /// Runs the stateless checks on a batch in parallel. results[i] is set for txns[i].
+    static void CheckBatch(const std::vector<Transaction> & txns, unsigned int numShards, unsigned int shardID, 
+                           std::vector<Result> & results);
+};
+
+#endif // __TXNVERIFIER_H__
@@ -0,0 +1,144 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <algorithm>
+#include <vector>
+
+#include "TxnVerifyCache.h"
+#include "common/Constants.h"
+#include "libCrypto/Sha2.h"
+
+using namespace std;
+
+TxnVerifyCache::TxnVerifyCache(size_t capacity) : 
+    m_maxPerGeneration(max<size_t>(1, capacity / (2 * NUM_SHARDS))), m_hits(0), m_misses(0), m_earlyRotations(0)
+{
+}
+
+TxnVerifyCache & TxnVerifyCache::GetInstance()
+{
+    static TxnVerifyCache cache(TXN_VERIFY_CACHE_SIZE);
+    return cache;
+}
+
+TxnVerifyCache::Key TxnVerifyCache::MakeKey(const Transaction & tx)
+{
+    const auto & pubKey = tx.GetSenderPubKey();
+    const auto & signature = tx.GetSignature();
+
+    vector<unsigned char> buf;
+    buf.reserve(PUB_KEY_SIZE + TRAN_SIG_SIZE);
+    buf.insert(buf.end(), pubKey.begin(), pubKey.end());
+    buf.insert(buf.end(), signature.begin(), signature.end());
+
+    SHA2<HASH_TYPE::HASH_VARIANT_256> sha2;
+    sha2.Update(buf);
+    const vector<unsigned char> & output = sha2.Finalize();
+
+    Key key;
+    key.m_tranID = tx.GetTranID();
+    copy(output.begin(), output.end(), key.m_sigHash.asArray().begin());
+    return key;
+}
+
+TxnVerifyCache::Shard & TxnVerifyCache::GetShard(const Key & key)
+{
+    // Use bytes the hasher does not, so that shards and buckets stay independent
+    return m_shards.at(key.m_tranID[sizeof(size_t)] % NUM_SHARDS);
+}
+
+bool TxnVerifyCache::Contains(const Key & key)
+{
+    Shard & shard = GetShard(key);
+
+    bool found;
+    {
+        lock_guard<mutex> g(shard.m_mutex);
+        found = (shard.m_current.count(key) > 0) || (shard.m_previous.count(key) > 0);
+    }
+
+    if (found)
+    {
+        m_hits++;
+    }
+    else
+    {
+        m_misses++;
+    }
+
+    return found;
+}
+
+void TxnVerifyCache::Insert(const Key & key)
+{
+    Shard & shard = GetShard(key);
+    lock_guard<mutex> g(shard.m_mutex);
+
+    if (shard.m_current.size() >= m_maxPerGeneration)
+    {
+        shard.m_previous.swap(shard.m_current);
+        shard.m_current.clear();
+        m_earlyRotations++;
+    }
+
+    shard.m_current.insert(key);
+}
+
+void TxnVerifyCache::Rotate()
+{
+    for (auto & shard : m_shards)
+    {
+        lock_guard<mutex> g(shard.m_mutex);
+        shard.m_previous.swap(shard.m_current);
+        shard.m_current.clear();
+    }
+}
+
+void TxnVerifyCache::Clear()
+{
+    for (auto & shard : m_shards)
+    {
+        lock_guard<mutex> g(shard.m_mutex);
+        shard.m_current.clear();
+        shard.m_previous.clear();
+    }
+}
+
+size_t TxnVerifyCache::GetSize()
+{
+    size_t size = 0;
+    for (auto & shard : m_shards)
+    {
+        lock_guard<mutex> g(shard.m_mutex);
+        size += shard.m_current.size() + shard.m_previous.size();
+    }
+    return size;
+}
+
+uint64_t TxnVerifyCache::GetNumHits() const
+{
+    return m_hits;
+}
+
+uint64_t TxnVerifyCache::GetNumMisses() const
+{
+    return m_misses;
+}
+
+uint64_t TxnVerifyCache::GetNumEarlyRotations() const
+{
+    return m_earlyRotations;
+}
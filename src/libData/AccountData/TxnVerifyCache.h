@@ -0,0 +1,121 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#ifndef __TXNVERIFYCACHE_H__
+#define __TXNVERIFYCACHE_H__
+
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <unordered_set>
+
+#include "Transaction.h"
+#include "depends/common/FixedHash.h"
+
+/// Remembers which transactions have passed signature verification, so that a transaction seen again
+/// (submitted, then filled into a microblock, then forwarded) is verified only once.
+///
+/// Entries are keyed by the tran ID and a hash of the sender key and signature, so a known transaction
+/// with a different signature attached is still verified. The tran ID itself must be checked against the
+/// other fields by the caller. Entries are split over independently locked shards, each holding two
+/// generations: Rotate() drops the older one at every epoch, and a shard whose current generation fills
+/// up rotates on its own, which bounds the total size.
+class TxnVerifyCache
+{
+public:
+
+    struct Key
+    {
+        TxnHash m_tranID;
+        dev::h256 m_sigHash;
+
+        bool operator==(const Key & r) const
+        {
+            return (m_tranID == r.m_tranID) && (m_sigHash == r.m_sigHash);
+        }
+    };
+
+private:
+
+    /// Both halves are SHA-256 outputs, so their leading bytes are already a good hash.
+    struct KeyHasher
+    {
+        size_t operator()(const Key & key) const
+        {
+            size_t a, b;
+            std::memcpy(&a, key.m_tranID.data(), sizeof(a));
+            std::memcpy(&b, key.m_sigHash.data(), sizeof(b));
+            return a ^ b;
+        }
+    };
+
+    struct Shard
+    {
+        std::mutex m_mutex;
+        std::unordered_set<Key, KeyHasher> m_current;
+        std::unordered_set<Key, KeyHasher> m_previous;
+    };
+
+    static const unsigned int NUM_SHARDS = 16;
+
+    std::array<Shard, NUM_SHARDS> m_shards;
+    const size_t m_maxPerGeneration;
+
+    std::atomic<uint64_t> m_hits;
+    std::atomic<uint64_t> m_misses;
+    std::atomic<uint64_t> m_earlyRotations;
+
+    Shard & GetShard(const Key & key);
+
+public:
+
+    /// Constructor. capacity bounds the number of entries across all shards and both generations.
+    explicit TxnVerifyCache(size_t capacity);
+
+    /// Returns the process-wide instance, sized by TXN_VERIFY_CACHE_SIZE.
+    static TxnVerifyCache & GetInstance();
+
+    /// Builds the cache key of a transaction.
+    static Key MakeKey(const Transaction & tx);
+
+    /// Returns true if the key has been verified before. Counts a hit or a miss.
+    bool Contains(const Key & key);
+
+    /// Records a key as verified.
+    void Insert(const Key & key);
+
+    /// Starts a new generation, dropping everything verified before the previous one started.
+    void Rotate();
+
+    /// Drops all entries. Statistics are kept.
+    void Clear();
+
+    /// Returns the number of entries held.
+    size_t GetSize();
+
+    /// Returns the number of lookups that found an entry.
+    uint64_t GetNumHits() const;
+
+    /// Returns the number of lookups that did not.
+    uint64_t GetNumMisses() const;
+
+    /// Returns how often a full shard rotated before the epoch ended. A growing count means the cache is
+    /// too small for one epoch of transactions.
+    uint64_t GetNumEarlyRotations() const;
+};
+
+#endif // __TXNVERIFYCACHE_H__
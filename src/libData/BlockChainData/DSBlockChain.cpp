@@ -20,65 +20,64 @@
 using namespace std;
 using namespace boost::multiprecision;
 
-DSBlockChain::DSBlockChain()
+DSBlockChain::DSBlockChain() : m_dsBlocks(DS_BLOCKCHAIN_SIZE, make_shared<const DSBlock>())
 {
-    m_dsBlocks.resize(DS_BLOCKCHAIN_SIZE);
 }
 
 DSBlockChain::~DSBlockChain()
 {
-    
+
 }
 
-uint256_t DSBlockChain::GetBlockCount()
+uint64_t DSBlockChain::GetBlockCount()
 {
-    lock_guard<mutex> g(m_mutexDSBlocks);
     return m_dsBlocks.size();
 }
 
-DSBlock DSBlockChain::GetLastBlock()
+shared_ptr<const DSBlock> DSBlockChain::GetLastBlock()
 {
-    lock_guard<mutex> g(m_mutexDSBlocks);
-    return m_dsBlocks.back();
+    return m_dsBlocks.Back();
 }
 
-DSBlock DSBlockChain::GetBlock(const uint256_t & blockNum)
+shared_ptr<const DSBlock> DSBlockChain::GetBlock(uint64_t blockNum)
 {
-    lock_guard<mutex> g(m_mutexDSBlocks);
+    uint64_t blockCount = m_dsBlocks.size();
 
-    if (blockNum >= m_dsBlocks.size())
+    if (blockNum >= blockCount)
     {
         throw "Blocknumber Absent";
     }
-    else if(blockNum + m_dsBlocks.capacity() < m_dsBlocks.size())
+    else if (blockNum + m_dsBlocks.capacity() >= blockCount)
     {
-        DSBlockSharedPtr block;
-        BlockStorage::GetBlockStorage().GetDSBlock(blockNum, block);
-        return *block;
-    }
+        shared_ptr<const DSBlock> block = m_dsBlocks.Get(blockNum);
 
-    // To-do: We cannot even index into a vector using uint256_t
-    // uint256_t might just be too big to begin with
-    // Consider switching to uint64_t
-    // For now we directly cast to uint64_t
+        // The slot may have been reused by a newer block since the count was read
+        if (block->GetHeader().GetBlockNum() == blockNum)
+        {
+            return block;
+        }
+    }
 
-    assert(m_dsBlocks[blockNum].GetHeader().GetBlockNum() == blockNum);
-    return m_dsBlocks[blockNum];
+    DSBlockSharedPtr block;
+    if (!BlockStorage::GetBlockStorage().GetDSBlock(blockNum, block))
+    {
+        throw "Blocknumber Absent";
+    }
+    return block;
 }
 
 int DSBlockChain::AddBlock(const DSBlock & block)
 {
     uint256_t blockNumOfNewBlock = block.GetHeader().GetBlockNum();
+    uint64_t index = blockNumOfNewBlock.convert_to<uint64_t>();
 
     lock_guard<mutex> g(m_mutexDSBlocks);
 
-    uint256_t blockNumOfExistingBlock = 
-        m_dsBlocks[blockNumOfNewBlock].GetHeader().GetBlockNum();
+    uint256_t blockNumOfExistingBlock = m_dsBlocks.Get(index)->GetHeader().GetBlockNum();
 
-    if(blockNumOfExistingBlock < blockNumOfNewBlock ||
-        blockNumOfExistingBlock == (uint256_t) -1)
+    if (blockNumOfExistingBlock < blockNumOfNewBlock || blockNumOfExistingBlock == (uint256_t) -1)
     {
-        m_dsBlocks.insert_new(blockNumOfNewBlock, block);
+        m_dsBlocks.Publish(index, make_shared<const DSBlock>(block));
     }
     else
     {
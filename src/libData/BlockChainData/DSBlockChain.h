@@ -17,37 +17,41 @@
 #ifndef __DSBLOCKCHAIN_H__
 #define __DSBLOCKCHAIN_H__
 
+#include <memory>
 #include <mutex>
 #include <vector>
 
-#include <boost/multiprecision/cpp_int.hpp>
-
 #include "libData/BlockData/Block/DSBlock.h"
-#include "libData/DataStructures/CircularArray.h"
+#include "libData/DataStructures/SnapshotRing.h"
 #include "libPersistence/BlockStorage.h"
 
 /// Transient storage for DS blocks.
+///
+/// The most recent blocks are kept in a ring that readers access without locking. Blocks are
+/// shared and immutable once added, so readers hold them without copying; older blocks are
+/// loaded from block storage.
 class DSBlockChain
 {
-	std::mutex m_mutexDSBlocks;
-    CircularArray<DSBlock> m_dsBlocks;
+    // Serializes AddBlock, the only writer
+    std::mutex m_mutexDSBlocks;
+    SnapshotRing<DSBlock> m_dsBlocks;
 
 public:
 
-	/// Constructor.
+    /// Constructor.
     DSBlockChain();
 
     /// Destructor.
     ~DSBlockChain();
 
     /// Returns the number of blocks.
-    boost::multiprecision::uint256_t GetBlockCount();
+    uint64_t GetBlockCount();
 
     /// Returns the last stored block.
-    DSBlock GetLastBlock();
+    std::shared_ptr<const DSBlock> GetLastBlock();
 
     /// Returns the block at the specified block number.
-    DSBlock GetBlock(const boost::multiprecision::uint256_t & blocknum);
+    std::shared_ptr<const DSBlock> GetBlock(uint64_t blocknum);
 
     /// Adds a block to the chain.
     int AddBlock(const DSBlock & block);
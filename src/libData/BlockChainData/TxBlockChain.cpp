@@ -20,9 +20,8 @@
 using namespace std;
 using namespace boost::multiprecision;
 
-TxBlockChain::TxBlockChain()
+TxBlockChain::TxBlockChain() : m_txBlocks(TX_BLOCKCHAIN_SIZE, make_shared<const TxBlock>())
 {
-    m_txBlocks.resize(TX_BLOCKCHAIN_SIZE);
 }
 
 TxBlockChain::~TxBlockChain()
@@ -30,57 +29,55 @@ TxBlockChain::~TxBlockChain()
 
 }
 
-uint256_t TxBlockChain::GetBlockCount()
+uint64_t TxBlockChain::GetBlockCount()
 {
-    lock_guard<mutex> g(m_mutexTxBlocks);
     return m_txBlocks.size();
 }
 
-TxBlock TxBlockChain::GetLastBlock()
+shared_ptr<const TxBlock> TxBlockChain::GetLastBlock()
 {
-    lock_guard<mutex> g(m_mutexTxBlocks);
-    return m_txBlocks.back();
+    return m_txBlocks.Back();
 }
 
-TxBlock TxBlockChain::GetBlock(const uint256_t & blockNum)
+shared_ptr<const TxBlock> TxBlockChain::GetBlock(uint64_t blockNum)
 {
-    lock_guard<mutex> g(m_mutexTxBlocks);
+    uint64_t blockCount = m_txBlocks.size();
 
-    if (blockNum >= m_txBlocks.size())
+    if (blockNum >= blockCount)
     {
         throw "Blocknumber Absent";
     }
-    else if(blockNum + m_txBlocks.capacity() < m_txBlocks.size())
+    else if (blockNum + m_txBlocks.capacity() >= blockCount)
     {
-        TxBlockSharedPtr block;
-        BlockStorage::GetBlockStorage().GetTxBlock(blockNum, block);
-        return *block;
-    }
-
-    // To-do: We cannot even index into a vector using uint256_t
-    // uint256_t might just be too big to begin with
-    // Consider switching to uint64_t
-    // For now we directly cast to uint64_t
+        shared_ptr<const TxBlock> block = m_txBlocks.Get(blockNum);
 
-    assert(m_txBlocks[blockNum].GetHeader().GetBlockNum() == blockNum);
-    return m_txBlocks[blockNum];
+        // The slot may have been reused by a newer block since the count was read
+        if (block->GetHeader().GetBlockNum() == blockNum)
+        {
+            return block;
+        }
+    }
 
-    // return NULL;
+    TxBlockSharedPtr block;
+    if (!BlockStorage::GetBlockStorage().GetTxBlock(blockNum, block))
+    {
+        throw "Blocknumber Absent";
+    }
+    return block;
 }
 
 int TxBlockChain::AddBlock(const TxBlock & block)
 {
-    boost::multiprecision::uint256_t blockNumOfNewBlock = block.GetHeader().GetBlockNum();
+    uint256_t blockNumOfNewBlock = block.GetHeader().GetBlockNum();
+    uint64_t index = blockNumOfNewBlock.convert_to<uint64_t>();
 
     lock_guard<mutex> g(m_mutexTxBlocks);
 
-    boost::multiprecision::uint256_t blockNumOfExistingBlock =
-            m_txBlocks[blockNumOfNewBlock].GetHeader().GetBlockNum();
+    uint256_t blockNumOfExistingBlock = m_txBlocks.Get(index)->GetHeader().GetBlockNum();
 
-    if(blockNumOfExistingBlock < blockNumOfNewBlock ||
-       blockNumOfExistingBlock == (boost::multiprecision::uint256_t) -1)
+    if (blockNumOfExistingBlock < blockNumOfNewBlock || blockNumOfExistingBlock == (uint256_t) -1)
     {
-        m_txBlocks.insert_new(blockNumOfNewBlock, block);
+        m_txBlocks.Publish(index, make_shared<const TxBlock>(block));
     }
     else
     {
@@ -88,6 +85,4 @@ int TxBlockChain::AddBlock(const TxBlock & block)
     }
 
     return 1;
-    // lock_guard<mutex> g(m_mutexTxBlocks);
-    // m_txBlocks.push_back(block);
 }
\ No newline at end of file
@@ -17,37 +17,41 @@
 #ifndef __TXBLOCKCHAIN_H__
 #define __TXBLOCKCHAIN_H__
 
-#include <vector>
+#include <memory>
 #include <mutex>
+#include <vector>
 
-#include <boost/multiprecision/cpp_int.hpp>
-
-#include "libData/DataStructures/CircularArray.h"
 #include "libData/BlockData/Block/TxBlock.h"
+#include "libData/DataStructures/SnapshotRing.h"
 #include "libPersistence/BlockStorage.h"
 
 /// Transient storage for Tx blocks.
+///
+/// The most recent blocks are kept in a ring that readers access without locking. Blocks are
+/// shared and immutable once added, so readers hold them without copying; older blocks are
+/// loaded from block storage.
 class TxBlockChain
 {
+    // Serializes AddBlock, the only writer
     std::mutex m_mutexTxBlocks;
-    CircularArray<TxBlock>  m_txBlocks;
+    SnapshotRing<TxBlock> m_txBlocks;
 
 public:
 
-	/// Constructor.
+    /// Constructor.
     TxBlockChain();
 
     /// Destructor.
     ~TxBlockChain();
 
     /// Returns the number of blocks.
-    boost::multiprecision::uint256_t GetBlockCount();
+    uint64_t GetBlockCount();
 
     /// Returns the last stored block.
-    TxBlock GetLastBlock();
+    std::shared_ptr<const TxBlock> GetLastBlock();
 
     /// Returns the block at the specified block number.
-    TxBlock GetBlock(const boost::multiprecision::uint256_t & blocknum);
+    std::shared_ptr<const TxBlock> GetBlock(uint64_t blocknum);
 
     /// Adds a block to the chain.
     int AddBlock(const TxBlock & block);
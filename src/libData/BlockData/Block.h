@@ -20,6 +20,7 @@
 #include "Block/DSBlock.h"
 #include "BlockHeader/DSBlockHeader.h"
 #include "Block/MicroBlock.h"
+#include "Block/CompactMicroBlock.h"
 #include "BlockHeader/MicroBlockHeader.h"
 #include "Block/TxBlock.h"
 #include "BlockHeader/TxBlockHeader.h"
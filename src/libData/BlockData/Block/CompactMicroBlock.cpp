@@ -0,0 +1,287 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <unordered_map>
+
+#include "CompactMicroBlock.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+namespace
+{
+    inline uint64_t RotateLeft(uint64_t x, unsigned int b)
+    {
+        return (x << b) | (x >> (64 - b));
+    }
+
+    inline void SipRound(uint64_t & v0, uint64_t & v1, uint64_t & v2, uint64_t & v3)
+    {
+        v0 += v1; v1 = RotateLeft(v1, 13); v1 ^= v0; v0 = RotateLeft(v0, 32);
+        v2 += v3; v3 = RotateLeft(v3, 16); v3 ^= v2;
+        v0 += v3; v3 = RotateLeft(v3, 21); v3 ^= v0;
+        v2 += v1; v1 = RotateLeft(v1, 17); v1 ^= v2; v2 = RotateLeft(v2, 32);
+    }
+
+    inline uint64_t ReadWord(const unsigned char * p)
+    {
+        uint64_t w = 0;
+        for (unsigned int i = 0; i < 8; i++)
+        {
+            w |= static_cast<uint64_t>(p[i]) << (8 * i);
+        }
+        return w;
+    }
+
+    // SipHash-2-4 over a 32-byte transaction hash
+    uint64_t SipHash(uint64_t k0, uint64_t k1, const TxnHash & tranHash)
+    {
+        uint64_t v0 = 0x736f6d6570736575ULL ^ k0;
+        uint64_t v1 = 0x646f72616e646f6dULL ^ k1;
+        uint64_t v2 = 0x6c7967656e657261ULL ^ k0;
+        uint64_t v3 = 0x7465646279746573ULL ^ k1;
+
+        const unsigned char * data = tranHash.asArray().data();
+
+        for (unsigned int i = 0; i < TRAN_HASH_SIZE; i += 8)
+        {
+            uint64_t m = ReadWord(data + i);
+            v3 ^= m;
+            SipRound(v0, v1, v2, v3);
+            SipRound(v0, v1, v2, v3);
+            v0 ^= m;
+        }
+
+        uint64_t b = static_cast<uint64_t>(TRAN_HASH_SIZE) << 56;
+        v3 ^= b;
+        SipRound(v0, v1, v2, v3);
+        SipRound(v0, v1, v2, v3);
+        v0 ^= b;
+
+        v2 ^= 0xFF;
+        for (unsigned int i = 0; i < 4; i++)
+        {
+            SipRound(v0, v1, v2, v3);
+        }
+
+        return v0 ^ v1 ^ v2 ^ v3;
+    }
+}
+
+CompactMicroBlock::CompactMicroBlock() : m_salt(0)
+{
+
+}
+
+CompactMicroBlock::CompactMicroBlock(const vector<unsigned char> & src, unsigned int offset) : m_salt(0)
+{
+    Deserialize(src, offset);
+}
+
+CompactMicroBlock::CompactMicroBlock(const MicroBlock & microblock, uint64_t salt) : 
+    m_header(microblock.GetHeader()), m_headerSig(microblock.GetHeaderSig()), m_salt(salt)
+{
+    const vector<TxnHash> & tranHashes = microblock.GetTranHashes();
+
+    m_shortIDs.reserve(tranHashes.size());
+    for (const auto & tranHash : tranHashes)
+    {
+        m_shortIDs.push_back(GetShortID(tranHash));
+    }
+}
+
+unsigned int CompactMicroBlock::Serialize(vector<unsigned char> & dst, unsigned int offset) const
+{
+    LOG_MARKER();
+
+    unsigned int size_needed = GetSerializedSize();
+
+    if (dst.size() < offset + size_needed)
+    {
+        dst.resize(offset + size_needed);
+    }
+
+    m_header.Serialize(dst, offset);
+
+    unsigned int curOffset = offset + MicroBlock::GetMinSize();
+
+    copy(m_headerSig.begin(), m_headerSig.end(), dst.begin() + curOffset);
+    curOffset += BLOCK_SIG_SIZE;
+
+    SetNumber<uint64_t>(dst, curOffset, m_salt, sizeof(uint64_t));
+    curOffset += sizeof(uint64_t);
+
+    for (const auto & shortID : m_shortIDs)
+    {
+        SetNumber<uint64_t>(dst, curOffset, shortID, SHORT_ID_SIZE);
+        curOffset += SHORT_ID_SIZE;
+    }
+
+    return size_needed;
+}
+
+void CompactMicroBlock::Deserialize(const vector<unsigned char> & src, unsigned int offset)
+{
+    LOG_MARKER();
+
+    m_shortIDs.clear();
+
+    if (!CheckSerializedSize(src, offset))
+    {
+        LOG_MESSAGE("Error: Compact microblock size does not match its transaction count");
+        return;
+    }
+
+    m_header = MicroBlockHeader(src, offset);
+
+    unsigned int curOffset = offset + MicroBlock::GetMinSize();
+
+    copy(src.begin() + curOffset, src.begin() + curOffset + BLOCK_SIG_SIZE, m_headerSig.begin());
+    curOffset += BLOCK_SIG_SIZE;
+
+    m_salt = GetNumber<uint64_t>(src, curOffset, sizeof(uint64_t));
+    curOffset += sizeof(uint64_t);
+
+    m_shortIDs.reserve(m_header.GetNumTxs());
+    for (unsigned int i = 0; i < m_header.GetNumTxs(); i++)
+    {
+        m_shortIDs.push_back(GetNumber<uint64_t>(src, curOffset, SHORT_ID_SIZE));
+        curOffset += SHORT_ID_SIZE;
+    }
+}
+
+bool CompactMicroBlock::CheckSerializedSize(const vector<unsigned char> & src, unsigned int offset)
+{
+    const uint64_t minSize = MicroBlock::GetMinSize() + BLOCK_SIG_SIZE + sizeof(uint64_t);
+
+    if ((src.size() < offset) || (src.size() - offset < minSize))
+    {
+        return false;
+    }
+
+    // The count comes from the sender, so it is checked against the bytes actually received
+    uint64_t numTxs = MicroBlockHeader(src, offset).GetNumTxs();
+    return (src.size() - offset - minSize) == numTxs * SHORT_ID_SIZE;
+}
+
+unsigned int CompactMicroBlock::GetSerializedSize() const
+{
+    return MicroBlock::GetMinSize() + BLOCK_SIG_SIZE + sizeof(uint64_t) + 
+           (m_shortIDs.size() * SHORT_ID_SIZE);
+}
+
+const MicroBlockHeader & CompactMicroBlock::GetHeader() const
+{
+    return m_header;
+}
+
+const array<unsigned char, BLOCK_SIG_SIZE> & CompactMicroBlock::GetHeaderSig() const
+{
+    return m_headerSig;
+}
+
+const vector<uint64_t> & CompactMicroBlock::GetShortIDs() const
+{
+    return m_shortIDs;
+}
+
+uint64_t CompactMicroBlock::GetShortID(const TxnHash & tranHash) const
+{
+    uint64_t mask = (static_cast<uint64_t>(1) << (8 * SHORT_ID_SIZE)) - 1;
+    return ComputeKeyedID(m_salt, m_header.GetTxRootHash(), tranHash) & mask;
+}
+
+uint64_t CompactMicroBlock::ComputeKeyedID(uint64_t salt, const TxnHash & txRootHash, const TxnHash & tranHash)
+{
+    // Keyed by the sender's salt and the root the IDs must add up to, so IDs cannot be ground in advance
+    return SipHash(salt, ReadWord(txRootHash.asArray().data()), tranHash);
+}
+
+void CompactMicroBlock::Reconstruct(const vector<TxnHash> & pool, vector<TxnHash> & tranHashes,
+                                    vector<uint32_t> & missing) const
+{
+    LOG_MARKER();
+
+    enum SlotState : unsigned char
+    {
+        EMPTY = 0,
+        FILLED,
+        AMBIGUOUS
+    };
+
+    tranHashes.assign(m_shortIDs.size(), TxnHash());
+    missing.clear();
+
+    vector<unsigned char> slotStates(m_shortIDs.size(), EMPTY);
+
+    unordered_map<uint64_t, uint32_t> indexOfShortID;
+    indexOfShortID.reserve(m_shortIDs.size());
+    for (uint32_t i = 0; i < m_shortIDs.size(); i++)
+    {
+        // Two entries in the block sharing a short ID cannot be told apart and are fetched instead
+        if (!indexOfShortID.insert(make_pair(m_shortIDs.at(i), i)).second)
+        {
+            slotStates.at(i) = AMBIGUOUS;
+            slotStates.at(indexOfShortID.at(m_shortIDs.at(i))) = AMBIGUOUS;
+        }
+    }
+
+    for (const auto & tranHash : pool)
+    {
+        auto it = indexOfShortID.find(GetShortID(tranHash));
+        if (it == indexOfShortID.end())
+        {
+            continue;
+        }
+
+        unsigned char & slotState = slotStates.at(it->second);
+        if (slotState == EMPTY)
+        {
+            tranHashes.at(it->second) = tranHash;
+            slotState = FILLED;
+        }
+        else if ((slotState == FILLED) && (tranHashes.at(it->second) != tranHash))
+        {
+            // Two local transactions map to the same short ID
+            slotState = AMBIGUOUS;
+        }
+    }
+
+    for (uint32_t i = 0; i < slotStates.size(); i++)
+    {
+        if (slotStates.at(i) != FILLED)
+        {
+            missing.push_back(i);
+        }
+    }
+}
+
+bool CompactMicroBlock::Fill(uint32_t index, const TxnHash & tranHash, vector<TxnHash> & tranHashes) const
+{
+    if ((index >= m_shortIDs.size()) || (tranHashes.size() != m_shortIDs.size()) || 
+        (GetShortID(tranHash) != m_shortIDs.at(index)))
+    {
+        return false;
+    }
+
+    tranHashes.at(index) = tranHash;
+    return true;
+}
+
+MicroBlock CompactMicroBlock::ToMicroBlock(const vector<TxnHash> & tranHashes) const
+{
+    return MicroBlock(m_header, m_headerSig, tranHashes);
+}
@@ -0,0 +1,96 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#ifndef __COMPACTMICROBLOCK_H__
+#define __COMPACTMICROBLOCK_H__
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "MicroBlock.h"
+#include "common/Serializable.h"
+#include "common/Constants.h"
+#include "libData/AccountData/Transaction.h"
+#include "libData/BlockData/BlockHeader/MicroBlockHeader.h"
+
+/// Compact announcement of a microblock: the header and signature as usual, but each transaction
+/// hash is replaced by a short salted ID. Receivers rebuild the hash list from their own pool and
+/// only fetch the entries they cannot resolve.
+class CompactMicroBlock : public Serializable
+{
+    MicroBlockHeader m_header;
+    std::array<unsigned char, BLOCK_SIG_SIZE> m_headerSig;
+    uint64_t m_salt;
+    std::vector<uint64_t> m_shortIDs;
+
+public:
+
+    /// Number of bytes of each short transaction ID on the wire.
+    static const unsigned int SHORT_ID_SIZE = 6;
+
+    /// Default constructor.
+    CompactMicroBlock();
+
+    /// Constructor for loading compact microblock information from a byte stream.
+    CompactMicroBlock(const std::vector<unsigned char> & src, unsigned int offset);
+
+    /// Constructor for compacting a full microblock with the given salt.
+    CompactMicroBlock(const MicroBlock & microblock, uint64_t salt);
+
+    /// Implements the Serialize function inherited from Serializable.
+    unsigned int Serialize(std::vector<unsigned char> & dst, unsigned int offset) const;
+
+    /// Implements the Deserialize function inherited from Serializable.
+    /// Leaves no short IDs if the byte stream fails CheckSerializedSize.
+    void Deserialize(const std::vector<unsigned char> & src, unsigned int offset);
+
+    /// Returns true if the byte stream from offset to its end holds exactly one compact microblock,
+    /// i.e. the short IDs after the header fill it and match the transaction count in the header.
+    static bool CheckSerializedSize(const std::vector<unsigned char> & src, unsigned int offset);
+
+    /// Returns the size in bytes when serializing the compact microblock.
+    unsigned int GetSerializedSize() const;
+
+    /// Returns the microblock header.
+    const MicroBlockHeader & GetHeader() const;
+
+    /// Returns the microblock header signature.
+    const std::array<unsigned char, BLOCK_SIG_SIZE> & GetHeaderSig() const;
+
+    /// Returns the short transaction IDs in microblock order.
+    const std::vector<uint64_t> & GetShortIDs() const;
+
+    /// Computes the short ID of a transaction hash under this block's salt.
+    uint64_t GetShortID(const TxnHash & tranHash) const;
+
+    /// Computes the 64-bit ID of a transaction hash keyed by a salt and the txn root of its microblock.
+    /// Short IDs are its low bytes; other messages that name txns of a known microblock use all of it.
+    static uint64_t ComputeKeyedID(uint64_t salt, const TxnHash & txRootHash, const TxnHash & tranHash);
+
+    /// Resolves short IDs against the transaction hashes in the local pool.
+    /// tranHashes is sized to the block; indices that are unknown or ambiguous are returned in missing.
+    void Reconstruct(const std::vector<TxnHash> & pool, std::vector<TxnHash> & tranHashes,
+                     std::vector<uint32_t> & missing) const;
+
+    /// Places a fetched transaction hash at the given index if it matches the short ID there.
+    bool Fill(uint32_t index, const TxnHash & tranHash, std::vector<TxnHash> & tranHashes) const;
+
+    /// Builds the full microblock from a completely resolved hash list.
+    MicroBlock ToMicroBlock(const std::vector<TxnHash> & tranHashes) const;
+};
+
+#endif // __COMPACTMICROBLOCK_H__
@@ -40,7 +40,7 @@ unsigned int DSBlock::Serialize(vector<unsigned char> & dst, unsigned int offset
 {
     LOG_MARKER();
 
-    unsigned int header_size_needed = sizeof(uint8_t) + BLOCK_HASH_SIZE + UINT256_SIZE + PUB_KEY_SIZE + PUB_KEY_SIZE + UINT256_SIZE + UINT256_SIZE;
+    unsigned int header_size_needed = DSBlockHeader::Layout::SIZE;
     unsigned int size_needed = header_size_needed + BLOCK_SIG_SIZE;
     unsigned int size_remaining = dst.size() - offset;
 
@@ -59,7 +59,7 @@ void DSBlock::Deserialize(const vector<unsigned char> & src, unsigned int offset
 {
     LOG_MARKER();
 
-    unsigned int header_size_needed = sizeof(uint8_t) + BLOCK_HASH_SIZE + UINT256_SIZE + PUB_KEY_SIZE + PUB_KEY_SIZE + UINT256_SIZE + UINT256_SIZE;
+    unsigned int header_size_needed = DSBlockHeader::Layout::SIZE;
 
     DSBlockHeader header(src, offset);
     m_header = header;
@@ -68,8 +68,7 @@ void DSBlock::Deserialize(const vector<unsigned char> & src, unsigned int offset
 
 unsigned int DSBlock::GetSerializedSize()
 {
-    unsigned int header_size_needed = sizeof(uint8_t) + BLOCK_HASH_SIZE + UINT256_SIZE + PUB_KEY_SIZE + PUB_KEY_SIZE +
-            UINT256_SIZE + UINT256_SIZE;
+    unsigned int header_size_needed = DSBlockHeader::Layout::SIZE;
     unsigned int size_needed = header_size_needed + BLOCK_SIG_SIZE;
 
     return size_needed;
@@ -26,9 +26,7 @@ unsigned int MicroBlock::Serialize(vector<unsigned char> & dst, unsigned int off
 
     assert(m_header.GetNumTxs() == m_tranHashes.size());
 
-    unsigned int header_size_needed = sizeof(uint8_t) + sizeof(uint32_t) + UINT256_SIZE + UINT256_SIZE + 
-                                        BLOCK_HASH_SIZE + UINT256_SIZE + UINT256_SIZE + TRAN_HASH_SIZE + 
-                                        sizeof(uint32_t) + PUB_KEY_SIZE + UINT256_SIZE + BLOCK_HASH_SIZE;
+    unsigned int header_size_needed = MicroBlockHeader::Layout::SIZE;
 
     unsigned int size_needed = header_size_needed + BLOCK_SIG_SIZE + m_header.GetNumTxs() * TRAN_HASH_SIZE;
     unsigned int size_remaining = dst.size() - offset;
@@ -58,9 +56,7 @@ void MicroBlock::Deserialize(const vector<unsigned char> & src, unsigned int off
 {
     LOG_MARKER();
 
-    unsigned int header_size_needed = sizeof(uint8_t) + sizeof(uint32_t) + UINT256_SIZE + UINT256_SIZE + 
-                                        BLOCK_HASH_SIZE + UINT256_SIZE + UINT256_SIZE + TRAN_HASH_SIZE + 
-                                        sizeof(uint32_t) + PUB_KEY_SIZE + UINT256_SIZE + BLOCK_HASH_SIZE;
+    unsigned int header_size_needed = MicroBlockHeader::Layout::SIZE;
 
     MicroBlockHeader header(src, offset);
     m_header = header;
@@ -81,9 +77,7 @@ void MicroBlock::Deserialize(const vector<unsigned char> & src, unsigned int off
 
 unsigned int MicroBlock::GetSerializedSize() const
 {
-    unsigned int header_size_needed = sizeof(uint8_t) + sizeof(uint32_t) + UINT256_SIZE + UINT256_SIZE + 
-                                      BLOCK_HASH_SIZE + UINT256_SIZE + UINT256_SIZE + TRAN_HASH_SIZE + 
-                                      sizeof(uint32_t) + PUB_KEY_SIZE + UINT256_SIZE + BLOCK_HASH_SIZE;
+    unsigned int header_size_needed = MicroBlockHeader::Layout::SIZE;
     unsigned int block_size_needed = BLOCK_SIG_SIZE + (m_tranHashes.size() * TRAN_HASH_SIZE);
 
     return header_size_needed + block_size_needed;
@@ -91,9 +85,7 @@ unsigned int MicroBlock::GetSerializedSize() const
 
 unsigned int MicroBlock::GetMinSize()
 {
-    unsigned int header_size_needed = sizeof(uint8_t) + sizeof(uint32_t) + UINT256_SIZE + UINT256_SIZE + 
-                                      BLOCK_HASH_SIZE + UINT256_SIZE + UINT256_SIZE + TRAN_HASH_SIZE + 
-                                      sizeof(uint32_t) + PUB_KEY_SIZE + UINT256_SIZE + BLOCK_HASH_SIZE;
+    unsigned int header_size_needed = MicroBlockHeader::Layout::SIZE;
 
     return header_size_needed;
 }
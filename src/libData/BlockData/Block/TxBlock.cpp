@@ -26,9 +26,7 @@ unsigned int TxBlock::Serialize(vector<unsigned char> & dst, unsigned int offset
 
     assert(m_header.GetNumMicroBlockHashes() == m_microBlockHashes.size());
 
-    unsigned int header_size_needed = sizeof(uint8_t) + sizeof(uint32_t) + UINT256_SIZE + UINT256_SIZE + 
-                                      BLOCK_HASH_SIZE + UINT256_SIZE + UINT256_SIZE + TRAN_HASH_SIZE + 
-                                      sizeof(uint32_t) + sizeof(uint32_t) + PUB_KEY_SIZE + UINT256_SIZE + BLOCK_HASH_SIZE;
+    unsigned int header_size_needed = TxBlockHeader::Layout::SIZE;
 
     unsigned int size_needed = header_size_needed + BLOCK_SIG_SIZE + m_header.GetNumMicroBlockHashes() * TRAN_HASH_SIZE;
     unsigned int size_remaining = dst.size() - offset;
@@ -59,9 +57,7 @@ void TxBlock::Deserialize(const vector<unsigned char> & src, unsigned int offset
 {
     LOG_MARKER();
 
-    unsigned int header_size_needed = sizeof(uint8_t) + sizeof(uint32_t) + UINT256_SIZE + UINT256_SIZE + 
-                                      BLOCK_HASH_SIZE + UINT256_SIZE + UINT256_SIZE + TRAN_HASH_SIZE + 
-                                      sizeof(uint32_t) + sizeof(uint32_t) + PUB_KEY_SIZE + UINT256_SIZE + BLOCK_HASH_SIZE;
+    unsigned int header_size_needed = TxBlockHeader::Layout::SIZE;
 
     TxBlockHeader header(src, offset);
     m_header = header;
@@ -83,9 +79,7 @@ void TxBlock::Deserialize(const vector<unsigned char> & src, unsigned int offset
 
 unsigned int TxBlock::GetSerializedSize() const
 {
-    unsigned int header_size_needed = sizeof(uint8_t) + sizeof(uint32_t) + UINT256_SIZE + UINT256_SIZE + 
-                                      BLOCK_HASH_SIZE + UINT256_SIZE + UINT256_SIZE + TRAN_HASH_SIZE + 
-                                      sizeof(uint32_t) + sizeof(uint32_t) + PUB_KEY_SIZE + UINT256_SIZE + BLOCK_HASH_SIZE;
+    unsigned int header_size_needed = TxBlockHeader::Layout::SIZE;
     unsigned int block_size_needed = BLOCK_SIG_SIZE + (m_microBlockHashes.size() * TRAN_HASH_SIZE);
 
     return header_size_needed + block_size_needed;
@@ -93,9 +87,7 @@ unsigned int TxBlock::GetSerializedSize() const
 
 unsigned int TxBlock::GetMinSize()
 {
-    unsigned int header_size_needed = sizeof(uint8_t) + sizeof(uint32_t) + UINT256_SIZE + UINT256_SIZE + 
-                                      BLOCK_HASH_SIZE + UINT256_SIZE + UINT256_SIZE + TRAN_HASH_SIZE + 
-                                      sizeof(uint32_t) + sizeof(uint32_t) + PUB_KEY_SIZE + UINT256_SIZE + BLOCK_HASH_SIZE;
+    unsigned int header_size_needed = TxBlockHeader::Layout::SIZE;
 
     return header_size_needed;
 }
@@ -48,53 +48,32 @@ unsigned int DSBlockHeader::Serialize(vector<unsigned char> & dst, unsigned int
 {
     LOG_MARKER();
 
-    unsigned int size_needed = sizeof(uint8_t) + BLOCK_HASH_SIZE + UINT256_SIZE + PUB_KEY_SIZE + PUB_KEY_SIZE + 
-                               UINT256_SIZE + UINT256_SIZE;
-    unsigned int size_remaining = dst.size() - offset;
+    ByteWriter writer(dst, offset, Layout::SIZE);
 
-    if (size_remaining < size_needed)
-    {
-        dst.resize(size_needed + offset);
-    }
+    writer.WriteNumber(m_difficulty, sizeof(uint8_t));
+    writer.WriteBytes(m_prevHash.asArray());
+    writer.WriteNumber(m_nonce, UINT256_SIZE);
+    writer.WriteObject(m_minerPubKey, PUB_KEY_SIZE);
+    writer.WriteObject(m_leaderPubKey, PUB_KEY_SIZE);
+    writer.WriteNumber(m_blockNum, UINT256_SIZE);
+    writer.WriteNumber(m_timestamp, UINT256_SIZE);
 
-    unsigned int curOffset = offset;
-
-    SetNumber<uint8_t>(dst, curOffset, m_difficulty, sizeof(uint8_t));
-    curOffset += sizeof(uint8_t);
-    copy(m_prevHash.asArray().begin(), m_prevHash.asArray().end(), dst.begin() + curOffset);
-    curOffset += BLOCK_HASH_SIZE;
-    SetNumber<uint256_t>(dst, curOffset, m_nonce, UINT256_SIZE);
-    curOffset += UINT256_SIZE;
-    m_minerPubKey.Serialize(dst, curOffset);
-    curOffset += PUB_KEY_SIZE;
-    m_leaderPubKey.Serialize(dst, curOffset);
-    curOffset += PUB_KEY_SIZE;
-    SetNumber<uint256_t>(dst, curOffset, m_blockNum, UINT256_SIZE);
-    curOffset += UINT256_SIZE;
-    SetNumber<uint256_t>(dst, curOffset, m_timestamp, UINT256_SIZE);
-
-    return size_needed;
+    return Layout::SIZE;
 }
 
 void DSBlockHeader::Deserialize(const vector<unsigned char> & src, unsigned int offset)
 {
     LOG_MARKER();
 
-    unsigned int curOffset = offset;
-
-    m_difficulty = GetNumber<uint8_t>(src, curOffset, sizeof(uint8_t));
-    curOffset += sizeof(uint8_t);
-    copy(src.begin() + curOffset, src.begin() + curOffset + BLOCK_HASH_SIZE, m_prevHash.asArray().begin());
-    curOffset += BLOCK_HASH_SIZE;
-    m_nonce = GetNumber<uint256_t>(src, curOffset, UINT256_SIZE);
-    curOffset += UINT256_SIZE;
-    m_minerPubKey.Deserialize(src, curOffset);
-    curOffset += PUB_KEY_SIZE;
-    m_leaderPubKey.Deserialize(src, curOffset);
-    curOffset += PUB_KEY_SIZE;
-    m_blockNum = GetNumber<uint256_t>(src, curOffset, UINT256_SIZE);
-    curOffset += UINT256_SIZE;
-    m_timestamp = GetNumber<uint256_t>(src, curOffset, UINT256_SIZE);
+    ByteReader reader(src, offset);
+
+    m_difficulty = reader.ReadNumber<uint8_t>(sizeof(uint8_t));
+    reader.ReadBytes(m_prevHash.asArray());
+    m_nonce = reader.ReadNumber<uint256_t>(UINT256_SIZE);
+    reader.ReadObject(m_minerPubKey, PUB_KEY_SIZE);
+    reader.ReadObject(m_leaderPubKey, PUB_KEY_SIZE);
+    m_blockNum = reader.ReadNumber<uint256_t>(UINT256_SIZE);
+    m_timestamp = reader.ReadNumber<uint256_t>(UINT256_SIZE);
 }
 
 const uint8_t & DSBlockHeader::GetDifficulty() const
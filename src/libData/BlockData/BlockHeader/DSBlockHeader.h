@@ -39,6 +39,10 @@ class DSBlockHeader : public BlockHeaderBase
 
 public:
 
+    /// Serialized field sizes: [difficulty] [prev hash] [nonce] [miner pubkey] [leader pubkey] [block num] [timestamp]
+    typedef FieldLayout<sizeof(uint8_t), BLOCK_HASH_SIZE, UINT256_SIZE, PUB_KEY_SIZE, PUB_KEY_SIZE, 
+                        UINT256_SIZE, UINT256_SIZE> Layout;
+
     /// Default constructor.
     DSBlockHeader(); // creates a dummy invalid placeholder BlockHeader -- blocknum is maxsize of uint256
 
@@ -43,6 +43,12 @@ class MicroBlockHeader : public BlockHeaderBase
 
 public:
     
+    /// Serialized field sizes: [type] [version] [gas limit] [gas used] [prev hash] [block num] [timestamp]
+    /// [tx root hash] [num txs] [miner pubkey] [DS block num] [DS block header hash]
+    typedef FieldLayout<sizeof(uint8_t), sizeof(uint32_t), UINT256_SIZE, UINT256_SIZE, BLOCK_HASH_SIZE, 
+                        UINT256_SIZE, UINT256_SIZE, TRAN_HASH_SIZE, sizeof(uint32_t), PUB_KEY_SIZE, 
+                        UINT256_SIZE, BLOCK_HASH_SIZE> Layout;
+
     // Constructors
     MicroBlockHeader();
     MicroBlockHeader(const std::vector<unsigned char> & src, unsigned int offset);
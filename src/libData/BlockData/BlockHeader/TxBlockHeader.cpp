@@ -56,77 +56,42 @@ unsigned int TxBlockHeader::Serialize(vector<unsigned char> & dst, unsigned int
 {
     LOG_MARKER();
 
-    unsigned int size_needed = sizeof(uint8_t) + sizeof(uint32_t) + UINT256_SIZE + UINT256_SIZE + 
-                               BLOCK_HASH_SIZE + UINT256_SIZE + UINT256_SIZE + TRAN_HASH_SIZE + 
-                               sizeof(uint32_t) + sizeof(uint32_t) + PUB_KEY_SIZE + UINT256_SIZE + 
-                               BLOCK_HASH_SIZE;
-    unsigned int size_remaining = dst.size() - offset;
+    ByteWriter writer(dst, offset, Layout::SIZE);
 
-    if (size_remaining < size_needed)
-    {
-        dst.resize(size_needed + offset);
-    }
-
-    unsigned int curOffset = offset;
-
-    SetNumber<uint8_t>(dst, curOffset, m_type, sizeof(uint8_t));
-    curOffset += sizeof(uint8_t);
-    SetNumber<uint32_t>(dst, curOffset, m_version, sizeof(uint32_t));
-    curOffset += sizeof(uint32_t);
-    SetNumber<uint256_t>(dst, curOffset, m_gasLimit, UINT256_SIZE);
-    curOffset += UINT256_SIZE;
-    SetNumber<uint256_t>(dst, curOffset, m_gasUsed, UINT256_SIZE);
-    curOffset += UINT256_SIZE;
-    copy(m_prevHash.asArray().begin(), m_prevHash.asArray().end(), dst.begin() + curOffset);
-    curOffset += BLOCK_HASH_SIZE;
-    SetNumber<uint256_t>(dst, curOffset, m_blockNum, UINT256_SIZE);
-    curOffset += UINT256_SIZE;
-    SetNumber<uint256_t>(dst, curOffset, m_timestamp, UINT256_SIZE);
-    curOffset += UINT256_SIZE;
-    copy(m_txRootHash.asArray().begin(), m_txRootHash.asArray().end(), dst.begin() + curOffset);
-    curOffset += TRAN_HASH_SIZE;
-    SetNumber<uint32_t>(dst, curOffset, m_numTxs, sizeof(uint32_t));
-    curOffset += sizeof(uint32_t);
-    SetNumber<uint32_t>(dst, curOffset, m_numMicroBlockHashes, sizeof(uint32_t));
-    curOffset += sizeof(uint32_t);
-    m_minerPubKey.Serialize(dst, curOffset);
-    curOffset += PUB_KEY_SIZE;
-    SetNumber<uint256_t>(dst, curOffset, m_dsBlockNum, UINT256_SIZE);
-    curOffset += UINT256_SIZE;
-    copy(m_dsBlockHeader.asArray().begin(), m_dsBlockHeader.asArray().end(), dst.begin() + curOffset);
+    writer.WriteNumber(m_type, sizeof(uint8_t));
+    writer.WriteNumber(m_version, sizeof(uint32_t));
+    writer.WriteNumber(m_gasLimit, UINT256_SIZE);
+    writer.WriteNumber(m_gasUsed, UINT256_SIZE);
+    writer.WriteBytes(m_prevHash.asArray());
+    writer.WriteNumber(m_blockNum, UINT256_SIZE);
+    writer.WriteNumber(m_timestamp, UINT256_SIZE);
+    writer.WriteBytes(m_txRootHash.asArray());
+    writer.WriteNumber(m_numTxs, sizeof(uint32_t));
+    writer.WriteNumber(m_numMicroBlockHashes, sizeof(uint32_t));
+    writer.WriteObject(m_minerPubKey, PUB_KEY_SIZE);
+    writer.WriteNumber(m_dsBlockNum, UINT256_SIZE);
+    writer.WriteBytes(m_dsBlockHeader.asArray());
 
-    return size_needed;
+    return Layout::SIZE;
 }
 
 void TxBlockHeader::Deserialize(const vector<unsigned char> & src, unsigned int offset)
 {
     LOG_MARKER();
-    unsigned int curOffset = offset;
-    m_type = GetNumber<uint8_t>(src, curOffset, sizeof(uint8_t));
-    curOffset += sizeof(uint8_t);
-    m_version = GetNumber<uint32_t>(src, curOffset, sizeof(uint32_t));
-    curOffset += sizeof(uint32_t);
-    m_gasLimit = GetNumber<uint256_t>(src, curOffset, UINT256_SIZE);
-    curOffset += UINT256_SIZE;
-    m_gasUsed = GetNumber<uint256_t>(src, curOffset, UINT256_SIZE);
-    curOffset += UINT256_SIZE;
-    copy(src.begin() + curOffset, src.begin() + curOffset + BLOCK_HASH_SIZE, m_prevHash.asArray().begin());
-    curOffset += BLOCK_HASH_SIZE;
-    m_blockNum = GetNumber<uint256_t>(src, curOffset, UINT256_SIZE);
-    curOffset += UINT256_SIZE;
-    m_timestamp = GetNumber<uint256_t>(src, curOffset, UINT256_SIZE);
-    curOffset += UINT256_SIZE;
-    copy(src.begin() + curOffset, src.begin() + curOffset + TRAN_HASH_SIZE, m_txRootHash.asArray().begin());
-    curOffset += TRAN_HASH_SIZE;
-    m_numTxs = GetNumber<uint32_t>(src, curOffset, sizeof(uint32_t));
-    curOffset += sizeof(uint32_t);
-    m_numMicroBlockHashes = GetNumber<uint32_t>(src, curOffset, sizeof(uint32_t));
-    curOffset += sizeof(uint32_t);
-    m_minerPubKey.Deserialize(src, curOffset);
-    curOffset += PUB_KEY_SIZE;
-    m_dsBlockNum = GetNumber<uint256_t>(src, curOffset, UINT256_SIZE);
-    curOffset += UINT256_SIZE;
-    copy(src.begin() + curOffset, src.begin() + curOffset + BLOCK_HASH_SIZE, m_dsBlockHeader.asArray().begin());
+    ByteReader reader(src, offset);
+    m_type = reader.ReadNumber<uint8_t>(sizeof(uint8_t));
+    m_version = reader.ReadNumber<uint32_t>(sizeof(uint32_t));
+    m_gasLimit = reader.ReadNumber<uint256_t>(UINT256_SIZE);
+    m_gasUsed = reader.ReadNumber<uint256_t>(UINT256_SIZE);
+    reader.ReadBytes(m_prevHash.asArray());
+    m_blockNum = reader.ReadNumber<uint256_t>(UINT256_SIZE);
+    m_timestamp = reader.ReadNumber<uint256_t>(UINT256_SIZE);
+    reader.ReadBytes(m_txRootHash.asArray());
+    m_numTxs = reader.ReadNumber<uint32_t>(sizeof(uint32_t));
+    m_numMicroBlockHashes = reader.ReadNumber<uint32_t>(sizeof(uint32_t));
+    reader.ReadObject(m_minerPubKey, PUB_KEY_SIZE);
+    m_dsBlockNum = reader.ReadNumber<uint256_t>(UINT256_SIZE);
+    reader.ReadBytes(m_dsBlockHeader.asArray());
 }
 
 const uint8_t & TxBlockHeader::GetType() const
@@ -17,7 +17,7 @@
 #ifndef __CIRCULARARRAY_H__
 #define __CIRCULARARRAY_H__
 
-#include <boost/multiprecision/cpp_int.hpp>
+#include <cstdint>
 
 #include "libUtils/Logger.h"
 
@@ -27,7 +27,7 @@ class CircularArray
 {
     T * m_array;
     int m_capacity;
-    boost::multiprecision::uint256_t m_size;
+    uint64_t m_size;
 
 public:
 
@@ -60,25 +60,25 @@ public:
     }
 
     /// Index operator.
-    T & operator[](boost::multiprecision::uint256_t index)
+    T & operator[](uint64_t index)
     {
         if(m_array == nullptr)
         {
             LOG_MESSAGE("Error: m_array is nullptr")
             throw;
         }
-        return m_array[(int)(index % m_capacity)];
+        return m_array[index % m_capacity];
     }
 
     /// Adds an element to the array at the specified index.
-    void insert_new(boost::multiprecision::uint256_t index, const T & element)
+    void insert_new(uint64_t index, const T & element)
     {
         if(m_array == nullptr)
         {
             LOG_MESSAGE("Error: m_array is nullptr")
             throw;
         }
-        m_array[(int)(index % m_capacity)] = element;
+        m_array[index % m_capacity] = element;
         m_size++;
     }
 
@@ -90,7 +90,7 @@ public:
             LOG_MESSAGE("Error: m_array is nullptr")
             throw;
         }
-        return m_array[(int)((m_size-1) % m_capacity)];
+        return m_array[(m_size - 1) % m_capacity];
     }
 
     /// Adds an element to the end of the array.
@@ -101,13 +101,12 @@ public:
             LOG_MESSAGE("Error: m_array is nullptr")
             throw;
         }
-        // modulo arithmetic of 256-bit will probably be slow
-        m_array[(int)(m_size % m_capacity)] = element;
+        m_array[m_size % m_capacity] = element;
         m_size++;
     }
 
     /// Returns the number of elements currently stored in the array.
-    boost::multiprecision::uint256_t size()
+    uint64_t size()
     {
         return m_size;
     }
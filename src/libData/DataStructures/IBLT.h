@@ -0,0 +1,276 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#ifndef __IBLT_H__
+#define __IBLT_H__
+
+#include <cstdint>
+#include <unordered_set>
+#include <vector>
+
+#include "common/Serializable.h"
+
+/// Invertible Bloom lookup table over 64-bit keys.
+/// Two peers each fill a table with the same number of cells from their own key set; subtracting one
+/// from the other and decoding lists the keys held by only one side, as long as that difference is
+/// small relative to the table size.
+class IBLT : public Serializable
+{
+    struct Cell
+    {
+        int32_t m_count;
+        uint64_t m_keySum;
+        uint64_t m_hashSum;
+    };
+
+    std::vector<Cell> m_cells;
+
+    static uint64_t Mix(uint64_t key, uint64_t seed)
+    {
+        // splitmix64 finalizer
+        uint64_t z = key + seed * 0x9E3779B97F4A7C15ULL;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    unsigned int CellIndex(uint64_t key, unsigned int i) const
+    {
+        // Each hash function owns its own slice of the table, so a key never lands twice in one cell
+        const unsigned int sliceSize = m_cells.size() / NUM_HASHES;
+        return i * sliceSize + static_cast<unsigned int>(Mix(key, i + 1) % sliceSize);
+    }
+
+    static bool IsPure(const Cell & cell)
+    {
+        return ((cell.m_count == 1) || (cell.m_count == -1)) && (Mix(cell.m_keySum, 0) == cell.m_hashSum);
+    }
+
+    void Update(uint64_t key, int32_t delta)
+    {
+        if (m_cells.empty())
+        {
+            return;
+        }
+
+        const uint64_t check = Mix(key, 0);
+        for (unsigned int i = 0; i < NUM_HASHES; i++)
+        {
+            Cell & cell = m_cells.at(CellIndex(key, i));
+            cell.m_count += delta;
+            cell.m_keySum ^= key;
+            cell.m_hashSum ^= check;
+        }
+    }
+
+public:
+
+    /// Number of cells each key is added to.
+    static const unsigned int NUM_HASHES = 3;
+
+    /// Bytes per serialized cell.
+    static const unsigned int CELL_SIZE = sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint64_t);
+
+    /// Largest table built or accepted off the wire (about 2 MB serialized).
+    static const unsigned int MAX_NUM_CELLS = NUM_HASHES * (1 << 15);
+
+    /// Constructor. The cell count is rounded up to a multiple of NUM_HASHES and capped at MAX_NUM_CELLS.
+    explicit IBLT(unsigned int numCells = 0)
+    {
+        uint64_t rounded = (((uint64_t) numCells + NUM_HASHES - 1) / NUM_HASHES) * NUM_HASHES;
+        m_cells.assign((rounded < MAX_NUM_CELLS) ? rounded : MAX_NUM_CELLS, Cell{ 0, 0, 0 });
+    }
+
+    /// Constructor for loading a table from a byte stream.
+    IBLT(const std::vector<unsigned char> & src, unsigned int offset)
+    {
+        Deserialize(src, offset);
+    }
+
+    /// Returns a cell count that decodes a difference of the given size with high probability,
+    /// capped at MAX_NUM_CELLS.
+    static unsigned int GetNumCellsForDifference(unsigned int difference)
+    {
+        uint64_t numCells = 2 * (uint64_t) difference + 4 * NUM_HASHES;
+        return (numCells < MAX_NUM_CELLS) ? numCells : MAX_NUM_CELLS;
+    }
+
+    /// Adds a key.
+    void Insert(uint64_t key)
+    {
+        Update(key, 1);
+    }
+
+    /// Removes a key.
+    void Erase(uint64_t key)
+    {
+        Update(key, -1);
+    }
+
+    /// Subtracts another table of the same size cell by cell. Returns false if the sizes differ.
+    bool Subtract(const IBLT & other)
+    {
+        if (m_cells.size() != other.m_cells.size())
+        {
+            return false;
+        }
+
+        for (unsigned int i = 0; i < m_cells.size(); i++)
+        {
+            m_cells.at(i).m_count -= other.m_cells.at(i).m_count;
+            m_cells.at(i).m_keySum ^= other.m_cells.at(i).m_keySum;
+            m_cells.at(i).m_hashSum ^= other.m_cells.at(i).m_hashSum;
+        }
+
+        return true;
+    }
+
+    /// Lists the keys with positive and negative counts.
+    /// Returns false if the table could not be fully peeled, in which case the lists are incomplete.
+    /// A crafted table can make peeling cycle, so a key peeled twice or more keys than cells also fail.
+    bool Decode(std::vector<uint64_t> & positive, std::vector<uint64_t> & negative) const
+    {
+        std::vector<Cell> cells = m_cells;
+        IBLT work;
+        work.m_cells.swap(cells);
+
+        positive.clear();
+        negative.clear();
+
+        std::unordered_set<uint64_t> peeled;
+        std::vector<unsigned int> pureCells;
+        for (unsigned int i = 0; i < work.m_cells.size(); i++)
+        {
+            if (IsPure(work.m_cells.at(i)))
+            {
+                pureCells.push_back(i);
+            }
+        }
+
+        while (!pureCells.empty())
+        {
+            unsigned int index = pureCells.back();
+            pureCells.pop_back();
+
+            const Cell cell = work.m_cells.at(index);
+            if (!IsPure(cell))
+            {
+                continue;
+            }
+
+            if (!peeled.insert(cell.m_keySum).second || (peeled.size() > work.m_cells.size()))
+            {
+                return false;
+            }
+
+            if (cell.m_count == 1)
+            {
+                positive.push_back(cell.m_keySum);
+            }
+            else
+            {
+                negative.push_back(cell.m_keySum);
+            }
+
+            work.Update(cell.m_keySum, -cell.m_count);
+
+            for (unsigned int i = 0; i < NUM_HASHES; i++)
+            {
+                unsigned int neighbour = work.CellIndex(cell.m_keySum, i);
+                if (IsPure(work.m_cells.at(neighbour)))
+                {
+                    pureCells.push_back(neighbour);
+                }
+            }
+        }
+
+        for (const auto & remaining : work.m_cells)
+        {
+            if ((remaining.m_count != 0) || (remaining.m_keySum != 0) || (remaining.m_hashSum != 0))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    /// Returns the number of cells.
+    unsigned int GetNumCells() const
+    {
+        return m_cells.size();
+    }
+
+    /// Returns the size in bytes when serializing the table.
+    unsigned int GetSerializedSize() const
+    {
+        return sizeof(uint32_t) + m_cells.size() * CELL_SIZE;
+    }
+
+    /// Implements the Serialize function inherited from Serializable.
+    unsigned int Serialize(std::vector<unsigned char> & dst, unsigned int offset) const
+    {
+        unsigned int curOffset = offset;
+
+        SetNumber<uint32_t>(dst, curOffset, m_cells.size(), sizeof(uint32_t));
+        curOffset += sizeof(uint32_t);
+
+        for (const auto & cell : m_cells)
+        {
+            SetNumber<uint32_t>(dst, curOffset, static_cast<uint32_t>(cell.m_count), sizeof(uint32_t));
+            curOffset += sizeof(uint32_t);
+            SetNumber<uint64_t>(dst, curOffset, cell.m_keySum, sizeof(uint64_t));
+            curOffset += sizeof(uint64_t);
+            SetNumber<uint64_t>(dst, curOffset, cell.m_hashSum, sizeof(uint64_t));
+            curOffset += sizeof(uint64_t);
+        }
+
+        return curOffset - offset;
+    }
+
+    /// Implements the Deserialize function inherited from Serializable.
+    /// A stream too short for the advertised cell count, or one above MAX_NUM_CELLS, yields an empty table.
+    void Deserialize(const std::vector<unsigned char> & src, unsigned int offset)
+    {
+        m_cells.clear();
+
+        unsigned int curOffset = offset;
+
+        uint32_t numCells = GetNumber<uint32_t>(src, curOffset, sizeof(uint32_t));
+        curOffset += sizeof(uint32_t);
+
+        if ((numCells % NUM_HASHES != 0) || (numCells > MAX_NUM_CELLS) || (src.size() < curOffset) || 
+            ((src.size() - curOffset) / CELL_SIZE < numCells))
+        {
+            return;
+        }
+
+        m_cells.reserve(numCells);
+        for (unsigned int i = 0; i < numCells; i++)
+        {
+            Cell cell;
+            cell.m_count = static_cast<int32_t>(GetNumber<uint32_t>(src, curOffset, sizeof(uint32_t)));
+            curOffset += sizeof(uint32_t);
+            cell.m_keySum = GetNumber<uint64_t>(src, curOffset, sizeof(uint64_t));
+            curOffset += sizeof(uint64_t);
+            cell.m_hashSum = GetNumber<uint64_t>(src, curOffset, sizeof(uint64_t));
+            curOffset += sizeof(uint64_t);
+            m_cells.push_back(cell);
+        }
+    }
+};
+
+#endif // __IBLT_H__
@@ -0,0 +1,180 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+#ifndef __SNAPSHOTRING_H__
+#define __SNAPSHOTRING_H__
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+/// Fixed-capacity ring of the most recent elements, indexed by a 64-bit sequence number.
+///
+/// Each slot is a single atomic word holding a pointer to a node with an immutable element, plus
+/// the number of readers copying the element out of it. Readers and the single writer only use
+/// atomic read-modify-write operations on that word, so neither side ever waits on the other.
+/// Reference counting is split: a reader counts itself in the slot word, and the writer that
+/// replaces a node moves that count onto the node. Whoever brings it to zero frees the node. An
+/// element a reader holds stays alive after its slot is reused, so readers only need to check that
+/// the element they got still has the index they asked for.
+template<class T>
+class SnapshotRing
+{
+    struct Node
+    {
+        std::shared_ptr<const T> m_element;
+        std::atomic<int64_t> m_readers;  // readers still copying after the node left its slot, less those already done
+
+        explicit Node(std::shared_ptr<const T> element) : m_element(std::move(element)), m_readers(0)
+        {
+        }
+    };
+
+    // Slot word: node pointer in the low 48 bits, readers in the slot in the high 16 bits
+    static_assert(sizeof(void *) == sizeof(uint64_t), "SnapshotRing packs node pointers into 48 bits");
+    static const unsigned int POINTER_BITS = 48;
+    static const uint64_t POINTER_MASK = (1ULL << POINTER_BITS) - 1;
+    static const uint64_t ONE_READER = 1ULL << POINTER_BITS;
+
+    std::unique_ptr<std::atomic<uint64_t>[]> m_slots;
+    unsigned int m_capacity;
+    std::shared_ptr<const T> m_empty;
+    std::atomic<uint64_t> m_size;
+
+    static Node * ToNode(uint64_t word)
+    {
+        return reinterpret_cast<Node *>(word & POINTER_MASK);
+    }
+
+    static uint64_t ToWord(Node * node)
+    {
+        return reinterpret_cast<uint64_t>(node);
+    }
+
+    std::atomic<uint64_t> & GetSlot(uint64_t index) const
+    {
+        return m_slots[index % m_capacity];
+    }
+
+    // Drops a reference a reader took in the slot word
+    static void Release(std::atomic<uint64_t> & slot, Node * node)
+    {
+        uint64_t word = slot.load(std::memory_order_relaxed);
+        while (ToNode(word) == node)
+        {
+            if (slot.compare_exchange_weak(word, word - ONE_READER, std::memory_order_release, std::memory_order_relaxed))
+            {
+                return;
+            }
+        }
+
+        // The writer has replaced the node and moved this reader's count onto it
+        if (node->m_readers.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        {
+            delete node;
+        }
+    }
+
+    // Hands a node that has just left its slot over to the readers still copying from it
+    static void Retire(uint64_t word)
+    {
+        const int64_t readers = word >> POINTER_BITS;
+        Node * node = ToNode(word);
+        if (node->m_readers.fetch_add(readers, std::memory_order_acq_rel) == -readers)
+        {
+            delete node;
+        }
+    }
+
+public:
+
+    /// Constructor. Every slot starts out holding empty.
+    SnapshotRing(unsigned int capacity, const std::shared_ptr<const T> & empty)
+        : m_slots(new std::atomic<uint64_t>[capacity]), m_capacity(capacity), m_empty(empty), m_size(0)
+    {
+        for (unsigned int i = 0; i < m_capacity; i++)
+        {
+            Node * node = new Node(empty);
+            if ((ToWord(node) & ~POINTER_MASK) != 0)
+            {
+                throw std::bad_alloc();
+            }
+            m_slots[i].store(ToWord(node), std::memory_order_relaxed);
+        }
+    }
+
+    /// Destructor. No reader may still be using the ring.
+    ~SnapshotRing()
+    {
+        for (unsigned int i = 0; i < m_capacity; i++)
+        {
+            delete ToNode(m_slots[i].load(std::memory_order_acquire));
+        }
+    }
+
+    SnapshotRing(const SnapshotRing<T> &) = delete;
+
+    SnapshotRing & operator=(const SnapshotRing<T> &) = delete;
+
+    /// Returns the element in the slot for index. It is a newer element if index has been overwritten.
+    std::shared_ptr<const T> Get(uint64_t index) const
+    {
+        std::atomic<uint64_t> & slot = GetSlot(index);
+
+        // Counting in before reading the pointer keeps the node alive until Release
+        Node * node = ToNode(slot.fetch_add(ONE_READER, std::memory_order_acquire));
+        std::shared_ptr<const T> element = node->m_element;
+        Release(slot, node);
+
+        return element;
+    }
+
+    /// Returns the element at index size() - 1, or the empty element if nothing is published yet.
+    std::shared_ptr<const T> Back() const
+    {
+        uint64_t size = m_size.load(std::memory_order_acquire);
+        return (size == 0) ? m_empty : Get(size - 1);
+    }
+
+    /// Publishes an element at index. Only one thread may publish at a time.
+    void Publish(uint64_t index, std::shared_ptr<const T> element)
+    {
+        Node * node = new Node(std::move(element));
+        if ((ToWord(node) & ~POINTER_MASK) != 0)
+        {
+            delete node;
+            throw std::bad_alloc();
+        }
+
+        Retire(GetSlot(index).exchange(ToWord(node), std::memory_order_acq_rel));
+        m_size.fetch_add(1, std::memory_order_release);
+    }
+
+    /// Returns the number of elements published so far.
+    uint64_t size() const
+    {
+        return m_size.load(std::memory_order_acquire);
+    }
+
+    /// Returns the number of slots.
+    unsigned int capacity() const
+    {
+        return m_capacity;
+    }
+};
+
+#endif // __SNAPSHOTRING_H__
@@ -30,7 +30,7 @@
 #include "libMediator/Mediator.h"
 #include "libNetwork/P2PComm.h"
 #include "libUtils/DataConversion.h"
-#include "libUtils/DetachedFunction.h"
+#include "libUtils/EventLog.h"
 #include "libUtils/Logger.h"
 #include "libUtils/SanityChecks.h"
 
@@ -57,10 +57,10 @@ void DirectoryService::StoreDSBlockToStorage()
     // Store DS Block to disk
     vector<unsigned char> serializedDSBlock;
     m_pendingDSBlock->Serialize(serializedDSBlock, 0);
-    BlockStorage::GetBlockStorage().PutDSBlock(m_pendingDSBlock->GetHeader().GetBlockNum(), serializedDSBlock);
+    BlockStorage::GetBlockStorage().PutDSBlock(m_pendingDSBlock->GetHeader().GetBlockNum().convert_to<uint64_t>(), serializedDSBlock);
 }
 
-bool DirectoryService::SendDSBlockToLookupNodes(DSBlock & lastDSBlock, Peer & winnerpeer)
+bool DirectoryService::SendDSBlockToLookupNodes(const DSBlock & lastDSBlock, Peer & winnerpeer)
 {
     vector<unsigned char> dsblock_message = { MessageType::NODE, NodeInstructionType::DSBLOCK };
     unsigned int curr_offset = MessageOffset::BODY;
@@ -99,7 +99,7 @@ void DirectoryService::DetermineNodesToSendDSBlockTo(const Peer & winnerpeer, un
     LOG_MARKER();
 
     LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "New DSBlock created with chosen nonce   = 0x" << hex <<
-                          m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetNonce());
+                          m_mediator.m_dsBlockChain.GetLastBlock()->GetHeader().GetNonce());
     LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "New DSBlock hash is                     = 0x" <<
                           DataConversion::charArrToHexStr(m_mediator.m_dsBlockRand));
     LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "New DS leader (PoW1 winner) IP          = " << winnerpeer.GetPrintableIPAddress() << ":" <<
@@ -135,7 +135,7 @@ void DirectoryService::SendDSBlockToCluster(const Peer & winnerpeer, unsigned in
     unsigned int curr_offset = MessageOffset::BODY;
 
     // 259-byte DS block
-    m_mediator.m_dsBlockChain.GetLastBlock().Serialize(dsblock_message, MessageOffset::BODY);
+    m_mediator.m_dsBlockChain.GetLastBlock()->Serialize(dsblock_message, MessageOffset::BODY);
     curr_offset += DSBlock::GetSerializedSize();
 
     // 32-byte DS block hash / rand1
@@ -164,7 +164,7 @@ void DirectoryService::SendDSBlockToCluster(const Peer & winnerpeer, unsigned in
     SHA2<HASH_TYPE::HASH_VARIANT_256> sha256;
     sha256.Update(dsblock_message);
     vector<unsigned char> this_msg_hash = sha256.Finalize();
-    LOG_STATE("[INFOR][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "][" << DataConversion::Uint8VecToHexStr(this_msg_hash).substr(0, 6)  << "][" << DataConversion::charArrToHexStr(m_mediator.m_dsBlockRand).substr(0, 6) << "][" << m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum()  << "] DSBLOCKGEN");
+    LOG_STATE("[INFOR][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "][" << DataConversion::Uint8VecToHexStr(this_msg_hash).substr(0, 6)  << "][" << DataConversion::charArrToHexStr(m_mediator.m_dsBlockRand).substr(0, 6) << "][" << m_mediator.m_dsBlockChain.GetLastBlock()->GetHeader().GetBlockNum()  << "] DSBLOCKGEN");
 #endif // STAT_TEST
 
     P2PComm::GetInstance().SendBroadcastMessage(pow1nodes_cluster, dsblock_message);
@@ -213,26 +213,22 @@ void DirectoryService::UpdateDSCommiteeComposition(const Peer & winnerpeer)
     LOG_MARKER();
 
     m_mediator.m_DSCommitteeNetworkInfo.push_front(winnerpeer);
-    m_mediator.m_DSCommitteePubKeys.push_front(m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetMinerPubKey());
+    m_mediator.m_DSCommitteePubKeys.push_front(m_mediator.m_dsBlockChain.GetLastBlock()->GetHeader().GetMinerPubKey());
     m_mediator.m_DSCommitteeNetworkInfo.pop_back();
     m_mediator.m_DSCommitteePubKeys.pop_back();
 
     // Remove the new winner of pow1 from m_allpowconn. He is the new ds leader and do not need to do pow anymore
-    m_allPoWConns.erase(m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetMinerPubKey());
+    m_allPoWConns.erase(m_mediator.m_dsBlockChain.GetLastBlock()->GetHeader().GetMinerPubKey());
 }
 
 void DirectoryService::ScheduleShardingConsensus(const unsigned int wait_window)
 {
     LOG_MARKER();
 
-    auto func = [this, wait_window]() -> void
-    {
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Waiting " << wait_window << 
-                     " seconds, accepting PoW2 submissions...");
-        this_thread::sleep_for(chrono::seconds(wait_window));
-        RunConsensusOnSharding();
-    };
-    DetachedFunction(1, func);
+    LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Waiting " << wait_window << 
+                 " seconds, accepting PoW2 submissions...");
+
+    SchedulePhase(wait_window, [this]() -> void { RunConsensusOnSharding(); });
 }
 
 void DirectoryService::ProcessDSBlockConsensusWhenDone(const vector<unsigned char> & message, 
@@ -243,8 +239,9 @@ void DirectoryService::ProcessDSBlockConsensusWhenDone(const vector<unsigned cha
 #ifdef STAT_TEST
     if (m_mode == PRIMARY_DS)
     {
-        LOG_STATE("[DSCON][" << setw(15) << left << m_mediator.m_selfPeer.GetPrintableIPAddress() << 
+        LOG_STATE_TEXT("[DSCON][" << setw(15) << left << m_mediator.m_selfPeer.GetPrintableIPAddress() << 
                   "][" << m_mediator.m_txBlockChain.GetBlockCount() << "] DONE");
+        LOG_EVENT(EVENT_DSCON, PHASE_DONE, m_mediator.m_txBlockChain.GetBlockCount(), 0, 0);
     }
 #endif // STAT_TEST
 
@@ -269,14 +266,14 @@ void DirectoryService::ProcessDSBlockConsensusWhenDone(const vector<unsigned cha
 
     // Add the DS block to the chain
     StoreDSBlockToStorage();
-    DSBlock lastDSBlock = m_mediator.m_dsBlockChain.GetLastBlock();
+    shared_ptr<const DSBlock> lastDSBlock = m_mediator.m_dsBlockChain.GetLastBlock();
 
     m_mediator.UpdateDSBlockRand();
 
     Peer winnerpeer;
     {
         lock_guard<mutex> g(m_mutexAllPoWConns);
-        winnerpeer = m_allPoWConns.at(lastDSBlock.GetHeader().GetMinerPubKey());
+        winnerpeer = m_allPoWConns.at(lastDSBlock->GetHeader().GetMinerPubKey());
     }
 
     LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
@@ -285,7 +282,7 @@ void DirectoryService::ProcessDSBlockConsensusWhenDone(const vector<unsigned cha
     {
         LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
                      "I the primary DS will soon be sending the DSBlock to the lookup nodes");
-        SendDSBlockToLookupNodes(lastDSBlock, winnerpeer);
+        SendDSBlockToLookupNodes(*lastDSBlock, winnerpeer);
     }
 
     unsigned int my_DS_cluster_num, my_pow1nodes_cluster_lo, my_pow1nodes_cluster_hi;
@@ -316,7 +313,7 @@ void DirectoryService::ProcessDSBlockConsensusWhenDone(const vector<unsigned cha
         // Tell my Node class to start PoW2
         m_mediator.UpdateDSBlockRand();
         array<unsigned char, 32> rand2 = {0};
-        m_mediator.m_node->StartPoW2(lastDSBlock.GetHeader().GetBlockNum(),
+        m_mediator.m_node->StartPoW2(lastDSBlock->GetHeader().GetBlockNum(),
                                      3, m_mediator.m_dsBlockRand, rand2);
     }
 }
@@ -329,34 +326,21 @@ bool DirectoryService::ProcessDSBlockConsensus(const vector<unsigned char> & mes
     LOG_MARKER();
     // Consensus messages must be processed in correct sequence as they come in
     // It is possible for ANNOUNCE to arrive before correct DS state
-    // In that case, ANNOUNCE will sleep for a second below
-    // If COLLECTIVESIG also comes in, it's then possible COLLECTIVESIG will be processed before ANNOUNCE!
-    // So, ANNOUNCE should acquire a lock here
+    // In that case, ANNOUNCE is parked below and replayed once the state is entered
+    // Messages arriving in the state itself also go through the queue while it is not empty, so a
+    // COLLECTIVESIG cannot overtake a parked ANNOUNCE
 
     lock_guard<mutex> g(m_mutexConsensus);
 
     
-    // Wait for a while for ProcessDSBlock in the case that primary sent announcement pretty early
-    // TODO: Should await sleep. Use conditional var.
-    unsigned int sleep_time_while_waiting = 100; 
-    if ((m_state == POW1_SUBMISSION) || (m_state == DSBLOCK_CONSENSUS_PREP))
+    // Park the message for ProcessDSBlock in the case that primary sent announcement pretty early
+    if ((m_state == POW1_SUBMISSION) || (m_state == DSBLOCK_CONSENSUS_PREP) || (m_state == DSBLOCK_CONSENSUS))
     {
-        //for (unsigned int i = 0; i < POW1_WINDOW_IN_SECONDS; i++)
-        unsigned int i = 0;
-        while(true)
+        auto replay = [this, message, offset, from]() -> void { ProcessDSBlockConsensus(message, offset, from); };
+        if (m_stateNotifier.ParkUntil(DSBLOCK_CONSENSUS, replay, chrono::seconds(PARKED_MESSAGE_TIMEOUT_IN_SECONDS)))
         {
-            if (m_state == DSBLOCK_CONSENSUS)
-            {
-                break;
-            }
-
-            if (i % 100 == 0)
-            {
-                LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Waiting for DSBLOCK_CONSENSUS before processing. Time elapsed: " << (i/10) << "seconds");
-            }
-
-            this_thread::sleep_for(chrono::milliseconds(sleep_time_while_waiting));
-            i++; 
+            LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Parked until DSBLOCK_CONSENSUS");
+            return true;
         }
     }
 
@@ -31,6 +31,7 @@
 #include "libNetwork/P2PComm.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
+#include "libUtils/EventLog.h"
 #include "libUtils/Logger.h"
 #include "libUtils/SanityChecks.h"
 
@@ -46,10 +47,10 @@ void DirectoryService::ComposeDSBlock()
     BlockHash prevHash;
     if (m_mediator.m_dsBlockChain.GetBlockCount() > 0)
     {
-        DSBlock lastBlock = m_mediator.m_dsBlockChain.GetLastBlock();
+        shared_ptr<const DSBlock> lastBlock = m_mediator.m_dsBlockChain.GetLastBlock();
         SHA2<HASH_TYPE::HASH_VARIANT_256> sha2;
         vector<unsigned char> vec;
-        const DSBlockHeader & lastHeader = lastBlock.GetHeader();
+        const DSBlockHeader & lastHeader = lastBlock->GetHeader();
         lastHeader.Serialize(vec, 0);
         sha2.Update(vec);
         const vector<unsigned char> & resVec = sha2.Finalize();
@@ -66,9 +67,9 @@ void DirectoryService::ComposeDSBlock()
     uint8_t difficulty = POW2_DIFFICULTY;
     if (m_mediator.m_dsBlockChain.GetBlockCount() > 0)
     {
-        DSBlock lastBlock = m_mediator.m_dsBlockChain.GetLastBlock();
-        blockNum = lastBlock.GetHeader().GetBlockNum() + 1;
-        difficulty = lastBlock.GetHeader().GetDifficulty();
+        shared_ptr<const DSBlock> lastBlock = m_mediator.m_dsBlockChain.GetLastBlock();
+        blockNum = lastBlock->GetHeader().GetBlockNum() + 1;
+        difficulty = lastBlock->GetHeader().GetDifficulty();
     }
 
     DSBlockHeader newHeader(difficulty, prevHash, winnerNonce, winnerKey, m_mediator.m_selfKey.second, 
@@ -128,7 +129,8 @@ bool DirectoryService::RunConsensusOnDSBlockWhenDSPrimary()
     }
 
 #ifdef STAT_TEST
-    LOG_STATE("[DSCON][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "]["<< m_mediator.m_txBlockChain.GetBlockCount() << "] BGIN");
+    LOG_STATE_TEXT("[DSCON][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "]["<< m_mediator.m_txBlockChain.GetBlockCount() << "] BGIN");
+    LOG_EVENT(EVENT_DSCON, PHASE_BEGN, m_mediator.m_txBlockChain.GetBlockCount(), 0, 0);
 #endif // STAT_TEST
 
     cl->StartConsensus(m);
@@ -206,7 +208,8 @@ void DirectoryService::RunConsensusOnDSBlock()
     {
         lock_guard<mutex> g(m_mutexAllPOW1);
         LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Num of PoW1 sub rec: " << m_allPoW1s.size());
-        LOG_STATE("[POW1R][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "]["<< m_allPoW1s.size() << "] ");
+        LOG_STATE_TEXT("[POW1R][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "]["<< m_allPoW1s.size() << "] ");
+        LOG_EVENT(EVENT_POW1R, PHASE_NONE, m_mediator.m_currentEpochNum, m_allPoW1s.size(), 0);
 
         if (m_allPoW1s.size() == 0)
         {
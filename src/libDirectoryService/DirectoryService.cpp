@@ -31,6 +31,7 @@
 #include "libNetwork/P2PComm.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
+#include "libUtils/Executor.h"
 #include "libUtils/Logger.h"
 #include "libUtils/SanityChecks.h"
 #include "libUtils/TxnRootComputation.h"
@@ -38,7 +39,7 @@
 using namespace std;
 using namespace boost::multiprecision;
 
-DirectoryService::DirectoryService(Mediator & mediator) : m_mediator(mediator)
+DirectoryService::DirectoryService(Mediator & mediator) : m_mediator(mediator), m_stateNotifier(m_state)
 {
 #ifndef IS_LOOKUP_NODE
     SetState(POW1_SUBMISSION);
@@ -51,10 +52,19 @@ DirectoryService::DirectoryService(Mediator & mediator) : m_mediator(mediator)
 
 DirectoryService::~DirectoryService()
 {
-
+    m_phaseTimer.Cancel();
 }
 
 #ifndef IS_LOOKUP_NODE
+void DirectoryService::SchedulePhase(const unsigned int wait_window, function<void()> phase)
+{
+    lock_guard<mutex> g(m_mutexPhaseTimer);
+
+    // Only one phase is ever pending; a newer schedule supersedes an older one
+    m_phaseTimer.Cancel();
+    m_phaseTimer = Executor::GetInstance().PostBlockingAfter(chrono::seconds(wait_window), phase);
+}
+
 bool DirectoryService::CheckState(Action action)
 {
     if(m_mode == Mode::IDLE)
@@ -494,9 +504,11 @@ bool DirectoryService::ProcessSetPrimary(const vector<unsigned char> & message,
 #endif // STAT_TEST
 
     LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Waiting " << POW1_WINDOW_IN_SECONDS << " seconds, accepting PoW1 submissions...");
-    this_thread::sleep_for(chrono::seconds(POW1_WINDOW_IN_SECONDS));
-    LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Starting consensus on ds block");
-    RunConsensusOnDSBlock();
+    SchedulePhase(POW1_WINDOW_IN_SECONDS, [this]() -> void
+    {
+        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Starting consensus on ds block");
+        RunConsensusOnDSBlock();
+    });
 #endif // IS_LOOKUP_NODE
 
     return true;
@@ -505,7 +517,7 @@ bool DirectoryService::ProcessSetPrimary(const vector<unsigned char> & message,
 #ifndef IS_LOOKUP_NODE
 bool DirectoryService::CheckWhetherDSBlockIsFresh(const uint256_t dsblock_num)
 {
-    // uint256_t latest_block_num_in_blockchain = m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+    // uint256_t latest_block_num_in_blockchain = m_mediator.m_dsBlockChain.GetLastBlock()->GetHeader().GetBlockNum();
     uint256_t latest_block_num_in_blockchain = m_mediator.m_dsBlockChain.GetBlockCount();
 
     if (dsblock_num < latest_block_num_in_blockchain)
@@ -528,6 +540,7 @@ void DirectoryService::SetState(DirState state)
 {
     m_state = state;
     LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "DS State is now " << m_state);
+    m_stateNotifier.Notify();
 }
 
 vector<Peer> DirectoryService::GetBroadcastList(unsigned char ins_type, const Peer & broadcast_originator)
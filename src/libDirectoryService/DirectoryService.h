@@ -25,6 +25,7 @@
 #include <array>
 #include <deque>
 #include <shared_mutex>
+#include <unordered_map>
 #include <boost/multiprecision/cpp_int.hpp>
 #include <libCrypto/Sha2.h>
 
@@ -34,7 +35,9 @@
 #include "libData/BlockData/Block.h"
 #include "libNetwork/PeerStore.h"
 #include "libNetwork/P2PComm.h"
+#include "libUtils/StateNotifier.h"
 #include "libUtils/TimeUtils.h"
+#include "libUtils/TimerWheel.h"
 #include "libPOW/pow.h"
 #include "libPersistence/BlockStorage.h"
 
@@ -87,13 +90,13 @@ class DirectoryService : public Executable, public Broadcastable
     std::shared_timed_mutex m_mutexProducerConsumer;
     std::mutex m_mutexConsensus;
 
-    // Sharding committee members
+    // Sharding committee members (ordered: shards are serialized in key order)
     std::vector<std::map<PubKey, Peer>> m_shards;
-    std::map<PubKey, uint32_t> m_publicKeyToShardIdMap;
+    std::unordered_map<PubKey, uint32_t> m_publicKeyToShardIdMap;
 
     // PoW common variables
     std::mutex m_mutexAllPoWs;
-    std::map<PubKey, Peer> m_allPoWConns;
+    std::map<PubKey, Peer> m_allPoWConns; // Ordered: DS clusters split it by position
     std::mutex m_mutexAllPoWConns; 
 
     // Consensus variables
@@ -110,7 +113,7 @@ class DirectoryService : public Executable, public Broadcastable
     std::mutex m_mutexAllPOW1;
 
     // PoW2 (sharding) consensus variables
-    std::map<PubKey, boost::multiprecision::uint256_t> m_allPoW2s;
+    std::unordered_map<PubKey, boost::multiprecision::uint256_t> m_allPoW2s;
     std::mutex m_mutexAllPOW2;
     std::map<std::array<unsigned char, BLOCK_HASH_SIZE>, PubKey> m_sortedPoW2s;
 
@@ -120,11 +123,18 @@ class DirectoryService : public Executable, public Broadcastable
     std::shared_ptr<TxBlock> m_finalBlock;
     std::vector<unsigned char> m_finalBlockMessage;
     std::vector<Peer> m_sharingAssignment;
+
+    // Timer for the next scheduled phase (PoW windows, leader preparation)
+    TimerHandle m_phaseTimer;
+    std::mutex m_mutexPhaseTimer;
     
     Mediator & m_mediator;
 
     const uint32_t RESHUFFLE_INTERVAL = 500;
 
+    // Threads sending final block fragments to a shard
+    const unsigned int FINALBLOCK_FRAGMENT_SENDERS = 16;
+
     // Message handlers
     bool ProcessSetPrimary(const std::vector<unsigned char> & message, unsigned int offset, 
                            const Peer & from);
@@ -141,6 +151,7 @@ class DirectoryService : public Executable, public Broadcastable
     bool ProcessFinalBlockConsensus(const std::vector<unsigned char> & message, unsigned int offset, 
                                     const Peer & from);
 #ifndef IS_LOOKUP_NODE
+    void SchedulePhase(const unsigned int wait_window, std::function<void()> phase);
     bool CheckState(Action action);
     bool VerifyPOW2(const vector<unsigned char> &message, unsigned int offset, const Peer &from);
 
@@ -174,7 +185,7 @@ class DirectoryService : public Executable, public Broadcastable
 
     // internal calls from ProcessDSBlockConsensus
     void StoreDSBlockToStorage(); // To further refactor
-    bool SendDSBlockToLookupNodes(DSBlock & lastDSBlock, Peer & winnerpeer);
+    bool SendDSBlockToLookupNodes(const DSBlock & lastDSBlock, Peer & winnerpeer);
     void DetermineNodesToSendDSBlockTo(const Peer &winnerpeer, unsigned int &my_DS_cluster_num,
                                        unsigned int &my_pow1nodes_cluster_lo,
                                        unsigned int &my_pow1nodes_cluster_hi) const;
@@ -195,6 +206,9 @@ class DirectoryService : public Executable, public Broadcastable
                                            unsigned int &my_shards_hi) const;
     void SendFinalBlockToShardNodes(unsigned int my_DS_cluster_num, unsigned int my_shards_lo, 
                                     unsigned int my_shards_hi);
+    void SendFinalBlockFragmentsToShard(const std::vector<unsigned char> & finalblock_message,
+                                        const std::vector<Peer> & shard_peers,
+                                        unsigned int my_pos_in_cluster, unsigned int cluster_size);
 
     // Final Block functions
     void RunConsensusOnFinalBlock();
@@ -272,6 +286,13 @@ public:
     /// The current internal state of this DirectoryService instance.
     std::atomic<DirState> m_state;
 
+private:
+    // Replays messages that arrived before the state they need
+    StateNotifier<DirState> m_stateNotifier;
+    const unsigned int PARKED_MESSAGE_TIMEOUT_IN_SECONDS = 600;
+
+public:
+
     /// The ID number of this Zilliqa instance for use with consensus operations.
     uint16_t m_consensusMyID;
 
@@ -288,7 +309,7 @@ public:
     /// Implements the GetBroadcastList function inherited from Broadcastable.
     std::vector<Peer> GetBroadcastList(unsigned char ins_type, const Peer & broadcast_originator);
 
-    /// Launches separate thread to execute sharding consensus after wait_window seconds.
+    /// Schedules sharding consensus to run after wait_window seconds.
     void ScheduleShardingConsensus(const unsigned int wait_window);
 #endif // IS_LOOKUP_NODE
     
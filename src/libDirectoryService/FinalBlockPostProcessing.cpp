@@ -26,13 +26,17 @@
 #include "depends/libTrie/TrieDB.h"
 #include "depends/libTrie/TrieHash.h"
 #include "depends/libDatabase/MemoryDB.h"
+#include "libCrypto/Schnorr.h"
 #include "libCrypto/Sha2.h"
 #include "libMediator/Mediator.h"
 #include "libNetwork/P2PComm.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
+#include "libUtils/EventLog.h"
 #include "libUtils/Logger.h"
+#include "libUtils/ReedSolomon.h"
 #include "libUtils/SanityChecks.h"
+#include "libUtils/ThreadPool.h"
 
 using namespace std;
 using namespace boost::multiprecision;
@@ -51,7 +55,7 @@ void DirectoryService::StoreFinalBlockToDisk()
 
     vector<unsigned char> serializedTxBlock;
     m_finalBlock->Serialize(serializedTxBlock, 0);
-    BlockStorage::GetBlockStorage().PutTxBlock(m_finalBlock->GetHeader().GetBlockNum(), 
+    BlockStorage::GetBlockStorage().PutTxBlock(m_finalBlock->GetHeader().GetBlockNum().convert_to<uint64_t>(), 
                                                serializedTxBlock);
 }
 
@@ -100,7 +104,8 @@ void DirectoryService::DetermineShardsToSendFinalBlockTo(unsigned int & my_DS_cl
 
     // Multicast assignments:
     // 1. Divide DS committee into clusters of size 20
-    // 2. Each cluster talks to all shard members in each shard
+    // 2. Each cluster talks to all shard members in each shard, each DS node sending
+    //    erasure-coded fragments to its own slice of the members
     //    DS cluster 0 => Shard 0
     //    DS cluster 1 => Shard 1
     //    ...
@@ -158,6 +163,11 @@ void DirectoryService::SendFinalBlockToShardNodes(unsigned int my_DS_cluster_num
         Serializable::SetNumber<uint32_t>(finalblock_message, curr_offset, m_consensusID, sizeof(uint32_t));
         curr_offset += sizeof(uint32_t);
 
+        // Position of this DS node within its multicast cluster
+        unsigned int my_cluster_lo = my_DS_cluster_num * DS_MULTICAST_CLUSTER_SIZE;
+        unsigned int cluster_size = min<unsigned int>(DS_MULTICAST_CLUSTER_SIZE, 
+                                                      m_mediator.m_DSCommitteeNetworkInfo.size() - my_cluster_lo);
+
         auto p = m_shards.begin();
         advance(p, my_shards_lo);
 
@@ -182,7 +192,8 @@ void DirectoryService::SendFinalBlockToShardNodes(unsigned int my_DS_cluster_num
                     m_mediator.m_dsBlockRand).substr(0, 6) << "][" << m_mediator.m_txBlockChain.GetBlockCount() << "] FBBLKGEN");
 #endif // STAT_TEST
 
-            P2PComm::GetInstance().SendBroadcastMessage(shard_peers, finalblock_message);
+            SendFinalBlockFragmentsToShard(finalblock_message, shard_peers, 
+                                           m_consensusMyID - my_cluster_lo, cluster_size);
 
             p++;
         }
@@ -191,6 +202,105 @@ void DirectoryService::SendFinalBlockToShardNodes(unsigned int my_DS_cluster_num
     m_finalBlockMessage.clear();
 }
 
+void DirectoryService::SendFinalBlockFragmentsToShard(const vector<unsigned char> & finalblock_message,
+                                                      const vector<Peer> & shard_peers,
+                                                      unsigned int my_pos_in_cluster, 
+                                                      unsigned int cluster_size)
+{
+    // Every DS node in the cluster encodes the same FINALBLOCK message into n fragments, any k of
+    // which rebuild it. Shard member j receives fragment (j mod n) from DS node (j mod cluster size)
+    // only, and members 0..n-1 relay their fragment to the rest of the shard.
+    // Message = [32-byte FINALBLOCK message hash] [4-byte FINALBLOCK message length] [1-byte k]
+    //           [1-byte n] [1-byte fragment index] [33-byte DS pubkey] [fragment] [64-byte signature]
+    // The signature by that DS node covers everything before it, so relayed fragments keep it.
+    LOG_MARKER();
+
+    const unsigned int n = min<unsigned int>(shard_peers.size(), ReedSolomon::MAX_FRAGMENTS);
+    const unsigned int k = max<unsigned int>(1, n / FINALBLOCK_FRAGMENT_REDUNDANCY);
+
+    vector<vector<unsigned char>> fragments;
+    if (!ReedSolomon::Encode(finalblock_message, k, n, fragments))
+    {
+        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                     "Error: Failed to encode final block for " << shard_peers.size() << " shard nodes");
+        return;
+    }
+
+    SHA2<HASH_TYPE::HASH_VARIANT_256> sha256;
+    sha256.Update(finalblock_message);
+    const vector<unsigned char> message_hash = sha256.Finalize();
+
+    ThreadPool pool(FINALBLOCK_FRAGMENT_SENDERS);
+
+    // Members j and j + n get the same fragment, so each one is signed once
+    map<unsigned int, SharedBuffer> signed_fragments;
+
+    for (unsigned int j = my_pos_in_cluster; j < shard_peers.size(); j += cluster_size)
+    {
+        const unsigned int index = j % n;
+
+        auto signed_fragment = signed_fragments.find(index);
+        if (signed_fragment != signed_fragments.end())
+        {
+            const Peer peer = shard_peers.at(j);
+            const SharedBuffer buffer = signed_fragment->second;
+            pool.AddJob([peer, buffer]() -> void
+            {
+                P2PComm::GetInstance().SendMessage(peer, buffer);
+            });
+            continue;
+        }
+
+        const vector<unsigned char> & fragment = fragments.at(index);
+
+        vector<unsigned char> fragment_message = { MessageType::NODE, NodeInstructionType::FINALBLOCKFRAGMENT };
+        fragment_message.resize(MessageOffset::BODY + FINALBLOCK_FRAGMENT_HEADER_SIZE + fragment.size());
+
+        unsigned int curr_offset = MessageOffset::BODY;
+
+        copy(message_hash.begin(), message_hash.end(), fragment_message.begin() + curr_offset);
+        curr_offset += message_hash.size();
+
+        Serializable::SetNumber<uint32_t>(fragment_message, curr_offset, finalblock_message.size(), sizeof(uint32_t));
+        curr_offset += sizeof(uint32_t);
+
+        Serializable::SetNumber<uint8_t>(fragment_message, curr_offset, (uint8_t)k, sizeof(uint8_t));
+        curr_offset += sizeof(uint8_t);
+
+        Serializable::SetNumber<uint8_t>(fragment_message, curr_offset, (uint8_t)n, sizeof(uint8_t));
+        curr_offset += sizeof(uint8_t);
+
+        Serializable::SetNumber<uint8_t>(fragment_message, curr_offset, (uint8_t)index, sizeof(uint8_t));
+        curr_offset += sizeof(uint8_t);
+
+        m_mediator.m_selfKey.second.Serialize(fragment_message, curr_offset);
+        curr_offset += PUB_KEY_SIZE;
+
+        copy(fragment.begin(), fragment.end(), fragment_message.begin() + curr_offset);
+        curr_offset += fragment.size();
+
+        Signature signature;
+        if (!Schnorr::GetInstance().Sign(fragment_message, MessageOffset::BODY, curr_offset - MessageOffset::BODY, 
+                                         m_mediator.m_selfKey.first, m_mediator.m_selfKey.second, signature))
+        {
+            LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                         "Error: Failed to sign final block fragment " << index);
+            continue;
+        }
+        signature.Serialize(fragment_message, curr_offset);
+
+        const Peer peer = shard_peers.at(j);
+        const SharedBuffer buffer(move(fragment_message));
+        signed_fragments.emplace(index, buffer);
+        pool.AddJob([peer, buffer]() -> void
+        {
+            P2PComm::GetInstance().SendMessage(peer, buffer);
+        });
+    }
+
+    pool.WaitAll();
+}
+
 void DirectoryService::ProcessFinalBlockConsensusWhenDone()
 {
     LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
@@ -199,14 +309,16 @@ void DirectoryService::ProcessFinalBlockConsensusWhenDone()
 #ifdef STAT_TEST
     if (m_mode == PRIMARY_DS)
     {
-        LOG_STATE("[FBCON][" << setw(15) << left << m_mediator.m_selfPeer.GetPrintableIPAddress() << 
+        LOG_STATE_TEXT("[FBCON][" << setw(15) << left << m_mediator.m_selfPeer.GetPrintableIPAddress() << 
                   "][" << m_mediator.m_txBlockChain.GetBlockCount() << "] DONE");
+        LOG_EVENT(EVENT_FBCON, PHASE_DONE, m_mediator.m_txBlockChain.GetBlockCount(), 0, 0);
     }
 #endif // STAT_TEST
 
     // Add finalblock to txblockchain
     m_mediator.m_txBlockChain.AddBlock(*m_finalBlock);
-    m_mediator.m_currentEpochNum = (uint64_t) m_mediator.m_txBlockChain.GetBlockCount();
+    m_mediator.m_currentEpochNum = m_mediator.m_txBlockChain.GetBlockCount();
+    TRACE_EPOCH(m_mediator.m_currentEpochNum);
 
     StoreFinalBlockToDisk();
 
@@ -247,20 +359,11 @@ void DirectoryService::ProcessFinalBlockConsensusWhenDone()
         {
             LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "[PoW needed]");
 
-            POW::GetInstance().EthashConfigureLightClient((uint64_t)m_mediator.m_dsBlockChain.GetBlockCount()); // hack hack hack -- typecasting
+            POW::GetInstance().EthashConfigureLightClient(m_mediator.m_dsBlockChain.GetBlockCount());
             m_consensusID = 0;
-            if (m_mode == PRIMARY_DS)
-            {
-                LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Waiting " << POW1_WINDOW_IN_SECONDS << " seconds, accepting PoW1 submissions...");
-                this_thread::sleep_for(chrono::seconds(POW1_WINDOW_IN_SECONDS));
-            }
-            else
-            {
-                LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Waiting " << POW1_BACKUP_WINDOW_IN_SECONDS << " seconds, accepting PoW1 submissions...");
-                this_thread::sleep_for(chrono::seconds(POW1_BACKUP_WINDOW_IN_SECONDS));
-            }
-
-            RunConsensusOnDSBlock();
+            unsigned int wait_window = (m_mode == PRIMARY_DS) ? POW1_WINDOW_IN_SECONDS : POW1_BACKUP_WINDOW_IN_SECONDS;
+            LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Waiting " << wait_window << " seconds, accepting PoW1 submissions...");
+            SchedulePhase(wait_window, [this]() -> void { RunConsensusOnDSBlock(); });
         }
         else 
         {
@@ -282,30 +385,23 @@ bool DirectoryService::ProcessFinalBlockConsensus(const vector<unsigned char> &
 
     // Consensus messages must be processed in correct sequence as they come in
     // It is possible for ANNOUNCE to arrive before correct DS state
-    // In that case, ANNOUNCE will sleep for a second below
-    // If COLLECTIVESIG also comes in, it's then possible COLLECTIVESIG will be processed before ANNOUNCE!
-    // So, ANNOUNCE should acquire a lock here
+    // In that case, ANNOUNCE is parked below and replayed once the state is entered
+    // Messages arriving in the state itself also go through the queue while it is not empty, so a
+    // COLLECTIVESIG cannot overtake a parked ANNOUNCE
 
     lock_guard<mutex> g(m_mutexConsensus);
 
     
-    // Wait for a while in the case that primary sent announcement pretty early
-    unsigned int sleep_time_while_waiting = 100; 
-    if ((m_state == MICROBLOCK_SUBMISSION) || (m_state == FINALBLOCK_CONSENSUS_PREP))
+    // Park the message in the case that primary sent announcement pretty early
+    if ((m_state == MICROBLOCK_SUBMISSION) || (m_state == FINALBLOCK_CONSENSUS_PREP) || 
+        (m_state == FINALBLOCK_CONSENSUS))
     {
-        for (unsigned int i = 0; i < 100; i++)
+        auto replay = [this, message, offset, from]() -> void { ProcessFinalBlockConsensus(message, offset, from); };
+        if (m_stateNotifier.ParkUntil(FINALBLOCK_CONSENSUS, replay, chrono::seconds(10)))
         {
-            if (m_state == FINALBLOCK_CONSENSUS)
-            {
-                break;
-            }
-
-            if (i % 10 == 0)
-            {
-                LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
-                             "Waiting for FINALBLOCK_CONSENSUS before processing");
-            }
-            this_thread::sleep_for(chrono::milliseconds(sleep_time_while_waiting));
+            LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                         "Parked until FINALBLOCK_CONSENSUS");
+            return true;
         }
     }
 
@@ -31,6 +31,7 @@
 #include "libNetwork/P2PComm.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
+#include "libUtils/EventLog.h"
 #include "libUtils/Logger.h"
 #include "libUtils/SanityChecks.h"
 #include "libUtils/TxnRootComputation.h"
@@ -56,8 +57,9 @@ void DirectoryService::ExtractDataFromMicroblocks
                                                             microBlock.GetHeader().GetNumTxs() << " transactions.");
 
 #ifdef STAT_TEST
-        LOG_STATE("[STATS][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() <<
+        LOG_STATE_TEXT("[STATS][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() <<
                              "][" << i  << "    ][" << microBlock.GetHeader().GetNumTxs() << "] PROPOSED");
+        LOG_EVENT(EVENT_STATS, PHASE_PROPOSED, m_mediator.m_txBlockChain.GetBlockCount(), microBlock.GetHeader().GetNumTxs(), i);
 #endif // STAT_TEST
         i++;
 
@@ -77,7 +79,7 @@ void DirectoryService::ExtractDataFromMicroblocks
 
 void DirectoryService::ComposeFinalBlockCore()
 {
-    LOG_MARKER();
+    TRACE_MARKER();
 
     TxnHash microblockTrieRoot;
     std::vector<BlockHash> microBlockTxHashes;
@@ -99,26 +101,26 @@ void DirectoryService::ComposeFinalBlockCore()
     uint256_t blockNum = 0;
     if (m_mediator.m_txBlockChain.GetBlockCount() > 0)
     {
-        TxBlock lastBlock = m_mediator.m_txBlockChain.GetLastBlock();
+        shared_ptr<const TxBlock> lastBlock = m_mediator.m_txBlockChain.GetLastBlock();
         SHA2<HASH_TYPE::HASH_VARIANT_256> sha2;
         vector<unsigned char> vec;
-        lastBlock.GetHeader().Serialize(vec, 0);
+        lastBlock->GetHeader().Serialize(vec, 0);
         sha2.Update(vec);
         vector<unsigned char> hashVec = sha2.Finalize();
         copy(hashVec.begin(), hashVec.end(), prevHash.asArray().begin());
         LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(),
                      "Prev block hash as per leader " << prevHash.hex() << endl <<
-                     "TxBlockHeader: " << lastBlock.GetHeader());
-        blockNum = lastBlock.GetHeader().GetBlockNum() + 1;
+                     "TxBlockHeader: " << lastBlock->GetHeader());
+        blockNum = lastBlock->GetHeader().GetBlockNum() + 1;
     }
 
     assert(m_mediator.m_dsBlockChain.GetBlockCount() > 0);
   
-    DSBlock lastDSBlock = m_mediator.m_dsBlockChain.GetLastBlock();
-    uint256_t lastDSBlockNum = lastDSBlock.GetHeader().GetBlockNum();
+    shared_ptr<const DSBlock> lastDSBlock = m_mediator.m_dsBlockChain.GetLastBlock();
+    uint256_t lastDSBlockNum = lastDSBlock->GetHeader().GetBlockNum();
     SHA2<HASH_TYPE::HASH_VARIANT_256> sha2;
     vector<unsigned char> vec;
-    lastDSBlock.GetHeader().Serialize(vec, 0);
+    lastDSBlock->GetHeader().Serialize(vec, 0);
     sha2.Update(vec);
     vector<unsigned char> hashVec = sha2.Finalize();
     BlockHash dsBlockHeader;
@@ -137,9 +139,10 @@ void DirectoryService::ComposeFinalBlockCore()
     );
 
 #ifdef STAT_TEST
-    LOG_STATE("[STATS][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() <<
+    LOG_STATE_TEXT("[STATS][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() <<
                          "][" << m_mediator.m_txBlockChain.GetBlockCount() << "][" <<
                          m_finalBlock->GetHeader().GetNumTxs()  << "] FINAL");
+    LOG_EVENT(EVENT_STATS, PHASE_FINAL, m_mediator.m_txBlockChain.GetBlockCount(), m_finalBlock->GetHeader().GetNumTxs(), 0);
 #endif // STAT_TEST
 
     LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Final block proposed with " <<
@@ -363,7 +366,8 @@ bool DirectoryService::RunConsensusOnFinalBlockWhenDSPrimary()
 #ifdef STAT_TEST
     if (m_mode == PRIMARY_DS)
     {
-        LOG_STATE("[FBCON][" << setw(15) << left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "][" << m_mediator.m_txBlockChain.GetBlockCount() << "] BGIN");
+        LOG_STATE_TEXT("[FBCON][" << setw(15) << left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "][" << m_mediator.m_txBlockChain.GetBlockCount() << "] BGIN");
+        LOG_EVENT(EVENT_FBCON, PHASE_BEGN, m_mediator.m_txBlockChain.GetBlockCount(), 0, 0);
     }
 #endif // STAT_TEST
 
@@ -405,7 +409,7 @@ bool DirectoryService::CheckFinalBlockNumber()
     uint256_t expectedBlocknum = 0;
     if (m_mediator.m_txBlockChain.GetBlockCount() > 0)
     {
-        expectedBlocknum = m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() + 1;
+        expectedBlocknum = m_mediator.m_txBlockChain.GetLastBlock()->GetHeader().GetBlockNum() + 1;
     }
     if (finalblockBlocknum != expectedBlocknum)
     {
@@ -431,7 +435,7 @@ bool DirectoryService::CheckPreviousFinalBlockHash()
     {
         SHA2<HASH_TYPE::HASH_VARIANT_256> sha2;
         vector<unsigned char> vec;
-        m_mediator.m_txBlockChain.GetLastBlock().GetHeader().Serialize(vec, 0);
+        m_mediator.m_txBlockChain.GetLastBlock()->GetHeader().Serialize(vec, 0);
         sha2.Update(vec);
         vector<unsigned char> hashVec = sha2.Finalize();
         copy(hashVec.begin(), hashVec.end(), expectedPrevHash.asArray().begin());
@@ -441,7 +445,7 @@ bool DirectoryService::CheckPreviousFinalBlockHash()
     LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(),
                  "Prev block hash recvd: " << finalblockPrevHash.hex() << endl <<
                  "Prev block hash expected: " << expectedPrevHash.hex() << endl <<
-                 "TxBlockHeader: " << m_mediator.m_txBlockChain.GetLastBlock().GetHeader());
+                 "TxBlockHeader: " << m_mediator.m_txBlockChain.GetLastBlock()->GetHeader());
 
     if (finalblockPrevHash != expectedPrevHash)
     {
@@ -457,9 +461,9 @@ bool DirectoryService::CheckFinalBlockTimestamp()
 {
     if (m_mediator.m_txBlockChain.GetBlockCount() > 0)
     {
-        const TxBlock & lastTxBlock = m_mediator.m_txBlockChain.GetLastBlock();
+        shared_ptr<const TxBlock> lastTxBlock = m_mediator.m_txBlockChain.GetLastBlock();
         uint256_t finalblockTimestamp = m_finalBlock->GetHeader().GetTimestamp();
-        uint256_t lastTxBlockTimestamp = lastTxBlock.GetHeader().GetTimestamp();
+        uint256_t lastTxBlockTimestamp = lastTxBlock->GetHeader().GetTimestamp();
         if (finalblockTimestamp <= lastTxBlockTimestamp)
         {
             LOG_MESSAGE("Error: Timestamp check failed. Last Tx Block: " << lastTxBlockTimestamp << 
@@ -31,6 +31,7 @@
 #include "libNetwork/P2PComm.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
+#include "libUtils/EventLog.h"
 #include "libUtils/Logger.h"
 #include "libUtils/SanityChecks.h"
 
@@ -118,7 +119,8 @@ bool DirectoryService::ProcessMicroblockSubmission(const vector<unsigned char> &
 #ifdef STAT_TEST
         if (m_mode == PRIMARY_DS)
         {
-            LOG_STATE("[MICRO][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "][" << m_mediator.m_txBlockChain.GetBlockCount() << "] LAST");
+            LOG_STATE_TEXT("[MICRO][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "][" << m_mediator.m_txBlockChain.GetBlockCount() << "] LAST");
+            LOG_EVENT(EVENT_MICRO, PHASE_LAST, m_mediator.m_txBlockChain.GetBlockCount(), 0, 0);
         }
 #endif // STAT_TEST
         for (auto & microBlock : m_microBlocks)
@@ -131,7 +133,8 @@ bool DirectoryService::ProcessMicroblockSubmission(const vector<unsigned char> &
 #ifdef STAT_TEST
     else if ((m_microBlocks.size() == 1) && (m_mode == PRIMARY_DS))
     {
-        LOG_STATE("[MICRO][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "][" << m_mediator.m_txBlockChain.GetBlockCount() << "] FRST");
+        LOG_STATE_TEXT("[MICRO][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "][" << m_mediator.m_txBlockChain.GetBlockCount() << "] FRST");
+        LOG_EVENT(EVENT_MICRO, PHASE_FRST, m_mediator.m_txBlockChain.GetBlockCount(), 0, 0);
     }
 #endif // STAT_TEST
 
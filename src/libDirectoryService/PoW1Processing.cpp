@@ -197,21 +197,14 @@ bool DirectoryService::ProcessPoW1Submission(const vector<unsigned char> & messa
     // Message = [32-byte block number] [4-byte listening port] [33-byte public key] [8-byte nonce] [32-byte resulting hash] [32-byte mixhash]
     LOG_MARKER();
     shared_lock<shared_timed_mutex> lock(m_mutexProducerConsumer);
-    unsigned int sleep_time_while_waiting = 100; 
-    if (m_state == FINALBLOCK_CONSENSUS)
+    if ((m_state == FINALBLOCK_CONSENSUS) || (m_state == POW1_SUBMISSION))
     {
-        for (unsigned int i = 0; i < POW_SUB_BUFFER_TIME; i++)
+        // Accept submissions that arrive up to POW_SUB_BUFFER_TIME tenths of a second early
+        auto replay = [this, message, offset, from]() -> void { ProcessPoW1Submission(message, offset, from); };
+        if (m_stateNotifier.ParkUntil(POW1_SUBMISSION, replay, chrono::milliseconds(POW_SUB_BUFFER_TIME * 100)))
         {
-            if (m_state == POW1_SUBMISSION)
-            {
-                break;
-            }
-
-            if (i % 10 == 0)
-            {
-                LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Waiting for POW1_SUBMISSION before processing");
-            }
-            this_thread::sleep_for(chrono::milliseconds(sleep_time_while_waiting));
+            LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Parked until POW1_SUBMISSION");
+            return true;
         }
     }
 
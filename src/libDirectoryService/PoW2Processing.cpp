@@ -166,21 +166,15 @@ bool DirectoryService::ProcessPoW2Submission(const vector<unsigned char> & messa
     // Message = [32-byte block num] [4-byte listening port] [33-byte public key] [8-byte nonce] [32-byte resulting hash] [32-byte mixhash]
     LOG_MARKER();
     shared_lock<shared_timed_mutex> lock(m_mutexProducerConsumer);
-    unsigned int sleep_time_while_waiting = 100; 
-    if (m_state == DSBLOCK_CONSENSUS || 
-        (m_state != POW2_SUBMISSION && m_mode == Mode::IDLE && m_mediator.m_node->m_state == Node::POW2_SUBMISSION))
+    if (m_state == DSBLOCK_CONSENSUS || m_state == POW2_SUBMISSION || 
+        (m_mode == Mode::IDLE && m_mediator.m_node->m_state == Node::POW2_SUBMISSION))
     {
-        for (unsigned int i = 0; i < POW_SUB_BUFFER_TIME; i++)
+        // Accept submissions that arrive up to POW_SUB_BUFFER_TIME tenths of a second early
+        auto replay = [this, message, offset, from]() -> void { ProcessPoW2Submission(message, offset, from); };
+        if (m_stateNotifier.ParkUntil(POW2_SUBMISSION, replay, chrono::milliseconds(POW_SUB_BUFFER_TIME * 100)))
         {
-            if (m_state == POW2_SUBMISSION)
-            {
-                break;
-            }
-            if(i % 10 == 0)
-            {
-                LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Waiting for POW2_SUBMISSION before processing");
-            }
-            this_thread::sleep_for(chrono::milliseconds(sleep_time_while_waiting));
+            LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Parked until POW2_SUBMISSION");
+            return true;
         }
     }
 
@@ -31,6 +31,7 @@
 #include "libNetwork/P2PComm.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
+#include "libUtils/EventLog.h"
 #include "libUtils/Logger.h"
 #include "libUtils/SanityChecks.h"
 
@@ -201,29 +202,20 @@ bool DirectoryService::ProcessShardingConsensus(const vector<unsigned char> & me
     LOG_MARKER();
     // Consensus messages must be processed in correct sequence as they come in
     // It is possible for ANNOUNCE to arrive before correct DS state
-    // In that case, ANNOUNCE will sleep for a second below
-    // If COLLECTIVESIG also comes in, it's then possible COLLECTIVESIG will be processed before ANNOUNCE!
-    // So, ANNOUNCE should acquire a lock here
+    // In that case, ANNOUNCE is parked below and replayed once the state is entered
+    // Messages arriving in the state itself also go through the queue while it is not empty, so a
+    // COLLECTIVESIG cannot overtake a parked ANNOUNCE
 
     lock_guard<mutex> g(m_mutexConsensus);
     
-    unsigned int sleep_time_while_waiting = 100; 
-    // Wait for a while in the case that primary sent announcement pretty early
-    if ((m_state == POW2_SUBMISSION) || (m_state == SHARDING_CONSENSUS_PREP))
+    // Park the message in the case that primary sent announcement pretty early
+    if ((m_state == POW2_SUBMISSION) || (m_state == SHARDING_CONSENSUS_PREP) || (m_state == SHARDING_CONSENSUS))
     {
-        for (unsigned int i = 0; i < 1000; i++)
+        auto replay = [this, message, offset, from]() -> void { ProcessShardingConsensus(message, offset, from); };
+        if (m_stateNotifier.ParkUntil(SHARDING_CONSENSUS, replay, chrono::seconds(100)))
         {
-            if (m_state == SHARDING_CONSENSUS)
-            {
-                break;
-            }
-
-            if (i % 100 == 0)
-            {
-                LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Waiting for SHARDING_CONSENSUS before processing");
-            }
-
-            this_thread::sleep_for(chrono::milliseconds(sleep_time_while_waiting));
+            LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Parked until SHARDING_CONSENSUS");
+            return true;
         }
     }
 
@@ -246,9 +238,10 @@ bool DirectoryService::ProcessShardingConsensus(const vector<unsigned char> & me
 #ifdef STAT_TEST
         if (m_mode == PRIMARY_DS)
         {
-            LOG_STATE("[SHCON][" << std::setw(15) << std::left << 
+            LOG_STATE_TEXT("[SHCON][" << std::setw(15) << std::left << 
                       m_mediator.m_selfPeer.GetPrintableIPAddress() << "][" << 
                       m_mediator.m_txBlockChain.GetBlockCount() << "] DONE");
+            LOG_EVENT(EVENT_SHCON, PHASE_DONE, m_mediator.m_txBlockChain.GetBlockCount(), 0, 0);
         }
 #endif // STAT_TEST
 
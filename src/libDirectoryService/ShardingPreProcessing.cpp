@@ -31,6 +31,7 @@
 #include "libNetwork/P2PComm.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
+#include "libUtils/EventLog.h"
 #include "libUtils/Logger.h"
 #include "libUtils/SanityChecks.h"
 
@@ -170,16 +171,20 @@ bool DirectoryService::RunConsensusOnShardingWhenDSPrimary()
         return false;
     }
 
-    ConsensusLeader * cl = dynamic_cast<ConsensusLeader*>(m_consensusObject.get());
+    // Hold a reference so the consensus object outlives the preparation window
+    shared_ptr<ConsensusCommon> consensus = m_consensusObject;
 
     LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Waiting " << LEADER_SHARDING_PREPARATION_IN_SECONDS << " seconds before announcing...");
-    this_thread::sleep_for(chrono::seconds(LEADER_SHARDING_PREPARATION_IN_SECONDS));
-
+    SchedulePhase(LEADER_SHARDING_PREPARATION_IN_SECONDS, [this, consensus, sharding_structure]() -> void
+    {
 #ifdef STAT_TEST
-    LOG_STATE("[SHCON][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "][" << m_mediator.m_txBlockChain.GetBlockCount() << "] BGIN");
+        LOG_STATE_TEXT("[SHCON][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "][" << m_mediator.m_txBlockChain.GetBlockCount() << "] BGIN");
+        LOG_EVENT(EVENT_SHCON, PHASE_BEGN, m_mediator.m_txBlockChain.GetBlockCount(), 0, 0);
 #endif // STAT_TEST
 
-    cl->StartConsensus(sharding_structure);
+        ConsensusLeader * cl = dynamic_cast<ConsensusLeader*>(consensus.get());
+        cl->StartConsensus(sharding_structure);
+    });
 
     return true;
 }
@@ -300,7 +305,8 @@ void DirectoryService::RunConsensusOnSharding()
 
     lock_guard<mutex> g(m_mutexAllPOW2);
     LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Num of PoW2 sub rec: " << m_allPoW2s.size());
-    LOG_STATE("[POW2R][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "]["<< m_allPoW2s.size() << "] ");
+    LOG_STATE_TEXT("[POW2R][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "]["<< m_allPoW2s.size() << "] ");
+    LOG_EVENT(EVENT_POW2R, PHASE_NONE, m_mediator.m_currentEpochNum, m_allPoW2s.size(), 0);
 
     LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "My consensus id is " << m_consensusMyID); 
 
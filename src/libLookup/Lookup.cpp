@@ -31,6 +31,7 @@
 #include <boost/property_tree/ptree.hpp>
 
 #include "common/Messages.h"
+#include "libData/AccountData/TxnVerifier.h"
 #include "libData/BlockData/Block.h"
 #include "libData/BlockChainData/DSBlockChain.h"
 #include "libData/BlockChainData/TxBlockChain.h"
@@ -38,6 +39,7 @@
 #include "libNetwork/P2PComm.h"
 #include "libPersistence/BlockStorage.h"
 #include "libUtils/DataConversion.h"
+#include "libUtils/Executor.h"
 #include "libUtils/SanityChecks.h"
 #include "Lookup.h"
 
@@ -520,13 +522,11 @@ bool Lookup::ProcessGetDSBlockFromSeed(const vector<unsigned char> & message, un
     }
 
     // 32-byte lower-limit block number 
-    boost::multiprecision::uint256_t lowBlockNum = 
-        Serializable::GetNumber<uint256_t>(message, offset, UINT256_SIZE);
+    uint64_t lowBlockNum = Serializable::GetNumber<uint64_t>(message, offset, UINT256_SIZE);
     offset += UINT256_SIZE; 
 
     // 32-byte upper-limit block number 
-    boost::multiprecision::uint256_t highBlockNum = 
-        Serializable::GetNumber<uint256_t>(message, offset, UINT256_SIZE);
+    uint64_t highBlockNum = Serializable::GetNumber<uint64_t>(message, offset, UINT256_SIZE);
     offset += UINT256_SIZE; 
 
     if(highBlockNum == 0)
@@ -536,38 +536,38 @@ bool Lookup::ProcessGetDSBlockFromSeed(const vector<unsigned char> & message, un
 
     LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
                  "ProcessGetDSBlockFromSeed requested by " << from << " for blocks " <<
-                 lowBlockNum.convert_to<string>() << " to " << highBlockNum.convert_to<string>());
+                 lowBlockNum << " to " << highBlockNum);
 
     // dsBlockMessage = [lowBlockNum][highBlockNum][DSBlock][DSBlock]... (highBlockNum - lowBlockNum + 1) times
     vector<unsigned char> dsBlockMessage = { MessageType::LOOKUP, 
                                              LookupInstructionType::SETDSBLOCKFROMSEED };
     unsigned int curr_offset = MessageOffset::BODY;
 
-    Serializable::SetNumber<uint256_t>(dsBlockMessage, curr_offset, lowBlockNum, UINT256_SIZE);
+    Serializable::SetNumber<uint64_t>(dsBlockMessage, curr_offset, lowBlockNum, UINT256_SIZE);
     curr_offset += UINT256_SIZE;
 
     unsigned int highBlockNumOffset = curr_offset;
 
-    Serializable::SetNumber<uint256_t>(dsBlockMessage, curr_offset, highBlockNum, UINT256_SIZE);
+    Serializable::SetNumber<uint64_t>(dsBlockMessage, curr_offset, highBlockNum, UINT256_SIZE);
     curr_offset += UINT256_SIZE;
 
-    boost::multiprecision::uint256_t blockNum; 
+    uint64_t blockNum;
 
     for(blockNum = lowBlockNum; blockNum <= highBlockNum; blockNum++)
     {
         try
         {
             LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
-                         "Fetching DSBlock " << blockNum.convert_to<string>() << " for " << from);
-            DSBlock dsBlock = m_mediator.m_dsBlockChain.GetBlock(blockNum);
+                         "Fetching DSBlock " << blockNum << " for " << from);
+            shared_ptr<const DSBlock> dsBlock = m_mediator.m_dsBlockChain.GetBlock(blockNum);
             LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
-                         "DSBlock " << blockNum.convert_to<string>() << " serialized for " << from);
-            dsBlock.Serialize(dsBlockMessage, curr_offset);
+                         "DSBlock " << blockNum << " serialized for " << from);
+            dsBlock->Serialize(dsBlockMessage, curr_offset);
             curr_offset += DSBlock::GetSerializedSize();
         }
         catch (const char* e)
         {
-            LOG_MESSAGE("Block Number " + blockNum.convert_to<string>() + 
+            LOG_MESSAGE("Block Number " << blockNum << 
                         " absent. Didn't include it in response message. Reason: " << e);
             break;
         }
@@ -576,7 +576,7 @@ bool Lookup::ProcessGetDSBlockFromSeed(const vector<unsigned char> & message, un
     // if serialization got interrupted in between, reset the highBlockNum value in msg
     if(blockNum != highBlockNum + 1)
     {
-        Serializable::SetNumber<uint256_t>(dsBlockMessage, highBlockNumOffset, blockNum - 1, 
+        Serializable::SetNumber<uint64_t>(dsBlockMessage, highBlockNumOffset, blockNum - 1, 
                                            UINT256_SIZE);
     }
 
@@ -609,13 +609,11 @@ bool Lookup::ProcessGetTxBlockFromSeed(const vector<unsigned char> & message, un
     }
 
     // 32-byte lower-limit block number 
-    boost::multiprecision::uint256_t lowBlockNum = 
-        Serializable::GetNumber<uint256_t>(message, offset, UINT256_SIZE);
+    uint64_t lowBlockNum = Serializable::GetNumber<uint64_t>(message, offset, UINT256_SIZE);
     offset += UINT256_SIZE; 
 
     // 32-byte upper-limit block number 
-    boost::multiprecision::uint256_t highBlockNum = 
-        Serializable::GetNumber<uint256_t>(message, offset, UINT256_SIZE);
+    uint64_t highBlockNum = Serializable::GetNumber<uint64_t>(message, offset, UINT256_SIZE);
     offset += UINT256_SIZE; 
 
     if(highBlockNum == 0)
@@ -625,38 +623,38 @@ bool Lookup::ProcessGetTxBlockFromSeed(const vector<unsigned char> & message, un
 
     LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
                  "ProcessGetTxBlockFromSeed requested by " << from << " for blocks " <<
-                 lowBlockNum.convert_to<string>() << " to " << highBlockNum.convert_to<string>());
+                 lowBlockNum << " to " << highBlockNum);
 
     // txBlockMessage = [lowBlockNum][highBlockNum][TxBlock][TxBlock]... (highBlockNum - lowBlockNum + 1) times
     vector<unsigned char> txBlockMessage = { MessageType::LOOKUP, 
                                              LookupInstructionType::SETTXBLOCKFROMSEED };
     unsigned int curr_offset = MessageOffset::BODY;
 
-    Serializable::SetNumber<uint256_t>(txBlockMessage, curr_offset, lowBlockNum, UINT256_SIZE);
+    Serializable::SetNumber<uint64_t>(txBlockMessage, curr_offset, lowBlockNum, UINT256_SIZE);
     curr_offset += UINT256_SIZE;
 
     unsigned int highBlockNumOffset = curr_offset;
 
-    Serializable::SetNumber<uint256_t>(txBlockMessage, curr_offset, highBlockNum, UINT256_SIZE);
+    Serializable::SetNumber<uint64_t>(txBlockMessage, curr_offset, highBlockNum, UINT256_SIZE);
     curr_offset += UINT256_SIZE;
 
-    boost::multiprecision::uint256_t blockNum; 
+    uint64_t blockNum;
 
     for(blockNum = lowBlockNum; blockNum <= highBlockNum; blockNum++)
     {
         try
         {
             LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
-                         "Fetching TxBlock " << blockNum.convert_to<string>() << " for " << from);
-            TxBlock txBlock = m_mediator.m_txBlockChain.GetBlock(blockNum);
+                         "Fetching TxBlock " << blockNum << " for " << from);
+            shared_ptr<const TxBlock> txBlock = m_mediator.m_txBlockChain.GetBlock(blockNum);
             LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
-                         "TxBlock " << blockNum.convert_to<string>() << " serialized for " << from);
-            txBlock.Serialize(txBlockMessage, curr_offset);
-            curr_offset += txBlock.GetSerializedSize();
+                         "TxBlock " << blockNum << " serialized for " << from);
+            txBlock->Serialize(txBlockMessage, curr_offset);
+            curr_offset += txBlock->GetSerializedSize();
         }
         catch (const char* e)
         {
-            LOG_MESSAGE("Block Number " + blockNum.convert_to<string>() + 
+            LOG_MESSAGE("Block Number " << blockNum << 
                         " absent. Didn't include it in response message. Reason: " << e);
             break;
         }
@@ -665,7 +663,7 @@ bool Lookup::ProcessGetTxBlockFromSeed(const vector<unsigned char> & message, un
     // if serialization got interrupted in between, reset the highBlockNum value in msg
     if(blockNum != highBlockNum + 1)
     {
-        Serializable::SetNumber<uint256_t>(txBlockMessage, highBlockNumOffset, blockNum - 1, 
+        Serializable::SetNumber<uint64_t>(txBlockMessage, highBlockNumOffset, blockNum - 1, 
                                            UINT256_SIZE);
     }
 
@@ -691,6 +689,11 @@ bool Lookup::ProcessGetTxBodyFromSeed(const vector<unsigned char> & message, uns
 
     LOG_MARKER();
 
+    if (IsMessageSizeInappropriate(message.size(), offset, TRAN_HASH_SIZE + sizeof(uint32_t)))
+    {
+        return false;
+    }
+
     TxnHash tranHash;
     copy(message.begin() + offset, message.begin() + offset + TRAN_HASH_SIZE, 
          tranHash.asArray().begin());
@@ -698,13 +701,18 @@ bool Lookup::ProcessGetTxBodyFromSeed(const vector<unsigned char> & message, uns
 
     TxBodySharedPtr tx;
 
-    BlockStorage::GetBlockStorage().GetTxBody(tranHash, tx);
+    // Bodies of transactions not committed yet are not stored, and such requests get no reply
+    if (!BlockStorage::GetBlockStorage().GetTxBody(tranHash, tx))
+    {
+        return false;
+    }
 
     // txBodyMessage = [TRAN_HASH_SIZE txHashStr][Transaction::GetSerializedSize() txBody]
     vector<unsigned char> txBodyMessage = { MessageType::LOOKUP, 
                                             LookupInstructionType::SETTXBODYFROMSEED };
     unsigned int curr_offset = MessageOffset::BODY;
 
+    txBodyMessage.resize(curr_offset + TRAN_HASH_SIZE);
     copy(tranHash.asArray().begin(), tranHash.asArray().end(), txBodyMessage.begin() + curr_offset);
     curr_offset += TRAN_HASH_SIZE;
 
@@ -864,7 +872,7 @@ bool Lookup::ProcessSetDSBlockFromSeed(const vector<unsigned char> & message, un
         // Store DS Block to disk
         vector<unsigned char> serializedDSBlock;
         dsBlock.Serialize(serializedDSBlock, 0);
-        BlockStorage::GetBlockStorage().PutDSBlock(dsBlock.GetHeader().GetBlockNum(), 
+        BlockStorage::GetBlockStorage().PutDSBlock(dsBlock.GetHeader().GetBlockNum().convert_to<uint64_t>(), 
                                                    serializedDSBlock);
     }
 
@@ -940,11 +948,12 @@ bool Lookup::ProcessSetTxBlockFromSeed(const vector<unsigned char> & message, un
         // Store Tx Block to disk
         vector<unsigned char> serializedTxBlock;
         txBlock.Serialize(serializedTxBlock, 0);
-        BlockStorage::GetBlockStorage().PutTxBlock(txBlock.GetHeader().GetBlockNum(), 
+        BlockStorage::GetBlockStorage().PutTxBlock(txBlock.GetHeader().GetBlockNum().convert_to<uint64_t>(), 
                                                    serializedTxBlock);
     }
 #ifndef IS_LOOKUP_NODE // TODO : remove from here to top
-    m_mediator.m_currentEpochNum = (uint64_t) m_mediator.m_txBlockChain.GetBlockCount();
+    m_mediator.m_currentEpochNum = m_mediator.m_txBlockChain.GetBlockCount();
+    TRACE_EPOCH(m_mediator.m_currentEpochNum);
     m_mediator.UpdateTxBlockRand();
 
     {
@@ -963,18 +972,21 @@ bool Lookup::ProcessSetTxBlockFromSeed(const vector<unsigned char> & message, un
     POW::GetInstance().EthashConfigureLightClient(m_mediator.m_currentEpochNum);
     // for(int i=0; i<5; i++)
     // {
-    m_mediator.m_node->StartPoW2(m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum(), 
+    m_mediator.m_node->StartPoW2(m_mediator.m_dsBlockChain.GetLastBlock()->GetHeader().GetBlockNum(), 
                                  uint8_t(0x3), dsBlockRand, txBlockRand);
     //     this_thread::sleep_for(chrono::seconds(15));
     // }
-    this_thread::sleep_for(chrono::seconds(NEW_NODE_POW2_TIMEOUT_IN_SECONDS));
-    if(!m_mediator.m_isConnectedToNetwork)
+    auto func = [this]() -> void
     {
-        Synchronizer synchronizer;
-        synchronizer.FetchDSInfo(this);
-        synchronizer.FetchLatestDSBlocks(this, m_mediator.m_dsBlockChain.GetBlockCount());
-        synchronizer.FetchLatestTxBlocks(this, m_mediator.m_txBlockChain.GetBlockCount());        
-    }
+        if(!m_mediator.m_isConnectedToNetwork)
+        {
+            Synchronizer synchronizer;
+            synchronizer.FetchDSInfo(this);
+            synchronizer.FetchLatestDSBlocks(this, m_mediator.m_dsBlockChain.GetBlockCount());
+            synchronizer.FetchLatestTxBlocks(this, m_mediator.m_txBlockChain.GetBlockCount());        
+        }
+    };
+    Executor::GetInstance().PostBlockingAfter(chrono::seconds(NEW_NODE_POW2_TIMEOUT_IN_SECONDS), func);
 #endif // IS_LOOKUP_NODE
 
     return true;
@@ -1001,6 +1013,12 @@ bool Lookup::ProcessSetTxBodyFromSeed(const vector<unsigned char> & message, uns
 
     Transaction transaction(message, offset);
 
+    if ((transaction.GetTranID() != tranHash) || (TxnVerifier::Check(transaction, 0, 0) != TxnVerifier::VALID))
+    {
+        LOG_MESSAGE("Error: Txn body from seed failed verification: " << tranHash);
+        return false;
+    }
+
     vector<unsigned char> serializedTxBody;
     transaction.Serialize(serializedTxBody, 0);
     BlockStorage::GetBlockStorage().PutTxBody(tranHash, serializedTxBody);
@@ -66,7 +66,7 @@ bool Synchronizer::AddGenesisDSBlockToBlockChain(DSBlockChain & dsBlockChain,
     // Store DS Block to disk
     vector<unsigned char> serializedDSBlock;
     dsBlock.Serialize(serializedDSBlock, 0);
-    BlockStorage::GetBlockStorage().PutDSBlock(dsBlock.GetHeader().GetBlockNum(), 
+    BlockStorage::GetBlockStorage().PutDSBlock(dsBlock.GetHeader().GetBlockNum().convert_to<uint64_t>(), 
                                                serializedDSBlock);
 
     return true;
@@ -115,7 +115,7 @@ bool Synchronizer::AddGenesisTxBlockToBlockChain(TxBlockChain & txBlockChain,
     // Store Tx Block to disk
     vector<unsigned char> serializedTxBlock;
     txBlock.Serialize(serializedTxBlock, 0);
-    BlockStorage::GetBlockStorage().PutTxBlock(txBlock.GetHeader().GetBlockNum(), 
+    BlockStorage::GetBlockStorage().PutTxBlock(txBlock.GetHeader().GetBlockNum().convert_to<uint64_t>(), 
                                                serializedTxBlock);    
 
     return true;
@@ -60,10 +60,10 @@ void Mediator::UpdateDSBlockRand(bool isGenesis)
     }
     else
     {
-        DSBlock lastBlock = m_dsBlockChain.GetLastBlock();
+        shared_ptr<const DSBlock> lastBlock = m_dsBlockChain.GetLastBlock();
         SHA2<HASH_TYPE::HASH_VARIANT_256> sha2;
         vector<unsigned char> vec;
-        lastBlock.GetHeader().Serialize(vec, 0);
+        lastBlock->GetHeader().Serialize(vec, 0);
         sha2.Update(vec);
         vector<unsigned char> randVec;
         randVec = sha2.Finalize();
@@ -84,10 +84,10 @@ void Mediator::UpdateTxBlockRand(bool isGenesis)
     }
     else
     {
-        TxBlock lastBlock = m_txBlockChain.GetLastBlock();
+        shared_ptr<const TxBlock> lastBlock = m_txBlockChain.GetLastBlock();
         SHA2<HASH_TYPE::HASH_VARIANT_256> sha2;
         vector<unsigned char> vec;
-        lastBlock.GetHeader().Serialize(vec, 0);
+        lastBlock->GetHeader().Serialize(vec, 0);
         sha2.Update(vec);
         vector<unsigned char> randVec;
         randVec = sha2.Finalize();
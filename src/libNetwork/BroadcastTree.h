@@ -0,0 +1,113 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#ifndef __BROADCASTTREE_H__
+#define __BROADCASTTREE_H__
+
+#include <vector>
+
+/// Deterministic k-ary dissemination tree over the members 0..size-1 of a committee.
+///
+/// The root member sits at position 0 and member i at position (i - root) mod size. The children of
+/// position p are positions p * fanout + 1 .. p * fanout + fanout, so every member forwards to at most
+/// fanout others and a message from the root reaches everyone in O(log size) hops.
+class BroadcastTree
+{
+    unsigned int m_size;
+    unsigned int m_fanout;
+    unsigned int m_root;
+
+    unsigned int ToPosition(unsigned int member) const
+    {
+        return (member + m_size - m_root) % m_size;
+    }
+
+    unsigned int ToMember(unsigned int position) const
+    {
+        return (position + m_root) % m_size;
+    }
+
+public:
+
+    /// Constructor. fanout must be at least 1 and root less than size.
+    BroadcastTree(unsigned int size, unsigned int fanout, unsigned int root) : 
+        m_size(size), m_fanout(fanout), m_root(root)
+    {
+    }
+
+    /// Returns the member at the root of the tree.
+    unsigned int GetRoot() const
+    {
+        return m_root;
+    }
+
+    /// Returns the members the given member forwards to.
+    std::vector<unsigned int> GetChildren(unsigned int member) const
+    {
+        std::vector<unsigned int> children;
+
+        if (member >= m_size)
+        {
+            return children;
+        }
+
+        const unsigned long long first = (unsigned long long)ToPosition(member) * m_fanout + 1;
+        for (unsigned long long p = first; (p < first + m_fanout) && (p < m_size); p++)
+        {
+            children.push_back(ToMember(p));
+        }
+
+        return children;
+    }
+
+    /// Returns the member the given member receives from. The root is its own parent.
+    unsigned int GetParent(unsigned int member) const
+    {
+        const unsigned int position = ToPosition(member);
+        return (position == 0) ? member : ToMember((position - 1) / m_fanout);
+    }
+
+    /// Returns true if member is root_member or one of its descendants.
+    bool IsInSubtree(unsigned int root_member, unsigned int member) const
+    {
+        if ((root_member >= m_size) || (member >= m_size))
+        {
+            return false;
+        }
+
+        const unsigned int root_position = ToPosition(root_member);
+        unsigned int position = ToPosition(member);
+        while (position > root_position)
+        {
+            position = (position - 1) / m_fanout;
+        }
+
+        return position == root_position;
+    }
+
+    /// Returns the number of hops from the root to the deepest member.
+    unsigned int GetDepth() const
+    {
+        unsigned int depth = 0;
+        for (unsigned long long last = 0; last + 1 < m_size; depth++)
+        {
+            last = last * m_fanout + m_fanout;
+        }
+        return depth;
+    }
+};
+
+#endif // __BROADCASTTREE_H__
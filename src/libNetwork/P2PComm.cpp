@@ -16,6 +16,7 @@
 
 
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <unistd.h>
 #include <stdint.h>
@@ -27,9 +28,10 @@
 #include "PeerStore.h"
 #include "common/Messages.h"
 #include "libCrypto/Sha2.h"
+#include "libUtils/EventLog.h"
+#include "libUtils/Executor.h"
 #include "libUtils/Logger.h"
-#include "libUtils/DetachedFunction.h"
-#include "libUtils/JoinableFunction.h"
+#include "libUtils/Metrics.h"
 #include "libUtils/DataConversion.h"
 
 using namespace std;
@@ -75,11 +77,13 @@ P2PComm & P2PComm::GetInstance()
     return comm;
 }
 
-void P2PComm::SendMessageCore(const Peer & peer, const std::vector<unsigned char> & message, 
+void P2PComm::SendMessageCore(const Peer & peer, const unsigned char * message, uint32_t length,
                               unsigned char start_byte, const vector<unsigned char> & msg_hash)
 {
+    TRACE_SPAN(__FUNCTION__);
+
     uint32_t retry_counter = 0;
-    while (!SendMessageSocketCore(peer, message, start_byte, msg_hash))
+    while (!SendMessageSocketCore(peer, message, length, start_byte, msg_hash))
     {
         retry_counter++;
         LOG_MESSAGE("Error: Socket connect failed " << retry_counter  << "/" << MAXRETRYCONN <<
@@ -94,12 +98,13 @@ void P2PComm::SendMessageCore(const Peer & peer, const std::vector<unsigned char
     }
 }
 
-bool P2PComm::SendMessageSocketCore(const Peer & peer, const std::vector<unsigned char> & message,
+bool P2PComm::SendMessageSocketCore(const Peer & peer, const unsigned char * message, uint32_t length,
                                     unsigned char start_byte, 
                                     const vector<unsigned char> & msg_hash)
 {
     LOG_MARKER();
-    LOG_PAYLOAD("Sending message to " << peer, message, Logger::MAX_BYTES_TO_DISPLAY);
+
+    LOG_PAYLOAD_BYTES("Sending message to " << peer, message, length, Logger::MAX_BYTES_TO_DISPLAY);
     
     if (peer.m_ipAddress == 0 && peer.m_listenPortHost == 0)
     {
@@ -138,8 +143,10 @@ bool P2PComm::SendMessageSocketCore(const Peer & peer, const std::vector<unsigne
         {
             LOG_MESSAGE("Error: Socket connect failed. Code = " << errno  << " Desc: " << 
                         std::strerror(errno) << ". IP address: " << peer);
+            METRICS_COUNTER("zilliqa_p2p_connect_failures_total", "Outgoing connections that failed to connect").Increment();
             return false;
         }
+        METRICS_COUNTER("zilliqa_p2p_connections_opened_total", "Outgoing connections opened").Increment();
 
         // Transmission format:
         // 0x11 - start byte
@@ -153,66 +160,52 @@ bool P2PComm::SendMessageSocketCore(const Peer & peer, const std::vector<unsigne
         // 0x33 - start byte (report)
         // 0x00 0x00 0x00 0x01 - 4-byte length of message
         // 0x00
-        uint32_t length = message.size();
+        uint32_t body_length = length;
         if (start_byte == START_BYTE_BROADCAST)
         {
+            if (msg_hash.size() != HASH_LEN)
+            {
+                LOG_MESSAGE("Error: Wrong message hash length.");
+                return false;
+            }
             length += HASH_LEN;
         }
         unsigned char buf[HDR_LEN] = {start_byte, (unsigned char)((length >> 24) & 0xFF),
                                       (unsigned char)((length >> 16) & 0xFF), 
                                       (unsigned char)((length >> 8) & 0xFF), 
                                       (unsigned char)(length & 0xFF)};
-        uint32_t written_length = 0;
 
-        while (written_length != HDR_LEN)
+        // Header, hash and body go out in one gathered write straight from their own buffers
+        struct iovec iov[3];
+        unsigned int iov_count = 0;
+        iov[iov_count].iov_base = buf;
+        iov[iov_count++].iov_len = HDR_LEN;
+        if (start_byte == START_BYTE_BROADCAST)
         {
-            int n = write(cli_sock, buf + written_length, HDR_LEN - written_length);
-            if (n <= 0)
-            {
-                LOG_MESSAGE("Error: Socket write failed in message header. Code = " << errno  <<
-                            " Desc: " << std::strerror(errno) << ". IP address:" << peer);
-                return false;
-            }
-            written_length += n;
+            iov[iov_count].iov_base = const_cast<unsigned char *>(msg_hash.data());
+            iov[iov_count++].iov_len = HASH_LEN;
         }
-
-        if (start_byte == START_BYTE_BROADCAST)
+        if (body_length > 0)
         {
-            written_length = 0;
-            while (written_length != HASH_LEN)
-            {
-                int n = write(cli_sock, &msg_hash.at(0) + written_length, 
-                              HASH_LEN - written_length);
-                if (n <= 0)
-                {
-                    LOG_MESSAGE("Error: Socket write failed in hash header. Code = " << errno <<
-                                " Desc: " << std::strerror(errno) ) ;
-                    return false;
-                }
-                written_length += n;
-            }
-
-            if (written_length == HASH_LEN)
-            {
-                written_length = HDR_LEN;
-            }
-            else
-            {
-                LOG_MESSAGE("Error: Wrong message hash length.");
-                return false;
-            }
-
-            length -= HASH_LEN;
+            iov[iov_count].iov_base = const_cast<unsigned char *>(message);
+            iov[iov_count++].iov_len = body_length;
         }
 
-        if (written_length == HDR_LEN)
+        const size_t total_length = HDR_LEN + length;
+        size_t written_length = 0;
+        struct iovec * next = iov;
+
+        while (written_length != total_length)
         {
-            written_length = 0;
-            while (written_length != length)
-            {
-                int n = write(cli_sock, &message.at(0) + written_length, length - written_length);
+            struct msghdr msg;
+            memset(&msg, 0, sizeof(msg));
+            msg.msg_iov = next;
+            msg.msg_iovlen = iov_count - (next - iov);
 
-                if (errno == EPIPE) 
+            ssize_t n = sendmsg(cli_sock, &msg, MSG_NOSIGNAL);
+            if (n <= 0)
+            {
+                if ((errno == EPIPE) && (written_length >= HDR_LEN))
                 {
                     LOG_MESSAGE(" Error: SIGPIPE detected. Error No: " << errno << " Desc: " <<
                                 std::strerror(errno)); 
@@ -220,13 +213,24 @@ bool P2PComm::SendMessageSocketCore(const Peer & peer, const std::vector<unsigne
                     // No retry as it is likely the other end terminate the conn due to duplicated msg.
                 }
 
-                if (n <= 0)
-                {
-                    LOG_MESSAGE("Error: Socket write failed in message body. Code = " << 
-                                errno << " Desc: " << std::strerror(errno) );
-                    return false;
-                }
-                written_length += n;
+                LOG_MESSAGE("Error: Socket write failed. Code = " << errno << " Desc: " << 
+                            std::strerror(errno) << ". IP address: " << peer);
+                return false;
+            }
+            written_length += n;
+            METRICS_COUNTER("zilliqa_p2p_bytes_sent_total", "Bytes written to outgoing connections").Increment(n);
+
+            // Skip the fully written pieces and advance into a partially written one
+            size_t remaining = n;
+            while ((remaining > 0) && (remaining >= next->iov_len))
+            {
+                remaining -= next->iov_len;
+                next++;
+            }
+            if (remaining > 0)
+            {
+                next->iov_base = static_cast<unsigned char *>(next->iov_base) + remaining;
+                next->iov_len -= remaining;
             }
         }
 
@@ -244,7 +248,7 @@ bool P2PComm::SendMessageSocketCore(const Peer & peer, const std::vector<unsigne
 }
 
 void P2PComm::SendBroadcastMessageCore(const vector<Peer> & peers,
-                                       const vector<unsigned char> & message,
+                                       const unsigned char * message, uint32_t length,
                                        const vector<unsigned char> & message_hash)
 {
     LOG_MARKER();
@@ -261,32 +265,30 @@ void P2PComm::SendBroadcastMessageCore(const vector<Peer> & peers,
     {
             
         Peer peer = peers.at(*curr);
-        auto func1 = [this, peer, &message, &message_hash]() mutable -> void
+        auto func1 = [this, peer, message, length, &message_hash]() mutable -> void
         {
-            SendMessageCore(peer, message, START_BYTE_BROADCAST, message_hash);
+            SendMessageCore(peer, message, length, START_BYTE_BROADCAST, message_hash);
         };
         pool.AddJob(func1);
     }
     pool.WaitAll(); 
     pool.JoinAll();
 
-    // TODO: are we sure there wont be many threads arising from this, will ThreadPool alleviate it?
-    // Launch a separate, detached thread to automatically remove the hash from the list after a long time period has elapsed
-    auto func2 = [this, message_hash]() -> void
+    // Schedule automatic removal of the hash from the list after a long time period has elapsed
+    vector<unsigned char> msg_hash_copy(message_hash);
+    auto func2 = [this, msg_hash_copy]() -> void
     {
-        vector<unsigned char> msg_hash_copy(message_hash);
-        this_thread::sleep_for(chrono::seconds(BROADCAST_EXPIRY_SECONDS));
         lock_guard<mutex> guard(m_broadcastHashesMutex);
         m_broadcastHashes.erase(msg_hash_copy);
         LOG_PAYLOAD("Removing msg hash from broadcast list", msg_hash_copy, 
                     Logger::MAX_BYTES_TO_DISPLAY);
     };
 
-    DetachedFunction(1, func2);
+    Executor::GetInstance().PostAfter(chrono::seconds(BROADCAST_EXPIRY_SECONDS), func2);
 }
 
 void P2PComm::HandleAcceptedConnection(int cli_sock, Peer from, 
-                                       function<void(const vector<unsigned char> &, const Peer &)> dispatcher, 
+                                       dispatcher_func dispatcher, 
                                        broadcast_list_func broadcast_list_retriever)
 {
     LOG_MARKER();
@@ -295,6 +297,9 @@ void P2PComm::HandleAcceptedConnection(int cli_sock, Peer from,
 
     LOG_MESSAGE("Incoming message from " << from);
 
+    METRICS_COUNTER("zilliqa_p2p_connections_accepted_total", "Incoming connections accepted").Increment();
+    MetricCounter & bytesReceived = METRICS_COUNTER("zilliqa_p2p_bytes_received_total", "Bytes read from incoming connections");
+
     vector<unsigned char> message;
 
     // Reception format:
@@ -324,6 +329,7 @@ void P2PComm::HandleAcceptedConnection(int cli_sock, Peer from,
             return;
         }
         read_length += n;
+        bytesReceived.Increment(n);
     }
 
     if (!((read_length == HDR_LEN) && ((buf[0] == START_BYTE_NORMAL) || (buf[0] == START_BYTE_BROADCAST))))
@@ -349,6 +355,7 @@ void P2PComm::HandleAcceptedConnection(int cli_sock, Peer from,
                 return;
             }
             read_length += n;
+            bytesReceived.Increment(n);
         }
 
         // Check if this message has been received before
@@ -375,6 +382,7 @@ void P2PComm::HandleAcceptedConnection(int cli_sock, Peer from,
                         return;
                     }
                     read_length += n;
+                    bytesReceived.Increment(n);
                 }
 
                 LOG_PAYLOAD("Message received", message, Logger::MAX_BYTES_TO_DISPLAY);
@@ -419,25 +427,31 @@ void P2PComm::HandleAcceptedConnection(int cli_sock, Peer from,
                 ins_type = message.at(MessageOffset::INST);
             }
 
+            // From here on the message is only shared, never copied
+            SharedBuffer buffer(move(message));
+
             vector<Peer> broadcast_list = broadcast_list_retriever(msg_type, ins_type, from);
             if (broadcast_list.size() > 0)
             {
-                // Launch a separate thread to forward the message to peers
+                // Forward to peers in the background while the message is dispatched; the task
+                // holds a reference to the buffer until the last send is done
                 vector<unsigned char> this_msg_hash(hash_buf, hash_buf + HASH_LEN);
-                auto func = [this, &broadcast_list, &message, &this_msg_hash]() -> 
-                             void { SendBroadcastMessageCore(broadcast_list, message,
-                                                             this_msg_hash); };
-                JoinableFunction jf(1, func);
+                auto func = [this, broadcast_list, buffer, this_msg_hash]() -> void
+                { 
+                    SendBroadcastMessageCore(broadcast_list, buffer.data(), buffer.size(), this_msg_hash); 
+                };
+                Executor::GetInstance().PostBlocking(func);
             }
 
 #ifdef STAT_TEST
             vector<unsigned char> this_msg_hash(hash_buf, hash_buf + HASH_LEN);
-            LOG_STATE("[BROAD][" << std::setw(15) << std::left << m_selfPeer << "][" << 
+            LOG_STATE_TEXT("[BROAD][" << std::setw(15) << std::left << m_selfPeer << "][" << 
                       DataConversion::Uint8VecToHexStr(this_msg_hash).substr(0, 6) << "] RECV");
+            LOG_EVENT(EVENT_BROAD, PHASE_RECV, 0, Serializable::GetNumber<uint64_t>(this_msg_hash, 0, sizeof(uint64_t)), 0);
 #endif // STAT_TEST
 
             // Dispatch message normally
-            dispatcher(message, from);
+            dispatcher(buffer, from);
         }
     }
     else
@@ -455,6 +469,7 @@ void P2PComm::HandleAcceptedConnection(int cli_sock, Peer from,
                 return;
             }
             read_length += n;
+            bytesReceived.Increment(n);
         }
 
         LOG_PAYLOAD("Message received", message, Logger::MAX_BYTES_TO_DISPLAY);
@@ -467,12 +482,12 @@ void P2PComm::HandleAcceptedConnection(int cli_sock, Peer from,
 
         cli_sock_closer.reset(); // close socket now so it can be reused
 
-        dispatcher(message, from);
+        dispatcher(SharedBuffer(move(message)), from);
     }
 }
 
 void P2PComm::StartMessagePump(uint32_t listen_port_host, 
-                               function<void(const vector<unsigned char> &, const Peer &)> dispatcher,
+                               dispatcher_func dispatcher,
                                broadcast_list_func broadcast_list_retriever)
 {
     LOG_MARKER();
@@ -547,7 +562,7 @@ void P2PComm::SendMessage(const vector<Peer> & peers, const vector<unsigned char
         Peer peer = peers.at(*curr);
         auto func1 = [this, peer, &message]() mutable -> void
         {
-            SendMessageCore(peer, message, START_BYTE_NORMAL, vector<unsigned char>());
+            SendMessageCore(peer, message.data(), message.size(), START_BYTE_NORMAL, vector<unsigned char>());
         };
 
         
@@ -577,7 +592,7 @@ void P2PComm::SendMessage(const deque<Peer> & peers, const vector<unsigned char>
         Peer peer = peers.at(*curr);
         auto func1 = [this, peer, &message]() mutable -> void
         {
-            SendMessageCore(peer, message, START_BYTE_NORMAL, vector<unsigned char>());
+            SendMessageCore(peer, message.data(), message.size(), START_BYTE_NORMAL, vector<unsigned char>());
         };
 
         pool.AddJob(func1);
@@ -592,7 +607,13 @@ void P2PComm::SendMessage(const deque<Peer> & peers, const vector<unsigned char>
 void P2PComm::SendMessage(const Peer & peer, const vector<unsigned char> & message)
 {
     LOG_MARKER();
-    SendMessageCore(peer, message, START_BYTE_NORMAL, vector<unsigned char>());
+    SendMessageCore(peer, message.data(), message.size(), START_BYTE_NORMAL, vector<unsigned char>());
+}
+
+void P2PComm::SendMessage(const Peer & peer, const SharedBuffer & message)
+{
+    LOG_MARKER();
+    SendMessageCore(peer, message.data(), message.size(), START_BYTE_NORMAL, vector<unsigned char>());
 }
 
 void P2PComm::SendBroadcastMessage(const vector<Peer> & peers, 
@@ -612,15 +633,17 @@ void P2PComm::SendBroadcastMessage(const vector<Peer> & peers,
         }
 
 #ifdef STAT_TEST
-        LOG_STATE("[BROAD][" << std::setw(15) << std::left << m_selfPeer.GetPrintableIPAddress() <<
+        LOG_STATE_TEXT("[BROAD][" << std::setw(15) << std::left << m_selfPeer.GetPrintableIPAddress() <<
                   "][" << DataConversion::Uint8VecToHexStr(this_msg_hash).substr(0, 6) << "] BEGN");
+        LOG_EVENT(EVENT_BROAD, PHASE_BEGN, 0, Serializable::GetNumber<uint64_t>(this_msg_hash, 0, sizeof(uint64_t)), 0);
 #endif // STAT_TEST
 
-        SendBroadcastMessageCore(peers, message, this_msg_hash);
+        SendBroadcastMessageCore(peers, message.data(), message.size(), this_msg_hash);
 
 #ifdef STAT_TEST
-        LOG_STATE("[BROAD][" << std::setw(15) << std::left << m_selfPeer.GetPrintableIPAddress() <<
+        LOG_STATE_TEXT("[BROAD][" << std::setw(15) << std::left << m_selfPeer.GetPrintableIPAddress() <<
                   "][" << DataConversion::Uint8VecToHexStr(this_msg_hash).substr(0, 6) << "] DONE");
+        LOG_EVENT(EVENT_BROAD, PHASE_DONE, 0, Serializable::GetNumber<uint64_t>(this_msg_hash, 0, sizeof(uint64_t)), 0);
 #endif // STAT_TEST
     }
 }
@@ -25,9 +25,11 @@
 
 #include "Peer.h"
 #include "libUtils/Logger.h"
+#include "libUtils/SharedBuffer.h"
 #include "libUtils/ThreadPool.h"
 
 typedef std::function<std::vector<Peer>(unsigned char msg_type, unsigned char ins_type, const Peer &)> broadcast_list_func;
+typedef std::function<void(const SharedBuffer &, const Peer &)> dispatcher_func;
 
 /// Provides network layer functionality.
 class P2PComm
@@ -45,9 +47,9 @@ class P2PComm
     const static uint32_t PUMPMESSAGE_MILLISECONDS = 1000;
     uint32_t m_counterMessagePump;
 
-    void SendMessageCore(const Peer & peer, const std::vector<unsigned char> & message, unsigned char start_byte, const std::vector<unsigned char> & msg_hash);
-    bool SendMessageSocketCore(const Peer & peer, const std::vector<unsigned char> & message, unsigned char start_byte, const std::vector<unsigned char> & msg_hash);
-    void SendBroadcastMessageCore(const std::vector<Peer> & peers, const std::vector<unsigned char> & message, const std::vector<unsigned char> & message_hash);
+    void SendMessageCore(const Peer & peer, const unsigned char * message, uint32_t length, unsigned char start_byte, const std::vector<unsigned char> & msg_hash);
+    bool SendMessageSocketCore(const Peer & peer, const unsigned char * message, uint32_t length, unsigned char start_byte, const std::vector<unsigned char> & msg_hash);
+    void SendBroadcastMessageCore(const std::vector<Peer> & peers, const unsigned char * message, uint32_t length, const std::vector<unsigned char> & message_hash);
 
     P2PComm();
     ~P2PComm();
@@ -62,10 +64,11 @@ public:
     static P2PComm & GetInstance();
 
     /// Receives incoming message and assigns to designated message dispatcher.
-    void HandleAcceptedConnection(int cli_sock, Peer from, std::function<void(const std::vector<unsigned char> &, const Peer &)> dispatcher, broadcast_list_func broadcast_list_retriever);
+    /// The message is read once into a SharedBuffer that the dispatcher and the broadcast forwarder share.
+    void HandleAcceptedConnection(int cli_sock, Peer from, dispatcher_func dispatcher, broadcast_list_func broadcast_list_retriever);
 
     /// Listens for incoming socket connections.
-    void StartMessagePump(uint32_t listen_port_host, std::function<void(const std::vector<unsigned char> &, const Peer &)> dispatcher, broadcast_list_func broadcast_list_retriever);
+    void StartMessagePump(uint32_t listen_port_host, dispatcher_func dispatcher, broadcast_list_func broadcast_list_retriever);
 
     /// Multicasts message to specified list of peers.
     void SendMessage(const std::vector<Peer> & peers, const std::vector<unsigned char> & message);
@@ -76,6 +79,9 @@ public:
     /// Sends message to specified peer.
     void SendMessage(const Peer & peer, const std::vector<unsigned char> & message);
 
+    /// Sends message to specified peer without copying the shared buffer.
+    void SendMessage(const Peer & peer, const SharedBuffer & message);
+
     /// Multicasts message of type=broadcast to specified list of peers.
     void SendBroadcastMessage(const std::vector<Peer> & peers, const std::vector<unsigned char> & message);
 
@@ -58,7 +58,7 @@ void Node::StoreDSBlockToDisk(const DSBlock & dsblock)
     // Store DS Block to disk
     vector<unsigned char> serializedDSBlock;
     dsblock.Serialize(serializedDSBlock, 0);
-    BlockStorage::GetBlockStorage().PutDSBlock(dsblock.GetHeader().GetBlockNum(), serializedDSBlock);
+    BlockStorage::GetBlockStorage().PutDSBlock(dsblock.GetHeader().GetBlockNum().convert_to<uint64_t>(), serializedDSBlock);
 }
 
 void Node::UpdateDSCommiteeComposition(const Peer & winnerpeer)
@@ -67,7 +67,7 @@ void Node::UpdateDSCommiteeComposition(const Peer & winnerpeer)
     // 1. Insert new leader at the head of the queue
     // 2. Pop out the oldest backup from the tail of the queue
     // Note: If I am the primary, push a placeholder with ip=0 and port=0 in place of my real port
-    if (m_mediator.m_selfKey.second == m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetMinerPubKey())
+    if (m_mediator.m_selfKey.second == m_mediator.m_dsBlockChain.GetLastBlock()->GetHeader().GetMinerPubKey())
     {
         m_mediator.m_DSCommitteeNetworkInfo.push_front(Peer());
     }
@@ -75,7 +75,7 @@ void Node::UpdateDSCommiteeComposition(const Peer & winnerpeer)
     {
         m_mediator.m_DSCommitteeNetworkInfo.push_front(winnerpeer);
     }
-    m_mediator.m_DSCommitteePubKeys.push_front(m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetMinerPubKey());
+    m_mediator.m_DSCommitteePubKeys.push_front(m_mediator.m_dsBlockChain.GetLastBlock()->GetHeader().GetMinerPubKey());
 
     m_mediator.m_DSCommitteeNetworkInfo.pop_back();
     m_mediator.m_DSCommitteePubKeys.pop_back();
@@ -83,7 +83,7 @@ void Node::UpdateDSCommiteeComposition(const Peer & winnerpeer)
 
 bool Node::CheckWhetherDSBlockNumIsLatest(const uint256_t dsblockNum)
 {
-    // uint256_t latestBlockNumInBlockchain = m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum();
+    // uint256_t latestBlockNumInBlockchain = m_mediator.m_dsBlockChain.GetLastBlock()->GetHeader().GetBlockNum();
     uint256_t latestBlockNumInBlockchain = m_mediator.m_dsBlockChain.GetBlockCount();
 
     if (dsblockNum < latestBlockNumInBlockchain)
@@ -187,7 +187,7 @@ bool Node::ProcessDSBlock(const vector<unsigned char> & message, unsigned int cu
 
 #ifndef IS_LOOKUP_NODE
     // Check if I am the next DS leader
-    if (m_mediator.m_selfKey.second == m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetMinerPubKey())
+    if (m_mediator.m_selfKey.second == m_mediator.m_dsBlockChain.GetLastBlock()->GetHeader().GetMinerPubKey())
     {
         LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "I won PoW1 :-) I am now the new DS committee leader!");
         m_mediator.m_ds->m_consensusMyID = 0;
@@ -205,7 +205,7 @@ bool Node::ProcessDSBlock(const vector<unsigned char> & message, unsigned int cu
 
         // Tell my Node class to start PoW2 if I didn't win PoW1
         array<unsigned char, 32> rand2 = {0};
-        StartPoW2(m_mediator.m_dsBlockChain.GetLastBlock().GetHeader().GetBlockNum(),
+        StartPoW2(m_mediator.m_dsBlockChain.GetLastBlock()->GetHeader().GetBlockNum(),
                                      3, m_mediator.m_dsBlockRand, rand2);
     }
 #endif // IS_LOOKUP_NODE
@@ -14,10 +14,12 @@
 * and which include a reference to GPLv3 in their program files.
 **/
 
+#include <algorithm>
 #include <thread>
 #include <chrono>
 #include <array>
 #include <functional>
+#include <random>
 #include <boost/multiprecision/cpp_int.hpp>
 
 #include "Node.h"
@@ -29,15 +31,22 @@
 #include "depends/libTrie/TrieHash.h"
 #include "depends/libDatabase/MemoryDB.h"
 #include "libConsensus/ConsensusUser.h"
+#include "libCrypto/Schnorr.h"
 #include "libCrypto/Sha2.h"
+#include "libData/DataStructures/IBLT.h"
 #include "libData/AccountData/Account.h"
 #include "libData/AccountData/AccountStore.h"
 #include "libData/AccountData/Transaction.h"
+#include "libData/AccountData/TxnVerifyCache.h"
 #include "libMediator/Mediator.h"
 #include "libPOW/pow.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
+#include "libUtils/Executor.h"
+#include "libUtils/EventLog.h"
 #include "libUtils/Logger.h"
+#include "libUtils/Metrics.h"
+#include "libUtils/ReedSolomon.h"
 #include "libUtils/SanityChecks.h"
 #include "libUtils/TimeLockedFunction.h"
 #include "libUtils/TimeUtils.h"
@@ -83,13 +92,22 @@ bool Node::ReadAuxilliaryInfoFromFinalBlockMsg(const vector<unsigned char> & mes
 void Node::StoreFinalBlock(const TxBlock & txBlock)
 {
     m_mediator.m_txBlockChain.AddBlock(txBlock);
-    m_mediator.m_currentEpochNum = (uint64_t) m_mediator.m_txBlockChain.GetBlockCount();
+    m_mediator.m_currentEpochNum = m_mediator.m_txBlockChain.GetBlockCount();
+    TRACE_EPOCH(m_mediator.m_currentEpochNum);
 
     m_committedTransactions.erase(m_mediator.m_currentEpochNum-2);
 
+    // Signatures verified two epochs ago are no longer needed
+    TxnVerifyCache & verifyCache = TxnVerifyCache::GetInstance();
+    verifyCache.Rotate();
+    LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                 "Txn verify cache: " << verifyCache.GetNumHits() << " hits, " << verifyCache.GetNumMisses() << 
+                 " misses, " << verifyCache.GetNumEarlyRotations() << " early rotations, " << 
+                 verifyCache.GetSize() << " entries")
+
     LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
                  "DEBUG last block has a size of " << 
-                 m_mediator.m_txBlockChain.GetLastBlock().GetSerializedSize())
+                 m_mediator.m_txBlockChain.GetLastBlock()->GetSerializedSize())
     LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
                  "DEBUG cur block has a size of " << txBlock.GetSerializedSize())
     LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
@@ -102,33 +120,34 @@ void Node::StoreFinalBlock(const TxBlock & txBlock)
     // Store Tx Block to disk
     vector<unsigned char> serializedTxBlock;
     txBlock.Serialize(serializedTxBlock, 0);
-    BlockStorage::GetBlockStorage().PutTxBlock(txBlock.GetHeader().GetBlockNum(), 
+    BlockStorage::GetBlockStorage().PutTxBlock(txBlock.GetHeader().GetBlockNum().convert_to<uint64_t>(), 
                                                serializedTxBlock);
 
     LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Final block " << 
-                 m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() <<
+                 m_mediator.m_txBlockChain.GetLastBlock()->GetHeader().GetBlockNum() <<
                  " received with prevhash 0x" <<
                  DataConversion::charArrToHexStr
                  (
-                    m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetPrevHash().asArray()
+                    m_mediator.m_txBlockChain.GetLastBlock()->GetHeader().GetPrevHash().asArray()
                  ));
 
 #ifdef STAT_TEST
-    LOG_STATE("[FINBK][" << std::setw(15) << std::left << 
+    LOG_STATE_TEXT("[FINBK][" << std::setw(15) << std::left << 
               m_mediator.m_selfPeer.GetPrintableIPAddress() << "][" <<
-              m_mediator.m_txBlockChain.GetLastBlock().GetHeader().GetBlockNum() << "] RECV");
+              m_mediator.m_txBlockChain.GetLastBlock()->GetHeader().GetBlockNum() << "] RECV");
+    LOG_EVENT(EVENT_FINBK, PHASE_RECV, m_mediator.m_txBlockChain.GetLastBlock()->GetHeader().GetBlockNum(), 0, 0);
 #endif // STAT_TEST
 }
 
 bool Node::IsMicroBlockTxRootHashInFinalBlock(TxnHash microBlockTxRootHash, 
-                                              const uint256_t & blocknum)
+                                              uint64_t blocknum)
 {
     lock_guard<mutex> g(m_mutexUnavailableMicroBlocks);
     return m_unavailableMicroBlocks[blocknum].erase(microBlockTxRootHash);
 }
 
 void Node::LoadUnavailableMicroBlockTxRootHashes(const TxBlock & finalBlock, 
-                                                 const boost::multiprecision::uint256_t & blocknum)
+                                                 uint64_t blocknum)
 {
     LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(),
                  "Unavailable FinalBlock TxRoot hash : ")
@@ -159,218 +178,234 @@ void Node::LoadUnavailableMicroBlockTxRootHashes(const TxBlock & finalBlock,
 }
 
 #ifndef IS_LOOKUP_NODE
-bool Node::FindTxnInSubmittedTxnsList(const TxBlock & finalblock, const uint256_t & blockNum, 
-                                      uint8_t sharing_mode, vector<Transaction> & txns_to_send, 
-                                      const TxnHash & tx_hash)
+bool Node::CommitTxnFromPool(uint64_t blockNum, uint8_t sharing_mode, 
+                             vector<Transaction> & txns_to_send, const TxnHash & tx_hash)
 {
     LOG_MARKER();
 
-    // boost::multiprecision::uint256_t blockNum = m_mediator.m_txBlockChain.GetBlockCount();
-
-    lock(m_mutexSubmittedTransactions, m_mutexCommittedTransactions);
-    lock_guard<mutex> g(m_mutexSubmittedTransactions, adopt_lock);
-    lock_guard<mutex> g2(m_mutexCommittedTransactions, adopt_lock);
+    Transaction tx;
 
-    auto & submittedTransactions = m_submittedTransactions[blockNum];
-    auto & committedTransactions = m_committedTransactions[blockNum];
-    const auto & txnIt = submittedTransactions.find(tx_hash);
-
-    // Check if transaction is part of submitted Tx list
-    if (txnIt != submittedTransactions.end())
+    // Check if transaction is pending, and take it out of the pool
+    if (!m_txnPool.Commit(tx_hash, tx))
     {
-        if ((sharing_mode == SEND_ONLY) || (sharing_mode == SEND_AND_FORWARD))
+        // Otherwise it was fetched from the leader for this microblock
+        lock_guard<mutex> g(m_mutexMissingMicroBlockTxns);
+
+        auto fetched = m_fetchedMicroBlockTxns.find(tx_hash);
+        if (fetched == m_fetchedMicroBlockTxns.end())
         {
-            txns_to_send.push_back(txnIt->second);
+            return false;
         }
 
-        // Move entry from submitted Tx list to committed Tx list
-        committedTransactions.push_back(txnIt->second);
-        submittedTransactions.erase(txnIt);
-
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "[TXN] [" << blockNum << 
-                     "] Committed     = 0x" << 
-                     DataConversion::charArrToHexStr(committedTransactions.back().GetTranID()
-                                                                                 .asArray()));
-
-        // Update from and to accounts
-        AccountStore::GetInstance().UpdateAccounts(committedTransactions.back());
-
-        // DO NOT DELETE. PERISTENT STORAGE
-        /**
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "##Storing Transaction##");
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), DataConversion::charArrToHexStr(tx_hash));
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), (*entry).GetAmount());
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), DataConversion::charArrToHexStr((*entry).GetToAddr()));
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), DataConversion::charArrToHexStr((*entry).GetFromAddr()));
-        **/
-
-        //LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Storing Transaction: "<< DataConversion::charArrToHexStr(tx_hash) <<
-        //    " with amount: "<<(*entry).GetAmount()<<
-        //    ", to: "<<DataConversion::charArrToHexStr((*entry).GetToAddr())<<
-        //   ", from: "<<DataConversion::charArrToHexStr((*entry).GetFromAddr()));
-
-        // Store TxBody to disk
-        vector<unsigned char> serializedTxBody;
-        committedTransactions.back().Serialize(serializedTxBody, 0);
-        BlockStorage::GetBlockStorage().PutTxBody(tx_hash, serializedTxBody);
-
-        // Move on to next transaction in block
-        return true;
+        tx = fetched->second;
+        m_txnPool.CommitExternal(tx);
     }
+    METRICS_COUNTER("zilliqa_txns_committed_total", "Transactions committed in final blocks").Increment();
 
-    return false;
-}
-
-bool Node::FindTxnInReceivedTxnsList(const TxBlock & finalblock, const uint256_t & blockNum, 
-                                     uint8_t sharing_mode, vector<Transaction> & txns_to_send, 
-                                     const TxnHash & tx_hash)
-{
-    LOG_MARKER();
-
-    lock(m_mutexReceivedTransactions, m_mutexCommittedTransactions);
-    lock_guard<mutex> g(m_mutexReceivedTransactions, adopt_lock);
-    lock_guard<mutex> g2(m_mutexCommittedTransactions, adopt_lock);
-
-    auto & receivedTransactions = m_receivedTransactions[blockNum];
-    auto & committedTransactions = m_committedTransactions[blockNum];
-
-    const auto & txnIt = receivedTransactions.find(tx_hash);
-
-    // Check if transaction is part of received Tx list
-    if (txnIt != receivedTransactions.end())
+    if ((sharing_mode == SEND_ONLY) || (sharing_mode == SEND_AND_FORWARD))
     {
-        if ((sharing_mode == SEND_ONLY) || (sharing_mode == SEND_AND_FORWARD))
-        {
-            txns_to_send.push_back(txnIt->second);
-        }
-
-        // Move entry from received Tx list to committed Tx list
-        committedTransactions.push_back(txnIt->second);
-        receivedTransactions.erase(txnIt);
+        txns_to_send.push_back(tx);
+    }
 
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
-                     "[TXN] [" << blockNum << "] Committed     = 0x" << 
-                     DataConversion::charArrToHexStr(committedTransactions.back().GetTranID()
-                                                                                 .asArray()));
+    lock_guard<mutex> g(m_mutexCommittedTransactions);
+    auto & committedTransactions = m_committedTransactions[blockNum];
 
-        // Update from and to accounts
-        AccountStore::GetInstance().UpdateAccounts(committedTransactions.back());
+    // Move entry from the pool to committed Tx list
+    committedTransactions.push_back(tx);
 
-        /**
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "##Storing Transaction##");
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), DataConversion::charArrToHexStr(tx_hash));
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), (*entry).GetAmount());
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), DataConversion::charArrToHexStr((*entry).GetToAddr()));
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), DataConversion::charArrToHexStr((*entry).GetFromAddr()));
-        **/
+    LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                 "[TXN] [" << blockNum << "] Committed     = 0x" << 
+                 DataConversion::charArrToHexStr(tx_hash.asArray()));
 
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
-                     "ReceivedTransaction: Storing Transaction: " << 
-                     DataConversion::charArrToHexStr(tx_hash.asArray()) <<
-                     " with amount: " << committedTransactions.back().GetAmount() <<
-                     ", to: " << committedTransactions.back().GetToAddr() <<
-                     ", from: " << committedTransactions.back().GetFromAddr());
+    // Update from and to accounts
+    AccountStore::GetInstance().UpdateAccounts(tx);
 
-        // Store TxBody to disk
-        vector<unsigned char> serializedTxBody;
-        committedTransactions.back().Serialize(serializedTxBody, 0);
-        BlockStorage::GetBlockStorage().PutTxBody(tx_hash, serializedTxBody);
+    // Store TxBody to disk
+    vector<unsigned char> serializedTxBody;
+    tx.Serialize(serializedTxBody, 0);
+    BlockStorage::GetBlockStorage().PutTxBody(tx_hash, serializedTxBody);
 
-        // Move on to next transaction in block
-        return true;
-    }
-
-    return false;
+    return true;
 }
 
-void Node::CommitMyShardsMicroBlock(const TxBlock & finalblock, const uint256_t & blocknum, 
+void Node::CommitMyShardsMicroBlock(const TxBlock & finalblock, uint64_t blocknum, 
                                     uint8_t sharing_mode, vector<Transaction> & txns_to_send)
 {
     LOG_MARKER();
 
     // Loop through transactions in block
     const vector<TxnHash> & tx_hashes = m_microblock->GetTranHashes();
+    unsigned int numMissing = 0;
     for (unsigned int i = 0; i < tx_hashes.size(); i++)
     {
         const TxnHash & tx_hash = tx_hashes.at(i);
 
-        if(FindTxnInSubmittedTxnsList(finalblock, blocknum, sharing_mode, txns_to_send, tx_hash))
+        if(!CommitTxnFromPool(blocknum, sharing_mode, txns_to_send, tx_hash))
         {
-            continue;
-        }
-
-        if(!FindTxnInReceivedTxnsList(finalblock, blocknum, sharing_mode, txns_to_send, tx_hash))
-        {
-            // TODO
-            LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(),  "Error: Cannnot find txn in submitted txn and recv list"); 
+            // Pinned and fetched transactions cannot be evicted, so this only happens if neither held it
+            LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(),
+                         "Error: Missing txn in pool: " << tx_hash);
+            numMissing++;
         }
     }
 
-    LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
-                 "Number of transactions to broadcast for block " << 
-                 blocknum << " = " << txns_to_send.size());
+    // Anything still pinned was not committed and may be evicted again
+    m_txnPool.Unpin();
 
     {
-        lock_guard<mutex> g(m_mutexReceivedTransactions);
-        m_receivedTransactions.erase(blocknum);
+        lock_guard<mutex> g(m_mutexMissingMicroBlockTxns);
+        m_fetchedMicroBlockTxns.clear();
     }
+
+    if (numMissing > 0)
     {
-        lock_guard<mutex> g2(m_mutexSubmittedTransactions);
-        m_submittedTransactions.erase(blocknum);
+        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(),
+                     "Error: " << numMissing << " of " << tx_hashes.size() << 
+                     " txns in my microblock could not be committed");
     }
+
+    LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                 "Number of transactions to broadcast for block " << 
+                 blocknum << " = " << txns_to_send.size());
 }
 
-void Node::BroadcastTransactionsToSendingAssignment(const uint256_t & blocknum, 
+void Node::BroadcastTransactionsToSendingAssignment(uint64_t blocknum, 
                                                     const vector<Peer> & sendingAssignment,
                                                     const TxnHash & microBlockTxHash,
-                                                    vector<Transaction> & txns_to_send) const
+                                                    vector<Transaction> & txns_to_send)
 {
     LOG_MARKER();
 
     if (txns_to_send.size() > 0 )
     {
-        // Transaction body sharing
-        unsigned int cur_offset = MessageOffset::BODY;
-        vector<unsigned char> forwardtxn_message = { MessageType::NODE, 
-                                                     NodeInstructionType::FORWARDTRANSACTION };
+        // Bodies are only offered here; each receiver replies with a sketch of what it already holds
+        OfferTransactions(blocknum, sendingAssignment, microBlockTxHash, txns_to_send);
+    }
+    else
+    {
+        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                     "DEBUG I have no txn body to send")
+    }
+}
 
-        // block num
-        Serializable::SetNumber<uint256_t>(forwardtxn_message, cur_offset, blocknum, UINT256_SIZE);
-        cur_offset += UINT256_SIZE;
+void Node::OfferTransactions(uint64_t blocknum, const vector<Peer> & peers,
+                             const TxnHash & microBlockTxHash, const vector<Transaction> & txns)
+{
+    LOG_MARKER();
 
-        forwardtxn_message.resize(cur_offset + TRAN_HASH_SIZE);
+    // Forwarding IDs are keyed by a fresh salt per offer, so a sender cannot grind colliding txns in advance
+    random_device rd;
+    uint64_t salt = (static_cast<uint64_t>(rd()) << 32) | rd();
 
-        // microblock tx hash
-        copy(microBlockTxHash.asArray().begin(), 
-             microBlockTxHash.asArray().end(), 
-             forwardtxn_message.begin() + cur_offset);
-        cur_offset += TRAN_HASH_SIZE;
+    {
+        lock_guard<mutex> g(m_mutexTxnsToForward);
 
-        for (unsigned int i = 0; i < txns_to_send.size(); i++)
+        // Keep offers for the current and previous block only
+        for (auto it = m_txnsToForward.begin(); it != m_txnsToForward.end(); )
         {
-            // txn body
-            txns_to_send.at(i).Serialize(forwardtxn_message, cur_offset);
-            cur_offset += Transaction::GetSerializedSize();
-
-            LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "[TXN] [" << 
-                         blocknum << "] Broadcasted   = 0x" << 
-                         DataConversion::charArrToHexStr(txns_to_send.at(i).GetTranID().asArray()));
+            it = (it->first + 1 < blocknum) ? m_txnsToForward.erase(it) : next(it);
         }
-        
-        P2PComm::GetInstance().SendBroadcastMessage(sendingAssignment, forwardtxn_message);
-        
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
-                     "DEBUG: I have broadcasted the txn body!")
+
+        m_txnsToForward[blocknum][microBlockTxHash] = { salt, txns };
     }
-    else
+
+    // A microblock only holds txns from its own shard, so any one of them names the shard
+    uint32_t shard_id = (txns.empty() || (m_numShards == 0)) ? 0 : 
+                        Transaction::GetShardIndex(txns.front().GetFromAddr(), m_numShards);
+
+    // Message = [32-byte block num] [32-byte microblock tx root] [4-byte num txns] [4-byte listen port]
+    //           [8-byte salt] [4-byte shard id]
+    unsigned int cur_offset = MessageOffset::BODY;
+    vector<unsigned char> offer_message = { MessageType::NODE, NodeInstructionType::FORWARDTXNOFFER };
+
+    Serializable::SetNumber<uint64_t>(offer_message, cur_offset, blocknum, UINT256_SIZE);
+    cur_offset += UINT256_SIZE;
+
+    offer_message.resize(cur_offset + TRAN_HASH_SIZE);
+    copy(microBlockTxHash.asArray().begin(), microBlockTxHash.asArray().end(), 
+         offer_message.begin() + cur_offset);
+    cur_offset += TRAN_HASH_SIZE;
+
+    Serializable::SetNumber<uint32_t>(offer_message, cur_offset, txns.size(), sizeof(uint32_t));
+    cur_offset += sizeof(uint32_t);
+
+    Serializable::SetNumber<uint32_t>(offer_message, cur_offset, m_mediator.m_selfPeer.m_listenPortHost, 
+                                      sizeof(uint32_t));
+    cur_offset += sizeof(uint32_t);
+
+    Serializable::SetNumber<uint64_t>(offer_message, cur_offset, salt, sizeof(uint64_t));
+    cur_offset += sizeof(uint64_t);
+
+    Serializable::SetNumber<uint32_t>(offer_message, cur_offset, shard_id, sizeof(uint32_t));
+    cur_offset += sizeof(uint32_t);
+
+    P2PComm::GetInstance().SendMessage(peers, offer_message);
+
+    LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Offered " << txns.size() << 
+                 " txn bodies for block " << blocknum << " to " << peers.size() << " peers");
+}
+
+void Node::SendForwardedTransactions(uint64_t blocknum, const Peer & peer, 
+                                     const TxnHash & microBlockTxHash, uint64_t salt,
+                                     const vector<Transaction> & txns, const vector<bool> & include)
+{
+    LOG_MARKER();
+
+    // Message = [32-byte block num] [32-byte microblock tx root] [8-byte salt]
+    //           [4-byte num txns] [8-byte forwarding ID] ... [8-byte forwarding ID] 
+    //           [4-byte num bodies] [Transaction] ... [Transaction]
+    // The IDs list the whole microblock in order, keyed by the salt and the root; the bodies are only
+    // those the receiver lacks
+    unsigned int cur_offset = MessageOffset::BODY;
+    vector<unsigned char> forwardtxn_message = { MessageType::NODE, 
+                                                 NodeInstructionType::FORWARDTRANSACTION };
+
+    Serializable::SetNumber<uint64_t>(forwardtxn_message, cur_offset, blocknum, UINT256_SIZE);
+    cur_offset += UINT256_SIZE;
+
+    forwardtxn_message.resize(cur_offset + TRAN_HASH_SIZE);
+    copy(microBlockTxHash.asArray().begin(), microBlockTxHash.asArray().end(), 
+         forwardtxn_message.begin() + cur_offset);
+    cur_offset += TRAN_HASH_SIZE;
+
+    Serializable::SetNumber<uint64_t>(forwardtxn_message, cur_offset, salt, sizeof(uint64_t));
+    cur_offset += sizeof(uint64_t);
+
+    Serializable::SetNumber<uint32_t>(forwardtxn_message, cur_offset, txns.size(), sizeof(uint32_t));
+    cur_offset += sizeof(uint32_t);
+
+    uint32_t num_bodies = 0;
+    for (unsigned int i = 0; i < txns.size(); i++)
     {
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
-                     "DEBUG I have no txn body to send")
+        Serializable::SetNumber<uint64_t>(forwardtxn_message, cur_offset, 
+                                          CompactMicroBlock::ComputeKeyedID(salt, microBlockTxHash, 
+                                                                            txns.at(i).GetTranID()), 
+                                          sizeof(uint64_t));
+        cur_offset += sizeof(uint64_t);
+        num_bodies += include.at(i) ? 1 : 0;
+    }
+
+    Serializable::SetNumber<uint32_t>(forwardtxn_message, cur_offset, num_bodies, sizeof(uint32_t));
+    cur_offset += sizeof(uint32_t);
+
+    forwardtxn_message.resize(cur_offset + num_bodies * Transaction::GetSerializedSize());
+    for (unsigned int i = 0; i < txns.size(); i++)
+    {
+        if (include.at(i))
+        {
+            txns.at(i).Serialize(forwardtxn_message, cur_offset);
+            cur_offset += Transaction::GetSerializedSize();
+        }
     }
+
+    P2PComm::GetInstance().SendMessage(peer, forwardtxn_message);
+
+    LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Sent " << num_bodies << " of " << 
+                 txns.size() << " txn bodies for block " << blocknum << " to " << peer);
 }
 
 void Node::LoadForwardingAssignmentFromFinalBlock(const vector<Peer> & fellowForwarderNodes, 
-                                                  const uint256_t & blocknum)
+                                                  uint64_t blocknum)
 {
     // For now, since each sharding setup only processes one block, then whatever transactions we 
     // failed to submit have to be discarded m_createdTransactions.clear();
@@ -421,7 +456,7 @@ void Node::LoadForwardingAssignmentFromFinalBlock(const vector<Peer> & fellowFor
     }
 }
 
-bool Node::IsMyShardsMicroBlockTxRootHashInFinalBlock(const uint256_t & blocknum)
+bool Node::IsMyShardsMicroBlockTxRootHashInFinalBlock(uint64_t blocknum)
 {
     return m_microblock != nullptr &&
            IsMicroBlockTxRootHashInFinalBlock(m_microblock->GetHeader().GetTxRootHash(), blocknum);
@@ -436,8 +471,8 @@ bool Node::ActOnFinalBlock(uint8_t tx_sharing_mode, const vector<Peer> & nodes)
     // If tx_sharing_mode=NODE_FORWARD_ONLY ==> Body = [num fellow forwarders] [IP and node] ... [IP and node]
     LOG_MARKER();
 
-    const TxBlock finalblock = m_mediator.m_txBlockChain.GetLastBlock();
-    const uint256_t & blocknum = finalblock.GetHeader().GetBlockNum();
+    shared_ptr<const TxBlock> finalblock = m_mediator.m_txBlockChain.GetLastBlock();
+    const uint64_t blocknum = finalblock->GetHeader().GetBlockNum().convert_to<uint64_t>();
 
     vector<Peer> sendingAssignment;
 
@@ -476,7 +511,7 @@ bool Node::ActOnFinalBlock(uint8_t tx_sharing_mode, const vector<Peer> & nodes)
     {
         vector<Transaction> txns_to_send;
         
-        CommitMyShardsMicroBlock(finalblock, blocknum, tx_sharing_mode, txns_to_send);
+        CommitMyShardsMicroBlock(*finalblock, blocknum, tx_sharing_mode, txns_to_send);
 
         if(sendingAssignment.size() > 0)
         {
@@ -504,8 +539,8 @@ bool Node::ActOnFinalBlock(uint8_t tx_sharing_mode, vector<Peer> sendingAssignme
 
     if (tx_sharing_mode == SEND_AND_FORWARD)
     {
-        const TxBlock finalblock = m_mediator.m_txBlockChain.GetLastBlock();
-        const uint256_t & blocknum = finalblock.GetHeader().GetBlockNum();
+        shared_ptr<const TxBlock> finalblock = m_mediator.m_txBlockChain.GetLastBlock();
+        const uint64_t blocknum = finalblock->GetHeader().GetBlockNum().convert_to<uint64_t>();
 
         LoadForwardingAssignmentFromFinalBlock(fellowForwarderNodes, blocknum);
 
@@ -515,7 +550,7 @@ bool Node::ActOnFinalBlock(uint8_t tx_sharing_mode, vector<Peer> sendingAssignme
         {
             vector<Transaction> txns_to_send;
 
-            CommitMyShardsMicroBlock(finalblock, blocknum, tx_sharing_mode, txns_to_send);
+            CommitMyShardsMicroBlock(*finalblock, blocknum, tx_sharing_mode, txns_to_send);
 
             if(sendingAssignment.size() > 0)
             {
@@ -544,7 +579,7 @@ void Node::InitiatePoW1()
     m_consensusLeaderID = 0; 
 
     SetState(POW1_SUBMISSION);
-    POW::GetInstance().EthashConfigureLightClient((uint64_t)m_mediator.m_dsBlockChain.GetBlockCount()); // hack hack hack -- typecasting
+    POW::GetInstance().EthashConfigureLightClient(m_mediator.m_dsBlockChain.GetBlockCount());
     LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Start pow1 ");
     auto func = [this]() mutable -> void
     {
@@ -596,25 +631,25 @@ void Node::ScheduleTxnSubmission()
     auto main_func = [this]() mutable -> void { SubmitTransactions(); };
     DetachedFunction(1, main_func);
 
-    LOG_MESSAGE("I am going to sleep for " << SUBMIT_TX_WINDOW << " seconds");
-    this_thread::sleep_for(chrono::seconds(SUBMIT_TX_WINDOW));
-    LOG_MESSAGE("I have woken up from the sleep of " << SUBMIT_TX_WINDOW << " seconds");
+    LOG_MESSAGE("Accepting transactions for " << SUBMIT_TX_WINDOW << " seconds");
 
     auto main_func2 = [this]() mutable -> void { 
         unique_lock<shared_timed_mutex> lock(m_mutexProducerConsumer);
         SetState(TX_SUBMISSION_BUFFER); 
     };   
-    DetachedFunction(1, main_func2); 
+    m_txnSubmissionTimer.Cancel();
+    m_txnSubmissionTimer = Executor::GetInstance().PostBlockingAfter(chrono::seconds(SUBMIT_TX_WINDOW), main_func2);
 }
 
 void Node::ScheduleMicroBlockConsensus()
 {
-    LOG_MESSAGE("I am going to sleep for " << SUBMIT_TX_WINDOW_EXTENDED << " seconds");
-    this_thread::sleep_for(chrono::seconds(SUBMIT_TX_WINDOW_EXTENDED));
-    LOG_MESSAGE("I have woken up from the sleep of " << SUBMIT_TX_WINDOW_EXTENDED << " seconds");
+    // The extended window starts once the submission window closes
+    LOG_MESSAGE("Starting microblock consensus in " << SUBMIT_TX_WINDOW + SUBMIT_TX_WINDOW_EXTENDED << " seconds");
 
     auto main_func3 = [this]() mutable -> void { RunConsensusOnMicroBlock(); };
-    DetachedFunction(1, main_func3);
+    m_microBlockConsensusTimer.Cancel();
+    m_microBlockConsensusTimer = Executor::GetInstance().PostBlockingAfter(
+        chrono::seconds(SUBMIT_TX_WINDOW + SUBMIT_TX_WINDOW_EXTENDED), main_func3);
 }
 
 void Node::BeginNextConsensusRound()
@@ -882,25 +917,22 @@ bool Node::ProcessFinalBlock(const vector<unsigned char> & message, unsigned int
 {
     // Message = [32-byte DS blocknum] [4-byte consensusid] [1-byte shard id] 
     //           [Final block] [Tx body sharing setup]
-    LOG_MARKER();
+    TRACE_MARKER();
 
 #ifndef IS_LOOKUP_NODE
-    if(m_state == MICROBLOCK_CONSENSUS)
+    if ((m_state == MICROBLOCK_CONSENSUS) || (m_state == WAITING_FINALBLOCK))
     {
-        unsigned int time_pass = 0;
-        while(m_state != PROCESS_FINALBLOCK)
+        auto replay = [this, message, offset, from]() -> void { ProcessFinalBlock(message, offset, from); };
+        if (m_stateNotifier.ParkUntil(WAITING_FINALBLOCK, replay, chrono::seconds(PARKED_MESSAGE_TIMEOUT_IN_SECONDS)))
         {
-            time_pass++;
-            if (time_pass % 10)
-            {
-                LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), string("Waiting ") +
-                             "for state change from MICROBLOCK_CONSENSUS to PROCESS_FINALBLOCK");
-            }
-            this_thread::sleep_for(chrono::milliseconds(100));
+            LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), string("Parked ") +
+                         "until state change from MICROBLOCK_CONSENSUS to WAITING_FINALBLOCK");
+            return true;
         }
     }
+
     // Checks if (m_state != WAITING_FINALBLOCK)
-    else if (!CheckState(PROCESS_FINALBLOCK))
+    if (!CheckState(PROCESS_FINALBLOCK))
     {
         LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
                      "Too late - current state is " << m_state << ".");
@@ -923,17 +955,19 @@ bool Node::ProcessFinalBlock(const vector<unsigned char> & message, unsigned int
 
     LogReceivedFinalBlockDetails(txBlock);
 
-    LOG_STATE("[TXBOD][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "][" << txBlock.GetHeader().GetBlockNum() << "] FRST");
+    LOG_STATE_TEXT("[TXBOD][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "][" << txBlock.GetHeader().GetBlockNum() << "] FRST");
+    LOG_EVENT(EVENT_TXBOD, PHASE_FRST, txBlock.GetHeader().GetBlockNum(), 0, 0);
 
 // #ifdef IS_LOOKUP_NODE
-    LoadUnavailableMicroBlockTxRootHashes(txBlock, txBlock.GetHeader().GetBlockNum());
+    LoadUnavailableMicroBlockTxRootHashes(txBlock, txBlock.GetHeader().GetBlockNum().convert_to<uint64_t>());
 // #endif // IS_LOOKUP_NODE    
 
     StoreFinalBlock(txBlock);
 
     if (txBlock.GetHeader().GetNumMicroBlockHashes() == 1)
     {
-        LOG_STATE("[TXBOD][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "][" << txBlock.GetHeader().GetBlockNum() << "] LAST");
+        LOG_STATE_TEXT("[TXBOD][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "][" << txBlock.GetHeader().GetBlockNum() << "] LAST");
+        LOG_EVENT(EVENT_TXBOD, PHASE_LAST, txBlock.GetHeader().GetBlockNum(), 0, 0);
     }
 
     // Assumption: New PoW1 done after every block committed
@@ -977,10 +1011,241 @@ bool Node::ProcessFinalBlock(const vector<unsigned char> & message, unsigned int
     return true;
 }
 
+bool Node::ProcessFinalBlockFragment(const vector<unsigned char> & message, unsigned int offset, 
+                                     const Peer & from)
+{
+    // Message = [32-byte FINALBLOCK message hash] [4-byte FINALBLOCK message length] [1-byte k]
+    //           [1-byte n] [1-byte fragment index] [33-byte DS pubkey] [fragment] [64-byte signature]
+    // Fragments come from the DS cluster and from fellow shard members, signed by the DS node that
+    // encoded them. Any k distinct fragments rebuild the FINALBLOCK message, which is then processed
+    // as if it had arrived whole.
+
+#ifndef IS_LOOKUP_NODE
+    LOG_MARKER();
+
+    const unsigned int hash_size = BLOCK_HASH_SIZE;
+    const unsigned int signature_size = SIGNATURE_CHALLENGE_SIZE + SIGNATURE_RESPONSE_SIZE;
+
+    if (IsMessageSizeInappropriate(message.size(), offset, FINALBLOCK_FRAGMENT_HEADER_SIZE + signature_size))
+    {
+        return false;
+    }
+
+    unsigned int cur_offset = offset;
+
+    vector<unsigned char> message_hash(message.begin() + cur_offset, 
+                                       message.begin() + cur_offset + hash_size);
+    cur_offset += hash_size;
+
+    uint32_t length = Serializable::GetNumber<uint32_t>(message, cur_offset, sizeof(uint32_t));
+    cur_offset += sizeof(uint32_t);
+
+    uint8_t k = Serializable::GetNumber<uint8_t>(message, cur_offset, sizeof(uint8_t));
+    cur_offset += sizeof(uint8_t);
+
+    uint8_t n = Serializable::GetNumber<uint8_t>(message, cur_offset, sizeof(uint8_t));
+    cur_offset += sizeof(uint8_t);
+
+    uint8_t index = Serializable::GetNumber<uint8_t>(message, cur_offset, sizeof(uint8_t));
+    cur_offset += sizeof(uint8_t);
+
+    PubKey signer(message, cur_offset);
+    cur_offset += PUB_KEY_SIZE;
+
+    // The coding follows from the shard size, the same way the DS nodes pick it
+    const unsigned int expected_n = min<unsigned int>(m_myShardMembersNetworkInfo.size(), ReedSolomon::MAX_FRAGMENTS);
+    const unsigned int expected_k = max<unsigned int>(1, expected_n / FINALBLOCK_FRAGMENT_REDUNDANCY);
+
+    if ((k != expected_k) || (n != expected_n) || (index >= n) || 
+        (message.size() - cur_offset - signature_size != ReedSolomon::GetFragmentSize(length, k)))
+    {
+        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                     "Error: Malformed final block fragment " << (unsigned int)index << 
+                     " (k = " << (unsigned int)k << ", n = " << (unsigned int)n << ")");
+        return false;
+    }
+
+    const unsigned int fragment_end = message.size() - signature_size;
+
+    if (find(m_mediator.m_DSCommitteePubKeys.begin(), m_mediator.m_DSCommitteePubKeys.end(), signer) == 
+        m_mediator.m_DSCommitteePubKeys.end())
+    {
+        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                     "Error: Final block fragment " << (unsigned int)index << " not signed by a DS node");
+        return false;
+    }
+
+    Signature signature(message, fragment_end);
+    if (!Schnorr::GetInstance().Verify(message, offset, fragment_end - offset, signature, signer))
+    {
+        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                     "Error: Invalid signature on final block fragment " << (unsigned int)index);
+        return false;
+    }
+
+    bool relay = false;
+    vector<unsigned char> finalblock_message;
+
+    {
+        lock_guard<mutex> g(m_mutexFinalBlockFragments);
+
+        if (message_hash == m_lastRebuiltFinalBlockHash)
+        {
+            return true;
+        }
+
+        // Fragments of final blocks from earlier epochs can never complete now
+        const uint64_t epoch = m_mediator.m_currentEpochNum;
+        for (auto stale = m_finalBlockFragments.begin(); stale != m_finalBlockFragments.end(); )
+        {
+            if (stale->second.m_epoch < epoch)
+            {
+                stale = m_finalBlockFragments.erase(stale);
+            }
+            else
+            {
+                stale++;
+            }
+        }
+
+        auto it = m_finalBlockFragments.find(message_hash);
+        if (it == m_finalBlockFragments.end())
+        {
+            // Every DS node encodes the same message, so an honest one never needs a second entry per epoch
+            for (const auto & pending : m_finalBlockFragments)
+            {
+                if (pending.second.m_creator == signer)
+                {
+                    LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                                 "Error: DS node already has a different final block pending this epoch");
+                    return false;
+                }
+            }
+
+            it = m_finalBlockFragments.emplace(message_hash, FinalBlockFragments{false, epoch, signer, {}}).first;
+        }
+
+        FinalBlockFragments & entry = it->second;
+
+        // A signer contributes one fragment per index, whatever length it announces with it
+        for (const auto & group : entry.m_fragments)
+        {
+            if (group.second.count(make_pair((unsigned int)index, signer)) > 0)
+            {
+                return true;
+            }
+        }
+
+        // Member i is the first holder of fragment i, so it relays that fragment to the shard
+        if ((index == m_consensusMyID) && !entry.m_relayed)
+        {
+            entry.m_relayed = true;
+            relay = true;
+        }
+
+        auto & fragments = entry.m_fragments[length];
+        fragments.emplace(make_pair((unsigned int)index, signer), 
+                          vector<unsigned char>(message.begin() + cur_offset, message.begin() + fragment_end));
+
+        // Picks one copy of each index, skipping those by the excluded signer if there is one
+        auto pick = [&fragments](const PubKey * excluded) -> map<unsigned int, vector<unsigned char>>
+        {
+            map<unsigned int, vector<unsigned char>> picked;
+            for (const auto & fragment : fragments)
+            {
+                if ((excluded == nullptr) || !(fragment.first.second == *excluded))
+                {
+                    picked.emplace(fragment.first.first, fragment.second);
+                }
+            }
+            return picked;
+        };
+
+        map<unsigned int, vector<unsigned char>> distinct = pick(nullptr);
+        if (distinct.size() >= k)
+        {
+            auto rebuild = [k, n, length, &message_hash](const map<unsigned int, vector<unsigned char>> & picked, 
+                                                         vector<unsigned char> & dst) -> bool
+            {
+                if (!ReedSolomon::Decode(picked, k, n, length, dst))
+                {
+                    return false;
+                }
+
+                SHA2<HASH_TYPE::HASH_VARIANT_256> sha256;
+                sha256.Update(dst);
+                return (sha256.Finalize() == message_hash) && (dst.size() > MessageOffset::BODY) &&
+                       (dst.at(MessageOffset::INST) == NodeInstructionType::FINALBLOCK);
+            };
+
+            bool rebuilt = rebuild(distinct, finalblock_message);
+
+            if (!rebuilt)
+            {
+                // Every fragment carries a valid DS signature, so a bad one came from a faulty DS node -
+                // leave out the fragments of one signer at a time, taking other signers' copies instead
+                set<PubKey> signers;
+                for (const auto & fragment : fragments)
+                {
+                    signers.insert(fragment.first.second);
+                }
+
+                for (auto suspect = signers.begin(); !rebuilt && (signers.size() > 1) && (suspect != signers.end()); suspect++)
+                {
+                    map<unsigned int, vector<unsigned char>> others = pick(&*suspect);
+                    rebuilt = (others.size() >= k) && rebuild(others, finalblock_message);
+                }
+            }
+
+            if (rebuilt)
+            {
+                // Fragments of older final blocks can never complete now
+                m_lastRebuiltFinalBlockHash = message_hash;
+                m_finalBlockFragments.clear();
+            }
+            else
+            {
+                // Keep what arrived - more fragments may yet outvote the bad ones
+                LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                             "Error: Final block rebuilt from " << fragments.size() << 
+                             " fragments does not match its hash");
+                finalblock_message.clear();
+            }
+        }
+    }
+
+    if (relay)
+    {
+        BroadcastToMyShard(message);
+    }
+
+    if (!finalblock_message.empty())
+    {
+        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                     "Rebuilt final block from " << (unsigned int)k << " of " << (unsigned int)n << 
+                     " fragments");
+        return ProcessFinalBlock(finalblock_message, MessageOffset::BODY, from);
+    }
+#endif // IS_LOOKUP_NODE
+
+    return true;
+}
+
+bool Node::IsMicroBlockTxRootHashUnavailable(const TxnHash & microBlockTxHash, uint64_t blocknum)
+{
+    lock_guard<mutex> g(m_mutexUnavailableMicroBlocks);
+    auto it = m_unavailableMicroBlocks.find(blocknum);
+    return (it != m_unavailableMicroBlocks.end()) && (it->second.count(microBlockTxHash) > 0);
+}
+
 bool Node::LoadForwardedTxnsAndCheckRoot(const vector<unsigned char> & message,
-                                         unsigned int cur_offset, TxnHash & microBlockTxHash,
+                                         unsigned int cur_offset, uint64_t blocknum,
+                                         TxnHash & microBlockTxHash,
                                          vector<Transaction> & txnsInForwardedMessage)
 {
+    // Merges the bodies in the message with those received earlier for the same microblock.
+    // Returns true once the whole microblock is present and its txn root checks out.
+
     LOG_MARKER();
 
     copy(message.begin() + cur_offset, message.begin() + cur_offset + TRAN_HASH_SIZE, 
@@ -989,28 +1254,79 @@ bool Node::LoadForwardedTxnsAndCheckRoot(const vector<unsigned char> & message,
     LOG_MESSAGE("Received MicroBlock TxHash root : " << 
                 DataConversion::charArrToHexStr(microBlockTxHash.asArray()));
 
-    vector<TxnHash> txnHashesInForwardedMessage;
+    uint64_t salt = Serializable::GetNumber<uint64_t>(message, cur_offset, sizeof(uint64_t));
+    cur_offset += sizeof(uint64_t);
+
+    uint32_t num_txns = Serializable::GetNumber<uint32_t>(message, cur_offset, sizeof(uint32_t));
+    cur_offset += sizeof(uint32_t);
 
-    const unsigned int length_needed_per_txn = Transaction::GetSerializedSize();
-    while(cur_offset + length_needed_per_txn <= message.size())
+    if (message.size() < cur_offset + num_txns * sizeof(uint64_t) + sizeof(uint32_t))
+    {
+        LOG_MESSAGE("Error: Forwarded txns message too short for " << num_txns << " IDs");
+        return false;
+    }
+
+    vector<uint64_t> ids;
+    ids.reserve(num_txns);
+    for (unsigned int i = 0; i < num_txns; i++)
+    {
+        ids.push_back(Serializable::GetNumber<uint64_t>(message, cur_offset, sizeof(uint64_t)));
+        cur_offset += sizeof(uint64_t);
+    }
+
+    uint32_t num_bodies = Serializable::GetNumber<uint32_t>(message, cur_offset, sizeof(uint32_t));
+    cur_offset += sizeof(uint32_t);
+
+    if (IsMessageSizeInappropriate(message.size(), cur_offset, num_bodies * Transaction::GetSerializedSize()))
+    {
+        return false;
+    }
+
+    vector<Transaction> bodies;
+    bodies.reserve(num_bodies);
+    for (unsigned int i = 0; i < num_bodies; i++)
     {
         // reading [Transaction] from received msg
-        Transaction tx(message, cur_offset);
+        bodies.emplace_back(message, cur_offset);
         cur_offset += Transaction::GetSerializedSize();
+    }
 
-        txnsInForwardedMessage.push_back(tx);
-        txnHashesInForwardedMessage.push_back(tx.GetTranID());
+    lock_guard<mutex> g(m_mutexPartialForwardedTxns);
 
-        LOG_MESSAGE("Received forwarded transaction : " << tx.GetTranID());
+    for (auto it = m_partialForwardedTxns.begin(); it != m_partialForwardedTxns.end(); )
+    {
+        it = (it->first + 1 < blocknum) ? m_partialForwardedTxns.erase(it) : next(it);
     }
 
-    return ComputeTransactionsRoot(txnHashesInForwardedMessage) == microBlockTxHash;
+    auto & microblocks = m_partialForwardedTxns[blocknum];
+    auto & held = microblocks.emplace(microBlockTxHash, ForwardedTxnSet(microBlockTxHash)).first->second;
+
+    // Only bodies that pass the stateless checks are held, so a forged body cannot take a real one's place
+    unsigned int num_added = held.Add(bodies);
+    LOG_MESSAGE("Received " << num_bodies << " forwarded txns, " << num_added << " new and valid");
+
+    switch (held.Assemble(salt, ids, txnsInForwardedMessage))
+    {
+    case ForwardedTxnSet::INCOMPLETE:
+        LOG_MESSAGE("Holding " << held.GetSize() << " of " << ids.size() << " forwarded txns -- waiting for the rest");
+        return false;
+    case ForwardedTxnSet::MISMATCH:
+        LOG_MESSAGE("Error: Forwarded txns do not match microblock txn root -- discarding");
+        microblocks.erase(microBlockTxHash);
+        return false;
+    case ForwardedTxnSet::COMPLETE:
+        break;
+    }
+
+    microblocks.erase(microBlockTxHash);
+
+    return true;
 }
 
 void Node::CommitForwardedTransactions(const vector<Transaction> & txnsInForwardedMessage, 
-                                       const uint256_t & blocknum)
+                                       uint64_t blocknum)
 {
-    LOG_MARKER();
+    TRACE_MARKER();
 
     unsigned int txn_counter = 0;
     for(const auto & tx : txnsInForwardedMessage)
@@ -1021,6 +1337,9 @@ void Node::CommitForwardedTransactions(const vector<Transaction> & txnsInForward
             AccountStore::GetInstance().UpdateAccounts(tx);
         }
 
+        // The body may have come from the pool, which must not offer it again
+        m_txnPool.CommitExternal(tx);
+
         LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
                      "[TXN] [" << blocknum << 
                      "] Body received = 0x" << tx.GetTranID());
@@ -1049,7 +1368,7 @@ void Node::CommitForwardedTransactions(const vector<Transaction> & txnsInForward
 }
 
 #ifndef IS_LOOKUP_NODE
-void Node::LoadFwdingAssgnForThisBlockNum(const uint256_t & blocknum, vector<Peer> & forward_list)
+void Node::LoadFwdingAssgnForThisBlockNum(uint64_t blocknum, vector<Peer> & forward_list)
 {
     LOG_MARKER();
 
@@ -1062,7 +1381,7 @@ void Node::LoadFwdingAssgnForThisBlockNum(const uint256_t & blocknum, vector<Pee
 }
 #endif // IS_LOOKUP_NODE
 
-void Node::DeleteEntryFromFwdingAssgnAndMissingBodyCountMap(const uint256_t & blocknum)
+void Node::DeleteEntryFromFwdingAssgnAndMissingBodyCountMap(uint64_t blocknum)
 {
     LOG_MARKER();
 
@@ -1083,20 +1402,224 @@ void Node::DeleteEntryFromFwdingAssgnAndMissingBodyCountMap(const uint256_t & bl
         m_forwardingAssignment.erase(blocknum);
 #endif // IS_LOOKUP_NODE
 
-        LOG_STATE("[TXBOD][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "][" << blocknum << "] LAST");
+        LOG_STATE_TEXT("[TXBOD][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "][" << blocknum << "] LAST");
+        LOG_EVENT(EVENT_TXBOD, PHASE_LAST, blocknum, 0, 0);
     }
 }
 
+bool Node::ProcessForwardTxnOffer(const vector<unsigned char> & message, unsigned int offset, 
+                                  const Peer & from)
+{
+    // Message = [32-byte block num] [32-byte microblock tx root] [4-byte num txns] [4-byte listen port]
+    //           [8-byte salt] [4-byte shard id]
+    // Replies with a sketch of the bodies already held, so the sender only transmits the difference
+
+    LOG_MARKER();
+
+    if (IsMessageSizeInappropriate(message.size(), offset, 
+                                   UINT256_SIZE + TRAN_HASH_SIZE + sizeof(uint32_t) + sizeof(uint32_t) + 
+                                   sizeof(uint64_t) + sizeof(uint32_t)))
+    {
+        return false;
+    }
+
+    unsigned int cur_offset = offset;
+
+    uint64_t blocknum = Serializable::GetNumber<uint64_t>(message, cur_offset, UINT256_SIZE);
+    cur_offset += UINT256_SIZE;
+
+    TxnHash microBlockTxHash;
+    copy(message.begin() + cur_offset, message.begin() + cur_offset + TRAN_HASH_SIZE, 
+         microBlockTxHash.asArray().begin());
+    cur_offset += TRAN_HASH_SIZE;
+
+    uint32_t num_txns = Serializable::GetNumber<uint32_t>(message, cur_offset, sizeof(uint32_t));
+    cur_offset += sizeof(uint32_t);
+
+    uint32_t listenPort = Serializable::GetNumber<uint32_t>(message, cur_offset, sizeof(uint32_t));
+    cur_offset += sizeof(uint32_t);
+
+    uint64_t salt = Serializable::GetNumber<uint64_t>(message, cur_offset, sizeof(uint64_t));
+    cur_offset += sizeof(uint64_t);
+
+    uint32_t shard_id = Serializable::GetNumber<uint32_t>(message, cur_offset, sizeof(uint32_t));
+    cur_offset += sizeof(uint32_t);
+
+    // The count sizes the sketch, so an unbounded one from the peer would size our allocation
+    if (num_txns > MAX_TXNS_PER_MICROBLOCK)
+    {
+        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                     "Offer of " << num_txns << " txns exceeds " << MAX_TXNS_PER_MICROBLOCK << " per microblock");
+        return false;
+    }
+
+    if (!IsMicroBlockTxRootHashUnavailable(microBlockTxHash, blocknum))
+    {
+        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                     "Offered txns for block " << blocknum << " already held or not expected");
+        return true;
+    }
+
+    bool known = false;
+    {
+        lock_guard<mutex> g(m_mutexPartialForwardedTxns);
+        auto block = m_partialForwardedTxns.find(blocknum);
+        known = (block != m_partialForwardedTxns.end()) && (block->second.count(microBlockTxHash) > 0);
+    }
+
+    // On first sight of the microblock, pending txns from its shard are likely in it already
+    vector<Transaction> candidates;
+    if (!known)
+    {
+        m_txnPool.GetFromShard(m_numShards, shard_id, candidates);
+    }
+
+    IBLT sketch;
+    {
+        lock_guard<mutex> g(m_mutexPartialForwardedTxns);
+
+        for (auto it = m_partialForwardedTxns.begin(); it != m_partialForwardedTxns.end(); )
+        {
+            it = (it->first + 1 < blocknum) ? m_partialForwardedTxns.erase(it) : next(it);
+        }
+
+        auto & held = m_partialForwardedTxns[blocknum].emplace(microBlockTxHash, 
+                                                                ForwardedTxnSet(microBlockTxHash)).first->second;
+        unsigned int num_seeded = held.AddCandidates(candidates);
+        sketch = held.GetSketch(salt, num_txns);
+
+        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                     "Sketch for " << num_txns << " offered txns: " << held.GetSize() << " held (" << num_seeded << 
+                     " from pool), " << sketch.GetNumCells() << " cells");
+    }
+
+    // Message = [32-byte block num] [32-byte microblock tx root] [4-byte listen port] [8-byte salt] [IBLT]
+    vector<unsigned char> sketch_message = { MessageType::NODE, NodeInstructionType::FORWARDTXNSKETCH };
+    cur_offset = MessageOffset::BODY;
+
+    Serializable::SetNumber<uint64_t>(sketch_message, cur_offset, blocknum, UINT256_SIZE);
+    cur_offset += UINT256_SIZE;
+
+    sketch_message.resize(cur_offset + TRAN_HASH_SIZE);
+    copy(microBlockTxHash.asArray().begin(), microBlockTxHash.asArray().end(), 
+         sketch_message.begin() + cur_offset);
+    cur_offset += TRAN_HASH_SIZE;
+
+    Serializable::SetNumber<uint32_t>(sketch_message, cur_offset, m_mediator.m_selfPeer.m_listenPortHost, 
+                                      sizeof(uint32_t));
+    cur_offset += sizeof(uint32_t);
+
+    Serializable::SetNumber<uint64_t>(sketch_message, cur_offset, salt, sizeof(uint64_t));
+    cur_offset += sizeof(uint64_t);
+
+    sketch.Serialize(sketch_message, cur_offset);
+
+    P2PComm::GetInstance().SendMessage(Peer(from.m_ipAddress, listenPort), sketch_message);
+
+    return true;
+}
+
+bool Node::ProcessForwardTxnSketch(const vector<unsigned char> & message, unsigned int offset, 
+                                   const Peer & from)
+{
+    // Message = [32-byte block num] [32-byte microblock tx root] [4-byte listen port] [8-byte salt] [IBLT]
+    // An IBLT with no cells asks for every body
+
+#ifndef IS_LOOKUP_NODE
+    LOG_MARKER();
+
+    if (IsMessageSizeInappropriate(message.size(), offset, 
+                                   UINT256_SIZE + TRAN_HASH_SIZE + sizeof(uint32_t) + sizeof(uint64_t) + 
+                                   sizeof(uint32_t)))
+    {
+        return false;
+    }
+
+    unsigned int cur_offset = offset;
+
+    uint64_t blocknum = Serializable::GetNumber<uint64_t>(message, cur_offset, UINT256_SIZE);
+    cur_offset += UINT256_SIZE;
+
+    TxnHash microBlockTxHash;
+    copy(message.begin() + cur_offset, message.begin() + cur_offset + TRAN_HASH_SIZE, 
+         microBlockTxHash.asArray().begin());
+    cur_offset += TRAN_HASH_SIZE;
+
+    uint32_t listenPort = Serializable::GetNumber<uint32_t>(message, cur_offset, sizeof(uint32_t));
+    cur_offset += sizeof(uint32_t);
+
+    uint64_t salt = Serializable::GetNumber<uint64_t>(message, cur_offset, sizeof(uint64_t));
+    cur_offset += sizeof(uint64_t);
+
+    IBLT theirs(message, cur_offset);
+
+    TxnsToForward offer;
+    {
+        lock_guard<mutex> g(m_mutexTxnsToForward);
+        auto block = m_txnsToForward.find(blocknum);
+        if (block == m_txnsToForward.end() || block->second.count(microBlockTxHash) == 0)
+        {
+            LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                         "Sketch received for txns I did not offer");
+            return false;
+        }
+        offer = block->second.at(microBlockTxHash);
+    }
+
+    const vector<Transaction> & txns = offer.m_txns;
+    vector<bool> include(txns.size(), true);
+
+    // A sketch keyed by the salt of an earlier offer cannot be compared, so every body is sent
+    if ((theirs.GetNumCells() > 0) && (salt == offer.m_salt))
+    {
+        IBLT mine(theirs.GetNumCells());
+        for (const auto & tx : txns)
+        {
+            mine.Insert(CompactMicroBlock::ComputeKeyedID(salt, microBlockTxHash, tx.GetTranID()));
+        }
+        mine.Subtract(theirs);
+
+        vector<uint64_t> onlyMine;
+        vector<uint64_t> onlyTheirs;
+        if (mine.Decode(onlyMine, onlyTheirs))
+        {
+            unordered_set<uint64_t> missing(onlyMine.begin(), onlyMine.end());
+            for (unsigned int i = 0; i < txns.size(); i++)
+            {
+                include.at(i) = (missing.count(CompactMicroBlock::ComputeKeyedID(salt, microBlockTxHash, 
+                                                                                 txns.at(i).GetTranID())) > 0);
+            }
+        }
+        else
+        {
+            LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                         "Sketch with " << theirs.GetNumCells() << " cells did not decode -- sending all bodies");
+        }
+    }
+
+    SendForwardedTransactions(blocknum, Peer(from.m_ipAddress, listenPort), microBlockTxHash, offer.m_salt, 
+                              txns, include);
+#endif // IS_LOOKUP_NODE
+    return true;
+}
+
 bool Node::ProcessForwardTransaction(const vector<unsigned char> & message, unsigned int cur_offset, 
                                      const Peer & from)
 {
-    // Message = [block number] [Transaction] [Transaction] [Transaction] ....
-    // Received from other shards
+    // Message = [block number] [microblock tx root] [salt] [num txns] [forwarding ID] ... [forwarding ID]
+    //           [num bodies] [Transaction] ... [Transaction]
+    // Received from other shards, in reply to this node's sketch
 
     LOG_MARKER();
 
+    if (IsMessageSizeInappropriate(message.size(), cur_offset, 
+                                   UINT256_SIZE + TRAN_HASH_SIZE + sizeof(uint64_t) + sizeof(uint32_t)))
+    {
+        return false;
+    }
+
     // reading [block number] from received msg
-    uint256_t blocknum = Serializable::GetNumber<uint256_t>(message, cur_offset, UINT256_SIZE);
+    uint64_t blocknum = Serializable::GetNumber<uint64_t>(message, cur_offset, UINT256_SIZE);
     cur_offset += UINT256_SIZE;
 
     LOG_MESSAGE("Received forwarded txns for block number " << blocknum);
@@ -1104,7 +1627,7 @@ bool Node::ProcessForwardTransaction(const vector<unsigned char> & message, unsi
     TxnHash microBlockTxRootHash;
     vector<Transaction> txnsInForwardedMessage;
 
-    if (!LoadForwardedTxnsAndCheckRoot(message, cur_offset, microBlockTxRootHash, 
+    if (!LoadForwardedTxnsAndCheckRoot(message, cur_offset, blocknum, microBlockTxRootHash, 
                                        txnsInForwardedMessage))
     {   
         return false;
@@ -1114,7 +1637,8 @@ bool Node::ProcessForwardTransaction(const vector<unsigned char> & message, unsi
     {
         return false;
     }
-  
+
+    // The root pins the tran IDs but not the signatures; those were checked as the bodies were held
     CommitForwardedTransactions(txnsInForwardedMessage, blocknum);
 
 #ifndef IS_LOOKUP_NODE
@@ -1127,11 +1651,9 @@ bool Node::ProcessForwardTransaction(const vector<unsigned char> & message, unsi
 #ifndef IS_LOOKUP_NODE
     if (forward_list.size() > 0)
     {
-        P2PComm::GetInstance().SendBroadcastMessage(forward_list, message);
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
-                     "DEBUG I have broadcasted the txn body!")
+        OfferTransactions(blocknum, forward_list, microBlockTxRootHash, txnsInForwardedMessage);
     }
 #endif // IS_LOOKUP_NODE
 
     return true;
-}
\ No newline at end of file
+}
@@ -17,6 +17,7 @@
 #include <array>
 #include <chrono>
 #include <functional>
+#include <random>
 #include <thread>
 
 #include <boost/multiprecision/cpp_int.hpp>
@@ -34,10 +35,12 @@
 #include "libData/AccountData/Account.h"
 #include "libData/AccountData/AccountStore.h"
 #include "libData/AccountData/Transaction.h"
+#include "libData/AccountData/TxnVerifier.h"
 #include "libMediator/Mediator.h"
 #include "libPOW/pow.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
+#include "libUtils/EventLog.h"
 #include "libUtils/Logger.h"
 #include "libUtils/SanityChecks.h"
 #include "libUtils/TimeLockedFunction.h"
@@ -71,8 +74,9 @@ void Node::ProcessMicroblockConsensusIfPrimary() const
     m_microblock->Serialize(microblock, cur_offset);
 
 #ifdef STAT_TEST
-    LOG_STATE("[MICRO][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << 
+    LOG_STATE_TEXT("[MICRO][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << 
               "][" << m_mediator.m_currentEpochNum << "] SENT");
+    LOG_EVENT(EVENT_MICRO, PHASE_SENT, m_mediator.m_currentEpochNum, m_myShardID, 0);
 #endif // STAT_TEST
     P2PComm::GetInstance().SendMessage(m_mediator.m_DSCommitteeNetworkInfo, microblock);
 }
@@ -87,27 +91,25 @@ bool Node::ProcessMicroblockConsensus(const vector<unsigned char> & message, uns
 
     // Consensus messages must be processed in correct sequence as they come in
     // It is possible for ANNOUNCE to arrive before correct DS state
-    // In that case, ANNOUNCE will sleep for a second below
-    // If COLLECTIVESIG also comes in, it's then possible COLLECTIVESIG will be processed before ANNOUNCE!
-    // So, ANNOUNCE should acquire a lock here
-    const unsigned int sleep_time_while_waiting = 500;
-
-    // Wait for a while in the case that primary sent announcement pretty early
-    if ((m_state == TX_SUBMISSION) || (m_state == TX_SUBMISSION_BUFFER) || (m_state == MICROBLOCK_CONSENSUS_PREP))
+    // In that case, ANNOUNCE is parked below and replayed once the state is entered
+    // If COLLECTIVESIG also comes in, it is parked behind ANNOUNCE, so replay keeps the arrival order;
+    // this holds in MICROBLOCK_CONSENSUS too until the queue has been replayed
+    // ANNOUNCE still acquires the lock here so parking and processing do not interleave
+
+    // Park the message in the case that primary sent announcement pretty early
+    if ((m_state == TX_SUBMISSION) || (m_state == TX_SUBMISSION_BUFFER) || (m_state == MICROBLOCK_CONSENSUS_PREP) || 
+        (m_state == MICROBLOCK_CONSENSUS))
     {
-        unsigned int time_pass = 0;
-        while (m_state != MICROBLOCK_CONSENSUS)
+        auto replay = [this, message, offset, from]() -> void { ProcessMicroblockConsensus(message, offset, from); };
+        if (m_stateNotifier.ParkUntil(MICROBLOCK_CONSENSUS, replay, chrono::seconds(PARKED_MESSAGE_TIMEOUT_IN_SECONDS)))
         {
-            this_thread::sleep_for(chrono::milliseconds(sleep_time_while_waiting));
-            time_pass++;
-            if (time_pass % 10)
-            {
-                LOG_MESSAGE2(to_string( m_mediator.m_currentEpochNum).c_str(), "Waiting for MICROBLOCK_CONSENSUS before processing");
-            }
+            LOG_MESSAGE2(to_string( m_mediator.m_currentEpochNum).c_str(), "Parked until MICROBLOCK_CONSENSUS");
+            return true;
         }
     }
-    // else if (m_state != MICROBLOCK_CONSENSUS)
-    else if (!CheckState(PROCESS_MICROBLOCKCONSENSUS))
+
+    // if (m_state != MICROBLOCK_CONSENSUS)
+    if (!CheckState(PROCESS_MICROBLOCKCONSENSUS))
     {
         LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Not in MICROBLOCK_CONSENSUS state");
         return false;
@@ -122,7 +124,8 @@ bool Node::ProcessMicroblockConsensus(const vector<unsigned char> & message, uns
         if (m_isPrimary == true)
         {
 #ifdef STAT_TEST
-            LOG_STATE("[MICON][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "]["<< m_mediator.m_currentEpochNum << "] DONE");
+            LOG_STATE_TEXT("[MICON][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "]["<< m_mediator.m_currentEpochNum << "] DONE");
+            LOG_EVENT(EVENT_MICON, PHASE_DONE, m_mediator.m_currentEpochNum, 0, 0);
 #endif // STAT_TEST
 
             // Multicast micro block to all DS nodes
@@ -175,33 +178,13 @@ bool Node::ComposeMicroBlock()
     array<unsigned char, BLOCK_SIG_SIZE> signature;
     vector<TxnHash> tranHashes;
 
-    unsigned int index = 0;
-    {
-        lock(m_mutexReceivedTransactions, m_mutexSubmittedTransactions);
-        lock_guard<mutex> g(m_mutexReceivedTransactions, adopt_lock);
-        lock_guard<mutex> g2(m_mutexSubmittedTransactions, adopt_lock);
-
-        auto & receivedTransactions = m_receivedTransactions[blockNum];
-        auto & submittedTransactions = m_submittedTransactions[blockNum];
-
-        txRootHash = ComputeTransactionsRoot(receivedTransactions, submittedTransactions);
-
-        numTxs = receivedTransactions.size() + submittedTransactions.size();
-        tranHashes.resize(numTxs);
-        for (const auto & tx : receivedTransactions)
-        {
-            const auto & txid = tx.first.asArray();
-            copy(txid.begin(), txid.end(), tranHashes.at(index).asArray().begin());
-            index++;
-        }
-
-        for (const auto & tx : submittedTransactions)
-        {
-            const auto & txid = tx.first.asArray();
-            copy(txid.begin(), txid.end(), tranHashes.at(index).asArray().begin());
-            index++;
-        }
-    }
+    // Transactions still waiting in the intake batch are verified now so that they can be included
+    FlushTxnIntake();
+    m_txnPool.SelectExecutable(MAX_TXNS_PER_MICROBLOCK, tranHashes);
+    // Keep the proposed transactions in the pool until the final block commits them
+    m_txnPool.Pin(tranHashes);
+    txRootHash = ComputeTransactionsRoot(tranHashes);
+    numTxs = tranHashes.size();
 
     LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Creating new micro block.")
     m_microblock.reset
@@ -232,8 +215,14 @@ bool Node::RunConsensusOnMicroBlockWhenShardLeader()
     // composed microblock stored in m_microblock
     ComposeMicroBlock();
 
+    // Announce short salted IDs instead of full hashes; backups rebuild the list from their own pools
+    random_device rd;
+    uint64_t salt = (static_cast<uint64_t>(rd()) << 32) | rd();
     vector<unsigned char> microblock;
-    m_microblock->Serialize(microblock, 0);
+    CompactMicroBlock(*m_microblock, salt).Serialize(microblock, 0);
+
+    LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Compact microblock announcement: " << 
+                 microblock.size() << " bytes (full microblock: " << m_microblock->GetSerializedSize() << " bytes)");
 
     //m_consensusID = 0;
     m_consensusBlockHash.resize(BLOCK_HASH_SIZE);
@@ -265,7 +254,8 @@ bool Node::RunConsensusOnMicroBlockWhenShardLeader()
     }
 
 #ifdef STAT_TEST
-    LOG_STATE("[MICON][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "]["<< m_mediator.m_currentEpochNum << "] BGIN");
+    LOG_STATE_TEXT("[MICON][" << std::setw(15) << std::left << m_mediator.m_selfPeer.GetPrintableIPAddress() << "]["<< m_mediator.m_currentEpochNum << "] BGIN");
+    LOG_EVENT(EVENT_MICON, PHASE_BEGN, m_mediator.m_currentEpochNum, 0, 0);
 #endif // STAT_TEST
     ConsensusLeader * cl = dynamic_cast<ConsensusLeader*>(m_consensusObject.get());
     cl->StartConsensus(microblock);
@@ -316,7 +306,7 @@ bool Node::RunConsensusOnMicroBlockWhenShardBackup()
 
 bool Node::RunConsensusOnMicroBlock()
 {
-    LOG_MARKER();
+    TRACE_MARKER();
 
     // set state first and then take writer lock so that SubmitTransactions
     // if it takes reader lock later breaks out of loop
@@ -346,23 +336,22 @@ bool Node::RunConsensusOnMicroBlock()
 
 bool Node::CheckLegitimacyOfTxnHashes()
 {
-    lock(m_mutexReceivedTransactions, m_mutexSubmittedTransactions);
-    lock_guard<mutex> g(m_mutexReceivedTransactions, adopt_lock);
-    lock_guard<mutex> g2(m_mutexSubmittedTransactions, adopt_lock);
+    // The leader may have included transactions still waiting in this node's intake batch. Everything
+    // in the pool has been verified on the way in, so no signature is checked here.
+    FlushTxnIntake();
 
-    auto const & receivedTransactions = m_receivedTransactions[m_mediator.m_currentEpochNum];
-    auto const & submittedTransactions = m_submittedTransactions[m_mediator.m_currentEpochNum];
+    // Pinning keeps the transactions in the pool until the final block commits them
+    if (m_txnPool.Pin(m_microblock->GetTranHashes()))
+    {
+        return true;
+    }
+
+    lock_guard<mutex> g(m_mutexMissingMicroBlockTxns);
 
     for(auto const & hash : m_microblock->GetTranHashes())
     {   
-        // Check if transaction is part of submitted Tx list
-        if(submittedTransactions.find(hash) != submittedTransactions.end())
-        {
-            continue;
-        }
-
-        // Check if transaction is part of received Tx list
-        if(receivedTransactions.find(hash) == receivedTransactions.end())
+        // Check if transaction is part of the pending pool, or was fetched from the leader
+        if(!m_txnPool.Contains(hash) && (m_fetchedMicroBlockTxns.count(hash) == 0))
         {
             LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
                          "Missing txn: " << hash)
@@ -410,9 +399,9 @@ bool Node::CheckMicroBlockTimestamp()
     // Check timestamp (must be greater than timestamp of last Tx block header in the Tx blockchain)
     if (m_mediator.m_txBlockChain.GetBlockCount() > 0)
     {
-        const TxBlock & lastTxBlock = m_mediator.m_txBlockChain.GetLastBlock();
+        shared_ptr<const TxBlock> lastTxBlock = m_mediator.m_txBlockChain.GetLastBlock();
         uint256_t thisMicroblockTimestamp = m_microblock->GetHeader().GetTimestamp();
-        uint256_t lastTxBlockTimestamp = lastTxBlock.GetHeader().GetTimestamp();
+        uint256_t lastTxBlockTimestamp = lastTxBlock->GetHeader().GetTimestamp();
         if (thisMicroblockTimestamp <= lastTxBlockTimestamp)
         {
             LOG_MESSAGE("Error: Timestamp check failed. Last Tx Block: " << lastTxBlockTimestamp << 
@@ -474,19 +463,133 @@ bool Node::CheckMicroBlockTxnRootHash()
     return true;      
 }
 
-bool Node::MicroBlockValidator(const vector<unsigned char> & microblock)
+bool Node::ReconstructMicroBlock(const vector<unsigned char> & compact_microblock)
+{
+    LOG_MARKER();
+
+    if (!CompactMicroBlock::CheckSerializedSize(compact_microblock, 0))
+    {
+        LOG_MESSAGE("Error: Compact microblock size does not match its transaction count");
+        return false;
+    }
+
+    CompactMicroBlock compactBlock(compact_microblock, 0);
+
+    {
+        lock_guard<mutex> g(m_mutexMissingMicroBlockTxns);
+        m_fetchedMicroBlockTxns.clear();
+    }
+
+    vector<TxnHash> pool;
+    m_txnPool.GetTranIDs(pool);
+
+    vector<TxnHash> tranHashes;
+    vector<uint32_t> missing;
+    compactBlock.Reconstruct(pool, tranHashes, missing);
+
+    // Pin what was resolved before fetching, so intake cannot evict it while this round runs.
+    // Anything evicted between reading the pool and pinning is fetched like the rest.
+    unordered_set<uint32_t> unresolved(missing.begin(), missing.end());
+    vector<TxnHash> resolved;
+    resolved.reserve(tranHashes.size() - missing.size());
+    for (uint32_t i = 0; i < tranHashes.size(); i++)
+    {
+        if (unresolved.count(i) == 0)
+        {
+            resolved.push_back(tranHashes.at(i));
+        }
+    }
+
+    if (!m_txnPool.Pin(resolved))
+    {
+        for (uint32_t i = 0; i < tranHashes.size(); i++)
+        {
+            if ((unresolved.count(i) == 0) && !m_txnPool.Contains(tranHashes.at(i)))
+            {
+                missing.push_back(i);
+            }
+        }
+    }
+
+    LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Compact microblock: " << 
+                 tranHashes.size() - missing.size() << " of " << tranHashes.size() << 
+                 " txns resolved from local pool");
+
+    if (!missing.empty() && !FetchMissingMicroBlockTxns(compactBlock, tranHashes, missing))
+    {
+        return false;
+    }
+
+    m_microblock = make_shared<MicroBlock>(compactBlock.ToMicroBlock(tranHashes));
+
+    return true;
+}
+
+bool Node::FetchMissingMicroBlockTxns(const CompactMicroBlock & compactBlock, vector<TxnHash> & tranHashes,
+                                      const vector<uint32_t> & missing)
 {
     LOG_MARKER();
 
+    // Message = [32-byte block num] [4-byte consensus id] [4-byte requester id] [4-byte count] 
+    //           [4-byte index] ... [4-byte index]
+    vector<unsigned char> request = { MessageType::NODE, NodeInstructionType::GETMICROBLOCKTXNS };
+    unsigned int cur_offset = MessageOffset::BODY;
+
+    Serializable::SetNumber<uint256_t>(request, cur_offset, m_mediator.m_currentEpochNum, UINT256_SIZE);
+    cur_offset += UINT256_SIZE;
+
+    Serializable::SetNumber<uint32_t>(request, cur_offset, m_consensusID, sizeof(uint32_t));
+    cur_offset += sizeof(uint32_t);
+
+    Serializable::SetNumber<uint32_t>(request, cur_offset, m_consensusMyID, sizeof(uint32_t));
+    cur_offset += sizeof(uint32_t);
+
+    Serializable::SetNumber<uint32_t>(request, cur_offset, missing.size(), sizeof(uint32_t));
+    cur_offset += sizeof(uint32_t);
+
+    for (auto index : missing)
+    {
+        Serializable::SetNumber<uint32_t>(request, cur_offset, index, sizeof(uint32_t));
+        cur_offset += sizeof(uint32_t);
+    }
+
+    unique_lock<mutex> lock(m_mutexMissingMicroBlockTxns);
+
+    m_compactMicroBlock = make_shared<CompactMicroBlock>(compactBlock);
+    m_pendingTranHashes = move(tranHashes);
+    m_missingTxnIndices = unordered_set<uint32_t>(missing.begin(), missing.end());
+
+    LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Requesting " << missing.size() << 
+                 " missing txns from shard leader");
+    P2PComm::GetInstance().SendMessage(m_myShardMembersNetworkInfo.at(m_consensusLeaderID), request);
+
+    bool complete = m_cvMissingMicroBlockTxns.wait_for(lock, chrono::seconds(FETCH_MICROBLOCK_TXNS_TIMEOUT_IN_SECONDS), 
+                                                       [this] { return m_missingTxnIndices.empty(); });
+
+    tranHashes = move(m_pendingTranHashes);
+    m_compactMicroBlock = nullptr;
+    m_pendingTranHashes.clear();
+
+    if (!complete)
+    {
+        LOG_MESSAGE("Error: Timed out waiting for " << m_missingTxnIndices.size() << " missing txns");
+        m_missingTxnIndices.clear();
+        return false;
+    }
+
+    return true;
+}
+
+bool Node::MicroBlockValidator(const vector<unsigned char> & microblock)
+{
+    LOG_MARKER();
 
-    // [TODO] To put in the logic
-    m_microblock = make_shared<MicroBlock>(MicroBlock(microblock, 0));
 
     bool valid = false;
 
     do
     {
-        if (!CheckBlockTypeIsMicro() || !CheckMicroBlockVersion() || !CheckMicroBlockTimestamp() || 
+        if (!ReconstructMicroBlock(microblock) || !CheckBlockTypeIsMicro() || !CheckMicroBlockVersion() || !CheckMicroBlockTimestamp() || 
             !CheckMicroBlockHashes() || !CheckMicroBlockTxnRootHash())
         {
             break;
@@ -518,4 +621,169 @@ bool Node::MicroBlockValidator(const vector<unsigned char> & microblock)
     // return true;
 
 }
-#endif // IS_LOOKUP_NODE 
+#endif // IS_LOOKUP_NODE
+
+bool Node::ProcessGetMicroBlockTxns(const vector<unsigned char> & message, unsigned int offset, 
+                                    const Peer & from)
+{
+#ifndef IS_LOOKUP_NODE
+    // Message = [32-byte block num] [4-byte consensus id] [4-byte requester id] [4-byte count] 
+    //           [4-byte index] ... [4-byte index]
+
+    LOG_MARKER();
+
+    const unsigned int min_size = UINT256_SIZE + sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint32_t);
+    if (IsMessageSizeInappropriate(message.size(), offset, min_size, sizeof(uint32_t)))
+    {
+        return false;
+    }
+
+    unsigned int cur_offset = offset;
+
+    uint256_t blockNum = Serializable::GetNumber<uint256_t>(message, cur_offset, UINT256_SIZE);
+    cur_offset += UINT256_SIZE;
+
+    uint32_t consensusID = Serializable::GetNumber<uint32_t>(message, cur_offset, sizeof(uint32_t));
+    cur_offset += sizeof(uint32_t);
+
+    uint32_t requesterID = Serializable::GetNumber<uint32_t>(message, cur_offset, sizeof(uint32_t));
+    cur_offset += sizeof(uint32_t);
+
+    uint32_t count = Serializable::GetNumber<uint32_t>(message, cur_offset, sizeof(uint32_t));
+    cur_offset += sizeof(uint32_t);
+
+    if ((count != (message.size() - cur_offset) / sizeof(uint32_t)) || 
+        (requesterID >= m_myShardMembersNetworkInfo.size()))
+    {
+        LOG_MESSAGE("Error: Malformed missing txns request");
+        return false;
+    }
+
+    shared_ptr<MicroBlock> microblock;
+    {
+        lock_guard<mutex> g(m_mutexConsensus);
+        microblock = m_microblock;
+    }
+
+    if (!m_isPrimary || (microblock == nullptr) || (blockNum != m_mediator.m_currentEpochNum) || 
+        (consensusID != m_consensusID))
+    {
+        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                     "Ignoring missing txns request for a microblock I did not propose");
+        return false;
+    }
+
+    // Message = [32-byte block num] [4-byte count] [4-byte index] [Transaction] ... [4-byte index] [Transaction]
+    vector<unsigned char> response = { MessageType::NODE, NodeInstructionType::SETMICROBLOCKTXNS };
+    unsigned int resp_offset = MessageOffset::BODY;
+
+    Serializable::SetNumber<uint256_t>(response, resp_offset, blockNum, UINT256_SIZE);
+    resp_offset += UINT256_SIZE;
+
+    unsigned int count_offset = resp_offset;
+    resp_offset += sizeof(uint32_t);
+
+    uint32_t found = 0;
+    const vector<TxnHash> & tranHashes = microblock->GetTranHashes();
+    for (uint32_t i = 0; i < count; i++)
+    {
+        uint32_t index = Serializable::GetNumber<uint32_t>(message, cur_offset, sizeof(uint32_t));
+        cur_offset += sizeof(uint32_t);
+
+        Transaction tx;
+        if ((index >= tranHashes.size()) || !m_txnPool.Get(tranHashes.at(index), tx))
+        {
+            continue;
+        }
+
+        Serializable::SetNumber<uint32_t>(response, resp_offset, index, sizeof(uint32_t));
+        resp_offset += sizeof(uint32_t);
+        tx.Serialize(response, resp_offset);
+        resp_offset += Transaction::GetSerializedSize();
+        found++;
+    }
+
+    Serializable::SetNumber<uint32_t>(response, count_offset, found, sizeof(uint32_t));
+
+    LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Sending " << found << " of " << 
+                 count << " requested txns to backup " << requesterID);
+    P2PComm::GetInstance().SendMessage(m_myShardMembersNetworkInfo.at(requesterID), response);
+#endif // IS_LOOKUP_NODE
+    return true;
+}
+
+bool Node::ProcessSetMicroBlockTxns(const vector<unsigned char> & message, unsigned int offset, 
+                                    const Peer & from)
+{
+#ifndef IS_LOOKUP_NODE
+    // Message = [32-byte block num] [4-byte count] [4-byte index] [Transaction] ... [4-byte index] [Transaction]
+
+    LOG_MARKER();
+
+    const unsigned int entry_size = sizeof(uint32_t) + Transaction::GetSerializedSize();
+    if (IsMessageSizeInappropriate(message.size(), offset, UINT256_SIZE + sizeof(uint32_t), entry_size))
+    {
+        return false;
+    }
+
+    unsigned int cur_offset = offset;
+
+    uint256_t blockNum = Serializable::GetNumber<uint256_t>(message, cur_offset, UINT256_SIZE);
+    cur_offset += UINT256_SIZE;
+
+    uint32_t count = Serializable::GetNumber<uint32_t>(message, cur_offset, sizeof(uint32_t));
+    cur_offset += sizeof(uint32_t);
+
+    if (count != (message.size() - cur_offset) / entry_size)
+    {
+        LOG_MESSAGE("Error: Malformed missing txns response");
+        return false;
+    }
+
+    lock_guard<mutex> g(m_mutexMissingMicroBlockTxns);
+
+    if ((m_compactMicroBlock == nullptr) || (blockNum != m_mediator.m_currentEpochNum))
+    {
+        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                     "Ignoring missing txns response -- no reconstruction pending");
+        return false;
+    }
+
+    vector<uint32_t> indices;
+    vector<Transaction> received;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        indices.push_back(Serializable::GetNumber<uint32_t>(message, cur_offset, sizeof(uint32_t)));
+        cur_offset += sizeof(uint32_t);
+
+        received.emplace_back(message, cur_offset);
+        cur_offset += Transaction::GetSerializedSize();
+    }
+
+    vector<TxnVerifier::Result> results;
+    TxnVerifier::CheckBatch(received, m_numShards, m_myShardID, results);
+
+    unsigned int filled = 0;
+    for (uint32_t i = 0; i < count; i++)
+    {
+        const Transaction & tx = received.at(i);
+
+        // Only accept valid bodies that were asked for and match the announced short ID
+        if ((results.at(i) == TxnVerifier::VALID) && (m_missingTxnIndices.count(indices.at(i)) > 0) && 
+            m_compactMicroBlock->Fill(indices.at(i), tx.GetTranID(), m_pendingTranHashes))
+        {
+            m_missingTxnIndices.erase(indices.at(i));
+
+            // Not pooled: the pool may refuse it, and validation and commit must still find it
+            m_fetchedMicroBlockTxns[tx.GetTranID()] = tx;
+            filled++;
+        }
+    }
+
+    LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Filled " << filled << 
+                 " missing txns, " << m_missingTxnIndices.size() << " still missing");
+
+    m_cvMissingMicroBlockTxns.notify_all();
+#endif // IS_LOOKUP_NODE
+    return true;
+}
@@ -14,6 +14,7 @@
 * and which include a reference to GPLv3 in their program files.
 **/
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <functional>
@@ -34,11 +35,16 @@
 #include "libData/AccountData/Account.h"
 #include "libData/AccountData/AccountStore.h"
 #include "libData/AccountData/Transaction.h"
+#include "libData/AccountData/TxnVerifier.h"
 #include "libMediator/Mediator.h"
+#include "libNetwork/BroadcastTree.h"
 #include "libPOW/pow.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
+#include "libUtils/EventLog.h"
+#include "libUtils/Executor.h"
 #include "libUtils/Logger.h"
+#include "libUtils/Metrics.h"
 #include "libUtils/SanityChecks.h"
 #include "libUtils/TimeLockedFunction.h"
 #include "libUtils/TimeUtils.h"
@@ -46,13 +52,19 @@
 using namespace std;
 using namespace boost::multiprecision;
 
-Node::Node(Mediator & mediator) : m_mediator(mediator)
+Node::Node(Mediator & mediator) : m_mediator(mediator), 
+                                  m_txnPool((uint64_t) TXN_POOL_MAX_SIZE_IN_MB * 1024 * 1024), 
+                                  m_stateNotifier(m_state)
 {
     // m_state = IDLE;
+    // Transactions are taken in during TX_SUBMISSION_BUFFER too, so the ones parked for TX_SUBMISSION
+    // are still replayed if the state moves on before they all ran
+    m_stateNotifier.AlsoDrainIn(TX_SUBMISSION, TX_SUBMISSION_BUFFER);
     m_consensusID = 0;
     m_consensusLeaderID = 0;
     m_synchronizer.InitializeGenesisBlocks(m_mediator.m_dsBlockChain, m_mediator.m_txBlockChain);
-    m_mediator.m_currentEpochNum = (uint64_t) m_mediator.m_txBlockChain.GetBlockCount();
+    m_mediator.m_currentEpochNum = m_mediator.m_txBlockChain.GetBlockCount();
+    TRACE_EPOCH(m_mediator.m_currentEpochNum);
     m_mediator.UpdateDSBlockRand(true);
     m_mediator.UpdateTxBlockRand(true);
     SetState(POW1_SUBMISSION);
@@ -61,7 +73,8 @@ Node::Node(Mediator & mediator) : m_mediator(mediator)
 
 Node::~Node()
 {
-
+    m_txnSubmissionTimer.Cancel();
+    m_microBlockConsensusTimer.Cancel();
 }
 
 #ifndef IS_LOOKUP_NODE
@@ -328,42 +341,87 @@ vector<Peer> Node::GetBroadcastList(unsigned char ins_type, const Peer & broadca
     //     return peers;
     // }
 
-    // Regardless of the instruction type, right now all our "broadcasts" are just redundant multicasts from DS nodes to non-DS nodes
+#ifndef IS_LOOKUP_NODE
+    // Shard-wide broadcasts travel down the broadcast tree, so each node only forwards to its children
+    if ((ins_type == NodeInstructionType::SUBMITTRANSACTION) || 
+        (ins_type == NodeInstructionType::FINALBLOCKFRAGMENT))
+    {
+        lock_guard<mutex> g(m_mutexBroadcastTree);
+        return m_broadcastTreeChildren;
+    }
+#endif // IS_LOOKUP_NODE
+
+    // All our other "broadcasts" are just redundant multicasts from DS nodes to non-DS nodes
     return vector<Peer>();
 }
 
 #ifndef IS_LOOKUP_NODE
-bool Node::CheckCreatedTransaction(const Transaction & tx)
+void Node::BuildBroadcastTree()
 {
+    // The root rotates with the DS epoch so the interior nodes change with every sharding structure
     LOG_MARKER();
 
-    // Check if from account is sharded here
-    const Address & fromAddr = tx.GetFromAddr();
-    unsigned int correct_shard = Transaction::GetShardIndex(fromAddr, m_numShards);
+    const unsigned int size = m_myShardMembersNetworkInfo.size();
+    if (size == 0)
+    {
+        return;
+    }
 
-    if (correct_shard != m_myShardID)
+    BroadcastTree tree(size, BROADCAST_TREE_FANOUT, 
+                       (unsigned int)(m_mediator.m_dsBlockChain.GetBlockCount() % size));
+
+    lock_guard<mutex> g(m_mutexBroadcastTree);
+
+    m_isBroadcastTreeRoot = (tree.GetRoot() == m_consensusMyID);
+    m_broadcastTreeRoot = m_myShardMembersNetworkInfo.at(tree.GetRoot());
+
+    m_broadcastTreeChildren.clear();
+    for (unsigned int child : tree.GetChildren(m_consensusMyID))
     {
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
-                     "Error: This tx is not sharded to me!");
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
-                     "From Account  = 0x" << fromAddr);
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
-                     "Correct shard = " << correct_shard);
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
-                     "This shard    = " << m_myShardID);
-        return false;
+        m_broadcastTreeChildren.push_back(m_myShardMembersNetworkInfo.at(child));
+    }
+
+    LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                 "Broadcast tree root = " << tree.GetRoot() << ", depth = " << tree.GetDepth() << 
+                 ", my children = " << m_broadcastTreeChildren.size());
+}
+
+void Node::BroadcastToMyShard(const vector<unsigned char> & message)
+{
+    // My own subtree is served directly and everyone else through the root. The copy that comes back 
+    // down from my parent is discarded as a duplicate.
+    LOG_MARKER();
+
+    vector<Peer> peers;
+    {
+        lock_guard<mutex> g(m_mutexBroadcastTree);
+        peers = m_broadcastTreeChildren;
+        if (!m_isBroadcastTreeRoot)
+        {
+            peers.push_back(m_broadcastTreeRoot);
+        }
     }
 
-    // Check if from account exists in local storage
+    P2PComm::GetInstance().SendBroadcastMessage(peers, message);
+}
+#endif // IS_LOOKUP_NODE
+
+#ifndef IS_LOOKUP_NODE
+bool Node::CheckCreatedTransaction(const Transaction & tx)
+{
+    // Stateful part of transaction intake - the caller holds m_mutexCommittedTransactions, so the
+    // account store does not change while a batch is checked against it
+
+    const Address & fromAddr = tx.GetFromAddr();
+
+    // To-do: Accounts are not loaded into the account store yet, so unknown senders are let through
     if (!AccountStore::GetInstance().DoesAccountExist(fromAddr))
     {
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
-                     "To-do: What to do if from account is not in my account store?");
-        throw exception();
+        return true;
     }
 
-    // Check from account nonce
-    if (tx.GetNonce() != AccountStore::GetInstance().GetNonce(fromAddr) + 1)
+    // Check from account nonce (later nonces wait in the pool until the gap is filled)
+    if (tx.GetNonce() <= AccountStore::GetInstance().GetNonce(fromAddr))
     {
         LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
                      "Error: Tx nonce not in line with account state!");
@@ -371,22 +429,11 @@ bool Node::CheckCreatedTransaction(const Transaction & tx)
                      "From Account      = 0x" << fromAddr);
         LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
                      "Account Nonce     = " << AccountStore::GetInstance().GetNonce(fromAddr));
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
-                     "Expected Tx Nonce = " << AccountStore::GetInstance().GetNonce(fromAddr) + 1);
         LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
                      "Actual Tx Nonce   = " << tx.GetNonce());
         return false;
     }
 
-    // Check if to account exists in local storage
-    const Address & toAddr = tx.GetToAddr();
-    if (!AccountStore::GetInstance().DoesAccountExist(toAddr))
-    {
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
-                     "To-do: What to do if to account is not in my account store?");
-        throw exception();
-    }
-
     // Check if transaction amount is valid
     if (AccountStore::GetInstance().GetBalance(fromAddr) < tx.GetAmount())
     {
@@ -403,6 +450,133 @@ bool Node::CheckCreatedTransaction(const Transaction & tx)
     
     return true;
 }
+
+bool Node::IsTxnIntakeOpen(const function<void()> & replay, bool & parked)
+{
+    // Transactions that arrive while parked ones are replayed may go ahead of them, as the pool orders
+    // each sender's transactions by nonce rather than by arrival
+    if (m_state == TX_SUBMISSION || m_state == TX_SUBMISSION_BUFFER)
+    {
+        return true;
+    }
+
+    if (m_stateNotifier.ParkUntil(TX_SUBMISSION, replay, chrono::seconds(PARKED_MESSAGE_TIMEOUT_IN_SECONDS)))
+    {
+        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                     "Not in ProcessSubmitTxn state -- parked until TX_SUBMISSION")
+        parked = true;
+        return false;
+    }
+
+    if (m_state != TX_SUBMISSION && m_state != TX_SUBMISSION_BUFFER)
+    {
+        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                     "Not in ProcessSubmitTxn state -- current state is " << m_state)
+        return false;
+    }
+
+    return true;
+}
+
+void Node::VerifyAndPoolTxns(const vector<Transaction> & txns)
+{
+    LOG_MARKER();
+
+    auto start = chrono::steady_clock::now();
+
+    // Tran ID, sender key, signature and shard checks run in parallel
+    vector<TxnVerifier::Result> results;
+    TxnVerifier::CheckBatch(txns, m_numShards, m_myShardID, results);
+
+    // Nonce and balance checks run one at a time
+    unsigned int num_pooled = 0;
+    {
+        lock_guard<mutex> g(m_mutexCommittedTransactions);
+
+        for (unsigned int i = 0; i < txns.size(); i++)
+        {
+            const Transaction & tx = txns.at(i);
+
+            if (results.at(i) != TxnVerifier::VALID)
+            {
+                LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                             "Rejected txn: " << tx.GetTranID() << " (check " << (unsigned int) results.at(i) << 
+                             " failed)")
+                continue;
+            }
+
+            if (!CheckCreatedTransaction(tx))
+            {
+                continue;
+            }
+
+            if (!m_txnPool.Insert(tx))
+            {
+                LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                             "Dropped txn: " << tx.GetTranID() << " (pool size " << m_txnPool.GetSize() << ")")
+                continue;
+            }
+
+            LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Received txn: " << tx.GetTranID())
+            num_pooled++;
+        }
+    }
+
+    METRICS_COUNTER("zilliqa_txns_received_total", "Transactions received for verification").Increment(txns.size());
+    METRICS_COUNTER("zilliqa_txns_pooled_total", "Transactions verified and added to the pool").Increment(num_pooled);
+    METRICS_GAUGE("zilliqa_txn_pool_size", "Transactions pending in the pool").Set(m_txnPool.GetSize());
+
+    uint64_t elapsed_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    METRICS_HISTOGRAM("zilliqa_txn_verify_batch_seconds", "Time to verify and pool one batch of transactions")
+        .Record(chrono::microseconds(elapsed_us));
+    LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                 "Verified " << txns.size() << " txns in " << elapsed_us << " us (" << 
+                 txns.size() * 1000000 / max<uint64_t>(elapsed_us, 1) << " txns/s), pooled " << num_pooled)
+}
+
+void Node::QueueTxnForIntake(const Transaction & tx)
+{
+    vector<Transaction> batch;
+
+    {
+        lock_guard<mutex> g(m_mutexTxnIntake);
+        m_txnIntakeBatch.push_back(tx);
+
+        if (m_txnIntakeBatch.size() >= TXN_INTAKE_BATCH_SIZE)
+        {
+            m_txnIntakeTimer.Cancel();
+            batch.swap(m_txnIntakeBatch);
+        }
+        else if (!m_txnIntakeTimer.IsPending())
+        {
+            // A partial batch is verified after a short wait rather than held until it fills up
+            auto func = [this]() -> void { FlushTxnIntake(); };
+            m_txnIntakeTimer = Executor::GetInstance().PostBlockingAfter(
+                chrono::milliseconds(TXN_INTAKE_BATCH_TIMEOUT_IN_MILLISECONDS), func);
+        }
+    }
+
+    if (!batch.empty())
+    {
+        VerifyAndPoolTxns(batch);
+    }
+}
+
+void Node::FlushTxnIntake()
+{
+    vector<Transaction> batch;
+
+    {
+        lock_guard<mutex> g(m_mutexTxnIntake);
+        m_txnIntakeTimer.Cancel();
+        batch.swap(m_txnIntakeBatch);
+    }
+
+    if (!batch.empty())
+    {
+        VerifyAndPoolTxns(batch);
+    }
+}
 #endif // IS_LOOKUP_NODE
 
 bool Node::ProcessCreateTransaction(const vector<unsigned char> & message, unsigned int offset, 
@@ -425,26 +599,11 @@ bool Node::ProcessCreateTransaction(const vector<unsigned char> & message, unsig
 
     // 33-byte from pubkey
     PubKey fromPubkey(message, cur_offset);
-
-    // Generate from account
-    Address fromAddr;
-    SHA2<HASH_TYPE::HASH_VARIANT_256> sha2;
-    sha2.Update(message, cur_offset, PUB_KEY_SIZE);
-    const vector<unsigned char> & tmp1 = sha2.Finalize();
-    copy(tmp1.end() - ACC_ADDR_SIZE, tmp1.end(), fromAddr.asArray().begin());
-
     cur_offset += PUB_KEY_SIZE;
 
     // 33-byte to pubkey
     PubKey toPubkey(message, cur_offset);
-
-    // Generate to account
-    Address toAddr;
-    sha2.Reset();
-    sha2.Update(message, cur_offset, PUB_KEY_SIZE);
-    const vector<unsigned char> & tmp2 = sha2.Finalize();
-    copy(tmp2.end() - ACC_ADDR_SIZE, tmp2.end(), fromAddr.asArray().begin());
-
+    Address toAddr = Account::GetAddressFromPublicKey(toPubkey);
     cur_offset += PUB_KEY_SIZE;
 
     // 32-byte amount
@@ -452,32 +611,42 @@ bool Node::ProcessCreateTransaction(const vector<unsigned char> & message, unsig
 
     // Create the transaction object
 
+    // The test script cannot sign for the from pubkey it names, so the transactions are sent from a 
+    // key pair generated here instead, picked so that the sender is sharded to this shard
+    pair<PrivKey, PubKey> senderKey = Schnorr::GetInstance().GenKeyPair();
+    if (m_numShards > 0)
+    {
+        while (Transaction::GetShardIndex(Account::GetAddressFromPublicKey(senderKey.second), m_numShards) != 
+               m_myShardID)
+        {
+            senderKey = Schnorr::GetInstance().GenKeyPair();
+        }
+    }
+
     // To-do: Replace dummy values with the required ones
-    //uint32_t version = 0;
-    uint32_t version = (uint32_t) m_consensusMyID; //hack
+    uint32_t version = 0;
     uint256_t nonce = 0;
 
-    array<unsigned char, TRAN_SIG_SIZE> signature;
-    fill(signature.begin(), signature.end(), 0x0F);
-
-    lock_guard<mutex> g(m_mutexCreatedTransactions);
-
-    // if(!CheckCreatedTransaction(txn))
-    // {
-    //     return false;
-    // }
-
     //TODO: Remove this before production. This is to reduce time spent on aws testnet. 
-    for (unsigned i=0; i < 10000; i++)
+    const unsigned int numTxns = 10000;
+
+    // Signing takes a while, so it is done before the submission path is locked out
+    vector<Transaction> txns;
+    if (!TxnVerifier::CreateSignedBatch(version, nonce, toAddr, senderKey.first, senderKey.second, amount, numTxns, 
+                                        txns))
     {
-        Transaction txn(version, nonce, toAddr, fromAddr, amount, signature);
         LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
-                     "Created txns: " << txn.GetTranID())
-        m_createdTransactions.push_back(txn);
-        nonce++;
-        amount++;
+                     "Error: Failed to sign created txns");
+        return false;
     }
 
+    LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                 "Created " << numTxns << " txns from 0x" << txns.front().GetFromAddr() << 
+                 " in place of the requested sender 0x" << Account::GetAddressFromPublicKey(fromPubkey))
+
+    lock_guard<mutex> g(m_mutexCreatedTransactions);
+    m_createdTransactions.insert(m_createdTransactions.end(), txns.begin(), txns.end());
+
 
 #endif // IS_LOOKUP_NODE
     return true;
@@ -488,7 +657,7 @@ bool Node::ProcessSubmitTransaction(const vector<unsigned char> & message, unsig
 {
 #ifndef IS_LOOKUP_NODE
     // This message is sent by my shard peers
-    // Message = [204-byte transaction]
+    // Message = [237-byte transaction]
 
     LOG_MARKER();
 
@@ -497,26 +666,54 @@ bool Node::ProcessSubmitTransaction(const vector<unsigned char> & message, unsig
         return false;
     }
 
-    while (m_state != TX_SUBMISSION && m_state != TX_SUBMISSION_BUFFER)
+    bool parked = false;
+    auto replay = [this, message, offset, from]() -> void { ProcessSubmitTransaction(message, offset, from); };
+    if (!IsTxnIntakeOpen(replay, parked))
     {
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
-                     "Not in ProcessSubmitTxn state -- waiting!")
-        this_thread::sleep_for(chrono::milliseconds(200));
+        return parked;
     }
- 
-    boost::multiprecision::uint256_t blockNum = (uint256_t) m_mediator.m_currentEpochNum;
-    unsigned int cur_offset = offset;
-    const auto & submittedTransaction = Transaction(message, cur_offset);
-    // if(CheckCreatedTransaction(submittedTransaction))
-    // {
-        lock_guard<mutex> g(m_mutexReceivedTransactions);
-        auto & receivedTransactions = m_receivedTransactions[blockNum];
-        receivedTransactions.insert(make_pair(submittedTransaction.GetTranID(), 
-                                              submittedTransaction));
-        LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
-                     "Received txn: " << submittedTransaction.GetTranID())
-    // }
-    
+
+    // Verification happens in batches, see VerifyAndPoolTxns()
+    QueueTxnForIntake(Transaction(message, offset));
+
+#endif // IS_LOOKUP_NODE
+    return true;
+}
+
+bool Node::ProcessSubmitTxnBatch(const vector<unsigned char> & message, unsigned int offset, 
+                                 const Peer & from)
+{
+#ifndef IS_LOOKUP_NODE
+    // This message is sent by load generators and clients submitting many transactions at once
+    // Message = [237-byte transaction] [237-byte transaction] ...
+
+    LOG_MARKER();
+
+    const unsigned int txnSize = Transaction::GetSerializedSize();
+    if (IsMessageSizeInappropriate(message.size(), offset, txnSize, txnSize))
+    {
+        return false;
+    }
+
+    bool parked = false;
+    auto replay = [this, message, offset, from]() -> void { ProcessSubmitTxnBatch(message, offset, from); };
+    if (!IsTxnIntakeOpen(replay, parked))
+    {
+        return parked;
+    }
+
+    // The batch is already as large as the intake would make it, so it is verified as it is
+    vector<Transaction> txns;
+    txns.reserve((message.size() - offset) / txnSize);
+    for (unsigned int cur_offset = offset; cur_offset < message.size(); cur_offset += txnSize)
+    {
+        txns.emplace_back(message, cur_offset);
+    }
+
+    LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
+                 "Received batch of " << txns.size() << " txns from " << from)
+    VerifyAndPoolTxns(txns);
+
 #endif // IS_LOOKUP_NODE
     return true;
 }
@@ -552,6 +749,7 @@ void Node::SetState(NodeState state)
     m_state = state;
     LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "Node State is now " << m_state <<
                  " at epoch " << m_mediator.m_currentEpochNum);
+    m_stateNotifier.Notify();
 }
 
 #ifndef IS_LOOKUP_NODE
@@ -569,7 +767,6 @@ void Node::SubmitTransactions()
 
     if (m_consensusMyID >= lower_id_limit && m_consensusMyID <= upper_id_limit)
     {
-        boost::multiprecision::uint256_t blockNum = (uint256_t) m_mediator.m_currentEpochNum;
         while (true && txn_sent_count < 500) 
         // TODO: remove the condition on txn_sent_count -- temporary hack to artificially limit number of
         // txns needed to be shared within shard members so that it completes in the time limit    
@@ -599,23 +796,22 @@ void Node::SubmitTransactions()
                 vector<unsigned char> tx_message = { MessageType::NODE, 
                                                      NodeInstructionType::SUBMITTRANSACTION };
                 t.Serialize(tx_message, MessageOffset::BODY);
-                P2PComm::GetInstance().SendMessage(m_myShardMembersNetworkInfo, tx_message);
+                BroadcastToMyShard(tx_message);
 
                 LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), 
                              "Sent txn: " << t.GetTranID())
 
-                lock_guard<mutex> g(m_mutexSubmittedTransactions);
-                auto & submittedTransactions = m_submittedTransactions[blockNum];
-                submittedTransactions.insert(make_pair(t.GetTranID(), t));
+                m_txnPool.Insert(t);
                 txn_sent_count++; 
             }
         }
     }
 #ifdef STAT_TEST
-    LOG_STATE("[TXNSE][" << std::setw(15) << std::left << 
+    LOG_STATE_TEXT("[TXNSE][" << std::setw(15) << std::left << 
               m_mediator.m_selfPeer.GetPrintableIPAddress() << "][" << 
               m_mediator.m_currentEpochNum << "][" << m_myShardID << "][" << txn_sent_count << 
               "] CONT");
+    LOG_EVENT(EVENT_TXNSE, PHASE_CONT, m_mediator.m_currentEpochNum, m_myShardID, txn_sent_count);
 #endif // STAT_TEST
 
 }
@@ -639,7 +835,13 @@ bool Node::Execute(const vector<unsigned char> & message, unsigned int offset, c
         &Node::ProcessSubmitTransaction,
         &Node::ProcessMicroblockConsensus,
         &Node::ProcessFinalBlock,
-        &Node::ProcessForwardTransaction
+        &Node::ProcessForwardTransaction,
+        &Node::ProcessGetMicroBlockTxns,
+        &Node::ProcessSetMicroBlockTxns,
+        &Node::ProcessForwardTxnOffer,
+        &Node::ProcessForwardTxnSketch,
+        &Node::ProcessFinalBlockFragment,
+        &Node::ProcessSubmitTxnBatch
     };
 
     const unsigned char ins_byte = message.at(offset);
@@ -16,6 +16,7 @@
 #ifndef __NODE_H__
 #define __NODE_H__
 
+#include <condition_variable>
 #include <deque>
 #include <list>
 #include <map>
@@ -31,13 +32,17 @@
 #include "depends/common/FixedHash.h"
 #include "libConsensus/Consensus.h"
 #include "libData/BlockData/Block.h"
+#include "libData/AccountData/ForwardedTxnSet.h"
 #include "libData/AccountData/Transaction.h"
+#include "libData/AccountData/TxPool.h"
 #include "libData/BlockChainData/TxBlockChain.h"
 #include "libNetwork/P2PComm.h"
 #include "libNetwork/PeerStore.h"
 #include "libPersistence/BlockStorage.h"
 #include "libPOW/pow.h"
 #include "libLookup/Synchronizer.h"
+#include "libUtils/StateNotifier.h"
+#include "libUtils/TimerWheel.h"
 
 class Mediator;
 
@@ -102,31 +107,85 @@ class Node : public Executable, public Broadcastable
     const static uint32_t RECVTXNDELAY_MILLISECONDS = 3000;
     const unsigned int SUBMIT_TX_WINDOW = 15;
     const unsigned int SUBMIT_TX_WINDOW_EXTENDED = 30;                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                                           ;
+
+    // Timers ending the transaction submission windows of the current round
+    TimerHandle m_txnSubmissionTimer;
+    TimerHandle m_microBlockConsensusTimer;
     const static unsigned int GOSSIP_RATE = 48;
+
+    // Intra-shard broadcast tree, rebuilt from every sharding structure
+    std::mutex m_mutexBroadcastTree;
+    Peer m_broadcastTreeRoot;
+    bool m_isBroadcastTreeRoot = false;
+    std::vector<Peer> m_broadcastTreeChildren;
+    const static unsigned int BROADCAST_TREE_FANOUT = 8;
     
     // Transactions information
     std::mutex m_mutexCreatedTransactions;
     std::list<Transaction> m_createdTransactions;
     
-    std::mutex m_mutexSubmittedTransactions;
-    std::unordered_map<boost::multiprecision::uint256_t, 
-                       std::unordered_map<TxnHash, Transaction>> m_submittedTransactions;
-    
-    std::mutex m_mutexReceivedTransactions;
-    std::unordered_map<boost::multiprecision::uint256_t, 
-                       std::unordered_map<TxnHash, Transaction>> m_receivedTransactions;
+    // Pending transactions, submitted by this node or received from the shard, until committed
+    TxPool m_txnPool;
+
+    // Received transactions waiting to be verified as one batch
+    std::mutex m_mutexTxnIntake;
+    std::vector<Transaction> m_txnIntakeBatch;
+    TimerHandle m_txnIntakeTimer;
     
     std::mutex m_mutexCommittedTransactions;
-    std::unordered_map<boost::multiprecision::uint256_t, 
+    std::unordered_map<uint64_t, 
                        std::list<Transaction>> m_committedTransactions;
 
     // Transaction body sharing variables
     std::mutex m_mutexUnavailableMicroBlocks;
-    std::unordered_map<boost::multiprecision::uint256_t, 
+    std::unordered_map<uint64_t, 
                        std::unordered_set<TxnHash>> m_unavailableMicroBlocks;
 
     std::mutex m_mutexForwardingAssignment;
-    std::unordered_map<boost::multiprecision::uint256_t, std::vector<Peer>> m_forwardingAssignment;
+    std::unordered_map<uint64_t, std::vector<Peer>> m_forwardingAssignment;
+
+    // Bodies offered to other nodes, in microblock order, with the salt their forwarding IDs are keyed by
+    struct TxnsToForward
+    {
+        uint64_t m_salt;
+        std::vector<Transaction> m_txns;
+    };
+
+    // Offers per block num and microblock root
+    std::mutex m_mutexTxnsToForward;
+    std::unordered_map<uint64_t, 
+                       std::unordered_map<TxnHash, TxnsToForward>> m_txnsToForward;
+
+    // Forwarded bodies received so far, per block num and microblock root
+    std::mutex m_mutexPartialForwardedTxns;
+    std::unordered_map<uint64_t, 
+                       std::unordered_map<TxnHash, ForwardedTxnSet>> m_partialForwardedTxns;
+
+    // Compact microblock reconstruction (backup side)
+    std::mutex m_mutexMissingMicroBlockTxns;
+    std::condition_variable m_cvMissingMicroBlockTxns;
+    std::shared_ptr<CompactMicroBlock> m_compactMicroBlock;
+    std::vector<TxnHash> m_pendingTranHashes;
+    std::unordered_set<uint32_t> m_missingTxnIndices;
+
+    // Bodies fetched for the microblock under consensus, until it is committed. Kept apart from the
+    // pool, which may refuse them (nonce conflicts) or evict them while intake is open.
+    std::unordered_map<TxnHash, Transaction> m_fetchedMicroBlockTxns;
+
+    // Erasure-coded final block fragments received so far, per hash of the FINALBLOCK message.
+    // Each DS node may start one entry per epoch, and entries from earlier epochs are dropped.
+    // Fragments are kept per announced length and per (index, signer), so a faulty signer can neither
+    // fix the length nor claim an index ahead of the honest copies.
+    struct FinalBlockFragments
+    {
+        bool m_relayed;
+        uint64_t m_epoch;
+        PubKey m_creator;
+        std::map<uint32_t, std::map<std::pair<unsigned int, PubKey>, std::vector<unsigned char>>> m_fragments;
+    };
+    std::mutex m_mutexFinalBlockFragments;
+    std::map<std::vector<unsigned char>, FinalBlockFragments> m_finalBlockFragments;
+    std::vector<unsigned char> m_lastRebuiltFinalBlockHash;
     
     bool CheckState(Action action);
     
@@ -161,30 +220,24 @@ class Node : public Executable, public Broadcastable
 
     // internal calls from ActOnFinalBlock for NODE_FORWARD_ONLY and SEND_AND_FORWARD
     void LoadForwardingAssignmentFromFinalBlock(const vector<Peer> & fellowForwarderNodes,
-                                                const boost::multiprecision::uint256_t & blocknum);
-    bool FindTxnInSubmittedTxnsList(const TxBlock & finalblock, 
-                                    const boost::multiprecision::uint256_t & blocknum,
-                                    uint8_t sharing_mode, 
-                                    vector<Transaction> & txns_to_send,
-                                    const TxnHash & tx_hash);
-    bool FindTxnInReceivedTxnsList(const TxBlock & finalblock, 
-                                   const boost::multiprecision::uint256_t & blocknum,
-                                   uint8_t sharing_mode, 
-                                   vector<Transaction> & txns_to_send,
-                                   const TxnHash & tx_hash);
+                                                uint64_t blocknum);
+    bool CommitTxnFromPool(uint64_t blocknum,
+                           uint8_t sharing_mode, 
+                           vector<Transaction> & txns_to_send,
+                           const TxnHash & tx_hash);
     void CommitMyShardsMicroBlock(const TxBlock & finalblock, 
-                                  const boost::multiprecision::uint256_t & blocknum,
+                                  uint64_t blocknum,
                                   uint8_t sharing_mode, 
                                   vector<Transaction> & txns_to_send);
-    void BroadcastTransactionsToSendingAssignment(const boost::multiprecision::uint256_t & blocknum,
+    void BroadcastTransactionsToSendingAssignment(uint64_t blocknum,
                                                   const vector<Peer> & sendingAssignment,
                                                   const TxnHash & microBlockTxHash,
-                                                  vector<Transaction> & txns_to_send) const;
+                                                  vector<Transaction> & txns_to_send);
     void LoadUnavailableMicroBlockTxRootHashes(const TxBlock & finalblock, 
-                                               const boost::multiprecision::uint256_t & blocknum);
+                                               uint64_t blocknum);
     bool IsMicroBlockTxRootHashInFinalBlock(TxnHash microBlockHash,
-                                      const boost::multiprecision::uint256_t & blocknum);
-    bool IsMyShardsMicroBlockTxRootHashInFinalBlock(const boost::multiprecision::uint256_t & blocknum);
+                                      uint64_t blocknum);
+    bool IsMyShardsMicroBlockTxRootHashInFinalBlock(uint64_t blocknum);
     bool ReadAuxilliaryInfoFromFinalBlockMsg(const vector<unsigned char> & message, 
                                              unsigned int & cur_offset, uint8_t & shard_id);
     void StoreFinalBlock(const TxBlock & txBlock);
@@ -201,14 +254,28 @@ class Node : public Executable, public Broadcastable
                                                         uint8_t shard_id);
 
     // internal calls from ProcessForwardTransaction
-    void LoadFwdingAssgnForThisBlockNum(const boost::multiprecision::uint256_t & blocknum, 
+    void LoadFwdingAssgnForThisBlockNum(uint64_t blocknum, 
                                         vector<Peer> & forward_list);
     bool LoadForwardedTxnsAndCheckRoot(const vector<unsigned char> & message,
-                                       unsigned int cur_offset, TxnHash & microBlockTxHash,
+                                       unsigned int cur_offset, 
+                                       uint64_t blocknum,
+                                       TxnHash & microBlockTxHash,
                                        vector<Transaction> & txnsInForwardedMessage);
+    bool IsMicroBlockTxRootHashUnavailable(const TxnHash & microBlockTxHash,
+                                           uint64_t blocknum);
+    void OfferTransactions(uint64_t blocknum, 
+                           const vector<Peer> & peers,
+                           const TxnHash & microBlockTxHash, 
+                           const vector<Transaction> & txns);
+    void SendForwardedTransactions(uint64_t blocknum,
+                                   const Peer & peer,
+                                   const TxnHash & microBlockTxHash,
+                                   uint64_t salt,
+                                   const vector<Transaction> & txns,
+                                   const vector<bool> & include);
     void CommitForwardedTransactions(const vector<Transaction> & txnsInForwardedMessage,
-                                     const boost::multiprecision::uint256_t & blocknum);
-    void DeleteEntryFromFwdingAssgnAndMissingBodyCountMap(const boost::multiprecision::uint256_t & blocknum);
+                                     uint64_t blocknum);
+    void DeleteEntryFromFwdingAssgnAndMissingBodyCountMap(uint64_t blocknum);
     void LogReceivedFinalBlockDetails(const TxBlock & txblock);
 
     // internal calls from ProcessDSBlock
@@ -221,18 +288,32 @@ class Node : public Executable, public Broadcastable
     bool ProcessSharding(const std::vector<unsigned char> & message, unsigned int offset, const Peer & from);
     bool ProcessCreateTransaction(const std::vector<unsigned char> & message, unsigned int offset, const Peer & from);
     bool ProcessSubmitTransaction(const std::vector<unsigned char> & message, unsigned int offset, const Peer & from);
+    bool ProcessSubmitTxnBatch(const std::vector<unsigned char> & message, unsigned int offset, const Peer & from);
     bool ProcessMicroblockConsensus(const std::vector<unsigned char> & message, unsigned int offset, const Peer & from);
     bool ProcessFinalBlock(const std::vector<unsigned char> & message, unsigned int offset, const Peer & from);
+    bool ProcessFinalBlockFragment(const std::vector<unsigned char> & message, unsigned int offset, const Peer & from);
     bool ProcessForwardTransaction(const std::vector<unsigned char> & message, unsigned int offset, const Peer & from);
+    bool ProcessGetMicroBlockTxns(const std::vector<unsigned char> & message, unsigned int offset, const Peer & from);
+    bool ProcessSetMicroBlockTxns(const std::vector<unsigned char> & message, unsigned int offset, const Peer & from);
+    bool ProcessForwardTxnOffer(const std::vector<unsigned char> & message, unsigned int offset, const Peer & from);
+    bool ProcessForwardTxnSketch(const std::vector<unsigned char> & message, unsigned int offset, const Peer & from);
     // bool ProcessCreateAccounts(const std::vector<unsigned char> & message, unsigned int offset, const Peer & from);
     bool ProcessDSBlock(const std::vector<unsigned char> & message, unsigned int offset, const Peer & from);
 
     bool CheckWhetherDSBlockNumIsLatest(const boost::multiprecision::uint256_t dsblock_num);
 
 #ifndef IS_LOOKUP_NODE
+    // Intra-shard broadcast functions
+    void BuildBroadcastTree();
+    void BroadcastToMyShard(const std::vector<unsigned char> & message);
+
     // Transaction functions
     void SubmitTransactions();
     bool CheckCreatedTransaction(const Transaction & tx);
+    bool IsTxnIntakeOpen(const std::function<void()> & replay, bool & parked);
+    void QueueTxnForIntake(const Transaction & tx);
+    void FlushTxnIntake();
+    void VerifyAndPoolTxns(const std::vector<Transaction> & txns);
 
     bool RunConsensusOnMicroBlockWhenShardLeader();
     bool RunConsensusOnMicroBlockWhenShardBackup();
@@ -240,6 +321,10 @@ class Node : public Executable, public Broadcastable
     bool ComposeMicroBlock();
     void ProcessMicroblockConsensusIfPrimary() const;
     bool MicroBlockValidator(const std::vector<unsigned char> & sharding_structure);
+    bool ReconstructMicroBlock(const std::vector<unsigned char> & compact_microblock);
+    bool FetchMissingMicroBlockTxns(const CompactMicroBlock & compactBlock, 
+                                    std::vector<TxnHash> & tranHashes,
+                                    const std::vector<uint32_t> & missing);
     bool CheckLegitimacyOfTxnHashes();
     bool CheckBlockTypeIsMicro();
     bool CheckMicroBlockVersion();
@@ -268,6 +353,13 @@ public:
     /// The current internal state of this Node instance.
     std::atomic<NodeState> m_state;
 
+private:
+    // Replays messages that arrived before the state they need
+    StateNotifier<NodeState> m_stateNotifier;
+    const unsigned int PARKED_MESSAGE_TIMEOUT_IN_SECONDS = 600;
+
+public:
+
     /// Constructor. Requires mediator reference to access DirectoryService and other global members.
     Node(Mediator & mediator);
 
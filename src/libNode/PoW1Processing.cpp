@@ -38,6 +38,7 @@
 #include "libPOW/pow.h"
 #include "libUtils/DataConversion.h"
 #include "libUtils/DetachedFunction.h"
+#include "libUtils/EventLog.h"
 #include "libUtils/Logger.h"
 #include "libUtils/SanityChecks.h"
 #include "libUtils/TimeLockedFunction.h"
@@ -141,8 +142,9 @@ bool Node::ReadVariablesFromStartPoW1Message(const vector<unsigned char> & messa
     // 32-byte rand2
     copy(message.begin() + cur_offset, message.begin() + cur_offset + UINT256_SIZE, rand2.begin());
     cur_offset += UINT256_SIZE;
-    LOG_STATE("[START][EPOCH][" << std::setw(15) << std::left << 
+    LOG_STATE_TEXT("[START][EPOCH][" << std::setw(15) << std::left << 
               m_mediator.m_selfPeer.GetPrintableIPAddress() << "][" << block_num << "]");
+    LOG_EVENT(EVENT_START, PHASE_NONE, block_num, 0, 0);
 
     // Log all values
     // LOG_MESSAGE2(to_string(m_mediator.m_currentEpochNum).c_str(), "My IP address     = " << m_mediator.m_selfPeer.GetPrintableIPAddress());
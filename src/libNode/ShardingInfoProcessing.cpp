@@ -139,6 +139,8 @@ bool Node::ProcessSharding(const vector<unsigned char> & message, unsigned int o
         return false;
     }
 
+    BuildBroadcastTree();
+
     if (m_mediator.m_selfKey.second == m_myShardMembersPubKeys.front())
     {
         m_isPrimary = true;
@@ -177,25 +179,8 @@ bool Node::ProcessSharding(const vector<unsigned char> & message, unsigned int o
 
     // TimeLockedFunction tlf(SUBMIT_TX_WINDOW, main_func, expiry_func, true);
 
-    auto main_func = [this]() mutable -> void { SubmitTransactions(); };
-    DetachedFunction(1, main_func);
-
-    LOG_MESSAGE("I am going to sleep for 15 seconds");
-    this_thread::sleep_for(chrono::seconds(15));
-    LOG_MESSAGE("I have woken up from the sleep of 15 seconds");
-
-    auto main_func2 = [this]() mutable -> void { 
-        unique_lock<shared_timed_mutex> lock(m_mutexProducerConsumer);
-        SetState(TX_SUBMISSION_BUFFER); 
-    };   
-    DetachedFunction(1, main_func2); 
-
-    LOG_MESSAGE("I am going to sleep for 30 seconds");
-    this_thread::sleep_for(chrono::seconds(30));
-    LOG_MESSAGE("I have woken up from the sleep of 30 seconds");
-
-    auto main_func3 = [this]() mutable -> void { RunConsensusOnMicroBlock(); };
-    DetachedFunction(1, main_func3);
+    ScheduleTxnSubmission();
+    ScheduleMicroBlockConsensus();
 
 #endif // IS_LOOKUP_NODE
     return true;
@@ -15,6 +15,7 @@
 **/
 
 
+#include <chrono>
 #include <iostream>
 #include <iomanip>
 #include <ctime>
@@ -23,8 +24,21 @@
 //#include "libCrypto/Sha3.h"
 #include "libCrypto/Sha2.h"
 #include "libUtils/DataConversion.h"
+#include "libUtils/Metrics.h"
 #include "common/Serializable.h"
 
+static void RecordHashRate(uint64_t hashes, std::chrono::steady_clock::time_point start)
+{
+    METRICS_COUNTER("zilliqa_pow_hashes_total", "Ethash evaluations while mining").Increment(hashes);
+
+    auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    if (elapsed_ns > 0)
+    {
+        METRICS_GAUGE("zilliqa_pow_hash_rate", "Hashes per second over the last mining run")
+            .Set(static_cast<int64_t>(hashes * 1e9 / elapsed_ns));
+    }
+}
+
 POW::POW()
 {
     currentBlockNum = 0;
@@ -174,16 +188,20 @@ ethash_return_value_t POW::EthashFullCompute(ethash_full_t & full, ethash_h256_t
 ethash_mining_result_t POW::MineLight(ethash_light_t & light, ethash_h256_t const & header_hash, ethash_h256_t & difficulty)
 {
     uint64_t nonce = std::time(0);
+    const uint64_t start_nonce = nonce;
+    const auto start = std::chrono::steady_clock::now();
     while (shouldMine)
     {
         ethash_return_value_t mineResult = EthashLightCompute(light, header_hash, nonce);
         if(ethash_check_difficulty(&mineResult.result, &difficulty))
         {
+            RecordHashRate(nonce - start_nonce + 1, start);
             ethash_mining_result_t winning_result = {BlockhashToHexString(&mineResult.result), BlockhashToHexString(&mineResult.mix_hash), nonce, true};
             return winning_result;
         }
         nonce++;
     }
+    RecordHashRate(nonce - start_nonce, start);
 
     ethash_mining_result_t failure_result = { "", "", 0, false };
     return failure_result;
@@ -192,16 +210,20 @@ ethash_mining_result_t POW::MineLight(ethash_light_t & light, ethash_h256_t cons
 ethash_mining_result_t POW::MineFull(ethash_full_t & full, ethash_h256_t const & header_hash, ethash_h256_t & difficulty)
 {
     uint64_t nonce = std::time(0);
+    const uint64_t start_nonce = nonce;
+    const auto start = std::chrono::steady_clock::now();
     while (shouldMine)
     {
         ethash_return_value_t mineResult = EthashFullCompute(full, header_hash, nonce);
         if(ethash_check_difficulty(&mineResult.result, &difficulty))
         {
+            RecordHashRate(nonce - start_nonce + 1, start);
             ethash_mining_result_t winning_result = {BlockhashToHexString(&mineResult.result), BlockhashToHexString(&mineResult.mix_hash), nonce, true};
             return winning_result;
         }
         nonce++;
     }
+    RecordHashRate(nonce - start_nonce, start);
 
     ethash_mining_result_t failure_result = { "", "", 0, false };
     return failure_result;
@@ -269,7 +291,7 @@ ethash_mining_result_t POW::PoWMine(const boost::multiprecision::uint256_t & blo
                                     const PubKey & pubKey,
                                     bool fullDataset)
 {
-    LOG_MARKER();
+    TRACE_MARKER();
     // mutex required to prevent a new mining to begin before previous mining operation has ended(ie. shouldMine=false
     // has been processed) and result.success has been returned)
     std::lock_guard<std::mutex> g(m_mutexPoWMine);
@@ -25,23 +25,14 @@
 #include <leveldb/db.h>
 
 #include "BlockStorage.h"
+#include "libUtils/Metrics.h"
 
 using namespace std;
 
-static string ConvertUInt256ToString(boost::multiprecision::uint256_t number) 
+static MetricHistogram & GetLatencyMetric(const char * op, const char * table)
 {
-    if (number == 0) 
-    {
-        return "0";
-    }
-    string result = "";
-    while (number != 0) 
-    {
-        result += to_string( (unsigned int) number % 10 );
-        number /= 10;
-    }
-    reverse(result.begin(), result.end());
-    return result;
+    return Metrics::GetInstance().GetHistogram("zilliqa_storage_latency_seconds", "Block storage read and write latency",
+                                               string("op=\"") + op + "\",table=\"" + table + "\"");
 }
 
 BlockStorage & BlockStorage::GetBlockStorage()
@@ -50,37 +41,41 @@ BlockStorage & BlockStorage::GetBlockStorage()
     return bs;
 }
 
-bool BlockStorage::PutBlock(const boost::multiprecision::uint256_t & blockNum, 
-    const vector<unsigned char> & body, const BlockType & blockType)
+bool BlockStorage::PutBlock(uint64_t blockNum, const vector<unsigned char> & body, const BlockType & blockType)
 {
+    static MetricHistogram & dsLatency = GetLatencyMetric("put", "ds_block");
+    static MetricHistogram & txLatency = GetLatencyMetric("put", "tx_block");
+    MetricTimer timer((blockType == BlockType::DS) ? dsLatency : txLatency);
+
+    // Keys are decimal block numbers, as written when they were uint256_t
     int ret;
     if (blockType == BlockType::DS)
     {
-        ret = m_dsBlockchainDB.Insert(blockNum, body);
+        ret = m_dsBlockchainDB.Insert(to_string(blockNum), body);
     }
     else if (blockType == BlockType::Tx)
     {
-        ret = m_txBlockchainDB.Insert(blockNum, body);
+        ret = m_txBlockchainDB.Insert(to_string(blockNum), body);
     }
     return (ret == 0);
 }
 
-bool BlockStorage::PutDSBlock(const boost::multiprecision::uint256_t & blockNum, 
-    const vector<unsigned char> & body)
+bool BlockStorage::PutDSBlock(uint64_t blockNum, const vector<unsigned char> & body)
 {
     return PutBlock(blockNum, body, BlockType::DS);
 }
 
-bool BlockStorage::PutTxBlock(const boost::multiprecision::uint256_t & blockNum, 
-    const vector<unsigned char> & body)
+bool BlockStorage::PutTxBlock(uint64_t blockNum, const vector<unsigned char> & body)
 {
     return PutBlock(blockNum, body, BlockType::Tx);
 }
 
-bool BlockStorage::GetDSBlock(const boost::multiprecision::uint256_t & blockNum, 
-    DSBlockSharedPtr & block)
+bool BlockStorage::GetDSBlock(uint64_t blockNum, DSBlockSharedPtr & block)
 {
-    string blockString = m_dsBlockchainDB.Lookup(blockNum);
+    static MetricHistogram & latency = GetLatencyMetric("get", "ds_block");
+    MetricTimer timer(latency);
+
+    string blockString = m_dsBlockchainDB.Lookup(to_string(blockNum));
 
     if(blockString.empty())
     {
@@ -95,10 +90,12 @@ bool BlockStorage::GetDSBlock(const boost::multiprecision::uint256_t & blockNum,
     return true;
 }
 
-bool BlockStorage::GetTxBlock(const boost::multiprecision::uint256_t & blockNum, 
-    TxBlockSharedPtr & block)
+bool BlockStorage::GetTxBlock(uint64_t blockNum, TxBlockSharedPtr & block)
 {
-    string blockString = m_txBlockchainDB.Lookup(blockNum);
+    static MetricHistogram & latency = GetLatencyMetric("get", "tx_block");
+    MetricTimer timer(latency);
+
+    string blockString = m_txBlockchainDB.Lookup(to_string(blockNum));
  
     if(blockString.empty())
     {
@@ -113,12 +110,18 @@ bool BlockStorage::GetTxBlock(const boost::multiprecision::uint256_t & blockNum,
 
 bool BlockStorage::PutTxBody(const dev::h256 & key, const vector<unsigned char> & body)
 {
+    static MetricHistogram & latency = GetLatencyMetric("put", "tx_body");
+    MetricTimer timer(latency);
+
     int ret = m_txBodyDB.Insert(key, body);
     return (ret == 0);
 }
 
 bool BlockStorage::GetTxBody(const dev::h256 & key, TxBodySharedPtr & body)
 {
+    static MetricHistogram & latency = GetLatencyMetric("get", "tx_body");
+    MetricTimer timer(latency);
+
     string bodyString = m_txBodyDB.Lookup(key);
     
     if(bodyString.empty())
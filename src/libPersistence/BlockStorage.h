@@ -41,8 +41,7 @@ class BlockStorage
     BlockStorage() : m_metadataDB("metadata"), m_txBodyDB("txBodies"), 
                      m_dsBlockchainDB("dsBlocks"), m_txBlockchainDB("txBlocks") {};
     ~BlockStorage() = default;
-    bool PutBlock(const boost::multiprecision::uint256_t & blockNum, 
-                  const std::vector<unsigned char> & block, const BlockType & blockType);
+    bool PutBlock(uint64_t blockNum, const std::vector<unsigned char> & block, const BlockType & blockType);
 
 public:
 
@@ -50,18 +49,16 @@ public:
     static BlockStorage & GetBlockStorage();
 
     /// Adds a DS block to storage.
-    bool PutDSBlock(const boost::multiprecision::uint256_t & blockNum, 
-                    const std::vector<unsigned char> & block); 
+    bool PutDSBlock(uint64_t blockNum, const std::vector<unsigned char> & block);
 
     /// Adds a Tx block to storage.
-    bool PutTxBlock(const boost::multiprecision::uint256_t & blockNum, 
-                    const std::vector<unsigned char> & block); 
+    bool PutTxBlock(uint64_t blockNum, const std::vector<unsigned char> & block);
 
     /// Retrieves the requested DS block.
-    bool GetDSBlock(const boost::multiprecision::uint256_t & blocknum, DSBlockSharedPtr & block);
+    bool GetDSBlock(uint64_t blocknum, DSBlockSharedPtr & block);
 
     /// Retrieves the requested Tx block.
-    bool GetTxBlock(const boost::multiprecision::uint256_t & blocknum, TxBlockSharedPtr & block);
+    bool GetTxBlock(uint64_t blocknum, TxBlockSharedPtr & block);
 
     /// Adds a transaction body to storage.
     bool PutTxBody(const dev::h256 & key, const std::vector<unsigned char> & body);
@@ -0,0 +1,580 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <algorithm>
+
+#include "EpochSimulator.h"
+#include "common/Constants.h"
+#include "common/Messages.h"
+#include "libConsensus/ConsensusCommon.h"
+#include "libData/BlockData/Block/CompactMicroBlock.h"
+#include "libData/BlockData/Block/DSBlock.h"
+#include "libData/BlockData/Block/MicroBlock.h"
+#include "libData/BlockData/Block/TxBlock.h"
+#include "libNetwork/BroadcastTree.h"
+#include "libUtils/ReedSolomon.h"
+
+using namespace std;
+
+namespace
+{
+    // P2PComm frame header ([1-byte start byte] [4-byte length]) plus the message class and instruction bytes
+    const uint32_t MESSAGE_OVERHEAD = sizeof(uint8_t) + sizeof(uint32_t) + MessageOffset::BODY;
+
+    const uint32_t SIGNATURE_SIZE = SIGNATURE_CHALLENGE_SIZE + SIGNATURE_RESPONSE_SIZE;
+
+    // Consensus message layouts, see ConsensusLeader and ConsensusBackup: [1-byte consensus message type]
+    // [4-byte consensus id] [32-byte blockhash] [2-byte sender id] then the body and a signature
+    const uint32_t CONSENSUS_PREFIX = sizeof(uint8_t) + sizeof(uint32_t) + BLOCK_HASH_SIZE + sizeof(uint16_t);
+    const uint32_t CONSENSUS_COMMIT_SIZE = CONSENSUS_PREFIX + COMMIT_POINT_SIZE + SIGNATURE_SIZE;
+    const uint32_t CONSENSUS_CHALLENGE_SIZE = CONSENSUS_PREFIX + COMMIT_POINT_SIZE + PUB_KEY_SIZE + CHALLENGE_SIZE + SIGNATURE_SIZE;
+    const uint32_t CONSENSUS_RESPONSE_SIZE = CONSENSUS_PREFIX + RESPONSE_SIZE + SIGNATURE_SIZE;
+    const uint32_t CONSENSUS_COLLECTIVE_SIG_SIZE = CONSENSUS_PREFIX + SIGNATURE_SIZE + SIGNATURE_SIZE;
+
+    // Aggregated commits and responses add [1-byte attempt] and the member bitmap
+    const uint32_t CONSENSUS_AGGREGATE_OVERHEAD = sizeof(uint8_t);
+
+    // Final block fragment: header, fragment, then the signature of the DS node that encoded it
+    const uint32_t FRAGMENT_OVERHEAD = FINALBLOCK_FRAGMENT_HEADER_SIZE + SIGNATURE_SIZE;
+
+    // PoW submission: [32-byte block number] [4-byte port] [33-byte pubkey] [8-byte nonce]
+    // [32-byte result] [32-byte mixhash]
+    const uint32_t POW_SUBMISSION_SIZE = UINT256_SIZE + sizeof(uint32_t) + PUB_KEY_SIZE + sizeof(uint64_t) + POW_SIZE + POW_SIZE;
+
+    // Sharding structure entry per shard node: [33-byte pubkey] [16-byte IP] [4-byte port]
+    const uint32_t SHARDING_ENTRY_SIZE = PUB_KEY_SIZE + IP_SIZE + PORT_SIZE;
+
+    // Member bitmap as written by SetBitVector: [2-byte length] [bits]
+    uint32_t GetBitmapSize(unsigned int numMembers)
+    {
+        return sizeof(uint16_t) + GetBitVectorLengthInBytes(numMembers);
+    }
+
+    MicroBlock MakeMicroBlock(unsigned int numTxns, const PubKey & pubKey)
+    {
+        vector<TxnHash> tranHashes(numTxns);
+        for (unsigned int i = 0; i < numTxns; i++)
+        {
+            for (unsigned int b = 0; b < sizeof(uint32_t); b++)
+            {
+                tranHashes.at(i).asArray().at(b) = static_cast<unsigned char>(i >> (8 * b));
+            }
+        }
+
+        MicroBlockHeader header(0, 0, 0, 0, BlockHash(), 0, 0, TxnHash(), numTxns, pubKey, 0, BlockHash());
+        array<unsigned char, BLOCK_SIG_SIZE> signature = {0};
+        return MicroBlock(header, signature, tranHashes);
+    }
+}
+
+/// State of one consensus round. Commits and responses travel up a BroadcastTree over the member
+/// indices rooted at the leader; a flat round is the tree whose fanout covers every backup.
+struct EpochSimulator::Round
+{
+    vector<unsigned int> m_members;
+    BroadcastTree m_tree;
+    unsigned int m_phase;
+    function<void(unsigned int)> m_onMemberDone;
+
+    // Per member and stage: pieces still awaited (its own plus one per child), and signers covered so far
+    vector<unsigned int> m_pending[2];
+    vector<unsigned int> m_signers[2];
+
+    Round(const vector<unsigned int> & members, unsigned int fanout, unsigned int phase,
+          const function<void(unsigned int)> & onMemberDone) :
+        m_members(members), m_tree(members.size(), fanout, 0), m_phase(phase), m_onMemberDone(onMemberDone)
+    {
+        for (unsigned int stage = 0; stage < 2; stage++)
+        {
+            m_pending[stage].resize(members.size());
+            m_signers[stage].assign(members.size(), 0);
+            for (unsigned int i = 0; i < members.size(); i++)
+            {
+                m_pending[stage].at(i) = m_tree.GetChildren(i).size() + ((i == 0) ? 0 : 1);
+            }
+        }
+    }
+};
+
+EpochSimulator::EpochSimulator(const Config & config) : 
+    m_config(config), m_net(config.m_numDSNodes + config.m_numShards * config.m_shardSize, config.m_link, 
+    config.m_seed), m_rng(config.m_seed ^ 0x5A5A5A5A), m_numEvents(0)
+{
+    const PubKey pubKey = Schnorr::GetInstance().GenKeyPair().second;
+    const unsigned int numShardNodes = config.m_numShards * config.m_shardSize;
+
+    m_powSize = MESSAGE_OVERHEAD + POW_SUBMISSION_SIZE;
+
+    // DSBLOCK: [DS block] [32-byte DS block hash] [16-byte winner IP] [4-byte winner port]
+    m_dsBlockSize = MESSAGE_OVERHEAD + DSBlock::GetSerializedSize() + BLOCK_HASH_SIZE + IP_SIZE + PORT_SIZE;
+
+    // SHARDING: [32-byte block number] [4-byte num shards] then per shard [4-byte size] [entries]
+    m_shardingSize = MESSAGE_OVERHEAD + UINT256_SIZE + sizeof(uint32_t) + config.m_numShards * sizeof(uint32_t) + 
+                     numShardNodes * SHARDING_ENTRY_SIZE;
+
+    MicroBlock microBlock = MakeMicroBlock(config.m_txnsPerMicroBlock, pubKey);
+    m_compactMicroBlockSize = MESSAGE_OVERHEAD + CompactMicroBlock(microBlock, 0).GetSerializedSize();
+
+    // MICROBLOCKSUBMISSION: [32-byte DS block number] [4-byte consensus ID] [4-byte shard ID] [microblock]
+    m_microBlockSize = MESSAGE_OVERHEAD + UINT256_SIZE + sizeof(uint32_t) + sizeof(uint32_t) + microBlock.GetSerializedSize();
+
+    vector<TxnHash> microBlockHashes(config.m_numShards);
+    TxBlockHeader header(0, 0, 0, 0, BlockHash(), 0, 0, TxnHash(), config.m_numShards * config.m_txnsPerMicroBlock,
+                         config.m_numShards, pubKey, 0, BlockHash());
+    array<unsigned char, BLOCK_SIG_SIZE> signature = {0};
+    m_finalBlockSize = MESSAGE_OVERHEAD + UINT256_SIZE + sizeof(uint32_t) + sizeof(uint8_t) + 
+                       TxBlock(header, signature, microBlockHashes).GetSerializedSize();
+
+    m_numFragments = min<unsigned int>(config.m_shardSize, ReedSolomon::MAX_FRAGMENTS);
+    m_numFragmentsNeeded = max<unsigned int>(1, m_numFragments / FINALBLOCK_FRAGMENT_REDUNDANCY);
+    m_fragmentSize = MESSAGE_OVERHEAD + FRAGMENT_OVERHEAD + 
+                     ReedSolomon::GetFragmentSize(m_finalBlockSize - MESSAGE_OVERHEAD, m_numFragmentsNeeded);
+}
+
+unsigned int EpochSimulator::GetNumNodes() const
+{
+    return m_config.m_numDSNodes + m_config.m_numShards * m_config.m_shardSize;
+}
+
+unsigned int EpochSimulator::GetShardMember(unsigned int shard, unsigned int index) const
+{
+    return m_config.m_numDSNodes + shard * m_config.m_shardSize + index;
+}
+
+vector<unsigned int> EpochSimulator::GetDSCommittee() const
+{
+    vector<unsigned int> members(m_config.m_numDSNodes);
+    for (unsigned int i = 0; i < members.size(); i++)
+    {
+        members.at(i) = i;
+    }
+    return members;
+}
+
+vector<unsigned int> EpochSimulator::GetShard(unsigned int shard) const
+{
+    vector<unsigned int> members(m_config.m_shardSize);
+    for (unsigned int i = 0; i < members.size(); i++)
+    {
+        members.at(i) = GetShardMember(shard, i);
+    }
+    return members;
+}
+
+unsigned int EpochSimulator::BeginPhase(const string & name, uint64_t startNs)
+{
+    m_phases.push_back({ name, startNs, startNs, 0, 0, 0, 0 });
+    return m_phases.size() - 1;
+}
+
+void EpochSimulator::MarkEnd(unsigned int phase)
+{
+    m_phases.at(phase).m_endNs = max(m_phases.at(phase).m_endNs, m_net.Now());
+}
+
+uint64_t EpochSimulator::GetDelayUntil(uint64_t timeNs) const
+{
+    return (timeNs > m_net.Now()) ? timeNs - m_net.Now() : 0;
+}
+
+uint64_t EpochSimulator::RunUntilIdle()
+{
+    m_numEvents += m_net.Run();
+    return m_net.Now();
+}
+
+void EpochSimulator::RunPoW(const string & name, uint64_t startNs, uint64_t windowNs)
+{
+    const unsigned int phase = BeginPhase(name, startNs);
+    const uint64_t windowEnd = startNs + windowNs;
+    uniform_int_distribution<uint64_t> miningTime(m_config.m_meanPoWNs / 2, m_config.m_meanPoWNs * 3 / 2);
+
+    for (unsigned int node = m_config.m_numDSNodes; node < GetNumNodes(); node++)
+    {
+        m_net.Schedule(GetDelayUntil(startNs) + miningTime(m_rng), [this, node, phase, windowEnd]()
+        {
+            for (unsigned int ds = 0; ds < m_config.m_numDSNodes; ds++)
+            {
+                m_net.Send(node, ds, m_powSize, phase, [this, ds, phase, windowEnd]()
+                {
+                    m_net.Compute(ds, m_config.m_costs.m_powVerifyNs, [this, phase, windowEnd]()
+                    {
+                        if (m_net.Now() > windowEnd)
+                        {
+                            m_phases.at(phase).m_numLate++;
+                        }
+                    });
+                });
+            }
+        });
+    }
+
+    RunUntilIdle();
+
+    // The DS committee waits out the window whether or not every submission is in
+    m_phases.at(phase).m_endNs = windowEnd;
+}
+
+void EpochSimulator::RunConsensus(const vector<unsigned int> & members, uint32_t announcementSize,
+                                  uint64_t validateNs, unsigned int phase,
+                                  const function<void(unsigned int member)> & onMemberDone)
+{
+    const unsigned int fanout = (m_config.m_aggregationFanout > 0) ? m_config.m_aggregationFanout : 
+                                max<unsigned int>(1, members.size() - 1);
+    auto round = make_shared<Round>(members, fanout, phase, onMemberDone);
+    const Costs & costs = m_config.m_costs;
+
+    m_net.Compute(members.at(0), costs.m_signNs, [this, round, announcementSize, validateNs, &costs]()
+    {
+        if (round->m_members.size() == 1)
+        {
+            round->m_onMemberDone(round->m_members.at(0));
+            return;
+        }
+
+        for (unsigned int i = 1; i < round->m_members.size(); i++)
+        {
+            m_net.Send(round->m_members.at(0), round->m_members.at(i), CONSENSUS_PREFIX + announcementSize + 
+                       SIGNATURE_SIZE, round->m_phase, [this, round, i, validateNs, &costs]()
+            {
+                // Check the leader's signature and the proposed block, then sign a commit
+                m_net.Compute(round->m_members.at(i), costs.m_verifyNs + validateNs + costs.m_signNs, 
+                              [this, round, i]()
+                {
+                    Contribute(round, i, false, 1);
+                });
+            });
+        }
+    });
+}
+
+void EpochSimulator::Contribute(const shared_ptr<Round> & round, unsigned int index, bool response,
+                                unsigned int numSigners)
+{
+    const unsigned int stage = response ? 1 : 0;
+    round->m_signers[stage].at(index) += numSigners;
+
+    if (--round->m_pending[stage].at(index) > 0)
+    {
+        return;
+    }
+
+    if (index == 0)
+    {
+        OnCollected(round, response);
+        return;
+    }
+
+    // Combine the children's pieces with our own, sign, and pass the aggregate up
+    const Costs & costs = m_config.m_costs;
+    const unsigned int signers = round->m_signers[stage].at(index);
+    const bool aggregated = !round->m_tree.GetChildren(index).empty();
+    const uint32_t size = MESSAGE_OVERHEAD + (response ? CONSENSUS_RESPONSE_SIZE : CONSENSUS_COMMIT_SIZE) + 
+                          (aggregated ? CONSENSUS_AGGREGATE_OVERHEAD + GetBitmapSize(round->m_members.size()) : 0);
+    const unsigned int parent = round->m_tree.GetParent(index);
+    const uint64_t aggregateNs = aggregated ? signers * costs.m_aggregatePerSignerNs + costs.m_signNs : 0;
+
+    m_net.Compute(round->m_members.at(index), aggregateNs, [this, round, index, parent, size, signers, response]()
+    {
+        m_net.Send(round->m_members.at(index), round->m_members.at(parent), size, round->m_phase, 
+                   [this, round, parent, signers, response]()
+        {
+            // Commits are checked by signature; responses are also checked against their keys and commits
+            m_net.Compute(round->m_members.at(parent), (response ? 2 : 1) * m_config.m_costs.m_verifyNs, 
+                          [this, round, parent, signers, response]()
+            {
+                Contribute(round, parent, response, signers);
+            });
+        });
+    });
+}
+
+void EpochSimulator::OnCollected(const shared_ptr<Round> & round, bool response)
+{
+    const Costs & costs = m_config.m_costs;
+    const unsigned int leader = round->m_members.at(0);
+    const uint64_t aggregateNs = round->m_members.size() * costs.m_aggregatePerSignerNs + costs.m_signNs;
+
+    if (!response)
+    {
+        m_net.Compute(leader, aggregateNs, [this, round, &costs]()
+        {
+            for (unsigned int i = 1; i < round->m_members.size(); i++)
+            {
+                m_net.Send(round->m_members.at(0), round->m_members.at(i), MESSAGE_OVERHEAD + CONSENSUS_CHALLENGE_SIZE, 
+                           round->m_phase, [this, round, i, &costs]()
+                {
+                    m_net.Compute(round->m_members.at(i), costs.m_verifyNs + costs.m_signNs, [this, round, i]()
+                    {
+                        Contribute(round, i, true, 1);
+                    });
+                });
+            }
+        });
+        return;
+    }
+
+    m_net.Compute(leader, aggregateNs, [this, round, &costs]()
+    {
+        const uint32_t size = MESSAGE_OVERHEAD + CONSENSUS_COLLECTIVE_SIG_SIZE + GetBitmapSize(round->m_members.size());
+        for (unsigned int i = 1; i < round->m_members.size(); i++)
+        {
+            m_net.Send(round->m_members.at(0), round->m_members.at(i), size, round->m_phase, 
+                       [this, round, i, &costs]()
+            {
+                // The leader's signature and the collective signature
+                m_net.Compute(round->m_members.at(i), 2 * costs.m_verifyNs, [round, i]()
+                {
+                    round->m_onMemberDone(round->m_members.at(i));
+                });
+            });
+        }
+        round->m_onMemberDone(round->m_members.at(0));
+    });
+}
+
+uint64_t EpochSimulator::RunDSConsensusAndMulticast(const string & name, uint64_t startNs, uint32_t blockSize,
+                                                    uint64_t validateNs)
+{
+    const unsigned int consensus = BeginPhase(name + "/consensus", startNs);
+    const unsigned int multicast = BeginPhase(name + "/multicast", startNs);
+    const unsigned int numDS = m_config.m_numDSNodes;
+    const unsigned int firstShardNode = numDS;
+    bool started = false;
+
+    m_net.Schedule(GetDelayUntil(startNs), [this, consensus, multicast, blockSize, validateNs, numDS, 
+                                           firstShardNode, &started]()
+    {
+        RunConsensus(GetDSCommittee(), blockSize, validateNs, consensus, 
+                     [this, consensus, multicast, blockSize, numDS, firstShardNode, &started](unsigned int ds)
+        {
+            MarkEnd(consensus);
+            if (!started)
+            {
+                m_phases.at(multicast).m_startNs = m_net.Now();
+                started = true;
+            }
+
+            // Each DS node serves an equal share of the shard nodes
+            for (unsigned int node = firstShardNode + ds; node < GetNumNodes(); node += numDS)
+            {
+                m_net.Send(ds, node, blockSize, multicast, [this, node, multicast]()
+                {
+                    m_net.Compute(node, m_config.m_costs.m_verifyNs, [this, multicast]()
+                    {
+                        MarkEnd(multicast);
+                    });
+                });
+            }
+        });
+    });
+
+    RunUntilIdle();
+    return max(m_phases.at(consensus).m_endNs, m_phases.at(multicast).m_endNs);
+}
+
+uint64_t EpochSimulator::RunMicroBlocks(uint64_t startNs)
+{
+    const unsigned int consensus = BeginPhase("microblock/consensus", startNs);
+    const unsigned int submission = BeginPhase("microblock/submission", startNs);
+    const Costs & costs = m_config.m_costs;
+    const uint64_t validateNs = m_config.m_txnsPerMicroBlock * costs.m_txnValidateNs;
+
+    m_net.Schedule(GetDelayUntil(startNs), [this, consensus, submission, validateNs, &costs]()
+    {
+        for (unsigned int shard = 0; shard < m_config.m_numShards; shard++)
+        {
+            const unsigned int leader = GetShardMember(shard, 0);
+
+            RunConsensus(GetShard(shard), m_compactMicroBlockSize, validateNs, consensus, 
+                         [this, leader, consensus, submission, validateNs, &costs](unsigned int member)
+            {
+                MarkEnd(consensus);
+                if (member != leader)
+                {
+                    return;
+                }
+
+                for (unsigned int ds = 0; ds < m_config.m_numDSNodes; ds++)
+                {
+                    m_net.Send(leader, ds, m_microBlockSize, submission, [this, ds, submission, validateNs, &costs]()
+                    {
+                        m_net.Compute(ds, costs.m_verifyNs + validateNs, [this, submission]()
+                        {
+                            MarkEnd(submission);
+                        });
+                    });
+                }
+            });
+        }
+    });
+
+    RunUntilIdle();
+    return m_phases.at(submission).m_endNs;
+}
+
+uint64_t EpochSimulator::RunFinalBlock(uint64_t startNs)
+{
+    const unsigned int consensus = BeginPhase("final_block/consensus", startNs);
+    const unsigned int dissemination = BeginPhase("final_block/fragments", startNs);
+    const unsigned int numDS = m_config.m_numDSNodes;
+    const unsigned int shardSize = m_config.m_shardSize;
+    const uint64_t validateNs = (uint64_t) m_config.m_numShards * m_config.m_txnsPerMicroBlock * 
+                                m_config.m_costs.m_txnValidateNs;
+    bool started = false;
+
+    // Per shard node and fragment: whether it is held (for rebuilding) and whether it has been relayed
+    // (P2PComm drops a broadcast it has already forwarded)
+    const unsigned int numShardNodes = m_config.m_numShards * shardSize;
+    auto held = make_shared<vector<vector<bool>>>(numShardNodes, vector<bool>(m_numFragments, false));
+    auto relayed = make_shared<vector<vector<bool>>>(numShardNodes, vector<bool>(m_numFragments, false));
+    auto numHeld = make_shared<vector<unsigned int>>(numShardNodes, 0);
+    const BroadcastTree tree(shardSize, m_config.m_treeFanout, 0);
+
+    // Hands fragment f to member j of a shard, either straight from the DS committee or as a relay
+    auto receive = make_shared<function<void(unsigned int, unsigned int, unsigned int, bool)>>();
+    *receive = [this, held, relayed, numHeld, tree, shardSize, dissemination, receive]
+               (unsigned int shard, unsigned int j, unsigned int f, bool fromDS)
+    {
+        const unsigned int slot = shard * shardSize + j;
+
+        if (!held->at(slot).at(f))
+        {
+            held->at(slot).at(f) = true;
+            if (++numHeld->at(slot) == m_numFragmentsNeeded)
+            {
+                // Rebuild the block and check its collective signature
+                m_net.Compute(GetShardMember(shard, j), 2 * m_config.m_costs.m_verifyNs, [this, dissemination]()
+                {
+                    MarkEnd(dissemination);
+                });
+            }
+        }
+
+        // Members 0..n-1 relay the fragment they got from the DS committee to the root and their subtree
+        vector<unsigned int> targets;
+        if (fromDS)
+        {
+            if (j >= m_numFragments)
+            {
+                return;
+            }
+            targets = tree.GetChildren(j);
+            if (j != tree.GetRoot())
+            {
+                targets.push_back(tree.GetRoot());
+            }
+        }
+        else
+        {
+            targets = tree.GetChildren(j);
+        }
+
+        if (relayed->at(slot).at(f))
+        {
+            return;
+        }
+        relayed->at(slot).at(f) = true;
+
+        for (unsigned int target : targets)
+        {
+            m_net.Send(GetShardMember(shard, j), GetShardMember(shard, target), m_fragmentSize, dissemination, 
+                       [receive, shard, target, f]()
+            {
+                (*receive)(shard, target, f, false);
+            });
+        }
+    };
+
+    m_net.Schedule(GetDelayUntil(startNs), [this, consensus, dissemination, validateNs, numDS, shardSize, 
+                                           receive, &started]()
+    {
+        RunConsensus(GetDSCommittee(), m_finalBlockSize, validateNs, consensus,
+                     [this, consensus, dissemination, numDS, shardSize, receive, &started](unsigned int ds)
+        {
+            MarkEnd(consensus);
+            if (!started)
+            {
+                m_phases.at(dissemination).m_startNs = m_net.Now();
+                started = true;
+            }
+
+            // Shard member j gets fragment j mod n from DS node j mod numDS
+            for (unsigned int shard = 0; shard < m_config.m_numShards; shard++)
+            {
+                for (unsigned int j = ds; j < shardSize; j += numDS)
+                {
+                    const unsigned int f = j % m_numFragments;
+                    m_net.Send(ds, GetShardMember(shard, j), m_fragmentSize, dissemination, [receive, shard, j, f]()
+                    {
+                        (*receive)(shard, j, f, true);
+                    });
+                }
+            }
+        });
+    });
+
+    RunUntilIdle();
+
+    // Break the self-reference so the closure is freed
+    *receive = nullptr;
+
+    return max(m_phases.at(consensus).m_endNs, m_phases.at(dissemination).m_endNs);
+}
+
+vector<EpochSimulator::PhaseTiming> EpochSimulator::Run()
+{
+    m_phases.clear();
+
+    uint64_t now = 0;
+
+    RunPoW("pow1", now, m_config.m_pow1WindowNs);
+    now = max(m_net.Now(), m_phases.back().m_endNs);
+
+    // Backups check the winning PoW before committing to the DS block
+    now = RunDSConsensusAndMulticast("ds_block", now, m_dsBlockSize, m_config.m_costs.m_powVerifyNs);
+
+    RunPoW("pow2", now, m_config.m_pow2WindowNs);
+    now = max(m_net.Now(), m_phases.back().m_endNs);
+
+    now = RunDSConsensusAndMulticast("sharding", now, m_shardingSize, 0);
+
+    for (unsigned int i = 0; i < m_config.m_numFinalBlocks; i++)
+    {
+        now = RunMicroBlocks(now);
+        now = RunFinalBlock(now);
+    }
+
+    for (unsigned int i = 0; i < m_phases.size(); i++)
+    {
+        SimNetwork::Traffic traffic = m_net.GetTraffic(i);
+        m_phases.at(i).m_numMessages = traffic.m_numMessages;
+        m_phases.at(i).m_numBytes = traffic.m_numBytes;
+        m_phases.at(i).m_numRetransmits = traffic.m_numRetransmits;
+    }
+
+    return m_phases;
+}
+
+uint64_t EpochSimulator::GetMaxEgressBytes() const
+{
+    return m_net.GetMaxEgressBytes();
+}
+
+uint64_t EpochSimulator::GetNumEvents() const
+{
+    return m_numEvents;
+}
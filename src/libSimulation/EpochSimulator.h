@@ -0,0 +1,139 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#ifndef __EPOCHSIMULATOR_H__
+#define __EPOCHSIMULATOR_H__
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "SimNetwork.h"
+
+/// Replays the message flow of one DS epoch over a SimNetwork and times each phase.
+///
+/// The model follows what the nodes in this tree send: PoW submissions to every DS node, DS block and
+/// sharding consensus in the DS committee followed by multicast to the shard nodes, microblock
+/// consensus in every shard (compact announcements, commits and responses aggregated along a
+/// BroadcastTree when the aggregation fanout is set) with submission to the DS committee, and final
+/// block consensus followed by Reed-Solomon fragment dissemination relayed along each shard's
+/// broadcast tree. Message sizes come from serializing real blocks of the configured dimensions.
+/// CPU time is charged per signature, verification and transaction, so results can be calibrated
+/// against the crypto benchmarks of this machine.
+///
+/// Protocol logic itself is not executed: accounts, state and block contents are not simulated.
+class EpochSimulator
+{
+public:
+
+    /// CPU time of the operations that dominate each phase.
+    struct Costs
+    {
+        uint64_t m_signNs;                  // One Schnorr signature
+        uint64_t m_verifyNs;                // One Schnorr verification
+        uint64_t m_aggregatePerSignerNs;    // Aggregating one signer's key, commit or response
+        uint64_t m_powVerifyNs;             // Verifying one PoW submission (light hash)
+        uint64_t m_txnValidateNs;           // Checking or applying one transaction of a block
+    };
+
+    struct Config
+    {
+        unsigned int m_numDSNodes;
+        unsigned int m_numShards;
+        unsigned int m_shardSize;
+        unsigned int m_treeFanout;          // Shard broadcast tree, as in Node::BROADCAST_TREE_FANOUT
+        unsigned int m_aggregationFanout;   // Consensus aggregation tree, 0 = flat
+        unsigned int m_numFinalBlocks;
+        unsigned int m_txnsPerMicroBlock;
+        uint64_t m_pow1WindowNs;
+        uint64_t m_pow2WindowNs;
+        uint64_t m_meanPoWNs;               // Mining time is uniform between half and 1.5 times this
+        Costs m_costs;
+        SimNetwork::LinkConfig m_link;
+        uint64_t m_seed;
+    };
+
+    /// Timing and traffic of one phase. Phases that overlap, like consensus and the dissemination
+    /// that each member starts as soon as it holds the collective signature, have overlapping spans.
+    struct PhaseTiming
+    {
+        std::string m_name;
+        uint64_t m_startNs;
+        uint64_t m_endNs;
+        uint64_t m_numMessages;
+        uint64_t m_numBytes;
+        uint64_t m_numRetransmits;
+        unsigned int m_numLate;             // PoW submissions verified after the window closed
+    };
+
+    /// Constructor.
+    explicit EpochSimulator(const Config & config);
+
+    /// Simulates one DS epoch and returns its phases in order.
+    std::vector<PhaseTiming> Run();
+
+    /// Returns the largest number of bytes sent by any node.
+    uint64_t GetMaxEgressBytes() const;
+
+    /// Returns the number of events executed.
+    uint64_t GetNumEvents() const;
+
+private:
+
+    struct Round;
+
+    const Config m_config;
+    SimNetwork m_net;
+    std::mt19937_64 m_rng;
+    std::vector<PhaseTiming> m_phases;
+    uint64_t m_numEvents;
+
+    // Wire sizes, including the 2-byte class/instruction prefix
+    uint32_t m_powSize;
+    uint32_t m_dsBlockSize;
+    uint32_t m_shardingSize;
+    uint32_t m_compactMicroBlockSize;
+    uint32_t m_microBlockSize;
+    uint32_t m_finalBlockSize;
+    uint32_t m_fragmentSize;
+    unsigned int m_numFragments;
+    unsigned int m_numFragmentsNeeded;
+
+    unsigned int GetNumNodes() const;
+    unsigned int GetShardMember(unsigned int shard, unsigned int index) const;
+    std::vector<unsigned int> GetDSCommittee() const;
+    std::vector<unsigned int> GetShard(unsigned int shard) const;
+
+    unsigned int BeginPhase(const std::string & name, uint64_t startNs);
+    void MarkEnd(unsigned int phase);
+    uint64_t GetDelayUntil(uint64_t timeNs) const;
+    uint64_t RunUntilIdle();
+
+    void RunPoW(const std::string & name, uint64_t startNs, uint64_t windowNs);
+    void RunConsensus(const std::vector<unsigned int> & members, uint32_t announcementSize, uint64_t validateNs,
+                      unsigned int phase, const std::function<void(unsigned int member)> & onMemberDone);
+    void Contribute(const std::shared_ptr<Round> & round, unsigned int index, bool response, unsigned int numSigners);
+    void OnCollected(const std::shared_ptr<Round> & round, bool response);
+    uint64_t RunDSConsensusAndMulticast(const std::string & name, uint64_t startNs, uint32_t blockSize,
+                                        uint64_t validateNs);
+    uint64_t RunMicroBlocks(uint64_t startNs);
+    uint64_t RunFinalBlock(uint64_t startNs);
+};
+
+#endif // __EPOCHSIMULATOR_H__
@@ -0,0 +1,129 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <algorithm>
+
+#include "SimNetwork.h"
+
+using namespace std;
+
+SimNetwork::SimNetwork(unsigned int numNodes, const LinkConfig & link, uint64_t seed) : 
+    m_link(link), m_rng(seed), m_now(0), m_nextSeq(0), m_egressFree(numNodes, 0), m_ingressFree(numNodes, 0),
+    m_cpuFree(numNodes, 0), m_egressBytes(numNodes, 0)
+{
+}
+
+uint64_t SimNetwork::Now() const
+{
+    return m_now;
+}
+
+void SimNetwork::ScheduleAt(uint64_t time, Handler handler)
+{
+    m_events.push({ time, m_nextSeq++, move(handler) });
+}
+
+void SimNetwork::Schedule(uint64_t delayNs, Handler handler)
+{
+    ScheduleAt(m_now + delayNs, move(handler));
+}
+
+uint64_t SimNetwork::GetTransmitTime(uint32_t numBytes) const
+{
+    return (m_link.m_bandwidthBps == 0) ? 0 : (uint64_t) numBytes * 8 * 1000000000 / m_link.m_bandwidthBps;
+}
+
+void SimNetwork::Send(unsigned int from, unsigned int to, uint32_t numBytes, unsigned int category,
+                      Handler onDeliver)
+{
+    const uint64_t transmitTime = GetTransmitTime(numBytes);
+
+    const uint64_t egressStart = max(m_now, m_egressFree.at(from));
+    m_egressFree.at(from) = egressStart + transmitTime;
+
+    uint64_t delay = m_link.m_latencyNs;
+    if (m_link.m_jitterNs > 0)
+    {
+        delay += uniform_int_distribution<uint64_t>(0, m_link.m_jitterNs)(m_rng);
+    }
+
+    unsigned int numRetransmits = 0;
+    if (m_link.m_lossRate > 0)
+    {
+        bernoulli_distribution lost(m_link.m_lossRate);
+        while ((numRetransmits < MAX_RETRANSMITS) && lost(m_rng))
+        {
+            numRetransmits++;
+        }
+        delay += numRetransmits * m_link.m_retransmitNs;
+    }
+
+    // The receiver takes the bytes no faster than its own link allows, after earlier arrivals
+    const uint64_t ingressStart = max(egressStart + delay, m_ingressFree.at(to));
+    const uint64_t delivered = max(ingressStart + transmitTime, m_egressFree.at(from) + delay);
+    m_ingressFree.at(to) = delivered;
+
+    m_egressBytes.at(from) += numBytes;
+    if (category >= m_traffic.size())
+    {
+        m_traffic.resize(category + 1, { 0, 0, 0 });
+    }
+    m_traffic.at(category).m_numMessages++;
+    m_traffic.at(category).m_numBytes += numBytes;
+    m_traffic.at(category).m_numRetransmits += numRetransmits;
+
+    ScheduleAt(delivered, move(onDeliver));
+}
+
+void SimNetwork::Compute(unsigned int node, uint64_t costNs, Handler onDone)
+{
+    const uint64_t done = max(m_now, m_cpuFree.at(node)) + costNs;
+    m_cpuFree.at(node) = done;
+    ScheduleAt(done, move(onDone));
+}
+
+uint64_t SimNetwork::Run()
+{
+    uint64_t numEvents = 0;
+
+    while (!m_events.empty())
+    {
+        // The handler may schedule more events, so take it out of the queue first
+        Event event = move(const_cast<Event &>(m_events.top()));
+        m_events.pop();
+
+        m_now = event.m_time;
+        event.m_handler();
+        numEvents++;
+    }
+
+    return numEvents;
+}
+
+SimNetwork::Traffic SimNetwork::GetTraffic(unsigned int category) const
+{
+    return (category < m_traffic.size()) ? m_traffic.at(category) : Traffic({ 0, 0, 0 });
+}
+
+uint64_t SimNetwork::GetMaxEgressBytes() const
+{
+    return m_egressBytes.empty() ? 0 : *max_element(m_egressBytes.begin(), m_egressBytes.end());
+}
+
+unsigned int SimNetwork::GetNumNodes() const
+{
+    return m_egressFree.size();
+}
@@ -0,0 +1,130 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#ifndef __SIMNETWORK_H__
+#define __SIMNETWORK_H__
+
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <random>
+#include <vector>
+
+/// Discrete-event network of nodes that share one virtual clock.
+///
+/// Nothing sleeps or touches a socket: sends and computations are turned into events at the virtual
+/// time they would complete, and Run() executes events in time order. Ties are broken by scheduling
+/// order, so a run is fully determined by its inputs and the seed.
+///
+/// A message first queues behind earlier sends on the sender's egress link, then travels for the
+/// link latency plus jitter, then queues on the receiver's ingress link. Links model the TCP
+/// connections P2PComm uses, so a lost segment delays the message by a retransmission timeout
+/// instead of dropping it. Ingress slots are reserved when a message is sent rather than when it
+/// arrives, which is exact unless messages overtake each other in flight.
+///
+/// Each node has one CPU. Compute() queues work behind the node's earlier work.
+class SimNetwork
+{
+public:
+
+    /// Properties shared by every node's network link.
+    struct LinkConfig
+    {
+        uint64_t m_latencyNs;       // One-way propagation delay
+        uint64_t m_jitterNs;        // Uniformly distributed extra delay, up to this much
+        uint64_t m_bandwidthBps;    // Egress and ingress capacity of each node, in bits per second
+        double m_lossRate;          // Probability that a transmission attempt is lost
+        uint64_t m_retransmitNs;    // Delay added by each lost attempt
+    };
+
+    /// Traffic counters for one category of messages.
+    struct Traffic
+    {
+        uint64_t m_numMessages;
+        uint64_t m_numBytes;
+        uint64_t m_numRetransmits;
+    };
+
+    using Handler = std::function<void()>;
+
+    /// Largest number of lost attempts before a message is delivered anyway.
+    static const unsigned int MAX_RETRANSMITS = 8;
+
+    /// Constructor.
+    SimNetwork(unsigned int numNodes, const LinkConfig & link, uint64_t seed);
+
+    /// Returns the virtual time in nanoseconds.
+    uint64_t Now() const;
+
+    /// Runs handler after delayNs of virtual time.
+    void Schedule(uint64_t delayNs, Handler handler);
+
+    /// Sends numBytes from one node to another and runs onDeliver once the last byte is received.
+    /// The message is counted under the given category.
+    void Send(unsigned int from, unsigned int to, uint32_t numBytes, unsigned int category, Handler onDeliver);
+
+    /// Occupies a node's CPU for costNs and runs onDone when the work completes.
+    void Compute(unsigned int node, uint64_t costNs, Handler onDone);
+
+    /// Executes events in time order until none are left. Returns the number executed.
+    uint64_t Run();
+
+    /// Returns the traffic sent so far under a category.
+    Traffic GetTraffic(unsigned int category) const;
+
+    /// Returns the largest number of bytes any single node has sent.
+    uint64_t GetMaxEgressBytes() const;
+
+    /// Returns the number of nodes.
+    unsigned int GetNumNodes() const;
+
+private:
+
+    struct Event
+    {
+        uint64_t m_time;
+        uint64_t m_seq;
+        Handler m_handler;
+    };
+
+    struct EventOrder
+    {
+        bool operator()(const Event & a, const Event & b) const
+        {
+            return (a.m_time != b.m_time) ? (a.m_time > b.m_time) : (a.m_seq > b.m_seq);
+        }
+    };
+
+    const LinkConfig m_link;
+    std::mt19937_64 m_rng;
+
+    uint64_t m_now;
+    uint64_t m_nextSeq;
+    std::priority_queue<Event, std::vector<Event>, EventOrder> m_events;
+
+    // Virtual time at which each node's egress link, ingress link and CPU next become free
+    std::vector<uint64_t> m_egressFree;
+    std::vector<uint64_t> m_ingressFree;
+    std::vector<uint64_t> m_cpuFree;
+
+    std::vector<uint64_t> m_egressBytes;
+    std::vector<Traffic> m_traffic;
+
+    void ScheduleAt(uint64_t time, Handler handler);
+    uint64_t GetTransmitTime(uint32_t numBytes) const;
+};
+
+#endif // __SIMNETWORK_H__
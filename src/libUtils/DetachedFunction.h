@@ -19,46 +19,25 @@
 #define __DETACHEDFUNCTION_H__
 
 #include <functional>
-#include <thread>
-#include "libUtils/Logger.h"
+#include "libUtils/Executor.h"
 
-/// Utility class for executing a function in one or more separate detached threads.
+/// Utility class for executing a function one or more times without waiting for it.
+/// The calls run on the Executor's blocking pool instead of on newly created threads.
 class DetachedFunction
 {
 public:
 
-    /// Retry limit for launching the detached threads.
-    const static int MaxAttempt = 3;
-
     /// Template constructor.
     template <class callable, class... arguments>
     DetachedFunction(int num_threads, callable&& f, arguments&&... args)
     {
-        std::function<typename std::result_of<callable(arguments...)>::type()> task(std::bind(std::forward<callable>(f), std::forward<arguments>(args)...));
-
-        int attemp_flag = false;
+        std::function<void()> task(std::bind(std::forward<callable>(f), std::forward<arguments>(args)...));
 
         for (int i = 0; i < num_threads; i++)
         {
-            for (int j = 0; j < MaxAttempt; j++)
-            {
-                try 
-                {
-                    if (attemp_flag == false)
-                    {
-                        std::thread(task).detach(); // attempt to detach a non-thread
-                        attemp_flag = true;
-                    }
-                } 
-                catch(const std::system_error& e) 
-                {
-                    LOG_MESSAGE("Error: " << j << " times tried. Caught system_error with code " << e.code() << " meaning " << e.what() << '\n');
-                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
-                }
-            }
-            attemp_flag = false;
+            Executor::GetInstance().PostBlocking(task);
         }
     }
 };
 
-#endif // __DETACHEDFUNCTION_H__
\ No newline at end of file
+#endif // __DETACHEDFUNCTION_H__
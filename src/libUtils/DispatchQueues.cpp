@@ -0,0 +1,201 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include "DispatchQueues.h"
+
+#include <sstream>
+
+#include "libUtils/Logger.h"
+#include "libUtils/Metrics.h"
+
+using namespace std;
+
+const unsigned int DispatchQueues::NUM_WAIT_BUCKETS;
+
+DispatchQueues::DispatchQueues(const vector<ClassConfig> & configs) : m_stop(false)
+{
+    for (const auto & config : configs)
+    {
+        unique_ptr<Queue> queue(new Queue());
+        queue->m_config = config;
+        queue->m_stats = ClassStats();
+
+        const string labels = "class=\"" + config.m_name + "\"";
+        queue->m_waitMetric = &Metrics::GetInstance().GetHistogram("zilliqa_dispatch_wait_seconds",
+                                                                  "Time messages wait in a dispatch queue", labels);
+        queue->m_droppedMetric = &Metrics::GetInstance().GetCounter("zilliqa_dispatch_dropped_total",
+                                                                   "Messages dropped by a full dispatch queue", labels);
+        queue->m_depthMetric = &Metrics::GetInstance().GetGauge("zilliqa_dispatch_depth",
+                                                               "Messages waiting in a dispatch queue", labels);
+        m_queues.push_back(move(queue));
+    }
+
+    for (auto & queue : m_queues)
+    {
+        for (unsigned int i = 0; i < max(queue->m_config.m_numWorkers, 1u); i++)
+        {
+            queue->m_workers.emplace_back(&DispatchQueues::WorkerLoop, this, ref(*queue));
+        }
+    }
+}
+
+DispatchQueues::~DispatchQueues()
+{
+    m_stop = true;
+
+    for (auto & queue : m_queues)
+    {
+        {
+            lock_guard<mutex> g(queue->m_mutex);
+            queue->m_cvNotEmpty.notify_all();
+            queue->m_cvNotFull.notify_all();
+        }
+        for (auto & worker : queue->m_workers)
+        {
+            worker.join();
+        }
+    }
+}
+
+bool DispatchQueues::Push(unsigned int cls, Task task)
+{
+    if (cls >= m_queues.size())
+    {
+        LOG_MESSAGE("Error: Unknown dispatch class " << cls);
+        return false;
+    }
+
+    Queue & queue = *m_queues.at(cls);
+
+    unique_lock<mutex> lock(queue.m_mutex);
+
+    if (queue.m_items.size() >= queue.m_config.m_capacity)
+    {
+        if (queue.m_config.m_policy == DROP_NEWEST)
+        {
+            queue.m_stats.m_dropped++;
+            queue.m_droppedMetric->Increment();
+            return false;
+        }
+
+        queue.m_cvNotFull.wait(lock, [this, &queue] { return m_stop || (queue.m_items.size() < queue.m_config.m_capacity); });
+        if (m_stop)
+        {
+            return false;
+        }
+    }
+
+    queue.m_items.push_back(Item{ move(task), Clock::now() });
+    queue.m_stats.m_pushed++;
+    queue.m_stats.m_depth = queue.m_items.size();
+    queue.m_stats.m_maxDepth = max(queue.m_stats.m_maxDepth, queue.m_stats.m_depth);
+    queue.m_depthMetric->Set(queue.m_stats.m_depth);
+    queue.m_cvNotEmpty.notify_one();
+
+    return true;
+}
+
+void DispatchQueues::WorkerLoop(Queue & queue)
+{
+    while (true)
+    {
+        Item item;
+
+        {
+            unique_lock<mutex> lock(queue.m_mutex);
+            queue.m_cvNotEmpty.wait(lock, [this, &queue] { return m_stop || !queue.m_items.empty(); });
+            if (m_stop)
+            {
+                return;
+            }
+
+            item = move(queue.m_items.front());
+            queue.m_items.pop_front();
+            queue.m_stats.m_depth = queue.m_items.size();
+            queue.m_depthMetric->Set(queue.m_stats.m_depth);
+
+            const Clock::duration wait = Clock::now() - item.m_queued;
+            queue.m_stats.m_waitHistogram[GetWaitBucket(wait)]++;
+            queue.m_waitMetric->Record(wait);
+            queue.m_cvNotFull.notify_one();
+        }
+
+        try
+        {
+            item.m_task();
+        }
+        catch (const exception & e)
+        {
+            LOG_MESSAGE("Error: Exception in " << queue.m_config.m_name << " handler: " << e.what());
+        }
+        catch (const char * e)
+        {
+            LOG_MESSAGE("Error: " << queue.m_config.m_name << " handler threw: " << e);
+        }
+        catch (...)
+        {
+            // Letting this escape the worker thread would terminate the process
+            LOG_MESSAGE("Error: Unknown exception in " << queue.m_config.m_name << " handler");
+        }
+
+        lock_guard<mutex> g(queue.m_mutex);
+        queue.m_stats.m_processed++;
+    }
+}
+
+unsigned int DispatchQueues::GetWaitBucket(Clock::duration wait)
+{
+    const auto ms = chrono::duration_cast<chrono::milliseconds>(wait).count();
+
+    unsigned int bucket = 0;
+    while ((bucket < NUM_WAIT_BUCKETS - 1) && (ms >= (1LL << bucket)))
+    {
+        bucket++;
+    }
+
+    return bucket;
+}
+
+DispatchQueues::ClassStats DispatchQueues::GetStats(unsigned int cls) const
+{
+    const Queue & queue = *m_queues.at(cls);
+    lock_guard<mutex> g(queue.m_mutex);
+    return queue.m_stats;
+}
+
+void DispatchQueues::LogStats() const
+{
+    for (unsigned int i = 0; i < m_queues.size(); i++)
+    {
+        const ClassStats stats = GetStats(i);
+
+        ostringstream histogram;
+        for (unsigned int j = 0; j < NUM_WAIT_BUCKETS; j++)
+        {
+            histogram << " " << stats.m_waitHistogram[j];
+        }
+
+        LOG_MESSAGE("Dispatch " << m_queues.at(i)->m_config.m_name << ": depth " << stats.m_depth << 
+                    " (max " << stats.m_maxDepth << "), pushed " << stats.m_pushed << ", dropped " << 
+                    stats.m_dropped << ", processed " << stats.m_processed << ", wait ms [<1 <2 <4 ... >=1024]:" << 
+                    histogram.str());
+    }
+}
+
+unsigned int DispatchQueues::GetNumClasses() const
+{
+    return m_queues.size();
+}
@@ -0,0 +1,123 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#ifndef __DISPATCHQUEUES_H__
+#define __DISPATCHQUEUES_H__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+class MetricCounter;
+class MetricGauge;
+class MetricHistogram;
+
+/// Bounded work queues, one per message class, each served by its own worker threads.
+///
+/// A slow or flooded class only holds up its own workers, so e.g. a burst of transactions cannot delay
+/// consensus messages queued behind it. When a queue is full, Push() either waits for room (BLOCK,
+/// which pushes back on the receiving socket thread) or drops the new item (DROP_NEWEST).
+class DispatchQueues
+{
+public:
+
+    using Task = std::function<void()>;
+    using Clock = std::chrono::steady_clock;
+
+    enum OverflowPolicy : unsigned char
+    {
+        BLOCK = 0x00,
+        DROP_NEWEST
+    };
+
+    /// Settings for one class.
+    struct ClassConfig
+    {
+        std::string m_name;
+        unsigned int m_numWorkers;
+        size_t m_capacity;
+        OverflowPolicy m_policy;
+    };
+
+    /// Number of wait-time histogram buckets. Bucket i counts waits under 2^i ms; the last counts the rest.
+    static const unsigned int NUM_WAIT_BUCKETS = 12;
+
+    /// Counters for one class.
+    struct ClassStats
+    {
+        size_t m_depth;
+        size_t m_maxDepth;
+        uint64_t m_pushed;
+        uint64_t m_dropped;
+        uint64_t m_processed;
+        uint64_t m_waitHistogram[NUM_WAIT_BUCKETS];
+    };
+
+    /// Constructor. Starts the workers of every class.
+    explicit DispatchQueues(const std::vector<ClassConfig> & configs);
+
+    /// Destructor. Stops the workers; queued items that have not started are discarded.
+    ~DispatchQueues();
+
+    /// Queues the task on the given class. Returns false if it was dropped.
+    bool Push(unsigned int cls, Task task);
+
+    /// Returns a snapshot of the counters of the given class.
+    ClassStats GetStats(unsigned int cls) const;
+
+    /// Logs the counters of every class.
+    void LogStats() const;
+
+    /// Returns the number of classes.
+    unsigned int GetNumClasses() const;
+
+private:
+
+    struct Item
+    {
+        Task m_task;
+        Clock::time_point m_queued;
+    };
+
+    struct Queue
+    {
+        ClassConfig m_config;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_cvNotEmpty;
+        std::condition_variable m_cvNotFull;
+        std::deque<Item> m_items;
+        ClassStats m_stats;
+        std::vector<std::thread> m_workers;
+        MetricHistogram * m_waitMetric;
+        MetricCounter * m_droppedMetric;
+        MetricGauge * m_depthMetric;
+    };
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::atomic<bool> m_stop;
+
+    void WorkerLoop(Queue & queue);
+    static unsigned int GetWaitBucket(Clock::duration wait);
+};
+
+#endif // __DISPATCHQUEUES_H__
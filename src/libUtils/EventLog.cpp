@@ -0,0 +1,151 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include "EventLog.h"
+#include "Logger.h"
+
+using namespace std;
+
+static_assert(sizeof(EventRecord) == 48, "EventRecord layout must stay fixed");
+static_assert(sizeof(EventLogHeader) == 64, "EventLogHeader layout must stay fixed");
+
+EventLog::EventLog() : m_header(nullptr), m_records(nullptr), m_mappedSize(0), m_node(0), m_port(0)
+{
+}
+
+EventLog::~EventLog()
+{
+    if (m_header != nullptr)
+    {
+        msync(m_header, m_mappedSize, MS_ASYNC);
+        munmap(m_header, m_mappedSize);
+    }
+}
+
+EventLog & EventLog::GetInstance()
+{
+    static EventLog eventlog;
+    return eventlog;
+}
+
+bool EventLog::Init(const string & fname, uint32_t node, uint16_t port, uint64_t capacity)
+{
+    if (m_header != nullptr)
+    {
+        return true;
+    }
+
+    // Record() takes the write index modulo the capacity
+    if (capacity == 0)
+    {
+        LOG_MESSAGE("Error: Event log " << fname << " needs a capacity of at least one record");
+        return false;
+    }
+
+    size_t mappedSize = sizeof(EventLogHeader) + capacity * sizeof(EventRecord);
+
+    int fd = open(fname.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        LOG_MESSAGE("Error: Failed to open event log " << fname);
+        return false;
+    }
+
+    if (ftruncate(fd, mappedSize) != 0)
+    {
+        LOG_MESSAGE("Error: Failed to size event log " << fname);
+        close(fd);
+        return false;
+    }
+
+    void * addr = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (addr == MAP_FAILED)
+    {
+        LOG_MESSAGE("Error: Failed to map event log " << fname);
+        return false;
+    }
+
+    EventLogHeader * header = static_cast<EventLogHeader *>(addr);
+    header->m_magic = MAGIC;
+    header->m_version = VERSION;
+    header->m_recordSize = sizeof(EventRecord);
+    header->m_capacity = capacity;
+    header->m_writeIndex.store(0);
+
+    m_node = node;
+    m_port = port;
+    m_mappedSize = mappedSize;
+    m_records = reinterpret_cast<EventRecord *>(header + 1);
+    m_header = header;
+
+    return true;
+}
+
+void EventLog::Record(EventId event, EventPhase phase, uint64_t epoch, uint64_t payload0, uint64_t payload1)
+{
+    if (m_header == nullptr)
+    {
+        return;
+    }
+
+    uint64_t index = m_header->m_writeIndex.fetch_add(1, memory_order_relaxed);
+    EventRecord & record = m_records[index % m_header->m_capacity];
+
+    // Invalidate first so a reader never pairs the old sequence with new fields
+    __atomic_store_n(&record.m_sequence, 0, __ATOMIC_RELAXED);
+    atomic_thread_fence(memory_order_release);
+
+    record.m_timestamp = chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count();
+    record.m_epoch = epoch;
+    record.m_payload[0] = payload0;
+    record.m_payload[1] = payload1;
+    record.m_node = m_node;
+    record.m_port = m_port;
+    record.m_event = event;
+    record.m_phase = phase;
+
+    __atomic_store_n(&record.m_sequence, index + 1, __ATOMIC_RELEASE);
+}
+
+const char * EventLog::GetEventName(uint8_t event)
+{
+    static const char * names[EVENT_COUNT] = 
+    {
+        "BROAD", "TXNSE", "MICRO", "MICON", "FINBK", "FBCON", "DSCON", 
+        "SHCON", "TXBOD", "START", "STATS", "POW1R", "POW2R"
+    };
+
+    return (event < EVENT_COUNT) ? names[event] : "UNKWN";
+}
+
+const char * EventLog::GetPhaseName(uint8_t phase)
+{
+    static const char * names[PHASE_COUNT] = 
+    {
+        "", "BEGN", "RECV", "DONE", "SENT", "FRST", "LAST", "CONT", "PROPOSED", "FINAL"
+    };
+
+    return (phase < PHASE_COUNT) ? names[phase] : "UNKWN";
+}
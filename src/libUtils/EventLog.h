@@ -0,0 +1,141 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#ifndef __EVENTLOG_H__
+#define __EVENTLOG_H__
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+/// Event identifiers, mirroring the tags used in the text state log.
+enum EventId : uint8_t
+{
+    EVENT_BROAD = 0,    // broadcast propagation
+    EVENT_TXNSE,        // transactions sent to shard
+    EVENT_MICRO,        // microblock submission
+    EVENT_MICON,        // microblock consensus
+    EVENT_FINBK,        // final block received
+    EVENT_FBCON,        // final block consensus
+    EVENT_DSCON,        // DS block consensus
+    EVENT_SHCON,        // sharding consensus
+    EVENT_TXBOD,        // transaction body sharing
+    EVENT_START,        // PoW1 epoch start
+    EVENT_STATS,        // microblock / final block transaction counts
+    EVENT_POW1R,        // PoW1 submissions received
+    EVENT_POW2R,        // PoW2 submissions received
+    EVENT_COUNT
+};
+
+/// Event phases, mirroring the suffixes used in the text state log.
+enum EventPhase : uint8_t
+{
+    PHASE_NONE = 0,
+    PHASE_BEGN,
+    PHASE_RECV,
+    PHASE_DONE,
+    PHASE_SENT,
+    PHASE_FRST,
+    PHASE_LAST,
+    PHASE_CONT,
+    PHASE_PROPOSED,
+    PHASE_FINAL,
+    PHASE_COUNT
+};
+
+/// Fixed-size binary event record (48 bytes).
+struct EventRecord
+{
+    /// Ring position + 1, written last; a mismatch means the record is torn or stale.
+    uint64_t m_sequence;
+
+    /// Monotonic (steady clock) time in nanoseconds.
+    uint64_t m_timestamp;
+
+    uint64_t m_epoch;
+    uint64_t m_payload[2];
+
+    /// Reporting node IPv4 address (net-encoded) and listen port.
+    uint32_t m_node;
+    uint16_t m_port;
+
+    uint8_t m_event;
+    uint8_t m_phase;
+};
+
+/// Header at the start of the memory-mapped event file.
+struct EventLogHeader
+{
+    uint64_t m_magic;
+    uint32_t m_version;
+    uint32_t m_recordSize;
+    uint64_t m_capacity;
+    std::atomic<uint64_t> m_writeIndex;
+    uint8_t m_reserved[32];
+};
+
+/// Structured binary event log backed by a memory-mapped ring file.
+/// Recording an event is one atomic increment and a 48-byte store; no formatting or I/O
+/// happens on the calling thread. Use the readevents tool to convert the file to CSV/JSON.
+class EventLog
+{
+    EventLogHeader * m_header;
+    EventRecord * m_records;
+    size_t m_mappedSize;
+    uint32_t m_node;
+    uint16_t m_port;
+
+    EventLog();
+    ~EventLog();
+
+public:
+
+    /// File signature ("ZILEVT01").
+    static const uint64_t MAGIC = 0x31305456454C495AULL;
+
+    static const uint32_t VERSION = 1;
+
+    /// Default number of records kept before the ring wraps around.
+    static const uint64_t DEFAULT_CAPACITY = 1 << 20;
+
+    /// Returns the singleton instance.
+    static EventLog & GetInstance();
+
+    /// Creates (or truncates) and maps the event file. Events are dropped until this succeeds.
+    /// Returns false for a capacity of 0.
+    bool Init(const std::string & fname, uint32_t node, uint16_t port, uint64_t capacity = DEFAULT_CAPACITY);
+
+    /// Appends one event to the ring.
+    void Record(EventId event, EventPhase phase, uint64_t epoch, uint64_t payload0 = 0, uint64_t payload1 = 0);
+
+    /// Returns the short tag for an event identifier.
+    static const char * GetEventName(uint8_t event);
+
+    /// Returns the short tag for an event phase.
+    static const char * GetPhaseName(uint8_t phase);
+};
+
+#define INIT_EVENT_LOG(fname, node, port) EventLog::GetInstance().Init(fname, node, port)
+#define LOG_EVENT(event, phase, epoch, payload0, payload1) EventLog::GetInstance().Record(event, phase, static_cast<uint64_t>(epoch), static_cast<uint64_t>(payload0), static_cast<uint64_t>(payload1))
+
+// Text state lines that a LOG_EVENT already records are only formatted when built with STATE_TEXT_LOG
+#ifdef STATE_TEXT_LOG
+#define LOG_STATE_TEXT(msg) LOG_STATE(msg)
+#else
+#define LOG_STATE_TEXT(msg)
+#endif // STATE_TEXT_LOG
+
+#endif // __EVENTLOG_H__
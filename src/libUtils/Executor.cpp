@@ -0,0 +1,250 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include "Executor.h"
+#include "Logger.h"
+
+using namespace std;
+
+namespace
+{
+    // Index of the work-stealing worker running on this thread, or -1
+    thread_local int t_workerIndex = -1;
+
+    void RunTask(const Executor::Task & task)
+    {
+        try
+        {
+            task();
+        }
+        catch (const std::exception & e)
+        {
+            LOG_MESSAGE("Error: Executor task threw exception: " << e.what());
+        }
+        catch (const char * e)
+        {
+            LOG_MESSAGE("Error: Executor task threw: " << e);
+        }
+        catch (...)
+        {
+            // A worker that lets this escape would take the whole process down
+            LOG_MESSAGE("Error: Executor task threw unknown exception");
+        }
+    }
+}
+
+const unsigned int Executor::MAX_BLOCKING_THREADS;
+const unsigned int Executor::BLOCKING_THREAD_IDLE_SECONDS;
+
+Executor::Executor() : m_nextWorker(0), m_pendingTasks(0), m_sleepingWorkers(0), m_blockingThreads(0),
+                       m_idleBlockingThreads(0)
+{
+    unsigned int numWorkers = max(1u, thread::hardware_concurrency());
+
+    for (unsigned int i = 0; i < numWorkers; i++)
+    {
+        m_workers.emplace_back(new Worker());
+    }
+
+    for (unsigned int i = 0; i < numWorkers; i++)
+    {
+        thread(&Executor::WorkerLoop, this, i).detach();
+    }
+}
+
+Executor::~Executor()
+{
+}
+
+Executor & Executor::GetInstance()
+{
+    // Never destroyed, so detached threads can never outlive it
+    static Executor * executor = new Executor();
+    return *executor;
+}
+
+void Executor::Post(Task task)
+{
+    unsigned int index = (t_workerIndex >= 0) ? t_workerIndex : (m_nextWorker++ % m_workers.size());
+
+    {
+        lock_guard<mutex> guard(m_workers[index]->m_mutex);
+        m_workers[index]->m_tasks.push_back(move(task));
+    }
+
+    m_pendingTasks++;
+
+    if (m_sleepingWorkers > 0)
+    {
+        lock_guard<mutex> guard(m_idleMutex);
+        m_idleCondition.notify_one();
+    }
+}
+
+void Executor::PostBlocking(Task task)
+{
+    lock_guard<mutex> guard(m_blockingMutex);
+
+    m_blockingTasks.push_back(move(task));
+
+    if (m_blockingTasks.size() <= m_idleBlockingThreads)
+    {
+        m_blockingCondition.notify_one();
+        return;
+    }
+
+    if (m_blockingThreads >= MAX_BLOCKING_THREADS)
+    {
+        // The task stays queued until a pool thread frees up
+        return;
+    }
+
+    try
+    {
+        thread(&Executor::BlockingLoop, this).detach();
+        m_blockingThreads++;
+    }
+    catch (const system_error & e)
+    {
+        LOG_MESSAGE("Error: Failed to grow blocking pool. Caught system_error with code " << e.code() << 
+                    " meaning " << e.what());
+    }
+}
+
+TimerHandle Executor::PostAfter(chrono::milliseconds delay, Task task)
+{
+    return TimerWheel::GetInstance().Schedule(delay, move(task), false);
+}
+
+TimerHandle Executor::PostBlockingAfter(chrono::milliseconds delay, Task task)
+{
+    return TimerWheel::GetInstance().Schedule(delay, move(task), true);
+}
+
+bool Executor::IsWorkerThread() const
+{
+    return t_workerIndex >= 0;
+}
+
+bool Executor::RunPendingTask()
+{
+    if (t_workerIndex < 0)
+    {
+        return false;
+    }
+
+    Task task;
+    if (!PopTask(t_workerIndex, task))
+    {
+        return false;
+    }
+
+    RunTask(task);
+    return true;
+}
+
+size_t Executor::GetNumWorkers() const
+{
+    return m_workers.size();
+}
+
+size_t Executor::GetNumBlockingThreads() const
+{
+    lock_guard<mutex> guard(m_blockingMutex);
+    return m_blockingThreads;
+}
+
+bool Executor::PopTask(unsigned int index, Task & task)
+{
+    // Newest task from our own deque first, for cache locality
+    {
+        Worker & self = *m_workers[index];
+        lock_guard<mutex> guard(self.m_mutex);
+        if (!self.m_tasks.empty())
+        {
+            task = move(self.m_tasks.back());
+            self.m_tasks.pop_back();
+            m_pendingTasks--;
+            return true;
+        }
+    }
+
+    // Otherwise steal the oldest task of another worker
+    for (unsigned int i = 1; i < m_workers.size(); i++)
+    {
+        Worker & victim = *m_workers[(index + i) % m_workers.size()];
+        lock_guard<mutex> guard(victim.m_mutex);
+        if (!victim.m_tasks.empty())
+        {
+            task = move(victim.m_tasks.front());
+            victim.m_tasks.pop_front();
+            m_pendingTasks--;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void Executor::WorkerLoop(unsigned int index)
+{
+    t_workerIndex = index;
+
+    while (true)
+    {
+        Task task;
+
+        if (PopTask(index, task))
+        {
+            RunTask(task);
+            continue;
+        }
+
+        unique_lock<mutex> lock(m_idleMutex);
+        m_sleepingWorkers++;
+        m_idleCondition.wait(lock, [this] { return m_pendingTasks > 0; });
+        m_sleepingWorkers--;
+    }
+}
+
+void Executor::BlockingLoop()
+{
+    unique_lock<mutex> lock(m_blockingMutex);
+
+    while (true)
+    {
+        if (m_blockingTasks.empty())
+        {
+            m_idleBlockingThreads++;
+            bool woken = m_blockingCondition.wait_for(lock, chrono::seconds(BLOCKING_THREAD_IDLE_SECONDS),
+                                                      [this] { return !m_blockingTasks.empty(); });
+            m_idleBlockingThreads--;
+
+            if (!woken)
+            {
+                m_blockingThreads--;
+                return;
+            }
+        }
+
+        Task task = move(m_blockingTasks.front());
+        m_blockingTasks.pop_front();
+
+        lock.unlock();
+        RunTask(task);
+        lock.lock();
+    }
+}
@@ -0,0 +1,272 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#ifndef __EXECUTOR_H__
+#define __EXECUTOR_H__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "TimerWheel.h"
+
+/// Handle to the result of a task submitted to the Executor.
+/// Continuations attached with Then() are posted to the Executor once the result is ready.
+template <class T>
+class TaskFuture
+{
+    template <class U> friend class TaskFuture;
+    friend class Executor;
+
+    struct State
+    {
+        std::mutex m_mutex;
+        bool m_ready = false;
+        std::vector<std::function<void()>> m_continuations;
+    };
+
+    std::shared_future<T> m_future;
+    std::shared_ptr<State> m_state;
+
+    explicit TaskFuture(std::shared_future<T> && future) : m_future(std::move(future)), m_state(std::make_shared<State>())
+    {
+    }
+
+    static void MarkReady(const std::shared_ptr<State> & state);
+
+public:
+
+    /// Default constructor. Creates an empty handle.
+    TaskFuture()
+    {
+    }
+
+    /// Returns true if the handle refers to a task.
+    bool Valid() const
+    {
+        return m_future.valid();
+    }
+
+    /// Returns true if the task has finished.
+    bool IsReady() const
+    {
+        return m_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }
+
+    /// Waits for the task and returns its result (rethrows its exception).
+    /// On an Executor worker thread, queued tasks are run while waiting instead of blocking the worker.
+    auto Get() const -> decltype(std::declval<std::shared_future<T>>().get());
+
+    /// Schedules f(std::shared_future<T>) to run on the Executor after this task finishes.
+    template <class F>
+    auto Then(F && f) -> TaskFuture<typename std::result_of<typename std::decay<F>::type(std::shared_future<T>)>::type>;
+};
+
+/// Process-wide task executor.
+///
+/// Short, non-blocking tasks run on a fixed set of work-stealing workers (one per core): each worker
+/// owns a deque, runs its newest task first and steals the oldest task of another worker when idle.
+/// Tasks that may block (socket I/O, sleeping, waiting on other nodes) go to a separate blocking pool,
+/// which reuses idle threads and never grows beyond MAX_BLOCKING_THREADS. Delayed tasks are held by the
+/// TimerWheel, so waiting for a deadline does not occupy a thread per task and can be cancelled.
+class Executor
+{
+public:
+
+    using Task = std::function<void()>;
+    using Clock = std::chrono::steady_clock;
+
+    /// Upper bound on the number of threads in the blocking pool.
+    static const unsigned int MAX_BLOCKING_THREADS = 512;
+
+    /// Seconds an idle blocking-pool thread waits for work before exiting.
+    static const unsigned int BLOCKING_THREAD_IDLE_SECONDS = 60;
+
+    /// Returns the singleton instance. The instance lives until process exit.
+    static Executor & GetInstance();
+
+    /// Queues a non-blocking task on the work-stealing workers.
+    void Post(Task task);
+
+    /// Queues a task that may block on the blocking pool.
+    void PostBlocking(Task task);
+
+    /// Queues a non-blocking task on the workers once the delay has elapsed.
+    /// The returned handle can cancel the task until it is queued.
+    TimerHandle PostAfter(std::chrono::milliseconds delay, Task task);
+
+    /// Queues a task that may block on the blocking pool once the delay has elapsed.
+    /// The returned handle can cancel the task until it is queued.
+    TimerHandle PostBlockingAfter(std::chrono::milliseconds delay, Task task);
+
+    /// Queues a non-blocking task on the workers and returns a handle to its result.
+    template <class F>
+    auto Submit(F && f) -> TaskFuture<typename std::result_of<typename std::decay<F>::type()>::type>;
+
+    /// Queues a task on the blocking pool and returns a handle to its result.
+    template <class F>
+    auto SubmitBlocking(F && f) -> TaskFuture<typename std::result_of<typename std::decay<F>::type()>::type>;
+
+    /// Returns true if the calling thread is one of the work-stealing workers.
+    bool IsWorkerThread() const;
+
+    /// Runs one queued worker task on the calling thread. Returns false if none was available.
+    bool RunPendingTask();
+
+    /// Returns the number of work-stealing workers.
+    size_t GetNumWorkers() const;
+
+    /// Returns the number of threads currently in the blocking pool.
+    size_t GetNumBlockingThreads() const;
+
+private:
+
+    struct Worker
+    {
+        std::mutex m_mutex;
+        std::deque<Task> m_tasks;
+    };
+
+    // Work-stealing workers
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<unsigned int> m_nextWorker;
+    std::atomic<int> m_pendingTasks;
+    std::atomic<unsigned int> m_sleepingWorkers;
+    std::mutex m_idleMutex;
+    std::condition_variable m_idleCondition;
+
+    // Blocking pool
+    std::deque<Task> m_blockingTasks;
+    unsigned int m_blockingThreads;
+    unsigned int m_idleBlockingThreads;
+    mutable std::mutex m_blockingMutex;
+    std::condition_variable m_blockingCondition;
+
+    Executor();
+    ~Executor();
+
+    Executor(Executor const &) = delete;
+    void operator=(Executor const &) = delete;
+
+    void WorkerLoop(unsigned int index);
+    void BlockingLoop();
+    bool PopTask(unsigned int index, Task & task);
+};
+
+template <class T>
+void TaskFuture<T>::MarkReady(const std::shared_ptr<State> & state)
+{
+    std::vector<std::function<void()>> continuations;
+
+    {
+        std::lock_guard<std::mutex> guard(state->m_mutex);
+        state->m_ready = true;
+        continuations.swap(state->m_continuations);
+    }
+
+    for (auto & continuation : continuations)
+    {
+        Executor::GetInstance().Post(std::move(continuation));
+    }
+}
+
+template <class T>
+auto TaskFuture<T>::Get() const -> decltype(std::declval<std::shared_future<T>>().get())
+{
+    Executor & executor = Executor::GetInstance();
+
+    if (executor.IsWorkerThread())
+    {
+        while (!IsReady())
+        {
+            if (!executor.RunPendingTask())
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    return m_future.get();
+}
+
+template <class T>
+template <class F>
+auto TaskFuture<T>::Then(F && f) -> TaskFuture<typename std::result_of<typename std::decay<F>::type(std::shared_future<T>)>::type>
+{
+    using R = typename std::result_of<typename std::decay<F>::type(std::shared_future<T>)>::type;
+
+    std::shared_future<T> future = m_future;
+    auto task = std::make_shared<std::packaged_task<R()>>(
+        [func = std::forward<F>(f), future]() mutable -> R { return func(future); });
+
+    TaskFuture<R> result(task->get_future().share());
+    auto next = result.m_state;
+    Executor::Task run = [task, next]() { (*task)(); TaskFuture<R>::MarkReady(next); };
+
+    bool ready;
+    {
+        std::lock_guard<std::mutex> guard(m_state->m_mutex);
+        ready = m_state->m_ready;
+        if (!ready)
+        {
+            m_state->m_continuations.push_back(run);
+        }
+    }
+
+    if (ready)
+    {
+        Executor::GetInstance().Post(std::move(run));
+    }
+
+    return result;
+}
+
+template <class F>
+auto Executor::Submit(F && f) -> TaskFuture<typename std::result_of<typename std::decay<F>::type()>::type>
+{
+    using R = typename std::result_of<typename std::decay<F>::type()>::type;
+
+    auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+    TaskFuture<R> result(task->get_future().share());
+    auto state = result.m_state;
+
+    Post([task, state]() { (*task)(); TaskFuture<R>::MarkReady(state); });
+
+    return result;
+}
+
+template <class F>
+auto Executor::SubmitBlocking(F && f) -> TaskFuture<typename std::result_of<typename std::decay<F>::type()>::type>
+{
+    using R = typename std::result_of<typename std::decay<F>::type()>::type;
+
+    auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(f));
+    TaskFuture<R> result(task->get_future().share());
+    auto state = result.m_state;
+
+    PostBlocking([task, state]() { (*task)(); TaskFuture<R>::MarkReady(state); });
+
+    return result;
+}
+
+#endif // __EXECUTOR_H__
@@ -19,14 +19,14 @@
 #define __JOINABLEFUNCTION_H__
 
 #include <functional>
-#include <chrono>
-#include <future>
 #include <vector>
+#include "libUtils/Executor.h"
 
-/// Utility class for executing a function in separate join-able threads.
+/// Utility class for executing a function one or more times and waiting for all calls to finish.
+/// The calls run on the Executor's blocking pool instead of on newly created threads.
 class JoinableFunction
 {
-    std::vector<std::future<void>> futures;
+    std::vector<TaskFuture<void>> futures;
     bool joined;
 
 public:
@@ -35,11 +35,11 @@ public:
     template <class callable, class... arguments>
     JoinableFunction(int num_threads, callable&& f, arguments&&... args)
     {
-        std::function<typename std::result_of<callable(arguments...)>::type()> task(std::bind(std::forward<callable>(f), std::forward<arguments>(args)...));
+        std::function<void()> task(std::bind(std::forward<callable>(f), std::forward<arguments>(args)...));
 
         for (int i = 0; i < num_threads; i++)
         {
-            futures.push_back(std::async(std::launch::async, task));
+            futures.push_back(Executor::GetInstance().SubmitBlocking(task));
         }
 
         joined = false;
@@ -54,16 +54,16 @@ public:
         }
     }
 
-    /// Joins all the launched threads.
+    /// Waits for all the launched calls.
     void join()
     {
         for (auto & e : futures)
         {
-            e.get();
+            e.Get();
         }
 
         joined = true;
     }
 };
 
-#endif // __JOINABLEFUNCTION_H__
\ No newline at end of file
+#endif // __JOINABLEFUNCTION_H__
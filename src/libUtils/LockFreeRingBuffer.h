@@ -0,0 +1,155 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#ifndef __LOCKFREERINGBUFFER_H__
+#define __LOCKFREERINGBUFFER_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+/// Bounded lock-free multi-producer queue (sequence-numbered slots, after D. Vyukov).
+/// Producers never block each other; a full buffer is reported to the caller.
+template <class T>
+class LockFreeRingBuffer
+{
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T data;
+    };
+
+    // Keep producer and consumer cursors on separate cache lines
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    const size_t m_mask;
+    std::unique_ptr<Cell[]> m_buffer;
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_enqueuePos;
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> m_dequeuePos;
+
+public:
+
+    /// Constructor. Capacity is rounded up to the next power of two.
+    explicit LockFreeRingBuffer(size_t capacity) : m_mask(RoundUp(capacity) - 1), 
+                                                   m_buffer(new Cell[m_mask + 1]),
+                                                   m_enqueuePos(0), m_dequeuePos(0)
+    {
+        for (size_t i = 0; i <= m_mask; i++)
+        {
+            m_buffer[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    LockFreeRingBuffer(const LockFreeRingBuffer &) = delete;
+    LockFreeRingBuffer & operator=(const LockFreeRingBuffer &) = delete;
+
+    /// Moves the item into the buffer. Returns false if the buffer is full.
+    bool TryPush(T && item)
+    {
+        Cell * cell;
+        size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            cell = &m_buffer[pos & m_mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+
+            if (diff == 0)
+            {
+                if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = m_enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = std::move(item);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Moves the oldest item out of the buffer. Returns false if the buffer is empty.
+    bool TryPop(T & item)
+    {
+        Cell * cell;
+        size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+
+        while (true)
+        {
+            cell = &m_buffer[pos & m_mask];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)(pos + 1);
+
+            if (diff == 0)
+            {
+                if (m_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = m_dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        item = std::move(cell->data);
+        cell->sequence.store(pos + m_mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// Returns true if no items are waiting (approximate under concurrent access).
+    bool Empty() const
+    {
+        return m_enqueuePos.load(std::memory_order_acquire) == m_dequeuePos.load(std::memory_order_acquire);
+    }
+
+    /// Returns the number of slots in the buffer.
+    size_t Capacity() const
+    {
+        return m_mask + 1;
+    }
+
+private:
+
+    static size_t RoundUp(size_t n)
+    {
+        size_t result = 2;
+        while (result < n)
+        {
+            result <<= 1;
+        }
+        return result;
+    }
+};
+
+#endif // __LOCKFREERINGBUFFER_H__
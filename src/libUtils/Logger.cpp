@@ -31,10 +31,44 @@ using namespace std;
 
 const streampos Logger::MAX_FILE_SIZE = 1024 * 1024 * 100; // 100MB per log file
 
-Logger::Logger(const char * prefix, bool log_to_file, streampos max_file_size)
+atomic<int> Logger::log_level(LOG_LEVEL_DEBUG);
+
+namespace
+{
+    // The kernel thread ID never changes for a thread, so fetch it once
+    pid_t GetTid()
+    {
+        static thread_local pid_t tid = syscall(SYS_gettid);
+        return tid;
+    }
+
+    // Only re-format the wall clock when the second changes
+    const string & GetTimeString()
+    {
+        static thread_local time_t lastTime = 0;
+        static thread_local string timeString;
+
+        time_t curTime = chrono::system_clock::to_time_t(chrono::system_clock::now());
+
+        if (curTime != lastTime || timeString.empty())
+        {
+            struct tm gmtTime;
+            gmtime_r(&curTime, &gmtTime);
+            ostringstream oss;
+            oss << PAD(put_time(&gmtTime, "%H:%M:%S"), Logger::TIME_LEN);
+            timeString = oss.str();
+            lastTime = curTime;
+        }
+
+        return timeString;
+    }
+}
+
+Logger::Logger(const char * prefix, bool log_to_file, streampos max_file_size) : queue(QUEUE_CAPACITY)
 {
     this->log_to_file = log_to_file;
     this->max_file_size = max_file_size;
+    this->file_size = 0;
 
     if (log_to_file)
     {
@@ -50,18 +84,25 @@ Logger::Logger(const char * prefix, bool log_to_file, streampos max_file_size)
         seqnum = 0;
         newLog();
     }
+
+    writer_stop = false;
+    writer_idle = false;
+    lines_pushed = 0;
+    lines_written = 0;
+    writer = thread(&Logger::writerLoop, this);
 }
 
 Logger::~Logger()
 {
+    writer_stop = true;
+    writer_cv.notify_one();
+    writer.join();
     logfile.close();
 }
 
 void Logger::checkLog()
 {
-    std::ifstream in(fname.c_str(), std::ifstream::ate | std::ifstream::binary);
-
-    if (in.tellg() >= max_file_size)
+    if (file_size >= max_file_size)
     {
         logfile.close();
         newLog();
@@ -77,153 +118,200 @@ void Logger::newLog()
     snprintf(buf, sizeof(buf), "-%05d-log.txt", seqnum);
     fname = fname_prefix + buf;
     logfile.open(fname.c_str(), ios_base::app);
-}
 
-Logger & Logger::GetLogger(const char * fname_prefix, bool log_to_file, streampos max_file_size)
-{
-    static Logger logger(fname_prefix, log_to_file, max_file_size);
-    return logger;
-}
-
-Logger & Logger::GetStateLogger(const char * fname_prefix, bool log_to_file, streampos max_file_size)
-{
-    static Logger logger(fname_prefix, log_to_file, max_file_size);
-    return logger;
+    // Appending to an existing file continues from its current size
+    std::ifstream in(fname.c_str(), std::ifstream::ate | std::ifstream::binary);
+    file_size = in.good() ? in.tellg() : streampos(0);
 }
 
-void Logger::LogMessage(const char * msg, const char * function)
+void Logger::enqueue(string && line)
 {
-    pid_t tid = syscall(SYS_gettid);
+    lines_pushed++;
 
-    auto clockNow = std::chrono::system_clock::now();
-    std::time_t curTime = std::chrono::system_clock::to_time_t(clockNow);
-    auto gmtTime = gmtime(&curTime);
-
-    lock_guard<mutex> guard(m);
-
-    if (log_to_file)
+    // Producers only wait when the writer has fallen a whole buffer behind
+    while (!queue.TryPush(move(line)))
     {
-        checkLog();
-        logfile << "[TID " << PAD(tid, TID_LEN) << "][" << PAD(put_time(gmtTime, "%H:%M:%S"), TIME_LEN) 
-                << "][" << LIMIT(function, MAX_FUNCNAME_LEN) << "] " << msg << endl << flush;
+        writer_cv.notify_one();
+        this_thread::yield();
     }
-    else
+
+    if (writer_idle.load(memory_order_relaxed))
     {
-        cout << "[TID " << PAD(tid, TID_LEN) << "][" << PAD(put_time(gmtTime, "%H:%M:%S"), TIME_LEN) << "][" 
-             << LIMIT(function, MAX_FUNCNAME_LEN) << "] " << msg << endl << flush;
+        writer_cv.notify_one();
     }
 }
 
-void Logger::LogMessage(const char * msg, const char * function, const char * epoch)
+void Logger::writeBatch(const string & batch)
 {
-    pid_t tid = syscall(SYS_gettid);
-
-    auto clockNow = std::chrono::system_clock::now();
-    std::time_t curTime = std::chrono::system_clock::to_time_t(clockNow);
-    auto gmtTime = gmtime(&curTime);
-
-    lock_guard<mutex> guard(m);
-
     if (log_to_file)
     {
         checkLog();
-        logfile << "[TID " << PAD(tid, TID_LEN) << "][" << PAD(put_time(gmtTime, "%H:%M:%S"), TIME_LEN)
-                << "][" << LIMIT(function, MAX_FUNCNAME_LEN) << "]" << "[Epoch " << epoch << "] " 
-                << msg << endl << flush;
+        logfile.write(batch.data(), batch.size());
+        logfile.flush();
+        file_size += batch.size();
     }
     else
     {
-        cout << "[TID " << PAD(tid, TID_LEN) << "][" << PAD(put_time(gmtTime, "%H:%M:%S"), TIME_LEN)
-             << "][" << LIMIT(function, MAX_FUNCNAME_LEN) << "]" << "[Epoch " << epoch << "] " 
-             << msg << endl << flush;
+        cout.write(batch.data(), batch.size());
+        cout.flush();
     }
 }
 
-void Logger::LogState(const char * msg, const char * function)
+void Logger::writerLoop()
 {
-    lock_guard<mutex> guard(m);
+    string batch;
+    string line;
+    batch.reserve(WRITE_BATCH_SIZE);
 
-    if (log_to_file)
+    while (true)
     {
-        checkLog();
-        logfile << msg << endl << flush;
-    }
-    else
-    {
-        cout << msg << endl << flush;
+        uint64_t count = 0;
+
+        while (batch.size() < WRITE_BATCH_SIZE && queue.TryPop(line))
+        {
+            batch += line;
+            count++;
+
+            // Stop at the rollover point so no file grows past one line over the limit
+            if (log_to_file && (file_size + (streamoff)batch.size() >= max_file_size))
+            {
+                break;
+            }
+        }
+
+        if (!batch.empty())
+        {
+            writeBatch(batch);
+            batch.clear();
+
+            lock_guard<mutex> guard(m);
+            lines_written += count;
+            flushed_cv.notify_all();
+            continue;
+        }
+
+        if (writer_stop)
+        {
+            break;
+        }
+
+        unique_lock<mutex> lock(m);
+        writer_idle = true;
+        if (queue.Empty() && !writer_stop)
+        {
+            // Timed wait guards against a notification racing with writer_idle
+            writer_cv.wait_for(lock, chrono::milliseconds(10));
+        }
+        writer_idle = false;
     }
 }
 
+void Logger::Flush()
+{
+    uint64_t target = lines_pushed.load();
+
+    unique_lock<mutex> lock(m);
+    writer_cv.notify_one();
+    flushed_cv.wait(lock, [this, target] { return lines_written.load() >= target; });
+}
+
+void Logger::SetLogLevel(LogLevel level)
+{
+    log_level.store(level, memory_order_relaxed);
+}
+
+LogLevel Logger::GetLogLevel()
+{
+    return static_cast<LogLevel>(log_level.load(memory_order_relaxed));
+}
+
+Logger & Logger::GetLogger(const char * fname_prefix, bool log_to_file, streampos max_file_size)
+{
+    static Logger logger(fname_prefix, log_to_file, max_file_size);
+    return logger;
+}
+
+Logger & Logger::GetStateLogger(const char * fname_prefix, bool log_to_file, streampos max_file_size)
+{
+    static Logger logger(fname_prefix, log_to_file, max_file_size);
+    return logger;
+}
+
+void Logger::LogMessage(const char * msg, const char * function)
+{
+    ostringstream oss;
+    oss << "[TID " << PAD(GetTid(), TID_LEN) << "][" << GetTimeString() 
+        << "][" << LIMIT(function, MAX_FUNCNAME_LEN) << "] " << msg << '\n';
+    enqueue(oss.str());
+}
+
+void Logger::LogMessage(const char * msg, const char * function, const char * epoch)
+{
+    ostringstream oss;
+    oss << "[TID " << PAD(GetTid(), TID_LEN) << "][" << GetTimeString()
+        << "][" << LIMIT(function, MAX_FUNCNAME_LEN) << "]" << "[Epoch " << epoch << "] " 
+        << msg << '\n';
+    enqueue(oss.str());
+}
+
+void Logger::LogState(const char * msg, const char * function)
+{
+    string line(msg);
+    line += '\n';
+    enqueue(move(line));
+}
+
 void Logger::LogMessageAndPayload(const char * msg, const vector<unsigned char> & payload, size_t max_bytes_to_display, const char * function)
 {
-    pid_t tid = syscall(SYS_gettid);
+    LogMessageAndPayload(msg, payload.data(), payload.size(), max_bytes_to_display, function);
+}
 
+void Logger::LogMessageAndPayload(const char * msg, const unsigned char * payload, size_t payload_len, size_t max_bytes_to_display, const char * function)
+{
     static const char * hex_table = "0123456789ABCDEF";
 
-    size_t payload_string_len = (payload.size() * 2) + 1;
-    if (payload.size() > max_bytes_to_display)
+    size_t payload_string_len = (payload_len * 2) + 1;
+    if (payload_len > max_bytes_to_display)
     {
         payload_string_len = (max_bytes_to_display * 2) + 1;
     }
 
     unique_ptr<char[]> payload_string = make_unique<char[]>(payload_string_len);
-    for (unsigned int payload_idx = 0, payload_string_idx = 0; (payload_idx < payload.size()) && ((payload_string_idx + 2) < payload_string_len); payload_idx++)
+    for (unsigned int payload_idx = 0, payload_string_idx = 0; (payload_idx < payload_len) && ((payload_string_idx + 2) < payload_string_len); payload_idx++)
     {
-        payload_string.get()[payload_string_idx++] = hex_table[(payload.at(payload_idx) >> 4) & 0xF];
-        payload_string.get()[payload_string_idx++] = hex_table[payload.at(payload_idx) & 0xF];
+        payload_string.get()[payload_string_idx++] = hex_table[(payload[payload_idx] >> 4) & 0xF];
+        payload_string.get()[payload_string_idx++] = hex_table[payload[payload_idx] & 0xF];
     }
     payload_string.get()[payload_string_len-1] = '\0';
 
-    auto clockNow = std::chrono::system_clock::now();
-    std::time_t curTime = std::chrono::system_clock::to_time_t(clockNow); 
-    auto gmtTime = gmtime(&curTime);   
-
-    lock_guard<mutex> guard(m);
+    ostringstream oss;
+    oss << "[TID " << PAD(GetTid(), TID_LEN) << "][" << GetTimeString()
+        << "][" << LIMIT(function, MAX_FUNCNAME_LEN) << "] " << msg 
+        << " (Len=" << payload_len << "): " << payload_string.get();
 
-    if (log_to_file)
+    if (payload_len > max_bytes_to_display)
     {
-        checkLog();
-
-        if (payload.size() > max_bytes_to_display)
-        {
-            logfile << "[TID " << PAD(tid, TID_LEN) << "][" << PAD(put_time(gmtTime, "%H:%M:%S"), TIME_LEN)
-                    << "][" << LIMIT(function, MAX_FUNCNAME_LEN) << "] " << msg 
-                    << " (Len=" << payload.size() << "): " << payload_string.get() << "..." 
-                    << endl << flush;
-        }
-        else
-        {
-            logfile << "[TID " << PAD(tid, TID_LEN) << "][" << PAD(put_time(gmtTime, "%H:%M:%S"), TIME_LEN)
-                    << "][" << LIMIT(function, MAX_FUNCNAME_LEN) << "] " << msg 
-                    << " (Len=" << payload.size() << "): " << payload_string.get() << endl << flush;
-        }
-    }
-    else
-    {
-        if (payload.size() > max_bytes_to_display)
-        {
-            cout << "[TID " << PAD(tid, TID_LEN) << "][" << PAD(put_time(gmtTime, "%H:%M:%S"), TIME_LEN)
-                 << "][" << LIMIT(function, MAX_FUNCNAME_LEN) << "] " << msg 
-                 << " (Len=" << payload.size() << "): " << payload_string.get() << "..." 
-                 << endl << flush;
-        }
-        else
-        {
-            cout << "[TID " << PAD(tid, TID_LEN) << "][" << PAD(put_time(gmtTime, "%H:%M:%S"), TIME_LEN)
-                 << "][" << LIMIT(function, MAX_FUNCNAME_LEN) << "] " << msg << " (Len=" 
-                 << payload.size() << "): " << payload_string.get() << endl << flush;
-        }
+        oss << "...";
     }
+
+    oss << '\n';
+    enqueue(oss.str());
 }
 
-ScopeMarker::ScopeMarker(const char * function) : function(function)
+ScopeMarker::ScopeMarker(const char * function, TraceLevel trace_level) : function(function), enabled(Logger::IsEnabled(LOG_LEVEL_DEBUG)), span(function, trace_level)
 {
-    Logger & logger = Logger::GetLogger(NULL, true);
-    logger.LogMessage("BEGIN", this->function.c_str());
+    if (enabled)
+    {
+        Logger & logger = Logger::GetLogger(NULL, true);
+        logger.LogMessage("BEGIN", this->function);
+    }
 }
 
 ScopeMarker::~ScopeMarker()
 {
-    Logger & logger = Logger::GetLogger(NULL, true);
-    logger.LogMessage("END", function.c_str());
+    if (enabled)
+    {
+        Logger & logger = Logger::GetLogger(NULL, true);
+        logger.LogMessage("END", function);
+    }
 }
@@ -17,14 +17,37 @@
 #ifndef __LOGGER_H__
 #define __LOGGER_H__
 
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 #include <sstream>
 #include <boost/multiprecision/cpp_int.hpp>
 
+#include "libUtils/LockFreeRingBuffer.h"
+#include "libUtils/Tracer.h"
+
+/// Severity levels, lowest first.
+enum LogLevel : int
+{
+    LOG_LEVEL_DEBUG = 0,
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_WARNING,
+    LOG_LEVEL_FATAL,
+    LOG_LEVEL_OFF
+};
+
+/// Messages below this level are compiled out entirely (override with -DLOG_COMPILE_LEVEL=n).
+#ifndef LOG_COMPILE_LEVEL
+#define LOG_COMPILE_LEVEL LOG_LEVEL_DEBUG
+#endif
+
 /// Utility logging class for outputting messages to stdout or file.
+/// Callers only format their line and push it into a lock-free ring buffer;
+/// a background writer thread drains the buffer and writes in batches.
 class Logger
 {
 private:
@@ -38,14 +61,35 @@ private:
 
     void checkLog();
     void newLog();
+    void enqueue(std::string && line);
+    void writerLoop();
+    void writeBatch(const std::string & batch);
 
     std::string fname_prefix;
     std::string fname;
     std::ofstream logfile;
+    std::streampos file_size;
     unsigned int seqnum;
 
+    LockFreeRingBuffer<std::string> queue;
+    std::atomic<bool> writer_stop;
+    std::atomic<bool> writer_idle;
+    std::atomic<uint64_t> lines_pushed;
+    std::atomic<uint64_t> lines_written;
+    std::condition_variable writer_cv;
+    std::condition_variable flushed_cv;
+    std::thread writer;
+
+    static std::atomic<int> log_level;
+
 public:
 
+    /// Number of pending lines the ring buffer can hold before callers have to wait.
+    static const size_t QUEUE_CAPACITY = 1 << 16;
+
+    /// Maximum number of bytes the writer accumulates before issuing a write.
+    static const size_t WRITE_BATCH_SIZE = 1 << 16;
+
     /// Limits the number of bytes of a payload to display.
     static const size_t MAX_BYTES_TO_DISPLAY = 100;
 
@@ -78,17 +122,38 @@ public:
 
     /// Outputs the specified message, function name, and payload to the main log.
     void LogMessageAndPayload(const char * msg, const std::vector<unsigned char> & payload, size_t max_bytes_to_display, const char * function);
+
+    /// Outputs the specified message, function name, and payload held outside a vector to the main log.
+    void LogMessageAndPayload(const char * msg, const unsigned char * payload, size_t payload_len, size_t max_bytes_to_display, const char * function);
+
+    /// Blocks until every message logged so far has been written out.
+    void Flush();
+
+    /// Sets the runtime threshold below which messages are discarded before formatting.
+    static void SetLogLevel(LogLevel level);
+
+    /// Returns the current runtime threshold.
+    static LogLevel GetLogLevel();
+
+    /// Returns true if messages at the specified level are currently logged.
+    static inline bool IsEnabled(LogLevel level)
+    {
+        return (level >= LOG_COMPILE_LEVEL) && (level >= log_level.load(std::memory_order_relaxed));
+    }
 };
 
 /// Utility class for automatically logging function or code block exit.
+/// The scope is also recorded as a trace span when tracing at the given level is on.
 class ScopeMarker
 {
-    std::string function;
+    const char * function;
+    bool enabled;
+    TraceSpan span;
 
 public:
 
     /// Constructor.
-    ScopeMarker(const char * function);
+    ScopeMarker(const char * function, TraceLevel trace_level = TRACE_ALL);
 
     /// Destructor.
     ~ScopeMarker();
@@ -97,10 +162,14 @@ public:
 #define INIT_FILE_LOGGER(fname_prefix) Logger::GetLogger(fname_prefix, true)
 #define INIT_STDOUT_LOGGER() Logger::GetLogger(NULL, false)
 #define INIT_STATE_LOGGER(fname_prefix) Logger::GetStateLogger(fname_prefix, true)
+#define LOG_ENABLED(level) Logger::IsEnabled(level)
 #define LOG_MARKER() ScopeMarker marker(__FUNCTION__)
-#define LOG_MESSAGE(msg) { std::ostringstream oss; oss << msg; Logger::GetLogger(NULL, true).LogMessage(oss.str().c_str(), __FUNCTION__); }
-#define LOG_MESSAGE2(blockNum, msg) { std::ostringstream oss; oss << msg; Logger::GetLogger(NULL, true).LogMessage(oss.str().c_str(), __FUNCTION__, blockNum); }
-#define LOG_PAYLOAD(msg, payload, max_bytes_to_display) { std::ostringstream oss; oss << msg; Logger::GetLogger(NULL, true).LogMessageAndPayload(oss.str().c_str(), payload, max_bytes_to_display, __FUNCTION__); }
+#define TRACE_MARKER() ScopeMarker marker(__FUNCTION__, TRACE_PHASES)
+#define LOG_GENERAL(level, msg) { if (LOG_ENABLED(level)) { std::ostringstream oss; oss << msg; Logger::GetLogger(NULL, true).LogMessage(oss.str().c_str(), __FUNCTION__); } }
+#define LOG_MESSAGE(msg) LOG_GENERAL(LOG_LEVEL_INFO, msg)
+#define LOG_MESSAGE2(blockNum, msg) { if (LOG_ENABLED(LOG_LEVEL_INFO)) { std::ostringstream oss; oss << msg; Logger::GetLogger(NULL, true).LogMessage(oss.str().c_str(), __FUNCTION__, blockNum); } }
+#define LOG_PAYLOAD(msg, payload, max_bytes_to_display) { if (LOG_ENABLED(LOG_LEVEL_INFO)) { std::ostringstream oss; oss << msg; Logger::GetLogger(NULL, true).LogMessageAndPayload(oss.str().c_str(), payload, max_bytes_to_display, __FUNCTION__); } }
+#define LOG_PAYLOAD_BYTES(msg, payload, payload_len, max_bytes_to_display) { if (LOG_ENABLED(LOG_LEVEL_INFO)) { std::ostringstream oss; oss << msg; Logger::GetLogger(NULL, true).LogMessageAndPayload(oss.str().c_str(), payload, payload_len, max_bytes_to_display, __FUNCTION__); } }
 #define LOG_STATE(msg) { std::ostringstream oss; oss << msg; Logger::GetStateLogger(NULL, true).LogState(oss.str().c_str(), __FUNCTION__); }
 
 #endif // __LOGGER_H__
@@ -0,0 +1,354 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <netinet/in.h>
+#include <sstream>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+#include "DetachedFunction.h"
+#include "Executor.h"
+#include "Logger.h"
+#include "Metrics.h"
+
+using namespace std;
+
+const double Metrics::QUANTILES[] = { 0.5, 0.9, 0.99, 0.999 };
+const unsigned int Metrics::NUM_QUANTILES = sizeof(QUANTILES) / sizeof(QUANTILES[0]);
+
+MetricHistogram::MetricHistogram() : m_count(0), m_sum(0)
+{
+    for (auto & bucket : m_buckets)
+    {
+        bucket.store(0, memory_order_relaxed);
+    }
+}
+
+unsigned int MetricHistogram::GetBucket(uint64_t ns)
+{
+    if (ns < SUB_BUCKETS)
+    {
+        return static_cast<unsigned int>(ns);
+    }
+
+    // The top SUB_BUCKET_BITS + 1 bits of the value select the bucket
+    unsigned int shift = (63 - __builtin_clzll(ns)) - SUB_BUCKET_BITS;
+    return SUB_BUCKETS + shift * SUB_BUCKETS + static_cast<unsigned int>((ns >> shift) & (SUB_BUCKETS - 1));
+}
+
+uint64_t MetricHistogram::GetBucketValue(unsigned int bucket)
+{
+    if (bucket < SUB_BUCKETS)
+    {
+        return bucket;
+    }
+
+    unsigned int shift = (bucket - SUB_BUCKETS) / SUB_BUCKETS;
+    uint64_t lower = static_cast<uint64_t>(SUB_BUCKETS + (bucket - SUB_BUCKETS) % SUB_BUCKETS) << shift;
+    return lower + ((1ULL << shift) >> 1);
+}
+
+void MetricHistogram::Record(uint64_t ns)
+{
+    m_buckets[GetBucket(ns)].fetch_add(1, memory_order_relaxed);
+    m_count.fetch_add(1, memory_order_relaxed);
+    m_sum.fetch_add(ns, memory_order_relaxed);
+}
+
+uint64_t MetricHistogram::GetQuantile(double q) const
+{
+    // Count from the buckets themselves so a concurrent Record() cannot push the rank past the end
+    uint64_t counts[NUM_BUCKETS];
+    uint64_t total = 0;
+    for (unsigned int i = 0; i < NUM_BUCKETS; i++)
+    {
+        counts[i] = m_buckets[i].load(memory_order_relaxed);
+        total += counts[i];
+    }
+
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    uint64_t rank = max<uint64_t>(1, static_cast<uint64_t>(ceil(q * total)));
+    uint64_t seen = 0;
+    for (unsigned int i = 0; i < NUM_BUCKETS; i++)
+    {
+        seen += counts[i];
+        if (seen >= rank)
+        {
+            return GetBucketValue(i);
+        }
+    }
+
+    return GetBucketValue(NUM_BUCKETS - 1);
+}
+
+Metrics::Metrics() : m_started(false)
+{
+}
+
+Metrics & Metrics::GetInstance()
+{
+    static Metrics metrics;
+    return metrics;
+}
+
+Metrics::Family & Metrics::GetFamily(const string & name, const string & help, MetricType type)
+{
+    auto it = m_families.find(name);
+    if (it == m_families.end())
+    {
+        it = m_families.emplace(name, Family()).first;
+        it->second.m_type = type;
+        it->second.m_help = help;
+    }
+    else if (it->second.m_type != type)
+    {
+        LOG_MESSAGE("Error: Metric " << name << " registered with two types; only the first is exported");
+    }
+    return it->second;
+}
+
+MetricCounter & Metrics::GetCounter(const string & name, const string & help, const string & labels)
+{
+    lock_guard<mutex> g(m_mutex);
+    unique_ptr<MetricCounter> & metric = GetFamily(name, help, COUNTER).m_counters[labels];
+    if (!metric)
+    {
+        metric.reset(new MetricCounter());
+    }
+    return *metric;
+}
+
+MetricGauge & Metrics::GetGauge(const string & name, const string & help, const string & labels)
+{
+    lock_guard<mutex> g(m_mutex);
+    unique_ptr<MetricGauge> & metric = GetFamily(name, help, GAUGE).m_gauges[labels];
+    if (!metric)
+    {
+        metric.reset(new MetricGauge());
+    }
+    return *metric;
+}
+
+MetricHistogram & Metrics::GetHistogram(const string & name, const string & help, const string & labels)
+{
+    lock_guard<mutex> g(m_mutex);
+    unique_ptr<MetricHistogram> & metric = GetFamily(name, help, HISTOGRAM).m_histograms[labels];
+    if (!metric)
+    {
+        metric.reset(new MetricHistogram());
+    }
+    return *metric;
+}
+
+namespace
+{
+    string FormatLabels(const string & labels, const string & extra = "")
+    {
+        if (labels.empty() && extra.empty())
+        {
+            return "";
+        }
+        if (labels.empty() || extra.empty())
+        {
+            return "{" + labels + extra + "}";
+        }
+        return "{" + labels + "," + extra + "}";
+    }
+
+    double ToSeconds(uint64_t ns)
+    {
+        return static_cast<double>(ns) / 1e9;
+    }
+}
+
+void Metrics::WritePrometheus(ostream & os) const
+{
+    lock_guard<mutex> g(m_mutex);
+
+    os << setprecision(9);
+    for (const auto & entry : m_families)
+    {
+        const string & name = entry.first;
+        const Family & family = entry.second;
+
+        os << "# HELP " << name << " " << family.m_help << "\n";
+        switch (family.m_type)
+        {
+        case COUNTER:
+            os << "# TYPE " << name << " counter\n";
+            for (const auto & metric : family.m_counters)
+            {
+                os << name << FormatLabels(metric.first) << " " << metric.second->Get() << "\n";
+            }
+            break;
+        case GAUGE:
+            os << "# TYPE " << name << " gauge\n";
+            for (const auto & metric : family.m_gauges)
+            {
+                os << name << FormatLabels(metric.first) << " " << metric.second->Get() << "\n";
+            }
+            break;
+        case HISTOGRAM:
+            os << "# TYPE " << name << " summary\n";
+            for (const auto & metric : family.m_histograms)
+            {
+                for (unsigned int i = 0; i < NUM_QUANTILES; i++)
+                {
+                    ostringstream quantile;
+                    quantile << "quantile=\"" << QUANTILES[i] << "\"";
+                    os << name << FormatLabels(metric.first, quantile.str()) << " "
+                       << ToSeconds(metric.second->GetQuantile(QUANTILES[i])) << "\n";
+                }
+                os << name << "_sum" << FormatLabels(metric.first) << " " << ToSeconds(metric.second->GetSum()) << "\n";
+                os << name << "_count" << FormatLabels(metric.first) << " " << metric.second->GetCount() << "\n";
+            }
+            break;
+        }
+    }
+}
+
+void Metrics::ServeLoop(int servSock)
+{
+    while (true)
+    {
+        int cliSock = accept(servSock, nullptr, nullptr);
+        if (cliSock < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            LOG_MESSAGE("Error: Metrics accept failed. Desc: " << std::strerror(errno));
+            break;
+        }
+
+        // The serving thread handles one client at a time, so a client that stops talking must not hold it
+        struct timeval timeout = { SOCKET_TIMEOUT_IN_SECONDS, 0 };
+        setsockopt(cliSock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+        setsockopt(cliSock, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+
+        // Every request gets the full metrics page; the request itself is not parsed
+        char request[1024];
+        recv(cliSock, request, sizeof(request), 0);
+
+        ostringstream body;
+        WritePrometheus(body);
+        const string content = body.str();
+
+        ostringstream response;
+        response << "HTTP/1.0 200 OK\r\n"
+                 << "Content-Type: text/plain; version=0.0.4\r\n"
+                 << "Content-Length: " << content.size() << "\r\n"
+                 << "Connection: close\r\n\r\n"
+                 << content;
+        const string out = response.str();
+
+        size_t written = 0;
+        while (written < out.size())
+        {
+            ssize_t n = send(cliSock, out.data() + written, out.size() - written, MSG_NOSIGNAL);
+            if (n <= 0)
+            {
+                break;
+            }
+            written += n;
+        }
+
+        close(cliSock);
+    }
+
+    close(servSock);
+}
+
+void Metrics::DumpLoop(string fname, unsigned int intervalInSeconds)
+{
+    // Write to a temporary file and rename so readers never see a partial dump
+    const string tmpname = fname + ".tmp";
+    {
+        ofstream file(tmpname, ios::trunc);
+        WritePrometheus(file);
+    }
+    if (rename(tmpname.c_str(), fname.c_str()) != 0)
+    {
+        LOG_MESSAGE("Error: Failed to write metrics to " << fname);
+    }
+
+    Executor::GetInstance().PostBlockingAfter(chrono::seconds(intervalInSeconds),
+                                              [this, fname, intervalInSeconds]() -> void
+                                              {
+                                                  DumpLoop(fname, intervalInSeconds);
+                                              });
+}
+
+void Metrics::Start(unsigned int port, unsigned int intervalInSeconds, const string & fname)
+{
+    {
+        lock_guard<mutex> g(m_mutex);
+        if (m_started)
+        {
+            return;
+        }
+        m_started = true;
+    }
+
+    if (port != 0)
+    {
+        int servSock = socket(AF_INET, SOCK_STREAM, 0);
+        int enable = 1;
+        setsockopt(servSock, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable));
+
+        struct sockaddr_in servAddr;
+        memset(&servAddr, 0, sizeof(struct sockaddr_in));
+        servAddr.sin_family = AF_INET;
+        servAddr.sin_port = htons(port);
+        servAddr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+        if ((servSock < 0) || (::bind(servSock, (struct sockaddr *) &servAddr, sizeof(servAddr)) < 0) ||
+            (listen(servSock, 16) < 0))
+        {
+            LOG_MESSAGE("Error: Metrics listener on port " << port << " failed. Desc: " << std::strerror(errno));
+            if (servSock >= 0)
+            {
+                close(servSock);
+            }
+        }
+        else
+        {
+            LOG_MESSAGE("Serving metrics on 127.0.0.1:" << port);
+            DetachedFunction(1, &Metrics::ServeLoop, this, servSock);
+        }
+    }
+
+    if (intervalInSeconds != 0)
+    {
+        Executor::GetInstance().PostBlockingAfter(chrono::seconds(intervalInSeconds),
+                                                  [this, fname, intervalInSeconds]() -> void
+                                                  {
+                                                      DumpLoop(fname, intervalInSeconds);
+                                                  });
+    }
+}
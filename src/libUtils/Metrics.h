@@ -0,0 +1,177 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+#ifndef __METRICS_H__
+#define __METRICS_H__
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+
+/// Monotonically increasing count.
+class MetricCounter
+{
+    std::atomic<uint64_t> m_value;
+
+public:
+
+    MetricCounter() : m_value(0) {}
+
+    void Increment(uint64_t n = 1) { m_value.fetch_add(n, std::memory_order_relaxed); }
+
+    uint64_t Get() const { return m_value.load(std::memory_order_relaxed); }
+};
+
+/// Value that can go up and down.
+class MetricGauge
+{
+    std::atomic<int64_t> m_value;
+
+public:
+
+    MetricGauge() : m_value(0) {}
+
+    void Set(int64_t value) { m_value.store(value, std::memory_order_relaxed); }
+
+    void Add(int64_t n) { m_value.fetch_add(n, std::memory_order_relaxed); }
+
+    int64_t Get() const { return m_value.load(std::memory_order_relaxed); }
+};
+
+/// Distribution of durations in nanoseconds.
+///
+/// Buckets are log-linear: every power of two is split into SUB_BUCKETS equal parts, so any
+/// recorded value is reported within 1 / SUB_BUCKETS of its true value over the full 64-bit range.
+/// Recording is a few relaxed atomic increments and never allocates.
+class MetricHistogram
+{
+public:
+
+    static const unsigned int SUB_BUCKET_BITS = 4;
+    static const unsigned int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+    static const unsigned int NUM_BUCKETS = SUB_BUCKETS + (64 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+    MetricHistogram();
+
+    void Record(uint64_t ns);
+
+    void Record(std::chrono::steady_clock::duration elapsed)
+    {
+        Record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+    }
+
+    uint64_t GetCount() const { return m_count.load(std::memory_order_relaxed); }
+
+    uint64_t GetSum() const { return m_sum.load(std::memory_order_relaxed); }
+
+    /// Returns the value at quantile q (0 < q <= 1) in nanoseconds, or 0 if nothing was recorded.
+    uint64_t GetQuantile(double q) const;
+
+    static unsigned int GetBucket(uint64_t ns);
+
+    /// Returns the midpoint of a bucket.
+    static uint64_t GetBucketValue(unsigned int bucket);
+
+private:
+
+    std::atomic<uint64_t> m_buckets[NUM_BUCKETS];
+    std::atomic<uint64_t> m_count;
+    std::atomic<uint64_t> m_sum;
+};
+
+/// Records the lifetime of the object into a histogram.
+class MetricTimer
+{
+    MetricHistogram & m_histogram;
+    std::chrono::steady_clock::time_point m_start;
+
+public:
+
+    explicit MetricTimer(MetricHistogram & histogram) : m_histogram(histogram), m_start(std::chrono::steady_clock::now()) {}
+
+    ~MetricTimer() { m_histogram.Record(std::chrono::steady_clock::now() - m_start); }
+};
+
+/// Process-wide registry of named counters, gauges and histograms.
+///
+/// Metrics are created on first lookup and live until process exit, so callers can keep the returned
+/// reference and update it without touching the registry again. Labels are passed preformatted, e.g.
+/// "class=\"txn\"". The registry is exported in the Prometheus text format, with histograms written as
+/// summaries in seconds, either over a local HTTP listener or to a file rewritten periodically.
+class Metrics
+{
+    enum MetricType : unsigned char
+    {
+        COUNTER = 0x00,
+        GAUGE,
+        HISTOGRAM
+    };
+
+    struct Family
+    {
+        MetricType m_type;
+        std::string m_help;
+        std::map<std::string, std::unique_ptr<MetricCounter>> m_counters;
+        std::map<std::string, std::unique_ptr<MetricGauge>> m_gauges;
+        std::map<std::string, std::unique_ptr<MetricHistogram>> m_histograms;
+    };
+
+    mutable std::mutex m_mutex;
+    std::map<std::string, Family> m_families;
+    bool m_started;
+
+    Metrics();
+
+    Family & GetFamily(const std::string & name, const std::string & help, MetricType type);
+    void ServeLoop(int servSock);
+    void DumpLoop(std::string fname, unsigned int intervalInSeconds);
+
+public:
+
+    /// Quantiles exported for every histogram.
+    static const double QUANTILES[];
+    static const unsigned int NUM_QUANTILES;
+
+    /// Seconds a scrape connection may stall on a read or write before it is dropped.
+    static const unsigned int SOCKET_TIMEOUT_IN_SECONDS = 5;
+
+    /// Returns the singleton instance.
+    static Metrics & GetInstance();
+
+    MetricCounter & GetCounter(const std::string & name, const std::string & help, const std::string & labels = "");
+
+    MetricGauge & GetGauge(const std::string & name, const std::string & help, const std::string & labels = "");
+
+    MetricHistogram & GetHistogram(const std::string & name, const std::string & help, const std::string & labels = "");
+
+    /// Writes every metric in the Prometheus text exposition format (version 0.0.4).
+    void WritePrometheus(std::ostream & os) const;
+
+    /// Serves the metrics on 127.0.0.1:port (if port is not 0) and rewrites fname every
+    /// intervalInSeconds (if not 0). Only the first call has any effect.
+    void Start(unsigned int port, unsigned int intervalInSeconds, const std::string & fname = "metrics.prom");
+};
+
+/// The lookups below run once per call site; the metric is then updated without locking.
+#define METRICS_COUNTER(name, help) ([]() -> MetricCounter & { static MetricCounter & m = Metrics::GetInstance().GetCounter(name, help); return m; }())
+#define METRICS_GAUGE(name, help) ([]() -> MetricGauge & { static MetricGauge & m = Metrics::GetInstance().GetGauge(name, help); return m; }())
+#define METRICS_HISTOGRAM(name, help) ([]() -> MetricHistogram & { static MetricHistogram & m = Metrics::GetInstance().GetHistogram(name, help); return m; }())
+
+#endif // __METRICS_H__
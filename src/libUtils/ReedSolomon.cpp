@@ -0,0 +1,231 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include "ReedSolomon.h"
+
+#include <algorithm>
+#include <array>
+
+using namespace std;
+
+const unsigned int ReedSolomon::MAX_FRAGMENTS;
+
+namespace
+{
+    // Multiplication and inverse tables for GF(2^8) with the polynomial x^8 + x^4 + x^3 + x^2 + 1
+    struct GaloisField
+    {
+        array<array<unsigned char, 256>, 256> mul;
+        array<unsigned char, 256> inv;
+
+        GaloisField()
+        {
+            array<unsigned char, 512> exp;
+            array<unsigned int, 256> log;
+
+            unsigned int x = 1;
+            for (unsigned int i = 0; i < 255; i++)
+            {
+                exp[i] = x;
+                log[x] = i;
+                x <<= 1;
+                if (x & 0x100)
+                {
+                    x ^= 0x11D;
+                }
+            }
+            for (unsigned int i = 255; i < exp.size(); i++)
+            {
+                exp[i] = exp[i - 255];
+            }
+
+            for (unsigned int a = 0; a < 256; a++)
+            {
+                for (unsigned int b = 0; b < 256; b++)
+                {
+                    mul[a][b] = (a == 0 || b == 0) ? 0 : exp[log[a] + log[b]];
+                }
+                inv[a] = (a == 0) ? 0 : exp[255 - log[a]];
+            }
+        }
+    };
+
+    const GaloisField & GetField()
+    {
+        static const GaloisField field;
+        return field;
+    }
+
+    // Generator matrix element for data fragment j in fragment i
+    unsigned char GetCoefficient(unsigned int i, unsigned int j, unsigned int k)
+    {
+        if (i < k)
+        {
+            return (i == j) ? 1 : 0;
+        }
+        return GetField().inv[i ^ j];
+    }
+
+    // out += c * in, element-wise
+    void MultiplyAdd(unsigned char c, const unsigned char * in, unsigned char * out, unsigned int size)
+    {
+        if (c == 0)
+        {
+            return;
+        }
+
+        const array<unsigned char, 256> & row = GetField().mul[c];
+        for (unsigned int b = 0; b < size; b++)
+        {
+            out[b] ^= row[in[b]];
+        }
+    }
+
+    // Gauss-Jordan inversion of a k x k matrix in place. Returns false if the matrix is singular.
+    bool Invert(vector<vector<unsigned char>> & m)
+    {
+        const GaloisField & gf = GetField();
+        const unsigned int k = m.size();
+
+        vector<vector<unsigned char>> result(k, vector<unsigned char>(k, 0));
+        for (unsigned int i = 0; i < k; i++)
+        {
+            result[i][i] = 1;
+        }
+
+        for (unsigned int col = 0; col < k; col++)
+        {
+            unsigned int pivot = col;
+            while (pivot < k && m[pivot][col] == 0)
+            {
+                pivot++;
+            }
+            if (pivot == k)
+            {
+                return false;
+            }
+            swap(m[col], m[pivot]);
+            swap(result[col], result[pivot]);
+
+            unsigned char scale = gf.inv[m[col][col]];
+            for (unsigned int c = 0; c < k; c++)
+            {
+                m[col][c] = gf.mul[scale][m[col][c]];
+                result[col][c] = gf.mul[scale][result[col][c]];
+            }
+
+            for (unsigned int r = 0; r < k; r++)
+            {
+                unsigned char factor = m[r][col];
+                if (r == col || factor == 0)
+                {
+                    continue;
+                }
+                MultiplyAdd(factor, m[col].data(), m[r].data(), k);
+                MultiplyAdd(factor, result[col].data(), result[r].data(), k);
+            }
+        }
+
+        m.swap(result);
+        return true;
+    }
+}
+
+unsigned int ReedSolomon::GetFragmentSize(unsigned int length, unsigned int k)
+{
+    return (k == 0) ? 0 : (length + k - 1) / k;
+}
+
+bool ReedSolomon::Encode(const vector<unsigned char> & data, unsigned int k, unsigned int n,
+                         vector<vector<unsigned char>> & fragments)
+{
+    if (k == 0 || k > n || n > MAX_FRAGMENTS)
+    {
+        return false;
+    }
+
+    const unsigned int size = GetFragmentSize(data.size(), k);
+
+    fragments.assign(n, vector<unsigned char>(size, 0));
+
+    for (unsigned int j = 0; j < k; j++)
+    {
+        unsigned int begin = j * size;
+        if (begin < data.size())
+        {
+            unsigned int end = min<unsigned int>(begin + size, data.size());
+            copy(data.begin() + begin, data.begin() + end, fragments[j].begin());
+        }
+    }
+
+    for (unsigned int i = k; i < n; i++)
+    {
+        for (unsigned int j = 0; j < k; j++)
+        {
+            MultiplyAdd(GetCoefficient(i, j, k), fragments[j].data(), fragments[i].data(), size);
+        }
+    }
+
+    return true;
+}
+
+bool ReedSolomon::Decode(const map<unsigned int, vector<unsigned char>> & fragments,
+                         unsigned int k, unsigned int n, unsigned int length,
+                         vector<unsigned char> & data)
+{
+    if (k == 0 || k > n || n > MAX_FRAGMENTS || fragments.size() < k)
+    {
+        return false;
+    }
+
+    const unsigned int size = GetFragmentSize(length, k);
+
+    // Data fragments sort first, so the identity rows are used whenever they are available
+    vector<const vector<unsigned char> *> inputs;
+    vector<vector<unsigned char>> matrix;
+    for (auto it = fragments.begin(); it != fragments.end() && inputs.size() < k; it++)
+    {
+        if (it->first >= n || it->second.size() != size)
+        {
+            return false;
+        }
+
+        vector<unsigned char> row(k);
+        for (unsigned int j = 0; j < k; j++)
+        {
+            row[j] = GetCoefficient(it->first, j, k);
+        }
+        matrix.push_back(move(row));
+        inputs.push_back(&it->second);
+    }
+
+    if (!Invert(matrix))
+    {
+        return false;
+    }
+
+    data.assign(k * size, 0);
+    for (unsigned int j = 0; j < k; j++)
+    {
+        for (unsigned int r = 0; r < k; r++)
+        {
+            MultiplyAdd(matrix[j][r], inputs[r]->data(), data.data() + j * size, size);
+        }
+    }
+    data.resize(length);
+
+    return true;
+}
@@ -0,0 +1,51 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#ifndef __REEDSOLOMON_H__
+#define __REEDSOLOMON_H__
+
+#include <map>
+#include <vector>
+
+/// Systematic Reed-Solomon erasure code over GF(2^8).
+///
+/// Data is split into k equally sized data fragments (zero padded at the end) and extended with
+/// n - k parity fragments. Parity fragment i (k <= i < n) is the row of a Cauchy matrix with
+/// element 1 / (i ^ j) for data fragment j, so every k x k submatrix of the generator is
+/// invertible and any k distinct fragments are enough to rebuild the data.
+class ReedSolomon
+{
+public:
+
+    /// Largest supported number of fragments. Fragment indices fit in one byte.
+    static const unsigned int MAX_FRAGMENTS = 255;
+
+    /// Splits data into n fragments, any k of which are enough to rebuild it.
+    /// Returns false if 0 < k <= n <= MAX_FRAGMENTS does not hold.
+    static bool Encode(const std::vector<unsigned char> & data, unsigned int k, unsigned int n,
+                       std::vector<std::vector<unsigned char>> & fragments);
+
+    /// Rebuilds the first length bytes of the data from at least k fragments keyed by index.
+    /// Returns false if there are fewer than k fragments or the fragments are malformed.
+    static bool Decode(const std::map<unsigned int, std::vector<unsigned char>> & fragments,
+                       unsigned int k, unsigned int n, unsigned int length,
+                       std::vector<unsigned char> & data);
+
+    /// Returns the size of each fragment produced for length bytes of data.
+    static unsigned int GetFragmentSize(unsigned int length, unsigned int k);
+};
+
+#endif // __REEDSOLOMON_H__
@@ -14,81 +14,62 @@
 * and which include a reference to GPLv3 in their program files.
 **/
 
-#include "ReverseLock.h"
+#include "Executor.h"
 #include "Scheduler.h"
 
 using namespace std;
 
-Scheduler::Scheduler()
+namespace
 {
-}
-
-Scheduler::~Scheduler()
-{
-}
-
-void Scheduler::ServiceQueue()
-{
-    unique_lock<mutex> lock(newTaskMutex);
-
-    while (true) 
+    TimerHandle ScheduleWhileAlive(const shared_ptr<atomic<bool>> & alive, function<void (void)> f, 
+                                   int64_t deltaMilliSeconds)
     {
-        try 
-        {   
-            while (taskQueue.empty()) {
-                newTaskScheduled.wait(lock);
-            }
-
-            while (!taskQueue.empty()) {
-                std::chrono::time_point<std::chrono::system_clock> timeToWaitFor = taskQueue.begin()->first;
-                if (newTaskScheduled.wait_until(lock, timeToWaitFor) == std::cv_status::timeout)
+        return Executor::GetInstance().PostBlockingAfter(chrono::milliseconds(deltaMilliSeconds),
+            [alive, f]() 
+            { 
+                if (*alive) 
                 {
-                    break;
+                    f();
                 }
-            }
-
-            if (taskQueue.empty())
-            {
-                continue;
-            }
-
-            std::function<void (void)> f = taskQueue.begin()->second;
-            taskQueue.erase(taskQueue.begin());
+            });
+    }
 
+    void SchedulePeriodicallyHelper(const shared_ptr<atomic<bool>> & alive, function<void (void)> f, 
+                                    int64_t deltaMilliSeconds)
+    {
+        ScheduleWhileAlive(alive, [alive, f, deltaMilliSeconds]() 
             {
-                ReverseLock<unique_lock<mutex>> rlock(lock);
                 f();
-            }
-        } 
-        catch (...) 
-        {
-            throw;
-        }
+                SchedulePeriodicallyHelper(alive, f, deltaMilliSeconds);
+            }, deltaMilliSeconds);
     }
-    newTaskScheduled.notify_one();
 }
 
-void Scheduler::ScheduleAt(std::function<void (void)> f, chrono::time_point<chrono::system_clock> t)
+Scheduler::Scheduler() : m_alive(make_shared<atomic<bool>>(true))
 {
-    {
-        lock_guard<mutex> lock(newTaskMutex);
-        taskQueue.insert(make_pair(t, f));
-    }
-    newTaskScheduled.notify_one();
 }
 
-void Scheduler::ScheduleAfter(std::function<void (void)> f, int64_t deltaMilliSeconds)
+Scheduler::~Scheduler()
 {
-    ScheduleAt(f, chrono::system_clock::now() + chrono::milliseconds(deltaMilliSeconds));
+    *m_alive = false;
 }
 
-static void SchedulePeriodicallyHelper(Scheduler* s, std::function<void (void)> f, int64_t deltaMilliSeconds)
+void Scheduler::ServiceQueue()
 {
-    f();
-    s->ScheduleAfter(bind(&SchedulePeriodicallyHelper, s, f, deltaMilliSeconds), deltaMilliSeconds);
 }
 
-void Scheduler::SchedulePeriodically(std::function<void (void)> f, int64_t deltaMilliSeconds)
+TimerHandle Scheduler::ScheduleAt(function<void (void)> f, chrono::time_point<chrono::system_clock> t)
 {
-    ScheduleAfter(bind(&SchedulePeriodicallyHelper, this, f, deltaMilliSeconds), deltaMilliSeconds);
-}
\ No newline at end of file
+    int64_t delta = chrono::duration_cast<chrono::milliseconds>(t - chrono::system_clock::now()).count();
+    return ScheduleWhileAlive(m_alive, f, max<int64_t>(delta, 0));
+}
+
+TimerHandle Scheduler::ScheduleAfter(function<void (void)> f, int64_t deltaMilliSeconds)
+{
+    return ScheduleWhileAlive(m_alive, f, deltaMilliSeconds);
+}
+
+void Scheduler::SchedulePeriodically(function<void (void)> f, int64_t deltaMilliSeconds)
+{
+    SchedulePeriodicallyHelper(m_alive, f, deltaMilliSeconds);
+}
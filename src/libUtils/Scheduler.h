@@ -17,37 +17,37 @@
 #ifndef __SCHEDULER_H__
 #define __SCHEDULER_H__
 
+#include <atomic>
 #include <chrono>
-#include <condition_variable>
 #include <functional>
-#include <map>
-#include <mutex>
-#include <thread>
+#include <memory>
 
+#include "TimerWheel.h"
 
-// should be initialized this way
-// CScheduler::Function serviceLoop = boost::bind(&CScheduler::serviceQueue, &scheduler);
-// threadGroup.create_thread(boost::bind(&TraceThread<CScheduler::Function>, "scheduler", serviceLoop));
-
+/// Schedules tasks at a point in time, after a delay, or periodically.
+/// Tasks are held by the TimerWheel and run on the Executor's blocking pool once due.
+/// Tasks that have not run yet are dropped when the Scheduler is destroyed.
 class Scheduler
 {
 public:
     Scheduler();
     ~Scheduler();
 
-    void ScheduleAt(std::function<void (void)> f, 
+    /// Runs f at (or as soon as possible after) time t.
+    TimerHandle ScheduleAt(std::function<void (void)> f, 
         std::chrono::time_point<std::chrono::system_clock> t = std::chrono::system_clock::now());
 
-    void ScheduleAfter(std::function<void (void)> f, int64_t deltaMilliSeconds);
+    /// Runs f once the delay has elapsed.
+    TimerHandle ScheduleAfter(std::function<void (void)> f, int64_t deltaMilliSeconds);
 
+    /// Runs f every deltaMilliSeconds, starting deltaMilliSeconds from now.
     void SchedulePeriodically(std::function<void (void)> f, int64_t deltaMilliSeconds);
 
+    /// Kept for existing callers. Tasks no longer need a service thread, so this returns immediately.
     void ServiceQueue();
 
 private:
-    std::multimap<std::chrono::time_point<std::chrono::system_clock>, std::function<void (void)>> taskQueue;
-    std::condition_variable newTaskScheduled;
-    mutable std::mutex newTaskMutex;
+    std::shared_ptr<std::atomic<bool>> m_alive;
 };
 
-#endif // __SCHEDULER_H__
\ No newline at end of file
+#endif // __SCHEDULER_H__
@@ -0,0 +1,110 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#ifndef __SHAREDBUFFER_H__
+#define __SHAREDBUFFER_H__
+
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+/// Immutable, reference-counted byte buffer.
+///
+/// A received message is moved into a SharedBuffer once and then handed to the dispatcher, the
+/// broadcast forwarder and any queued handler by copying the buffer, which only copies a pointer.
+/// Slice() returns a view of part of the same storage. The bytes can never change once shared.
+class SharedBuffer
+{
+    std::shared_ptr<const std::vector<unsigned char>> m_storage;
+    size_t m_offset;
+    size_t m_size;
+
+    SharedBuffer(const std::shared_ptr<const std::vector<unsigned char>> & storage, size_t offset, size_t size)
+        : m_storage(storage), m_offset(offset), m_size(size)
+    {
+    }
+
+public:
+
+    /// Default constructor. Creates an empty buffer.
+    SharedBuffer() : m_storage(std::make_shared<const std::vector<unsigned char>>()), m_offset(0), m_size(0)
+    {
+    }
+
+    /// Constructor. Takes ownership of the bytes without copying them.
+    explicit SharedBuffer(std::vector<unsigned char> && bytes)
+        : m_storage(std::make_shared<const std::vector<unsigned char>>(std::move(bytes))),
+          m_offset(0), m_size(m_storage->size())
+    {
+    }
+
+    /// Returns a view of size bytes starting at offset, sharing this buffer's storage.
+    SharedBuffer Slice(size_t offset, size_t size) const
+    {
+        if ((offset > m_size) || (size > m_size - offset))
+        {
+            throw std::out_of_range("SharedBuffer::Slice");
+        }
+        return SharedBuffer(m_storage, m_offset + offset, size);
+    }
+
+    /// Returns a view of the bytes from offset to the end, sharing this buffer's storage.
+    SharedBuffer Slice(size_t offset) const
+    {
+        return Slice(offset, (offset > m_size) ? 0 : m_size - offset);
+    }
+
+    /// Returns a pointer to the first byte of the view.
+    const unsigned char * data() const { return m_storage->data() + m_offset; }
+
+    /// Returns the number of bytes in the view.
+    size_t size() const { return m_size; }
+
+    /// Returns true if the view is empty.
+    bool empty() const { return m_size == 0; }
+
+    const unsigned char * begin() const { return data(); }
+    const unsigned char * end() const { return data() + m_size; }
+
+    /// Returns the byte at index, checking the bounds of the view.
+    unsigned char at(size_t index) const
+    {
+        if (index >= m_size)
+        {
+            throw std::out_of_range("SharedBuffer::at");
+        }
+        return data()[index];
+    }
+
+    /// Returns true if the view covers the whole storage, so GetVector() can be used.
+    bool IsWhole() const { return (m_offset == 0) && (m_size == m_storage->size()); }
+
+    /// Returns the underlying vector of a whole buffer, for code that reads messages as vectors.
+    const std::vector<unsigned char> & GetVector() const
+    {
+        if (!IsWhole())
+        {
+            throw std::logic_error("SharedBuffer::GetVector on a slice");
+        }
+        return *m_storage;
+    }
+
+    /// Returns the number of buffers and slices sharing this storage.
+    long GetUseCount() const { return m_storage.use_count(); }
+};
+
+#endif // __SHAREDBUFFER_H__
@@ -0,0 +1,258 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#ifndef __STATENOTIFIER_H__
+#define __STATENOTIFIER_H__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "libUtils/Executor.h"
+#include "libUtils/Logger.h"
+
+/// Notification mechanism for a state machine whose state is held in an atomic.
+///
+/// Threads can wait for a condition on the state with a deadline, and message handlers that arrive
+/// before the state they need can park their work instead of blocking. Work parked for a state is
+/// replayed in arrival order on the Executor's blocking pool once that state is entered, and dropped
+/// if the state is not entered before its deadline. The owner must call Notify() after every change
+/// of the state. Handlers must go through ParkUntil() in the target state as well, so that a message
+/// arriving while earlier ones are still queued or replaying does not overtake them.
+template <class State>
+class StateNotifier
+{
+public:
+
+    using Task = std::function<void()>;
+
+    /// Constructor. The notifier only reads the state.
+    explicit StateNotifier(const std::atomic<State> & state) : m_state(state)
+    {
+    }
+
+    /// Wakes threads blocked in WaitFor() and replays the work parked for the current state.
+    void Notify();
+
+    /// Blocks until pred() returns true or the timeout elapses. Returns the final value of pred().
+    template <class Predicate>
+    bool WaitFor(Predicate pred, std::chrono::milliseconds timeout);
+
+    /// Parks the task until the state becomes target, unless the state already is target and no
+    /// earlier work is queued for it. Returns false if the caller should go ahead immediately.
+    /// Work replayed from the queue always goes ahead, so a handler can park itself.
+    bool ParkUntil(State target, Task task, std::chrono::milliseconds timeout);
+
+    /// Lets work parked for target also be replayed while the state is other, for handlers that
+    /// accept more than one state. Call before any work is parked.
+    void AlsoDrainIn(State target, State other);
+
+    /// Returns the number of tasks parked for the given state.
+    size_t GetNumParked(State target);
+
+private:
+
+    struct Parked
+    {
+        Task m_task;
+        bool m_queued;
+        TimerHandle m_timer;
+        typename std::list<std::shared_ptr<Parked>>::iterator m_position;
+    };
+
+    const std::atomic<State> & m_state;
+    std::map<State, std::list<std::shared_ptr<Parked>>> m_parked;
+    std::map<State, std::set<State>> m_alsoDrainIn;
+    std::set<State> m_draining;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+
+    static bool & IsReplaying()
+    {
+        static thread_local bool replaying = false;
+        return replaying;
+    }
+
+    bool IsDrainState(State target, State state) const;
+    void Drain(State state);
+    void Expire(State state, const std::weak_ptr<Parked> & weak);
+};
+
+template <class State>
+void StateNotifier<State>::Notify()
+{
+    std::vector<State> targets;
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        m_condition.notify_all();
+
+        State state = m_state;
+        for (const auto & parked : m_parked)
+        {
+            if (!parked.second.empty() && IsDrainState(parked.first, state) && 
+                (m_draining.count(parked.first) == 0))
+            {
+                m_draining.insert(parked.first);
+                targets.push_back(parked.first);
+            }
+        }
+    }
+
+    // Replay off the caller's thread, which may hold locks the parked handlers need
+    for (const auto & target : targets)
+    {
+        Executor::GetInstance().PostBlocking([this, target]() { Drain(target); });
+    }
+}
+
+template <class State>
+template <class Predicate>
+bool StateNotifier<State>::WaitFor(Predicate pred, std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    return m_condition.wait_for(lock, timeout, pred);
+}
+
+template <class State>
+bool StateNotifier<State>::ParkUntil(State target, Task task, std::chrono::milliseconds timeout)
+{
+    if (IsReplaying())
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    auto & queue = m_parked[target];
+
+    // Earlier arrivals for this state go first, even if the state has just been entered
+    if (IsDrainState(target, m_state) && queue.empty() && (m_draining.count(target) == 0))
+    {
+        return false;
+    }
+
+    auto parked = std::make_shared<Parked>();
+    parked->m_task = std::move(task);
+    parked->m_queued = true;
+    parked->m_position = queue.insert(queue.end(), parked);
+
+    std::weak_ptr<Parked> weak = parked;
+    parked->m_timer = Executor::GetInstance().PostAfter(timeout, [this, target, weak]() { Expire(target, weak); });
+
+    return true;
+}
+
+template <class State>
+void StateNotifier<State>::AlsoDrainIn(State target, State other)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_alsoDrainIn[target].insert(other);
+}
+
+template <class State>
+size_t StateNotifier<State>::GetNumParked(State target)
+{
+    std::lock_guard<std::mutex> guard(m_mutex);
+
+    auto it = m_parked.find(target);
+    return (it == m_parked.end()) ? 0 : it->second.size();
+}
+
+template <class State>
+bool StateNotifier<State>::IsDrainState(State target, State state) const
+{
+    if (state == target)
+    {
+        return true;
+    }
+
+    auto it = m_alsoDrainIn.find(target);
+    return (it != m_alsoDrainIn.end()) && (it->second.count(state) > 0);
+}
+
+template <class State>
+void StateNotifier<State>::Drain(State state)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    auto & queue = m_parked[state];
+
+    // Anything left once the state moves on waits for the next entry into this state
+    while (!queue.empty() && IsDrainState(state, m_state))
+    {
+        std::shared_ptr<Parked> parked = queue.front();
+        queue.pop_front();
+        parked->m_queued = false;
+        parked->m_timer.Cancel();
+
+        lock.unlock();
+        IsReplaying() = true;
+        try
+        {
+            parked->m_task();
+        }
+        catch (const std::exception & e)
+        {
+            LOG_MESSAGE("Error: Parked task threw exception: " << e.what());
+        }
+        catch (const char * e)
+        {
+            LOG_MESSAGE("Error: Parked task threw: " << e);
+        }
+        catch (...)
+        {
+            // Letting this escape would leave this thread replaying and the state marked as draining for good
+            LOG_MESSAGE("Error: Parked task threw unknown exception");
+        }
+        IsReplaying() = false;
+        lock.lock();
+    }
+
+    m_draining.erase(state);
+}
+
+template <class State>
+void StateNotifier<State>::Expire(State state, const std::weak_ptr<Parked> & weak)
+{
+    Task task;
+
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+
+        std::shared_ptr<Parked> parked = weak.lock();
+        if (!parked || !parked->m_queued)
+        {
+            return;
+        }
+
+        m_parked[state].erase(parked->m_position);
+        parked->m_queued = false;
+        task = std::move(parked->m_task);
+    }
+
+    LOG_MESSAGE("Dropped message parked for state " << static_cast<int>(state) << " (deadline passed)");
+}
+
+#endif // __STATENOTIFIER_H__
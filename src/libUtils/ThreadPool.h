@@ -17,54 +17,32 @@
 #ifndef CONCURRENT_THREADPOOL_H
 #define CONCURRENT_THREADPOOL_H
 
-#include <thread>
 #include <mutex>
 #include <functional>
 #include <condition_variable>
-
-/**
- *  Set to 1 to use vector instead of queue for jobs container to improve
- *  memory locality however changes job order from FIFO to LIFO.
- */
-#define CONTIGUOUS_JOBS_MEMORY 0
-#if CONTIGUOUS_JOBS_MEMORY
-#include <vector>
-#else
+#include <memory>
 #include <queue>
-#endif
+
+#include "libUtils/Executor.h"
+#include "libUtils/Logger.h"
 
 /**
- *  Simple ThreadPool that creates `threadCount` threads upon its creation,
- *  and pulls from a queue to get new jobs.
+ *  Simple ThreadPool that runs at most `threadCount` jobs at a time,
+ *  pulling from a queue to get new jobs. The jobs run on the process-wide
+ *  Executor's blocking pool, so creating a ThreadPool per operation no
+ *  longer creates and tears down threads.
  *
- *  This class requires a number of c++11 features be present in your compiler.
+ *  A thread waiting in `ThreadPool::WaitAll` runs queued jobs itself
+ *  instead of only sleeping. A pool created inside a job of another pool
+ *  (e.g. a multicast started from a forwarded message) therefore finishes
+ *  even when the blocking pool has no thread left to give it.
  */
 class ThreadPool
 {
 public:
-#if CONTIGUOUS_JOBS_MEMORY
-    explicit ThreadPool(const unsigned int threadCount, const unsigned int jobsReserveCount = 0) :
-#else
     explicit ThreadPool(const unsigned int threadCount) :
-#endif
-        _jobsLeft(0),
-        _bailout(false)
+        _state(std::make_shared<State>(threadCount > 0 ? threadCount : 1))
     {
-        _threads.reserve(threadCount);
-        for (unsigned int index = 0; index < threadCount; ++index)
-        {
-            _threads.push_back(std::thread([this]
-            {
-                this->Task();
-            }));
-        }
-
-#if CONTIGUOUS_JOBS_MEMORY
-        if (jobsReserveCount > 0)
-        {
-            _queue.reserve(jobsReserveCount);
-        }
-#endif
     }
 
     /**
@@ -76,153 +54,146 @@ public:
     }
 
     /**
-     *  Add a new job to the pool. If there are no jobs in the queue,
-     *  a thread is woken up to take the job. If all threads are busy,
-     *  the job is added to the end of the queue.
+     *  Add a new job to the pool. If fewer than `threadCount` jobs are
+     *  running, a runner is started for it right away. Otherwise it waits
+     *  at the end of the queue.
      */
     void AddJob(const std::function<void()>& job)
     {
-        // scoped lock
+        std::lock_guard<std::mutex> lock(_state->_mutex);
+
+        if (_state->_bailout)
         {
-            std::lock_guard<std::mutex> lock(_queueMutex);
-#if CONTIGUOUS_JOBS_MEMORY
-            _queue.push_back(job);
-#else
-            _queue.push(job);
-#endif
+            return;
         }
-        // scoped lock
+
+        ++_state->_jobsLeft;
+        _state->_queue.push(job);
+
+        if (_state->_runners < _state->_maxRunning)
         {
-            std::lock_guard<std::mutex> lock(_jobsLeftMutex);
-            ++_jobsLeft;
+            ++_state->_runners;
+            std::shared_ptr<State> state = _state;
+            Executor::GetInstance().PostBlocking([state]
+            {
+                Run(*state);
+            });
         }
-        _jobAvailableVar.notify_one();
     }
 
     /**
-     *  Join with all threads. Block until all threads have completed.
-     *  The queue may be filled after this call, but the threads will
-     *  be done. After invoking `ThreadPool::JoinAll`, the pool can no
-     *  longer be used.
+     *  Block until the running jobs have completed. Jobs still in the
+     *  queue are discarded. After invoking `ThreadPool::JoinAll`, the
+     *  pool can no longer be used.
      */
     void JoinAll()
     {
-        // scoped lock
-        {
-            std::lock_guard<std::mutex> lock(_queueMutex);
-            if (_bailout)
-            {
-                return;
-            }
-            _bailout = true;
-        }
+        State & state = *_state;
+        std::unique_lock<std::mutex> lock(state._mutex);
 
-        // note that we're done, and wake up any thread that's
-        // waiting for a new job
-        _jobAvailableVar.notify_all();
+        state._bailout = true;
+        state._jobsLeft -= state._queue.size();
+        state._queue = std::queue<std::function<void()>>();
 
-        for (std::thread& thread : _threads)
+        // Runners that have not started yet find the queue empty, and they
+        // keep the state alive themselves, so only running jobs are waited on
+        state._doneVar.wait(lock, [&state]
         {
-            if (thread.joinable())
-            {
-                thread.join();
-            }
-        }
+            return state._active == 0;
+        });
     }
 
     /**
-     *  Wait for the pool to empty before continuing.
-     *  This does not call `std::thread::join`, it only waits until
-     *  all jobs have finished executing.
+     *  Wait for the pool to empty before continuing. Queued jobs are run
+     *  on the calling thread while waiting.
      */
     void WaitAll()
     {
-        std::unique_lock<std::mutex> lock(_jobsLeftMutex);
-        if (_jobsLeft > 0)
+        State & state = *_state;
+        std::unique_lock<std::mutex> lock(state._mutex);
+
+        while (state._jobsLeft > 0)
         {
-            _waitVar.wait(lock, [this]
+            if (state._queue.empty())
             {
-                return _jobsLeft == 0;
-            });
+                state._doneVar.wait(lock);
+                continue;
+            }
+
+            RunFront(state, lock);
         }
     }
 
-    /**
-     *  Get the vector of threads themselves, in order to set the
-     *  affinity, or anything else you might want to do
-     */
-    std::vector<std::thread>& GetThreads()
+private:
+    struct State
     {
-        return _threads;
-    }
+        explicit State(unsigned int maxRunning) :
+            _maxRunning(maxRunning),
+            _runners(0),
+            _active(0),
+            _jobsLeft(0),
+            _bailout(false)
+        {
+        }
+
+        std::queue<std::function<void()>> _queue;
+
+        const unsigned int _maxRunning;
+        unsigned int _runners;
+        unsigned int _active;
+        int _jobsLeft;
+        bool _bailout;
+        std::condition_variable _doneVar;
+        std::mutex _mutex;
+    };
 
-private:
     /**
-     *  Take the next job in the queue and run it.
-     *  Notify the main thread that a job has completed.
+     *  Take the job at the front of the queue and run it with the lock
+     *  released. Notify waiters once it has completed, even if it threw.
      */
-    void Task()
+    static void RunFront(State & state, std::unique_lock<std::mutex> & lock)
     {
-        while (true)
-        {
-            std::function<void()> job;
-
-            // scoped lock
-            {
-                std::unique_lock<std::mutex> lock(_queueMutex);
-
-                if (_bailout)
-                {
-                    return;
-                }
-
-                // Wait for a job if we don't have any.
-                _jobAvailableVar.wait(lock, [this]
-                {
-                    return !_queue.empty() || _bailout;
-                });
-
-                if (_bailout)
-                {
-                    return;
-                }
-
-                // Get job from the queue
-#if CONTIGUOUS_JOBS_MEMORY
-                job = _queue.back();
-                _queue.pop_back();
-#else
-                job = _queue.front();
-                _queue.pop();
-#endif
-            }
+        std::function<void()> job = std::move(state._queue.front());
+        state._queue.pop();
+        ++state._active;
 
+        lock.unlock();
+        try
+        {
             job();
+        }
+        catch (const std::exception & e)
+        {
+            LOG_MESSAGE("Error: ThreadPool job threw exception: " << e.what());
+        }
+        catch (...)
+        {
+            // Letting this escape would skip the counts below and leave WaitAll and JoinAll hanging
+            LOG_MESSAGE("Error: ThreadPool job threw unknown exception");
+        }
+        lock.lock();
 
-            // scoped lock
-            {
-                std::lock_guard<std::mutex> lock(_jobsLeftMutex);
-                --_jobsLeft;
-            }
+        --state._active;
+        --state._jobsLeft;
+        state._doneVar.notify_all();
+    }
 
-            _waitVar.notify_one();
+    /**
+     *  Keep taking jobs from the queue until it is empty.
+     */
+    static void Run(State & state)
+    {
+        std::unique_lock<std::mutex> lock(state._mutex);
+
+        while (!state._queue.empty() && !state._bailout)
+        {
+            RunFront(state, lock);
         }
+
+        --state._runners;
     }
 
-    std::vector<std::thread> _threads;
-#if CONTIGUOUS_JOBS_MEMORY
-    std::vector<std::function<void()>> _queue;
-#else
-    std::queue<std::function<void()>> _queue;
-#endif
-
-    int _jobsLeft;
-    bool _bailout;
-    std::condition_variable _jobAvailableVar;
-    std::condition_variable _waitVar;
-    std::mutex _jobsLeftMutex;
-    std::mutex _queueMutex;
+    std::shared_ptr<State> _state;
 };
 
-#undef CONTIGUOUS_JOBS_MEMORY
-#endif //CONCURRENT_THREADPOOL_H
\ No newline at end of file
+#endif //CONCURRENT_THREADPOOL_H
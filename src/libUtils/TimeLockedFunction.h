@@ -18,82 +18,130 @@
 #ifndef __TIMELOCKEDFUNCTION_H__
 #define __TIMELOCKEDFUNCTION_H__
 
-#include <thread>
+#include <condition_variable>
 #include <future>
 #include <memory>
+#include <mutex>
 #include <functional>
 #include <chrono>
 
+#include "libUtils/Executor.h"
 #include "libUtils/Logger.h"
 
 using namespace std;
 
-/// Utility class for executing a primary function and a subsequent expiry function in separate join-able threads.
+/// Utility class for executing a primary function and a subsequent expiry function.
+/// The primary function runs on the Executor's blocking pool and the expiry is a cancellable
+/// TimerWheel timer, so no thread sleeps for the duration of the window and a primary function
+/// that finishes early releases the window immediately.
 class TimeLockedFunction
 {
 private:
+    struct CompletionState
+    {
+        mutex m;
+        condition_variable cv;
+        int pending = 2; // primary path + expiry path
+    };
+
     shared_ptr<promise<int>> result_promise;
     future<int> result_future;
+    shared_ptr<CompletionState> completion;
 
-    unique_ptr<thread> thread_main;
-    unique_ptr<thread> thread_timer;
+    static void MarkDone(const shared_ptr<CompletionState> & completion)
+    {
+        lock_guard<mutex> guard(completion->m);
+        completion->pending--;
+        completion->cv.notify_all();
+    }
 
 public:
 
     /// Template constructor.
     template <class callable1, class callable2>
-    TimeLockedFunction(unsigned int expiration_in_seconds, callable1&& main_func, callable2&& expiration_func, bool call_expiry_always) : result_promise(new promise<int>)
+    TimeLockedFunction(unsigned int expiration_in_seconds, callable1&& main_func, callable2&& expiration_func, bool call_expiry_always) : result_promise(new promise<int>), completion(make_shared<CompletionState>())
     {
         function<typename result_of<callable1()>::type()> task_main(main_func);
         function<typename result_of<callable2()>::type()> task_expiry(expiration_func);
 
         result_future = result_promise->get_future();
 
-        auto func_main = [task_main, task_expiry, call_expiry_always](shared_ptr<promise<int>> result_promise) -> void
+        auto result = result_promise;
+        auto done = completion;
+
+        auto func_timer = [expiration_in_seconds, task_expiry, result, done]() -> void
         {
             try
             {
-                task_main();
-                result_promise->set_value(0);
-                if (call_expiry_always)
-                {
-                    task_expiry();
-                }
+                LOG_MESSAGE("Window of " + to_string(expiration_in_seconds) + " seconds has expired");
+                result->set_value(-1);
+                task_expiry();
             }
             catch(future_error &)
             {
-                // Function returned too late
+                // Function returned on time
+            }
+            catch(...)
+            {
+                LOG_MESSAGE("Error: Expiry function threw an exception");
             }
+            MarkDone(done);
         };
 
-        thread_main = make_unique<thread>(func_main, result_promise);
+        LOG_MESSAGE("Expiry scheduled in " + to_string(expiration_in_seconds) + " seconds");
+        TimerHandle timer = Executor::GetInstance().PostBlockingAfter(chrono::seconds(expiration_in_seconds), func_timer);
 
-        auto func_timer = [expiration_in_seconds, task_expiry](shared_ptr<promise<int>> result_promise) -> void
+        auto func_main = [task_main, task_expiry, call_expiry_always, result, done, timer]() mutable -> void
         {
+            bool completed = false;
             try
             {
-                LOG_MESSAGE("I am going to sleep for " + to_string(expiration_in_seconds) + " seconds");
-                this_thread::sleep_for(chrono::seconds(expiration_in_seconds));
-                LOG_MESSAGE("I have woken up from the sleep of " + to_string(expiration_in_seconds) + " seconds");
-                result_promise->set_value(-1);
-                task_expiry();
+                task_main();
+                completed = true;
+            }
+            catch(...)
+            {
+                LOG_MESSAGE("Error: Main function threw an exception");
+            }
+
+            try
+            {
+                // A main function that failed ends the window now, as if it had expired
+                result->set_value(completed ? 0 : -1);
+                if (call_expiry_always || !completed)
+                {
+                    task_expiry();
+                }
             }
             catch(future_error &)
             {
-                // Function returned on time
+                // Function returned too late
+            }
+            catch(...)
+            {
+                LOG_MESSAGE("Error: Expiry function threw an exception");
             }
+
+            // The result is set either way, so the expiry path has nothing left to do
+            if (timer.Cancel())
+            {
+                MarkDone(done);
+            }
+            MarkDone(done);
         };
 
-        thread_timer = make_unique<thread>(func_timer, result_promise);
+        Executor::GetInstance().PostBlocking(func_main);
     }
 
-    /// Destructor. Joins both launched threads.
+    /// Destructor. Waits for both the primary and the expiry paths to finish.
     ~TimeLockedFunction()
     {
-        thread_main->join();
-        thread_timer->join();
+        {
+            unique_lock<mutex> lock(completion->m);
+            completion->cv.wait(lock, [this] { return completion->pending == 0; });
+        }
         result_future.get();
     }
 };
 
-#endif // __TIMELOCKEDFUNCTION_H__
\ No newline at end of file
+#endif // __TIMELOCKEDFUNCTION_H__
@@ -0,0 +1,256 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include "Executor.h"
+#include "Logger.h"
+#include "TimerWheel.h"
+
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+const unsigned int TimerWheel::TICK_MILLISECONDS;
+const unsigned int TimerWheel::SLOTS_PER_LEVEL;
+const unsigned int TimerWheel::NUM_LEVELS;
+
+namespace
+{
+    const unsigned int SLOT_BITS = 8;
+    const uint64_t SLOT_MASK = TimerWheel::SLOTS_PER_LEVEL - 1;
+
+    static_assert((1u << SLOT_BITS) == TimerWheel::SLOTS_PER_LEVEL, "SLOT_BITS must match SLOTS_PER_LEVEL");
+}
+
+bool TimerHandle::Cancel()
+{
+    shared_ptr<Entry> entry = m_entry.lock();
+    if (!entry)
+    {
+        return false;
+    }
+
+    return TimerWheel::GetInstance().Cancel(entry);
+}
+
+bool TimerHandle::IsPending() const
+{
+    shared_ptr<Entry> entry = m_entry.lock();
+    if (!entry)
+    {
+        return false;
+    }
+
+    lock_guard<mutex> guard(TimerWheel::GetInstance().m_mutex);
+    return entry->m_pending;
+}
+
+TimerWheel::TimerWheel() : m_currentTick(0), m_start(Clock::now()), m_numPending(0)
+{
+    thread(&TimerWheel::DriverLoop, this).detach();
+}
+
+TimerWheel::~TimerWheel()
+{
+}
+
+TimerWheel & TimerWheel::GetInstance()
+{
+    // Never destroyed, so the detached driver thread can never outlive it
+    static TimerWheel * wheel = new TimerWheel();
+    return *wheel;
+}
+
+uint64_t TimerWheel::NowTick() const
+{
+    return chrono::duration_cast<chrono::milliseconds>(Clock::now() - m_start).count() / TICK_MILLISECONDS;
+}
+
+TimerHandle TimerWheel::Schedule(chrono::milliseconds delay, Task task, bool blocking)
+{
+    // Round up so a timer never fires before its delay, and always wait at least one tick
+    uint64_t ticks = (max<int64_t>(delay.count(), 0) + TICK_MILLISECONDS - 1) / TICK_MILLISECONDS;
+    ticks = max<uint64_t>(ticks, 1);
+
+    // Beyond the span of the top level a slot would be revisited before the timer is due
+    const uint64_t maxTicks = (1ULL << (SLOT_BITS * (NUM_LEVELS - 1))) * (SLOTS_PER_LEVEL - 1);
+    if (ticks > maxTicks)
+    {
+        LOG_MESSAGE("Warning: Timer delay of " << delay.count() << " ms clamped to " << maxTicks * TICK_MILLISECONDS << " ms");
+        ticks = maxTicks;
+    }
+
+    shared_ptr<TimerHandle::Entry> entry = make_shared<TimerHandle::Entry>();
+    entry->m_blocking = blocking;
+    entry->m_pending = true;
+    entry->m_task = move(task);
+    entry->m_slot = nullptr;
+
+    bool wasEmpty;
+    {
+        lock_guard<mutex> guard(m_mutex);
+
+        wasEmpty = (m_numPending == 0);
+        if (wasEmpty)
+        {
+            // Nothing is pending, so the idle driver's tick can jump straight to the present
+            m_currentTick = max(m_currentTick, NowTick());
+        }
+
+        // The current tick is already partly over, so count from the next one
+        entry->m_expiry = max(m_currentTick, NowTick()) + ticks + 1;
+        Place(entry);
+        m_numPending++;
+    }
+
+    if (wasEmpty)
+    {
+        m_condition.notify_one();
+    }
+
+    return TimerHandle(entry);
+}
+
+size_t TimerWheel::GetNumPending() const
+{
+    lock_guard<mutex> guard(m_mutex);
+    return m_numPending;
+}
+
+void TimerWheel::Place(const shared_ptr<TimerHandle::Entry> & entry)
+{
+    uint64_t delta = (entry->m_expiry > m_currentTick) ? (entry->m_expiry - m_currentTick) : 0;
+
+    unsigned int level = 0;
+    while ((level + 1 < NUM_LEVELS) && (delta >= (1ULL << (SLOT_BITS * (level + 1)))))
+    {
+        level++;
+    }
+
+    uint64_t when = (delta == 0) ? m_currentTick : entry->m_expiry;
+    Slot & target = m_slots[level][(when >> (SLOT_BITS * level)) & SLOT_MASK];
+
+    if (entry->m_slot == nullptr)
+    {
+        entry->m_position = target.insert(target.end(), entry);
+    }
+    else
+    {
+        // Splicing keeps the entry's iterator valid, so a cascade never reallocates
+        target.splice(target.end(), *entry->m_slot, entry->m_position);
+    }
+
+    entry->m_slot = &target;
+}
+
+void TimerWheel::Cascade(unsigned int level)
+{
+    Slot cascading;
+    cascading.splice(cascading.end(), m_slots[level][(m_currentTick >> (SLOT_BITS * level)) & SLOT_MASK]);
+
+    while (!cascading.empty())
+    {
+        shared_ptr<TimerHandle::Entry> entry = cascading.front();
+        entry->m_slot = &cascading;
+        Place(entry);
+    }
+}
+
+bool TimerWheel::Cancel(const shared_ptr<TimerHandle::Entry> & entry)
+{
+    Task task;
+
+    {
+        lock_guard<mutex> guard(m_mutex);
+
+        if (!entry->m_pending)
+        {
+            return false;
+        }
+
+        entry->m_pending = false;
+        task = move(entry->m_task);
+        entry->m_slot->erase(entry->m_position);
+        entry->m_slot = nullptr;
+        m_numPending--;
+    }
+
+    // The task (and whatever it captured) is released outside the lock
+    return true;
+}
+
+void TimerWheel::DriverLoop()
+{
+    vector<shared_ptr<TimerHandle::Entry>> due;
+    unique_lock<mutex> lock(m_mutex);
+
+    while (true)
+    {
+        if (m_numPending == 0)
+        {
+            m_condition.wait(lock, [this] { return m_numPending > 0; });
+            continue;
+        }
+
+        if (m_currentTick >= NowTick())
+        {
+            m_condition.wait_until(lock, m_start + chrono::milliseconds((m_currentTick + 1) * TICK_MILLISECONDS));
+            continue;
+        }
+
+        m_currentTick++;
+
+        // Whenever a level wraps around, pull the next slot of the level above down into the wheel
+        for (unsigned int level = 1; level < NUM_LEVELS; level++)
+        {
+            if ((m_currentTick & ((1ULL << (SLOT_BITS * level)) - 1)) != 0)
+            {
+                break;
+            }
+            Cascade(level);
+        }
+
+        Slot & slot = m_slots[0][m_currentTick & SLOT_MASK];
+        for (auto & entry : slot)
+        {
+            entry->m_pending = false;
+            entry->m_slot = nullptr;
+            due.push_back(entry);
+        }
+        m_numPending -= slot.size();
+        slot.clear();
+
+        if (due.empty())
+        {
+            continue;
+        }
+
+        lock.unlock();
+        for (auto & entry : due)
+        {
+            if (entry->m_blocking)
+            {
+                Executor::GetInstance().PostBlocking(move(entry->m_task));
+            }
+            else
+            {
+                Executor::GetInstance().Post(move(entry->m_task));
+            }
+        }
+        due.clear();
+        lock.lock();
+    }
+}
@@ -0,0 +1,127 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#ifndef __TIMERWHEEL_H__
+#define __TIMERWHEEL_H__
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+
+class TimerWheel;
+
+/// Handle to a timer scheduled on the TimerWheel. Copies refer to the same timer.
+class TimerHandle
+{
+    friend class TimerWheel;
+
+    struct Entry;
+    std::weak_ptr<Entry> m_entry;
+
+    explicit TimerHandle(const std::shared_ptr<Entry> & entry) : m_entry(entry)
+    {
+    }
+
+public:
+
+    /// Default constructor. Creates a handle that refers to no timer.
+    TimerHandle()
+    {
+    }
+
+    /// Cancels the timer. Returns true if it was still pending and will now never run.
+    bool Cancel();
+
+    /// Returns true if the timer has neither fired nor been cancelled.
+    bool IsPending() const;
+};
+
+/// Process-wide hierarchical timer wheel.
+///
+/// Time advances in ticks of TICK_MILLISECONDS. Level 0 holds timers due within the next
+/// SLOTS_PER_LEVEL ticks; every higher level covers SLOTS_PER_LEVEL times the span of the one below,
+/// and its slots are cascaded down as the lower level wraps around. Each slot is a linked list and
+/// every timer remembers its own position, so scheduling and cancelling are O(1) regardless of how
+/// many timers are pending. A single driver thread advances the wheel and hands due tasks to the
+/// Executor; it sleeps without a deadline while no timers are pending.
+class TimerWheel
+{
+public:
+
+    using Task = std::function<void()>;
+    using Clock = std::chrono::steady_clock;
+
+    /// Resolution of the wheel. Timers fire at most one tick late.
+    static const unsigned int TICK_MILLISECONDS = 10;
+
+    /// Number of slots in each level (must be a power of two).
+    static const unsigned int SLOTS_PER_LEVEL = 256;
+
+    /// Number of levels. 4 levels of 256 slots at 10 ms ticks span more than a year.
+    static const unsigned int NUM_LEVELS = 4;
+
+    /// Returns the singleton instance. The instance lives until process exit.
+    static TimerWheel & GetInstance();
+
+    /// Schedules the task to be posted to the Executor once the delay has elapsed.
+    /// If blocking is true the task is posted to the Executor's blocking pool.
+    TimerHandle Schedule(std::chrono::milliseconds delay, Task task, bool blocking);
+
+    /// Returns the number of timers that have neither fired nor been cancelled.
+    size_t GetNumPending() const;
+
+private:
+
+    using Slot = std::list<std::shared_ptr<TimerHandle::Entry>>;
+
+    friend class TimerHandle;
+
+    Slot m_slots[NUM_LEVELS][SLOTS_PER_LEVEL];
+    uint64_t m_currentTick;
+    Clock::time_point m_start;
+    size_t m_numPending;
+    mutable std::mutex m_mutex;
+    std::condition_variable m_condition;
+
+    TimerWheel();
+    ~TimerWheel();
+
+    TimerWheel(TimerWheel const &) = delete;
+    void operator=(TimerWheel const &) = delete;
+
+    void DriverLoop();
+    void Place(const std::shared_ptr<TimerHandle::Entry> & entry);
+    void Cascade(unsigned int level);
+    bool Cancel(const std::shared_ptr<TimerHandle::Entry> & entry);
+    uint64_t NowTick() const;
+};
+
+struct TimerHandle::Entry
+{
+    uint64_t m_expiry;
+    bool m_blocking;
+    bool m_pending;
+    TimerWheel::Task m_task;
+    TimerWheel::Slot * m_slot;
+    TimerWheel::Slot::iterator m_position;
+};
+
+#endif // __TIMERWHEEL_H__
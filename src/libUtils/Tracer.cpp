@@ -0,0 +1,190 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "Executor.h"
+#include "Logger.h"
+#include "Tracer.h"
+
+using namespace std;
+
+atomic<int> Tracer::s_level(TRACE_OFF);
+
+Tracer::Tracer() : m_epoch(0), m_processName("zilliqa"), m_fnamePrefix("trace-epoch-")
+{
+}
+
+Tracer & Tracer::GetInstance()
+{
+    static Tracer tracer;
+    return tracer;
+}
+
+void Tracer::Init(const string & processName, const string & fnamePrefix)
+{
+    lock_guard<mutex> g(m_mutex);
+    m_processName = processName;
+    m_fnamePrefix = fnamePrefix;
+}
+
+void Tracer::SetLevel(TraceLevel level)
+{
+    s_level.store(level, memory_order_relaxed);
+}
+
+TraceLevel Tracer::GetLevel()
+{
+    return static_cast<TraceLevel>(s_level.load(memory_order_relaxed));
+}
+
+uint64_t Tracer::Now()
+{
+    return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+Tracer::ThreadBuffer & Tracer::GetThreadBuffer()
+{
+    // The registry shares ownership, so spans of a thread that has exited are still exported
+    static thread_local shared_ptr<ThreadBuffer> buffer;
+    if (!buffer)
+    {
+        buffer = make_shared<ThreadBuffer>();
+        buffer->m_tid = syscall(SYS_gettid);
+        buffer->m_dropped = 0;
+
+        lock_guard<mutex> g(m_mutex);
+        m_buffers.push_back(buffer);
+    }
+    return *buffer;
+}
+
+void Tracer::Record(const char * name, uint64_t start, uint64_t end, uint64_t epoch)
+{
+    ThreadBuffer & buffer = GetThreadBuffer();
+
+    lock_guard<mutex> g(buffer.m_mutex);
+    if (buffer.m_spans.size() >= MAX_SPANS_PER_THREAD)
+    {
+        buffer.m_dropped++;
+        return;
+    }
+    buffer.m_spans.push_back({ name, start, end - start, epoch });
+}
+
+void Tracer::Drain(vector<pair<pid_t, vector<TraceSpanRecord>>> & spans, uint64_t & dropped)
+{
+    lock_guard<mutex> g(m_mutex);
+
+    for (auto it = m_buffers.begin(); it != m_buffers.end();)
+    {
+        ThreadBuffer & buffer = **it;
+        {
+            lock_guard<mutex> bg(buffer.m_mutex);
+            if (!buffer.m_spans.empty())
+            {
+                spans.emplace_back(buffer.m_tid, vector<TraceSpanRecord>());
+                spans.back().second.swap(buffer.m_spans);
+            }
+            dropped += buffer.m_dropped;
+            buffer.m_dropped = 0;
+        }
+
+        // Only the registry holds the buffer once its thread has exited
+        it = (it->use_count() == 1) ? m_buffers.erase(it) : it + 1;
+    }
+}
+
+namespace
+{
+    void WriteJsonString(ostream & os, const string & value)
+    {
+        os << '"';
+        for (char c : value)
+        {
+            if ((c == '"') || (c == '\\'))
+            {
+                os << '\\';
+            }
+            os << c;
+        }
+        os << '"';
+    }
+}
+
+void Tracer::Export(ostream & os)
+{
+    vector<pair<pid_t, vector<TraceSpanRecord>>> spans;
+    uint64_t dropped = 0;
+    Drain(spans, dropped);
+
+    string processName;
+    {
+        lock_guard<mutex> g(m_mutex);
+        processName = m_processName;
+    }
+
+    const pid_t pid = getpid();
+
+    // Complete ("X") events with microsecond timestamps, plus the process name as metadata
+    os << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid << ",\"args\":{\"name\":";
+    WriteJsonString(os, processName);
+    os << "}}";
+
+    os << fixed << setprecision(3);
+    for (const auto & thread : spans)
+    {
+        for (const auto & span : thread.second)
+        {
+            os << ",\n{\"name\":";
+            WriteJsonString(os, span.m_name);
+            os << ",\"cat\":\"zilliqa\",\"ph\":\"X\",\"ts\":" << span.m_start / 1000.0 << ",\"dur\":"
+               << span.m_duration / 1000.0 << ",\"pid\":" << pid << ",\"tid\":" << thread.first
+               << ",\"args\":{\"epoch\":" << span.m_epoch << "}}";
+        }
+    }
+
+    os << "\n],\"otherData\":{\"dropped_spans\":" << dropped << "}}\n";
+}
+
+void Tracer::StartEpoch(uint64_t epoch)
+{
+    uint64_t previous = m_epoch.exchange(epoch, memory_order_relaxed);
+    if ((previous == epoch) || (GetLevel() == TRACE_OFF))
+    {
+        return;
+    }
+
+    string fname;
+    {
+        lock_guard<mutex> g(m_mutex);
+        fname = m_fnamePrefix + to_string(previous) + ".json";
+    }
+
+    Executor::GetInstance().PostBlocking([this, fname]() -> void
+    {
+        ofstream file(fname, ios::trunc);
+        Export(file);
+        if (!file)
+        {
+            LOG_MESSAGE("Error: Failed to write trace " << fname);
+        }
+    });
+}
@@ -0,0 +1,145 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+#ifndef __TRACER_H__
+#define __TRACER_H__
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <sys/types.h>
+#include <vector>
+
+/// Which spans are recorded. Each level includes the ones before it.
+enum TraceLevel : int
+{
+    TRACE_OFF = 0,
+    TRACE_PHASES,   // spans around the epoch phases (TRACE_SPAN, TRACE_MARKER)
+    TRACE_ALL       // every LOG_MARKER as well
+};
+
+/// One completed span. Names must be string literals or otherwise outlive the tracer.
+struct TraceSpanRecord
+{
+    const char * m_name;
+    uint64_t m_start;
+    uint64_t m_duration;
+    uint64_t m_epoch;
+};
+
+/// Records timed spans into per-thread buffers and exports them in the Chrome trace-event format,
+/// which chrome://tracing and Perfetto load directly.
+///
+/// A span costs two steady clock reads and an append to the calling thread's own buffer; the buffer
+/// lock is only ever contended while an export drains it. Spans are tagged with the epoch current when
+/// they started. Moving to a new epoch writes everything recorded so far to <prefix><old epoch>.json,
+/// so spans still running at that point land in the next epoch's file.
+class Tracer
+{
+    struct ThreadBuffer
+    {
+        std::mutex m_mutex;
+        std::vector<TraceSpanRecord> m_spans;
+        pid_t m_tid;
+        uint64_t m_dropped;
+    };
+
+    std::mutex m_mutex;
+    std::vector<std::shared_ptr<ThreadBuffer>> m_buffers;
+    std::atomic<uint64_t> m_epoch;
+    std::string m_processName;
+    std::string m_fnamePrefix;
+
+    static std::atomic<int> s_level;
+
+    Tracer();
+
+    ThreadBuffer & GetThreadBuffer();
+    void Drain(std::vector<std::pair<pid_t, std::vector<TraceSpanRecord>>> & spans, uint64_t & dropped);
+
+public:
+
+    /// Spans a thread can hold between exports; later ones are dropped and counted.
+    static const size_t MAX_SPANS_PER_THREAD = 1 << 16;
+
+    /// Returns the singleton instance.
+    static Tracer & GetInstance();
+
+    /// Sets the process name shown in the viewer and the prefix of the per-epoch files.
+    void Init(const std::string & processName, const std::string & fnamePrefix = "trace-epoch-");
+
+    /// Switches tracing at runtime. Safe to call from a signal handler.
+    static void SetLevel(TraceLevel level);
+
+    static TraceLevel GetLevel();
+
+    /// Returns true if spans of the specified level are currently recorded.
+    static inline bool IsEnabled(TraceLevel level)
+    {
+        return (level != TRACE_OFF) && (level <= s_level.load(std::memory_order_relaxed));
+    }
+
+    /// Returns the monotonic time in nanoseconds.
+    static uint64_t Now();
+
+    /// Returns the epoch new spans are tagged with.
+    uint64_t GetEpoch() const { return m_epoch.load(std::memory_order_relaxed); }
+
+    /// Appends a completed span to the calling thread's buffer.
+    void Record(const char * name, uint64_t start, uint64_t end, uint64_t epoch);
+
+    /// Tags new spans with the specified epoch and, if tracing is on, exports the previous epoch's
+    /// spans to its file on the blocking pool.
+    void StartEpoch(uint64_t epoch);
+
+    /// Removes every recorded span from the buffers and writes them as a trace-event JSON document.
+    void Export(std::ostream & os);
+};
+
+/// Records the lifetime of the object as a span if its level is enabled at construction.
+class TraceSpan
+{
+    const char * m_name;
+    uint64_t m_start;
+    uint64_t m_epoch;
+
+public:
+
+    explicit TraceSpan(const char * name, TraceLevel level = TRACE_PHASES) : m_name(nullptr), m_start(0), m_epoch(0)
+    {
+        if (Tracer::IsEnabled(level))
+        {
+            m_name = name;
+            m_start = Tracer::Now();
+            m_epoch = Tracer::GetInstance().GetEpoch();
+        }
+    }
+
+    ~TraceSpan()
+    {
+        if (m_name != nullptr)
+        {
+            Tracer::GetInstance().Record(m_name, m_start, Tracer::Now(), m_epoch);
+        }
+    }
+};
+
+#define TRACE_SPAN(name) TraceSpan trace_span(name)
+#define TRACE_EPOCH(epoch) Tracer::GetInstance().StartEpoch(static_cast<uint64_t>(epoch))
+
+#endif // __TRACER_H__
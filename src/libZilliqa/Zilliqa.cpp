@@ -20,9 +20,25 @@
 
 using namespace std;
 
+namespace
+{
+    // Consensus phases have timeouts, so consensus never waits behind other classes and is never dropped.
+    // Handlers may block on messages of another class (e.g., a microblock announce waits for
+    // SETMICROBLOCKTXNS), so every class has more than one worker. Only client transactions are dropped
+    // under overload - everything else pushes back on the receiving socket thread.
+    const vector<DispatchQueues::ClassConfig> DISPATCH_CLASSES =
+    {
+        { "consensus",    4, 4096,  DispatchQueues::BLOCK },
+        { "blocks",       2, 1024,  DispatchQueues::BLOCK },
+        { "pow",          2, 4096,  DispatchQueues::BLOCK },
+        { "transactions", 2, 16384, DispatchQueues::DROP_NEWEST },
+        { "lookup",       4, 1024,  DispatchQueues::BLOCK }
+    };
+}
+
 Zilliqa::Zilliqa(const std::pair<PrivKey, PubKey> & key, const Peer & peer, bool loadConfig) :
         m_pm(key, peer, loadConfig), m_mediator(key, peer), m_ds(m_mediator), m_lookup(m_mediator), 
-        m_n(m_mediator), m_cu(key, peer)
+        m_n(m_mediator), m_cu(key, peer), m_numDispatched(0), m_queues(DISPATCH_CLASSES)
 {
     LOG_MARKER();
 
@@ -50,7 +66,71 @@ Zilliqa::~Zilliqa()
 
 }
 
-void Zilliqa::Dispatch(const vector<unsigned char> & message, const Peer & from)
+unsigned int Zilliqa::GetDispatchClass(unsigned char msg_type, unsigned char ins_type)
+{
+    switch (msg_type)
+    {
+        case MessageType::DIRECTORY:
+            switch (ins_type)
+            {
+                case DSInstructionType::POW1SUBMISSION:
+                case DSInstructionType::POW2SUBMISSION:
+                    return POW;
+                case DSInstructionType::MICROBLOCKSUBMISSION:
+                    return BLOCKS;
+                default:
+                    return CONSENSUS;
+            }
+        case MessageType::NODE:
+            switch (ins_type)
+            {
+                case NodeInstructionType::STARTPOW1:
+                    return POW;
+                case NodeInstructionType::CREATETRANSACTION:
+                case NodeInstructionType::SUBMITTRANSACTION:
+                case NodeInstructionType::SUBMITTXNBATCH:
+                    return TRANSACTIONS;
+                case NodeInstructionType::MICROBLOCKCONSENSUS:
+                    return CONSENSUS;
+                default:
+                    return BLOCKS;
+            }
+        case MessageType::CONSENSUSUSER:
+            return CONSENSUS;
+        case MessageType::PEER:
+        case MessageType::LOOKUP:
+        default:
+            return LOOKUP;
+    }
+}
+
+void Zilliqa::Dispatch(const SharedBuffer & message, const Peer & from)
+{
+    LOG_MARKER();
+
+    if (message.size() < MessageOffset::BODY)
+    {
+        return;
+    }
+
+    const unsigned int cls = GetDispatchClass(message.at(MessageOffset::TYPE), message.at(MessageOffset::INST));
+
+    // The queued task shares the received buffer instead of copying the message
+    auto task = [this, message, from]() -> void { DispatchNow(message.GetVector(), from); };
+    if (!m_queues.Push(cls, task))
+    {
+        LOG_MESSAGE("Dispatch queue full - dropped message type " << std::hex << 
+                    (unsigned int)message.at(MessageOffset::TYPE) << " instruction " << 
+                    (unsigned int)message.at(MessageOffset::INST));
+    }
+
+    if (++m_numDispatched % DISPATCH_STATS_INTERVAL == 0)
+    {
+        m_queues.LogStats();
+    }
+}
+
+void Zilliqa::DispatchNow(const vector<unsigned char> & message, const Peer & from)
 {
     LOG_MARKER();
 
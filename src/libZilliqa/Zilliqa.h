@@ -18,6 +18,7 @@
 #ifndef __ZILLIQA_H__
 #define __ZILLIQA_H__
 
+#include <atomic>
 #include <vector>
 
 #include "libConsensus/ConsensusUser.h"
@@ -28,6 +29,8 @@
 #include "libNetwork/PeerStore.h"
 #include "libNetwork/PeerManager.h"
 #include "libNode/Node.h"
+#include "libUtils/DispatchQueues.h"
+#include "libUtils/SharedBuffer.h"
 
 /// Main Zilliqa class.
 class Zilliqa
@@ -39,6 +42,25 @@ class Zilliqa
     Node m_n;
     ConsensusUser m_cu; // Note: This is just a test class to demo Consensus usage
 
+    // Incoming messages are queued by class so slow or flooded classes cannot delay consensus
+    enum DispatchClass : unsigned int
+    {
+        CONSENSUS = 0x00,
+        BLOCKS,
+        POW,
+        TRANSACTIONS,
+        LOOKUP
+    };
+
+    const static unsigned int DISPATCH_STATS_INTERVAL = 10000; // messages between stats logs
+    std::atomic<uint64_t> m_numDispatched;
+
+    // Declared last so the workers stop before the handlers they call are destroyed
+    DispatchQueues m_queues;
+
+    static unsigned int GetDispatchClass(unsigned char msg_type, unsigned char ins_type);
+    void DispatchNow(const std::vector<unsigned char> & message, const Peer & from);
+
 public:
 
     /// Constructor.
@@ -48,7 +70,7 @@ public:
     ~Zilliqa();
 
     /// Forwards an incoming message for processing by the appropriate subclass.
-    void Dispatch(const std::vector<unsigned char> & message, const Peer & from);
+    void Dispatch(const SharedBuffer & message, const Peer & from);
 
     /// Returns a list of broadcast peers based on the specified message and instruction types.
     std::vector<Peer> RetrieveBroadcastList(unsigned char msg_type, unsigned char ins_type, const Peer & from);
@@ -0,0 +1,258 @@
+/**
+* Copyright (c) 2018 Zilliqa
+* This source code is being disclosed to you solely for the purpose of your participation in
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to
+* the protocols and algorithms that are programmed into, and intended by, the code. You may
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd.,
+* including modifying or publishing the code (or any part of it), and developing or forming
+* another public or private blockchain network. This source code is provided ‘as is’ and no
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed.
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <algorithm>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "common/Constants.h"
+#include "common/Messages.h"
+#include "libConsensus/ConsensusBackup.h"
+#include "libConsensus/ConsensusLeader.h"
+#include "libCrypto/Schnorr.h"
+#include "libNetwork/P2PComm.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE consensusroundtest
+#include <boost/test/included/unit_test.hpp>
+
+using namespace std;
+
+namespace
+{
+    // Consensus message types, as carried in the byte after [CLA] [INS]
+    const unsigned char MSG_CHALLENGE = 0x02;
+    const unsigned char MSG_RECOMMIT = 0x0D;
+
+    const unsigned int COMMITTEE_SIZE = 7;
+    const unsigned int FANOUT = 2;
+    const uint16_t LEADER_ID = 0;
+
+    // Returns the first port from which COMMITTEE_SIZE consecutive ports can be bound. StartMessagePump does not
+    // set SO_REUSEADDR, so ports still held by an earlier run would leave members deaf.
+    uint32_t FindFreePorts(uint32_t first)
+    {
+        for (uint32_t base = first; base < 65535 - COMMITTEE_SIZE; base += COMMITTEE_SIZE)
+        {
+            bool free = true;
+            for (unsigned int i = 0; (i < COMMITTEE_SIZE) && free; i++)
+            {
+                int sock = socket(AF_INET, SOCK_STREAM, 0);
+                struct sockaddr_in addr;
+                memset(&addr, 0, sizeof(struct sockaddr_in));
+                addr.sin_family = AF_INET;
+                addr.sin_port = htons(base + i);
+                addr.sin_addr.s_addr = INADDR_ANY;
+                free = (sock >= 0) && (::bind(sock, (struct sockaddr *) &addr, sizeof(addr)) == 0);
+                if (sock >= 0)
+                {
+                    close(sock);
+                }
+            }
+            if (free)
+            {
+                return base;
+            }
+        }
+        return first;
+    }
+
+    // One committee member: a consensus session and the pump that feeds it, the way Node holds m_consensusObject
+    struct Member
+    {
+        mutex m_mutex;
+        shared_ptr<ConsensusCommon> m_consensus;
+        bool m_dropChallenges = false;
+    };
+
+    // A committee on localhost, each member listening on its own port
+    struct Committee
+    {
+        vector<shared_ptr<Member>> m_members;
+        deque<PubKey> m_pubKeys;
+        deque<Peer> m_peers;
+        vector<PrivKey> m_privKeys;
+        shared_ptr<atomic<unsigned int>> m_recommits;
+
+        Committee(uint32_t first_port) : m_recommits(make_shared<atomic<unsigned int>>(0))
+        {
+            const uint32_t base_port = FindFreePorts(first_port);
+            for (unsigned int i = 0; i < COMMITTEE_SIZE; i++)
+            {
+                pair<PrivKey, PubKey> keypair = Schnorr::GetInstance().GenKeyPair();
+                m_privKeys.push_back(keypair.first);
+                m_pubKeys.push_back(keypair.second);
+                m_peers.push_back(Peer(inet_addr("127.0.0.1"), base_port + i));
+
+                shared_ptr<Member> member = make_shared<Member>();
+                m_members.push_back(member);
+
+                shared_ptr<atomic<unsigned int>> recommits = m_recommits;
+                auto dispatcher = [member, recommits](const SharedBuffer & message, const Peer & from) -> void
+                {
+                    if (message.size() <= MessageOffset::BODY)
+                    {
+                        return;
+                    }
+
+                    lock_guard<mutex> g(member->m_mutex);
+                    const unsigned char type = message.at(MessageOffset::BODY);
+                    if (member->m_dropChallenges && (type == MSG_CHALLENGE))
+                    {
+                        return;
+                    }
+                    if (type == MSG_RECOMMIT)
+                    {
+                        (*recommits)++;
+                    }
+                    if (member->m_consensus != nullptr)
+                    {
+                        member->m_consensus->ProcessMessage(message.GetVector(), MessageOffset::BODY);
+                    }
+                };
+                auto broadcast_list = [](unsigned char, unsigned char, const Peer &) -> vector<Peer> { return vector<Peer>(); };
+
+                const uint32_t port = base_port + i;
+                thread pump([port, dispatcher, broadcast_list]() -> void
+                {
+                    P2PComm::GetInstance().StartMessagePump(port, dispatcher, broadcast_list);
+                });
+                pump.detach();
+            }
+
+            // Let every pump bind before the first message goes out
+            this_thread::sleep_for(chrono::milliseconds(500));
+
+            const vector<unsigned char> block_hash(BLOCK_HASH_SIZE, 0x77);
+            auto validator = [](const vector<unsigned char> &) -> bool { return true; };
+            for (unsigned int i = 0; i < COMMITTEE_SIZE; i++)
+            {
+                lock_guard<mutex> g(m_members.at(i)->m_mutex);
+                if (i == LEADER_ID)
+                {
+                    m_members.at(i)->m_consensus.reset(new ConsensusLeader(1, block_hash, i, m_privKeys.at(i), m_pubKeys, m_peers,
+                                                                           0x00, 0x00, FANOUT));
+                }
+                else
+                {
+                    m_members.at(i)->m_consensus.reset(new ConsensusBackup(1, block_hash, i, LEADER_ID, m_privKeys.at(i), m_pubKeys,
+                                                                           m_peers, 0x00, 0x00, validator, FANOUT));
+                }
+            }
+        }
+
+        ConsensusCommon::State GetState(unsigned int i)
+        {
+            lock_guard<mutex> g(m_members.at(i)->m_mutex);
+            return m_members.at(i)->m_consensus->GetState();
+        }
+
+        void Start()
+        {
+            shared_ptr<ConsensusCommon> leader;
+            {
+                lock_guard<mutex> g(m_members.at(LEADER_ID)->m_mutex);
+                leader = m_members.at(LEADER_ID)->m_consensus;
+            }
+            dynamic_cast<ConsensusLeader*>(leader.get())->StartConsensus(vector<unsigned char>(100, 0xAB));
+        }
+
+        // Waits until every member not listed as faulty reaches DONE or ERROR, or the deadline passes
+        bool WaitUntilDone(const vector<unsigned int> & faulty, chrono::milliseconds deadline)
+        {
+            const auto end = chrono::steady_clock::now() + deadline;
+            while (chrono::steady_clock::now() < end)
+            {
+                bool finished = true;
+                for (unsigned int i = 0; i < COMMITTEE_SIZE; i++)
+                {
+                    if (find(faulty.begin(), faulty.end(), i) != faulty.end())
+                    {
+                        continue;
+                    }
+                    const ConsensusCommon::State state = GetState(i);
+                    finished = finished && ((state == ConsensusCommon::DONE) || (state == ConsensusCommon::ERROR));
+                }
+                if (finished)
+                {
+                    return true;
+                }
+                this_thread::sleep_for(chrono::milliseconds(100));
+            }
+            return false;
+        }
+    };
+
+    chrono::milliseconds RoundDeadline()
+    {
+        return chrono::milliseconds(2 * CONSENSUS_AGGREGATION_MAX_ATTEMPTS *
+                                    (CONSENSUS_AGGREGATION_FALLBACK_TIMEOUT_IN_MILLISECONDS + CONSENSUS_AGGREGATION_RESPONSE_TIMEOUT_IN_MILLISECONDS));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE (consensusroundtest)
+
+BOOST_AUTO_TEST_CASE (test_aggregated_round)
+{
+    INIT_STDOUT_LOGGER();
+
+    Committee committee(5300);
+    committee.Start();
+
+    BOOST_REQUIRE_MESSAGE(committee.WaitUntilDone({}, RoundDeadline()), "Aggregated round did not finish");
+    for (unsigned int i = 0; i < COMMITTEE_SIZE; i++)
+    {
+        BOOST_CHECK_MESSAGE(committee.GetState(i) == ConsensusCommon::DONE, "Member " << i << " did not reach DONE");
+    }
+    BOOST_CHECK_MESSAGE(*committee.m_recommits == 0, "Healthy round should not need a recommit");
+}
+
+BOOST_AUTO_TEST_CASE (test_recommit_on_missing_response)
+{
+    INIT_STDOUT_LOGGER();
+
+    // Member 1 aggregates the commits of 3 and 4 but never answers the challenge, so the leader has to
+    // blame it and ask everyone else for fresh commits
+    Committee committee(5400);
+    const unsigned int faulty = 1;
+    {
+        lock_guard<mutex> g(committee.m_members.at(faulty)->m_mutex);
+        committee.m_members.at(faulty)->m_dropChallenges = true;
+    }
+    committee.Start();
+
+    BOOST_REQUIRE_MESSAGE(committee.WaitUntilDone({ faulty }, RoundDeadline()), "Round with a silent aggregator did not finish");
+    for (unsigned int i = 0; i < COMMITTEE_SIZE; i++)
+    {
+        if (i != faulty)
+        {
+            BOOST_CHECK_MESSAGE(committee.GetState(i) == ConsensusCommon::DONE, "Member " << i << " did not reach DONE");
+        }
+    }
+    BOOST_CHECK_MESSAGE(*committee.m_recommits > 0, "Leader should have sent a recommit");
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -102,6 +102,75 @@ BOOST_AUTO_TEST_CASE (test_multisig)
 
 }
 
+BOOST_AUTO_TEST_CASE (test_subtree_aggregation)
+{
+    INIT_STDOUT_LOGGER();
+
+    Schnorr & schnorr = Schnorr::GetInstance();
+
+    // Two subtrees of an aggregation tree, each combining its members' commits and responses
+    const unsigned int nbsigners = 12;
+    const unsigned int subtree_size = 5;
+    vector<PrivKey> privkeys;
+    vector<PubKey> pubkeys;
+    for (unsigned int i = 0; i < nbsigners; i++)
+    {
+        pair<PrivKey, PubKey> keypair = schnorr.GenKeyPair();
+        privkeys.push_back(keypair.first);
+        pubkeys.push_back(keypair.second);
+    }
+
+    vector<unsigned char> message(1024);
+    generate(message.begin(), message.end(), std::rand);
+
+    vector<CommitSecret> secrets(nbsigners);
+    vector<CommitPoint> points;
+    for (unsigned int i = 0; i < nbsigners; i++)
+    {
+        points.push_back(CommitPoint(secrets.at(i)));
+    }
+
+    // Subtrees [0, 5) and [5, 10) are aggregated below the leader; 10 and 11 commit directly
+    vector<CommitPoint> subtree_points_1(points.begin(), points.begin() + subtree_size);
+    vector<CommitPoint> subtree_points_2(points.begin() + subtree_size, points.begin() + 2 * subtree_size);
+    vector<PubKey> subtree_keys_1(pubkeys.begin(), pubkeys.begin() + subtree_size);
+    vector<PubKey> subtree_keys_2(pubkeys.begin() + subtree_size, pubkeys.begin() + 2 * subtree_size);
+
+    shared_ptr<CommitPoint> subtree_commit_1 = MultiSig::AggregateCommits(subtree_points_1);
+    shared_ptr<CommitPoint> subtree_commit_2 = MultiSig::AggregateCommits(subtree_points_2);
+    shared_ptr<PubKey> subtree_key_1 = MultiSig::AggregatePubKeys(subtree_keys_1);
+    shared_ptr<PubKey> subtree_key_2 = MultiSig::AggregatePubKeys(subtree_keys_2);
+
+    // The leader's challenge is over the aggregate of the pieces it received
+    vector<CommitPoint> pieces = { *subtree_commit_1, *subtree_commit_2, points.at(10), points.at(11) };
+    shared_ptr<CommitPoint> aggregatedCommit = MultiSig::AggregateCommits(pieces);
+    shared_ptr<PubKey> aggregatedPubkey = MultiSig::AggregatePubKeys(pubkeys);
+    BOOST_CHECK_MESSAGE(*aggregatedCommit == *MultiSig::AggregateCommits(points), "Aggregating subtree commits changed the aggregated commit");
+
+    Challenge challenge(*aggregatedCommit, *aggregatedPubkey, message);
+
+    vector<Response> responses;
+    for (unsigned int i = 0; i < nbsigners; i++)
+    {
+        responses.push_back(Response(secrets.at(i), challenge, privkeys.at(i)));
+    }
+
+    // Each subtree response verifies against the subtree key and commit alone
+    vector<Response> subtree_responses_1(responses.begin(), responses.begin() + subtree_size);
+    vector<Response> subtree_responses_2(responses.begin() + subtree_size, responses.begin() + 2 * subtree_size);
+    shared_ptr<Response> subtree_response_1 = MultiSig::AggregateResponses(subtree_responses_1);
+    shared_ptr<Response> subtree_response_2 = MultiSig::AggregateResponses(subtree_responses_2);
+
+    BOOST_CHECK_MESSAGE(MultiSig::VerifyResponse(*subtree_response_1, challenge, *subtree_key_1, *subtree_commit_1) == true, "Subtree response verification failed");
+    BOOST_CHECK_MESSAGE(MultiSig::VerifyResponse(*subtree_response_2, challenge, *subtree_key_2, *subtree_commit_2) == true, "Subtree response verification failed");
+    BOOST_CHECK_MESSAGE(MultiSig::VerifyResponse(*subtree_response_1, challenge, *subtree_key_2, *subtree_commit_2) == false, "Subtree response verified against the wrong subtree");
+
+    // The pieces combine into the same collective signature as flat aggregation
+    vector<Response> piece_responses = { *subtree_response_1, *subtree_response_2, responses.at(10), responses.at(11) };
+    shared_ptr<Signature> signature = MultiSig::AggregateSign(challenge, *MultiSig::AggregateResponses(piece_responses));
+    BOOST_CHECK_MESSAGE(schnorr.Verify(message, *signature, *aggregatedPubkey) == true, "Collective signature from subtree pieces failed");
+}
+
 BOOST_AUTO_TEST_CASE (test_serialization)
 {
     Schnorr & schnorr = Schnorr::GetInstance();
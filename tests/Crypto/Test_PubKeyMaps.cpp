@@ -0,0 +1,195 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <chrono>
+#include <map>
+#include <unordered_map>
+#include <boost/multiprecision/cpp_int.hpp>
+
+#include "libCrypto/Schnorr.h"
+#include "libCrypto/Sha2.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE pubkeymapstest
+#include <boost/test/included/unit_test.hpp>
+
+using namespace std;
+using namespace boost::multiprecision;
+
+namespace
+{
+    const unsigned int NUM_POW2_SUBMISSIONS = 10000;
+    const unsigned int BENCH_COMM_SIZE = 600;
+
+    /// Ordering as it was computed before the compressed encoding was cached.
+    struct LegacyPubKeyLess
+    {
+        bool operator()(const PubKey & l, const PubKey & r) const
+        {
+            unique_ptr<BN_CTX, void (*)(BN_CTX*)> ctx(BN_CTX_new(), BN_CTX_free);
+            const EC_GROUP * group = Schnorr::GetInstance().GetCurve().m_group.get();
+            shared_ptr<BIGNUM> lhs(EC_POINT_point2bn(group, l.m_P.get(), POINT_CONVERSION_COMPRESSED, NULL, ctx.get()), BN_clear_free);
+            shared_ptr<BIGNUM> rhs(EC_POINT_point2bn(group, r.m_P.get(), POINT_CONVERSION_COMPRESSED, NULL, ctx.get()), BN_clear_free);
+            return BN_cmp(lhs.get(), rhs.get()) == -1;
+        }
+    };
+
+    vector<PubKey> & GetKeys()
+    {
+        static vector<PubKey> keys;
+        if (keys.empty())
+        {
+            keys.reserve(NUM_POW2_SUBMISSIONS);
+            for (unsigned int i = 0; i < NUM_POW2_SUBMISSIONS; i++)
+            {
+                keys.push_back(Schnorr::GetInstance().GenKeyPair().second);
+            }
+        }
+        return keys;
+    }
+
+    /// Mirrors DirectoryService::ComputeSharding: sort the PoW2 submissions by H(nonce, pubkey),
+    /// then deal them out round-robin into committees and record each key's shard ID.
+    template <class PoW2Map, class ShardMap, class ShardIdMap>
+    uint64_t RunComputeSharding(const PoW2Map & allPoW2s, vector<ShardMap> & shards, ShardIdMap & shardIds)
+    {
+        auto start = chrono::steady_clock::now();
+
+        uint32_t numOfComms = (allPoW2s.size() + BENCH_COMM_SIZE - 1) / BENCH_COMM_SIZE;
+        shards.assign(numOfComms, ShardMap());
+        shardIds.clear();
+
+        map<array<unsigned char, BLOCK_HASH_SIZE>, PubKey> sortedPoW2s;
+        for (auto & kv : allPoW2s)
+        {
+            SHA2<HASH_TYPE::HASH_VARIANT_256> sha2;
+            vector<unsigned char> hashVec(POW_SIZE + PUB_KEY_SIZE);
+            Serializable::SetNumber<uint256_t>(hashVec, 0, kv.second, UINT256_SIZE);
+            kv.first.Serialize(hashVec, POW_SIZE);
+            sha2.Update(hashVec);
+            const vector<unsigned char> & sortHashVec = sha2.Finalize();
+            array<unsigned char, BLOCK_HASH_SIZE> sortHash;
+            copy(sortHashVec.begin(), sortHashVec.end(), sortHash.begin());
+            sortedPoW2s.insert(make_pair(sortHash, kv.first));
+        }
+
+        unsigned int i = 0;
+        for (auto & kv : sortedPoW2s)
+        {
+            shards.at(i % numOfComms).insert(make_pair(kv.second, i));
+            shardIds.insert(make_pair(kv.second, i % numOfComms));
+            i++;
+        }
+
+        // Shard ID lookups as done per microblock submission
+        uint64_t checksum = 0;
+        for (auto & kv : allPoW2s)
+        {
+            checksum += shardIds.at(kv.first);
+        }
+
+        LOG_MESSAGE("  checksum " << checksum);
+        return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+    }
+}
+
+BOOST_AUTO_TEST_SUITE (pubkeymapstest)
+
+BOOST_AUTO_TEST_CASE (test_ordering_matches_bignum)
+{
+    INIT_STDOUT_LOGGER();
+
+    const vector<PubKey> & keys = GetKeys();
+    LegacyPubKeyLess legacy;
+
+    for (unsigned int i = 1; i < 1000; i++)
+    {
+        const PubKey & a = keys.at(i - 1);
+        const PubKey & b = keys.at(i);
+        BOOST_CHECK_MESSAGE((a < b) == legacy(a, b), "Byte-wise ordering differs from bignum ordering");
+        BOOST_CHECK_MESSAGE((a > b) == legacy(b, a), "Byte-wise ordering differs from bignum ordering");
+    }
+}
+
+BOOST_AUTO_TEST_CASE (test_hash_and_equality)
+{
+    INIT_STDOUT_LOGGER();
+
+    const vector<PubKey> & keys = GetKeys();
+    hash<PubKey> hasher;
+
+    vector<unsigned char> bytes;
+    keys.at(0).Serialize(bytes, 0);
+    PubKey copy1(bytes, 0);
+    PubKey copy2 = keys.at(0);
+
+    BOOST_CHECK_MESSAGE(copy1 == keys.at(0), "Deserialized key not equal to original");
+    BOOST_CHECK_MESSAGE(copy2 == keys.at(0), "Copied key not equal to original");
+    BOOST_CHECK_MESSAGE(hasher(copy1) == hasher(keys.at(0)), "Equal keys hash differently");
+    BOOST_CHECK_MESSAGE(!(keys.at(0) == keys.at(1)), "Distinct keys compare equal");
+
+    unordered_map<PubKey, unsigned int> lookup;
+    for (unsigned int i = 0; i < keys.size(); i++)
+    {
+        lookup.insert(make_pair(keys.at(i), i));
+    }
+    BOOST_CHECK_MESSAGE(lookup.size() == keys.size(), "Keys lost in unordered_map");
+    BOOST_CHECK_MESSAGE(lookup.at(copy1) == 0, "Lookup by deserialized key failed");
+}
+
+BOOST_AUTO_TEST_CASE (test_compute_sharding_benchmark)
+{
+    INIT_STDOUT_LOGGER();
+
+    const vector<PubKey> & keys = GetKeys();
+
+    map<PubKey, uint256_t, LegacyPubKeyLess> legacyPoW2s;
+    unordered_map<PubKey, uint256_t> allPoW2s;
+    for (unsigned int i = 0; i < keys.size(); i++)
+    {
+        legacyPoW2s.insert(make_pair(keys.at(i), uint256_t(i)));
+        allPoW2s.insert(make_pair(keys.at(i), uint256_t(i)));
+    }
+
+    vector<map<PubKey, unsigned int, LegacyPubKeyLess>> legacyShards;
+    map<PubKey, uint32_t, LegacyPubKeyLess> legacyShardIds;
+    uint64_t legacyTime = RunComputeSharding(legacyPoW2s, legacyShards, legacyShardIds);
+
+    vector<map<PubKey, unsigned int>> shards;
+    unordered_map<PubKey, uint32_t> shardIds;
+    uint64_t cachedTime = RunComputeSharding(allPoW2s, shards, shardIds);
+
+    LOG_MESSAGE("ComputeSharding with " << keys.size() << " PoW2 submissions:");
+    LOG_MESSAGE("  bignum comparisons + ordered maps: " << legacyTime << " us");
+    LOG_MESSAGE("  cached encoding + hashed maps:     " << cachedTime << " us");
+
+    // Both layouts must produce the same committees
+    BOOST_CHECK_MESSAGE(legacyShards.size() == shards.size(), "Committee count differs");
+    for (unsigned int i = 0; i < shards.size(); i++)
+    {
+        auto it = shards.at(i).begin();
+        for (auto & kv : legacyShards.at(i))
+        {
+            BOOST_CHECK_MESSAGE(it != shards.at(i).end() && it->first == kv.first, "Committee membership or order differs");
+            if (it != shards.at(i).end())
+            {
+                it++;
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,330 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <chrono>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <boost/multiprecision/cpp_int.hpp>
+
+#include "common/ByteStream.h"
+#include "libData/AccountData/Transaction.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE bytestreamtest
+#include <boost/test/included/unit_test.hpp>
+
+using namespace std;
+using namespace boost::multiprecision;
+
+namespace
+{
+    // The byte loops Serializable used before ByteStream; the wire format must not change
+
+    template<class T>
+    T ReferenceGet(const vector<unsigned char> & src, unsigned int offset, unsigned int len)
+    {
+        T result = 0;
+        unsigned int left_shift = (len - 1) * 8;
+        for (unsigned int i = 0; i < len; i++)
+        {
+            T tmp = src.at(offset + i);
+            result += (tmp << left_shift);
+            left_shift -= 8;
+        }
+        return result;
+    }
+
+    template<class T>
+    void ReferenceSet(vector<unsigned char> & dst, unsigned int offset, T value, unsigned int len)
+    {
+        if (dst.size() < offset + len)
+        {
+            dst.resize(offset + len);
+        }
+        unsigned int right_shift = (len - 1) * 8;
+        for (unsigned int i = 0; i < len; i++)
+        {
+            dst.at(offset + i) = static_cast<unsigned char>((value >> right_shift) & 0xFF);
+            right_shift -= 8;
+        }
+    }
+
+    uint256_t RandomUint256(mt19937_64 & rng)
+    {
+        // Mix full-width values with small ones so short limb counts are covered too
+        uint256_t v = 0;
+        const unsigned int words = rng() % 5;
+        for (unsigned int i = 0; i < words; i++)
+        {
+            v = (v << 64) | uint256_t(rng());
+        }
+        return v;
+    }
+
+    Transaction RandomTransaction(mt19937_64 & rng)
+    {
+        Address toAddr, fromAddr;
+        array<unsigned char, PUB_KEY_SIZE> pubKey;
+        array<unsigned char, TRAN_SIG_SIZE> signature;
+        for (auto & b : toAddr.asArray()) { b = rng(); }
+        for (auto & b : fromAddr.asArray()) { b = rng(); }
+        for (auto & b : pubKey) { b = rng(); }
+        for (auto & b : signature) { b = rng(); }
+        return Transaction(rng(), RandomUint256(rng), toAddr, fromAddr, RandomUint256(rng), pubKey, signature);
+    }
+
+    vector<unsigned char> ReferenceSerialize(const Transaction & tx)
+    {
+        vector<unsigned char> dst(Transaction::GetSerializedSize());
+        unsigned int cur = 0;
+        copy(tx.GetTranID().asArray().begin(), tx.GetTranID().asArray().end(), dst.begin() + cur);
+        cur += TRAN_HASH_SIZE;
+        ReferenceSet<uint32_t>(dst, cur, tx.GetVersion(), sizeof(uint32_t));
+        cur += sizeof(uint32_t);
+        ReferenceSet<uint256_t>(dst, cur, tx.GetNonce(), UINT256_SIZE);
+        cur += UINT256_SIZE;
+        copy(tx.GetToAddr().asArray().begin(), tx.GetToAddr().asArray().end(), dst.begin() + cur);
+        cur += ACC_ADDR_SIZE;
+        copy(tx.GetFromAddr().asArray().begin(), tx.GetFromAddr().asArray().end(), dst.begin() + cur);
+        cur += ACC_ADDR_SIZE;
+        ReferenceSet<uint256_t>(dst, cur, tx.GetAmount(), UINT256_SIZE);
+        cur += UINT256_SIZE;
+        copy(tx.GetSenderPubKey().begin(), tx.GetSenderPubKey().end(), dst.begin() + cur);
+        cur += PUB_KEY_SIZE;
+        copy(tx.GetSignature().begin(), tx.GetSignature().end(), dst.begin() + cur);
+        return dst;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE (bytestreamtest)
+
+BOOST_AUTO_TEST_CASE (test_numbers_match_reference)
+{
+    INIT_STDOUT_LOGGER();
+
+    mt19937_64 rng(11);
+
+    for (unsigned int i = 0; i < 2000; i++)
+    {
+        const uint64_t r = rng();
+        const uint256_t big = RandomUint256(rng);
+        const uint128_t mid = uint128_t(big & ((uint256_t(1) << 128) - 1));
+
+        vector<unsigned char> expected, actual;
+
+        ReferenceSet<uint8_t>(expected, 0, (uint8_t)r, 1);
+        ReferenceSet<uint16_t>(expected, 1, (uint16_t)r, 2);
+        ReferenceSet<uint32_t>(expected, 3, (uint32_t)r, 4);
+        ReferenceSet<uint32_t>(expected, 7, (uint32_t)r, 3);
+        ReferenceSet<uint64_t>(expected, 10, r, 8);
+        ReferenceSet<uint128_t>(expected, 18, mid, UINT128_SIZE);
+        ReferenceSet<uint256_t>(expected, 34, big, UINT256_SIZE);
+        ReferenceSet<uint256_t>(expected, 66, big, 20);
+
+        ByteWriter writer(actual, 0, expected.size());
+        writer.WriteNumber((uint8_t)r, 1);
+        writer.WriteNumber((uint16_t)r, 2);
+        writer.WriteNumber((uint32_t)r, 4);
+        writer.WriteNumber((uint32_t)r, 3);
+        writer.WriteNumber(r, 8);
+        writer.WriteNumber(mid, UINT128_SIZE);
+        writer.WriteNumber(big, UINT256_SIZE);
+        writer.WriteNumber(big, 20);
+
+        BOOST_REQUIRE_MESSAGE(actual == expected, "Stored bytes differ from the reference format");
+        BOOST_CHECK(writer.GetOffset() == expected.size());
+
+        ByteReader reader(actual, 0);
+        BOOST_CHECK(reader.ReadNumber<uint8_t>(1) == ReferenceGet<uint8_t>(expected, 0, 1));
+        BOOST_CHECK(reader.ReadNumber<uint16_t>(2) == ReferenceGet<uint16_t>(expected, 1, 2));
+        BOOST_CHECK(reader.ReadNumber<uint32_t>(4) == ReferenceGet<uint32_t>(expected, 3, 4));
+        BOOST_CHECK(reader.ReadNumber<uint32_t>(3) == ReferenceGet<uint32_t>(expected, 7, 3));
+        BOOST_CHECK(reader.ReadNumber<uint64_t>(8) == r);
+        BOOST_CHECK(reader.ReadNumber<uint128_t>(UINT128_SIZE) == mid);
+        BOOST_CHECK(reader.ReadNumber<uint256_t>(UINT256_SIZE) == big);
+        BOOST_CHECK(reader.ReadNumber<uint256_t>(20) == ReferenceGet<uint256_t>(expected, 66, 20));
+        BOOST_CHECK(reader.Good());
+
+        // Serializable goes through the same fast paths
+        BOOST_CHECK(Serializable::GetNumber<uint256_t>(expected, 34, UINT256_SIZE) == big);
+        BOOST_CHECK(Serializable::GetNumber<uint64_t>(expected, 10, 8) == r);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (test_short_stream)
+{
+    vector<unsigned char> bytes = { 1, 2, 3 };
+
+    ByteReader reader(bytes, 0);
+    BOOST_CHECK(reader.ReadNumber<uint16_t>(2) == 0x0102);
+    BOOST_CHECK(reader.Good());
+    BOOST_CHECK(reader.ReadNumber<uint32_t>(4) == 0);
+    BOOST_CHECK(!reader.Good());
+
+    BOOST_CHECK(Serializable::GetNumber<uint256_t>(bytes, 0, UINT256_SIZE) == 0);
+}
+
+BOOST_AUTO_TEST_CASE (test_index_in_wide_field)
+{
+    mt19937_64 rng(12);
+
+    for (unsigned int i = 0; i < 1000; i++)
+    {
+        // Block numbers are held as uint64_t but sent in the 32-byte uint256_t encoding
+        const uint64_t r = (i % 2 == 0) ? rng() : rng() % 1000;
+
+        vector<unsigned char> expected, actual(UINT256_SIZE, 0xFF);
+        ReferenceSet<uint256_t>(expected, 0, uint256_t(r), UINT256_SIZE);
+        Serializable::SetNumber<uint64_t>(actual, 0, r, UINT256_SIZE);
+
+        BOOST_REQUIRE_MESSAGE(actual == expected, "Padded index differs from the uint256_t encoding");
+        BOOST_CHECK(Serializable::GetNumber<uint64_t>(expected, 0, UINT256_SIZE) == r);
+
+        ByteReader reader(expected, 0);
+        BOOST_CHECK(reader.ReadNumber<uint64_t>(UINT256_SIZE) == r);
+
+        // A block number beyond 64 bits must not wrap around to a small index
+        vector<unsigned char> huge;
+        ReferenceSet<uint256_t>(huge, 0, (uint256_t(1 + i) << 64) + r, UINT256_SIZE);
+        BOOST_CHECK(Serializable::GetNumber<uint64_t>(huge, 0, UINT256_SIZE) == numeric_limits<uint64_t>::max());
+    }
+}
+
+BOOST_AUTO_TEST_CASE (test_layouts)
+{
+    static_assert(Transaction::Layout::NUM_FIELDS == 8, "Transaction has 8 fields");
+    static_assert(Transaction::Layout::SIZE == TRAN_HASH_SIZE + 4 + 32 + 20 + 20 + 32 + PUB_KEY_SIZE + 
+                  TRAN_SIG_SIZE, "Transaction size");
+    static_assert(Transaction::Layout::Offset(2) == TRAN_HASH_SIZE + 4, "Nonce offset");
+    static_assert(Transaction::Layout::Offset(8) == Transaction::Layout::SIZE, "End offset");
+
+    BOOST_CHECK(Transaction::GetSerializedSize() == Transaction::Layout::SIZE);
+}
+
+BOOST_AUTO_TEST_CASE (test_transaction_round_trip)
+{
+    mt19937_64 rng(12);
+
+    for (unsigned int i = 0; i < 500; i++)
+    {
+        Transaction tx = RandomTransaction(rng);
+
+        vector<unsigned char> wire = { 0xAA };
+        BOOST_CHECK(tx.Serialize(wire, 1) == Transaction::GetSerializedSize());
+        BOOST_REQUIRE(wire.size() == 1 + Transaction::GetSerializedSize());
+
+        BOOST_REQUIRE_MESSAGE(vector<unsigned char>(wire.begin() + 1, wire.end()) == ReferenceSerialize(tx),
+                              "Transaction bytes differ from the reference format");
+
+        Transaction copy(wire, 1);
+        BOOST_CHECK(copy == tx);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (test_serialization_throughput)
+{
+    Logger::SetLogLevel(LOG_LEVEL_INFO);
+
+    mt19937_64 rng(13);
+    vector<Transaction> txs;
+    for (unsigned int i = 0; i < 2000; i++)
+    {
+        txs.push_back(RandomTransaction(rng));
+    }
+
+    const unsigned int rounds = 50;
+    const unsigned int size = Transaction::GetSerializedSize();
+    vector<unsigned char> wire(txs.size() * size);
+    uint64_t sink = 0;
+    Address toAddr, fromAddr;
+
+    auto start = chrono::steady_clock::now();
+    for (unsigned int r = 0; r < rounds; r++)
+    {
+        for (unsigned int i = 0; i < txs.size(); i++)
+        {
+            const Transaction & tx = txs[i];
+            const unsigned int offset = i * size + TRAN_HASH_SIZE;
+            ReferenceSet<uint32_t>(wire, offset, tx.GetVersion(), sizeof(uint32_t));
+            ReferenceSet<uint256_t>(wire, offset + 4, tx.GetNonce(), UINT256_SIZE);
+            copy(tx.GetToAddr().asArray().begin(), tx.GetToAddr().asArray().end(), wire.begin() + offset + 36);
+            copy(tx.GetFromAddr().asArray().begin(), tx.GetFromAddr().asArray().end(), wire.begin() + offset + 56);
+            ReferenceSet<uint256_t>(wire, offset + 76, tx.GetAmount(), UINT256_SIZE);
+        }
+        for (unsigned int i = 0; i < txs.size(); i++)
+        {
+            const unsigned int offset = i * size + TRAN_HASH_SIZE;
+            sink += ReferenceGet<uint32_t>(wire, offset, sizeof(uint32_t));
+            sink += ReferenceGet<uint256_t>(wire, offset + 4, UINT256_SIZE).convert_to<uint64_t>();
+            copy(wire.begin() + offset + 36, wire.begin() + offset + 56, toAddr.asArray().begin());
+            copy(wire.begin() + offset + 56, wire.begin() + offset + 76, fromAddr.asArray().begin());
+            sink += ReferenceGet<uint256_t>(wire, offset + 76, UINT256_SIZE).convert_to<uint64_t>();
+        }
+    }
+    auto reference_ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    for (unsigned int r = 0; r < rounds; r++)
+    {
+        for (unsigned int i = 0; i < txs.size(); i++)
+        {
+            const Transaction & tx = txs[i];
+            ByteWriter writer(wire, i * size + TRAN_HASH_SIZE, 0);
+            writer.WriteNumber(tx.GetVersion(), sizeof(uint32_t));
+            writer.WriteNumber(tx.GetNonce(), UINT256_SIZE);
+            writer.WriteBytes(tx.GetToAddr().asArray());
+            writer.WriteBytes(tx.GetFromAddr().asArray());
+            writer.WriteNumber(tx.GetAmount(), UINT256_SIZE);
+        }
+        for (unsigned int i = 0; i < txs.size(); i++)
+        {
+            ByteReader reader(wire, i * size + TRAN_HASH_SIZE);
+            sink += reader.ReadNumber<uint32_t>(sizeof(uint32_t));
+            sink += reader.ReadNumber<uint256_t>(UINT256_SIZE).convert_to<uint64_t>();
+            reader.ReadBytes(toAddr.asArray());
+            reader.ReadBytes(fromAddr.asArray());
+            sink += reader.ReadNumber<uint256_t>(UINT256_SIZE).convert_to<uint64_t>();
+        }
+    }
+    auto fields_ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    for (unsigned int r = 0; r < rounds; r++)
+    {
+        for (unsigned int i = 0; i < txs.size(); i++)
+        {
+            txs[i].Serialize(wire, i * size);
+        }
+        for (unsigned int i = 0; i < txs.size(); i++)
+        {
+            Transaction tx(wire, i * size);
+            sink += tx.GetVersion();
+        }
+    }
+    auto transaction_ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+
+    const uint64_t ops = (uint64_t)rounds * txs.size();
+    LOG_MESSAGE("Number fields of " << ops << " transactions written and read: byte loop " << reference_ns / ops << 
+                " ns/tx, ByteWriter/ByteReader " << fields_ns / ops << " ns/tx (" << (double)reference_ns / max<int64_t>(fields_ns, 1) << "x)");
+    LOG_MESSAGE("Transaction Serialize + Deserialize: " << transaction_ns / ops << " ns/tx, " << 
+                (2.0 * ops * size * 1000.0) / max<int64_t>(transaction_ns, 1) << " MB/s (checksum " << sink % 10 << ")");
+
+    Logger::SetLogLevel(LOG_LEVEL_DEBUG);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,191 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+#include "common/Messages.h"
+#include "libCrypto/Schnorr.h"
+#include "libCrypto/Sha2.h"
+#include "libData/BlockData/Block.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE compactmicroblocktest
+#include <boost/test/included/unit_test.hpp>
+
+using namespace std;
+using namespace boost::multiprecision;
+
+namespace
+{
+    const unsigned int NUM_TXNS = 10000;
+    const unsigned int NUM_MISSING = 100;
+
+    TxnHash MakeTxnHash(unsigned int seed)
+    {
+        SHA2<HASH_TYPE::HASH_VARIANT_256> sha2;
+        vector<unsigned char> input;
+        Serializable::SetNumber<uint32_t>(input, 0, seed, sizeof(uint32_t));
+        sha2.Update(input);
+        const vector<unsigned char> & output = sha2.Finalize();
+
+        TxnHash tranHash;
+        copy(output.begin(), output.end(), tranHash.asArray().begin());
+        return tranHash;
+    }
+
+    MicroBlock MakeMicroBlock(const vector<TxnHash> & tranHashes)
+    {
+        BlockHash prevHash;
+        fill(prevHash.asArray().begin(), prevHash.asArray().end(), 0x77);
+        BlockHash dsBlockHeader;
+        fill(dsBlockHeader.asArray().begin(), dsBlockHeader.asArray().end(), 0x11);
+        TxnHash txRootHash = MakeTxnHash(NUM_TXNS * 2);
+        array<unsigned char, BLOCK_SIG_SIZE> signature;
+        fill(signature.begin(), signature.end(), 0x22);
+
+        MicroBlockHeader header(TXBLOCKTYPE::MICRO, BLOCKVERSION::VERSION1, 100, 1, prevHash, 1, 12345, 
+                                txRootHash, tranHashes.size(), Schnorr::GetInstance().GenKeyPair().second,
+                                1, dsBlockHeader);
+
+        return MicroBlock(header, signature, tranHashes);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE (compactmicroblocktest)
+
+BOOST_AUTO_TEST_CASE (test_roundtrip_and_reconstruct)
+{
+    INIT_STDOUT_LOGGER();
+
+    vector<TxnHash> tranHashes;
+    for (unsigned int i = 0; i < NUM_TXNS; i++)
+    {
+        tranHashes.push_back(MakeTxnHash(i));
+    }
+
+    MicroBlock microblock = MakeMicroBlock(tranHashes);
+    CompactMicroBlock compact(microblock, 0x0123456789ABCDEFULL);
+
+    vector<unsigned char> fullBytes;
+    microblock.Serialize(fullBytes, 0);
+
+    vector<unsigned char> compactBytes;
+    compact.Serialize(compactBytes, 0);
+    BOOST_CHECK_MESSAGE(compactBytes.size() == compact.GetSerializedSize(), "Serialized size mismatch");
+
+    CompactMicroBlock received(compactBytes, 0);
+    BOOST_CHECK_MESSAGE(received.GetShortIDs() == compact.GetShortIDs(), "Short IDs changed on the wire");
+    BOOST_CHECK_MESSAGE(received.GetHeader() == microblock.GetHeader(), "Header changed on the wire");
+
+    // Backup pool: everything except the first NUM_MISSING txns, plus unrelated txns, in random order
+    vector<TxnHash> pool;
+    for (unsigned int i = NUM_MISSING; i < NUM_TXNS; i++)
+    {
+        pool.push_back(tranHashes.at(i));
+    }
+    for (unsigned int i = 0; i < 1000; i++)
+    {
+        pool.push_back(MakeTxnHash(NUM_TXNS + i));
+    }
+    shuffle(pool.begin(), pool.end(), mt19937(1));
+
+    vector<TxnHash> rebuilt;
+    vector<uint32_t> missing;
+    received.Reconstruct(pool, rebuilt, missing);
+
+    BOOST_CHECK_MESSAGE(missing.size() == NUM_MISSING, "Expected " << NUM_MISSING << " missing, got " << missing.size());
+
+    for (auto index : missing)
+    {
+        BOOST_CHECK_MESSAGE(!received.Fill(index, MakeTxnHash(NUM_TXNS + 5000), rebuilt), "Fill accepted wrong txn");
+        BOOST_CHECK_MESSAGE(received.Fill(index, tranHashes.at(index), rebuilt), "Fill rejected requested txn");
+    }
+
+    BOOST_CHECK_MESSAGE(received.ToMicroBlock(rebuilt) == microblock, "Reconstructed microblock differs");
+
+    // Bytes on the wire for the announcement plus fetching the missing bodies by index
+    unsigned int requestBytes = MessageOffset::BODY + UINT256_SIZE + 3 * sizeof(uint32_t) + 
+                                missing.size() * sizeof(uint32_t);
+    unsigned int responseBytes = MessageOffset::BODY + UINT256_SIZE + sizeof(uint32_t) + 
+                                 missing.size() * (sizeof(uint32_t) + Transaction::GetSerializedSize());
+
+    LOG_MESSAGE("Microblock with " << NUM_TXNS << " txns:");
+    LOG_MESSAGE("  full announcement:    " << fullBytes.size() << " bytes");
+    LOG_MESSAGE("  compact announcement: " << compactBytes.size() << " bytes");
+    LOG_MESSAGE("  fetch of " << NUM_MISSING << " missing: " << requestBytes + responseBytes << " bytes");
+
+    BOOST_CHECK_MESSAGE(compactBytes.size() * 4 < fullBytes.size(), "Compact announcement not smaller");
+}
+
+BOOST_AUTO_TEST_CASE (test_ambiguous_short_ids_are_fetched)
+{
+    INIT_STDOUT_LOGGER();
+
+    // Entries sharing a short ID cannot be placed from the pool and must be fetched by index
+    vector<TxnHash> tranHashes = { MakeTxnHash(1), MakeTxnHash(2), MakeTxnHash(1) };
+    MicroBlock microblock = MakeMicroBlock(tranHashes);
+    CompactMicroBlock compact(microblock, 42);
+
+    vector<TxnHash> rebuilt;
+    vector<uint32_t> missing;
+    compact.Reconstruct(tranHashes, rebuilt, missing);
+
+    BOOST_CHECK_MESSAGE((missing == vector<uint32_t>{ 0, 2 }), "Ambiguous entries not marked missing");
+    BOOST_CHECK_MESSAGE(rebuilt.at(1) == tranHashes.at(1), "Unambiguous entry not resolved");
+
+    BOOST_CHECK_MESSAGE(compact.Fill(0, tranHashes.at(0), rebuilt), "Fill rejected fetched txn");
+    BOOST_CHECK_MESSAGE(compact.Fill(2, tranHashes.at(2), rebuilt), "Fill rejected fetched txn");
+    BOOST_CHECK_MESSAGE(rebuilt == tranHashes, "Reconstruction failed");
+}
+
+BOOST_AUTO_TEST_CASE (test_size_mismatch_rejected)
+{
+    INIT_STDOUT_LOGGER();
+
+    vector<TxnHash> tranHashes = { MakeTxnHash(1), MakeTxnHash(2), MakeTxnHash(3) };
+    CompactMicroBlock compact(MakeMicroBlock(tranHashes), 42);
+
+    vector<unsigned char> bytes;
+    compact.Serialize(bytes, 0);
+    BOOST_CHECK_MESSAGE(CompactMicroBlock::CheckSerializedSize(bytes, 0), "Well-formed block rejected");
+
+    vector<unsigned char> truncated(bytes.begin(), bytes.end() - 1);
+    BOOST_CHECK_MESSAGE(!CompactMicroBlock::CheckSerializedSize(truncated, 0), "Truncated block accepted");
+
+    vector<unsigned char> padded(bytes);
+    padded.resize(bytes.size() + CompactMicroBlock::SHORT_ID_SIZE);
+    BOOST_CHECK_MESSAGE(!CompactMicroBlock::CheckSerializedSize(padded, 0), "Padded block accepted");
+
+    // A header claiming a huge count must not reserve memory for it
+    MicroBlockHeader header = compact.GetHeader();
+    MicroBlockHeader inflated(header.GetType(), header.GetVersion(), header.GetGasLimit(), header.GetGasUsed(),
+                              header.GetPrevHash(), header.GetBlockNum(), header.GetTimestamp(),
+                              header.GetTxRootHash(), 0xFFFFFFFF, header.GetMinerPubKey(),
+                              header.GetDSBlockNum(), header.GetDSBlockHeader());
+    inflated.Serialize(bytes, 0);
+    BOOST_CHECK_MESSAGE(!CompactMicroBlock::CheckSerializedSize(bytes, 0), "Inflated count accepted");
+
+    CompactMicroBlock received(bytes, 0);
+    BOOST_CHECK_MESSAGE(received.GetShortIDs().empty(), "Short IDs read from a malformed block");
+
+    vector<unsigned char> empty;
+    BOOST_CHECK_MESSAGE(!CompactMicroBlock::CheckSerializedSize(empty, 0), "Empty block accepted");
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,184 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <vector>
+
+#include "libData/AccountData/Account.h"
+#include "libData/AccountData/ForwardedTxnSet.h"
+#include "libData/AccountData/TxPool.h"
+#include "libData/AccountData/TxnVerifier.h"
+#include "libData/BlockData/Block/CompactMicroBlock.h"
+#include "libUtils/Logger.h"
+#include "libUtils/TxnRootComputation.h"
+
+#define BOOST_TEST_MODULE forwardedtxnsettest
+#include <boost/test/included/unit_test.hpp>
+
+using namespace std;
+using namespace boost::multiprecision;
+
+namespace
+{
+    const unsigned int NUM_TXNS = 200;
+
+    vector<Transaction> MakeTransactions(unsigned int numTxns, unsigned int firstNonce)
+    {
+        pair<PrivKey, PubKey> sender = Schnorr::GetInstance().GenKeyPair();
+        Address toAddr = Account::GetAddressFromPublicKey(Schnorr::GetInstance().GenKeyPair().second);
+
+        vector<Transaction> txns;
+        for (unsigned int i = 0; i < numTxns; i++)
+        {
+            txns.push_back(TxnVerifier::CreateSigned(0, firstNonce + i, toAddr, sender.first, sender.second, 1));
+        }
+        return txns;
+    }
+
+    TxnHash GetRoot(const vector<Transaction> & txns)
+    {
+        vector<TxnHash> tranHashes;
+        for (const auto & tx : txns)
+        {
+            tranHashes.push_back(tx.GetTranID());
+        }
+        return ComputeTransactionsRoot(tranHashes);
+    }
+
+    vector<uint64_t> GetIDs(const ForwardedTxnSet & set, uint64_t salt, const vector<Transaction> & txns)
+    {
+        vector<uint64_t> ids;
+        for (const auto & tx : txns)
+        {
+            ids.push_back(set.GetID(salt, tx.GetTranID()));
+        }
+        return ids;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE (forwardedtxnsettest)
+
+BOOST_AUTO_TEST_CASE (test_assemble_across_messages)
+{
+    INIT_STDOUT_LOGGER();
+
+    const vector<Transaction> txns = MakeTransactions(NUM_TXNS, 0);
+    ForwardedTxnSet set(GetRoot(txns));
+    const uint64_t salt = 0x0123456789ABCDEFULL;
+    const vector<uint64_t> ids = GetIDs(set, salt, txns);
+
+    // IDs depend on the salt and on the root, so they cannot be ground before an offer is made
+    BOOST_CHECK(set.GetID(salt, txns.at(0).GetTranID()) != set.GetID(salt + 1, txns.at(0).GetTranID()));
+    BOOST_CHECK(set.GetID(salt, txns.at(0).GetTranID()) != 
+                ForwardedTxnSet(txns.at(1).GetTranID()).GetID(salt, txns.at(0).GetTranID()));
+    BOOST_CHECK(set.GetID(salt, txns.at(0).GetTranID()) == 
+                CompactMicroBlock::ComputeKeyedID(salt, GetRoot(txns), txns.at(0).GetTranID()));
+
+    vector<Transaction> assembled;
+    vector<Transaction> firstHalf(txns.begin(), txns.begin() + NUM_TXNS / 2);
+    BOOST_CHECK(set.Add(firstHalf) == NUM_TXNS / 2);
+    BOOST_CHECK(set.Assemble(salt, ids, assembled) == ForwardedTxnSet::INCOMPLETE);
+
+    // The second forwarder uses its own salt
+    const uint64_t salt2 = salt ^ 0xFFFF;
+    BOOST_CHECK(set.GetSketch(salt2, NUM_TXNS).GetNumCells() >= IBLT::GetNumCellsForDifference(NUM_TXNS / 2));
+
+    vector<Transaction> secondHalf(txns.begin() + NUM_TXNS / 2, txns.end());
+    BOOST_CHECK(set.Add(secondHalf) == NUM_TXNS - NUM_TXNS / 2);
+    BOOST_CHECK(set.Add(secondHalf) == 0);
+    BOOST_CHECK(set.Assemble(salt2, GetIDs(set, salt2, txns), assembled) == ForwardedTxnSet::COMPLETE);
+    BOOST_CHECK(assembled == txns);
+}
+
+BOOST_AUTO_TEST_CASE (test_forged_body_not_held)
+{
+    INIT_STDOUT_LOGGER();
+
+    const vector<Transaction> txns = MakeTransactions(4, 0);
+    ForwardedTxnSet set(GetRoot(txns));
+    const uint64_t salt = 42;
+
+    // Same tran ID as the real body, but a signature that does not verify
+    const Transaction & real = txns.at(2);
+    array<unsigned char, TRAN_SIG_SIZE> signature = real.GetSignature();
+    signature.at(5) ^= 1;
+    Transaction forged(real.GetVersion(), real.GetNonce(), real.GetToAddr(), real.GetFromAddr(), real.GetAmount(), 
+                       real.GetSenderPubKey(), signature);
+    BOOST_CHECK(forged.GetTranID() == real.GetTranID());
+
+    // Sent first, the forged body must not keep the real one out
+    BOOST_CHECK(set.Add({ forged }) == 0);
+    BOOST_CHECK(set.Add(txns) == txns.size());
+
+    vector<Transaction> assembled;
+    BOOST_CHECK(set.Assemble(salt, GetIDs(set, salt, txns), assembled) == ForwardedTxnSet::COMPLETE);
+    BOOST_CHECK(assembled.at(2).GetSignature() == real.GetSignature());
+}
+
+BOOST_AUTO_TEST_CASE (test_sketch_from_pool)
+{
+    INIT_STDOUT_LOGGER();
+
+    const vector<Transaction> txns = MakeTransactions(NUM_TXNS, 0);
+    const unsigned int numMissing = 10;
+    const unsigned int numUnrelated = 20;
+
+    // The pool holds most of the microblock, plus pending txns that are not in it
+    TxPool pool(64 * 1024 * 1024);
+    for (unsigned int i = 0; i < NUM_TXNS - numMissing; i++)
+    {
+        BOOST_CHECK(pool.Insert(txns.at(i)));
+    }
+    for (const auto & tx : MakeTransactions(numUnrelated, 0))
+    {
+        BOOST_CHECK(pool.Insert(tx));
+    }
+
+    ForwardedTxnSet set(GetRoot(txns));
+    vector<Transaction> candidates;
+    pool.GetFromShard(0, 0, candidates);
+    BOOST_CHECK(set.AddCandidates(candidates) == NUM_TXNS - numMissing + numUnrelated);
+
+    // The first sketch already leaves out what the pool holds
+    const uint64_t salt = 0x5A5A5A5A12345678ULL;
+    IBLT theirs = set.GetSketch(salt, NUM_TXNS);
+
+    IBLT mine(theirs.GetNumCells());
+    for (const auto & tx : txns)
+    {
+        mine.Insert(set.GetID(salt, tx.GetTranID()));
+    }
+    BOOST_CHECK(mine.Subtract(theirs));
+
+    vector<uint64_t> onlyMine, onlyTheirs;
+    BOOST_CHECK(mine.Decode(onlyMine, onlyTheirs));
+    BOOST_CHECK(onlyMine.size() == numMissing);
+    BOOST_CHECK(onlyTheirs.size() == numUnrelated);
+
+    unsigned int pushBytes = NUM_TXNS * Transaction::GetSerializedSize();
+    unsigned int reconciledBytes = theirs.GetSerializedSize() + numMissing * Transaction::GetSerializedSize();
+    LOG_MESSAGE("Full push " << pushBytes << " bytes, sketch and missing bodies " << reconciledBytes << " bytes");
+    BOOST_CHECK(reconciledBytes < pushBytes / 4);
+
+    // Only the missing bodies arrive; the seeded ones fill in the rest
+    vector<Transaction> missing(txns.end() - numMissing, txns.end());
+    BOOST_CHECK(set.Add(missing) == numMissing);
+
+    vector<Transaction> assembled;
+    BOOST_CHECK(set.Assemble(salt, GetIDs(set, salt, txns), assembled) == ForwardedTxnSet::COMPLETE);
+    BOOST_CHECK(assembled == txns);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,186 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "libData/DataStructures/IBLT.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE iblttest
+#include <boost/test/included/unit_test.hpp>
+
+using namespace std;
+
+BOOST_AUTO_TEST_SUITE (iblttest)
+
+BOOST_AUTO_TEST_CASE (test_decode_difference)
+{
+    INIT_STDOUT_LOGGER();
+
+    mt19937_64 rng(7);
+
+    // Sender holds 10000 keys, receiver holds all but 50 of them plus 5 the sender never had
+    vector<uint64_t> senderKeys;
+    for (unsigned int i = 0; i < 10000; i++)
+    {
+        senderKeys.push_back(rng());
+    }
+
+    vector<uint64_t> extraKeys = { rng(), rng(), rng(), rng(), rng() };
+
+    IBLT receiver(IBLT::GetNumCellsForDifference(55));
+    for (unsigned int i = 50; i < senderKeys.size(); i++)
+    {
+        receiver.Insert(senderKeys.at(i));
+    }
+    for (auto key : extraKeys)
+    {
+        receiver.Insert(key);
+    }
+
+    vector<unsigned char> wire;
+    receiver.Serialize(wire, 0);
+    BOOST_CHECK_MESSAGE(wire.size() == receiver.GetSerializedSize(), "Serialized size mismatch");
+
+    IBLT received(wire, 0);
+    BOOST_CHECK_MESSAGE(received.GetNumCells() == receiver.GetNumCells(), "Cell count changed on the wire");
+
+    IBLT sender(received.GetNumCells());
+    for (auto key : senderKeys)
+    {
+        sender.Insert(key);
+    }
+    BOOST_CHECK_MESSAGE(sender.Subtract(received), "Subtract failed");
+
+    vector<uint64_t> onlySender;
+    vector<uint64_t> onlyReceiver;
+    BOOST_CHECK_MESSAGE(sender.Decode(onlySender, onlyReceiver), "Decode failed");
+
+    sort(onlySender.begin(), onlySender.end());
+    sort(onlyReceiver.begin(), onlyReceiver.end());
+    vector<uint64_t> expectedSender(senderKeys.begin(), senderKeys.begin() + 50);
+    sort(expectedSender.begin(), expectedSender.end());
+    sort(extraKeys.begin(), extraKeys.end());
+
+    BOOST_CHECK_MESSAGE(onlySender == expectedSender, "Wrong keys decoded on sender side");
+    BOOST_CHECK_MESSAGE(onlyReceiver == extraKeys, "Wrong keys decoded on receiver side");
+
+    // Reconciliation traffic versus pushing every 237-byte body
+    const unsigned int txn_size = 237;
+    unsigned int full = senderKeys.size() * txn_size;
+    unsigned int reconciled = wire.size() + senderKeys.size() * sizeof(uint64_t) + 50 * txn_size;
+    LOG_MESSAGE("10000-txn microblock, receiver missing 50: full push " << full << 
+                " bytes, reconciliation " << reconciled << " bytes");
+}
+
+BOOST_AUTO_TEST_CASE (test_decode_failure_is_reported)
+{
+    INIT_STDOUT_LOGGER();
+
+    mt19937_64 rng(11);
+
+    // A table far too small for the difference must report failure so the caller falls back
+    IBLT small(IBLT::GetNumCellsForDifference(2));
+    for (unsigned int i = 0; i < 500; i++)
+    {
+        small.Insert(rng());
+    }
+
+    vector<uint64_t> positive;
+    vector<uint64_t> negative;
+    BOOST_CHECK_MESSAGE(!small.Decode(positive, negative), "Overloaded table claimed to decode");
+
+    IBLT other(small.GetNumCells() + IBLT::NUM_HASHES);
+    BOOST_CHECK_MESSAGE(!small.Subtract(other), "Subtract accepted tables of different sizes");
+}
+
+BOOST_AUTO_TEST_CASE (test_empty_and_truncated)
+{
+    INIT_STDOUT_LOGGER();
+
+    IBLT empty;
+    vector<unsigned char> wire;
+    empty.Serialize(wire, 0);
+    BOOST_CHECK_MESSAGE(IBLT(wire, 0).GetNumCells() == 0, "Empty table did not round-trip");
+
+    IBLT table(IBLT::GetNumCellsForDifference(10));
+    table.Insert(1);
+    wire.clear();
+    table.Serialize(wire, 0);
+    wire.resize(wire.size() - 1);
+    BOOST_CHECK_MESSAGE(IBLT(wire, 0).GetNumCells() == 0, "Truncated table was accepted");
+}
+
+BOOST_AUTO_TEST_CASE (test_cell_cap)
+{
+    INIT_STDOUT_LOGGER();
+
+    BOOST_CHECK(IBLT::GetNumCellsForDifference(0xFFFFFFFF) == IBLT::MAX_NUM_CELLS);
+    BOOST_CHECK(IBLT(0xFFFFFFFF).GetNumCells() == IBLT::MAX_NUM_CELLS);
+
+    // A header advertising more cells than the cap is refused even when the bytes are all there
+    const uint32_t numCells = IBLT::MAX_NUM_CELLS + IBLT::NUM_HASHES;
+    vector<unsigned char> wire(sizeof(uint32_t) + numCells * IBLT::CELL_SIZE, 0);
+    Serializable::SetNumber<uint32_t>(wire, 0, numCells, sizeof(uint32_t));
+    BOOST_CHECK_MESSAGE(IBLT(wire, 0).GetNumCells() == 0, "Table above the cell cap was accepted");
+}
+
+BOOST_AUTO_TEST_CASE (test_crafted_cycle)
+{
+    INIT_STDOUT_LOGGER();
+
+    // Find the three cells of key X in a 12-cell table, and the hash sum that makes a cell holding X pure
+    const uint64_t key = 0x1234;
+    IBLT single(12);
+    single.Insert(key);
+
+    vector<unsigned char> wire;
+    single.Serialize(wire, 0);
+
+    vector<unsigned int> offsets;
+    uint64_t hash = 0;
+    for (unsigned int i = 0; i < single.GetNumCells(); i++)
+    {
+        unsigned int offset = sizeof(uint32_t) + i * IBLT::CELL_SIZE;
+        if (Serializable::GetNumber<uint32_t>(wire, offset, sizeof(uint32_t)) == 1)
+        {
+            offsets.push_back(offset);
+            hash = Serializable::GetNumber<uint64_t>(wire, offset + sizeof(uint32_t) + sizeof(uint64_t), sizeof(uint64_t));
+        }
+    }
+    BOOST_REQUIRE(offsets.size() == IBLT::NUM_HASHES);
+
+    // a = (1, X, h), b = (2, 0, 0), c = (0, 0, 0): peeling X from a makes b and c pure with X again,
+    // and peeling c restores the starting table
+    const uint64_t cells[IBLT::NUM_HASHES][3] = { { 1, key, hash }, { 2, 0, 0 }, { 0, 0, 0 } };
+    for (unsigned int i = 0; i < IBLT::NUM_HASHES; i++)
+    {
+        Serializable::SetNumber<uint32_t>(wire, offsets.at(i), cells[i][0], sizeof(uint32_t));
+        Serializable::SetNumber<uint64_t>(wire, offsets.at(i) + sizeof(uint32_t), cells[i][1], sizeof(uint64_t));
+        Serializable::SetNumber<uint64_t>(wire, offsets.at(i) + sizeof(uint32_t) + sizeof(uint64_t), cells[i][2], sizeof(uint64_t));
+    }
+
+    IBLT crafted(wire, 0);
+    BOOST_REQUIRE(crafted.GetNumCells() == 12);
+
+    vector<uint64_t> positive;
+    vector<uint64_t> negative;
+    BOOST_CHECK_MESSAGE(!crafted.Decode(positive, negative), "Crafted table claimed to decode");
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
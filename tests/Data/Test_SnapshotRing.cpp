@@ -0,0 +1,155 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "libData/DataStructures/SnapshotRing.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE snapshotringtest
+#include <boost/test/included/unit_test.hpp>
+
+using namespace std;
+
+namespace
+{
+    // Stand-in for a block: the payload makes copies expensive, the index checks the slot
+    struct Entry
+    {
+        uint64_t m_index;
+        vector<uint64_t> m_payload;
+
+        Entry() : m_index(-1) {}
+        explicit Entry(uint64_t index) : m_index(index), m_payload(64, index) {}
+    };
+}
+
+BOOST_AUTO_TEST_SUITE (snapshotringtest)
+
+BOOST_AUTO_TEST_CASE (test_publish_and_get)
+{
+    INIT_STDOUT_LOGGER();
+
+    const shared_ptr<const Entry> empty = make_shared<const Entry>();
+    SnapshotRing<Entry> ring(4, empty);
+
+    BOOST_CHECK(ring.size() == 0);
+    BOOST_CHECK(ring.capacity() == 4);
+    BOOST_CHECK(ring.Back() == empty);
+
+    for (uint64_t i = 0; i < 6; i++)
+    {
+        ring.Publish(i, make_shared<const Entry>(i));
+    }
+
+    BOOST_CHECK(ring.size() == 6);
+    BOOST_CHECK(ring.Back()->m_index == 5);
+    BOOST_CHECK(ring.Get(2)->m_index == 2);
+
+    // Index 1 shares its slot with 5 now
+    BOOST_CHECK(ring.Get(1)->m_index == 5);
+
+    // A held element outlives its slot being reused
+    shared_ptr<const Entry> held = ring.Get(3);
+    ring.Publish(7, make_shared<const Entry>(7));
+    BOOST_CHECK(held->m_index == 3);
+    BOOST_CHECK(held->m_payload.at(0) == 3);
+}
+
+BOOST_AUTO_TEST_CASE (test_release_replaced)
+{
+    SnapshotRing<Entry> ring(2, make_shared<const Entry>());
+
+    weak_ptr<const Entry> replaced;
+    {
+        shared_ptr<const Entry> first = make_shared<const Entry>(0);
+        replaced = first;
+        ring.Publish(0, move(first));
+    }
+    BOOST_CHECK(ring.Get(0)->m_index == 0);
+    BOOST_CHECK(!replaced.expired());
+
+    // Nobody holds index 0 once index 2 takes its slot, so the ring must let go of it
+    ring.Publish(1, make_shared<const Entry>(1));
+    ring.Publish(2, make_shared<const Entry>(2));
+    BOOST_CHECK(replaced.expired());
+    BOOST_CHECK(ring.Get(0)->m_index == 2);
+}
+
+BOOST_AUTO_TEST_CASE (test_concurrent_readers)
+{
+    const unsigned int capacity = 50;
+    const uint64_t numEntries = 20000;
+    const unsigned int numReaders = 4;
+
+    SnapshotRing<Entry> ring(capacity, make_shared<const Entry>());
+
+    atomic<bool> done(false);
+    atomic<uint64_t> numReads(0);
+    atomic<uint64_t> numTorn(0);
+
+    vector<thread> readers;
+    for (unsigned int r = 0; r < numReaders; r++)
+    {
+        readers.emplace_back([&]()
+        {
+            uint64_t reads = 0;
+            while (!done)
+            {
+                uint64_t size = ring.size();
+                if (size == 0)
+                {
+                    continue;
+                }
+
+                // Whatever a reader gets must be a whole entry at least as new as the count it read
+                shared_ptr<const Entry> back = ring.Back();
+                shared_ptr<const Entry> recent = ring.Get(size - 1 - reads % min<uint64_t>(size, capacity));
+                if ((back->m_index + 1 < size) || (back->m_payload.back() != back->m_index) ||
+                    (recent->m_payload.front() != recent->m_index))
+                {
+                    numTorn++;
+                }
+                reads++;
+            }
+            numReads += reads;
+        });
+    }
+
+    auto start = chrono::steady_clock::now();
+    for (uint64_t i = 0; i < numEntries; i++)
+    {
+        ring.Publish(i, make_shared<const Entry>(i));
+    }
+    auto publish_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+    done = true;
+    for (auto & reader : readers)
+    {
+        reader.join();
+    }
+
+    BOOST_CHECK(numTorn == 0);
+    BOOST_CHECK(ring.Back()->m_index == numEntries - 1);
+
+    LOG_MESSAGE("Published " << numEntries << " entries in " << publish_us << " us alongside " << numReaders <<
+                " readers doing " << numReads << " reads");
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
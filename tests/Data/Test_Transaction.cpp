@@ -58,7 +58,14 @@ BOOST_AUTO_TEST_CASE (test1)
     // Predicate pred(3, fromAddr, 2, 1, toAddr, fromAddr, 33, 1);
     // Transaction tx1(1, 5, toAddr, fromAddr, 55, signature, pred);
 
-    Transaction tx1(1, 5, toAddr, fromAddr, 55, signature);
+    std::array<unsigned char, PUB_KEY_SIZE> pubKey;
+
+    for (unsigned int i = 0; i < pubKey.size(); i++)
+    {
+        pubKey.at(i) = i + 12;
+    }
+
+    Transaction tx1(1, 5, toAddr, fromAddr, 55, pubKey, signature);
     std::vector<unsigned char> message1;
     tx1.Serialize(message1, 0);
 
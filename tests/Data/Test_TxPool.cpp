@@ -0,0 +1,343 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "libData/AccountData/TxPool.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE txpooltest
+#include <boost/test/included/unit_test.hpp>
+
+using namespace std;
+using namespace boost::multiprecision;
+
+namespace
+{
+    Address MakeAddress(uint64_t id)
+    {
+        Address addr;
+        for (unsigned int i = 0; i < sizeof(uint64_t); i++)
+        {
+            addr.asArray().at(i) = static_cast<unsigned char>(id >> (8 * i));
+        }
+        return addr;
+    }
+
+    Transaction MakeTransaction(uint64_t sender, uint64_t nonce, uint32_t version = 0)
+    {
+        array<unsigned char, PUB_KEY_SIZE> pubKey = {0};
+        array<unsigned char, TRAN_SIG_SIZE> signature;
+        fill(signature.begin(), signature.end(), 0x0F);
+        return Transaction(version, nonce, MakeAddress(sender + 1), MakeAddress(sender), 1, pubKey, signature);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE (txpooltest)
+
+BOOST_AUTO_TEST_CASE (test_dedup_and_nonce_order)
+{
+    INIT_STDOUT_LOGGER();
+
+    TxPool pool(1024 * 1024);
+
+    // Sender 1 arrives out of order with a gap at nonce 4
+    vector<Transaction> txs = { MakeTransaction(1, 3), MakeTransaction(1, 1), MakeTransaction(1, 2),
+                                MakeTransaction(1, 5), MakeTransaction(2, 7) };
+    for (const auto & tx : txs)
+    {
+        BOOST_CHECK(pool.Insert(tx));
+    }
+
+    BOOST_CHECK_MESSAGE(!pool.Insert(txs.at(0)), "Duplicate ID accepted");
+    BOOST_CHECK_MESSAGE(!pool.Insert(MakeTransaction(1, 2, 1)), "Second txn for a queued nonce accepted");
+    BOOST_CHECK(pool.GetSize() == txs.size());
+    BOOST_CHECK(pool.GetNumBytes() == txs.size() * TxPool::RECORD_SIZE + 2 * TxPool::SENDER_SIZE);
+
+    vector<TxnHash> selected;
+    pool.SelectExecutable(100, selected);
+
+    // Sender 1 runs 1, 2, 3 and stops at the gap; sender 2 starts at its lowest nonce
+    vector<TxnHash> expected = { txs.at(1).GetTranID(), txs.at(2).GetTranID(), txs.at(0).GetTranID(),
+                                 txs.at(4).GetTranID() };
+    BOOST_CHECK(selected == expected);
+
+    selected.clear();
+    pool.SelectExecutable(2, selected);
+    BOOST_CHECK(selected.size() == 2);
+}
+
+BOOST_AUTO_TEST_CASE (test_commit_advances_nonce)
+{
+    TxPool pool(1024 * 1024);
+
+    Transaction tx1 = MakeTransaction(1, 1);
+    Transaction tx2 = MakeTransaction(1, 2);
+    Transaction tx2Other = MakeTransaction(1, 2, 9);
+    BOOST_CHECK(pool.Insert(tx1));
+    BOOST_CHECK(pool.Insert(tx2));
+
+    Transaction committed;
+    BOOST_CHECK(pool.Commit(tx1.GetTranID(), committed));
+    BOOST_CHECK(committed == tx1);
+    BOOST_CHECK(!pool.Contains(tx1.GetTranID()));
+
+    // Nonce 1 is now below the sender's next nonce
+    BOOST_CHECK_MESSAGE(!pool.Insert(MakeTransaction(1, 1, 3)), "Stale nonce accepted");
+
+    vector<TxnHash> selected;
+    pool.SelectExecutable(10, selected);
+    BOOST_CHECK(selected == vector<TxnHash>({ tx2.GetTranID() }));
+
+    // A competing txn for nonce 2 was committed elsewhere: the queued one is dropped with it
+    BOOST_CHECK(pool.Insert(MakeTransaction(1, 3)));
+    pool.Remove(tx2.GetTranID());
+    BOOST_CHECK(pool.Insert(tx2Other));
+    BOOST_CHECK(pool.Commit(tx2Other.GetTranID(), committed));
+    BOOST_CHECK(pool.GetSize() == 1);
+
+    Transaction fetched;
+    BOOST_CHECK(pool.Get(MakeTransaction(1, 3).GetTranID(), fetched));
+    BOOST_CHECK(fetched.GetNonce() == 3);
+}
+
+BOOST_AUTO_TEST_CASE (test_commit_external)
+{
+    TxPool pool(1024 * 1024);
+
+    // The pool refuses a second body for nonce 1, which then gets committed from elsewhere
+    Transaction queued = MakeTransaction(1, 1);
+    Transaction external = MakeTransaction(1, 1, 9);
+    Transaction next = MakeTransaction(1, 2);
+    BOOST_CHECK(pool.Insert(queued));
+    BOOST_CHECK(pool.Insert(next));
+    BOOST_CHECK(!pool.Insert(external));
+
+    pool.CommitExternal(external);
+    BOOST_CHECK(!pool.Contains(queued.GetTranID()));
+    BOOST_CHECK_MESSAGE(!pool.Insert(MakeTransaction(1, 1, 3)), "Stale nonce accepted");
+
+    vector<TxnHash> selected;
+    pool.SelectExecutable(10, selected);
+    BOOST_CHECK(selected == vector<TxnHash>({ next.GetTranID() }));
+
+    // A sender with nothing pending is left alone
+    pool.CommitExternal(MakeTransaction(2, 5));
+    BOOST_CHECK(pool.GetSize() == 1);
+    BOOST_CHECK_MESSAGE(!pool.Insert(MakeTransaction(2, 5)), "Externally committed txn pooled");
+}
+
+BOOST_AUTO_TEST_CASE (test_committed_not_repooled)
+{
+    TxPool pool(1024 * 1024);
+
+    // Once a sender's queue drains, its committed txns must still be refused
+    Transaction tx1 = MakeTransaction(1, 1);
+    BOOST_CHECK(pool.Insert(tx1));
+
+    Transaction committed;
+    BOOST_CHECK(pool.Commit(tx1.GetTranID(), committed));
+    BOOST_CHECK(pool.GetSize() == 0);
+    BOOST_CHECK(pool.GetNumBytes() == 0);
+
+    BOOST_CHECK_MESSAGE(!pool.Insert(tx1), "Committed txn pooled again");
+    BOOST_CHECK_MESSAGE(!pool.Insert(MakeTransaction(1, 0)), "Stale nonce accepted");
+
+    // The next nonce is executable right away, a later one waits for the gap
+    Transaction tx2 = MakeTransaction(1, 2);
+    Transaction tx4 = MakeTransaction(1, 4);
+    BOOST_CHECK(pool.Insert(tx4));
+    BOOST_CHECK(pool.Insert(tx2));
+
+    vector<TxnHash> selected;
+    pool.SelectExecutable(10, selected);
+    BOOST_CHECK(selected == vector<TxnHash>({ tx2.GetTranID() }));
+}
+
+BOOST_AUTO_TEST_CASE (test_get_from_shard)
+{
+    TxPool pool(1024 * 1024);
+
+    for (unsigned int sender = 1; sender <= 8; sender++)
+    {
+        BOOST_CHECK(pool.Insert(MakeTransaction(sender, 1)));
+        BOOST_CHECK(pool.Insert(MakeTransaction(sender, 2)));
+    }
+
+    vector<Transaction> all;
+    pool.GetFromShard(0, 0, all);
+    BOOST_CHECK(all.size() == 16);
+
+    size_t total = 0;
+    for (unsigned int shard = 0; shard < 4; shard++)
+    {
+        vector<Transaction> txns;
+        pool.GetFromShard(4, shard, txns);
+        for (const auto & tx : txns)
+        {
+            BOOST_CHECK(Transaction::GetShardIndex(tx.GetFromAddr(), 4) == shard);
+        }
+        total += txns.size();
+    }
+    BOOST_CHECK(total == 16);
+}
+
+BOOST_AUTO_TEST_CASE (test_eviction)
+{
+    const unsigned int capacity = 100;
+    const uint64_t budget = capacity * TxPool::RECORD_SIZE + 3 * TxPool::SENDER_SIZE;
+    TxPool pool(budget);
+
+    // Sender 1 takes 80 slots, sender 2 takes 20
+    for (unsigned int i = 0; i < 80; i++)
+    {
+        BOOST_CHECK(pool.Insert(MakeTransaction(1, i)));
+    }
+    for (unsigned int i = 0; i < 20; i++)
+    {
+        BOOST_CHECK(pool.Insert(MakeTransaction(2, i)));
+    }
+    BOOST_CHECK(pool.GetNumEvicted() == 0);
+
+    // A new sender pushes out the back of the longest queue
+    BOOST_CHECK(pool.Insert(MakeTransaction(3, 0)));
+    BOOST_CHECK(pool.GetNumEvicted() == 1);
+    BOOST_CHECK(!pool.Contains(MakeTransaction(1, 79).GetTranID()));
+    BOOST_CHECK(pool.GetSize() == capacity);
+
+    // The longest sender's own newest txn is the one evicted
+    BOOST_CHECK(!pool.Insert(MakeTransaction(1, 200)));
+    BOOST_CHECK(pool.GetNumBytes() <= budget);
+}
+
+BOOST_AUTO_TEST_CASE (test_pinned_not_evicted)
+{
+    const unsigned int capacity = 10;
+    TxPool pool(capacity * TxPool::RECORD_SIZE + 3 * TxPool::SENDER_SIZE);
+
+    for (unsigned int i = 0; i < capacity; i++)
+    {
+        BOOST_CHECK(pool.Insert(MakeTransaction(1, i)));
+    }
+
+    // The whole queue is proposed for the microblock, so only newcomers can make room
+    vector<TxnHash> proposed;
+    pool.SelectExecutable(capacity, proposed);
+    BOOST_CHECK(pool.Pin(proposed));
+
+    BOOST_CHECK(!pool.Insert(MakeTransaction(2, 0)));
+    for (const auto & tranID : proposed)
+    {
+        BOOST_CHECK(pool.Contains(tranID));
+    }
+
+    // Once committed or unpinned they are fair game again
+    Transaction tx;
+    BOOST_CHECK(pool.Commit(proposed.at(0), tx));
+    BOOST_CHECK(pool.Insert(MakeTransaction(2, 0)));
+    BOOST_CHECK(!pool.Insert(MakeTransaction(3, 0)));
+
+    pool.Unpin();
+    BOOST_CHECK(pool.Insert(MakeTransaction(3, 0)));
+    BOOST_CHECK(!pool.Contains(proposed.back()));
+    BOOST_CHECK(pool.GetSize() == capacity);
+
+    BOOST_CHECK(!pool.Pin({ proposed.back() }));
+}
+
+BOOST_AUTO_TEST_CASE (test_throughput_1m_pending)
+{
+    Logger::SetLogLevel(LOG_LEVEL_INFO);
+
+    const unsigned int numSenders = 10000;
+    const unsigned int txnsPerSender = 100;
+    const unsigned int batchSize = 65536;
+    const unsigned int total = numSenders * txnsPerSender;
+
+    TxPool pool((uint64_t) total * TxPool::RECORD_SIZE + (uint64_t) numSenders * TxPool::SENDER_SIZE);
+
+    // Nonces arrive shuffled within each sender, senders interleaved
+    mt19937_64 rng(21);
+    vector<pair<uint32_t, uint32_t>> order;
+    order.reserve(total);
+    for (unsigned int n = 0; n < txnsPerSender; n++)
+    {
+        for (unsigned int s = 0; s < numSenders; s++)
+        {
+            order.push_back(make_pair(s, n));
+        }
+    }
+    shuffle(order.begin(), order.end(), rng);
+
+    int64_t insert_ns = 0;
+    vector<Transaction> batch;
+    batch.reserve(batchSize);
+    for (unsigned int i = 0; i < total; i += batchSize)
+    {
+        batch.clear();
+        for (unsigned int j = i; j < min(total, i + batchSize); j++)
+        {
+            batch.push_back(MakeTransaction(order.at(j).first, order.at(j).second));
+        }
+
+        auto start = chrono::steady_clock::now();
+        for (const auto & tx : batch)
+        {
+            pool.Insert(tx);
+        }
+        insert_ns += chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+    }
+
+    BOOST_CHECK(pool.GetSize() == total);
+    BOOST_CHECK(pool.GetNumEvicted() == 0);
+
+    const unsigned int k = 10000;
+    const unsigned int rounds = 100;
+    vector<TxnHash> selected;
+    selected.reserve(k);
+
+    auto start = chrono::steady_clock::now();
+    for (unsigned int r = 0; r < rounds; r++)
+    {
+        selected.clear();
+        pool.SelectExecutable(k, selected);
+    }
+    auto select_ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+
+    BOOST_CHECK(selected.size() == k);
+
+    // Commit the selection as a final block would
+    Transaction tx;
+    start = chrono::steady_clock::now();
+    for (const auto & tranID : selected)
+    {
+        pool.Commit(tranID, tx);
+    }
+    auto commit_ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+
+    BOOST_CHECK(pool.GetSize() == total - k);
+
+    LOG_MESSAGE("TxPool with " << total << " pending: insert " << insert_ns / total << " ns/txn, select " <<
+                k << " in " << select_ns / rounds / 1000 << " us, commit " << commit_ns / k << " ns/txn, " <<
+                pool.GetNumBytes() / (1024 * 1024) << " MB charged");
+
+    Logger::SetLogLevel(LOG_LEVEL_DEBUG);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
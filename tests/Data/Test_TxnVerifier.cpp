@@ -0,0 +1,161 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <chrono>
+#include <vector>
+
+#include "libData/AccountData/Account.h"
+#include "libData/AccountData/TxnVerifier.h"
+#include "libData/AccountData/TxnVerifyCache.h"
+#include "libUtils/Executor.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE txnverifiertest
+#include <boost/test/included/unit_test.hpp>
+
+using namespace std;
+using namespace boost::multiprecision;
+
+BOOST_AUTO_TEST_SUITE (txnverifiertest)
+
+BOOST_AUTO_TEST_CASE (test_checks)
+{
+    INIT_STDOUT_LOGGER();
+
+    pair<PrivKey, PubKey> sender = Schnorr::GetInstance().GenKeyPair();
+    pair<PrivKey, PubKey> other = Schnorr::GetInstance().GenKeyPair();
+    Address toAddr = Account::GetAddressFromPublicKey(other.second);
+
+    Transaction tx = TxnVerifier::CreateSigned(0, 1, toAddr, sender.first, sender.second, 100);
+    BOOST_CHECK(tx.GetFromAddr() == Account::GetAddressFromPublicKey(sender.second));
+    BOOST_CHECK(TxnVerifier::Check(tx, 0, 0) == TxnVerifier::VALID);
+
+    // A serialized round trip keeps the transaction valid
+    vector<unsigned char> wire;
+    tx.Serialize(wire, 0);
+    BOOST_CHECK(TxnVerifier::Check(Transaction(wire, 0), 0, 0) == TxnVerifier::VALID);
+
+    // Amount changed after signing: the ID no longer matches
+    vector<unsigned char> tampered = wire;
+    tampered.at(Transaction::Layout::Offset(5) + UINT256_SIZE - 1) ^= 1;
+    BOOST_CHECK(TxnVerifier::Check(Transaction(tampered, 0), 0, 0) == TxnVerifier::BAD_TRAN_ID);
+
+    // Same fields signed by a key that does not own the from address
+    Transaction forged(tx.GetVersion(), tx.GetNonce(), tx.GetToAddr(), tx.GetFromAddr(), tx.GetAmount(), 
+                       other.second.GetCompressed(), tx.GetSignature());
+    BOOST_CHECK(TxnVerifier::Check(forged, 0, 0) == TxnVerifier::BAD_SENDER_KEY);
+
+    // Signature bit flipped
+    tampered = wire;
+    tampered.at(Transaction::Layout::Offset(7) + 5) ^= 1;
+    BOOST_CHECK(TxnVerifier::Check(Transaction(tampered, 0), 0, 0) == TxnVerifier::BAD_SIGNATURE);
+
+    // Exactly one of two shards takes the sender
+    unsigned int shard = Transaction::GetShardIndex(tx.GetFromAddr(), 2);
+    BOOST_CHECK(TxnVerifier::Check(tx, 2, shard) == TxnVerifier::VALID);
+    BOOST_CHECK(TxnVerifier::Check(tx, 2, 1 - shard) == TxnVerifier::WRONG_SHARD);
+}
+
+BOOST_AUTO_TEST_CASE (test_create_signed_batch)
+{
+    const unsigned int numTxns = 300;
+
+    pair<PrivKey, PubKey> sender = Schnorr::GetInstance().GenKeyPair();
+    Address toAddr = Account::GetAddressFromPublicKey(Schnorr::GetInstance().GenKeyPair().second);
+
+    vector<Transaction> txns;
+    BOOST_REQUIRE(TxnVerifier::CreateSignedBatch(0, 5, toAddr, sender.first, sender.second, 100, numTxns, txns));
+    BOOST_REQUIRE(txns.size() == numTxns);
+
+    vector<TxnVerifier::Result> results;
+    TxnVerifier::CheckBatch(txns, 0, 0, results);
+    for (unsigned int i = 0; i < numTxns; i++)
+    {
+        BOOST_CHECK(results.at(i) == TxnVerifier::VALID);
+        BOOST_CHECK(txns.at(i).GetNonce() == 5 + i);
+        BOOST_CHECK(txns.at(i).GetAmount() == 100 + i);
+    }
+}
+
+BOOST_AUTO_TEST_CASE (test_batch_throughput)
+{
+    Logger::SetLogLevel(LOG_LEVEL_INFO);
+
+    const unsigned int numTxns = 4096;
+
+    pair<PrivKey, PubKey> sender = Schnorr::GetInstance().GenKeyPair();
+    Address toAddr = Account::GetAddressFromPublicKey(Schnorr::GetInstance().GenKeyPair().second);
+
+    vector<Transaction> txns;
+    txns.reserve(numTxns);
+    for (unsigned int i = 0; i < numTxns; i++)
+    {
+        txns.push_back(TxnVerifier::CreateSigned(0, i, toAddr, sender.first, sender.second, 1));
+    }
+
+    // Every 100th transaction is corrupted and must be singled out in its batch
+    vector<unsigned char> wire;
+    for (unsigned int i = 0; i < numTxns; i += 100)
+    {
+        wire.clear();
+        txns.at(i).Serialize(wire, 0);
+        wire.at(Transaction::Layout::Offset(7)) ^= 1;
+        txns.at(i) = Transaction(wire, 0);
+    }
+
+    TxnVerifyCache & cache = TxnVerifyCache::GetInstance();
+    cache.Clear();
+
+    auto start = chrono::steady_clock::now();
+    vector<TxnVerifier::Result> serial;
+    for (const auto & tx : txns)
+    {
+        serial.push_back(TxnVerifier::Check(tx, 0, 0));
+    }
+    auto serial_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+    cache.Clear();
+
+    start = chrono::steady_clock::now();
+    vector<TxnVerifier::Result> batched;
+    TxnVerifier::CheckBatch(txns, 0, 0, batched);
+    auto batched_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+    // The same transactions again, as when a microblock or forwarded bodies repeat them
+    uint64_t hits = cache.GetNumHits();
+    start = chrono::steady_clock::now();
+    vector<TxnVerifier::Result> repeated;
+    TxnVerifier::CheckBatch(txns, 0, 0, repeated);
+    auto repeated_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+    BOOST_CHECK(repeated == batched);
+    BOOST_CHECK(cache.GetNumHits() - hits == numTxns - (numTxns + 99) / 100);
+
+    BOOST_CHECK(batched == serial);
+    for (unsigned int i = 0; i < numTxns; i++)
+    {
+        BOOST_CHECK((batched.at(i) == TxnVerifier::VALID) == (i % 100 != 0));
+    }
+
+    LOG_MESSAGE("Verified " << numTxns << " txns: serial " << (uint64_t) numTxns * 1000000 / serial_us << 
+                " txns/s, batched on " << Executor::GetInstance().GetNumWorkers() << " workers " << 
+                (uint64_t) numTxns * 1000000 / batched_us << " txns/s, repeated from cache " << 
+                (uint64_t) numTxns * 1000000 / max<int64_t>(repeated_us, 1) << " txns/s");
+
+    Logger::SetLogLevel(LOG_LEVEL_DEBUG);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,151 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <atomic>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "libData/AccountData/TxnVerifyCache.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE txnverifycachetest
+#include <boost/test/included/unit_test.hpp>
+
+using namespace std;
+
+namespace
+{
+    TxnVerifyCache::Key RandomKey(mt19937_64 & rng)
+    {
+        TxnVerifyCache::Key key;
+        for (auto & b : key.m_tranID.asArray()) { b = rng(); }
+        for (auto & b : key.m_sigHash.asArray()) { b = rng(); }
+        return key;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE (txnverifycachetest)
+
+BOOST_AUTO_TEST_CASE (test_key)
+{
+    INIT_STDOUT_LOGGER();
+
+    array<unsigned char, PUB_KEY_SIZE> pubKey = {0};
+    array<unsigned char, TRAN_SIG_SIZE> signature = {0};
+    Transaction tx(0, 1, Address(), Address(), 5, pubKey, signature);
+
+    // Same transaction, another signature: same tran ID, different key
+    signature.at(0) = 1;
+    Transaction resigned(0, 1, Address(), Address(), 5, pubKey, signature);
+
+    BOOST_CHECK(tx.GetTranID() == resigned.GetTranID());
+    BOOST_CHECK(TxnVerifyCache::MakeKey(tx) == TxnVerifyCache::MakeKey(tx));
+    BOOST_CHECK(!(TxnVerifyCache::MakeKey(tx) == TxnVerifyCache::MakeKey(resigned)));
+}
+
+BOOST_AUTO_TEST_CASE (test_generations)
+{
+    TxnVerifyCache cache(1024);
+    mt19937_64 rng(3);
+
+    TxnVerifyCache::Key first = RandomKey(rng);
+    cache.Insert(first);
+    BOOST_CHECK(cache.Contains(first));
+    BOOST_CHECK(!cache.Contains(RandomKey(rng)));
+    BOOST_CHECK(cache.GetNumHits() == 1);
+    BOOST_CHECK(cache.GetNumMisses() == 1);
+
+    // Kept for one more epoch, then dropped
+    cache.Rotate();
+    BOOST_CHECK(cache.Contains(first));
+    cache.Rotate();
+    BOOST_CHECK(!cache.Contains(first));
+    BOOST_CHECK(cache.GetSize() == 0);
+}
+
+BOOST_AUTO_TEST_CASE (test_bounded)
+{
+    const unsigned int capacity = 1024;
+    TxnVerifyCache cache(capacity);
+    mt19937_64 rng(4);
+
+    vector<TxnVerifyCache::Key> keys;
+    for (unsigned int i = 0; i < 10 * capacity; i++)
+    {
+        keys.push_back(RandomKey(rng));
+        cache.Insert(keys.back());
+        BOOST_REQUIRE(cache.GetSize() <= capacity);
+    }
+
+    BOOST_CHECK(cache.GetNumEarlyRotations() > 0);
+
+    // The newest entries survive, the oldest are gone
+    BOOST_CHECK(cache.Contains(keys.back()));
+    BOOST_CHECK(!cache.Contains(keys.front()));
+}
+
+BOOST_AUTO_TEST_CASE (test_concurrent)
+{
+    const unsigned int numThreads = 8;
+    const unsigned int keysPerThread = 20000;
+    TxnVerifyCache cache(numThreads * keysPerThread * 2);
+
+    vector<vector<TxnVerifyCache::Key>> keys(numThreads);
+    mt19937_64 rng(5);
+    for (auto & v : keys)
+    {
+        for (unsigned int i = 0; i < keysPerThread; i++)
+        {
+            v.push_back(RandomKey(rng));
+        }
+    }
+
+    // Each thread inserts its own keys and looks up its neighbour's
+    atomic<unsigned int> found(0);
+    vector<thread> threads;
+    for (unsigned int t = 0; t < numThreads; t++)
+    {
+        threads.emplace_back([&, t]()
+        {
+            for (unsigned int i = 0; i < keysPerThread; i++)
+            {
+                cache.Insert(keys.at(t).at(i));
+                if (cache.Contains(keys.at((t + 1) % numThreads).at(i)))
+                {
+                    found++;
+                }
+            }
+        });
+    }
+    for (auto & th : threads)
+    {
+        th.join();
+    }
+
+    BOOST_CHECK(cache.GetNumHits() == found);
+    BOOST_CHECK(cache.GetNumHits() + cache.GetNumMisses() == numThreads * keysPerThread);
+
+    for (const auto & v : keys)
+    {
+        for (const auto & key : v)
+        {
+            BOOST_REQUIRE(cache.Contains(key));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,164 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <algorithm>
+#include <queue>
+#include <vector>
+
+#include "libNetwork/BroadcastTree.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE broadcasttreetest
+#include <boost/test/included/unit_test.hpp>
+
+using namespace std;
+
+namespace
+{
+    // Delivers a message from originator the way Node does: to the root and to its own children,
+    // after which every receiver forwards a first copy to its children. Returns the hop count per member.
+    vector<int> Disseminate(const BroadcastTree & tree, unsigned int size, unsigned int originator,
+                            vector<unsigned int> & egress)
+    {
+        vector<int> hops(size, -1);
+        egress.assign(size, 0);
+
+        queue<unsigned int> pending;
+        hops.at(originator) = 0;
+
+        vector<unsigned int> first = tree.GetChildren(originator);
+        if (tree.GetRoot() != originator)
+        {
+            first.push_back(tree.GetRoot());
+        }
+
+        egress.at(originator) = first.size();
+        for (unsigned int member : first)
+        {
+            hops.at(member) = 1;
+            pending.push(member);
+        }
+
+        while (!pending.empty())
+        {
+            unsigned int member = pending.front();
+            pending.pop();
+
+            for (unsigned int child : tree.GetChildren(member))
+            {
+                egress.at(member)++;
+                if (hops.at(child) < 0)
+                {
+                    hops.at(child) = hops.at(member) + 1;
+                    pending.push(child);
+                }
+            }
+        }
+
+        return hops;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE (broadcasttreetest)
+
+BOOST_AUTO_TEST_CASE (test_structure)
+{
+    INIT_STDOUT_LOGGER();
+
+    for (unsigned int size : { 1u, 2u, 9u, 73u, 600u })
+    {
+        for (unsigned int fanout : { 1u, 2u, 8u })
+        {
+            BroadcastTree tree(size, fanout, size / 3);
+
+            // Every member other than the root has exactly one parent
+            vector<unsigned int> parents(size, 0);
+            for (unsigned int member = 0; member < size; member++)
+            {
+                vector<unsigned int> children = tree.GetChildren(member);
+                BOOST_CHECK_MESSAGE(children.size() <= fanout, "Too many children");
+                for (unsigned int child : children)
+                {
+                    parents.at(child)++;
+                    BOOST_CHECK_MESSAGE(tree.GetParent(child) == member, "GetParent mismatch");
+                }
+            }
+
+            for (unsigned int member = 0; member < size; member++)
+            {
+                BOOST_CHECK_MESSAGE(parents.at(member) == ((member == tree.GetRoot()) ? 0u : 1u),
+                                    "Member " << member << " of " << size << " has " << parents.at(member) << " parents");
+            }
+
+            // A member is in the subtree of exactly the members on its path to the root
+            for (unsigned int member = 0; member < size; member++)
+            {
+                vector<bool> ancestors(size, false);
+                for (unsigned int m = member; ; m = tree.GetParent(m))
+                {
+                    ancestors.at(m) = true;
+                    if (m == tree.GetRoot())
+                    {
+                        break;
+                    }
+                }
+
+                for (unsigned int other = 0; other < size; other++)
+                {
+                    BOOST_CHECK_MESSAGE(tree.IsInSubtree(other, member) == ancestors.at(other),
+                                        "IsInSubtree(" << other << ", " << member << ") mismatch for size " << size << " fanout " << fanout);
+                }
+            }
+
+            vector<unsigned int> egress;
+            vector<int> hops = Disseminate(tree, size, tree.GetRoot(), egress);
+            BOOST_CHECK_MESSAGE((unsigned int)*max_element(hops.begin(), hops.end()) == tree.GetDepth(),
+                                "Depth mismatch for size " << size << " fanout " << fanout);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE (test_shard_broadcast)
+{
+    INIT_STDOUT_LOGGER();
+
+    const unsigned int size = 600;
+    const unsigned int fanout = 8;
+    BroadcastTree tree(size, fanout, 17);
+
+    unsigned int max_egress = 0;
+    int max_hops = 0;
+
+    for (unsigned int originator = 0; originator < size; originator++)
+    {
+        vector<unsigned int> egress;
+        vector<int> hops = Disseminate(tree, size, originator, egress);
+
+        BOOST_CHECK_MESSAGE(find(hops.begin(), hops.end(), -1) == hops.end(), 
+                            "Broadcast from " << originator << " missed a member");
+
+        max_egress = max(max_egress, *max_element(egress.begin(), egress.end()));
+        max_hops = max(max_hops, *max_element(hops.begin(), hops.end()));
+    }
+
+    BOOST_CHECK(max_egress <= fanout + 1);
+    BOOST_CHECK((unsigned int)max_hops <= tree.GetDepth() + 1);
+
+    LOG_MESSAGE("Shard of " << size << ": largest per-node egress " << max_egress << " messages (was " << 
+                size - 1 << "), at most " << max_hops << " hops (was 1)");
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -24,10 +24,10 @@
 
 using namespace std;
 
-void process_message(const vector<unsigned char> & message, const Peer & from)
+void process_message(const SharedBuffer & message, const Peer & from)
 {
     LOG_MARKER();
-    LOG_MESSAGE("Received message '" << (char*) &message.at(0) << "' at port " << from.m_listenPortHost << " from address " << from.m_ipAddress);
+    LOG_MESSAGE("Received message '" << (const char*) message.data() << "' at port " << from.m_listenPortHost << " from address " << from.m_ipAddress);
 }
 
 int main()
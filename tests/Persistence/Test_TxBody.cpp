@@ -49,8 +49,9 @@ BOOST_AUTO_TEST_CASE (testReadWriteSimpleStringToDB)
 Transaction constructDummyTxBody(int instanceNum) 
 {
     Address addr;
+    array<unsigned char, PUB_KEY_SIZE> pubKey = {0};
     array<unsigned char, BLOCK_SIG_SIZE> sign;
-    return Transaction(0, instanceNum, addr, addr, 0, sign);
+    return Transaction(0, instanceNum, addr, addr, 0, pubKey, sign);
 }
 
 BOOST_AUTO_TEST_CASE (testSerializationDeserialization)
@@ -0,0 +1,153 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <vector>
+
+#include "libSimulation/EpochSimulator.h"
+#include "libSimulation/SimNetwork.h"
+#include "libUtils/Logger.h"
+
+#define BOOST_TEST_MODULE simnetworktest
+#include <boost/test/included/unit_test.hpp>
+
+using namespace std;
+
+namespace
+{
+    const uint64_t MS = 1000000;
+
+    // 8 Mbps: one byte per microsecond
+    SimNetwork::LinkConfig MakeLink(double lossRate = 0)
+    {
+        return { 10 * MS, 0, 8000000, lossRate, 200 * MS };
+    }
+
+    EpochSimulator::Config MakeConfig(unsigned int aggregationFanout)
+    {
+        EpochSimulator::Config config;
+        config.m_numDSNodes = 10;
+        config.m_numShards = 2;
+        config.m_shardSize = 50;
+        config.m_treeFanout = 8;
+        config.m_aggregationFanout = aggregationFanout;
+        config.m_numFinalBlocks = 2;
+        config.m_txnsPerMicroBlock = 100;
+        config.m_pow1WindowNs = 1000 * MS;
+        config.m_pow2WindowNs = 1000 * MS;
+        config.m_meanPoWNs = 100 * MS;
+        config.m_costs = { 100000, 200000, 1000, 1000000, 1000 };
+        config.m_link = { 20 * MS, 5 * MS, 100000000, 0.01, 200 * MS };
+        config.m_seed = 7;
+        return config;
+    }
+}
+
+BOOST_AUTO_TEST_SUITE (simnetworktest)
+
+BOOST_AUTO_TEST_CASE (test_link_timing)
+{
+    INIT_STDOUT_LOGGER();
+
+    SimNetwork net(3, MakeLink(), 1);
+    vector<uint64_t> delivered;
+
+    // Two messages from node 0 queue on its egress link: 1000 us and 500 us of transmission
+    net.Send(0, 1, 1000, 0, [&]() { delivered.push_back(net.Now()); });
+    net.Send(0, 2, 500, 0, [&]() { delivered.push_back(net.Now()); });
+    net.Run();
+
+    BOOST_REQUIRE(delivered.size() == 2);
+    BOOST_CHECK(delivered.at(0) == 10 * MS + 1000000);
+    BOOST_CHECK(delivered.at(1) == 10 * MS + 1500000);
+
+    // Two senders into one receiver share its ingress link
+    SimNetwork fanIn(3, MakeLink(), 1);
+    delivered.clear();
+    fanIn.Send(0, 2, 1000, 0, [&]() { delivered.push_back(fanIn.Now()); });
+    fanIn.Send(1, 2, 1000, 1, [&]() { delivered.push_back(fanIn.Now()); });
+    fanIn.Run();
+
+    BOOST_REQUIRE(delivered.size() == 2);
+    BOOST_CHECK(delivered.at(1) == 10 * MS + 2000000);
+    BOOST_CHECK(fanIn.GetTraffic(0).m_numBytes == 1000);
+    BOOST_CHECK(fanIn.GetTraffic(1).m_numMessages == 1);
+    BOOST_CHECK(fanIn.GetMaxEgressBytes() == 1000);
+}
+
+BOOST_AUTO_TEST_CASE (test_compute_and_loss)
+{
+    SimNetwork net(2, MakeLink(1.0), 1);
+    uint64_t computed = 0, delivered = 0;
+
+    // Work on one node runs back to back
+    net.Compute(0, 5 * MS, []() {});
+    net.Compute(0, 5 * MS, [&]() { computed = net.Now(); });
+
+    // Every attempt is lost, so the message arrives after the retransmission cap
+    net.Send(0, 1, 0, 0, [&]() { delivered = net.Now(); });
+    net.Run();
+
+    BOOST_CHECK(computed == 10 * MS);
+    BOOST_CHECK(delivered == 10 * MS + SimNetwork::MAX_RETRANSMITS * 200 * MS);
+    BOOST_CHECK(net.GetTraffic(0).m_numRetransmits == SimNetwork::MAX_RETRANSMITS);
+}
+
+BOOST_AUTO_TEST_CASE (test_epoch_phases)
+{
+    EpochSimulator first(MakeConfig(4));
+    vector<EpochSimulator::PhaseTiming> phases = first.Run();
+
+    vector<string> names = { "pow1", "ds_block/consensus", "ds_block/multicast", "pow2", "sharding/consensus",
+                             "sharding/multicast", "microblock/consensus", "microblock/submission",
+                             "final_block/consensus", "final_block/fragments", "microblock/consensus",
+                             "microblock/submission", "final_block/consensus", "final_block/fragments" };
+    BOOST_REQUIRE(phases.size() == names.size());
+
+    for (unsigned int i = 0; i < phases.size(); i++)
+    {
+        BOOST_CHECK_MESSAGE(phases.at(i).m_name == names.at(i), "Phase " << i << " is " << phases.at(i).m_name);
+        BOOST_CHECK(phases.at(i).m_endNs > phases.at(i).m_startNs);
+        BOOST_CHECK(phases.at(i).m_numMessages > 0);
+    }
+
+    // Every shard node submits PoW to every DS node
+    BOOST_CHECK(phases.at(0).m_numMessages == 100 * 10);
+    BOOST_CHECK(phases.at(0).m_endNs == 1000 * MS);
+
+    // Each consensus member sends one commit and one response, whatever the tree shape
+    BOOST_CHECK(phases.at(1).m_numMessages == 9 * 5);
+
+    // Phases that depend on each other do not overlap
+    BOOST_CHECK(phases.at(3).m_startNs >= phases.at(2).m_endNs);
+    BOOST_CHECK(phases.at(8).m_startNs >= phases.at(7).m_endNs);
+    BOOST_CHECK(phases.at(10).m_startNs >= phases.at(9).m_endNs);
+
+    // Same seed, same run
+    EpochSimulator second(MakeConfig(4));
+    vector<EpochSimulator::PhaseTiming> again = second.Run();
+    for (unsigned int i = 0; i < phases.size(); i++)
+    {
+        BOOST_CHECK(again.at(i).m_endNs == phases.at(i).m_endNs);
+        BOOST_CHECK(again.at(i).m_numRetransmits == phases.at(i).m_numRetransmits);
+    }
+    BOOST_CHECK(second.GetNumEvents() == first.GetNumEvents());
+
+    // A flat round sends the same number of messages, all of them to the leader
+    EpochSimulator flat(MakeConfig(0));
+    BOOST_CHECK(flat.Run().at(1).m_numMessages == phases.at(1).m_numMessages);
+}
+
+BOOST_AUTO_TEST_SUITE_END ()
@@ -0,0 +1,120 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "libUtils/DispatchQueues.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+enum TestClass : unsigned int
+{
+    CONSENSUS = 0x00,
+    TRANSACTIONS
+};
+
+void test_isolation()
+{
+    LOG_MARKER();
+
+    DispatchQueues queues({ { "consensus", 2, 1024, DispatchQueues::BLOCK }, 
+                            { "transactions", 1, 100, DispatchQueues::DROP_NEWEST } });
+
+    // Flood the transaction class with slow handlers
+    unsigned int accepted = 0;
+    for (unsigned int i = 0; i < 1000; i++)
+    {
+        accepted += queues.Push(TRANSACTIONS, []() { this_thread::sleep_for(chrono::milliseconds(5)); }) ? 1 : 0;
+    }
+
+    // A consensus message behind the flood still runs right away
+    atomic<bool> done(false);
+    auto start = chrono::steady_clock::now();
+    queues.Push(CONSENSUS, [&done]() { done = true; });
+    while (!done)
+    {
+        this_thread::yield();
+    }
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+
+    DispatchQueues::ClassStats stats = queues.GetStats(TRANSACTIONS);
+
+    LOG_MESSAGE("Consensus message handled after " << elapsed << " ms with " << stats.m_depth << 
+                " transactions queued (behind them in one queue: ~500 ms)");
+    LOG_MESSAGE("Transactions accepted = " << accepted << ", dropped = " << stats.m_dropped << 
+                " (expected ~100 and ~900)");
+
+    queues.LogStats();
+}
+
+void test_back_pressure()
+{
+    LOG_MARKER();
+
+    DispatchQueues queues({ { "consensus", 1, 10, DispatchQueues::BLOCK } });
+
+    // With a full queue, Push() waits for the worker instead of dropping
+    atomic<unsigned int> ran(0);
+    auto start = chrono::steady_clock::now();
+    for (unsigned int i = 0; i < 50; i++)
+    {
+        queues.Push(CONSENSUS, [&ran]() { this_thread::sleep_for(chrono::milliseconds(2)); ran++; });
+    }
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+
+    while (ran < 50)
+    {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+
+    DispatchQueues::ClassStats stats = queues.GetStats(CONSENSUS);
+
+    LOG_MESSAGE("Pushing 50 items into a 10-item queue took " << elapsed << " ms (expected ~80 ms)");
+    LOG_MESSAGE("Dropped = " << stats.m_dropped << ", max depth = " << stats.m_maxDepth << " (expected 0 and 10)");
+}
+
+void test_throwing_handlers()
+{
+    LOG_MARKER();
+
+    DispatchQueues queues({ { "consensus", 1, 10, DispatchQueues::BLOCK } });
+
+    // Handlers that throw anything must leave the worker running
+    atomic<bool> done(false);
+    queues.Push(CONSENSUS, []() { throw "Blocknumber Absent"; });
+    queues.Push(CONSENSUS, []() { throw 42; });
+    queues.Push(CONSENSUS, [&done]() { done = true; });
+    while (!done)
+    {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+
+    LOG_MESSAGE("Handler after throwing ones ran = " << done << " (expected 1)");
+}
+
+int main()
+{
+    INIT_STDOUT_LOGGER();
+
+    test_isolation();
+    test_back_pressure();
+    test_throwing_handlers();
+
+    return 0;
+}
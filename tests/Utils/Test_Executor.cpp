@@ -0,0 +1,218 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "libUtils/Executor.h"
+#include "libUtils/Logger.h"
+#include "libUtils/ThreadPool.h"
+
+using namespace std;
+
+unsigned long fib(unsigned int n)
+{
+    return (n < 2) ? n : fib(n - 1) + fib(n - 2);
+}
+
+void test_submit()
+{
+    LOG_MARKER();
+
+    vector<TaskFuture<unsigned long>> results;
+    for (unsigned int i = 0; i < 20; i++)
+    {
+        results.push_back(Executor::GetInstance().Submit([i]() { return fib(20 + (i % 5)); }));
+    }
+
+    unsigned long sum = 0;
+    for (auto & r : results)
+    {
+        sum += r.Get();
+    }
+
+    LOG_MESSAGE("Sum of 20 fib tasks = " << sum << " (expected 441788)");
+}
+
+void test_continuation()
+{
+    LOG_MARKER();
+
+    auto result = Executor::GetInstance().Submit([]() { return 20; })
+                  .Then([](shared_future<int> f) { return f.get() * 2; })
+                  .Then([](shared_future<int> f) { return f.get() + 2; });
+
+    LOG_MESSAGE("Continuation result = " << result.Get() << " (expected 42)");
+}
+
+void test_nested()
+{
+    LOG_MARKER();
+
+    // A task waiting on other tasks must not starve the workers
+    auto outer = Executor::GetInstance().Submit([]()
+    {
+        vector<TaskFuture<unsigned long>> inner;
+        for (unsigned int i = 0; i < 8; i++)
+        {
+            inner.push_back(Executor::GetInstance().Submit([]() { return fib(18); }));
+        }
+
+        unsigned long sum = 0;
+        for (auto & r : inner)
+        {
+            sum += r.Get();
+        }
+        return sum;
+    });
+
+    LOG_MESSAGE("Nested sum = " << outer.Get() << " (expected 20672)");
+}
+
+void test_timer()
+{
+    LOG_MARKER();
+
+    atomic<int> order(0);
+    atomic<int> first(0), second(0);
+
+    auto start = chrono::steady_clock::now();
+    Executor::GetInstance().PostAfter(chrono::milliseconds(300), [&]() { second = ++order; });
+    Executor::GetInstance().PostAfter(chrono::milliseconds(100), [&]() { first = ++order; });
+
+    while (order < 2)
+    {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    LOG_MESSAGE("Timers fired in order " << first << "," << second << " (expected 1,2) after " << elapsed << " ms");
+}
+
+void test_blocking()
+{
+    LOG_MARKER();
+
+    atomic<int> done(0);
+    for (unsigned int i = 0; i < 100; i++)
+    {
+        Executor::GetInstance().PostBlocking([&done]()
+        {
+            this_thread::sleep_for(chrono::milliseconds(50));
+            done++;
+        });
+    }
+
+    while (done < 100)
+    {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+
+    LOG_MESSAGE("Blocking tasks done = " << done << ", pool threads = " << 
+                Executor::GetInstance().GetNumBlockingThreads() << " (max " << Executor::MAX_BLOCKING_THREADS << ")");
+}
+
+void test_nested_thread_pools()
+{
+    LOG_MARKER();
+
+    // More outer jobs than the blocking pool can hold, each waiting on a ThreadPool of its own
+    const unsigned int numOuter = 4 * Executor::MAX_BLOCKING_THREADS;
+    atomic<unsigned int> done(0), inner(0);
+    for (unsigned int i = 0; i < numOuter; i++)
+    {
+        Executor::GetInstance().PostBlocking([&done, &inner]()
+        {
+            ThreadPool pool(4);
+            for (unsigned int j = 0; j < 8; j++)
+            {
+                pool.AddJob([&inner]()
+                {
+                    this_thread::sleep_for(chrono::milliseconds(1));
+                    inner++;
+                });
+            }
+            pool.WaitAll();
+            pool.JoinAll();
+            done++;
+        });
+    }
+
+    while (done < numOuter)
+    {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+
+    LOG_MESSAGE("Nested pools done = " << done << ", inner jobs = " << inner << " (expected " << 8 * numOuter << ")");
+}
+
+void test_throwing_tasks()
+{
+    LOG_MARKER();
+
+    // Tasks that throw anything must leave the workers running
+    for (unsigned int i = 0; i < 4 * Executor::GetInstance().GetNumWorkers(); i++)
+    {
+        Executor::GetInstance().Post([]() { throw "Blocknumber Absent"; });
+        Executor::GetInstance().Post([]() { throw 42; });
+    }
+
+    auto result = Executor::GetInstance().Submit([]() { return fib(10); });
+    LOG_MESSAGE("Result after throwing tasks = " << result.Get() << " (expected 55)");
+}
+
+void test_throwing_pool_jobs()
+{
+    LOG_MARKER();
+
+    // A job that throws must still count as done, or WaitAll never returns
+    atomic<unsigned int> done(0);
+    ThreadPool pool(2);
+    for (unsigned int i = 0; i < 8; i++)
+    {
+        pool.AddJob([&done, i]()
+        {
+            done++;
+            if (i % 2 == 0)
+            {
+                throw 42;
+            }
+        });
+    }
+    pool.WaitAll();
+
+    LOG_MESSAGE("Pool jobs done after throws = " << done << " (expected 8)");
+}
+
+int main()
+{
+    INIT_STDOUT_LOGGER();
+
+    LOG_MESSAGE("Workers = " << Executor::GetInstance().GetNumWorkers());
+
+    test_submit();
+    test_continuation();
+    test_nested();
+    test_timer();
+    test_blocking();
+    test_nested_thread_pools();
+    test_throwing_tasks();
+    test_throwing_pool_jobs();
+
+    return 0;
+}
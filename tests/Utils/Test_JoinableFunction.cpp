@@ -16,6 +16,7 @@
 
 #include <memory>
 #include <mutex>
+#include <thread>
 #include "libUtils/JoinableFunction.h"
 #include "libUtils/Logger.h"
 
@@ -0,0 +1,73 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+const unsigned int MESSAGES_PER_THREAD = 100000;
+
+double run(unsigned int num_threads)
+{
+    vector<thread> threads;
+
+    auto start = chrono::steady_clock::now();
+
+    for (unsigned int i = 0; i < num_threads; i++)
+    {
+        threads.emplace_back([i]()
+        {
+            for (unsigned int j = 0; j < MESSAGES_PER_THREAD; j++)
+            {
+                LOG_MESSAGE("Thread " << i << " message " << j);
+            }
+        });
+    }
+
+    for (auto & t : threads)
+    {
+        t.join();
+    }
+
+    auto elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    Logger::GetLogger(NULL, true).Flush();
+
+    return MESSAGES_PER_THREAD / elapsed;
+}
+
+int main()
+{
+    // Write to a file so the benchmark output stays readable
+    INIT_FILE_LOGGER("throughput");
+
+    for (unsigned int num_threads : { 1, 2, 4, 8 })
+    {
+        double rate = run(num_threads);
+        cout << "Threads: " << num_threads << " Messages/sec/thread: " << (unsigned long)rate << endl;
+    }
+
+    // Disabled messages must cost next to nothing
+    Logger::SetLogLevel(LOG_LEVEL_WARNING);
+    double rate = run(1);
+    cout << "Disabled level Messages/sec/thread: " << (unsigned long)rate << endl;
+
+    return 0;
+}
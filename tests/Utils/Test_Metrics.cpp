@@ -0,0 +1,195 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+#include <algorithm>
+#include <arpa/inet.h>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <netinet/in.h>
+#include <random>
+#include <sstream>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "libUtils/Logger.h"
+#include "libUtils/Metrics.h"
+
+using namespace std;
+
+void test_counters()
+{
+    LOG_MARKER();
+
+    const unsigned int num_threads = 4;
+    const unsigned int increments = 1000000;
+
+    auto start = chrono::steady_clock::now();
+    vector<thread> threads;
+    for (unsigned int i = 0; i < num_threads; i++)
+    {
+        threads.emplace_back([]()
+        {
+            for (unsigned int j = 0; j < increments; j++)
+            {
+                METRICS_COUNTER("test_increments_total", "Increments from the test threads").Increment();
+                METRICS_GAUGE("test_balance", "Goes up and down").Add((j % 2 == 0) ? 1 : -1);
+            }
+        });
+    }
+    for (auto & t : threads)
+    {
+        t.join();
+    }
+    auto elapsed_ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+
+    LOG_MESSAGE("Counter = " << METRICS_COUNTER("test_increments_total", "").Get() << " (expected " << 
+                num_threads * increments << ")");
+    LOG_MESSAGE("Gauge = " << METRICS_GAUGE("test_balance", "").Get() << " (expected 0)");
+    LOG_MESSAGE("Same object on lookup: " << 
+                (&Metrics::GetInstance().GetCounter("test_increments_total", "") == 
+                 &METRICS_COUNTER("test_increments_total", "")) << " (expected 1)");
+    LOG_MESSAGE(num_threads << " threads: " << elapsed_ns / increments << " ns per counter + gauge update");
+}
+
+void test_histogram_accuracy()
+{
+    LOG_MARKER();
+
+    MetricHistogram histogram;
+    LOG_MESSAGE("Empty quantile = " << histogram.GetQuantile(0.5) << " (expected 0)");
+
+    // Latencies spread over six orders of magnitude
+    mt19937_64 rng(7);
+    lognormal_distribution<double> dist(12.0, 2.0);
+    vector<uint64_t> values(100000);
+    for (auto & value : values)
+    {
+        value = static_cast<uint64_t>(dist(rng));
+        histogram.Record(value);
+    }
+    sort(values.begin(), values.end());
+
+    double worst = 0;
+    for (unsigned int i = 0; i < Metrics::NUM_QUANTILES; i++)
+    {
+        double q = Metrics::QUANTILES[i];
+        uint64_t exact = values.at(static_cast<size_t>(ceil(q * values.size())) - 1);
+        uint64_t estimate = histogram.GetQuantile(q);
+        double error = fabs((double) estimate - (double) exact) / max<double>(exact, 1);
+        worst = max(worst, error);
+        LOG_MESSAGE("q" << q << ": exact " << exact << " ns, estimate " << estimate << " ns");
+    }
+    LOG_MESSAGE("Worst relative error within 1/" << MetricHistogram::SUB_BUCKETS << ": " << 
+                (worst <= 1.0 / MetricHistogram::SUB_BUCKETS) << " (expected 1)");
+    LOG_MESSAGE("Count = " << histogram.GetCount() << " (expected " << values.size() << ")");
+
+    bool monotonic = true;
+    uint64_t previous = 0;
+    for (unsigned int b = 0; b < MetricHistogram::NUM_BUCKETS; b++)
+    {
+        uint64_t value = MetricHistogram::GetBucketValue(b);
+        monotonic = monotonic && (b == 0 || value > previous) && (MetricHistogram::GetBucket(value) == b);
+        previous = value;
+    }
+    LOG_MESSAGE("Buckets increasing and self-consistent: " << monotonic << " (expected 1)");
+    LOG_MESSAGE("Largest value lands in last bucket: " << 
+                (MetricHistogram::GetBucket(UINT64_MAX) == MetricHistogram::NUM_BUCKETS - 1) << " (expected 1)");
+}
+
+void test_prometheus_format()
+{
+    LOG_MARKER();
+
+    Metrics::GetInstance().GetCounter("test_requests_total", "Requests served", "code=\"200\"").Increment(3);
+    Metrics::GetInstance().GetHistogram("test_latency_seconds", "Request latency", "op=\"get\"")
+        .Record(chrono::milliseconds(2));
+
+    ostringstream os;
+    Metrics::GetInstance().WritePrometheus(os);
+    const string text = os.str();
+
+    LOG_MESSAGE("Counter type line: " << (text.find("# TYPE test_requests_total counter\n") != string::npos) << 
+                " (expected 1)");
+    LOG_MESSAGE("Labelled sample: " << (text.find("test_requests_total{code=\"200\"} 3\n") != string::npos) << 
+                " (expected 1)");
+    LOG_MESSAGE("Summary type line: " << (text.find("# TYPE test_latency_seconds summary\n") != string::npos) << 
+                " (expected 1)");
+
+    const string quantile = "test_latency_seconds{op=\"get\",quantile=\"0.99\"} ";
+    size_t pos = text.find(quantile);
+    double seconds = (pos == string::npos) ? 0 : stod(text.substr(pos + quantile.size()));
+    LOG_MESSAGE("Quantile sample in seconds: " << seconds << " (expected about 0.002)");
+    LOG_MESSAGE("Count sample: " << (text.find("test_latency_seconds_count{op=\"get\"} 1\n") != string::npos) << 
+                " (expected 1)");
+}
+
+void test_listener()
+{
+    LOG_MARKER();
+
+    const unsigned int port = 19150;
+    Metrics::GetInstance().Start(port, 0);
+    this_thread::sleep_for(chrono::milliseconds(100));
+
+    int sock = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    // A client that connects and never sends must not block the scrape behind it
+    int idleSock = socket(AF_INET, SOCK_STREAM, 0);
+    connect(idleSock, (struct sockaddr *) &addr, sizeof(addr));
+
+    auto start = chrono::steady_clock::now();
+    string response;
+    if (connect(sock, (struct sockaddr *) &addr, sizeof(addr)) == 0)
+    {
+        const string request = "GET /metrics HTTP/1.0\r\n\r\n";
+        send(sock, request.data(), request.size(), 0);
+
+        char buf[4096];
+        ssize_t n;
+        while ((n = recv(sock, buf, sizeof(buf), 0)) > 0)
+        {
+            response.append(buf, n);
+        }
+    }
+    close(sock);
+    close(idleSock);
+
+    auto elapsed = chrono::duration_cast<chrono::seconds>(chrono::steady_clock::now() - start).count();
+    LOG_MESSAGE("Scrape behind an idle client took " << elapsed << " s (expected at most " << 
+                Metrics::SOCKET_TIMEOUT_IN_SECONDS << ")");
+    LOG_MESSAGE("HTTP 200: " << (response.compare(0, 15, "HTTP/1.0 200 OK") == 0) << " (expected 1)");
+    LOG_MESSAGE("Body has metrics: " << (response.find("test_requests_total{code=\"200\"} 3") != string::npos) << 
+                " (expected 1)");
+}
+
+int main()
+{
+    INIT_STDOUT_LOGGER();
+
+    test_counters();
+    test_histogram_accuracy();
+    test_prometheus_format();
+    test_listener();
+
+    return 0;
+}
@@ -0,0 +1,160 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "libUtils/Logger.h"
+#include "libUtils/ReedSolomon.h"
+
+using namespace std;
+
+void test_roundtrip()
+{
+    LOG_MARKER();
+
+    mt19937 gen(1);
+    unsigned int passed = 0, total = 0;
+
+    for (unsigned int n : { 1u, 2u, 7u, 64u, 255u })
+    {
+        for (unsigned int k : { 1u, (n + 1) / 2, n })
+        {
+            vector<unsigned char> data(1000 + gen() % 5000);
+            generate(data.begin(), data.end(), [&gen]() { return (unsigned char)gen(); });
+
+            vector<vector<unsigned char>> fragments;
+            ReedSolomon::Encode(data, k, n, fragments);
+
+            // Keep a random k of the n fragments
+            vector<unsigned int> indices(n);
+            for (unsigned int i = 0; i < n; i++)
+            {
+                indices[i] = i;
+            }
+            shuffle(indices.begin(), indices.end(), gen);
+
+            map<unsigned int, vector<unsigned char>> received;
+            for (unsigned int i = 0; i < k; i++)
+            {
+                received.emplace(indices[i], fragments[indices[i]]);
+            }
+
+            vector<unsigned char> rebuilt;
+            bool ok = ReedSolomon::Decode(received, k, n, data.size(), rebuilt) && (rebuilt == data);
+
+            // One fragment short must fail
+            received.erase(received.begin());
+            ok = ok && !ReedSolomon::Decode(received, k, n, data.size(), rebuilt);
+
+            passed += ok ? 1 : 0;
+            total++;
+        }
+    }
+
+    LOG_MESSAGE("Rebuilt " << passed << " of " << total << " codes from a random k of n fragments (expected all)");
+}
+
+void test_shard_dissemination()
+{
+    LOG_MARKER();
+
+    // One DS cluster serving one shard, with two DS nodes down
+    const unsigned int shard_size = 600;
+    const unsigned int cluster_size = 20;
+    const set<unsigned int> failed_ds = { 3, 11 };
+    const unsigned int message_size = 100 * 1024;
+    const unsigned int header_size = 32 + 4 + 3;
+
+    const unsigned int n = min(shard_size, ReedSolomon::MAX_FRAGMENTS);
+    const unsigned int k = n / 3;
+
+    mt19937 gen(2);
+    vector<unsigned char> message(message_size);
+    generate(message.begin(), message.end(), [&gen]() { return (unsigned char)gen(); });
+
+    vector<vector<unsigned char>> fragments;
+    ReedSolomon::Encode(message, k, n, fragments);
+    const unsigned int fragment_message_size = header_size + fragments[0].size();
+
+    // DS node d sends fragment (j mod n) to every member j with j mod cluster_size == d
+    vector<set<unsigned int>> held(shard_size);
+    vector<bool> got_from_ds(shard_size, false);
+    uint64_t ds_egress_max = 0;
+    for (unsigned int d = 0; d < cluster_size; d++)
+    {
+        uint64_t egress = 0;
+        for (unsigned int j = d; j < shard_size && failed_ds.count(d) == 0; j += cluster_size)
+        {
+            held[j].insert(j % n);
+            got_from_ds[j] = true;
+            egress += fragment_message_size;
+        }
+        ds_egress_max = max(ds_egress_max, egress);
+    }
+
+    // Members 0..n-1 relay the fragment they received to the rest of the shard
+    uint64_t member_egress_max = 0;
+    for (unsigned int j = 0; j < n; j++)
+    {
+        if (!got_from_ds[j])
+        {
+            continue;
+        }
+        for (unsigned int m = 0; m < shard_size; m++)
+        {
+            held[m].insert(j);
+        }
+        member_egress_max = max<uint64_t>(member_egress_max, (uint64_t)(shard_size - 1) * fragment_message_size);
+    }
+
+    unsigned int complete = 0;
+    for (unsigned int m = 0; m < shard_size; m++)
+    {
+        complete += (held[m].size() >= k) ? 1 : 0;
+    }
+
+    // Actually rebuild at member 3, which got nothing from the DS committee
+    map<unsigned int, vector<unsigned char>> received;
+    for (unsigned int index : held[3])
+    {
+        received.emplace(index, fragments[index]);
+    }
+    vector<unsigned char> rebuilt;
+    bool ok = ReedSolomon::Decode(received, k, n, message.size(), rebuilt) && (rebuilt == message);
+
+    // Previously every DS node in the cluster sent the whole message to every shard member
+    const uint64_t full_egress = (uint64_t)shard_size * message_size;
+
+    LOG_MESSAGE("Shard of " << shard_size << ", k = " << k << ", n = " << n << ": " << complete << 
+                " members can rebuild (expected " << shard_size << "), sample rebuild ok = " << ok);
+    LOG_MESSAGE("Egress per DS node: full = " << full_egress << " bytes, fragments = " << ds_egress_max << 
+                " bytes (" << full_egress / max<uint64_t>(ds_egress_max, 1) << "x less)");
+    LOG_MESSAGE("Largest egress per shard member for relaying: " << member_egress_max << " bytes");
+}
+
+int main()
+{
+    INIT_STDOUT_LOGGER();
+
+    test_roundtrip();
+    test_shard_dissemination();
+
+    return 0;
+}
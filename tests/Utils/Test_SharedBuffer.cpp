@@ -0,0 +1,115 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <chrono>
+#include <functional>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "libUtils/Logger.h"
+#include "libUtils/SharedBuffer.h"
+
+using namespace std;
+
+void test_slices()
+{
+    LOG_MARKER();
+
+    vector<unsigned char> bytes(100);
+    iota(bytes.begin(), bytes.end(), 0);
+    const unsigned char * storage = bytes.data();
+
+    SharedBuffer buffer(move(bytes));
+    SharedBuffer tail = buffer.Slice(32);
+    SharedBuffer middle = tail.Slice(8, 4);
+
+    LOG_MESSAGE("Buffer took over the vector storage: " << (buffer.data() == storage) << " (expected 1)");
+    LOG_MESSAGE("Tail size " << tail.size() << " first byte " << (unsigned int)tail.at(0) << " (expected 68 32)");
+    LOG_MESSAGE("Middle size " << middle.size() << " first byte " << (unsigned int)middle.at(0) << 
+                " shares storage: " << (middle.data() == storage + 40) << " (expected 4 40 1)");
+    LOG_MESSAGE("Buffers sharing the storage: " << buffer.GetUseCount() << " (expected 3)");
+    LOG_MESSAGE("Whole buffer " << buffer.IsWhole() << ", slice " << middle.IsWhole() << " (expected 1 0)");
+
+    bool threw = false;
+    try
+    {
+        buffer.Slice(90, 11);
+    }
+    catch (const out_of_range &)
+    {
+        threw = true;
+    }
+    LOG_MESSAGE("Slice past the end rejected: " << threw << " (expected 1)");
+}
+
+void test_fan_out()
+{
+    LOG_MARKER();
+
+    // One received message handed to a dispatch queue and to 8 forwarding tasks
+    const unsigned int message_size = 4 * 1024 * 1024;
+    const unsigned int consumers = 9;
+    const unsigned int rounds = 20;
+
+    uint64_t checksum_copy = 0, checksum_shared = 0;
+
+    auto start = chrono::steady_clock::now();
+    for (unsigned int r = 0; r < rounds; r++)
+    {
+        vector<unsigned char> message(message_size, (unsigned char)r);
+        vector<function<void()>> tasks;
+        for (unsigned int c = 0; c < consumers; c++)
+        {
+            tasks.emplace_back([message, &checksum_copy]() { checksum_copy += message.back(); });
+        }
+        for (auto & task : tasks)
+        {
+            task();
+        }
+    }
+    auto copy_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+    start = chrono::steady_clock::now();
+    for (unsigned int r = 0; r < rounds; r++)
+    {
+        SharedBuffer message(vector<unsigned char>(message_size, (unsigned char)r));
+        vector<function<void()>> tasks;
+        for (unsigned int c = 0; c < consumers; c++)
+        {
+            tasks.emplace_back([message, &checksum_shared]() { checksum_shared += message.at(message.size() - 1); });
+        }
+        for (auto & task : tasks)
+        {
+            task();
+        }
+    }
+    auto shared_us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count();
+
+    LOG_MESSAGE("Same results: " << (checksum_copy == checksum_shared) << " (expected 1)");
+    LOG_MESSAGE("Fan-out of " << rounds << " x " << message_size << "-byte messages to " << consumers << 
+                " consumers: copied " << copy_us << " us, shared " << shared_us << " us");
+}
+
+int main()
+{
+    INIT_STDOUT_LOGGER();
+
+    test_slices();
+    test_fan_out();
+
+    return 0;
+}
@@ -0,0 +1,180 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "libUtils/Logger.h"
+#include "libUtils/StateNotifier.h"
+
+using namespace std;
+
+enum TestState : unsigned char
+{
+    WAITING = 0x00,
+    READY,
+    DONE
+};
+
+atomic<TestState> state(WAITING);
+StateNotifier<TestState> notifier(state);
+
+void SetState(TestState s)
+{
+    state = s;
+    notifier.Notify();
+}
+
+void test_park_and_replay()
+{
+    LOG_MARKER();
+
+    mutex m;
+    vector<int> order;
+
+    // Messages arriving before READY are parked and replayed in arrival order
+    for (int i = 0; i < 5; i++)
+    {
+        bool parked = notifier.ParkUntil(READY, [&m, &order, i]() { lock_guard<mutex> g(m); order.push_back(i); },
+                                         chrono::seconds(5));
+        if (!parked)
+        {
+            LOG_MESSAGE("Error: message " << i << " was not parked");
+        }
+    }
+
+    LOG_MESSAGE("Parked = " << notifier.GetNumParked(READY) << " (expected 5)");
+
+    SetState(READY);
+
+    // Arrivals while the replay is running queue up behind it
+    notifier.ParkUntil(READY, [&m, &order]() { lock_guard<mutex> g(m); order.push_back(5); }, chrono::seconds(5));
+
+    while (notifier.GetNumParked(READY) > 0)
+    {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    this_thread::sleep_for(chrono::milliseconds(100));
+
+    lock_guard<mutex> g(m);
+    ostringstream replayed;
+    for (int i : order)
+    {
+        replayed << i << " ";
+    }
+    LOG_MESSAGE("Replay order = " << replayed.str() << "(expected 0 1 2 3 4 5)");
+
+    bool inline_run = !notifier.ParkUntil(READY, []() {}, chrono::seconds(5));
+    LOG_MESSAGE("Runs inline once in state = " << inline_run << " (expected 1)");
+}
+
+void test_expiry()
+{
+    LOG_MARKER();
+
+    atomic<bool> ran(false);
+
+    notifier.ParkUntil(DONE, [&ran]() { ran = true; }, chrono::milliseconds(100));
+    this_thread::sleep_for(chrono::milliseconds(300));
+
+    LOG_MESSAGE("Parked after deadline = " << notifier.GetNumParked(DONE) << " (expected 0)");
+
+    SetState(DONE);
+    this_thread::sleep_for(chrono::milliseconds(100));
+
+    LOG_MESSAGE("Expired message ran = " << ran << " (expected 0)");
+}
+
+void test_wait()
+{
+    LOG_MARKER();
+
+    SetState(WAITING);
+
+    thread t([]() { this_thread::sleep_for(chrono::milliseconds(100)); SetState(READY); });
+
+    auto start = chrono::steady_clock::now();
+    bool reached = notifier.WaitFor([]() { return state == READY; }, chrono::seconds(5));
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    t.join();
+
+    LOG_MESSAGE("Reached READY = " << reached << " after " << elapsed << " ms");
+
+    bool timedOut = !notifier.WaitFor([]() { return state == DONE; }, chrono::milliseconds(100));
+    LOG_MESSAGE("Timed out waiting for DONE = " << timedOut << " (expected 1)");
+}
+
+void test_also_drain_in()
+{
+    LOG_MARKER();
+
+    SetState(WAITING);
+    notifier.AlsoDrainIn(READY, DONE);
+
+    // Work parked for READY is replayed in DONE too, and DONE does not jump ahead of it
+    atomic<int> ran(0);
+    notifier.ParkUntil(READY, [&ran]() { ran++; }, chrono::seconds(5));
+    SetState(DONE);
+
+    bool parkedBehind = notifier.ParkUntil(READY, [&ran]() { ran++; }, chrono::seconds(5));
+    while (ran < (parkedBehind ? 2 : 1))
+    {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+
+    bool inline_run = !notifier.ParkUntil(READY, []() {}, chrono::seconds(5));
+    LOG_MESSAGE("Replayed in DONE = " << ran << " (expected " << (parkedBehind ? 2 : 1) << ")");
+    LOG_MESSAGE("Runs inline once drained = " << inline_run << " (expected 1)");
+}
+
+void test_throwing_parked_task()
+{
+    LOG_MARKER();
+
+    SetState(WAITING);
+
+    // A parked task that throws must not stop the queue from draining now or later
+    atomic<int> ran(0);
+    notifier.ParkUntil(READY, []() { throw 42; }, chrono::seconds(5));
+    notifier.ParkUntil(READY, [&ran]() { ran++; }, chrono::seconds(5));
+    SetState(READY);
+
+    while ((ran < 1) || (notifier.GetNumParked(READY) > 0))
+    {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+    this_thread::sleep_for(chrono::milliseconds(100));
+
+    bool inline_run = !notifier.ParkUntil(READY, []() {}, chrono::seconds(5));
+    LOG_MESSAGE("Replayed after throw = " << ran << " (expected 1)");
+    LOG_MESSAGE("Runs inline once drained = " << inline_run << " (expected 1)");
+}
+
+int main()
+{
+    INIT_STDOUT_LOGGER();
+
+    test_park_and_replay();
+    test_expiry();
+    test_wait();
+    test_also_drain_in();
+    test_throwing_parked_task();
+
+    return 0;
+}
@@ -17,6 +17,7 @@
 #include <cstring>
 #include <iostream>
 #include <mutex>
+#include <stdexcept>
 #include "libUtils/TimeLockedFunction.h"
 #include "libUtils/Logger.h"
 
@@ -67,6 +68,22 @@ void test(int target, int delay)
     TimeLockedFunction tlf(delay, main_func, expiry_func, true);
 }
 
+void test_throwing_main()
+{
+    LOG_MARKER();
+
+    // The window must close right away instead of hanging the destructor
+    auto start = chrono::steady_clock::now();
+    {
+        auto main_func = []() -> void { throw runtime_error("main failed"); };
+        auto expiry_func = []() -> void { LOG_MESSAGE("Expiry ran after main threw"); };
+        TimeLockedFunction tlf(10, main_func, expiry_func, false);
+    }
+
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    LOG_MESSAGE("Window closed after " << elapsed << " ms (expected well under 10000)");
+}
+
 int main()
 {
     INIT_STDOUT_LOGGER();
@@ -74,6 +91,7 @@ int main()
     test(5, 4);
     test(5, 5);
     test(5, 10);
+    test_throwing_main();
 
     return 0;
 }
@@ -0,0 +1,134 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "libUtils/Executor.h"
+#include "libUtils/Logger.h"
+#include "libUtils/TimerWheel.h"
+
+using namespace std;
+
+void test_order()
+{
+    LOG_MARKER();
+
+    atomic<int> order(0);
+    atomic<int> a(0), b(0), c(0);
+
+    TimerWheel & wheel = TimerWheel::GetInstance();
+    wheel.Schedule(chrono::milliseconds(250), [&]() { c = ++order; }, false);
+    wheel.Schedule(chrono::milliseconds(50), [&]() { a = ++order; }, false);
+    wheel.Schedule(chrono::milliseconds(150), [&]() { b = ++order; }, true);
+
+    this_thread::sleep_for(chrono::milliseconds(400));
+
+    LOG_MESSAGE("Fired in order " << a << "," << b << "," << c << " (expected 1,2,3)");
+}
+
+void test_cancel()
+{
+    LOG_MARKER();
+
+    atomic<int> fired(0);
+
+    TimerHandle keep = Executor::GetInstance().PostAfter(chrono::milliseconds(100), [&]() { fired += 1; });
+    TimerHandle drop = Executor::GetInstance().PostAfter(chrono::milliseconds(100), [&]() { fired += 10; });
+
+    bool cancelled = drop.Cancel();
+    bool cancelledTwice = drop.Cancel();
+
+    this_thread::sleep_for(chrono::milliseconds(300));
+
+    LOG_MESSAGE("Cancel = " << cancelled << ", second cancel = " << cancelledTwice << ", fired = " << fired <<
+                " (expected 1, 0, 1)");
+    LOG_MESSAGE("Pending after firing = " << keep.IsPending() << ", cancel after firing = " << keep.Cancel() <<
+                " (expected 0, 0)");
+}
+
+void test_cascade()
+{
+    LOG_MARKER();
+
+    // Beyond the first level (256 ticks), so the timer is cascaded down before it fires
+    const unsigned int delay = TimerWheel::SLOTS_PER_LEVEL * TimerWheel::TICK_MILLISECONDS + 500;
+
+    atomic<bool> fired(false);
+    chrono::steady_clock::time_point firedAt;
+
+    auto start = chrono::steady_clock::now();
+    TimerWheel::GetInstance().Schedule(chrono::milliseconds(delay), [&]() { firedAt = chrono::steady_clock::now(); fired = true; }, false);
+
+    while (!fired)
+    {
+        this_thread::sleep_for(chrono::milliseconds(10));
+    }
+
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(firedAt - start).count();
+    LOG_MESSAGE("Cascaded timer of " << delay << " ms fired after " << elapsed << " ms");
+}
+
+void test_many()
+{
+    LOG_MARKER();
+
+    const unsigned int count = 100000;
+    atomic<unsigned int> fired(0);
+    vector<TimerHandle> handles;
+    handles.reserve(count);
+
+    auto start = chrono::steady_clock::now();
+    for (unsigned int i = 0; i < count; i++)
+    {
+        handles.push_back(TimerWheel::GetInstance().Schedule(chrono::milliseconds(100 + (i % 1000)), [&]() { fired++; }, false));
+    }
+    auto scheduled = chrono::steady_clock::now();
+
+    // Cancel every other timer
+    unsigned int cancelled = 0;
+    for (unsigned int i = 0; i < count; i += 2)
+    {
+        cancelled += handles[i].Cancel() ? 1 : 0;
+    }
+    auto done = chrono::steady_clock::now();
+
+    LOG_MESSAGE("Scheduled " << count << " timers in " << 
+                chrono::duration_cast<chrono::microseconds>(scheduled - start).count() << " us, cancelled " <<
+                cancelled << " in " << chrono::duration_cast<chrono::microseconds>(done - scheduled).count() << " us");
+
+    while (TimerWheel::GetInstance().GetNumPending() > 0)
+    {
+        this_thread::sleep_for(chrono::milliseconds(50));
+    }
+    this_thread::sleep_for(chrono::milliseconds(100));
+
+    LOG_MESSAGE("Fired " << fired << " timers (expected " << count - cancelled << ")");
+}
+
+int main()
+{
+    INIT_STDOUT_LOGGER();
+
+    test_order();
+    test_cancel();
+    test_cascade();
+    test_many();
+
+    return 0;
+}
@@ -0,0 +1,156 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "libUtils/Logger.h"
+#include "libUtils/Tracer.h"
+
+using namespace std;
+
+unsigned int CountOccurrences(const string & text, const string & pattern)
+{
+    unsigned int count = 0;
+    for (size_t pos = text.find(pattern); pos != string::npos; pos = text.find(pattern, pos + 1))
+    {
+        count++;
+    }
+    return count;
+}
+
+void Phase()
+{
+    TRACE_SPAN("phase");
+    LOG_MARKER();
+}
+
+void test_levels()
+{
+    LOG_MARKER();
+
+    Tracer::SetLevel(TRACE_OFF);
+    Phase();
+    Tracer::SetLevel(TRACE_PHASES);
+    Phase();
+    Tracer::SetLevel(TRACE_ALL);
+    Phase();
+    Tracer::SetLevel(TRACE_OFF);
+
+    ostringstream os;
+    Tracer::GetInstance().Export(os);
+    const string json = os.str();
+
+    LOG_MESSAGE("Phase spans: " << CountOccurrences(json, "\"name\":\"phase\"") << " (expected 2)");
+    LOG_MESSAGE("Marker spans: " << CountOccurrences(json, "\"name\":\"Phase\"") << " (expected 1)");
+
+    ostringstream empty;
+    Tracer::GetInstance().Export(empty);
+    LOG_MESSAGE("Export drains the buffers: " << (CountOccurrences(empty.str(), "\"ph\":\"X\"") == 0) << 
+                " (expected 1)");
+}
+
+void test_threads_and_epochs()
+{
+    LOG_MARKER();
+
+    // Moving epochs with tracing off skips the file export
+    Tracer::GetInstance().Init("test node");
+    TRACE_EPOCH(5);
+    Tracer::SetLevel(TRACE_PHASES);
+
+    const unsigned int num_threads = 4;
+    const unsigned int spans_per_thread = 100;
+
+    vector<thread> threads;
+    for (unsigned int i = 0; i < num_threads; i++)
+    {
+        threads.emplace_back([]()
+        {
+            for (unsigned int j = 0; j < spans_per_thread; j++)
+            {
+                TRACE_SPAN("work");
+            }
+        });
+    }
+    for (auto & t : threads)
+    {
+        t.join();
+    }
+
+    ostringstream os;
+    Tracer::GetInstance().Export(os);
+    const string json = os.str();
+
+    LOG_MESSAGE("Spans from exited threads: " << CountOccurrences(json, "\"name\":\"work\"") << " (expected " << 
+                num_threads * spans_per_thread << ")");
+    LOG_MESSAGE("Tagged with the epoch: " << CountOccurrences(json, "\"epoch\":5}") << " (expected " << 
+                num_threads * spans_per_thread << ")");
+    LOG_MESSAGE("Process name: " << (json.find("\"args\":{\"name\":\"test node\"}") != string::npos) << 
+                " (expected 1)");
+    LOG_MESSAGE("Document closed: " << (json.find("\"dropped_spans\":0}}") != string::npos) << " (expected 1)");
+
+    Tracer::SetLevel(TRACE_OFF);
+}
+
+void test_overhead()
+{
+    LOG_MARKER();
+
+    const unsigned int iterations = 1000000;
+
+    Tracer::SetLevel(TRACE_OFF);
+    auto start = chrono::steady_clock::now();
+    for (unsigned int i = 0; i < iterations; i++)
+    {
+        TRACE_SPAN("overhead");
+    }
+    auto off_ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+
+    Tracer::SetLevel(TRACE_PHASES);
+    const unsigned int recorded = Tracer::MAX_SPANS_PER_THREAD;
+    start = chrono::steady_clock::now();
+    for (unsigned int i = 0; i < recorded; i++)
+    {
+        TRACE_SPAN("overhead");
+    }
+    auto on_ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+
+    // The buffer is full now, so further spans are dropped and counted
+    {
+        TRACE_SPAN("overhead");
+    }
+    Tracer::SetLevel(TRACE_OFF);
+
+    ostringstream os;
+    Tracer::GetInstance().Export(os);
+    LOG_MESSAGE("Overflow counted: " << (os.str().find("\"dropped_spans\":1}}") != string::npos) << " (expected 1)");
+    LOG_MESSAGE("Span cost: " << off_ns / iterations << " ns disabled, " << on_ns / recorded << " ns recorded");
+}
+
+int main()
+{
+    INIT_STDOUT_LOGGER();
+    Logger::SetLogLevel(LOG_LEVEL_INFO);
+
+    test_levels();
+    test_threads_and_epochs();
+    test_overhead();
+
+    return 0;
+}
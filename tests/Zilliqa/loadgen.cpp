@@ -0,0 +1,694 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+#include <arpa/inet.h>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "common/Messages.h"
+#include "common/Serializable.h"
+#include "libData/AccountData/Account.h"
+#include "libData/AccountData/Transaction.h"
+#include "libData/AccountData/TxnVerifier.h"
+#include "libData/BlockData/Block.h"
+#include "libNetwork/P2PComm.h"
+#include "libUtils/Executor.h"
+#include "libUtils/Logger.h"
+#include "libUtils/Metrics.h"
+
+using namespace std;
+using namespace boost::multiprecision;
+
+namespace
+{
+    using Clock = chrono::steady_clock;
+
+    /// Header at the start of a corpus file, followed by m_count serialized transactions.
+    /// Records are nonce-major: record n * m_numAccounts + a is the n-th transaction of account a.
+    struct CorpusHeader
+    {
+        uint64_t m_magic;
+        uint32_t m_version;
+        uint32_t m_recordSize;
+        uint64_t m_count;
+        uint64_t m_numAccounts;
+    };
+
+    const uint64_t CORPUS_MAGIC = 0x31304358544C495AULL; // "ZILTXC01"
+    const uint32_t CORPUS_VERSION = 1;
+
+    void PrintUsage(const char * name)
+    {
+        cout << "[USAGE] " << name << " generate <corpus file> <accounts> <txns per account> [--threads=<n>]" << endl
+             << "        " << name << " replay <corpus file> --target=<shard>,<ip>:<port> [--target=...]" << endl
+             << "            [--shards=<n>] [--rate=<txns/s>] [--poisson] [--batch=<txns>] [--linger-ms=<ms>]" << endl
+             << "            [--duration=<s>] [--lookup=<ip>:<port> --listen=<port>] [--probe-every=<n>]" << endl
+             << "            [--poll-ms=<ms>] [--drain=<s>]" << endl;
+    }
+
+    bool GetOption(const string & arg, const string & name, string & value)
+    {
+        const string prefix = "--" + name + "=";
+        if (arg.compare(0, prefix.size(), prefix) != 0)
+        {
+            return false;
+        }
+        value = arg.substr(prefix.size());
+        return true;
+    }
+
+    bool ParsePeer(const string & text, Peer & peer)
+    {
+        size_t colon = text.rfind(':');
+        struct in_addr ip_addr;
+        if ((colon == string::npos) || (inet_aton(text.substr(0, colon).c_str(), &ip_addr) == 0))
+        {
+            return false;
+        }
+        peer = Peer((uint128_t)ip_addr.s_addr, static_cast<uint32_t>(atoi(text.substr(colon + 1).c_str())));
+        return true;
+    }
+
+    void ParallelFor(uint64_t count, unsigned int numThreads, const function<void(uint64_t)> & body)
+    {
+        vector<thread> threads;
+        for (unsigned int t = 0; t < numThreads; t++)
+        {
+            threads.emplace_back([t, count, numThreads, &body]()
+            {
+                for (uint64_t i = t; i < count; i += numThreads)
+                {
+                    body(i);
+                }
+            });
+        }
+        for (auto & thread : threads)
+        {
+            thread.join();
+        }
+    }
+
+    int Generate(const string & path, uint64_t numAccounts, uint64_t txnsPerAccount, unsigned int numThreads)
+    {
+        const uint32_t recordSize = Transaction::GetSerializedSize();
+        const uint64_t count = numAccounts * txnsPerAccount;
+        const size_t fileSize = sizeof(CorpusHeader) + count * recordSize;
+
+        int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if ((fd < 0) || (ftruncate(fd, fileSize) != 0))
+        {
+            cerr << "Cannot create " << path << endl;
+            return -1;
+        }
+        void * addr = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        close(fd);
+        if (addr == MAP_FAILED)
+        {
+            cerr << "Cannot map " << path << endl;
+            return -1;
+        }
+
+        auto start = Clock::now();
+
+        vector<pair<PrivKey, PubKey>> keys(numAccounts);
+        vector<Address> addresses(numAccounts);
+        ParallelFor(numAccounts, numThreads, [&keys, &addresses](uint64_t a)
+        {
+            keys.at(a) = Schnorr::GetInstance().GenKeyPair();
+            addresses.at(a) = Account::GetAddressFromPublicKey(keys.at(a).second);
+        });
+
+        // Each account pays the next one; nonces start at 1 as the account store expects
+        unsigned char * records = static_cast<unsigned char *>(addr) + sizeof(CorpusHeader);
+        ParallelFor(count, numThreads, [&](uint64_t i)
+        {
+            uint64_t a = i % numAccounts;
+            uint64_t n = i / numAccounts;
+            Transaction tx = TxnVerifier::CreateSigned(0, n + 1, addresses.at((a + 1) % numAccounts),
+                                                       keys.at(a).first, keys.at(a).second, 1);
+            vector<unsigned char> bytes;
+            tx.Serialize(bytes, 0);
+            memcpy(records + i * recordSize, bytes.data(), recordSize);
+        });
+
+        // The header goes in last, so an interrupted run never leaves a valid-looking corpus
+        CorpusHeader * header = static_cast<CorpusHeader *>(addr);
+        header->m_version = CORPUS_VERSION;
+        header->m_recordSize = recordSize;
+        header->m_count = count;
+        header->m_numAccounts = numAccounts;
+        header->m_magic = CORPUS_MAGIC;
+
+        msync(addr, fileSize, MS_SYNC);
+        munmap(addr, fileSize);
+
+        auto elapsed_ms = chrono::duration_cast<chrono::milliseconds>(Clock::now() - start).count();
+        cout << "Signed " << count << " txns from " << numAccounts << " accounts in " << elapsed_ms << " ms ("
+             << count * 1000 / max<int64_t>(elapsed_ms, 1) << " txns/s) into " << path << endl;
+        return 0;
+    }
+
+    /// Read-only view of a corpus file.
+    class Corpus
+    {
+        void * m_addr;
+        size_t m_size;
+        const CorpusHeader * m_header;
+
+    public:
+
+        Corpus() : m_addr(MAP_FAILED), m_size(0), m_header(nullptr) {}
+
+        ~Corpus()
+        {
+            if (m_addr != MAP_FAILED)
+            {
+                munmap(m_addr, m_size);
+            }
+        }
+
+        bool Open(const string & path)
+        {
+            int fd = open(path.c_str(), O_RDONLY);
+            if (fd < 0)
+            {
+                return false;
+            }
+            m_size = lseek(fd, 0, SEEK_END);
+            if (m_size >= sizeof(CorpusHeader))
+            {
+                m_addr = mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0);
+            }
+            close(fd);
+            if (m_addr == MAP_FAILED)
+            {
+                return false;
+            }
+
+            m_header = static_cast<const CorpusHeader *>(m_addr);
+            return (m_header->m_magic == CORPUS_MAGIC) && (m_header->m_version == CORPUS_VERSION) && 
+                   (m_header->m_recordSize == Transaction::GetSerializedSize()) && 
+                   (m_size >= sizeof(CorpusHeader) + m_header->m_count * m_header->m_recordSize);
+        }
+
+        uint64_t GetCount() const { return m_header->m_count; }
+
+        uint32_t GetRecordSize() const { return m_header->m_recordSize; }
+
+        const unsigned char * GetRecord(uint64_t i) const
+        {
+            return static_cast<const unsigned char *>(m_addr) + sizeof(CorpusHeader) + i * m_header->m_recordSize;
+        }
+
+        Transaction GetTransaction(uint64_t i) const
+        {
+            return Transaction(vector<unsigned char>(GetRecord(i), GetRecord(i) + GetRecordSize()), 0);
+        }
+    };
+
+    /// Follows the final blocks of a lookup node and times sampled transactions from submission until
+    /// their bodies can be fetched from it, which happens once they are committed.
+    class CommitWatcher
+    {
+        Peer m_lookup;
+        uint32_t m_listenPort;
+
+        mutex m_mutex;
+        map<TxnHash, Clock::time_point> m_probes;
+        uint256_t m_nextBlock;
+        bool m_baselineSet;
+        uint64_t m_numBlocks;
+        uint64_t m_numCommitted;
+
+        MetricHistogram m_latency;
+
+        void OnTxBlocks(const vector<unsigned char> & message)
+        {
+            // Message = [32-byte lowBlockNum][32-byte highBlockNum][TxBlock][TxBlock]...
+            unsigned int offset = MessageOffset::BODY;
+            if (message.size() < offset + 2 * UINT256_SIZE)
+            {
+                return;
+            }
+            uint256_t low = Serializable::GetNumber<uint256_t>(message, offset, UINT256_SIZE);
+            uint256_t high = Serializable::GetNumber<uint256_t>(message, offset + UINT256_SIZE, UINT256_SIZE);
+            offset += 2 * UINT256_SIZE;
+
+            lock_guard<mutex> g(m_mutex);
+
+            // Blocks that existed before the run only set where counting starts
+            if (!m_baselineSet)
+            {
+                m_nextBlock = max(m_nextBlock, high + 1);
+                m_baselineSet = true;
+                return;
+            }
+
+            for (uint256_t blockNum = low; (blockNum <= high) && (offset < message.size()); blockNum++)
+            {
+                TxBlock block(message, offset);
+                offset += block.GetSerializedSize();
+
+                if (block.GetHeader().GetBlockNum() < m_nextBlock)
+                {
+                    continue;
+                }
+                m_nextBlock = block.GetHeader().GetBlockNum() + 1;
+                m_numBlocks++;
+                m_numCommitted += block.GetHeader().GetNumTxs();
+
+                cout << "Final block " << block.GetHeader().GetBlockNum() << ": " << 
+                        block.GetHeader().GetNumTxs() << " txns" << endl;
+            }
+        }
+
+        void OnTxBody(const vector<unsigned char> & message)
+        {
+            // Message = [TRAN_HASH_SIZE txHash][txBody]
+            if (message.size() < MessageOffset::BODY + TRAN_HASH_SIZE)
+            {
+                return;
+            }
+            TxnHash tranID;
+            copy(message.begin() + MessageOffset::BODY, message.begin() + MessageOffset::BODY + TRAN_HASH_SIZE, 
+                 tranID.asArray().begin());
+
+            lock_guard<mutex> g(m_mutex);
+            auto it = m_probes.find(tranID);
+            if (it != m_probes.end())
+            {
+                m_latency.Record(Clock::now() - it->second);
+                m_probes.erase(it);
+            }
+        }
+
+    public:
+
+        /// Probes waiting for their commit at any time; further samples are skipped.
+        static const size_t MAX_PROBES = 256;
+
+        CommitWatcher(const Peer & lookup, uint32_t listenPort) : m_lookup(lookup), m_listenPort(listenPort), 
+            m_nextBlock(1), m_baselineSet(false), m_numBlocks(0), m_numCommitted(0)
+        {
+        }
+
+        void Start()
+        {
+            auto dispatcher = [this](const SharedBuffer & buffer, const Peer &) -> void
+            {
+                if ((buffer.size() < MessageOffset::BODY) || (buffer.at(MessageOffset::TYPE) != MessageType::LOOKUP))
+                {
+                    return;
+                }
+                if (buffer.at(MessageOffset::INST) == LookupInstructionType::SETTXBLOCKFROMSEED)
+                {
+                    OnTxBlocks(buffer.GetVector());
+                }
+                else if (buffer.at(MessageOffset::INST) == LookupInstructionType::SETTXBODYFROMSEED)
+                {
+                    OnTxBody(buffer.GetVector());
+                }
+            };
+            auto no_broadcast = [](unsigned char, unsigned char, const Peer &) -> vector<Peer> { return vector<Peer>(); };
+
+            uint32_t port = m_listenPort;
+            thread([port, dispatcher, no_broadcast]()
+            {
+                P2PComm::GetInstance().StartMessagePump(port, dispatcher, no_broadcast);
+            }).detach();
+        }
+
+        /// Returns true if the baseline block number has been learned.
+        bool HasBaseline()
+        {
+            lock_guard<mutex> g(m_mutex);
+            return m_baselineSet;
+        }
+
+        bool AddProbe(const TxnHash & tranID)
+        {
+            lock_guard<mutex> g(m_mutex);
+            if (m_probes.size() >= MAX_PROBES)
+            {
+                return false;
+            }
+            m_probes.emplace(tranID, Clock::now());
+            return true;
+        }
+
+        size_t GetNumProbes()
+        {
+            lock_guard<mutex> g(m_mutex);
+            return m_probes.size();
+        }
+
+        /// Asks the lookup for new final blocks and for the bodies of the pending probes.
+        void Poll()
+        {
+            vector<vector<unsigned char>> requests;
+            {
+                lock_guard<mutex> g(m_mutex);
+
+                // getTxBlockMessage = [lowBlockNum][highBlockNum = 0 for the latest][Port]
+                vector<unsigned char> getTxBlocks = { MessageType::LOOKUP, LookupInstructionType::GETTXBLOCKFROMSEED };
+                Serializable::SetNumber<uint256_t>(getTxBlocks, MessageOffset::BODY, m_nextBlock, UINT256_SIZE);
+                Serializable::SetNumber<uint256_t>(getTxBlocks, MessageOffset::BODY + UINT256_SIZE, 0, UINT256_SIZE);
+                Serializable::SetNumber<uint32_t>(getTxBlocks, MessageOffset::BODY + 2 * UINT256_SIZE, m_listenPort, 
+                                                  sizeof(uint32_t));
+                requests.push_back(move(getTxBlocks));
+
+                // getTxBodyMessage = [TRAN_HASH_SIZE txHash][Port]; only committed bodies are answered
+                for (const auto & probe : m_probes)
+                {
+                    vector<unsigned char> getTxBody = { MessageType::LOOKUP, LookupInstructionType::GETTXBODYFROMSEED };
+                    getTxBody.insert(getTxBody.end(), probe.first.asArray().begin(), probe.first.asArray().end());
+                    Serializable::SetNumber<uint32_t>(getTxBody, getTxBody.size(), m_listenPort, sizeof(uint32_t));
+                    requests.push_back(move(getTxBody));
+                }
+            }
+
+            for (const auto & request : requests)
+            {
+                P2PComm::GetInstance().SendMessage(m_lookup, request);
+            }
+        }
+
+        void Report(ostream & os)
+        {
+            lock_guard<mutex> g(m_mutex);
+            os << "Final blocks " << m_numBlocks << ", committed " << m_numCommitted << " txns; commit latency ";
+            if (m_latency.GetCount() == 0)
+            {
+                os << "n/a";
+            }
+            else
+            {
+                os << fixed << setprecision(2) << "p50 " << m_latency.GetQuantile(0.5) / 1e9 << " s, p90 " << 
+                      m_latency.GetQuantile(0.9) / 1e9 << " s, p99 " << m_latency.GetQuantile(0.99) / 1e9 << 
+                      " s (" << m_latency.GetCount() << " samples)";
+            }
+            os << ", " << m_probes.size() << " pending" << endl;
+        }
+    };
+
+    struct Target
+    {
+        unsigned int m_shard;
+        Peer m_peer;
+    };
+
+    /// Per-shard batch being filled, sent to the shard's targets in turn.
+    struct ShardQueue
+    {
+        vector<unsigned char> m_message;
+        unsigned int m_numTxns;
+        Clock::time_point m_oldest;
+        vector<Peer> m_peers;
+        unsigned int m_nextPeer;
+    };
+
+    int Replay(int argc, const char * argv[])
+    {
+        const string path = argv[2];
+        vector<Target> targets;
+        unsigned int numShards = 1, batchSize = 500, lingerMs = 50, probeEvery = 100, pollMs = 1000;
+        double rate = 1000, durationSec = 0, drainSec = 60;
+        bool poisson = false;
+        string lookup, listen;
+
+        for (int i = 3; i < argc; i++)
+        {
+            string value;
+            const string arg = argv[i];
+            if (GetOption(arg, "target", value))
+            {
+                Target target;
+                size_t comma = value.find(',');
+                target.m_shard = atoi(value.substr(0, comma).c_str());
+                if ((comma == string::npos) || !ParsePeer(value.substr(comma + 1), target.m_peer))
+                {
+                    cerr << "Bad target " << value << endl;
+                    return -1;
+                }
+                targets.push_back(target);
+            }
+            else if (GetOption(arg, "shards", value)) { numShards = max(atoi(value.c_str()), 1); }
+            else if (GetOption(arg, "rate", value)) { rate = atof(value.c_str()); }
+            else if (GetOption(arg, "batch", value)) { batchSize = max(atoi(value.c_str()), 1); }
+            else if (GetOption(arg, "linger-ms", value)) { lingerMs = atoi(value.c_str()); }
+            else if (GetOption(arg, "duration", value)) { durationSec = atof(value.c_str()); }
+            else if (GetOption(arg, "lookup", value)) { lookup = value; }
+            else if (GetOption(arg, "listen", value)) { listen = value; }
+            else if (GetOption(arg, "probe-every", value)) { probeEvery = max(atoi(value.c_str()), 1); }
+            else if (GetOption(arg, "poll-ms", value)) { pollMs = max(atoi(value.c_str()), 1); }
+            else if (GetOption(arg, "drain", value)) { drainSec = atof(value.c_str()); }
+            else if (arg == "--poisson") { poisson = true; }
+            else
+            {
+                PrintUsage(argv[0]);
+                return -1;
+            }
+        }
+
+        Corpus corpus;
+        if (!corpus.Open(path))
+        {
+            cerr << path << " is not a version " << CORPUS_VERSION << " transaction corpus" << endl;
+            return -1;
+        }
+
+        vector<ShardQueue> shards(numShards);
+        for (const auto & target : targets)
+        {
+            if (target.m_shard >= numShards)
+            {
+                cerr << "Target shard " << target.m_shard << " out of range" << endl;
+                return -1;
+            }
+            shards.at(target.m_shard).m_peers.push_back(target.m_peer);
+        }
+
+        // Nodes only take transactions whose sender is sharded to them
+        const uint64_t count = corpus.GetCount();
+        vector<uint16_t> shardOf(count, 0);
+        if (numShards > 1)
+        {
+            ParallelFor(count, thread::hardware_concurrency(), [&corpus, &shardOf, numShards](uint64_t i)
+            {
+                shardOf.at(i) = Transaction::GetShardIndex(corpus.GetTransaction(i).GetFromAddr(), numShards);
+            });
+        }
+
+        unique_ptr<CommitWatcher> watcher;
+        if (!lookup.empty())
+        {
+            Peer lookupPeer;
+            if (listen.empty() || !ParsePeer(lookup, lookupPeer))
+            {
+                cerr << "--lookup needs <ip>:<port> and --listen=<port>" << endl;
+                return -1;
+            }
+            watcher.reset(new CommitWatcher(lookupPeer, atoi(listen.c_str())));
+            watcher->Start();
+
+            // Learn the current chain height so only blocks made during the run are counted
+            for (unsigned int i = 0; (i < 10) && !watcher->HasBaseline(); i++)
+            {
+                watcher->Poll();
+                this_thread::sleep_for(chrono::milliseconds(500));
+            }
+            if (!watcher->HasBaseline())
+            {
+                cerr << "No reply from lookup " << lookup << endl;
+                return -1;
+            }
+        }
+
+        for (auto & shard : shards)
+        {
+            shard.m_message = { MessageType::NODE, NodeInstructionType::SUBMITTXNBATCH };
+            shard.m_numTxns = 0;
+            shard.m_nextPeer = 0;
+        }
+
+        atomic<uint64_t> numSent(0);
+        atomic<uint64_t> numSkipped(0);
+        auto flush = [&numSent, &numSkipped](ShardQueue & shard) -> void
+        {
+            if (shard.m_numTxns == 0)
+            {
+                return;
+            }
+            if (shard.m_peers.empty())
+            {
+                numSkipped += shard.m_numTxns;
+            }
+            else
+            {
+                Peer peer = shard.m_peers.at(shard.m_nextPeer++ % shard.m_peers.size());
+                shared_ptr<vector<unsigned char>> message = make_shared<vector<unsigned char>>(move(shard.m_message));
+                uint64_t n = shard.m_numTxns;
+                Executor::GetInstance().PostBlocking([peer, message, n, &numSent]() -> void
+                {
+                    P2PComm::GetInstance().SendMessage(peer, *message);
+                    numSent += n;
+                });
+            }
+            shard.m_message = { MessageType::NODE, NodeInstructionType::SUBMITTXNBATCH };
+            shard.m_numTxns = 0;
+        };
+
+        // Open loop: arrival times are fixed up front and do not wait on the network
+        mt19937_64 rng(1);
+        exponential_distribution<double> gap(rate);
+        double nextArrival = 0;
+        const chrono::milliseconds linger(lingerMs);
+        const Clock::time_point start = Clock::now();
+        Clock::time_point nextReport = start + chrono::seconds(1);
+        Clock::time_point nextPoll = start + chrono::milliseconds(pollMs);
+        uint64_t queued = 0, lastReportSent = 0;
+        double maxLagMs = 0;
+
+        while ((queued < count) && ((durationSec == 0) || (nextArrival < durationSec)))
+        {
+            Clock::time_point now = Clock::now();
+            double elapsed = chrono::duration<double>(now - start).count();
+            maxLagMs = max(maxLagMs, (elapsed - nextArrival) * 1000);
+
+            while ((queued < count) && (nextArrival <= elapsed) && ((durationSec == 0) || (nextArrival < durationSec)))
+            {
+                ShardQueue & shard = shards.at(shardOf.at(queued));
+                if (shard.m_numTxns == 0)
+                {
+                    shard.m_oldest = now;
+                }
+                shard.m_message.insert(shard.m_message.end(), corpus.GetRecord(queued), 
+                                       corpus.GetRecord(queued) + corpus.GetRecordSize());
+                shard.m_numTxns++;
+
+                if (watcher && (queued % probeEvery == 0) && !shard.m_peers.empty())
+                {
+                    watcher->AddProbe(corpus.GetTransaction(queued).GetTranID());
+                }
+                if (shard.m_numTxns >= batchSize)
+                {
+                    flush(shard);
+                }
+
+                queued++;
+                nextArrival = poisson ? nextArrival + gap(rng) : queued / rate;
+            }
+
+            Clock::time_point wake = start + chrono::duration_cast<Clock::duration>(chrono::duration<double>(nextArrival));
+            for (auto & shard : shards)
+            {
+                if ((shard.m_numTxns > 0) && (now - shard.m_oldest >= linger))
+                {
+                    flush(shard);
+                }
+                if (shard.m_numTxns > 0)
+                {
+                    wake = min(wake, shard.m_oldest + linger);
+                }
+            }
+
+            if (watcher && (now >= nextPoll))
+            {
+                watcher->Poll();
+                nextPoll = now + chrono::milliseconds(pollMs);
+            }
+
+            if (now >= nextReport)
+            {
+                uint64_t sent = numSent;
+                cout << "t=" << fixed << setprecision(0) << elapsed << " s: queued " << queued << ", sent " << sent << 
+                        " (" << sent - lastReportSent << " txns/s, target " << rate << ")" << endl;
+                lastReportSent = sent;
+                nextReport += chrono::seconds(1);
+            }
+
+            this_thread::sleep_until(min(wake, min(nextReport, watcher ? nextPoll : nextReport)));
+        }
+
+        for (auto & shard : shards)
+        {
+            flush(shard);
+        }
+
+        // Wait for the submissions still on the blocking pool
+        while (numSent + numSkipped < queued)
+        {
+            this_thread::sleep_for(chrono::milliseconds(10));
+        }
+        double sendSec = chrono::duration<double>(Clock::now() - start).count();
+
+        cout << "Sent " << numSent << " txns in " << fixed << setprecision(2) << sendSec << " s: " << 
+                setprecision(0) << numSent / sendSec << " txns/s achieved, " << rate << " targeted" << 
+                (poisson ? " (Poisson)" : "") << ", max schedule lag " << setprecision(1) << maxLagMs << " ms" << endl;
+        if (numSkipped > 0)
+        {
+            cout << numSkipped << " txns skipped for shards without a target" << endl;
+        }
+
+        if (watcher)
+        {
+            Clock::time_point deadline = Clock::now() + chrono::duration_cast<Clock::duration>(chrono::duration<double>(drainSec));
+            while ((watcher->GetNumProbes() > 0) && (Clock::now() < deadline))
+            {
+                watcher->Poll();
+                this_thread::sleep_for(chrono::milliseconds(pollMs));
+            }
+            watcher->Report(cout);
+        }
+
+        return 0;
+    }
+}
+
+int main(int argc, const char * argv[])
+{
+    if ((argc >= 5) && (string(argv[1]) == "generate"))
+    {
+        unsigned int numThreads = thread::hardware_concurrency();
+        string value;
+        if ((argc == 6) && GetOption(argv[5], "threads", value))
+        {
+            numThreads = max(atoi(value.c_str()), 1);
+        }
+        return Generate(argv[2], strtoull(argv[3], nullptr, 10), strtoull(argv[4], nullptr, 10), numThreads);
+    }
+
+    if ((argc >= 4) && (string(argv[1]) == "replay"))
+    {
+        INIT_FILE_LOGGER("loadgen");
+        return Replay(argc, argv);
+    }
+
+    PrintUsage(argv[0]);
+    return -1;
+}
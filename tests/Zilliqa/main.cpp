@@ -22,10 +22,14 @@
 #include <algorithm>
 #include "libUtils/Logger.h"
 
+#include "common/Constants.h"
 #include "libNetwork/PeerStore.h"
 #include "libNetwork/P2PComm.h"
 #include "libUtils/Logger.h"
 #include "libUtils/DataConversion.h"
+#include "libUtils/EventLog.h"
+#include "libUtils/Metrics.h"
+#include "libUtils/Tracer.h"
 #include "libZilliqa/Zilliqa.h"
 
 using namespace std;
@@ -66,6 +70,12 @@ void got_unxpected()
     raise (SIGABRT); // generate core dump thru abort
 }
 
+/* SIGUSR1 steps the trace level: off -> phases -> all -> off. */
+void cycle_trace_level(int)
+{
+    Tracer::SetLevel(static_cast<TraceLevel>((Tracer::GetLevel() + 1) % (TRACE_ALL + 1)));
+}
+
 int main(int argc, const char * argv[])
 {
     const int num_args_required = 1 + 5; // first 1 = program name
@@ -91,9 +101,19 @@ int main(int argc, const char * argv[])
         inet_aton(argv[3], &ip_addr);
         Peer my_port((uint128_t)ip_addr.s_addr, static_cast<unsigned int>(atoi(argv[4])));
 
+#ifdef STAT_TEST
+        INIT_EVENT_LOG("state-events.bin", ip_addr.s_addr, my_port.m_listenPortHost);
+#endif // STAT_TEST
+
+        Metrics::GetInstance().Start(METRICS_PORT, METRICS_DUMP_INTERVAL_IN_SECONDS);
+
+        Tracer::GetInstance().Init("node " + to_string(my_port.m_listenPortHost));
+        Tracer::SetLevel(static_cast<TraceLevel>(TRACE_LEVEL));
+        signal(SIGUSR1, cycle_trace_level);
+
         Zilliqa zilliqa(make_pair(privkey, pubkey), my_port, atoi(argv[5]) == 1);
 
-        auto dispatcher = [&zilliqa](const vector<unsigned char> & message, const Peer & from) mutable -> void { zilliqa.Dispatch(message, from); };
+        auto dispatcher = [&zilliqa](const SharedBuffer & message, const Peer & from) mutable -> void { zilliqa.Dispatch(message, from); };
         auto broadcast_list_retriever = [&zilliqa](unsigned char msg_type, unsigned char ins_type, const Peer & from) mutable -> vector<Peer> { return zilliqa.RetrieveBroadcastList(msg_type, ins_type, from); };
 
         P2PComm::GetInstance().StartMessagePump(my_port.m_listenPortHost, dispatcher, broadcast_list_retriever);
@@ -0,0 +1,114 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <arpa/inet.h>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include "libUtils/EventLog.h"
+
+using namespace std;
+
+int main(int argc, const char * argv[])
+{
+    if ((argc != 2) && (argc != 3))
+    {
+        cout << "[USAGE] " << argv[0] << " <event log file> [csv|json]" << endl;
+        return -1;
+    }
+
+    bool json = (argc == 3) && (strcmp(argv[2], "json") == 0);
+
+    ifstream in(argv[1], ios::binary);
+    if (!in)
+    {
+        cerr << "Cannot open " << argv[1] << endl;
+        return -1;
+    }
+
+    // The header ends in an atomic, so read its fields individually
+    uint64_t magic = 0, capacity = 0, writeIndex = 0;
+    uint32_t version = 0, recordSize = 0;
+    in.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+    in.read(reinterpret_cast<char *>(&version), sizeof(version));
+    in.read(reinterpret_cast<char *>(&recordSize), sizeof(recordSize));
+    in.read(reinterpret_cast<char *>(&capacity), sizeof(capacity));
+    in.read(reinterpret_cast<char *>(&writeIndex), sizeof(writeIndex));
+
+    if (!in || (magic != EventLog::MAGIC) || (recordSize != sizeof(EventRecord)))
+    {
+        cerr << argv[1] << " is not a version " << EventLog::VERSION << " event log" << endl;
+        return -1;
+    }
+
+    vector<EventRecord> records(capacity);
+    in.seekg(sizeof(EventLogHeader));
+    in.read(reinterpret_cast<char *>(records.data()), capacity * sizeof(EventRecord));
+
+    // Walk the ring oldest-first; skip slots that were overwritten or never finished
+    uint64_t first = (writeIndex > capacity) ? writeIndex - capacity : 0;
+
+    if (json)
+    {
+        cout << "[" << endl;
+    }
+    else
+    {
+        cout << "seq,timestamp_ns,node,port,epoch,event,phase,payload0,payload1" << endl;
+    }
+
+    bool firstRow = true;
+
+    for (uint64_t index = first; index < writeIndex; index++)
+    {
+        const EventRecord & r = records[index % capacity];
+
+        if (r.m_sequence != index + 1)
+        {
+            continue;
+        }
+
+        struct in_addr ip_addr;
+        ip_addr.s_addr = r.m_node;
+        const char * node = inet_ntoa(ip_addr);
+
+        if (json)
+        {
+            cout << (firstRow ? "" : ",\n") << "{\"seq\":" << index << ",\"timestamp_ns\":" << r.m_timestamp 
+                 << ",\"node\":\"" << node << "\",\"port\":" << r.m_port << ",\"epoch\":" << r.m_epoch 
+                 << ",\"event\":\"" << EventLog::GetEventName(r.m_event) << "\",\"phase\":\"" 
+                 << EventLog::GetPhaseName(r.m_phase) << "\",\"payload0\":" << r.m_payload[0] 
+                 << ",\"payload1\":" << r.m_payload[1] << "}";
+        }
+        else
+        {
+            cout << index << "," << r.m_timestamp << "," << node << "," << r.m_port << "," << r.m_epoch << "," 
+                 << EventLog::GetEventName(r.m_event) << "," << EventLog::GetPhaseName(r.m_phase) << "," 
+                 << r.m_payload[0] << "," << r.m_payload[1] << endl;
+        }
+
+        firstRow = false;
+    }
+
+    if (json)
+    {
+        cout << endl << "]" << endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,198 @@
+/**
+* Copyright (c) 2018 Zilliqa 
+* This source code is being disclosed to you solely for the purpose of your participation in 
+* testing Zilliqa. You may view, compile and run the code for that purpose and pursuant to 
+* the protocols and algorithms that are programmed into, and intended by, the code. You may 
+* not do anything else with the code without express permission from Zilliqa Research Pte. Ltd., 
+* including modifying or publishing the code (or any part of it), and developing or forming 
+* another public or private blockchain network. This source code is provided ‘as is’ and no 
+* warranties are given as to title or non-infringement, merchantability or fitness for purpose 
+* and, to the extent permitted by law, all liability for your use of the code is disclaimed. 
+* Some programs in this code are governed by the GNU General Public License v3.0 (available at 
+* https://www.gnu.org/licenses/gpl-3.0.en.html) (‘GPLv3’). The programs that are governed by 
+* GPLv3.0 are those programs that are located in the folders src/depends and tests/depends 
+* and which include a reference to GPLv3 in their program files.
+**/
+
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include "common/Constants.h"
+#include "libSimulation/EpochSimulator.h"
+#include "libUtils/Logger.h"
+
+using namespace std;
+
+namespace
+{
+    void PrintUsage(const char * name)
+    {
+        cout << "[USAGE] " << name << " [--nodes=<shard nodes>] [--shard-size=<n>] [--ds=<n>]" << endl
+             << "        [--latency-ms=<ms>] [--jitter-ms=<ms>] [--bandwidth-mbps=<mbps>] [--loss=<rate>]" << endl
+             << "        [--final-blocks=<n>] [--txns=<per microblock>] [--aggregation-fanout=<n>]" << endl
+             << "        [--pow1-window=<s>] [--pow2-window=<s>] [--pow-seconds=<mean mining time>]" << endl
+             << "        [--calibrate=<zilliqa_bench JSON>] [--seed=<n>] [--out=<JSON file>]" << endl;
+    }
+
+    bool GetOption(const string & arg, const string & name, string & value)
+    {
+        const string prefix = "--" + name + "=";
+        if (arg.compare(0, prefix.size(), prefix) != 0)
+        {
+            return false;
+        }
+        value = arg.substr(prefix.size());
+        return true;
+    }
+
+    /// Takes CPU costs from the benchmarks this machine produced, where present.
+    bool Calibrate(const string & path, EpochSimulator::Costs & costs)
+    {
+        using boost::property_tree::ptree;
+        ptree pt;
+
+        try
+        {
+            read_json(path, pt);
+        }
+        catch (const exception & e)
+        {
+            cerr << "Cannot read " << path << ": " << e.what() << endl;
+            return false;
+        }
+
+        for (const auto & entry : pt.get_child("benchmarks", ptree()))
+        {
+            const string name = entry.second.get<string>("name", "");
+            const uint64_t ns = entry.second.get<double>("ns_per_op", 0);
+
+            if (name == "crypto/schnorr_sign")
+            {
+                costs.m_signNs = ns;
+            }
+            else if (name == "crypto/schnorr_verify")
+            {
+                costs.m_verifyNs = ns;
+            }
+            else if (name.compare(0, 26, "crypto/multisig_aggregate_") == 0)
+            {
+                // One op aggregates keys, commits and responses of every signer
+                costs.m_aggregatePerSignerNs = ns / (3 * atoi(name.substr(26).c_str()));
+            }
+            else if (name == "pow/light_verify")
+            {
+                costs.m_powVerifyNs = ns;
+            }
+        }
+
+        return true;
+    }
+
+    void WriteJson(ostream & os, const EpochSimulator::Config & config,
+                   const vector<EpochSimulator::PhaseTiming> & phases, uint64_t maxEgressBytes)
+    {
+        os << "{\n  \"nodes\": " << config.m_numShards * config.m_shardSize << ", \"shards\": " << 
+              config.m_numShards << ", \"ds_nodes\": " << config.m_numDSNodes << ", \"seed\": " << config.m_seed << 
+              ",\n  \"epoch_ms\": " << fixed << setprecision(3) << (phases.back().m_endNs / 1e6) << 
+              ", \"max_node_egress_bytes\": " << maxEgressBytes << ",\n  \"phases\": [";
+
+        for (unsigned int i = 0; i < phases.size(); i++)
+        {
+            const EpochSimulator::PhaseTiming & p = phases.at(i);
+            os << (i == 0 ? "\n" : ",\n") << "    { \"name\": \"" << p.m_name << "\", \"start_ms\": " << 
+                  p.m_startNs / 1e6 << ", \"duration_ms\": " << (p.m_endNs - p.m_startNs) / 1e6 << 
+                  ", \"messages\": " << p.m_numMessages << ", \"bytes\": " << p.m_numBytes << 
+                  ", \"retransmits\": " << p.m_numRetransmits << ", \"late\": " << p.m_numLate << " }";
+        }
+
+        os << "\n  ]\n}\n";
+    }
+}
+
+int main(int argc, const char * argv[])
+{
+    string nodes = "1000", shardSize = "500", numDS = to_string(COMM_SIZE);
+    string latencyMs = "50", jitterMs = "10", bandwidthMbps = "100", loss = "0";
+    string finalBlocks = to_string(NUM_FINAL_BLOCK_PER_POW), txns = to_string(MAX_TXNS_PER_MICROBLOCK);
+    string aggregationFanout = to_string(CONSENSUS_AGGREGATION_FANOUT);
+    string pow1Window = to_string(POW1_WINDOW_IN_SECONDS), pow2Window = to_string(BACKUP_POW2_WINDOW_IN_SECONDS);
+    string powSeconds, calibrate, seed = "1", outPath;
+
+    for (int i = 1; i < argc; i++)
+    {
+        const string arg = argv[i];
+        if (!GetOption(arg, "nodes", nodes) && !GetOption(arg, "shard-size", shardSize) && 
+            !GetOption(arg, "ds", numDS) && !GetOption(arg, "latency-ms", latencyMs) && 
+            !GetOption(arg, "jitter-ms", jitterMs) && !GetOption(arg, "bandwidth-mbps", bandwidthMbps) && 
+            !GetOption(arg, "loss", loss) && !GetOption(arg, "final-blocks", finalBlocks) && 
+            !GetOption(arg, "txns", txns) && !GetOption(arg, "aggregation-fanout", aggregationFanout) && 
+            !GetOption(arg, "pow1-window", pow1Window) && !GetOption(arg, "pow2-window", pow2Window) && 
+            !GetOption(arg, "pow-seconds", powSeconds) && !GetOption(arg, "calibrate", calibrate) && 
+            !GetOption(arg, "seed", seed) && !GetOption(arg, "out", outPath))
+        {
+            PrintUsage(argv[0]);
+            return -1;
+        }
+    }
+
+    INIT_STDOUT_LOGGER();
+    Logger::SetLogLevel(LOG_LEVEL_WARNING);
+
+    EpochSimulator::Config config;
+    config.m_numDSNodes = max(1, atoi(numDS.c_str()));
+    config.m_shardSize = max(1, atoi(shardSize.c_str()));
+    config.m_numShards = max(1, atoi(nodes.c_str()) / (int) config.m_shardSize);
+    config.m_treeFanout = 8;
+    config.m_aggregationFanout = atoi(aggregationFanout.c_str());
+    config.m_numFinalBlocks = atoi(finalBlocks.c_str());
+    config.m_txnsPerMicroBlock = atoi(txns.c_str());
+    config.m_pow1WindowNs = strtoull(pow1Window.c_str(), NULL, 10) * 1000000000;
+    config.m_pow2WindowNs = strtoull(pow2Window.c_str(), NULL, 10) * 1000000000;
+
+    // By default, mining finishes well within the PoW1 window
+    config.m_meanPoWNs = powSeconds.empty() ? config.m_pow1WindowNs / 4 : atof(powSeconds.c_str()) * 1e9;
+
+    // Costs measured with zilliqa_bench on a single core; --calibrate replaces them
+    config.m_costs = { 370000, 470000, 2000, 5000000, 2000 };
+    if (!calibrate.empty() && !Calibrate(calibrate, config.m_costs))
+    {
+        return -1;
+    }
+
+    config.m_link.m_latencyNs = atof(latencyMs.c_str()) * 1e6;
+    config.m_link.m_jitterNs = atof(jitterMs.c_str()) * 1e6;
+    config.m_link.m_bandwidthBps = atof(bandwidthMbps.c_str()) * 1e6;
+    config.m_link.m_lossRate = atof(loss.c_str());
+    config.m_link.m_retransmitNs = 200000000; // Linux minimum TCP RTO
+    config.m_seed = strtoull(seed.c_str(), NULL, 10);
+
+    EpochSimulator simulator(config);
+    vector<EpochSimulator::PhaseTiming> phases = simulator.Run();
+
+    cout << left << setw(26) << "phase" << right << setw(12) << "start ms" << setw(14) << "duration ms" << 
+            setw(12) << "messages" << setw(14) << "MB" << setw(8) << "late" << endl;
+    for (const auto & p : phases)
+    {
+        cout << left << setw(26) << p.m_name << right << fixed << setprecision(1) << setw(12) << 
+                p.m_startNs / 1e6 << setw(14) << (p.m_endNs - p.m_startNs) / 1e6 << setw(12) << p.m_numMessages << 
+                setprecision(2) << setw(14) << p.m_numBytes / 1e6 << setw(8) << p.m_numLate << endl;
+    }
+    cout << "Epoch: " << setprecision(1) << phases.back().m_endNs / 1e6 << " ms for " << 
+            config.m_numShards * config.m_shardSize + config.m_numDSNodes << " nodes, " << 
+            simulator.GetNumEvents() << " events, max egress per node " << setprecision(2) << 
+            simulator.GetMaxEgressBytes() / 1e6 << " MB" << endl;
+
+    if (!outPath.empty())
+    {
+        ofstream out(outPath);
+        WriteJson(out, config, phases, simulator.GetMaxEgressBytes());
+    }
+
+    return 0;
+}
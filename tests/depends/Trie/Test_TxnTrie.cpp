@@ -44,8 +44,9 @@ BOOST_AUTO_TEST_SUITE (trietest)
 Transaction constructDummyTxBody(int instanceNum)
 {
     Address addr = NullAddress;
+    array<unsigned char, PUB_KEY_SIZE> pubKey = {0};
     array<unsigned char, BLOCK_SIG_SIZE> sign = {0};
-    return Transaction(0, instanceNum, addr, addr, 0, sign);
+    return Transaction(0, instanceNum, addr, addr, 0, pubKey, sign);
 }
 
 // BOOST_AUTO_TEST_CASE (fat_trie)